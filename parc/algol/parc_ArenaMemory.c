@@ -0,0 +1,539 @@
+/*
+ * Copyright (c) 2015, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * Every allocation, whether from an arena or from the heap, is preceded by a header that records its origin
+ * and requested length, so that deallocation and reallocation work from any thread and with any current arena.
+ *
+ * An arena is a list of regions, the most recent first.  Allocation advances a pointer through the most recent
+ * region and a new, larger region is obtained when it is exhausted.  The most recent allocation is remembered
+ * so that it can be grown or returned in place, which serves the common pattern of building up a buffer.
+ *
+ * The arena and region bookkeeping outlives any particular `PARCMemoryInterface`,
+ * so it is allocated directly from the system.
+ *
+ * @author Glenn Scott, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include <config.h>
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#include <LongBow/runtime.h>
+
+#include <parc/algol/parc_ArenaMemory.h>
+#include <parc/algol/parc_StdlibMemory.h>
+
+#define _PARCArenaMemory_Alignment 16
+#define _PARCArenaMemory_DefaultRegionSize (64 * 1024)
+#define _PARCArenaMemory_MaximumRegionSize (4 * 1024 * 1024)
+#define _PARCArenaMemory_HugePageSize (2 * 1024 * 1024)
+
+#define _parcArenaMemory_AlignUp(_value_, _alignment_) (((_value_) + ((_alignment_) - 1)) & ~((uintptr_t) (_alignment_) - 1))
+
+// A heap allocation's origin is the address returned by the heap with the low bit set.
+#define _PARCArenaMemory_HeapOrigin ((uintptr_t) 1)
+
+typedef struct {
+    uintptr_t origin;    // The PARCArenaMemory that allocated the memory, or the heap base address | _PARCArenaMemory_HeapOrigin
+    size_t length;       // The requested length.
+} _PARCArenaMemoryHeader;
+
+#define _PARCArenaMemory_HeaderSize _parcArenaMemory_AlignUp(sizeof(_PARCArenaMemoryHeader), _PARCArenaMemory_Alignment)
+
+typedef struct parc_arena_memory_region {
+    struct parc_arena_memory_region *next;
+    size_t capacity;     // The size of the region, including this structure.
+    bool mapped;         // True if the region was obtained from mmap(2) rather than malloc(3).
+} _PARCArenaMemoryRegion;
+
+#define _PARCArenaMemory_RegionHeaderSize _parcArenaMemory_AlignUp(sizeof(_PARCArenaMemoryRegion), _PARCArenaMemory_Alignment)
+
+struct parc_arena_memory {
+    _PARCArenaMemoryRegion *regions;
+    uint8_t *next;       // The next free byte of the most recent region.
+    uint8_t *end;        // The end of the most recent region.
+    uint8_t *last;       // The most recent allocation, or NULL.
+    size_t nextRegionSize;
+    size_t bytesUsed;
+    size_t bytesReserved;
+    PARCArenaMemoryFlags flags;
+};
+
+// The number of regions held by all arenas.
+static uint32_t _parcArenaMemory_Regions;
+
+static pthread_once_t _parcArenaMemory_KeysOnce = PTHREAD_ONCE_INIT;
+static pthread_key_t _parcArenaMemory_CurrentKey;
+static pthread_key_t _parcArenaMemory_ThreadArenaKey;
+
+static void
+_parcArenaMemory_DestroyThreadArena(void *arena)
+{
+    if (pthread_getspecific(_parcArenaMemory_CurrentKey) == arena) {
+        pthread_setspecific(_parcArenaMemory_CurrentKey, NULL);
+    }
+    PARCArenaMemory *instance = arena;
+    parcArenaMemory_Destroy(&instance);
+}
+
+static void
+_parcArenaMemory_CreateKeys(void)
+{
+    pthread_key_create(&_parcArenaMemory_CurrentKey, NULL);
+    pthread_key_create(&_parcArenaMemory_ThreadArenaKey, _parcArenaMemory_DestroyThreadArena);
+}
+
+static inline PARCArenaMemory *
+_parcArenaMemory_Current(void)
+{
+    pthread_once(&_parcArenaMemory_KeysOnce, _parcArenaMemory_CreateKeys);
+    return pthread_getspecific(_parcArenaMemory_CurrentKey);
+}
+
+static inline _PARCArenaMemoryHeader *
+_parcArenaMemory_Header(const void *memory)
+{
+    return (_PARCArenaMemoryHeader *) ((uint8_t *) memory - _PARCArenaMemory_HeaderSize);
+}
+
+static void *
+_parcArenaMemory_MapHugePages(size_t capacity)
+{
+#ifdef MAP_ANONYMOUS
+    // Over-allocate so that the region can be trimmed to start on a huge page boundary.
+    size_t length = capacity + _PARCArenaMemory_HugePageSize;
+    uint8_t *mapping = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapping == MAP_FAILED) {
+        return NULL;
+    }
+
+    uint8_t *start = (uint8_t *) _parcArenaMemory_AlignUp((uintptr_t) mapping, _PARCArenaMemory_HugePageSize);
+    if (start > mapping) {
+        munmap(mapping, (size_t) (start - mapping));
+    }
+    size_t tail = (size_t) (mapping + length - (start + capacity));
+    if (tail > 0) {
+        munmap(start + capacity, tail);
+    }
+#ifdef MADV_HUGEPAGE
+    madvise(start, capacity, MADV_HUGEPAGE);
+#endif
+    return start;
+#else
+    return NULL;
+#endif
+}
+
+static _PARCArenaMemoryRegion *
+_parcArenaMemory_CreateRegion(const PARCArenaMemory *arena, size_t capacity)
+{
+    capacity = _parcArenaMemory_AlignUp(capacity, _PARCArenaMemory_Alignment);
+
+    _PARCArenaMemoryRegion *region = NULL;
+    bool mapped = false;
+    if (arena->flags & PARCArenaMemoryFlags_HugePages) {
+        capacity = _parcArenaMemory_AlignUp(capacity, _PARCArenaMemory_HugePageSize);
+        region = _parcArenaMemory_MapHugePages(capacity);
+        mapped = (region != NULL);
+    }
+    if (region == NULL) {
+        region = malloc(capacity);
+    }
+
+    if (region != NULL) {
+        region->next = NULL;
+        region->capacity = capacity;
+        region->mapped = mapped;
+        __atomic_add_fetch(&_parcArenaMemory_Regions, 1, __ATOMIC_RELAXED);
+    }
+    return region;
+}
+
+static void
+_parcArenaMemory_DestroyRegion(_PARCArenaMemoryRegion *region)
+{
+    __atomic_sub_fetch(&_parcArenaMemory_Regions, 1, __ATOMIC_RELAXED);
+    if (region->mapped) {
+        munmap(region, region->capacity);
+    } else {
+        free(region);
+    }
+}
+
+static void
+_parcArenaMemory_UseRegion(PARCArenaMemory *arena, _PARCArenaMemoryRegion *region)
+{
+    arena->next = (uint8_t *) region + _PARCArenaMemory_RegionHeaderSize;
+    arena->end = (uint8_t *) region + region->capacity;
+    arena->last = NULL;
+}
+
+// Make a new region, with room for at least the required number of bytes, the most recent region.
+static bool
+_parcArenaMemory_Grow(PARCArenaMemory *arena, size_t required)
+{
+    if (required > SIZE_MAX - _PARCArenaMemory_RegionHeaderSize - _PARCArenaMemory_HugePageSize) {
+        return false;
+    }
+
+    size_t capacity = arena->nextRegionSize;
+    if (capacity < _PARCArenaMemory_RegionHeaderSize + required) {
+        capacity = _PARCArenaMemory_RegionHeaderSize + required;
+    } else if (arena->nextRegionSize < _PARCArenaMemory_MaximumRegionSize) {
+        arena->nextRegionSize *= 2;
+    }
+
+    _PARCArenaMemoryRegion *region = _parcArenaMemory_CreateRegion(arena, capacity);
+    if (region == NULL) {
+        return false;
+    }
+    region->next = arena->regions;
+    arena->regions = region;
+    arena->bytesReserved += region->capacity;
+    _parcArenaMemory_UseRegion(arena, region);
+    return true;
+}
+
+static void *
+_parcArenaMemory_ArenaAllocate(PARCArenaMemory *arena, size_t alignment, size_t size)
+{
+    if (size > SIZE_MAX / 2) {
+        return NULL;
+    }
+
+    uintptr_t start = _parcArenaMemory_AlignUp((uintptr_t) arena->next + _PARCArenaMemory_HeaderSize, alignment);
+    if (arena->next == NULL || start + size > (uintptr_t) arena->end) {
+        if (!_parcArenaMemory_Grow(arena, _PARCArenaMemory_HeaderSize + alignment + size)) {
+            return NULL;
+        }
+        start = _parcArenaMemory_AlignUp((uintptr_t) arena->next + _PARCArenaMemory_HeaderSize, alignment);
+    }
+
+    uint8_t *result = (uint8_t *) start;
+    _PARCArenaMemoryHeader *header = _parcArenaMemory_Header(result);
+    header->origin = (uintptr_t) arena;
+    header->length = size;
+
+    uint8_t *next = (uint8_t *) _parcArenaMemory_AlignUp(start + size, _PARCArenaMemory_Alignment);
+    arena->bytesUsed += (size_t) (next - arena->next);
+    arena->next = next;
+    arena->last = result;
+
+    return result;
+}
+
+static void *
+_parcArenaMemory_HeapAllocate(size_t alignment, size_t size)
+{
+    size_t offset = (alignment > _PARCArenaMemory_HeaderSize) ? alignment : _PARCArenaMemory_HeaderSize;
+    if (size > SIZE_MAX - offset) {
+        return NULL;
+    }
+
+    void *base = NULL;
+    if (alignment <= _PARCArenaMemory_Alignment) {
+        base = parcStdlibMemory_Allocate(offset + size);
+    } else if (parcStdlibMemory_MemAlign(&base, alignment, offset + size) != 0) {
+        base = NULL;
+    }
+    if (base == NULL) {
+        return NULL;
+    }
+
+    uint8_t *result = (uint8_t *) base + offset;
+    _PARCArenaMemoryHeader *header = _parcArenaMemory_Header(result);
+    header->origin = (uintptr_t) base | _PARCArenaMemory_HeapOrigin;
+    header->length = size;
+    return result;
+}
+
+static inline void *
+_parcArenaMemory_Allocate(size_t alignment, size_t size)
+{
+    PARCArenaMemory *arena = _parcArenaMemory_Current();
+    if (arena != NULL) {
+        return _parcArenaMemory_ArenaAllocate(arena, alignment, size);
+    }
+    return _parcArenaMemory_HeapAllocate(alignment, size);
+}
+
+PARCArenaMemory *
+parcArenaMemory_Create(size_t regionSize, PARCArenaMemoryFlags flags)
+{
+    PARCArenaMemory *result = calloc(1, sizeof(PARCArenaMemory));
+    if (result != NULL) {
+        result->nextRegionSize = (regionSize == 0) ? _PARCArenaMemory_DefaultRegionSize : regionSize;
+        result->flags = flags;
+    }
+    return result;
+}
+
+void
+parcArenaMemory_Destroy(PARCArenaMemory **arenaPtr)
+{
+    PARCArenaMemory *arena = *arenaPtr;
+
+    if (_parcArenaMemory_Current() == arena) {
+        pthread_setspecific(_parcArenaMemory_CurrentKey, NULL);
+    }
+
+    _PARCArenaMemoryRegion *region = arena->regions;
+    while (region != NULL) {
+        _PARCArenaMemoryRegion *next = region->next;
+        _parcArenaMemory_DestroyRegion(region);
+        region = next;
+    }
+    free(arena);
+
+    *arenaPtr = NULL;
+}
+
+void
+parcArenaMemory_Reset(PARCArenaMemory *arena)
+{
+    _PARCArenaMemoryRegion *largest = arena->regions;
+    for (_PARCArenaMemoryRegion *region = arena->regions; region != NULL; region = region->next) {
+        if (region->capacity > largest->capacity) {
+            largest = region;
+        }
+    }
+
+    _PARCArenaMemoryRegion *region = arena->regions;
+    while (region != NULL) {
+        _PARCArenaMemoryRegion *next = region->next;
+        if (region != largest) {
+            _parcArenaMemory_DestroyRegion(region);
+        }
+        region = next;
+    }
+
+    arena->regions = largest;
+    arena->bytesUsed = 0;
+    if (largest != NULL) {
+        largest->next = NULL;
+        arena->bytesReserved = largest->capacity;
+        _parcArenaMemory_UseRegion(arena, largest);
+    }
+}
+
+PARCArenaMemory *
+parcArenaMemory_SetCurrent(PARCArenaMemory *arena)
+{
+    PARCArenaMemory *result = _parcArenaMemory_Current();
+    pthread_setspecific(_parcArenaMemory_CurrentKey, arena);
+    return result;
+}
+
+PARCArenaMemory *
+parcArenaMemory_GetCurrent(void)
+{
+    return _parcArenaMemory_Current();
+}
+
+PARCArenaMemory *
+parcArenaMemory_ThreadArena(void)
+{
+    pthread_once(&_parcArenaMemory_KeysOnce, _parcArenaMemory_CreateKeys);
+
+    PARCArenaMemory *result = pthread_getspecific(_parcArenaMemory_ThreadArenaKey);
+    if (result == NULL) {
+        result = parcArenaMemory_Create(0, PARCArenaMemoryFlags_None);
+        pthread_setspecific(_parcArenaMemory_ThreadArenaKey, result);
+    }
+    return result;
+}
+
+size_t
+parcArenaMemory_BytesUsed(const PARCArenaMemory *arena)
+{
+    return arena->bytesUsed;
+}
+
+size_t
+parcArenaMemory_BytesReserved(const PARCArenaMemory *arena)
+{
+    return arena->bytesReserved;
+}
+
+void *
+parcArenaMemory_Allocate(size_t size)
+{
+    if (size == 0) {
+        return NULL;
+    }
+    return _parcArenaMemory_Allocate(_PARCArenaMemory_Alignment, size);
+}
+
+void *
+parcArenaMemory_AllocateAndClear(size_t size)
+{
+    void *result = parcArenaMemory_Allocate(size);
+    if (result != NULL) {
+        memset(result, 0, size);
+    }
+    return result;
+}
+
+int
+parcArenaMemory_MemAlign(void **pointer, size_t alignment, size_t size)
+{
+    if (size == 0 || alignment < sizeof(void *) || (alignment & (alignment - 1)) != 0) {
+        return EINVAL;
+    }
+
+    *pointer = _parcArenaMemory_Allocate(alignment, size);
+    return (*pointer == NULL) ? ENOMEM : 0;
+}
+
+void
+parcArenaMemory_Deallocate(void **pointer)
+{
+    uint8_t *memory = *pointer;
+    if (memory != NULL) {
+        _PARCArenaMemoryHeader *header = _parcArenaMemory_Header(memory);
+
+        if (header->origin & _PARCArenaMemory_HeapOrigin) {
+            void *base = (void *) (header->origin & ~_PARCArenaMemory_HeapOrigin);
+            parcStdlibMemory_Deallocate(&base);
+        } else {
+            // The most recent allocation from this thread's arena can be returned immediately.
+            PARCArenaMemory *arena = (PARCArenaMemory *) header->origin;
+            if (arena == _parcArenaMemory_Current() && arena->last == memory) {
+                arena->bytesUsed -= (size_t) (arena->next - (uint8_t *) header);
+                arena->next = (uint8_t *) header;
+                arena->last = NULL;
+            }
+        }
+    }
+    *pointer = NULL;
+}
+
+void *
+parcArenaMemory_Reallocate(void *pointer, size_t newSize)
+{
+    if (newSize == 0) {
+        newSize = 1;
+    }
+    if (pointer == NULL) {
+        return parcArenaMemory_Allocate(newSize);
+    }
+
+    uint8_t *memory = pointer;
+    _PARCArenaMemoryHeader *header = _parcArenaMemory_Header(memory);
+
+    if (header->origin & _PARCArenaMemory_HeapOrigin) {
+        uint8_t *base = (uint8_t *) (header->origin & ~_PARCArenaMemory_HeapOrigin);
+        if (base + _PARCArenaMemory_HeaderSize == memory && newSize <= SIZE_MAX - _PARCArenaMemory_HeaderSize) {
+            base = parcStdlibMemory_Reallocate(base, _PARCArenaMemory_HeaderSize + newSize);
+            if (base == NULL) {
+                return NULL;
+            }
+            memory = base + _PARCArenaMemory_HeaderSize;
+            header = _parcArenaMemory_Header(memory);
+            header->origin = (uintptr_t) base | _PARCArenaMemory_HeapOrigin;
+            header->length = newSize;
+            return memory;
+        }
+    } else {
+        PARCArenaMemory *arena = (PARCArenaMemory *) header->origin;
+        if (arena == _parcArenaMemory_Current() && arena->last == memory && newSize <= (size_t) (arena->end - memory)) {
+            uint8_t *next = (uint8_t *) _parcArenaMemory_AlignUp((uintptr_t) memory + newSize, _PARCArenaMemory_Alignment);
+            arena->bytesUsed = arena->bytesUsed - (size_t) (arena->next - memory) + (size_t) (next - memory);
+            arena->next = next;
+            header->length = newSize;
+            return memory;
+        }
+    }
+
+    void *result = parcArenaMemory_Allocate(newSize);
+    if (result != NULL) {
+        memcpy(result, memory, (header->length < newSize) ? header->length : newSize);
+        parcArenaMemory_Deallocate(&pointer);
+    }
+    return result;
+}
+
+char *
+parcArenaMemory_StringDuplicate(const char *string, size_t length)
+{
+    size_t actualLength = strnlen(string, length);
+
+    char *result = parcArenaMemory_Allocate(actualLength + 1);
+    if (result != NULL) {
+        memcpy(result, string, actualLength);
+        result[actualLength] = 0;
+    }
+    return result;
+}
+
+uint32_t
+parcArenaMemory_Outstanding(void)
+{
+    return parcStdlibMemory_Outstanding() + __atomic_load_n(&_parcArenaMemory_Regions, __ATOMIC_RELAXED);
+}
+
+PARCMemoryInterface PARCArenaMemoryAsPARCMemory = {
+    .Allocate         = (uintptr_t) parcArenaMemory_Allocate,
+    .AllocateAndClear = (uintptr_t) parcArenaMemory_AllocateAndClear,
+    .MemAlign         = (uintptr_t) parcArenaMemory_MemAlign,
+    .Deallocate       = (uintptr_t) parcArenaMemory_Deallocate,
+    .Reallocate       = (uintptr_t) parcArenaMemory_Reallocate,
+    .StringDuplicate  = (uintptr_t) parcArenaMemory_StringDuplicate,
+    .Outstanding      = (uintptr_t) parcArenaMemory_Outstanding
+};
@@ -0,0 +1,397 @@
+/*
+ * Copyright (c) 2015, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @file parc_ArenaMemory.h
+ * @ingroup memory
+ * @brief A PARC Memory provider that allocates from bump-pointer regions that are freed all at once.
+ *
+ * A `PARCArenaMemory` is a region of memory from which allocations are made by advancing a pointer.
+ * Individual deallocations cost nothing and return no memory,
+ * instead all of the memory allocated from the arena is reclaimed at once by `parcArenaMemory_Reset` or `parcArenaMemory_Destroy`.
+ * This suits request-scoped work, such as parsing a message with `parcJSON_ParseBuffer` or `parcURI_Parse`,
+ * which makes thousands of small allocations that all die together.
+ *
+ * `PARCArenaMemoryAsPARCMemory` is a `PARCMemoryInterface` that allocates from the calling thread's current arena,
+ * set with `parcArenaMemory_SetCurrent`.
+ * A thread with no current arena allocates from the heap, via the `PARCStdlibMemory` provider,
+ * so the interface may be installed process-wide and arenas used only by the threads and for the durations that want them.
+ * Memory may be deallocated or reallocated by any thread regardless of where it was allocated.
+ *
+ * Each allocation carries a small header identifying where it came from.
+ * To enable this facade, you must include the following line in your execution before any allocations are performed.
+ *
+ * @code
+ * {
+ *     parcMemory_SetInterface(&PARCArenaMemoryAsPARCMemory);
+ * }
+ * @endcode
+ *
+ * An arena is not thread-safe, it must only be current in one thread at a time.
+ * No memory allocated from an arena may be used after the arena is reset or destroyed.
+ *
+ * @author Glenn Scott, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#ifndef PARCLibrary_parc_ArenaMemory_h
+#define PARCLibrary_parc_ArenaMemory_h
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <parc/algol/parc_Memory.h>
+
+struct parc_arena_memory;
+typedef struct parc_arena_memory PARCArenaMemory;
+
+/**
+ * @typedef PARCArenaMemoryFlags
+ * @brief Options for the creation of a `PARCArenaMemory`.
+ */
+typedef enum {
+    PARCArenaMemoryFlags_None = 0,
+    /**
+     * Back the arena with regions that are multiples of 2 MiB mapped directly from the operating system,
+     * and advise the operating system to use huge pages for them where it supports them.
+     */
+    PARCArenaMemoryFlags_HugePages = 1
+} PARCArenaMemoryFlags;
+
+extern PARCMemoryInterface PARCArenaMemoryAsPARCMemory;
+
+/**
+ * Create a new, empty `PARCArenaMemory`.
+ *
+ * The arena obtains memory from the system in regions starting at @p regionSize bytes,
+ * doubling the size of each successive region up to a limit.
+ * An allocation larger than a region is given a region of its own.
+ *
+ * @param [in] regionSize The size of the first region, or 0 for the default.
+ * @param [in] flags A combination of `PARCArenaMemoryFlags`.
+ *
+ * @return non-NULL A pointer to a new `PARCArenaMemory` that must be destroyed with `parcArenaMemory_Destroy`.
+ * @return NULL Memory could not be allocated.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCArenaMemory *arena = parcArenaMemory_Create(0, PARCArenaMemoryFlags_None);
+ *
+ *     parcArenaMemory_Destroy(&arena);
+ * }
+ * @endcode
+ */
+PARCArenaMemory *parcArenaMemory_Create(size_t regionSize, PARCArenaMemoryFlags flags);
+
+/**
+ * Destroy a `PARCArenaMemory`, reclaiming all of the memory allocated from it.
+ *
+ * The arena must not be the current arena of any thread.
+ *
+ * @param [in,out] arenaPtr A pointer to a pointer to the arena, which is set to NULL.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCArenaMemory *arena = parcArenaMemory_Create(0, PARCArenaMemoryFlags_None);
+ *
+ *     parcArenaMemory_Destroy(&arena);
+ * }
+ * @endcode
+ */
+void parcArenaMemory_Destroy(PARCArenaMemory **arenaPtr);
+
+/**
+ * Reclaim all of the memory allocated from the given arena, making it available for new allocations.
+ *
+ * The largest region is retained so that an arena used repeatedly for similar work
+ * stops obtaining memory from the system.
+ *
+ * @param [in] arena A pointer to a valid `PARCArenaMemory`.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCArenaMemory *arena = parcArenaMemory_Create(0, PARCArenaMemoryFlags_None);
+ *     PARCArenaMemory *previous = parcArenaMemory_SetCurrent(arena);
+ *
+ *     PARCJSON *json = parcJSON_ParseString(message);
+ *     ...
+ *     parcJSON_Release(&json);
+ *
+ *     parcArenaMemory_SetCurrent(previous);
+ *     parcArenaMemory_Reset(arena);
+ * }
+ * @endcode
+ */
+void parcArenaMemory_Reset(PARCArenaMemory *arena);
+
+/**
+ * Set the arena from which `PARCArenaMemoryAsPARCMemory` allocates in the calling thread.
+ *
+ * @param [in] arena A pointer to a valid `PARCArenaMemory`, or NULL to allocate from the heap.
+ *
+ * @return The previous current arena of the calling thread, which may be NULL.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCArenaMemory *previous = parcArenaMemory_SetCurrent(arena);
+ *     ...
+ *     parcArenaMemory_SetCurrent(previous);
+ * }
+ * @endcode
+ */
+PARCArenaMemory *parcArenaMemory_SetCurrent(PARCArenaMemory *arena);
+
+/**
+ * Get the arena from which `PARCArenaMemoryAsPARCMemory` allocates in the calling thread.
+ *
+ * @return The current arena of the calling thread, or NULL if the thread allocates from the heap.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCArenaMemory *arena = parcArenaMemory_GetCurrent();
+ * }
+ * @endcode
+ */
+PARCArenaMemory *parcArenaMemory_GetCurrent(void);
+
+/**
+ * Get the calling thread's own arena, creating it if necessary.
+ *
+ * The thread arena is destroyed when the thread exits.
+ * It is not made current by this function.
+ *
+ * @return A pointer to the calling thread's arena, or NULL if memory could not be allocated.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCArenaMemory *arena = parcArenaMemory_ThreadArena();
+ *     PARCArenaMemory *previous = parcArenaMemory_SetCurrent(arena);
+ *     ...
+ *     parcArenaMemory_SetCurrent(previous);
+ *     parcArenaMemory_Reset(arena);
+ * }
+ * @endcode
+ */
+PARCArenaMemory *parcArenaMemory_ThreadArena(void);
+
+/**
+ * Return the number of bytes allocated from the given arena since it was created or last reset,
+ * including the headers and alignment padding of each allocation.
+ *
+ * @param [in] arena A pointer to a valid `PARCArenaMemory`.
+ *
+ * @return The number of bytes allocated from the arena.
+ *
+ * Example:
+ * @code
+ * {
+ *     size_t used = parcArenaMemory_BytesUsed(arena);
+ * }
+ * @endcode
+ */
+size_t parcArenaMemory_BytesUsed(const PARCArenaMemory *arena);
+
+/**
+ * Return the number of bytes the given arena holds from the system.
+ *
+ * @param [in] arena A pointer to a valid `PARCArenaMemory`.
+ *
+ * @return The total size of the arena's regions.
+ *
+ * Example:
+ * @code
+ * {
+ *     size_t reserved = parcArenaMemory_BytesReserved(arena);
+ * }
+ * @endcode
+ */
+size_t parcArenaMemory_BytesReserved(const PARCArenaMemory *arena);
+
+/**
+ * Allocate memory from the calling thread's current arena, or from the heap if there is none.
+ *
+ * @param [in] size The number of bytes to allocate.
+ *
+ * @return A pointer to the allocated memory, aligned on 16 bytes, or NULL if @p size is 0 or memory could not be allocated.
+ *
+ * Example:
+ * @code
+ * {
+ *     void *memory = parcArenaMemory_Allocate(100);
+ *     parcArenaMemory_Deallocate(&memory);
+ * }
+ * @endcode
+ */
+void *parcArenaMemory_Allocate(size_t size);
+
+/**
+ * Perform the same operation as `parcArenaMemory_Allocate` and set each byte of the allocated memory to zero.
+ *
+ * @param [in] size The number of bytes to allocate.
+ *
+ * @return A pointer to the allocated memory, or NULL if @p size is 0 or memory could not be allocated.
+ *
+ * Example:
+ * @code
+ * {
+ *     void *memory = parcArenaMemory_AllocateAndClear(100);
+ *     parcArenaMemory_Deallocate(&memory);
+ * }
+ * @endcode
+ */
+void *parcArenaMemory_AllocateAndClear(size_t size);
+
+/**
+ * Allocate memory aligned on a multiple of @p alignment from the calling thread's current arena, or from the heap.
+ *
+ * @param [out] pointer Set to the address of the allocated memory.
+ * @param [in] alignment A power of 2 greater than or equal to `sizeof(void *)`.
+ * @param [in] size The number of bytes to allocate.
+ *
+ * @return 0 Successful
+ * @return EINVAL The alignment is not a power of 2 at least as large as `sizeof(void *)`, or the size is 0.
+ * @return ENOMEM Memory allocation error.
+ *
+ * Example:
+ * @code
+ * {
+ *     void *memory;
+ *     if (parcArenaMemory_MemAlign(&memory, 64, 100) == 0) {
+ *         parcArenaMemory_Deallocate(&memory);
+ *     }
+ * }
+ * @endcode
+ */
+int parcArenaMemory_MemAlign(void **pointer, size_t alignment, size_t size);
+
+/**
+ * Deallocate memory allocated by this provider.
+ *
+ * Heap memory is freed. Arena memory is reclaimed when its arena is reset or destroyed,
+ * except that the most recent allocation from the calling thread's current arena is reclaimed immediately.
+ *
+ * @param [in,out] pointer A pointer to the pointer to the memory, which is set to NULL.
+ *
+ * Example:
+ * @code
+ * {
+ *     void *memory = parcArenaMemory_Allocate(100);
+ *     parcArenaMemory_Deallocate(&memory);
+ * }
+ * @endcode
+ */
+void parcArenaMemory_Deallocate(void **pointer);
+
+/**
+ * Resize memory allocated by this provider.
+ *
+ * The most recent allocation from the calling thread's current arena is grown in place when the region has room.
+ * Otherwise new memory is allocated as by `parcArenaMemory_Allocate`, the content is copied and the original is deallocated.
+ *
+ * @param [in] pointer A pointer to memory allocated by this provider, or NULL.
+ * @param [in] newSize The new size of the memory.
+ *
+ * @return A pointer to the resized memory, or NULL if memory could not be allocated.
+ *
+ * Example:
+ * @code
+ * {
+ *     void *memory = parcArenaMemory_Allocate(100);
+ *     memory = parcArenaMemory_Reallocate(memory, 200);
+ *     parcArenaMemory_Deallocate(&memory);
+ * }
+ * @endcode
+ */
+void *parcArenaMemory_Reallocate(void *pointer, size_t newSize);
+
+/**
+ * Allocate a null-terminated copy of at most @p length characters of the given string.
+ *
+ * @param [in] string A pointer to a null-terminated string.
+ * @param [in] length The maximum length of the copy.
+ *
+ * @return A pointer to the copy, or NULL if memory could not be allocated.
+ *
+ * Example:
+ * @code
+ * {
+ *     char *copy = parcArenaMemory_StringDuplicate("Hello World", 11);
+ *     parcArenaMemory_Deallocate((void **) &copy);
+ * }
+ * @endcode
+ */
+char *parcArenaMemory_StringDuplicate(const char *string, size_t length);
+
+/**
+ * Return the number of outstanding heap allocations plus the number of regions held by all arenas.
+ *
+ * Allocations from an arena are not counted individually, they are outstanding until the arena is reset or destroyed.
+ *
+ * @return The number of outstanding allocations.
+ *
+ * Example:
+ * @code
+ * {
+ *     uint32_t outstanding = parcArenaMemory_Outstanding();
+ * }
+ * @endcode
+ */
+uint32_t parcArenaMemory_Outstanding(void);
+#endif // PARCLibrary_parc_ArenaMemory_h
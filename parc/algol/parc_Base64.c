@@ -71,6 +71,12 @@
  * ascii value 95, is we can detect it as outside base64.  Similarly, all the
  * invalid characters have the symbol "~", which is ascii 127.
  *
+ * The bulk of the work is done a block at a time by a codec selected once at run
+ * time: SSSE3 or AVX2 where the processor has them, otherwise a scalar table lookup
+ * of whole quanta.  The output size is computed up front, so everything is written
+ * straight into one contiguous output area.  Only the final padded quantum, line
+ * breaks, and errors go through the quantum-at-a-time code below.
+ *
  * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
  * @copyright (c) 2013-2014, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
  */
@@ -79,6 +85,11 @@
 
 #include <stdio.h>
 #include <string.h>
+#include <pthread.h>
+
+#ifdef __x86_64__
+#include <immintrin.h>
+#endif
 
 #include <LongBow/runtime.h>
 
@@ -119,69 +130,48 @@ const uint8_t decodeTable[256] = {
  * It includes `padLength` of pad necessary at the end.
  */
 static void
-_encodeWithPad(PARCBufferComposer *output, const uint8_t *quantum, size_t padLength)
+_encodeWithPad(uint8_t output[4], const uint8_t *quantum, size_t padLength)
 {
     assertTrue(padLength < 3, "Degenerate case -- should never pad all 3 bytes!");
 
-    unsigned index;
-
     uint8_t paddedQuantum[] = { 0, 0, 0 };
     memcpy(paddedQuantum, quantum, 3 - padLength);
 
-    for (index = 0; index < 4; index++) {
+    /*
+     * The four base64 symbols fall in to these locations in the
+     * 3-byte input
+     *
+     * aaaaaabb | bbbbcccc | ccdddddd
+     */
+    uint32_t bits = (paddedQuantum[0] << 16) | (paddedQuantum[1] << 8) | paddedQuantum[2];
+    for (unsigned index = 0; index < 4; index++) {
         if (index + padLength < 4) {
-            /*
-             * The four base64 symbols fall in to these locations in the
-             * 3-byte input
-             *
-             * aaaaaabb | bbbbcccc | ccdddddd
-             *
-             * This switch statement, based on the "a" "b" "c" or "d" case
-             * extracts the corresponding 6 bits from its location in the
-             * byte aray.
-             */
-            int sixbit = 0;
-            switch (index) {
-                case 0: // aaaaaa
-                    sixbit = paddedQuantum[0] >> 2;
-                    break;
-
-                case 1: // bbbbbb
-                    sixbit = ((paddedQuantum[0] & 0x03) << 4) | (paddedQuantum[1] >> 4);
-                    break;
-
-                case 2: // cccccc
-                    sixbit = ((paddedQuantum[1] & 0x0F) << 2) | (paddedQuantum[2] >> 6);
-                    break;
-
-                case 3: // dddddd
-                    sixbit = paddedQuantum[2] & 0x3F;
-                    break;
-            }
-            uint8_t encodedChar = base64code[ sixbit ];
-            parcBufferComposer_PutUint8(output, encodedChar);
+            output[index] = base64code[(bits >> (18 - 6 * index)) & 0x3F];
         } else {
-            parcBufferComposer_PutUint8(output, pad);
+            output[index] = pad;
         }
     }
 }
 
 /**
  * Decode the 4-byte quantum of base64 to binary.
+ *
+ * A pad character contributes no bits.  The number of bytes produced is the index of the
+ * last symbol that is not a pad, so "Zg==" produces 1 byte and "Zm9v" produces 3.
  */
 static bool
-_decode(PARCBufferComposer *output, uint8_t *quantum)
+_decode(uint8_t output[3], const uint8_t quantum[4], size_t *length)
 {
-    uint8_t threebytes[3] = { 0, 0, 0 };
-    size_t length_to_append = 0;
+    uint32_t bits = 0;
+    size_t lengthToAppend = 0;
 
-    for (int index = 0; index < 4; index++) {
+    for (unsigned index = 0; index < 4; index++) {
         uint8_t c = quantum[index];
         if (c != pad) {
             uint8_t value = decodeTable[c];
 
             // if its a non-base64 character, bail out of here
-            if (value == invalid) {
+            if (value >= 64) {
                 return false;
             }
 
@@ -191,41 +181,419 @@ _decode(PARCBufferComposer *output, uint8_t *quantum)
              *
              * aaaaaabb | bbbbcccc | ccdddddd
              */
-            switch (index) {
-                case 0: // aaaaaa
-                    threebytes[0] |= value << 2;
-                    break;
+            bits |= (uint32_t) value << (18 - 6 * index);
+            lengthToAppend = index;
+        }
+    }
 
-                case 1: // bbbbbb
-                    threebytes[0] |= (value & 0x30) >> 4;
-                    threebytes[1] |= (value & 0x0F) << 4;
+    output[0] = (uint8_t) (bits >> 16);
+    output[1] = (uint8_t) (bits >> 8);
+    output[2] = (uint8_t) bits;
+    *length = lengthToAppend;
+    return true;
+}
 
-                    // we've finished threebytes[0]
-                    length_to_append = 1;
-                    break;
+/*
+ * A codec converts as many whole blocks as it can and returns the number of input bytes it consumed,
+ * always a multiple of 3 for encoding and of 4 for decoding.  Encoding writes 4 characters for every 3
+ * bytes consumed.  Decoding writes 3 bytes for every 4 characters consumed, and stops at the first
+ * character that is not in the base64 alphabet (including pads and line breaks) or when the output
+ * space runs out, leaving the rest to the quantum-at-a-time code.
+ */
+typedef struct {
+    size_t (*encodeBlocks)(uint8_t *output, const uint8_t *input, size_t length);
+    size_t (*decodeBlocks)(uint8_t *output, size_t outputLength, const uint8_t *input, size_t length);
+} _PARCBase64Codec;
 
-                case 2: // cccccc
-                    threebytes[1] |= value >> 2;
-                    threebytes[2] |= (value & 0x03) << 6;
+static size_t
+_parcBase64_EncodeBlocks_Scalar(uint8_t *output, const uint8_t *input, size_t length)
+{
+    size_t i = 0;
+    for (; i + 3 <= length; i += 3) {
+        uint32_t bits = (input[i] << 16) | (input[i + 1] << 8) | input[i + 2];
+        output[0] = base64code[bits >> 18];
+        output[1] = base64code[(bits >> 12) & 0x3F];
+        output[2] = base64code[(bits >> 6) & 0x3F];
+        output[3] = base64code[bits & 0x3F];
+        output += 4;
+    }
+    return i;
+}
 
-                    // we've finished threebytes[1]
-                    length_to_append = 2;
-                    break;
+static size_t
+_parcBase64_DecodeBlocks_Scalar(uint8_t *output, size_t outputLength, const uint8_t *input, size_t length)
+{
+    size_t i = 0;
+    for (; i + 4 <= length && outputLength >= 3; i += 4) {
+        uint32_t a = decodeTable[input[i]];
+        uint32_t b = decodeTable[input[i + 1]];
+        uint32_t c = decodeTable[input[i + 2]];
+        uint32_t d = decodeTable[input[i + 3]];
+
+        // Valid symbols are 0..63, the invalid and skip markers both have bit 6 set.
+        if (((a | b | c | d) & 0xC0) != 0) {
+            break;
+        }
+        uint32_t bits = (a << 18) | (b << 12) | (c << 6) | d;
+        output[0] = (uint8_t) (bits >> 16);
+        output[1] = (uint8_t) (bits >> 8);
+        output[2] = (uint8_t) bits;
+        output += 3;
+        outputLength -= 3;
+    }
+    return i;
+}
+
+static const _PARCBase64Codec _parcBase64_ScalarCodec = {
+    .encodeBlocks = _parcBase64_EncodeBlocks_Scalar,
+    .decodeBlocks = _parcBase64_DecodeBlocks_Scalar,
+};
 
-                case 3: // dddddd
-                    threebytes[2] |= value;
+#ifdef __x86_64__
+/*
+ * The vector codecs follow Wojciech Muła's and Alfred Klomp's well known formulation.
+ *
+ * Encoding shuffles each 3 input bytes into a 32-bit lane, uses multiplies to move the four 6-bit
+ * fields into the low bits of four bytes, then maps the values 0..63 onto the alphabet by adding
+ * an offset chosen by a 16-entry table lookup.
+ *
+ * Decoding classifies every character by its high and low nibble at once, which both validates the
+ * block and selects the offset that maps the character back to 0..63, then packs the 6-bit fields
+ * back together with multiply-adds and a final shuffle.
+ */
+__attribute__((target("ssse3")))
+static inline __m128i
+_parcBase64_EncodeReshuffle_SSSE3(__m128i input)
+{
+    input = _mm_shuffle_epi8(input, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+    __m128i ac = _mm_mulhi_epu16(_mm_and_si128(input, _mm_set1_epi32(0x0fc0fc00)), _mm_set1_epi32(0x04000040));
+    __m128i bd = _mm_mullo_epi16(_mm_and_si128(input, _mm_set1_epi32(0x003f03f0)), _mm_set1_epi32(0x01000010));
+    return _mm_or_si128(ac, bd);
+}
+
+__attribute__((target("ssse3")))
+static inline __m128i
+_parcBase64_EncodeTranslate_SSSE3(__m128i values)
+{
+    const __m128i offsets = _mm_setr_epi8(65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0);
+    __m128i indices = _mm_subs_epu8(values, _mm_set1_epi8(51));
+    indices = _mm_sub_epi8(indices, _mm_cmpgt_epi8(values, _mm_set1_epi8(25)));
+    return _mm_add_epi8(values, _mm_shuffle_epi8(offsets, indices));
+}
+
+__attribute__((target("ssse3")))
+static size_t
+_parcBase64_EncodeBlocks_SSSE3(uint8_t *output, const uint8_t *input, size_t length)
+{
+    // Each block reads 16 bytes and encodes the first 12 of them.
+    size_t i = 0;
+    for (; i + sizeof(__m128i) <= length; i += 12) {
+        __m128i block = _mm_loadu_si128((const __m128i *) &input[i]);
+        block = _parcBase64_EncodeTranslate_SSSE3(_parcBase64_EncodeReshuffle_SSSE3(block));
+        _mm_storeu_si128((__m128i *) output, block);
+        output += sizeof(__m128i);
+    }
+    return i;
+}
 
-                    // we've finished threebytes[2]
-                    length_to_append = 3;
-                    break;
+__attribute__((target("ssse3")))
+static size_t
+_parcBase64_DecodeBlocks_SSSE3(uint8_t *output, size_t outputLength, const uint8_t *input, size_t length)
+{
+    const __m128i lutLo = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                        0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    const __m128i lutHi = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                                        0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m128i lutRoll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i mask2F = _mm_set1_epi8(0x2F);
+    const __m128i zero = _mm_setzero_si128();
+
+    // Each block decodes 16 characters to 12 bytes, but stores 16.
+    size_t i = 0;
+    for (; i + sizeof(__m128i) <= length && outputLength >= sizeof(__m128i); i += sizeof(__m128i)) {
+        __m128i block = _mm_loadu_si128((const __m128i *) &input[i]);
+        __m128i hiNibbles = _mm_and_si128(_mm_srli_epi32(block, 4), mask2F);
+        __m128i lo = _mm_shuffle_epi8(lutLo, _mm_and_si128(block, mask2F));
+        __m128i hi = _mm_shuffle_epi8(lutHi, hiNibbles);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(lo, hi), zero)) != 0xFFFF) {
+            break;
+        }
+        __m128i roll = _mm_shuffle_epi8(lutRoll, _mm_add_epi8(_mm_cmpeq_epi8(block, mask2F), hiNibbles));
+        block = _mm_add_epi8(block, roll);
+
+        block = _mm_maddubs_epi16(block, _mm_set1_epi32(0x01400140));
+        block = _mm_madd_epi16(block, _mm_set1_epi32(0x00011000));
+        block = _mm_shuffle_epi8(block, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+        _mm_storeu_si128((__m128i *) output, block);
+        output += 12;
+        outputLength -= 12;
+    }
+    return i;
+}
+
+static const _PARCBase64Codec _parcBase64_SSSE3Codec = {
+    .encodeBlocks = _parcBase64_EncodeBlocks_SSSE3,
+    .decodeBlocks = _parcBase64_DecodeBlocks_SSSE3,
+};
+
+__attribute__((target("avx2")))
+static size_t
+_parcBase64_EncodeBlocks_AVX2(uint8_t *output, const uint8_t *input, size_t length)
+{
+    const __m256i shuffle = _mm256_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1,
+                                            10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+    const __m256i offsets = _mm256_setr_epi8(65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0,
+                                             65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0);
+
+    // Each block encodes 24 bytes, 12 in each lane, reading 28.
+    size_t i = 0;
+    for (; i + 12 + sizeof(__m128i) <= length; i += 24) {
+        __m256i block = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i *) &input[i])),
+                                                _mm_loadu_si128((const __m128i *) &input[i + 12]), 1);
+        block = _mm256_shuffle_epi8(block, shuffle);
+        __m256i ac = _mm256_mulhi_epu16(_mm256_and_si256(block, _mm256_set1_epi32(0x0fc0fc00)), _mm256_set1_epi32(0x04000040));
+        __m256i bd = _mm256_mullo_epi16(_mm256_and_si256(block, _mm256_set1_epi32(0x003f03f0)), _mm256_set1_epi32(0x01000010));
+        block = _mm256_or_si256(ac, bd);
+
+        __m256i indices = _mm256_subs_epu8(block, _mm256_set1_epi8(51));
+        indices = _mm256_sub_epi8(indices, _mm256_cmpgt_epi8(block, _mm256_set1_epi8(25)));
+        block = _mm256_add_epi8(block, _mm256_shuffle_epi8(offsets, indices));
+        _mm256_storeu_si256((__m256i *) output, block);
+        output += sizeof(__m256i);
+    }
+    return i + _parcBase64_EncodeBlocks_SSSE3(output, &input[i], length - i);
+}
+
+__attribute__((target("avx2")))
+static size_t
+_parcBase64_DecodeBlocks_AVX2(uint8_t *output, size_t outputLength, const uint8_t *input, size_t length)
+{
+    const __m256i lutLo = _mm256_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                           0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A,
+                                           0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                           0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    const __m256i lutHi = _mm256_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                                           0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+                                           0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                                           0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m256i lutRoll = _mm256_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+                                             0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m256i mask2F = _mm256_set1_epi8(0x2F);
+    const __m256i pack = _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                                          2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+
+    // Each block decodes 32 characters to 24 bytes, but stores 32.
+    size_t i = 0;
+    for (; i + sizeof(__m256i) <= length && outputLength >= sizeof(__m256i); i += sizeof(__m256i)) {
+        __m256i block = _mm256_loadu_si256((const __m256i *) &input[i]);
+        __m256i hiNibbles = _mm256_and_si256(_mm256_srli_epi32(block, 4), mask2F);
+        __m256i lo = _mm256_shuffle_epi8(lutLo, _mm256_and_si256(block, mask2F));
+        __m256i hi = _mm256_shuffle_epi8(lutHi, hiNibbles);
+        if (!_mm256_testz_si256(lo, hi)) {
+            break;
+        }
+        __m256i roll = _mm256_shuffle_epi8(lutRoll, _mm256_add_epi8(_mm256_cmpeq_epi8(block, mask2F), hiNibbles));
+        block = _mm256_add_epi8(block, roll);
+
+        block = _mm256_maddubs_epi16(block, _mm256_set1_epi32(0x01400140));
+        block = _mm256_madd_epi16(block, _mm256_set1_epi32(0x00011000));
+        block = _mm256_shuffle_epi8(block, pack);
+        block = _mm256_permutevar8x32_epi32(block, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+        _mm256_storeu_si256((__m256i *) output, block);
+        output += 24;
+        outputLength -= 24;
+    }
+    return i + _parcBase64_DecodeBlocks_SSSE3(output, outputLength, &input[i], length - i);
+}
+
+static const _PARCBase64Codec _parcBase64_AVX2Codec = {
+    .encodeBlocks = _parcBase64_EncodeBlocks_AVX2,
+    .decodeBlocks = _parcBase64_DecodeBlocks_AVX2,
+};
+#endif // __x86_64__
+
+static const _PARCBase64Codec *_parcBase64_Codec = &_parcBase64_ScalarCodec;
+static pthread_once_t _parcBase64_CodecOnce = PTHREAD_ONCE_INIT;
+
+static void
+_parcBase64_SelectCodec(void)
+{
+#ifdef __x86_64__
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        _parcBase64_Codec = &_parcBase64_AVX2Codec;
+    } else if (__builtin_cpu_supports("ssse3")) {
+        _parcBase64_Codec = &_parcBase64_SSSE3Codec;
+    }
+#endif
+}
+
+static const _PARCBase64Codec *
+_parcBase64_GetCodec(void)
+{
+    pthread_once(&_parcBase64_CodecOnce, _parcBase64_SelectCodec);
+    return _parcBase64_Codec;
+}
+
+/*
+ * Encode `length` bytes into exactly parcBase64_EncodedLength(length) characters at `output`.
+ */
+static void
+_parcBase64_Encode(const _PARCBase64Codec *codec, uint8_t *output, size_t length, const uint8_t *input)
+{
+    size_t consumed = codec->encodeBlocks(output, input, length);
+    consumed += _parcBase64_EncodeBlocks_Scalar(&output[consumed / 3 * 4], &input[consumed], length - consumed);
+
+    if (consumed < length) {
+        _encodeWithPad(&output[consumed / 3 * 4], &input[consumed], 3 - (length - consumed));
+    }
+}
+
+/*
+ * Decode `length` characters into at most `outputLength` bytes at `output`,
+ * skipping line breaks and honouring pads as _decode() does.
+ *
+ * Returns false if there is a non-base64 character or an incomplete quantum.
+ */
+static bool
+_parcBase64_Decode(const _PARCBase64Codec *codec, uint8_t *output, size_t outputLength,
+                   size_t length, const uint8_t *input, size_t *decodedLength)
+{
+    size_t in = 0;
+    size_t out = 0;
+
+    while (in < length) {
+        size_t consumed = codec->decodeBlocks(&output[out], outputLength - out, &input[in], length - in);
+        in += consumed;
+        out += consumed / 4 * 3;
+        consumed = _parcBase64_DecodeBlocks_Scalar(&output[out], outputLength - out, &input[in], length - in);
+        in += consumed;
+        out += consumed / 4 * 3;
+
+        if (in == length) {
+            break;
+        }
+
+        // A line break, a pad, a non-base64 character, or a short final quantum.
+        if (decodeTable[input[in]] == skip) {
+            in++;
+            continue;
+        }
+
+        size_t index = 0;
+        uint8_t quantum[4];
+        while (index < 4 && in < length) {
+            uint8_t c = input[in];
+            uint8_t decoded = decodeTable[c];
+
+            if (decoded < 64 || c == pad) {
+                quantum[index++] = c;
+            } else if (decoded != skip) {
+                return false;
             }
+            in++;
+        }
+
+        uint8_t threeBytes[3];
+        size_t n;
+        if (index < 4 || !_decode(threeBytes, quantum, &n)) {
+            return false;
+        }
+        assertTrue(outputLength - out >= n, "Buffer overflow");
+        for (size_t i = 0; i < n; i++) {
+            output[out++] = threeBytes[i];
         }
     }
 
-    parcBufferComposer_PutArray(output, threebytes, length_to_append);
+    *decodedLength = out;
     return true;
 }
 
+size_t
+parcBase64_EncodedLength(size_t length)
+{
+    return (length + 2) / 3 * 4;
+}
+
+size_t
+parcBase64_DecodedLength(size_t length, const uint8_t array[length])
+{
+    if (length == 0) {
+        return 0;
+    }
+
+    size_t symbols = 0;
+    size_t end = length;
+
+    if (memchr(array, '\n', length) == NULL && memchr(array, '\r', length) == NULL) {
+        symbols = length;
+    } else {
+        for (size_t i = 0; i < length; i++) {
+            symbols += (decodeTable[array[i]] != skip);
+        }
+        while (end > 0 && decodeTable[array[end - 1]] == skip) {
+            end--;
+        }
+    }
+
+    // At most two trailing pads, which carry no data.
+    for (int i = 0; i < 2 && end > 0 && array[end - 1] == pad; i++) {
+        end--;
+        symbols--;
+    }
+    return symbols * 6 / 8;
+}
+
+PARCBuffer *
+parcBase64_EncodeArrayToBuffer(PARCBuffer *output, size_t length, const uint8_t array[length])
+{
+    size_t encodedLength = parcBase64_EncodedLength(length);
+    if (encodedLength > 0) {
+        uint8_t *encoded = parcBuffer_Overlay(output, encodedLength);
+        _parcBase64_Encode(_parcBase64_GetCodec(), encoded, length, array);
+    }
+    return output;
+}
+
+PARCBuffer *
+parcBase64_DecodeArrayToBuffer(PARCBuffer *output, size_t length, const uint8_t array[length])
+{
+    size_t remaining = parcBuffer_Remaining(output);
+    assertTrue(remaining >= parcBase64_DecodedLength(length, array), "Buffer overflow");
+
+    uint8_t *decoded = (remaining > 0) ? parcBuffer_Overlay(output, 0) : NULL;
+    size_t decodedLength;
+    if (!_parcBase64_Decode(_parcBase64_GetCodec(), decoded, remaining, length, array, &decodedLength)) {
+        return NULL;
+    }
+    return parcBuffer_SetPosition(output, parcBuffer_Position(output) + decodedLength);
+}
+
+PARCBuffer *
+parcBase64_EncodeToBuffer(const PARCBuffer *plainText)
+{
+    size_t remaining = parcBuffer_Remaining(plainText);
+    PARCBuffer *result = parcBuffer_Allocate(parcBase64_EncodedLength(remaining));
+    if (remaining > 0) {
+        parcBase64_EncodeArrayToBuffer(result, remaining, parcBuffer_Overlay((PARCBuffer *) plainText, 0));
+    }
+    return parcBuffer_Flip(result);
+}
+
+PARCBuffer *
+parcBase64_DecodeToBuffer(const PARCBuffer *encodedText)
+{
+    size_t remaining = parcBuffer_Remaining(encodedText);
+    const uint8_t *array = (remaining > 0) ? parcBuffer_Overlay((PARCBuffer *) encodedText, 0) : NULL;
+
+    PARCBuffer *result = parcBuffer_Allocate(parcBase64_DecodedLength(remaining, array));
+    if (parcBase64_DecodeArrayToBuffer(result, remaining, array) == NULL) {
+        parcBuffer_Release(&result);
+        return NULL;
+    }
+    return parcBuffer_Flip(result);
+}
+
 PARCBufferComposer *
 parcBase64_Encode(PARCBufferComposer *result, PARCBuffer *plainText)
 {
@@ -241,14 +609,16 @@ parcBase64_Encode(PARCBufferComposer *result, PARCBuffer *plainText)
 PARCBufferComposer *
 parcBase64_EncodeArray(PARCBufferComposer *output, size_t length, const uint8_t array[length])
 {
-    size_t offset = 0;
+    const _PARCBase64Codec *codec = _parcBase64_GetCodec();
 
-    // Encode 3-byte tuples
+    // Encode a whole number of quanta at a time into a local block, and append each block at once.
+    uint8_t encoded[4096];
+    size_t offset = 0;
     while (offset < length) {
-        const uint8_t *quantum = array + offset;
-        size_t padLength = 3 - min(3, length - offset);
-        _encodeWithPad(output, quantum, padLength);
-        offset += 3;
+        size_t chunk = min(length - offset, sizeof(encoded) / 4 * 3);
+        _parcBase64_Encode(codec, encoded, chunk, &array[offset]);
+        parcBufferComposer_PutArray(output, encoded, parcBase64_EncodedLength(chunk));
+        offset += chunk;
     }
 
     return output;
@@ -276,56 +646,20 @@ parcBase64_DecodeString(PARCBufferComposer *output, const char *encodedString)
 PARCBufferComposer *
 parcBase64_DecodeArray(PARCBufferComposer *output, size_t length, const uint8_t array[length])
 {
-    size_t offset = 0;
-    bool success = true;
-
-    // if we need to rollback, this is where we go
-    PARCBuffer *outputBuffer = parcBufferComposer_GetBuffer(output);
-    size_t rewind_to = parcBuffer_Position(outputBuffer);
-
-    while (offset < length && success) {
-        // filter out line feeds and carrage returns
-        // parse the input in 4-byte quantums
-        size_t index = 0;
-        uint8_t quantum[4];
-
-        // reset success at the start of each loop.  if we run out of input before
-        // we parse a full quantum, we'll fail the loop and rewind the output buffer.
-        success = false;
-
-        // 4 == quantum length for decode
-        while (index < 4 && offset < length) {
-            uint8_t c = array[offset];
-            uint8_t decoded = decodeTable[c];
-
-            if (decoded < 64 || c == pad) {
-                // this is an artifact from how the code was first written, so we
-                // pass the un-decoded character
-                quantum[index] = c;
-                index++;
-                offset++;
-                continue;
-            }
-
-            if (decoded == skip) {
-                offset++;
-                continue;
-            }
-
-            if (decoded == invalid) {
-                break;
-            }
-        }
-
-        if (index == 4) {
-            success = _decode(output, quantum);
-        }
+    // Decode everything before touching the output, so a failure leaves it as it was.
+    uint8_t local[3072];
+    size_t capacity = parcBase64_DecodedLength(length, array);
+    uint8_t *decoded = (capacity > sizeof(local)) ? parcMemory_Allocate(capacity) : local;
+    assertNotNull(decoded, "parcMemory_Allocate(%zu) returned NULL", capacity);
+
+    size_t decodedLength;
+    bool success = _parcBase64_Decode(_parcBase64_GetCodec(), decoded, capacity, length, array, &decodedLength);
+    if (success) {
+        parcBufferComposer_PutArray(output, decoded, decodedLength);
     }
 
-    if (!success) {
-        parcBuffer_SetPosition(outputBuffer, rewind_to);
-        return NULL;
+    if (decoded != local) {
+        parcMemory_Deallocate(&decoded);
     }
-
-    return output;
+    return success ? output : NULL;
 }
@@ -74,6 +74,10 @@
  * ascii value 95, is we can detect it as outside base64.  Similarly, all the
  * invalid characters have the symbol "~", which is ascii 127.
  *
+ * For bulk work, {@link parcBase64_EncodeArrayToBuffer} and {@link parcBase64_DecodeArrayToBuffer}
+ * write into a caller supplied `PARCBuffer` sized with {@link parcBase64_EncodedLength} and
+ * {@link parcBase64_DecodedLength}, using SSSE3 or AVX2 where the processor supports them.
+ *
  * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
  * @copyright (c) 2013-2014, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
  */
@@ -167,4 +171,131 @@ PARCBufferComposer *parcBase64_DecodeString(PARCBufferComposer *output, const ch
  * @endcode
  */
 PARCBufferComposer *parcBase64_DecodeArray(PARCBufferComposer *output, size_t length, const uint8_t array[length]);
+/**
+ * The number of characters in the base64 encoding of @p length bytes, including padding.
+ *
+ * @param [in] length The number of bytes to encode.
+ *
+ * @return The encoded length, 4 characters for each 3 bytes or part thereof.
+ *
+ * Example:
+ * @code
+ * {
+ *     size_t encodedLength = parcBase64_EncodedLength(5); // 8
+ * }
+ * @endcode
+ */
+size_t parcBase64_EncodedLength(size_t length);
+
+/**
+ * The number of bytes the base64 encoded @p array decodes to.
+ *
+ * Line breaks and trailing padding are not counted.
+ * The result is exact for well formed input, and never less than the decoded length of any input.
+ *
+ * @param [in] length The number of characters in @p array.
+ * @param [in] array The base64 encoded characters.
+ *
+ * @return The number of bytes needed to hold the decoded @p array.
+ *
+ * Example:
+ * @code
+ * {
+ *     size_t decodedLength = parcBase64_DecodedLength(8, (const uint8_t *) "Zm9vYmE="); // 5
+ * }
+ * @endcode
+ */
+size_t parcBase64_DecodedLength(size_t length, const uint8_t array[length]);
+
+/**
+ * Encode the array to base64, writing it to @p output at its current position.
+ *
+ * @p output must have at least `parcBase64_EncodedLength(length)` bytes remaining.
+ * Its position is advanced past the encoded characters.
+ *
+ * @param [in,out] output The `PARCBuffer` that receives the encoding.
+ * @param [in] length The length of @p array.
+ * @param [in] array The bytes to encode.
+ *
+ * @return  A pointer to the @p output
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBuffer *encoded = parcBuffer_Allocate(parcBase64_EncodedLength(length));
+ *     parcBase64_EncodeArrayToBuffer(encoded, length, array);
+ *     parcBuffer_Flip(encoded);
+ * }
+ * @endcode
+ */
+PARCBuffer *parcBase64_EncodeArrayToBuffer(PARCBuffer *output, size_t length, const uint8_t array[length]);
+
+/**
+ * Base64 decode the array, writing the result to @p output at its current position.
+ *
+ * Line breaks (CR and LF) in @p array are skipped.
+ * @p output must have at least `parcBase64_DecodedLength(length, array)` bytes remaining.
+ * On success its position is advanced past the decoded bytes,
+ * otherwise the position is left unchanged and the function returns NULL.
+ *
+ * @param [in,out] output The `PARCBuffer` that receives the decoded bytes.
+ * @param [in] length The length of @p array.
+ * @param [in] array The base64 characters to decode.
+ *
+ * @return  A pointer to the @p output, or NULL if @p array cannot be base64 decoded
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBuffer *decoded = parcBuffer_Allocate(parcBase64_DecodedLength(length, array));
+ *     if (parcBase64_DecodeArrayToBuffer(decoded, length, array) != NULL) {
+ *         parcBuffer_Flip(decoded);
+ *     }
+ * }
+ * @endcode
+ */
+PARCBuffer *parcBase64_DecodeArrayToBuffer(PARCBuffer *output, size_t length, const uint8_t array[length]);
+
+/**
+ * Encode the remaining bytes of @p plainText into a new `PARCBuffer` of exactly the encoded size.
+ *
+ * The position of @p plainText is not changed.
+ *
+ * @param [in] plainText The bytes to encode.
+ *
+ * @return A new, flipped, `PARCBuffer` containing the encoding that must be released via {@link parcBuffer_Release}.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBuffer *encoded = parcBase64_EncodeToBuffer(certificate);
+ *     ...
+ *     parcBuffer_Release(&encoded);
+ * }
+ * @endcode
+ */
+PARCBuffer *parcBase64_EncodeToBuffer(const PARCBuffer *plainText);
+
+/**
+ * Base64 decode the remaining bytes of @p encodedText into a new `PARCBuffer` of exactly the decoded size.
+ *
+ * The position of @p encodedText is not changed.
+ *
+ * @param [in] encodedText The base64 characters to decode.
+ *
+ * @return A new, flipped, `PARCBuffer` that must be released via {@link parcBuffer_Release}.
+ * @return NULL if @p encodedText cannot be base64 decoded.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBuffer *key = parcBase64_DecodeToBuffer(encodedKey);
+ *     if (key != NULL) {
+ *         ...
+ *         parcBuffer_Release(&key);
+ *     }
+ * }
+ * @endcode
+ */
+PARCBuffer *parcBase64_DecodeToBuffer(const PARCBuffer *encodedText);
 #endif // libparc_parc_Base64_h
@@ -58,6 +58,9 @@
  */
 #include <config.h>
 #include <ctype.h>
+#include <pthread.h>
+#include <string.h>
+#include <inttypes.h>
 
 #include <LongBow/runtime.h>
 #include <LongBow/debugging.h>
@@ -69,6 +72,10 @@
 #include <parc/algol/parc_DisplayIndented.h>
 #include <parc/algol/parc_HashCode.h>
 
+#ifdef __x86_64__
+#include <immintrin.h>
+#endif
+
 struct parc_buffer {
     PARCByteArray *array;
 
@@ -814,37 +821,271 @@ parcBuffer_GetBytes(PARCBuffer *buffer, size_t length, uint8_t array[length])
     return buffer;
 }
 
-uint16_t
-parcBuffer_GetUint16(PARCBuffer *buffer)
+// =====================================
+// Integer encoding
+//
+// Fixed-width integers are read and written directly at the buffer's position
+// rather than one parcBuffer_GetUint8 or parcBuffer_PutUint8 call per byte.
+// LEB128 values are decoded eight bytes at a time: the terminating byte is found from the
+// continuation bits of a 64-bit word and the 7-bit groups are compacted with shifts and masks.
+
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#  define _parcBuffer_FromBigEndian64(_value_)    __builtin_bswap64(_value_)
+#  define _parcBuffer_FromLittleEndian64(_value_) (_value_)
+#else
+#  define _parcBuffer_FromBigEndian64(_value_)    (_value_)
+#  define _parcBuffer_FromLittleEndian64(_value_) __builtin_bswap64(_value_)
+#endif
+#define _parcBuffer_ToBigEndian64(_value_) _parcBuffer_FromBigEndian64(_value_)
+
+// The longest LEB128 encoding of a uint64_t.
+#define _PARCBuffer_LEB128MaximumLength 10
+
+// The address of the byte at the buffer's position, which may be the limit.
+static inline uint8_t *
+_positionAddress(const PARCBuffer *buffer)
 {
-    uint8_t high = parcBuffer_GetUint8(buffer);
-    uint8_t low = parcBuffer_GetUint8(buffer);
+    return &parcByteArray_Array(buffer->array)[_effectivePosition(buffer)];
+}
 
-    uint16_t result = (high << 8) | low;
+static inline uint64_t
+_decodeBigEndian(const uint8_t *bytes, size_t length)
+{
+    if (length == sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, bytes, sizeof(word));
+        return _parcBuffer_FromBigEndian64(word);
+    }
 
+    uint64_t result = 0;
+    for (size_t i = 0; i < length; i++) {
+        result = result << 8 | bytes[i];
+    }
     return result;
 }
 
-uint32_t
-parcBuffer_GetUint32(PARCBuffer *buffer)
+static inline void
+_encodeBigEndian(uint8_t *bytes, size_t length, uint64_t value)
 {
-    uint32_t result = 0;
-    for (int i = 0; i < sizeof(uint32_t); i++) {
-        result = result << 8 | parcBuffer_GetUint8(buffer);
+    if (length == sizeof(uint64_t)) {
+        uint64_t word = _parcBuffer_ToBigEndian64(value);
+        memcpy(bytes, &word, sizeof(word));
+        return;
+    }
+
+    for (size_t i = length; i > 0; i--) {
+        bytes[i - 1] = (uint8_t) value;
+        value >>= 8;
     }
+}
+
+static uint64_t
+_parcBuffer_GetBigEndian(PARCBuffer *buffer, size_t length)
+{
+    parcBuffer_OptionalAssertValid(buffer);
+    _trapIfBufferUnderflow(buffer, length);
+
+    uint64_t result = _decodeBigEndian(_positionAddress(buffer), length);
+    buffer->position += length;
+
     return result;
 }
 
+static PARCBuffer *
+_parcBuffer_PutBigEndian(PARCBuffer *buffer, size_t length, uint64_t value)
+{
+    parcBuffer_OptionalAssertValid(buffer);
+    assertTrue(parcBuffer_Remaining(buffer) >= length, "Buffer overflow");
+
+    _encodeBigEndian(_positionAddress(buffer), length, value);
+    buffer->position += length;
+
+    return buffer;
+}
+
+/**
+ * Decode the LEB128 value at @p bytes.
+ *
+ * @return The number of bytes decoded, or 0 if the value is not terminated within @p available bytes
+ *         or the 10th byte would overflow 64 bits.
+ */
+static inline size_t
+_decodeLEB128(const uint8_t *bytes, size_t available, uint64_t *value)
+{
+    if (available >= sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, bytes, sizeof(word));
+        word = _parcBuffer_FromLittleEndian64(word);
+
+        uint64_t stops = ~word & 0x8080808080808080ULL;
+        if (stops != 0) {
+            size_t length = ((size_t) __builtin_ctzll(stops) >> 3) + 1;
+            uint64_t groups = word & 0x7f7f7f7f7f7f7f7fULL;
+            if (length < sizeof(uint64_t)) {
+                groups &= (1ULL << (length * 8)) - 1;
+            }
+            // Pack eight 7-bit groups into the low 56 bits: pairs, then quads, then the halves.
+            groups = ((groups & 0x7f007f007f007f00ULL) >> 1) | (groups & 0x007f007f007f007fULL);
+            groups = ((groups & 0x3fff00003fff0000ULL) >> 2) | (groups & 0x00003fff00003fffULL);
+            groups = ((groups & 0x0fffffff00000000ULL) >> 4) | (groups & 0x000000000fffffffULL);
+            *value = groups;
+            return length;
+        }
+    }
+
+    uint64_t result = 0;
+    size_t limit = available < _PARCBuffer_LEB128MaximumLength ? available : _PARCBuffer_LEB128MaximumLength;
+    for (size_t i = 0; i < limit; i++) {
+        uint64_t group = bytes[i] & 0x7f;
+        if (i == _PARCBuffer_LEB128MaximumLength - 1 && group > 1) {
+            return 0;
+        }
+        result |= group << (7 * i);
+        if ((bytes[i] & 0x80) == 0) {
+            *value = result;
+            return i + 1;
+        }
+    }
+    return 0;
+}
+
+static inline size_t
+_encodeLEB128(uint8_t bytes[_PARCBuffer_LEB128MaximumLength], uint64_t value)
+{
+    size_t length = 0;
+    while (value >= 0x80) {
+        bytes[length++] = (uint8_t) (value | 0x80);
+        value >>= 7;
+    }
+    bytes[length++] = (uint8_t) value;
+    return length;
+}
+
+static inline void
+_trapIfLEB128Invalid(const PARCBuffer *buffer, size_t remaining)
+{
+    if (remaining < _PARCBuffer_LEB128MaximumLength) {
+        trapOutOfBounds(parcBuffer_Position(buffer) + remaining, "PARCBuffer limit at %zd, LEB128 value at %zd is not terminated",
+                        parcBuffer_Limit(buffer), parcBuffer_Position(buffer));
+    }
+    trapIllegalValue(buffer, "LEB128 value at %zd exceeds 64 bits", parcBuffer_Position(buffer));
+}
+
+uint16_t
+parcBuffer_GetUint16(PARCBuffer *buffer)
+{
+    return (uint16_t) _parcBuffer_GetBigEndian(buffer, sizeof(uint16_t));
+}
+
+uint32_t
+parcBuffer_GetUint32(PARCBuffer *buffer)
+{
+    return (uint32_t) _parcBuffer_GetBigEndian(buffer, sizeof(uint32_t));
+}
+
 uint64_t
 parcBuffer_GetUint64(PARCBuffer *buffer)
 {
+    return _parcBuffer_GetBigEndian(buffer, sizeof(uint64_t));
+}
+
+uint64_t
+parcBuffer_GetUintN(PARCBuffer *buffer, size_t length)
+{
+    trapIllegalValueIf(length == 0 || length > sizeof(uint64_t), "Length must be between 1 and %zd, actual %zd", sizeof(uint64_t), length);
+
+    return _parcBuffer_GetBigEndian(buffer, length);
+}
+
+uint64_t
+parcBuffer_GetLEB128(PARCBuffer *buffer)
+{
+    parcBuffer_OptionalAssertValid(buffer);
+
+    size_t remaining = parcBuffer_Remaining(buffer);
     uint64_t result = 0;
-    for (int i = 0; i < sizeof(uint64_t); i++) {
-        result = result << 8 | parcBuffer_GetUint8(buffer);
+    size_t length = _decodeLEB128(_positionAddress(buffer), remaining, &result);
+    if (length == 0) {
+        _trapIfLEB128Invalid(buffer, remaining);
     }
+    buffer->position += length;
+
     return result;
 }
 
+PARCBuffer *
+parcBuffer_GetUint16Array(PARCBuffer *buffer, size_t count, uint16_t values[count])
+{
+    parcBuffer_OptionalAssertValid(buffer);
+    trapIllegalValueIf(count > SIZE_MAX / sizeof(uint16_t), "Count %zd is too large", count);
+    _trapIfBufferUnderflow(buffer, count * sizeof(uint16_t));
+
+    const uint8_t *bytes = _positionAddress(buffer);
+    size_t i = 0;
+#ifdef __x86_64__
+    // Swap the bytes of each 16-bit lane, eight values at a time.
+    for (; i + 8 <= count; i += 8) {
+        __m128i word = _mm_loadu_si128((const __m128i *) &bytes[i * sizeof(uint16_t)]);
+        word = _mm_or_si128(_mm_slli_epi16(word, 8), _mm_srli_epi16(word, 8));
+        _mm_storeu_si128((__m128i *) &values[i], word);
+    }
+#endif
+    for (; i < count; i++) {
+        values[i] = (uint16_t) (bytes[i * 2] << 8 | bytes[i * 2 + 1]);
+    }
+    buffer->position += count * sizeof(uint16_t);
+
+    return buffer;
+}
+
+PARCBuffer *
+parcBuffer_GetUint32Array(PARCBuffer *buffer, size_t count, uint32_t values[count])
+{
+    parcBuffer_OptionalAssertValid(buffer);
+    trapIllegalValueIf(count > SIZE_MAX / sizeof(uint32_t), "Count %zd is too large", count);
+    _trapIfBufferUnderflow(buffer, count * sizeof(uint32_t));
+
+    const uint8_t *bytes = _positionAddress(buffer);
+    size_t i = 0;
+#ifdef __x86_64__
+    // Exchange the 16-bit halves of each 32-bit lane, then swap the bytes within each half, four values at a time.
+    for (; i + 4 <= count; i += 4) {
+        __m128i word = _mm_loadu_si128((const __m128i *) &bytes[i * sizeof(uint32_t)]);
+        word = _mm_shufflehi_epi16(_mm_shufflelo_epi16(word, _MM_SHUFFLE(2, 3, 0, 1)), _MM_SHUFFLE(2, 3, 0, 1));
+        word = _mm_or_si128(_mm_slli_epi16(word, 8), _mm_srli_epi16(word, 8));
+        _mm_storeu_si128((__m128i *) &values[i], word);
+    }
+#endif
+    for (; i < count; i++) {
+        values[i] = (uint32_t) _decodeBigEndian(&bytes[i * sizeof(uint32_t)], sizeof(uint32_t));
+    }
+    buffer->position += count * sizeof(uint32_t);
+
+    return buffer;
+}
+
+PARCBuffer *
+parcBuffer_GetLEB128Array(PARCBuffer *buffer, size_t count, uint64_t values[count])
+{
+    parcBuffer_OptionalAssertValid(buffer);
+
+    const uint8_t *bytes = _positionAddress(buffer);
+    size_t remaining = parcBuffer_Remaining(buffer);
+    size_t offset = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        size_t length = _decodeLEB128(&bytes[offset], remaining - offset, &values[i]);
+        if (length == 0) {
+            buffer->position += offset;
+            _trapIfLEB128Invalid(buffer, remaining - offset);
+        }
+        offset += length;
+    }
+    buffer->position += offset;
+
+    return buffer;
+}
+
 PARCBuffer *
 parcBuffer_PutUint8(PARCBuffer *buffer, uint8_t value)
 {
@@ -860,40 +1101,58 @@ parcBuffer_PutUint8(PARCBuffer *buffer, uint8_t value)
 PARCBuffer *
 parcBuffer_PutUint16(PARCBuffer *buffer, uint16_t value)
 {
-    assertTrue(parcBuffer_Remaining(buffer) >= sizeof(uint16_t),
-               "Buffer overflow");
-
-    parcBuffer_PutUint8(buffer, (value >> 8) & 0xFF);
-    parcBuffer_PutUint8(buffer, value & 0xFF);
-    return buffer;
+    return _parcBuffer_PutBigEndian(buffer, sizeof(uint16_t), value);
 }
 
 PARCBuffer *
 parcBuffer_PutUint32(PARCBuffer *buffer, uint32_t value)
 {
-    assertTrue(parcBuffer_Remaining(buffer) >= sizeof(uint32_t),
-               "Buffer overflow");
-    for (int i = sizeof(uint32_t) - 1; i > 0; i--) {
-        uint8_t b = value >> (i * 8) & 0xFF;
-        parcBuffer_PutUint8(buffer, b);
-    }
-    parcBuffer_PutUint8(buffer, value & 0xFF);
-    return buffer;
+    return _parcBuffer_PutBigEndian(buffer, sizeof(uint32_t), value);
 }
 
 PARCBuffer *
 parcBuffer_PutUint64(PARCBuffer *buffer, uint64_t value)
 {
-    assertTrue(parcBuffer_Remaining(buffer) >= sizeof(uint64_t),
-               "Buffer overflow");
-    for (int i = sizeof(uint64_t) - 1; i > 0; i--) {
-        uint8_t b = value >> (i * 8) & 0xFF;
-        parcBuffer_PutUint8(buffer, b);
-    }
-    parcBuffer_PutUint8(buffer, value & 0xFF);
+    return _parcBuffer_PutBigEndian(buffer, sizeof(uint64_t), value);
+}
+
+PARCBuffer *
+parcBuffer_PutUintN(PARCBuffer *buffer, size_t length, uint64_t value)
+{
+    trapIllegalValueIf(length == 0 || length > sizeof(uint64_t), "Length must be between 1 and %zd, actual %zd", sizeof(uint64_t), length);
+    trapIllegalValueIf(length < sizeof(uint64_t) && (value >> (length * 8)) != 0,
+                       "Value %" PRIu64 " does not fit in %zd bytes", value, length);
+
+    return _parcBuffer_PutBigEndian(buffer, length, value);
+}
+
+PARCBuffer *
+parcBuffer_PutLEB128(PARCBuffer *buffer, uint64_t value)
+{
+    parcBuffer_OptionalAssertValid(buffer);
+
+    uint8_t bytes[_PARCBuffer_LEB128MaximumLength];
+    size_t length = _encodeLEB128(bytes, value);
+    assertTrue(parcBuffer_Remaining(buffer) >= length, "Buffer overflow");
+
+    memcpy(_positionAddress(buffer), bytes, length);
+    buffer->position += length;
+
     return buffer;
 }
 
+size_t
+parcBuffer_SizeOfUintN(uint64_t value)
+{
+    return value == 0 ? 1 : (size_t) (64 - __builtin_clzll(value) + 7) / 8;
+}
+
+size_t
+parcBuffer_SizeOfLEB128(uint64_t value)
+{
+    return value == 0 ? 1 : (size_t) (64 - __builtin_clzll(value) + 6) / 7;
+}
+
 PARCBuffer *
 parcBuffer_PutAtIndex(PARCBuffer *buffer, size_t index, uint8_t value)
 {
@@ -941,17 +1200,318 @@ parcBuffer_HashCode(const PARCBuffer *buffer)
 
     size_t remaining = parcBuffer_Remaining(buffer);
     if (remaining > 0) {
-        result = parcHashCode_Hash(parcBuffer_Overlay((PARCBuffer *) buffer, 0), parcBuffer_Remaining(buffer));
+        result = parcHashCode_HashData(parcBuffer_Overlay((PARCBuffer *) buffer, 0), parcBuffer_Remaining(buffer));
     }
     return result;
 }
 
+// =====================================
+// Byte scanning
+//
+// The search functions below run directly over the backing PARCByteArray
+// instead of fetching one byte at a time through parcBuffer_GetAtIndex.
+// On x86_64 SSE2 is always available and is used as the baseline vector implementation;
+// an AVX2 implementation is selected once at run time if the processor supports it.
+// Other architectures use the portable scalar implementation.
+
+// Byte sets of up to this many distinct members are compared in vector registers,
+// larger sets fall back to the table lookup.
+#define _PARCBuffer_VectorSetLimit 8
+
+typedef struct {
+    bool isMember[256];
+    size_t count;
+    uint8_t members[_PARCBuffer_VectorSetLimit];
+} _PARCBufferByteSet;
+
+typedef struct {
+    size_t (*findByte)(const uint8_t *bytes, size_t length, uint8_t byte);
+    size_t (*scanSet)(const uint8_t *bytes, size_t length, const _PARCBufferByteSet *set, bool member);
+    size_t (*findBytes)(const uint8_t *bytes, size_t length, const uint8_t *pattern, size_t patternLength);
+} _PARCBufferScanner;
+
+static void
+_parcBufferByteSet_Init(_PARCBufferByteSet *set, size_t length, const uint8_t bytes[length])
+{
+    memset(set->isMember, 0, sizeof(set->isMember));
+    set->count = 0;
+    for (size_t i = 0; i < length; i++) {
+        if (set->isMember[bytes[i]] == false) {
+            set->isMember[bytes[i]] = true;
+            if (set->count < _PARCBuffer_VectorSetLimit) {
+                set->members[set->count] = bytes[i];
+            }
+            set->count++;
+        }
+    }
+}
+
+/*
+ * Each scanning function returns the offset of the first match within `bytes`,
+ * or `length` if there is none.
+ */
+static size_t
+_parcBuffer_FindByte_Scalar(const uint8_t *bytes, size_t length, uint8_t byte)
+{
+    const uint8_t *match = memchr(bytes, byte, length);
+    return (match == NULL) ? length : (size_t) (match - bytes);
+}
+
+static size_t
+_parcBuffer_ScanSet_Scalar(const uint8_t *bytes, size_t length, const _PARCBufferByteSet *set, bool member)
+{
+    for (size_t i = 0; i < length; i++) {
+        if (set->isMember[bytes[i]] == member) {
+            return i;
+        }
+    }
+    return length;
+}
+
+static size_t
+_parcBuffer_FindBytes_Scalar(const uint8_t *bytes, size_t length, const uint8_t *pattern, size_t patternLength)
+{
+    if (patternLength > length) {
+        return length;
+    }
+    if (patternLength == 0) {
+        return 0;
+    }
+
+    size_t last = length - patternLength;
+    size_t i = 0;
+    while (i <= last) {
+        i += _parcBuffer_FindByte_Scalar(&bytes[i], last + 1 - i, pattern[0]);
+        if (i > last) {
+            break;
+        }
+        if (memcmp(&bytes[i + 1], &pattern[1], patternLength - 1) == 0) {
+            return i;
+        }
+        i++;
+    }
+    return length;
+}
+
+static const _PARCBufferScanner _parcBuffer_ScalarScanner = {
+    .findByte  = _parcBuffer_FindByte_Scalar,
+    .scanSet   = _parcBuffer_ScanSet_Scalar,
+    .findBytes = _parcBuffer_FindBytes_Scalar,
+};
+
+#ifdef __x86_64__
+static size_t
+_parcBuffer_FindByte_SSE2(const uint8_t *bytes, size_t length, uint8_t byte)
+{
+    const __m128i needle = _mm_set1_epi8((char) byte);
+
+    size_t i = 0;
+    for (; i + sizeof(__m128i) <= length; i += sizeof(__m128i)) {
+        __m128i block = _mm_loadu_si128((const __m128i *) &bytes[i]);
+        unsigned mask = (unsigned) _mm_movemask_epi8(_mm_cmpeq_epi8(block, needle));
+        if (mask != 0) {
+            return i + (size_t) __builtin_ctz(mask);
+        }
+    }
+    return i + _parcBuffer_FindByte_Scalar(&bytes[i], length - i, byte);
+}
+
+static size_t
+_parcBuffer_ScanSet_SSE2(const uint8_t *bytes, size_t length, const _PARCBufferByteSet *set, bool member)
+{
+    if (set->count == 0 || set->count > _PARCBuffer_VectorSetLimit) {
+        return _parcBuffer_ScanSet_Scalar(bytes, length, set, member);
+    }
+
+    __m128i needles[_PARCBuffer_VectorSetLimit];
+    for (size_t n = 0; n < set->count; n++) {
+        needles[n] = _mm_set1_epi8((char) set->members[n]);
+    }
+    const unsigned invert = member ? 0 : 0xFFFF;
+
+    size_t i = 0;
+    for (; i + sizeof(__m128i) <= length; i += sizeof(__m128i)) {
+        __m128i block = _mm_loadu_si128((const __m128i *) &bytes[i]);
+        __m128i hits = _mm_cmpeq_epi8(block, needles[0]);
+        for (size_t n = 1; n < set->count; n++) {
+            hits = _mm_or_si128(hits, _mm_cmpeq_epi8(block, needles[n]));
+        }
+        unsigned mask = (unsigned) _mm_movemask_epi8(hits) ^ invert;
+        if (mask != 0) {
+            return i + (size_t) __builtin_ctz(mask);
+        }
+    }
+    return i + _parcBuffer_ScanSet_Scalar(&bytes[i], length - i, set, member);
+}
+
+/*
+ * Compare the first and the last byte of the pattern against 16 candidate positions at once,
+ * and only confirm the candidates that match both.
+ */
+static size_t
+_parcBuffer_FindBytes_SSE2(const uint8_t *bytes, size_t length, const uint8_t *pattern, size_t patternLength)
+{
+    if (patternLength < 2 || patternLength > length) {
+        return _parcBuffer_FindBytes_Scalar(bytes, length, pattern, patternLength);
+    }
+
+    const __m128i first = _mm_set1_epi8((char) pattern[0]);
+    const __m128i final = _mm_set1_epi8((char) pattern[patternLength - 1]);
+    size_t candidates = length - patternLength + 1;
+
+    size_t i = 0;
+    for (; i + sizeof(__m128i) <= candidates; i += sizeof(__m128i)) {
+        __m128i head = _mm_loadu_si128((const __m128i *) &bytes[i]);
+        __m128i tail = _mm_loadu_si128((const __m128i *) &bytes[i + patternLength - 1]);
+        unsigned mask = (unsigned) _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(head, first), _mm_cmpeq_epi8(tail, final)));
+        while (mask != 0) {
+            size_t candidate = i + (size_t) __builtin_ctz(mask);
+            if (memcmp(&bytes[candidate + 1], &pattern[1], patternLength - 2) == 0) {
+                return candidate;
+            }
+            mask &= mask - 1;
+        }
+    }
+    return i + _parcBuffer_FindBytes_Scalar(&bytes[i], length - i, pattern, patternLength);
+}
+
+static const _PARCBufferScanner _parcBuffer_SSE2Scanner = {
+    .findByte  = _parcBuffer_FindByte_SSE2,
+    .scanSet   = _parcBuffer_ScanSet_SSE2,
+    .findBytes = _parcBuffer_FindBytes_SSE2,
+};
+
+__attribute__((target("avx2")))
+static size_t
+_parcBuffer_FindByte_AVX2(const uint8_t *bytes, size_t length, uint8_t byte)
+{
+    const __m256i needle = _mm256_set1_epi8((char) byte);
+
+    size_t i = 0;
+    for (; i + sizeof(__m256i) <= length; i += sizeof(__m256i)) {
+        __m256i block = _mm256_loadu_si256((const __m256i *) &bytes[i]);
+        unsigned mask = (unsigned) _mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle));
+        if (mask != 0) {
+            return i + (size_t) __builtin_ctz(mask);
+        }
+    }
+    return i + _parcBuffer_FindByte_SSE2(&bytes[i], length - i, byte);
+}
+
+__attribute__((target("avx2")))
+static size_t
+_parcBuffer_ScanSet_AVX2(const uint8_t *bytes, size_t length, const _PARCBufferByteSet *set, bool member)
+{
+    if (set->count == 0 || set->count > _PARCBuffer_VectorSetLimit) {
+        return _parcBuffer_ScanSet_Scalar(bytes, length, set, member);
+    }
+
+    __m256i needles[_PARCBuffer_VectorSetLimit];
+    for (size_t n = 0; n < set->count; n++) {
+        needles[n] = _mm256_set1_epi8((char) set->members[n]);
+    }
+    const unsigned invert = member ? 0 : 0xFFFFFFFF;
+
+    size_t i = 0;
+    for (; i + sizeof(__m256i) <= length; i += sizeof(__m256i)) {
+        __m256i block = _mm256_loadu_si256((const __m256i *) &bytes[i]);
+        __m256i hits = _mm256_cmpeq_epi8(block, needles[0]);
+        for (size_t n = 1; n < set->count; n++) {
+            hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(block, needles[n]));
+        }
+        unsigned mask = (unsigned) _mm256_movemask_epi8(hits) ^ invert;
+        if (mask != 0) {
+            return i + (size_t) __builtin_ctz(mask);
+        }
+    }
+    return i + _parcBuffer_ScanSet_SSE2(&bytes[i], length - i, set, member);
+}
+
+__attribute__((target("avx2")))
+static size_t
+_parcBuffer_FindBytes_AVX2(const uint8_t *bytes, size_t length, const uint8_t *pattern, size_t patternLength)
+{
+    if (patternLength < 2 || patternLength > length) {
+        return _parcBuffer_FindBytes_Scalar(bytes, length, pattern, patternLength);
+    }
+
+    const __m256i first = _mm256_set1_epi8((char) pattern[0]);
+    const __m256i final = _mm256_set1_epi8((char) pattern[patternLength - 1]);
+    size_t candidates = length - patternLength + 1;
+
+    size_t i = 0;
+    for (; i + sizeof(__m256i) <= candidates; i += sizeof(__m256i)) {
+        __m256i head = _mm256_loadu_si256((const __m256i *) &bytes[i]);
+        __m256i tail = _mm256_loadu_si256((const __m256i *) &bytes[i + patternLength - 1]);
+        unsigned mask = (unsigned) _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(head, first), _mm256_cmpeq_epi8(tail, final)));
+        while (mask != 0) {
+            size_t candidate = i + (size_t) __builtin_ctz(mask);
+            if (memcmp(&bytes[candidate + 1], &pattern[1], patternLength - 2) == 0) {
+                return candidate;
+            }
+            mask &= mask - 1;
+        }
+    }
+    return i + _parcBuffer_FindBytes_SSE2(&bytes[i], length - i, pattern, patternLength);
+}
+
+static const _PARCBufferScanner _parcBuffer_AVX2Scanner = {
+    .findByte  = _parcBuffer_FindByte_AVX2,
+    .scanSet   = _parcBuffer_ScanSet_AVX2,
+    .findBytes = _parcBuffer_FindBytes_AVX2,
+};
+#endif // __x86_64__
+
+static const _PARCBufferScanner *_parcBuffer_Scanner = &_parcBuffer_ScalarScanner;
+static pthread_once_t _parcBuffer_ScannerOnce = PTHREAD_ONCE_INIT;
+
+static void
+_parcBuffer_SelectScanner(void)
+{
+#ifdef __x86_64__
+    __builtin_cpu_init();
+    _parcBuffer_Scanner = __builtin_cpu_supports("avx2") ? &_parcBuffer_AVX2Scanner : &_parcBuffer_SSE2Scanner;
+#endif
+}
+
+static const _PARCBufferScanner *
+_parcBuffer_GetScanner(void)
+{
+    pthread_once(&_parcBuffer_ScannerOnce, _parcBuffer_SelectScanner);
+    return _parcBuffer_Scanner;
+}
+
+// The address of the byte at the buffer's position. The buffer must have remaining bytes.
+static inline const uint8_t *
+_remainingBytes(const PARCBuffer *buffer)
+{
+    return parcByteArray_AddressOfIndex(buffer->array, _effectivePosition(buffer));
+}
+
 size_t
 parcBuffer_FindUint8(const PARCBuffer *buffer, uint8_t byte)
 {
-    for (size_t i = parcBuffer_Position(buffer); i < parcBuffer_Limit(buffer); i++) {
-        if (parcBuffer_GetAtIndex(buffer, i) == byte) {
-            return i;
+    size_t remaining = parcBuffer_Remaining(buffer);
+    if (remaining > 0) {
+        size_t offset = _parcBuffer_GetScanner()->findByte(_remainingBytes(buffer), remaining, byte);
+        if (offset < remaining) {
+            return parcBuffer_Position(buffer) + offset;
+        }
+    }
+    return SIZE_MAX;
+}
+
+size_t
+parcBuffer_FindBytes(const PARCBuffer *buffer, size_t length, const uint8_t pattern[length])
+{
+    size_t remaining = parcBuffer_Remaining(buffer);
+    if (length == 0) {
+        return parcBuffer_Position(buffer);
+    }
+    if (length <= remaining) {
+        size_t offset = _parcBuffer_GetScanner()->findBytes(_remainingBytes(buffer), remaining, pattern, length);
+        if (offset < remaining) {
+            return parcBuffer_Position(buffer) + offset;
         }
     }
     return SIZE_MAX;
@@ -1018,33 +1578,33 @@ parcBuffer_ToHexString(const PARCBuffer *buffer)
     return result;
 }
 
+// Advance the buffer's position to the first byte whose membership in the set equals `member`.
+static bool
+_parcBuffer_SkipWhile(PARCBuffer *buffer, size_t length, const uint8_t bytes[length], bool member)
+{
+    size_t remaining = parcBuffer_Remaining(buffer);
+    if (remaining == 0) {
+        return false;
+    }
+
+    _PARCBufferByteSet set;
+    _parcBufferByteSet_Init(&set, length, bytes);
+
+    size_t offset = _parcBuffer_GetScanner()->scanSet(_remainingBytes(buffer), remaining, &set, member);
+    parcBuffer_SetPosition(buffer, parcBuffer_Position(buffer) + offset);
+    return offset < remaining;
+}
+
 bool
 parcBuffer_SkipOver(PARCBuffer *buffer, size_t length, const uint8_t bytesToSkipOver[length])
 {
-    while (parcBuffer_Remaining(buffer) > 0) {
-        uint8_t character = parcBuffer_GetUint8(buffer);
-        if (memchr(bytesToSkipOver, character, length) == NULL) {
-            parcBuffer_SetPosition(buffer, parcBuffer_Position(buffer) - 1);
-            return true;
-        }
-    }
-    return false;
+    return _parcBuffer_SkipWhile(buffer, length, bytesToSkipOver, false);
 }
 
 bool
 parcBuffer_SkipTo(PARCBuffer *buffer, size_t length, const uint8_t bytesToSkipTo[length])
 {
-    bool result = false;
-
-    while (parcBuffer_Remaining(buffer) > 0) {
-        uint8_t character = parcBuffer_GetUint8(buffer);
-        if (memchr(bytesToSkipTo, character, length) != NULL) {
-            parcBuffer_SetPosition(buffer, parcBuffer_Position(buffer) - 1);
-            result = true;
-            break;
-        }
-    }
-    return result;
+    return _parcBuffer_SkipWhile(buffer, length, bytesToSkipTo, true);
 }
 
 uint8_t
@@ -1210,6 +1210,127 @@ uint32_t parcBuffer_GetUint32(PARCBuffer *buffer);
  */
 uint64_t parcBuffer_GetUint64(PARCBuffer *buffer);
 
+/**
+ * Read an unsigned integer of @p length bytes in network order at the buffer's current position,
+ * and then increment the position by @p length.
+ *
+ * This is the variable length integer encoding used by CCNx TLV values, where the length
+ * of the integer is given by the enclosing TLV length.
+ * Unlike {@link parcVarint_DecodeBuffer} it allocates no memory.
+ *
+ * @param [in,out] buffer The pointer to the instance of `PARCBuffer` containing the value.
+ * @param [in] length The number of bytes in the value, from 1 to 8.
+ *
+ * @return The value at the buffer's current position.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBuffer *buffer = parcBuffer_Allocate(10);
+ *     parcBuffer_PutUintN(buffer, 3, 0x123456);
+ *     parcBuffer_Flip(buffer);
+ *     uint64_t actual = parcBuffer_GetUintN(buffer, 3);
+ * }
+ * @endcode
+ *
+ * @see parcBuffer_PutUintN
+ * @see parcBuffer_SizeOfUintN
+ */
+uint64_t parcBuffer_GetUintN(PARCBuffer *buffer, size_t length);
+
+/**
+ * Read the unsigned LEB128 encoded value at the buffer's current position,
+ * and then increment the position by the length of the encoding.
+ *
+ * LEB128 encodes 7 bits per byte, least significant group first,
+ * with the high bit of each byte set if another byte follows.
+ *
+ * @param [in,out] buffer The pointer to the instance of `PARCBuffer` containing the value.
+ *
+ * @return The decoded value.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBuffer *buffer = parcBuffer_Allocate(10);
+ *     parcBuffer_PutLEB128(buffer, 300);
+ *     parcBuffer_Flip(buffer);
+ *     uint64_t actual = parcBuffer_GetLEB128(buffer);
+ * }
+ * @endcode
+ *
+ * @throws LongBowTrapOutOfBounds The value is not terminated before the buffer's limit.
+ * @throws LongBowTrapIllegalValue The value does not fit in 64 bits.
+ *
+ * @see parcBuffer_GetLEB128Array
+ */
+uint64_t parcBuffer_GetLEB128(PARCBuffer *buffer);
+
+/**
+ * Read @p count consecutive unsigned 16-bit values in network order at the buffer's current position,
+ * and then increment the position by `2 * count`.
+ *
+ * @param [in,out] buffer The pointer to the instance of `PARCBuffer` containing the values.
+ * @param [in] count The number of values to read.
+ * @param [out] values The array to receive @p count values in host order.
+ *
+ * @return A pointer to the given `PARCBuffer` instance
+ *
+ * Example:
+ * @code
+ * {
+ *     uint16_t lengths[16];
+ *     parcBuffer_GetUint16Array(buffer, 16, lengths);
+ * }
+ * @endcode
+ */
+PARCBuffer *parcBuffer_GetUint16Array(PARCBuffer *buffer, size_t count, uint16_t values[count]);
+
+/**
+ * Read @p count consecutive unsigned 32-bit values in network order at the buffer's current position,
+ * and then increment the position by `4 * count`.
+ *
+ * @param [in,out] buffer The pointer to the instance of `PARCBuffer` containing the values.
+ * @param [in] count The number of values to read.
+ * @param [out] values The array to receive @p count values in host order.
+ *
+ * @return A pointer to the given `PARCBuffer` instance
+ *
+ * Example:
+ * @code
+ * {
+ *     uint32_t lengths[16];
+ *     parcBuffer_GetUint32Array(buffer, 16, lengths);
+ * }
+ * @endcode
+ */
+PARCBuffer *parcBuffer_GetUint32Array(PARCBuffer *buffer, size_t count, uint32_t values[count]);
+
+/**
+ * Read @p count consecutive unsigned LEB128 encoded values at the buffer's current position,
+ * and then increment the position past the last of them.
+ *
+ * This is equivalent to, and faster than, calling {@link parcBuffer_GetLEB128} @p count times.
+ *
+ * @param [in,out] buffer The pointer to the instance of `PARCBuffer` containing the values.
+ * @param [in] count The number of values to read.
+ * @param [out] values The array to receive @p count values.
+ *
+ * @return A pointer to the given `PARCBuffer` instance
+ *
+ * Example:
+ * @code
+ * {
+ *     uint64_t lengths[16];
+ *     parcBuffer_GetLEB128Array(buffer, 16, lengths);
+ * }
+ * @endcode
+ *
+ * @throws LongBowTrapOutOfBounds A value is not terminated before the buffer's limit.
+ * @throws LongBowTrapIllegalValue A value does not fit in 64 bits.
+ */
+PARCBuffer *parcBuffer_GetLEB128Array(PARCBuffer *buffer, size_t count, uint64_t values[count]);
+
 /**
  * Read an array of length bytes from the given PARCBuffer, copying them to an array.
  *
@@ -1320,6 +1441,83 @@ PARCBuffer *parcBuffer_PutUint32(PARCBuffer *buffer, uint32_t value);
  */
 PARCBuffer *parcBuffer_PutUint64(PARCBuffer *buffer, uint64_t value);
 
+/**
+ * Write an unsigned integer as @p length bytes in network order into the given buffer at the current position,
+ * and then increment the position by @p length.
+ *
+ * @param [in,out] buffer The pointer to the instance of `PARCBuffer` to receive the value.
+ * @param [in] length The number of bytes to write, from 1 to 8.
+ * @param [in] value The value to write. It must fit in @p length bytes.
+ *
+ * @return A pointer to the given `PARCBuffer` instance
+ *
+ * Example:
+ * @code
+ * {
+ *     uint64_t value = 0x123456;
+ *     PARCBuffer *buffer = parcBuffer_Allocate(10);
+ *     parcBuffer_PutUintN(buffer, parcBuffer_SizeOfUintN(value), value);
+ * }
+ * @endcode
+ *
+ * @see parcBuffer_GetUintN
+ */
+PARCBuffer *parcBuffer_PutUintN(PARCBuffer *buffer, size_t length, uint64_t value);
+
+/**
+ * Write an unsigned integer in LEB128 encoding into the given buffer at the current position,
+ * and then increment the position by the length of the encoding.
+ *
+ * @param [in,out] buffer The pointer to the instance of `PARCBuffer` to receive the value.
+ * @param [in] value The value to write.
+ *
+ * @return A pointer to the given `PARCBuffer` instance
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBuffer *buffer = parcBuffer_Allocate(10);
+ *     parcBuffer_PutLEB128(buffer, 300);
+ * }
+ * @endcode
+ *
+ * @see parcBuffer_GetLEB128
+ * @see parcBuffer_SizeOfLEB128
+ */
+PARCBuffer *parcBuffer_PutLEB128(PARCBuffer *buffer, uint64_t value);
+
+/**
+ * Return the minimum number of bytes needed to write @p value with {@link parcBuffer_PutUintN}.
+ *
+ * @param [in] value A value.
+ *
+ * @return The number of bytes, from 1 to 8.
+ *
+ * Example:
+ * @code
+ * {
+ *     size_t length = parcBuffer_SizeOfUintN(0x1234); // 2
+ * }
+ * @endcode
+ */
+size_t parcBuffer_SizeOfUintN(uint64_t value);
+
+/**
+ * Return the number of bytes {@link parcBuffer_PutLEB128} writes for @p value.
+ *
+ * @param [in] value A value.
+ *
+ * @return The number of bytes, from 1 to 10.
+ *
+ * Example:
+ * @code
+ * {
+ *     size_t length = parcBuffer_SizeOfLEB128(300); // 2
+ * }
+ * @endcode
+ */
+size_t parcBuffer_SizeOfLEB128(uint64_t value);
+
 /**
  * Insert unsigned 8-bit value to the given `PARCBuffer` at given index.
  *
@@ -1481,6 +1679,36 @@ PARCHashCode parcBuffer_HashCode(const PARCBuffer *buffer);
  */
 size_t parcBuffer_FindUint8(const PARCBuffer *buffer, uint8_t byte);
 
+/**
+ * Return the position of the first occurrence of the given sequence of bytes.
+ *
+ * The search begins at the current position and the whole sequence must lie before the limit.
+ * An empty sequence matches at the current position.
+ * The buffer's position is not changed.
+ *
+ * @param [in] buffer A pointer to a `PARCBuffer` instance.
+ * @param [in] length The number of bytes in @p pattern.
+ * @param [in] pattern The sequence of bytes to search for within the buffer.
+ *
+ * @return The index of the first byte of the first occurrence of @p pattern, or `SIZE_MAX` (<stdint.h>)
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBuffer *buffer = parcBuffer_WrapCString("Hello World");
+ *
+ *     size_t worldPosition = parcBuffer_FindBytes(buffer, 5, (uint8_t *) "World");
+ *
+ *     // worldPosition is equal to 6.
+ *
+ *     parcBuffer_Release(&buffer);
+ * }
+ * @endcode
+ *
+ * @see parcBuffer_FindUint8
+ */
+size_t parcBuffer_FindBytes(const PARCBuffer *buffer, size_t length, const uint8_t pattern[length]);
+
 /**
  * Produce a null-terminated string representation of the specified `PARCBuffer`
  * from the current position to the limit.
@@ -53,6 +53,14 @@
  * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
  */
 /**
+ * A composer appends to a single `PARCBuffer`, which is replaced by one of at least twice the capacity
+ * whenever it runs out of room.
+ *
+ * A chunked composer instead keeps the content in a list of segments.  When the current segment runs out of room
+ * it is appended to the list and a new segment, twice the size of the last up to `_MaximumSegmentSize`, is started.
+ * Nothing already composed is copied until a contiguous `PARCBuffer` is required, at which point the segments are
+ * coalesced into a single buffer once.  The segments can also be written out without coalescing them.
+ *
  * @author Glenn Scott, Palo Alto Research Center (Xerox PARC)
  * @copyright (c) 2013-2015, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
  */
@@ -64,15 +72,32 @@
 #include <stdlib.h>
 #include <stdarg.h>
 #include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <sys/uio.h>
 
 #include <parc/algol/parc_Memory.h>
 #include <parc/algol/parc_Object.h>
 #include <parc/algol/parc_BufferComposer.h>
 #include <parc/algol/parc_Buffer.h>
 
+// A chunked composer's segments grow geometrically up to this size.
+#define _MaximumSegmentSize (1024 * 1024)
+
+// The number of segments written by a single writev(2).
+#define _WriteBatchSize 64
+
 struct parc_buffer_composer {
     size_t incrementHeuristic;
     PARCBuffer *buffer;
+
+    // A chunked composer's filled segments, each flipped, preceding the content of buffer.
+    bool chunked;
+    PARCBuffer **segments;
+    size_t segmentCount;
+    size_t segmentCapacity;
+    size_t segmentBytes;
 };
 
 static void
@@ -84,6 +109,12 @@ _finalize(PARCBufferComposer **bufferPtr)
         if (composer->buffer != NULL) {
             parcBuffer_Release(&composer->buffer);
         }
+        for (size_t i = 0; i < composer->segmentCount; i++) {
+            parcBuffer_Release(&composer->segments[i]);
+        }
+        if (composer->segments != NULL) {
+            parcMemory_Deallocate(&composer->segments);
+        }
     }
 }
 
@@ -92,7 +123,72 @@ parcObject_ExtendPARCObject(PARCBufferComposer, _finalize, NULL, NULL, parcBuffe
 static PARCBufferComposer *
 _create(void)
 {
-    return parcObject_CreateInstance(PARCBufferComposer);
+    return parcObject_CreateAndClearInstance(PARCBufferComposer);
+}
+
+/**
+ * Close the current segment of a chunked composer and start a new one with room for at least the required number of bytes.
+ */
+static PARCBufferComposer *
+_appendSegment(PARCBufferComposer *composer, size_t required)
+{
+    size_t currentCapacity = parcBuffer_Capacity(composer->buffer);
+
+    if (parcBuffer_Position(composer->buffer) > 0) {
+        if (composer->segmentCount == composer->segmentCapacity) {
+            size_t segmentCapacity = composer->segmentCapacity == 0 ? 8 : composer->segmentCapacity * 2;
+            PARCBuffer **segments = parcMemory_Reallocate(composer->segments, segmentCapacity * sizeof(PARCBuffer *));
+            if (segments == NULL) {
+                return NULL;
+            }
+            composer->segments = segments;
+            composer->segmentCapacity = segmentCapacity;
+        }
+        composer->segments[composer->segmentCount++] = parcBuffer_Flip(composer->buffer);
+        composer->segmentBytes += parcBuffer_Limit(composer->buffer);
+    } else {
+        parcBuffer_Release(&composer->buffer);
+    }
+
+    size_t newCapacity = currentCapacity * 2;
+    if (newCapacity > _MaximumSegmentSize) {
+        newCapacity = _MaximumSegmentSize;
+    }
+    if (newCapacity < required) {
+        newCapacity = required;
+    }
+
+    composer->buffer = parcBuffer_Allocate(newCapacity);
+    if (composer->buffer == NULL) {
+        return NULL;
+    }
+
+    return composer;
+}
+
+/**
+ * Replace the segments of a chunked composer with a single buffer holding the same content.
+ *
+ * The content is unchanged, but the composer's buffer is replaced.
+ */
+static void
+_coalesce(PARCBufferComposer *composer)
+{
+    if (composer->segmentCount > 0) {
+        PARCBuffer *result = parcBuffer_Allocate(composer->segmentBytes + parcBuffer_Position(composer->buffer));
+        assertNotNull(result, "parcBuffer_Allocate(%zu) returned NULL", composer->segmentBytes + parcBuffer_Position(composer->buffer));
+
+        for (size_t i = 0; i < composer->segmentCount; i++) {
+            parcBuffer_PutBuffer(result, composer->segments[i]);
+            parcBuffer_Release(&composer->segments[i]);
+        }
+        parcBuffer_PutBuffer(result, parcBuffer_Flip(composer->buffer));
+        parcBuffer_Release(&composer->buffer);
+
+        composer->buffer = result;
+        composer->segmentCount = 0;
+        composer->segmentBytes = 0;
+    }
 }
 
 /**
@@ -104,6 +200,8 @@ _create(void)
  *
  * The position, limit, and mark remain unchanged.
  * The capacity is increased.
+ *
+ * A chunked composer instead starts a new segment with at least the required number of bytes.
  */
 static PARCBufferComposer *
 _ensureRemaining(PARCBufferComposer *composer, size_t required)
@@ -113,10 +211,18 @@ _ensureRemaining(PARCBufferComposer *composer, size_t required)
     size_t remainingCapacity = parcBuffer_Capacity(composer->buffer) - parcBuffer_Position(composer->buffer);
 
     if (remainingCapacity < required) {
+        if (composer->chunked) {
+            return _appendSegment(composer, required);
+        }
+
+        // Grow geometrically, so that composing n bytes copies O(n) bytes in total.
         size_t incrementAmount = required;
         if (incrementAmount < composer->incrementHeuristic) {
             incrementAmount = composer->incrementHeuristic;
         }
+        if (incrementAmount < parcBuffer_Capacity(composer->buffer)) {
+            incrementAmount = parcBuffer_Capacity(composer->buffer);
+        }
         size_t newCapacity = parcBuffer_Capacity(composer->buffer) + incrementAmount;
 
         PARCBuffer *newBuffer = parcBuffer_Allocate(newCapacity);
@@ -157,10 +263,36 @@ parcBufferComposer_Allocate(size_t size)
     return result;
 }
 
+PARCBufferComposer *
+parcBufferComposer_CreateChunked(size_t segmentSize)
+{
+    PARCBufferComposer *result = parcBufferComposer_Allocate(segmentSize);
+    if (result != NULL) {
+        result->chunked = true;
+    }
+    return result;
+}
+
 parcObject_ImplementAcquire(parcBufferComposer, PARCBufferComposer);
 
 parcObject_ImplementRelease(parcBufferComposer, PARCBufferComposer);
 
+/*
+ * Return the address and length of the composed content in segment `index`,
+ * where the segment after the last completed one is the unflipped current buffer.
+ */
+static const uint8_t *
+_segmentContent(const PARCBufferComposer *composer, size_t index, size_t *length)
+{
+    const PARCBuffer *segment = composer->buffer;
+    *length = parcBuffer_Position(composer->buffer);
+    if (index < composer->segmentCount) {
+        segment = composer->segments[index];
+        *length = parcBuffer_Limit(segment);
+    }
+    return parcByteArray_Array(parcBuffer_Array(segment)) + parcBuffer_ArrayOffset(segment);
+}
+
 bool
 parcBufferComposer_Equals(const PARCBufferComposer *x, const PARCBufferComposer *y)
 {
@@ -170,14 +302,39 @@ parcBufferComposer_Equals(const PARCBufferComposer *x, const PARCBufferComposer
     if (x == NULL || y == NULL) {
         return false;
     }
+    if (x->incrementHeuristic != y->incrementHeuristic) {
+        return false;
+    }
+    if (x->segmentBytes + parcBuffer_Position(x->buffer) != y->segmentBytes + parcBuffer_Position(y->buffer)) {
+        return false;
+    }
 
-    if (x->incrementHeuristic == y->incrementHeuristic) {
-        if (parcBuffer_Equals(x->buffer, y->buffer)) {
+    // Walk both segment lists in step, comparing the overlapping runs without coalescing either composer.
+    size_t xIndex = 0, yIndex = 0;
+    size_t xLength, yLength;
+    const uint8_t *xBytes = _segmentContent(x, xIndex, &xLength);
+    const uint8_t *yBytes = _segmentContent(y, yIndex, &yLength);
+    for (;;) {
+        while (xLength == 0 && xIndex < x->segmentCount) {
+            xBytes = _segmentContent(x, ++xIndex, &xLength);
+        }
+        while (yLength == 0 && yIndex < y->segmentCount) {
+            yBytes = _segmentContent(y, ++yIndex, &yLength);
+        }
+        if (xLength == 0 || yLength == 0) {
+            // The total lengths are equal, so both contents end here.
             return true;
         }
-    }
 
-    return false;
+        size_t length = (xLength < yLength) ? xLength : yLength;
+        if (memcmp(xBytes, yBytes, length) != 0) {
+            return false;
+        }
+        xBytes += length;
+        xLength -= length;
+        yBytes += length;
+        yLength -= length;
+    }
 }
 
 PARCBufferComposer *
@@ -301,26 +458,109 @@ parcBufferComposer_Format(PARCBufferComposer *composer, const char *format, ...)
 }
 
 PARCBuffer *
-parcBufferComposer_GetBuffer(const PARCBufferComposer *composer)
+parcBufferComposer_GetBuffer(PARCBufferComposer *composer)
 {
+    _coalesce(composer);
     return composer->buffer;
 }
 
 PARCBuffer *
 parcBufferComposer_CreateBuffer(PARCBufferComposer *composer)
 {
+    _coalesce(composer);
     return parcBuffer_Duplicate(composer->buffer);
 }
 
 PARCBuffer *
 parcBufferComposer_ProduceBuffer(PARCBufferComposer *composer)
 {
+    _coalesce(composer);
     return parcBuffer_Acquire(parcBuffer_Flip(composer->buffer));
 }
 
+size_t
+parcBufferComposer_GetLength(const PARCBufferComposer *composer)
+{
+    return composer->segmentBytes + parcBuffer_Position(composer->buffer);
+}
+
+size_t
+parcBufferComposer_WriteToOutputStream(const PARCBufferComposer *composer, PARCOutputStream *stream)
+{
+    size_t result = 0;
+
+    for (size_t i = 0; i < composer->segmentCount; i++) {
+        PARCBuffer *segment = parcBuffer_Duplicate(composer->segments[i]);
+        result += parcOutputStream_Write(stream, segment);
+        parcBuffer_Release(&segment);
+    }
+
+    PARCBuffer *segment = parcBuffer_Flip(parcBuffer_Duplicate(composer->buffer));
+    result += parcOutputStream_Write(stream, segment);
+    parcBuffer_Release(&segment);
+
+    return result;
+}
+
+static void
+_setIoVec(struct iovec *iov, const PARCBuffer *segment, size_t length)
+{
+    iov->iov_base = parcByteArray_Array(parcBuffer_Array(segment)) + parcBuffer_ArrayOffset(segment);
+    iov->iov_len = length;
+}
+
+ssize_t
+parcBufferComposer_WriteToFileDescriptor(const PARCBufferComposer *composer, int fileDescriptor)
+{
+    size_t segmentCount = composer->segmentCount + 1;
+    size_t written = 0;
+    size_t next = 0;
+
+    // Write the segments a batch at a time, restarting each batch from wherever a short write left off.
+    struct iovec iov[_WriteBatchSize];
+    size_t offset = 0;
+    while (next < segmentCount) {
+        int iovcnt = 0;
+        for (size_t i = next; i < segmentCount && iovcnt < _WriteBatchSize; i++) {
+            if (i < composer->segmentCount) {
+                _setIoVec(&iov[iovcnt], composer->segments[i], parcBuffer_Limit(composer->segments[i]));
+            } else {
+                // The current segment has not been flipped, its content ends at its position.
+                _setIoVec(&iov[iovcnt], composer->buffer, parcBuffer_Position(composer->buffer));
+            }
+            iovcnt++;
+        }
+        iov[0].iov_base = (uint8_t *) iov[0].iov_base + offset;
+        iov[0].iov_len -= offset;
+
+        ssize_t nwritten = writev(fileDescriptor, iov, iovcnt);
+        if (nwritten < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        written += nwritten;
+
+        // Skip the segments that were written entirely.
+        size_t remaining = nwritten;
+        int i = 0;
+        while (i < iovcnt && remaining >= iov[i].iov_len) {
+            remaining -= iov[i].iov_len;
+            i++;
+        }
+        offset = (i == 0) ? offset + remaining : remaining;
+        next += i;
+    }
+
+    return written;
+}
+
 char *
 parcBufferComposer_ToString(PARCBufferComposer *composer)
 {
+    _coalesce(composer);
+
     PARCBuffer *buffer = parcBuffer_Flip(parcBuffer_Duplicate(composer->buffer));
 
     char *result = parcBuffer_ToString(buffer);
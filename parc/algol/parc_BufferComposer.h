@@ -62,6 +62,11 @@
  * purpose buffer in that all native types may be added to the buffer. When finished, the user can finalize
  * the composer and produce a flipped `PARCBuffer` instance.
  *
+ * A chunked composer, created with `parcBufferComposer_CreateChunked`, appends to a list of segments instead of
+ * a single buffer, so content is never copied as the composer grows.  The segments can be written directly with
+ * `parcBufferComposer_WriteToFileDescriptor` or `parcBufferComposer_WriteToOutputStream`, and are coalesced into
+ * a single buffer once if a function that returns a `PARCBuffer` is called.
+ *
  * @author Glenn Scott, Christopher A. Wood, Palo Alto Research Center (Xerox PARC)
  * @copyright (c) 2013-2015, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
  */
@@ -71,7 +76,10 @@
 struct parc_buffer_composer;
 typedef struct parc_buffer_composer PARCBufferComposer;
 
+#include <sys/types.h>
+
 #include <parc/algol/parc_Buffer.h>
+#include <parc/algol/parc_OutputStream.h>
 
 extern parcObjectDescriptor_Declaration(PARCBufferComposer);
 
@@ -121,6 +129,36 @@ PARCBufferComposer *parcBufferComposer_Create(void);
  */
 PARCBufferComposer *parcBufferComposer_Allocate(size_t length);
 
+/**
+ * Create an empty chunked `PARCBufferComposer`.
+ *
+ * A chunked composer keeps its content in a list of segments, the first of @p segmentSize bytes.
+ * When a segment is full, a new one twice the size of the last is started, up to 1 MiB per segment,
+ * and the content already composed is not copied.
+ *
+ * The functions that return the content as a `PARCBuffer` coalesce the segments into a single buffer.
+ *
+ * @param [in] segmentSize The number of bytes in the first segment.
+ *
+ * @return NULL Memory could not be allocated.
+ * @return non-NULL A pointer to the new `PARCBufferComposer`.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBufferComposer *composer = parcBufferComposer_CreateChunked(4096);
+ *
+ *     for (int i = 0; i < 1000000; i++) {
+ *         parcBufferComposer_PutString(composer, "Hello World\n");
+ *     }
+ *     parcBufferComposer_WriteToFileDescriptor(composer, STDOUT_FILENO);
+ *
+ *     parcBufferComposer_Release(&composer);
+ * }
+ * @endcode
+ */
+PARCBufferComposer *parcBufferComposer_CreateChunked(size_t segmentSize);
+
 /**
  * Assert that an instance of `PARCBufferComposer` is valid.
  *
@@ -494,7 +532,13 @@ __attribute__((format(printf, 2, 3)));
  * No new reference is created. The caller must acquire a reference to the returned `PARCBuffer`
  * if it needs retain it beyond the life of the given `PARCBufferComposer`.
  *
- * @param composer [in] A pointer to a `PARCBufferComposer` instance.
+ * The composer is modified: the segments of a chunked composer are first coalesced into a single new `PARCBuffer`,
+ * which replaces the composer's buffer.
+ * A `PARCBuffer` obtained from an earlier call is then no longer the composer's buffer,
+ * and is released by the composer unless the caller acquired a reference to it.
+ * Callers sharing a composer between threads must serialise this call like any other write.
+ *
+ * @param composer [in,out] A pointer to a `PARCBufferComposer` instance.
  *
  * @return A pointer to the internal `PARCBuffer` which is wrapped by this `PARCBufferComposer`.
  *
@@ -513,7 +557,7 @@ __attribute__((format(printf, 2, 3)));
  * @see parcBufferComposer_PutBuffer
  * @see parcBufferComposer_ProduceBuffer
  */
-PARCBuffer *parcBufferComposer_GetBuffer(const PARCBufferComposer *composer);
+PARCBuffer *parcBufferComposer_GetBuffer(PARCBufferComposer *composer);
 
 /**
  * Create a `PARCBuffer` pointing to the underlying `PARCBuffer` instance.
@@ -583,6 +627,81 @@ PARCBuffer *parcBufferComposer_CreateBuffer(PARCBufferComposer *composer);
  */
 PARCBuffer *parcBufferComposer_ProduceBuffer(PARCBufferComposer *composer);
 
+/**
+ * Get the number of bytes composed so far.
+ *
+ * @param [in] composer A pointer to a `PARCBufferComposer` instance.
+ *
+ * @return The number of bytes composed so far.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBufferComposer *composer = parcBufferComposer_Create();
+ *     parcBufferComposer_PutString(composer, "Hello, World!");
+ *
+ *     size_t length = parcBufferComposer_GetLength(composer); // 13
+ *
+ *     parcBufferComposer_Release(&composer);
+ * }
+ * @endcode
+ */
+size_t parcBufferComposer_GetLength(const PARCBufferComposer *composer);
+
+/**
+ * Write the content of the given `PARCBufferComposer` to a `PARCOutputStream`, one segment at a time.
+ *
+ * The segments are not coalesced and the composer is not modified.
+ *
+ * @param [in] composer A pointer to a `PARCBufferComposer` instance.
+ * @param [in] stream A pointer to a valid `PARCOutputStream` instance.
+ *
+ * @return The sum of the values returned by `parcOutputStream_Write` for each segment.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBufferComposer *composer = parcBufferComposer_CreateChunked(4096);
+ *     parcBufferComposer_PutString(composer, "Hello, World!");
+ *
+ *     parcBufferComposer_WriteToOutputStream(composer, stream);
+ *
+ *     parcBufferComposer_Release(&composer);
+ * }
+ * @endcode
+ *
+ * @see parcBufferComposer_WriteToFileDescriptor
+ */
+size_t parcBufferComposer_WriteToOutputStream(const PARCBufferComposer *composer, PARCOutputStream *stream);
+
+/**
+ * Write the content of the given `PARCBufferComposer` to a file descriptor with `writev(2)`.
+ *
+ * The segments are not coalesced and the composer is not modified.
+ * Short writes are continued until all the content is written.
+ *
+ * @param [in] composer A pointer to a `PARCBufferComposer` instance.
+ * @param [in] fileDescriptor The file descriptor to write to.
+ *
+ * @return -1 An error occurred, and `errno` is set.
+ * @return The number of bytes written, which is `parcBufferComposer_GetLength`.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBufferComposer *composer = parcBufferComposer_CreateChunked(4096);
+ *     parcBufferComposer_PutString(composer, "Hello, World!");
+ *
+ *     ssize_t written = parcBufferComposer_WriteToFileDescriptor(composer, STDOUT_FILENO);
+ *
+ *     parcBufferComposer_Release(&composer);
+ * }
+ * @endcode
+ *
+ * @see parcBufferComposer_WriteToOutputStream
+ */
+ssize_t parcBufferComposer_WriteToFileDescriptor(const PARCBufferComposer *composer, int fileDescriptor);
+
 /**
  * Produce a null-terminated string containing the characters from 0 to the current
  * position of the given `PARCBufferComposer`.
@@ -61,6 +61,7 @@
 #include <stdio.h>
 #include <ctype.h>
 #include <string.h>
+#include <sys/mman.h>
 
 #include <LongBow/runtime.h>
 
@@ -74,6 +75,7 @@ struct parc_byte_array {
     uint8_t *array;
     size_t length;
     void (*freeFunction)(void **);
+    bool isMapping;
 };
 #define MAGIC 0x0ddba11c1a55e5
 
@@ -88,7 +90,9 @@ _parcByteArray_Destructor(PARCByteArray **byteArrayPtr)
 {
     PARCByteArray *byteArray = *byteArrayPtr;
 
-    if (byteArray->freeFunction != NULL) {
+    if (byteArray->isMapping) {
+        munmap(byteArray->array, byteArray->length);
+    } else if (byteArray->freeFunction != NULL) {
         if (byteArray->array != NULL) {
             byteArray->freeFunction((void **) &(byteArray->array));
         }
@@ -141,6 +145,7 @@ parcByteArray_Allocate(const size_t length)
         result->array = array;
         result->length = length;
         result->freeFunction = parcMemory_DeallocateImpl;
+        result->isMapping = false;
         return result;
     } else {
         parcMemory_Deallocate(&array);
@@ -157,6 +162,23 @@ parcByteArray_Wrap(const size_t length, uint8_t array[length])
             result->array = array;
             result->length = length;
             result->freeFunction = NULL;
+            result->isMapping = false;
+            return result;
+        }
+    }
+    return NULL;
+}
+
+PARCByteArray *
+parcByteArray_WrapMapping(const size_t length, uint8_t array[length])
+{
+    if (array != NULL && array != MAP_FAILED) {
+        PARCByteArray *result = parcObject_CreateInstance(PARCByteArray);
+        if (result != NULL) {
+            result->array = array;
+            result->length = length;
+            result->freeFunction = NULL;
+            result->isMapping = true;
             return result;
         }
     }
@@ -349,5 +371,5 @@ PARCHashCode
 parcByteArray_HashCode(const PARCByteArray *array)
 {
     parcByteArray_OptionalAssertValid(array);
-    return parcHashCode_Hash(array->array, array->length);
+    return parcHashCode_HashData(array->array, array->length);
 }
@@ -200,6 +200,31 @@ PARCByteArray *parcByteArray_Allocate(const size_t capacity);
  */
 PARCByteArray *parcByteArray_Wrap(size_t capacity, uint8_t array[capacity]);
 
+/**
+ * Wrap a memory mapping in a {@link PARCByteArray} that takes ownership of it.
+ *
+ * The @p array must be the address returned by `mmap(2)` for a mapping of @p capacity bytes.
+ * The mapping is removed with `munmap(2)` when the last reference to the `PARCByteArray` is released,
+ * so buffers sliced from it remain valid for as long as they are held.
+ *
+ * @param [in] capacity The length of the mapping.
+ * @param [in] array The address of the mapping.
+ *
+ * @return A pointer to an allocated `PARCByteArray` instance which must be released via {@link parcByteArray_Release()}.
+ * @return NULL If @p array is NULL or `MAP_FAILED`.
+ *
+ * Example:
+ * @code
+ * {
+ *     uint8_t *mapping = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+ *     PARCByteArray *byteArray = parcByteArray_WrapMapping(length, mapping);
+ *
+ *     parcByteArray_Release(&byteArray);
+ * }
+ * @endcode
+ */
+PARCByteArray *parcByteArray_WrapMapping(size_t capacity, uint8_t array[capacity]);
+
 /**
  * Returns the pointer to the `uint8_t` array that backs this `PARCByteArray`.
  *
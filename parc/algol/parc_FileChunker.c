@@ -61,7 +61,11 @@
 
 #include <stdio.h>
 #include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
 #include <sys/time.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
 
 #include <parc/algol/parc_Object.h>
 #include <parc/algol/parc_Buffer.h>
@@ -96,6 +100,9 @@ struct parc_buffer_chunker {
     PARCFile *file;
     PARCRandomAccessFile *fhandle;
 
+    // The whole file, if it is memory mapped, otherwise NULL.
+    PARCBuffer *mapping;
+
     // The current element of the iterator
     PARCBuffer *currentElement;
 };
@@ -111,11 +118,50 @@ _destroy(PARCFileChunker **chunkerP)
         parcFile_Release(&(*chunkerP)->file);
     }
 
+    if ((*chunkerP)->mapping != NULL) {
+        parcBuffer_Release(&(*chunkerP)->mapping);
+    }
+
     if ((*chunkerP)->currentElement != NULL) {
         parcBuffer_Release(&(*chunkerP)->currentElement);
     }
 }
 
+static size_t
+_totalSize(PARCFileChunker *chunker)
+{
+    if (chunker->mapping != NULL) {
+        return parcBuffer_Capacity(chunker->mapping);
+    }
+    return parcFile_GetFileSize(chunker->file);
+}
+
+/*
+ * Ask the kernel to start reading the pages of the chunk the iterator will return next.
+ */
+static void
+_prefetch(PARCFileChunker *chunker, const _ChunkerState *state)
+{
+    if (chunker->mapping != NULL && !state->atEnd) {
+        uint8_t *base = parcByteArray_Array(parcBuffer_Array(chunker->mapping));
+        size_t pageSize = (size_t) sysconf(_SC_PAGESIZE);
+        size_t start = state->position & ~(pageSize - 1);
+        madvise(&base[start], state->position + state->nextChunkSize - start, MADV_WILLNEED);
+    }
+}
+
+/*
+ * Set the kernel's read-ahead policy for the mapping to suit the direction of iteration.
+ * Read-ahead only runs forward, so it is turned off for reverse iteration and each chunk is prefetched instead.
+ */
+static void
+_advise(PARCFileChunker *chunker, int advice)
+{
+    if (chunker->mapping != NULL) {
+        madvise(parcByteArray_Array(parcBuffer_Array(chunker->mapping)), parcBuffer_Capacity(chunker->mapping), advice);
+    }
+}
+
 static void *
 _InitForward(PARCFileChunker *chunker)
 {
@@ -125,7 +171,7 @@ _InitForward(PARCFileChunker *chunker)
     state->direction = 0;
     state->position = 0;
     state->atEnd = false;
-    state->totalSize = parcFile_GetFileSize(chunker->file);
+    state->totalSize = _totalSize(chunker);
 
     if (state->totalSize < chunker->chunkSize) {
         state->position = 0;
@@ -135,6 +181,8 @@ _InitForward(PARCFileChunker *chunker)
         state->nextChunkSize = chunker->chunkSize;
     }
 
+    _advise(chunker, MADV_SEQUENTIAL);
+
     return state;
 }
 
@@ -146,7 +194,7 @@ _InitReverse(PARCFileChunker *chunker)
     state->chunkNumber = 0;
     state->direction = 1;
     state->atEnd = false;
-    state->totalSize = parcFile_GetFileSize(chunker->file);
+    state->totalSize = _totalSize(chunker);
 
     if (state->totalSize < chunker->chunkSize) {
         state->position = 0;
@@ -156,6 +204,9 @@ _InitReverse(PARCFileChunker *chunker)
         state->nextChunkSize = chunker->chunkSize;
     }
 
+    _advise(chunker, MADV_RANDOM);
+    _prefetch(chunker, state);
+
     return state;
 }
 
@@ -226,10 +277,35 @@ _parcChunker_NextFromBuffer(PARCFileChunker *chunker, _ChunkerState *state)
     return slice;
 }
 
+/*
+ * Return the next chunk as a slice of the mapping, without copying it.
+ * The slice holds a reference to the mapping, so it stays valid after the chunker is released.
+ */
+static void *
+_parcChunker_NextFromMapping(PARCFileChunker *chunker, _ChunkerState *state)
+{
+    parcBuffer_Clear(chunker->mapping);
+    parcBuffer_SetLimit(chunker->mapping, state->position + state->nextChunkSize);
+    parcBuffer_SetPosition(chunker->mapping, state->position);
+    PARCBuffer *slice = parcBuffer_Slice(chunker->mapping);
+
+    _advanceState(chunker, state);
+    if (state->direction != 0) {
+        _prefetch(chunker, state);
+    }
+
+    return slice;
+}
+
 static void *
 _parcChunker_Next(PARCFileChunker *chunker, void *state)
 {
-    PARCBuffer *buffer = _parcChunker_NextFromBuffer(chunker, state);
+    PARCBuffer *buffer;
+    if (chunker->mapping != NULL) {
+        buffer = _parcChunker_NextFromMapping(chunker, state);
+    } else {
+        buffer = _parcChunker_NextFromBuffer(chunker, state);
+    }
 
     if (chunker->currentElement != NULL) {
         parcBuffer_Release(&chunker->currentElement);
@@ -279,12 +355,66 @@ parcFileChunker_Create(PARCFile *file, size_t chunkSize)
         chunker->chunkSize = chunkSize;
         chunker->file = parcFile_Acquire(file);
         chunker->fhandle = parcRandomAccessFile_Open(chunker->file);
+        chunker->mapping = NULL;
         chunker->currentElement = NULL;
     }
 
     return chunker;
 }
 
+/*
+ * Map the whole of a regular, non-empty file.
+ *
+ * The mapping is private and writable so that, as with a chunk read into its own buffer,
+ * the holder of a chunk may modify it without changing the file.
+ */
+static PARCBuffer *
+_mapFile(const PARCFile *file)
+{
+    PARCBuffer *result = NULL;
+
+    char *path = parcFile_ToString(file);
+    int fd = open(path, O_RDONLY);
+    parcMemory_Deallocate(&path);
+
+    if (fd >= 0) {
+        struct stat statbuf;
+        if (fstat(fd, &statbuf) == 0 && S_ISREG(statbuf.st_mode) && statbuf.st_size > 0) {
+            size_t length = (size_t) statbuf.st_size;
+            uint8_t *address = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+
+            PARCByteArray *array = parcByteArray_WrapMapping(length, address);
+            if (array != NULL) {
+                result = parcBuffer_WrapByteArray(array, 0, length);
+                parcByteArray_Release(&array);
+            } else if (address != MAP_FAILED) {
+                munmap(address, length);
+            }
+        }
+        close(fd);
+    }
+
+    return result;
+}
+
+PARCFileChunker *
+parcFileChunker_CreateMapped(PARCFile *file, size_t chunkSize)
+{
+    PARCFileChunker *chunker = parcFileChunker_Create(file, chunkSize);
+
+    if (chunker != NULL) {
+        chunker->mapping = _mapFile(file);
+    }
+
+    return chunker;
+}
+
+bool
+parcFileChunker_IsMapped(const PARCFileChunker *chunker)
+{
+    return chunker->mapping != NULL;
+}
+
 
 PARCIterator *
 parcFileChunker_ForwardIterator(const PARCFileChunker *chunker)
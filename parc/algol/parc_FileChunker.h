@@ -98,6 +98,62 @@ extern PARCChunkerInterface *PARCFileChunkerAsChunker;
  */
 PARCFileChunker *parcFileChunker_Create(PARCFile *file, size_t chunkSize);
 
+/**
+ * Create a new chunker that memory maps @p file and returns each chunk as a slice of the mapping.
+ *
+ * The file is mapped once, and each chunk is a `PARCBuffer` that shares the mapping rather than
+ * a copy read from the file, so chunking a large file neither allocates nor copies its contents.
+ * A chunk holds a reference to the mapping and remains valid after the chunker is released.
+ * The mapping is private: modifying a chunk does not modify the file.
+ *
+ * The kernel is advised to read ahead for forward iteration,
+ * and to prefetch each chunk ahead of its use for reverse iteration.
+ *
+ * If @p file cannot be mapped, for example because it is empty or is not a regular file,
+ * the chunker reads each chunk from the file as {@link parcFileChunker_Create} does.
+ * The file must not be truncated while a mapped chunker or any of its chunks are in use.
+ *
+ * @param [in] file A `PARCFile` from which the data will be read.
+ * @param [in] chunkSize The size per chunk.
+ *
+ * @retval PARCFileChunker A newly allocated `PARCFileChunker`
+ * @retval NULL An error occurred.
+ *
+ * Example
+ * @code
+ * {
+ *     PARCFile *file = parcFile_Create("/var/content/movie.mp4");
+ *     PARCFileChunker *chunker = parcFileChunker_CreateMapped(file, 4096);
+ *
+ *     PARCIterator *itr = parcFileChunker_ForwardIterator(chunker);
+ *     ...
+ * }
+ * @endcode
+ *
+ * @see parcFileChunker_IsMapped
+ */
+PARCFileChunker *parcFileChunker_CreateMapped(PARCFile *file, size_t chunkSize);
+
+/**
+ * Determine if a `PARCFileChunker` returns chunks from a memory mapping of its file.
+ *
+ * @param [in] chunker A `PARCFileChunker` instance.
+ *
+ * @return true The chunks are slices of a memory mapping of the file.
+ * @return false The chunks are read from the file.
+ *
+ * Example
+ * @code
+ * {
+ *     PARCFileChunker *chunker = parcFileChunker_CreateMapped(file, 4096);
+ *     if (!parcFileChunker_IsMapped(chunker)) {
+ *         // The file could not be mapped, chunks are copied from it instead.
+ *     }
+ * }
+ * @endcode
+ */
+bool parcFileChunker_IsMapped(const PARCFileChunker *chunker);
+
 /**
  * Increase the number of references to a `PARCFileChunker` instance.
  *
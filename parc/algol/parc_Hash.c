@@ -56,12 +56,15 @@
  * This hash is based on FNV-1a, using different lengths.  Please see the FNV-1a
  * website for details on the algorithm: http://www.isthe.com/chongo/tech/comp/fnv
  *
+ * The fast hash is XXH64, see https://github.com/Cyan4973/xxHash for the specification.
+ *
  * @author Ignacio Solis, Palo Alto Research Center (Xerox PARC)
  * @copyright (c) 2013-2015, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
  */
 #include <config.h>
 
 #include <stdint.h>
+#include <string.h>
 #include <unistd.h>
 
 #include <parc/algol/parc_Hash.h>
@@ -183,3 +186,199 @@ parcHash32_Int32(uint32_t int32)
 {
     return parcHash32_Data(&int32, sizeof(uint32_t));
 }
+
+// =====================================
+// XXH64
+
+static const uint64_t _xxh64_prime1 = 0x9E3779B185EBCA87ULL;
+static const uint64_t _xxh64_prime2 = 0xC2B2AE3D27D4EB4FULL;
+static const uint64_t _xxh64_prime3 = 0x165667B19E3779F9ULL;
+static const uint64_t _xxh64_prime4 = 0x85EBCA77C2B2AE63ULL;
+static const uint64_t _xxh64_prime5 = 0x27D4EB2F165667C5ULL;
+
+#define _PARCHash64Fast_StripeLength 32
+
+static inline uint64_t
+_rotateLeft64(uint64_t value, int bits)
+{
+    return (value << bits) | (value >> (64 - bits));
+}
+
+// The algorithm is defined on little-endian words regardless of the host byte order.
+static inline uint64_t
+_readLittleEndian64(const uint8_t *bytes)
+{
+    uint64_t value;
+    memcpy(&value, bytes, sizeof(value));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    value = __builtin_bswap64(value);
+#endif
+    return value;
+}
+
+static inline uint32_t
+_readLittleEndian32(const uint8_t *bytes)
+{
+    uint32_t value;
+    memcpy(&value, bytes, sizeof(value));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    value = __builtin_bswap32(value);
+#endif
+    return value;
+}
+
+static inline uint64_t
+_xxh64_Round(uint64_t lane, uint64_t input)
+{
+    lane += input * _xxh64_prime2;
+    lane = _rotateLeft64(lane, 31);
+    return lane * _xxh64_prime1;
+}
+
+static inline uint64_t
+_xxh64_MergeRound(uint64_t hash, uint64_t lane)
+{
+    hash ^= _xxh64_Round(0, lane);
+    return hash * _xxh64_prime1 + _xxh64_prime4;
+}
+
+static inline void
+_xxh64_InitLanes(uint64_t lanes[4], uint64_t seed)
+{
+    lanes[0] = seed + _xxh64_prime1 + _xxh64_prime2;
+    lanes[1] = seed + _xxh64_prime2;
+    lanes[2] = seed;
+    lanes[3] = seed - _xxh64_prime1;
+}
+
+// Consume as many whole stripes as there are in the data, returning the number of bytes consumed.
+static inline size_t
+_xxh64_ConsumeStripes(uint64_t lanes[4], const uint8_t *bytes, size_t length)
+{
+    uint64_t v1 = lanes[0];
+    uint64_t v2 = lanes[1];
+    uint64_t v3 = lanes[2];
+    uint64_t v4 = lanes[3];
+
+    size_t offset = 0;
+    for (; offset + _PARCHash64Fast_StripeLength <= length; offset += _PARCHash64Fast_StripeLength) {
+        v1 = _xxh64_Round(v1, _readLittleEndian64(&bytes[offset]));
+        v2 = _xxh64_Round(v2, _readLittleEndian64(&bytes[offset + 8]));
+        v3 = _xxh64_Round(v3, _readLittleEndian64(&bytes[offset + 16]));
+        v4 = _xxh64_Round(v4, _readLittleEndian64(&bytes[offset + 24]));
+    }
+
+    lanes[0] = v1;
+    lanes[1] = v2;
+    lanes[2] = v3;
+    lanes[3] = v4;
+    return offset;
+}
+
+static inline uint64_t
+_xxh64_MergeLanes(const uint64_t lanes[4])
+{
+    uint64_t hash = _rotateLeft64(lanes[0], 1) + _rotateLeft64(lanes[1], 7)
+                    + _rotateLeft64(lanes[2], 12) + _rotateLeft64(lanes[3], 18);
+    for (int i = 0; i < 4; i++) {
+        hash = _xxh64_MergeRound(hash, lanes[i]);
+    }
+    return hash;
+}
+
+// Mix in the final (fewer than 32) bytes and the avalanche.
+static inline uint64_t
+_xxh64_Finalize(uint64_t hash, const uint8_t *bytes, size_t length)
+{
+    size_t offset = 0;
+    for (; offset + 8 <= length; offset += 8) {
+        hash ^= _xxh64_Round(0, _readLittleEndian64(&bytes[offset]));
+        hash = _rotateLeft64(hash, 27) * _xxh64_prime1 + _xxh64_prime4;
+    }
+    if (offset + 4 <= length) {
+        hash ^= (uint64_t) _readLittleEndian32(&bytes[offset]) * _xxh64_prime1;
+        hash = _rotateLeft64(hash, 23) * _xxh64_prime2 + _xxh64_prime3;
+        offset += 4;
+    }
+    for (; offset < length; offset++) {
+        hash ^= bytes[offset] * _xxh64_prime5;
+        hash = _rotateLeft64(hash, 11) * _xxh64_prime1;
+    }
+
+    hash ^= hash >> 33;
+    hash *= _xxh64_prime2;
+    hash ^= hash >> 29;
+    hash *= _xxh64_prime3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+uint64_t
+parcHash64Fast_Data(const void *data, size_t length, uint64_t seed)
+{
+    const uint8_t *bytes = data;
+
+    uint64_t hash;
+    size_t consumed = 0;
+    if (length >= _PARCHash64Fast_StripeLength) {
+        uint64_t lanes[4];
+        _xxh64_InitLanes(lanes, seed);
+        consumed = _xxh64_ConsumeStripes(lanes, bytes, length);
+        hash = _xxh64_MergeLanes(lanes);
+    } else {
+        hash = seed + _xxh64_prime5;
+    }
+    hash += (uint64_t) length;
+
+    return _xxh64_Finalize(hash, &bytes[consumed], length - consumed);
+}
+
+void
+parcHash64Fast_Init(PARCHash64Fast *state, uint64_t seed)
+{
+    _xxh64_InitLanes(state->lanes, seed);
+    state->seed = seed;
+    state->totalLength = 0;
+    state->stripeLength = 0;
+}
+
+void
+parcHash64Fast_Update(PARCHash64Fast *state, const void *data, size_t length)
+{
+    const uint8_t *bytes = data;
+    state->totalLength += length;
+
+    if (state->stripeLength > 0) {
+        size_t fill = _PARCHash64Fast_StripeLength - state->stripeLength;
+        if (length < fill) {
+            memcpy(&state->stripe[state->stripeLength], bytes, length);
+            state->stripeLength += length;
+            return;
+        }
+        memcpy(&state->stripe[state->stripeLength], bytes, fill);
+        _xxh64_ConsumeStripes(state->lanes, state->stripe, _PARCHash64Fast_StripeLength);
+        state->stripeLength = 0;
+        bytes += fill;
+        length -= fill;
+    }
+
+    size_t consumed = _xxh64_ConsumeStripes(state->lanes, bytes, length);
+    state->stripeLength = length - consumed;
+    if (state->stripeLength > 0) {
+        memcpy(state->stripe, &bytes[consumed], state->stripeLength);
+    }
+}
+
+uint64_t
+parcHash64Fast_Digest(const PARCHash64Fast *state)
+{
+    uint64_t hash;
+    if (state->totalLength >= _PARCHash64Fast_StripeLength) {
+        hash = _xxh64_MergeLanes(state->lanes);
+    } else {
+        hash = state->seed + _xxh64_prime5;
+    }
+    hash += state->totalLength;
+
+    return _xxh64_Finalize(hash, state->stripe, state->stripeLength);
+}
@@ -59,6 +59,7 @@
 #include <config.h>
 
 #include <parc/algol/parc_HashCode.h>
+#include <parc/algol/parc_Hash.h>
 
 #if PARCHashCodeSize == 64
 static const PARCHashCode _fnv1a_prime = 0x00000100000001B3ULL;
@@ -88,3 +89,18 @@ parcHashCode_HashHashCode(PARCHashCode initialValue, PARCHashCode update)
 {
     return parcHashCode_HashImpl((uint8_t *) &update, sizeof(PARCHashCode), initialValue);
 }
+
+PARCHashCode
+parcHashCode_HashData(const uint8_t *memory, size_t length)
+{
+#if PARCHashCodeDataAlgorithm == PARCHashCodeDataAlgorithm_FNV1a
+    return parcHashCode_HashImpl(memory, length, parcHashCode_InitialValue);
+#else
+    uint64_t hash = parcHash64Fast_Data(memory, length, parcHashCode_InitialValue);
+#if PARCHashCodeSize == 64
+    return hash;
+#else
+    return (PARCHashCode) (hash ^ (hash >> 32));
+#endif
+#endif
+}
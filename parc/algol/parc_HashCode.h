@@ -94,6 +94,19 @@ extern const PARCHashCode parcHashCode_InitialValue;
 
 #define parcHashCode_Hash(_memory_, _length_) parcHashCode_HashImpl(_memory_, _length_, parcHashCode_InitialValue)
 
+/*
+ * The algorithm used by `parcHashCode_HashData()` to hash the contents of byte containers
+ * such as `PARCBuffer` and `PARCByteArray`, which are frequently used as keys.
+ * Compile with -DPARCHashCodeDataAlgorithm=PARCHashCodeDataAlgorithm_FNV1a
+ * to use the same FNV-1a hash as `parcHashCode_Hash()`.
+ */
+#define PARCHashCodeDataAlgorithm_FNV1a 1
+#define PARCHashCodeDataAlgorithm_Fast 2
+
+#ifndef PARCHashCodeDataAlgorithm
+#define PARCHashCodeDataAlgorithm PARCHashCodeDataAlgorithm_Fast
+#endif
+
 /**
  * <#One Line Description#>
  *
@@ -132,4 +145,26 @@ PARCHashCode parcHashCode_HashImpl(const uint8_t *memory, size_t length, PARCHas
  * @endcode
  */
 PARCHashCode parcHashCode_HashHashCode(PARCHashCode initialValue, PARCHashCode update);
+
+/**
+ * Compute the `PARCHashCode` of a block of bytes with the algorithm selected by `PARCHashCodeDataAlgorithm`.
+ *
+ * The default is the fast, word-at-a-time hash `parcHash64Fast_Data()`,
+ * which is considerably faster than `parcHashCode_Hash()` for all but the shortest inputs.
+ *
+ * @param [in] memory A pointer to bytes used to generate the `PARCHashCode`.
+ * @param [in] length The number of bytes in memory to use to generate the `PARCHashCode`
+ *
+ * @return The resulting `PARCHashCode` value.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCHashCode hashCode = parcHashCode_HashData((uint8_t *) "Hello World", 11);
+ * }
+ * @endcode
+ *
+ * @see parcHash64Fast_Data
+ */
+PARCHashCode parcHashCode_HashData(const uint8_t *memory, size_t length);
 #endif
@@ -67,9 +67,13 @@
 #include "parc_LinkedList.h"
 
 #include <math.h>
+#include <string.h>
 
 static const uint32_t DEFAULT_CAPACITY = 43;
 
+// The flat storage is always a power of two number of slots, never fewer than this.
+static const uint32_t FLAT_MINIMUM_CAPACITY = 8;
+
 typedef struct PARCHashMapEntry {
     PARCObject *key;
     PARCObject *value;
@@ -118,6 +122,22 @@ _parcHashMapEntry_HashCode(const _PARCHashMapEntry *entry)
 }
 
 
+/*
+ * A slot in the open-addressing (flat) storage.
+ *
+ * The key's hash code is cached so that probing and resizing never call parcObject_HashCode,
+ * and most mismatches are rejected without calling parcObject_Equals.
+ *
+ * The probeLength is 0 for an empty slot, otherwise it is one more than the distance of the slot from the key's home slot.
+ * A slot with a non-zero probeLength but a NULL key is a tombstone left by an iterator removal.
+ */
+typedef struct {
+    PARCHashCode hashCode;
+    PARCObject *key;
+    PARCObject *value;
+    size_t probeLength;
+} _PARCHashMapSlot;
+
 struct PARCHashMap {
     PARCLinkedList **buckets;
     size_t minCapacity;
@@ -125,13 +145,122 @@ struct PARCHashMap {
     size_t size;
     double maxLoadFactor;
     double minLoadFactor;
+
+    // Non-NULL if this is a flat (open-addressing, Robin Hood) PARCHashMap, in which case buckets is NULL.
+    _PARCHashMapSlot *slots;
+    unsigned int slotShift;
+    size_t tombstones;
 };
 
-static _PARCHashMapEntry *
-_parcHashMap_GetEntry(const PARCHashMap *hashMap, const PARCObject *key)
+static inline bool
+_parcHashMap_IsFlat(const PARCHashMap *hashMap)
 {
-    PARCHashCode keyHash = parcObject_HashCode(key);
+    return hashMap->slots != NULL;
+}
+
+/*
+ * Fibonacci hashing: spread the hash code over the table using its high bits,
+ * so weak hash codes (e.g. small integers) don't pile up in neighbouring slots.
+ */
+static inline size_t
+_parcHashMap_FlatHomeSlot(const PARCHashMap *hashMap, PARCHashCode hashCode)
+{
+    return (size_t) (((uint64_t) hashCode * UINT64_C(0x9E3779B97F4A7C15)) >> hashMap->slotShift);
+}
+
+static _PARCHashMapSlot *
+_parcHashMap_FlatFind(const PARCHashMap *hashMap, const PARCObject *key, PARCHashCode hashCode)
+{
+    size_t mask = hashMap->capacity - 1;
+    size_t index = _parcHashMap_FlatHomeSlot(hashMap, hashCode);
+
+    for (size_t probeLength = 1; probeLength <= hashMap->slots[index].probeLength; probeLength++) {
+        _PARCHashMapSlot *slot = &hashMap->slots[index];
+        if (slot->hashCode == hashCode && slot->key != NULL && parcObject_Equals(key, slot->key)) {
+            return slot;
+        }
+        index = (index + 1) & mask;
+    }
+
+    return NULL;
+}
 
+/*
+ * Insert an entry whose key is known not to be present, displacing entries closer to their home slot (Robin Hood).
+ */
+static void
+_parcHashMap_FlatInsert(_PARCHashMapSlot *slots, size_t capacity, size_t index, _PARCHashMapSlot entry)
+{
+    size_t mask = capacity - 1;
+
+    entry.probeLength = 1;
+    while (slots[index].probeLength != 0) {
+        if (slots[index].probeLength < entry.probeLength) {
+            _PARCHashMapSlot displaced = slots[index];
+            slots[index] = entry;
+            entry = displaced;
+        }
+        index = (index + 1) & mask;
+        entry.probeLength++;
+    }
+    slots[index] = entry;
+}
+
+/*
+ * Empty the given slot and shift the following displaced entries back one slot.
+ * The caller is responsible for the references held by the slot.
+ */
+static void
+_parcHashMap_FlatDelete(PARCHashMap *hashMap, _PARCHashMapSlot *slot)
+{
+    size_t mask = hashMap->capacity - 1;
+    size_t index = slot - hashMap->slots;
+    size_t next = (index + 1) & mask;
+
+    while (hashMap->slots[next].probeLength > 1) {
+        hashMap->slots[index] = hashMap->slots[next];
+        hashMap->slots[index].probeLength--;
+        index = next;
+        next = (next + 1) & mask;
+    }
+    memset(&hashMap->slots[index], 0, sizeof(_PARCHashMapSlot));
+}
+
+static void
+_parcHashMap_FlatPurgeTombstones(PARCHashMap *hashMap)
+{
+    for (size_t i = 0; i < hashMap->capacity && hashMap->tombstones > 0; i++) {
+        while (hashMap->slots[i].probeLength != 0 && hashMap->slots[i].key == NULL) {
+            _parcHashMap_FlatDelete(hashMap, &hashMap->slots[i]);
+            hashMap->tombstones--;
+        }
+    }
+}
+
+static unsigned int
+_parcHashMap_FlatShift(size_t capacity)
+{
+    unsigned int shift = 64;
+    while (capacity > 1) {
+        capacity >>= 1;
+        shift--;
+    }
+    return shift;
+}
+
+static size_t
+_parcHashMap_FlatCapacity(size_t capacity)
+{
+    size_t result = FLAT_MINIMUM_CAPACITY;
+    while (result < capacity) {
+        result <<= 1;
+    }
+    return result;
+}
+
+static _PARCHashMapEntry *
+_parcHashMap_GetEntry(const PARCHashMap *hashMap, const PARCObject *key, PARCHashCode keyHash)
+{
     int bucket = keyHash % hashMap->capacity;
 
     _PARCHashMapEntry *result = NULL;
@@ -178,6 +307,17 @@ _parcHashMap_Finalize(PARCHashMap **instancePtr)
     assertNotNull(instancePtr, "Parameter must be a non-null pointer to a PARCHashMap pointer.");
     PARCHashMap *hashMap = *instancePtr;
 
+    if (_parcHashMap_IsFlat(hashMap)) {
+        for (size_t i = 0; i < hashMap->capacity; i++) {
+            if (hashMap->slots[i].key != NULL) {
+                parcObject_Release(&hashMap->slots[i].key);
+                parcObject_Release(&hashMap->slots[i].value);
+            }
+        }
+        parcMemory_Deallocate(&hashMap->slots);
+        return;
+    }
+
     for (unsigned int i = 0; i < hashMap->capacity; i++) {
         if (hashMap->buckets[i] != NULL) {
             parcLinkedList_Release(&hashMap->buckets[i]);
@@ -218,11 +358,44 @@ parcHashMap_CreateCapacity(unsigned int capacity)
         result->maxLoadFactor = 0.75;
         result->minLoadFactor = result->maxLoadFactor / 3.0;
         result->buckets = parcMemory_AllocateAndClear(capacity * sizeof(PARCLinkedList*));
+        result->slots = NULL;
+        result->slotShift = 0;
+        result->tombstones = 0;
     }
 
     return result;
 }
 
+PARCHashMap *
+parcHashMap_CreateFlatCapacity(unsigned int capacity)
+{
+    PARCHashMap *result = parcObject_CreateInstance(PARCHashMap);
+
+    if (result != NULL) {
+        capacity = _parcHashMap_FlatCapacity(capacity);
+
+        result->minCapacity = capacity;
+        result->capacity = capacity;
+        result->size = 0;
+        result->maxLoadFactor = 0.75;
+        result->minLoadFactor = result->maxLoadFactor / 3.0;
+        result->buckets = NULL;
+        result->slots = parcMemory_AllocateAndClear(capacity * sizeof(_PARCHashMapSlot));
+        result->slotShift = _parcHashMap_FlatShift(capacity);
+        result->tombstones = 0;
+    }
+
+    return result;
+}
+
+PARCHashMap *
+parcHashMap_CreateFlat(void)
+{
+    PARCHashMap *result = parcHashMap_CreateFlatCapacity(FLAT_MINIMUM_CAPACITY);
+
+    return result;
+}
+
 PARCHashMap *
 parcHashMap_Create(void)
 {
@@ -243,6 +416,28 @@ parcHashMap_Copy(const PARCHashMap *original)
     result->maxLoadFactor = original->maxLoadFactor;
     result->minLoadFactor = original->minLoadFactor;
     result->size = original->size;
+    result->slotShift = original->slotShift;
+    result->tombstones = 0;
+
+    if (_parcHashMap_IsFlat(original)) {
+        result->buckets = NULL;
+        result->slots = parcMemory_AllocateAndClear(result->capacity * sizeof(_PARCHashMapSlot));
+
+        for (size_t i = 0; i < original->capacity; i++) {
+            const _PARCHashMapSlot *slot = &original->slots[i];
+            if (slot->key != NULL) {
+                _PARCHashMapSlot entry = {
+                    .hashCode = slot->hashCode,
+                    .key      = parcObject_Acquire(slot->key),
+                    .value    = parcObject_Acquire(slot->value)
+                };
+                _parcHashMap_FlatInsert(result->slots, result->capacity, _parcHashMap_FlatHomeSlot(result, slot->hashCode), entry);
+            }
+        }
+        return result;
+    }
+
+    result->slots = NULL;
     result->buckets = parcMemory_Allocate(result->capacity * sizeof(PARCLinkedList*));
 
     for (unsigned int i = 0; i < result->capacity; i++) {
@@ -289,7 +484,19 @@ parcHashMap_Equals(const PARCHashMap *x, const PARCHashMap *y)
         parcHashMap_OptionalAssertValid(x);
         parcHashMap_OptionalAssertValid(y);
 
-        if (x->capacity == y->capacity) {
+        if (_parcHashMap_IsFlat(x) || _parcHashMap_IsFlat(y)) {
+            // The layout of flat storage depends on the order of insertion, so compare the mappings themselves.
+            if (_parcHashMap_IsFlat(x) && _parcHashMap_IsFlat(y) && x->size == y->size) {
+                result = true;
+                for (size_t i = 0; (i < x->capacity) && result; i++) {
+                    const _PARCHashMapSlot *slot = &x->slots[i];
+                    if (slot->key != NULL) {
+                        const _PARCHashMapSlot *other = _parcHashMap_FlatFind(y, slot->key, slot->hashCode);
+                        result = (other != NULL) && parcObject_Equals(slot->value, other->value);
+                    }
+                }
+            }
+        } else if (x->capacity == y->capacity) {
             if (x->size == y->size) {
                 result = true;
                 for (unsigned int i = 0; (i < x->capacity) && result; i++) {
@@ -314,6 +521,15 @@ parcHashMap_HashCode(const PARCHashMap *hashMap)
 
     PARCHashCode result = 0;
 
+    if (_parcHashMap_IsFlat(hashMap)) {
+        for (size_t i = 0; i < hashMap->capacity; i++) {
+            if (hashMap->slots[i].key != NULL) {
+                result += hashMap->slots[i].hashCode;
+            }
+        }
+        return result;
+    }
+
     for (unsigned int i = 0; i < hashMap->capacity; i++) {
         if (hashMap->buckets[i] != NULL) {
             result += parcLinkedList_HashCode(hashMap->buckets[i]);
@@ -332,6 +548,10 @@ parcHashMap_IsValid(const PARCHashMap *map)
         if (parcObject_IsValid(map)) {
             result = true;
 
+            if (_parcHashMap_IsFlat(map)) {
+                return result;
+            }
+
             for (unsigned int i = 0; i < map->capacity; i++) {
                 if (map->buckets[i] != NULL) {
                     if (parcLinkedList_IsValid(map->buckets[i]) == false) {
@@ -416,7 +636,17 @@ parcHashMap_Contains(PARCHashMap *hashMap, const PARCObject *key)
 {
     PARCObject *result = NULL;
 
-    _PARCHashMapEntry *entry = _parcHashMap_GetEntry(hashMap, key);
+    PARCHashCode keyHash = parcObject_HashCode(key);
+
+    if (_parcHashMap_IsFlat(hashMap)) {
+        _PARCHashMapSlot *slot = _parcHashMap_FlatFind(hashMap, key, keyHash);
+        if (slot != NULL) {
+            result = slot->value;
+        }
+        return result;
+    }
+
+    _PARCHashMapEntry *entry = _parcHashMap_GetEntry(hashMap, key, keyHash);
     if (entry != NULL) {
         result = entry->value;
     }
@@ -424,6 +654,28 @@ parcHashMap_Contains(PARCHashMap *hashMap, const PARCObject *key)
     return result;
 }
 
+static void
+_parcHashMap_FlatResize(PARCHashMap *hashMap, size_t newCapacity)
+{
+    _PARCHashMapSlot *newSlots = parcMemory_AllocateAndClear(newCapacity * sizeof(_PARCHashMapSlot));
+
+    _PARCHashMapSlot *cleanupSlots = hashMap->slots;
+    size_t oldCapacity = hashMap->capacity;
+
+    hashMap->slots = newSlots;
+    hashMap->capacity = newCapacity;
+    hashMap->slotShift = _parcHashMap_FlatShift(newCapacity);
+    hashMap->tombstones = 0;
+
+    for (size_t i = 0; i < oldCapacity; i++) {
+        if (cleanupSlots[i].key != NULL) {
+            _parcHashMap_FlatInsert(newSlots, newCapacity, _parcHashMap_FlatHomeSlot(hashMap, cleanupSlots[i].hashCode), cleanupSlots[i]);
+        }
+    }
+
+    parcMemory_Deallocate(&cleanupSlots);
+}
+
 static void
 _parcHashMap_Resize(PARCHashMap *hashMap, size_t newCapacity)
 {
@@ -431,6 +683,11 @@ _parcHashMap_Resize(PARCHashMap *hashMap, size_t newCapacity)
         return;
     }
 
+    if (_parcHashMap_IsFlat(hashMap)) {
+        _parcHashMap_FlatResize(hashMap, newCapacity);
+        return;
+    }
+
     PARCLinkedList **newBuckets = parcMemory_AllocateAndClear(newCapacity * sizeof(PARCLinkedList*));
 
     for (unsigned int i = 0; i < hashMap->capacity; i++) {
@@ -463,23 +720,34 @@ parcHashMap_Remove(PARCHashMap *hashMap, const PARCObject *key)
 {
     PARCHashCode keyHash = parcObject_HashCode(key);
 
-    int bucket = keyHash % hashMap->capacity;
-
     bool result = false;
 
-    if (hashMap->buckets[bucket] != NULL) {
-        PARCIterator *iterator = parcLinkedList_CreateIterator(hashMap->buckets[bucket]);
+    if (_parcHashMap_IsFlat(hashMap)) {
+        _PARCHashMapSlot *slot = _parcHashMap_FlatFind(hashMap, key, keyHash);
+        if (slot != NULL) {
+            parcObject_Release(&slot->key);
+            parcObject_Release(&slot->value);
+            _parcHashMap_FlatDelete(hashMap, slot);
+            hashMap->size--;
+            result = true;
+        }
+    } else {
+        int bucket = keyHash % hashMap->capacity;
 
-        while (parcIterator_HasNext(iterator)) {
-            _PARCHashMapEntry *entry = parcIterator_Next(iterator);
-            if (parcObject_Equals(key, entry->key)) {
-                parcIterator_Remove(iterator);
-                hashMap->size--;
-                result = true;
-                break;
+        if (hashMap->buckets[bucket] != NULL) {
+            PARCIterator *iterator = parcLinkedList_CreateIterator(hashMap->buckets[bucket]);
+
+            while (parcIterator_HasNext(iterator)) {
+                _PARCHashMapEntry *entry = parcIterator_Next(iterator);
+                if (parcObject_Equals(key, entry->key)) {
+                    parcIterator_Remove(iterator);
+                    hashMap->size--;
+                    result = true;
+                    break;
+                }
             }
+            parcIterator_Release(&iterator);
         }
-        parcIterator_Release(&iterator);
     }
 
     // When expanded by 2 the load factor goes from .75 (3/4) to .375 (3/8), if
@@ -507,7 +775,32 @@ parcHashMap_Put(PARCHashMap *hashMap, const PARCObject *key, const PARCObject *v
         _parcHashMap_Resize(hashMap, hashMap->capacity * 2);
     }
 
-    _PARCHashMapEntry *entry = _parcHashMap_GetEntry(hashMap, key);
+    PARCHashCode keyHash = parcObject_HashCode(key);
+
+    if (_parcHashMap_IsFlat(hashMap)) {
+        _PARCHashMapSlot *slot = _parcHashMap_FlatFind(hashMap, key, keyHash);
+
+        if (slot != NULL) {
+            if (slot->value != value) {
+                parcObject_Release(&slot->value);
+                slot->value = parcObject_Acquire(value);
+            }
+        } else {
+            parcObject_OptionalAssertValid(key);
+            parcObject_OptionalAssertValid(value);
+
+            _PARCHashMapSlot entry = {
+                .hashCode = keyHash,
+                .key      = parcObject_Copy(key),
+                .value    = parcObject_Acquire(value)
+            };
+            _parcHashMap_FlatInsert(hashMap->slots, hashMap->capacity, _parcHashMap_FlatHomeSlot(hashMap, keyHash), entry);
+            hashMap->size++;
+        }
+        return hashMap;
+    }
+
+    _PARCHashMapEntry *entry = _parcHashMap_GetEntry(hashMap, key, keyHash);
 
     if (entry != NULL) {
         if (entry->value != value) {
@@ -517,7 +810,6 @@ parcHashMap_Put(PARCHashMap *hashMap, const PARCObject *key, const PARCObject *v
     } else {
         entry = _parcHashMapEntry_Create(key, value);
 
-        PARCHashCode keyHash = parcObject_HashCode(key);
         int bucket = keyHash % hashMap->capacity;
 
         if (hashMap->buckets[bucket] == NULL) {
@@ -536,7 +828,17 @@ parcHashMap_Get(const PARCHashMap *hashMap, const PARCObject *key)
 {
     PARCObject *result = NULL;
 
-    _PARCHashMapEntry *entry = _parcHashMap_GetEntry(hashMap, key);
+    PARCHashCode keyHash = parcObject_HashCode(key);
+
+    if (_parcHashMap_IsFlat(hashMap)) {
+        _PARCHashMapSlot *slot = _parcHashMap_FlatFind(hashMap, key, keyHash);
+        if (slot != NULL) {
+            result = slot->value;
+        }
+        return result;
+    }
+
+    _PARCHashMapEntry *entry = _parcHashMap_GetEntry(hashMap, key, keyHash);
     if (entry != NULL) {
         result = entry->value;
     }
@@ -567,6 +869,20 @@ parcHashMap_GetClusteringNumber(const PARCHashMap *hashMap)
     size_t totalLength = 0;
     double variance = 0;
 
+    if (_parcHashMap_IsFlat(hashMap)) {
+        // For the flat storage the probe length of each entry stands in for the chain-length.
+        for (size_t i = 0; i < hashMap->capacity; ++i) {
+            if (hashMap->slots[i].key != NULL) {
+                size_t probeLength = hashMap->slots[i].probeLength;
+                totalLength++;
+                variance += (probeLength - 1) * (probeLength - 1);
+            }
+        }
+        variance /= ((double)totalLength);
+
+        return sqrt(variance) * ((double)hashMap->capacity/(double)totalLength);
+    }
+
     // Compute the variance vs 1.0
     for (size_t i = 0; i < hashMap->capacity; ++i) {
         if (hashMap->buckets[i] != NULL) {
@@ -589,6 +905,8 @@ typedef struct {
     int bucket;
     PARCIterator *listIterator;
     _PARCHashMapEntry *current;
+    size_t slot;
+    _PARCHashMapSlot *currentSlot;
 } _PARCHashMapIterator;
 
 static _PARCHashMapIterator *
@@ -596,7 +914,11 @@ _parcHashMap_Init(PARCHashMap *map __attribute__((unused)))
 {
     _PARCHashMapIterator *state = parcMemory_AllocateAndClear(sizeof(_PARCHashMapIterator));
 
-    if (state != NULL) {
+    if (state != NULL && _parcHashMap_IsFlat(map)) {
+        state->map = map;
+        state->slot = 0;
+        state->currentSlot = NULL;
+    } else if (state != NULL) {
         state->map = map;
         state->bucket = 0;
         state->listIterator = NULL;
@@ -617,6 +939,11 @@ _parcHashMap_Init(PARCHashMap *map __attribute__((unused)))
 static bool
 _parcHashMap_Fini(PARCHashMap *map __attribute__((unused)), _PARCHashMapIterator *state __attribute__((unused)))
 {
+    // Removal through an iterator leaves tombstones, so the remaining entries don't move while iterating.
+    if (_parcHashMap_IsFlat(map) && map->tombstones > 0) {
+        _parcHashMap_FlatPurgeTombstones(map);
+    }
+
     if (state->listIterator != NULL) {
         parcIterator_Release(&state->listIterator);
     }
@@ -624,9 +951,24 @@ _parcHashMap_Fini(PARCHashMap *map __attribute__((unused)), _PARCHashMapIterator
     return true;
 }
 
+static bool
+_parcHashMap_FlatHasNext(PARCHashMap *map, _PARCHashMapIterator *state)
+{
+    while (state->slot < map->capacity && map->slots[state->slot].key == NULL) {
+        state->slot++;
+    }
+    return state->slot < map->capacity;
+}
+
 static _PARCHashMapIterator *
 _parcHashMap_Next(PARCHashMap *map __attribute__((unused)), _PARCHashMapIterator *state)
 {
+    if (_parcHashMap_IsFlat(map)) {
+        trapOutOfBoundsIf(_parcHashMap_FlatHasNext(map, state) == false, "No more elements.");
+        state->currentSlot = &map->slots[state->slot++];
+        return state;
+    }
+
     _PARCHashMapEntry *result = parcIterator_Next(state->listIterator);
     state->current = result;
     return state;
@@ -637,7 +979,15 @@ _parcHashMap_Remove(PARCHashMap *map, _PARCHashMapIterator **statePtr __attribut
 {
     _PARCHashMapIterator *state = *statePtr;
 
-    if (state->listIterator != NULL) {
+    if (_parcHashMap_IsFlat(map)) {
+        _PARCHashMapSlot *slot = state->currentSlot;
+        if (slot != NULL && slot->key != NULL) {
+            parcObject_Release(&slot->key);
+            parcObject_Release(&slot->value);
+            map->tombstones++;
+            map->size--;
+        }
+    } else if (state->listIterator != NULL) {
         parcIterator_Remove(state->listIterator);
         map->size--;
     }
@@ -647,7 +997,9 @@ static bool
 _parcHashMap_HasNext(PARCHashMap *map __attribute__((unused)), _PARCHashMapIterator *state)
 {
     bool result = false;
-    if (state->listIterator != NULL) {
+    if (_parcHashMap_IsFlat(map)) {
+        result = _parcHashMap_FlatHasNext(map, state);
+    } else if (state->listIterator != NULL) {
         if (parcIterator_HasNext(state->listIterator)) {
             result = true;
         } else {
@@ -667,12 +1019,18 @@ _parcHashMap_HasNext(PARCHashMap *map __attribute__((unused)), _PARCHashMapItera
 static PARCObject *
 _parcHashMapValue_Element(PARCHashMap *map __attribute__((unused)), const _PARCHashMapIterator *state)
 {
+    if (_parcHashMap_IsFlat(map)) {
+        return state->currentSlot->value;
+    }
     return state->current->value;
 }
 
 static PARCObject *
 _parcHashMapKey_Element(PARCHashMap *map __attribute__((unused)), const _PARCHashMapIterator *state)
 {
+    if (_parcHashMap_IsFlat(map)) {
+        return state->currentSlot->key;
+    }
     return state->current->key;
 }
 
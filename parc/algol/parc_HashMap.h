@@ -167,6 +167,59 @@ PARCHashMap *parcHashMap_Create(void);
  */
 PARCHashMap *parcHashMap_CreateCapacity(unsigned int capacity);
 
+/**
+ * Constructs an empty `PARCHashMap` that stores its entries in a single flat array of slots.
+ *
+ * Rather than chaining each bucket through a `PARCLinkedList` of entry objects,
+ * a flat `PARCHashMap` uses open addressing with Robin Hood linear probing.
+ * Each slot holds the cached hash code of the key together with the key and value pointers,
+ * so a `parcHashMap_Put` of a new key allocates nothing but the copy of the key,
+ * and a lookup touches a few adjacent slots without allocating an iterator.
+ *
+ * The number of slots is always a power of two, and is expanded and contracted to keep
+ * the load factor below 0.75 and above 0.25.
+ * All other `PARCHashMap` functions, including the key and value iterators, work unchanged on a flat `PARCHashMap`.
+ * A flat `PARCHashMap` is never equal to a chained `PARCHashMap`.
+ *
+ * @return non-NULL A pointer to a valid PARCHashMap instance.
+ * @return NULL An error occurred.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCHashMap *a = parcHashMap_CreateFlat();
+ *
+ *     parcHashMap_Release(&a);
+ * }
+ * @endcode
+ *
+ * @see parcHashMap_CreateFlatCapacity
+ */
+PARCHashMap *parcHashMap_CreateFlat(void);
+
+/**
+ * Constructs an empty flat `PARCHashMap` with at least the specified minimum number of slots.
+ *
+ * The capacity is rounded up to the next power of two.
+ *
+ * @param [in] capacity The minimum number of slots.
+ *
+ * @return non-NULL A pointer to a valid PARCHashMap instance.
+ * @return NULL An error occurred.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCHashMap *a = parcHashMap_CreateFlatCapacity(1024);
+ *
+ *     parcHashMap_Release(&a);
+ * }
+ * @endcode
+ *
+ * @see parcHashMap_CreateFlat
+ */
+PARCHashMap *parcHashMap_CreateFlatCapacity(unsigned int capacity);
+
 /**
  * Create an independent copy the given `PARCBuffer`
  *
@@ -78,9 +78,9 @@ _parcIterator_Destroy(PARCIterator **iteratorPtr)
 {
     PARCIterator *iterator = *iteratorPtr;
 
-    parcObject_Release(&(iterator->object));
-
     (iterator->fini(iterator->object, iterator->state));
+
+    parcObject_Release(&(iterator->object));
 }
 
 parcObject_ExtendPARCObject(PARCIterator, _parcIterator_Destroy, NULL, NULL, NULL, NULL, NULL, NULL);
@@ -61,16 +61,62 @@
 #include <LongBow/runtime.h>
 
 #include <ctype.h>
+#include <math.h>
 #include <string.h>
 
 #include <parc/algol/parc_JSONParser.h>
 
 #include <parc/algol/parc_BufferComposer.h>
+#include <parc/algol/parc_ByteArray.h>
+#include <parc/algol/parc_Memory.h>
 #include <parc/algol/parc_Object.h>
 
+/*
+ * What the event parser expects next.
+ */
+typedef enum {
+    _PARCJSONParserState_Value = 0,     // A value: the start of the document, after a ':', or after a ',' in an array.
+    _PARCJSONParserState_FirstElement,  // A value or a ']' after a '['.
+    _PARCJSONParserState_FirstKey,      // A key or a '}' after a '{'.
+    _PARCJSONParserState_Key,           // A key after a ',' in an object.
+    _PARCJSONParserState_AfterValue,    // A ',' or the end of the enclosing object or array.
+    _PARCJSONParserState_Done,
+    _PARCJSONParserState_Error
+} _PARCJSONParserState;
+
+/*
+ * Numbers are kept in the same form as a PARCJSONValue number.
+ * Fraction digits beyond what an int64_t can hold are ignored.
+ */
+#define _PARCJSONParser_MaxFractionDigits 18
+
 struct parc_buffer_parser {
     char *ignore;
     PARCBuffer *buffer;
+
+    // The state of the event parser, which keeps its own copy of the buffer's bytes, position and limit.
+    _PARCJSONParserState state;
+    const uint8_t *bytes;
+    size_t position;
+    size_t limit;
+    uint8_t *containers;            // The opening character of each enclosing object or array.
+    size_t depth;
+    size_t containersCapacity;
+
+    // The value of the last event.
+    PARCJSONParserEvent event;
+    PARCBuffer *eventString;        // Either view or scratch.
+    PARCBuffer *view;               // A view of the buffer, set to cover eventStart to eventEnd when it is retrieved.
+    size_t eventStart;
+    size_t eventEnd;
+    PARCBuffer *scratch;            // The current string with its escape sequences decoded.
+    bool eventBoolean;
+    bool eventIsInteger;
+    int eventSign;
+    int64_t eventWhole;
+    int64_t eventFraction;
+    int eventFractionLog10;
+    int64_t eventExponent;
 };
 
 static PARCBuffer *
@@ -84,6 +130,16 @@ _destroyPARCBufferParser(PARCJSONParser **instancePtr)
 {
     PARCJSONParser *parser = *instancePtr;
     parcBuffer_Release(&parser->buffer);
+
+    if (parser->view != NULL) {
+        parcBuffer_Release(&parser->view);
+    }
+    if (parser->scratch != NULL) {
+        parcBuffer_Release(&parser->scratch);
+    }
+    if (parser->containers != NULL) {
+        parcMemory_Deallocate(&parser->containers);
+    }
 }
 
 parcObject_ExtendPARCObject(PARCJSONParser, _destroyPARCBufferParser, NULL, NULL, NULL, NULL, NULL, NULL);
@@ -91,7 +147,7 @@ parcObject_ExtendPARCObject(PARCJSONParser, _destroyPARCBufferParser, NULL, NULL
 PARCJSONParser *
 parcJSONParser_Create(PARCBuffer *buffer)
 {
-    PARCJSONParser *result = parcObject_CreateInstance(PARCJSONParser);
+    PARCJSONParser *result = parcObject_CreateAndClearInstance(PARCJSONParser);
     result->ignore = " \t\n";
     result->buffer = parcBuffer_Acquire(buffer);
     return result;
@@ -179,6 +235,24 @@ parcJSONParser_ParseString(PARCJSONParser *parser)
 
     PARCBuffer *buffer = _getBuffer(parser);
     if (parcBuffer_GetUint8(buffer) == '"') { // skip the initial '"' character starting the string.
+        // Most strings have no escape sequences and are copied in one step.
+        size_t start = parcBuffer_Position(buffer);
+        size_t length = parcBuffer_Remaining(buffer);
+        if (length > 0) {
+            const uint8_t *string = parcByteArray_AddressOfIndex(parcBuffer_Array(buffer), parcBuffer_ArrayOffset(buffer) + start);
+            size_t end = 0;
+            while (end < length && string[end] != '"' && string[end] != '\\' && !iscntrl(string[end])) {
+                end++;
+            }
+            if (end < length && string[end] == '"') {
+                result = parcBuffer_Allocate(end);
+                parcBuffer_PutArray(result, end, string);
+                parcBuffer_Flip(result);
+                parcBuffer_SetPosition(buffer, start + end + 1);
+                return result;
+            }
+        }
+
         PARCBufferComposer *composer = parcBufferComposer_Create();
 
         while (parcBuffer_Remaining(buffer)) {
@@ -220,3 +294,595 @@ parcJSONParser_ParseString(PARCJSONParser *parser)
     }
     return result;
 }
+
+static bool
+_parcJSONParser_IsWhitespace(uint8_t c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+/*
+ * A number or literal must end at whitespace or punctuation, so that "123abc" and "nullx" are errors.
+ */
+static bool
+_parcJSONParser_IsDelimiter(uint8_t c)
+{
+    return _parcJSONParser_IsWhitespace(c) || c == ',' || c == ']' || c == '}' || c == ':';
+}
+
+static size_t
+_parcJSONParser_SkipWhitespace(const uint8_t *bytes, size_t position, size_t limit)
+{
+    while (position < limit && _parcJSONParser_IsWhitespace(bytes[position])) {
+        position++;
+    }
+    return position;
+}
+
+static PARCJSONParserEvent
+_parcJSONParser_Event(PARCJSONParser *parser, size_t position, PARCJSONParserEvent event)
+{
+    parser->position = position;
+    parcBuffer_SetPosition(parser->buffer, position);
+    parser->event = event;
+    return event;
+}
+
+static PARCJSONParserEvent
+_parcJSONParser_Error(PARCJSONParser *parser, size_t position)
+{
+    parser->state = _PARCJSONParserState_Error;
+    parser->eventString = NULL;
+    return _parcJSONParser_Event(parser, position, PARCJSONParserEvent_Error);
+}
+
+static void
+_parcJSONParser_ValueComplete(PARCJSONParser *parser)
+{
+    parser->state = (parser->depth == 0) ? _PARCJSONParserState_Done : _PARCJSONParserState_AfterValue;
+}
+
+static PARCJSONParserEvent
+_parcJSONParser_StartContainer(PARCJSONParser *parser, size_t position, uint8_t opening)
+{
+    if (parser->depth == parser->containersCapacity) {
+        size_t capacity = (parser->containersCapacity == 0) ? 16 : parser->containersCapacity * 2;
+        if (parser->containers == NULL) {
+            parser->containers = parcMemory_Allocate(capacity);
+        } else {
+            parser->containers = parcMemory_Reallocate(parser->containers, capacity);
+        }
+        assertNotNull(parser->containers, "parcMemory_Allocate(%zu) returned NULL", capacity);
+        parser->containersCapacity = capacity;
+    }
+    parser->containers[parser->depth++] = opening;
+
+    if (opening == '{') {
+        parser->state = _PARCJSONParserState_FirstKey;
+        return _parcJSONParser_Event(parser, position + 1, PARCJSONParserEvent_StartObject);
+    }
+    parser->state = _PARCJSONParserState_FirstElement;
+    return _parcJSONParser_Event(parser, position + 1, PARCJSONParserEvent_StartArray);
+}
+
+static PARCJSONParserEvent
+_parcJSONParser_EndContainer(PARCJSONParser *parser, size_t position)
+{
+    uint8_t opening = parser->containers[--parser->depth];
+    _parcJSONParser_ValueComplete(parser);
+    return _parcJSONParser_Event(parser, position + 1,
+                                 (opening == '{') ? PARCJSONParserEvent_EndObject : PARCJSONParserEvent_EndArray);
+}
+
+static uint8_t
+_parcJSONParser_Closing(uint8_t opening)
+{
+    return (opening == '{') ? '}' : ']';
+}
+
+/*
+ * Setting the limit and position of the view is deferred to parcJSONParser_GetEventString,
+ * so that values the caller does not look at cost nothing.
+ */
+static PARCBuffer *
+_parcJSONParser_SetView(PARCJSONParser *parser, size_t start, size_t end)
+{
+    parser->eventStart = start;
+    parser->eventEnd = end;
+    return parser->view;
+}
+
+static bool
+_parcJSONParser_Hex4(const uint8_t *bytes, uint32_t *value)
+{
+    *value = 0;
+    for (int i = 0; i < 4; i++) {
+        uint8_t c = bytes[i];
+        uint32_t digit;
+        if (c >= '0' && c <= '9') {
+            digit = c - '0';
+        } else if (c >= 'a' && c <= 'f') {
+            digit = c - 'a' + 10;
+        } else if (c >= 'A' && c <= 'F') {
+            digit = c - 'A' + 10;
+        } else {
+            return false;
+        }
+        *value = (*value << 4) | digit;
+    }
+    return true;
+}
+
+static size_t
+_parcJSONParser_EncodeUTF8(uint32_t codePoint, uint8_t *output)
+{
+    if (codePoint < 0x80) {
+        output[0] = (uint8_t) codePoint;
+        return 1;
+    } else if (codePoint < 0x800) {
+        output[0] = (uint8_t) (0xC0 | (codePoint >> 6));
+        output[1] = (uint8_t) (0x80 | (codePoint & 0x3F));
+        return 2;
+    } else if (codePoint < 0x10000) {
+        output[0] = (uint8_t) (0xE0 | (codePoint >> 12));
+        output[1] = (uint8_t) (0x80 | ((codePoint >> 6) & 0x3F));
+        output[2] = (uint8_t) (0x80 | (codePoint & 0x3F));
+        return 3;
+    }
+    output[0] = (uint8_t) (0xF0 | (codePoint >> 18));
+    output[1] = (uint8_t) (0x80 | ((codePoint >> 12) & 0x3F));
+    output[2] = (uint8_t) (0x80 | ((codePoint >> 6) & 0x3F));
+    output[3] = (uint8_t) (0x80 | (codePoint & 0x3F));
+    return 4;
+}
+
+/*
+ * Decode the escape sequences in the bytes of a string (without its quotes) into the parser's scratch buffer.
+ * The decoded string is never longer than the encoded one.
+ * Return the offset of the first invalid escape sequence, or length if there is none.
+ */
+static size_t
+_parcJSONParser_Unescape(PARCJSONParser *parser, const uint8_t *string, size_t length)
+{
+    if (parser->scratch == NULL || parcBuffer_Capacity(parser->scratch) < length) {
+        size_t capacity = 64;
+        if (parser->scratch != NULL) {
+            capacity = parcBuffer_Capacity(parser->scratch) * 2;
+            parcBuffer_Release(&parser->scratch);
+        }
+        if (capacity < length) {
+            capacity = length;
+        }
+        parser->scratch = parcBuffer_Allocate(capacity);
+    }
+    uint8_t *output = parcByteArray_Array(parcBuffer_Array(parser->scratch));
+
+    size_t outputLength = 0;
+    size_t i = 0;
+    while (i < length) {
+        uint8_t c = string[i];
+        if (c != '\\') {
+            output[outputLength++] = c;
+            i++;
+            continue;
+        }
+
+        size_t escape = i;
+        c = string[i + 1];
+        i += 2;
+        switch (c) {
+            case '"':
+            case '\\':
+            case '/':
+                output[outputLength++] = c;
+                break;
+            case 'b':
+                output[outputLength++] = '\b';
+                break;
+            case 'f':
+                output[outputLength++] = '\f';
+                break;
+            case 'n':
+                output[outputLength++] = '\n';
+                break;
+            case 'r':
+                output[outputLength++] = '\r';
+                break;
+            case 't':
+                output[outputLength++] = '\t';
+                break;
+            case 'u': {
+                uint32_t codePoint;
+                if (i + 4 > length || !_parcJSONParser_Hex4(&string[i], &codePoint)) {
+                    return escape;
+                }
+                i += 4;
+                if (codePoint >= 0xDC00 && codePoint <= 0xDFFF) {
+                    return escape;
+                }
+                if (codePoint >= 0xD800 && codePoint <= 0xDBFF) {
+                    // A character outside the Basic Multilingual Plane is encoded as a surrogate pair.
+                    uint32_t low;
+                    if (i + 6 > length || string[i] != '\\' || string[i + 1] != 'u'
+                        || !_parcJSONParser_Hex4(&string[i + 2], &low) || low < 0xDC00 || low > 0xDFFF) {
+                        return escape;
+                    }
+                    i += 6;
+                    codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+                }
+                outputLength += _parcJSONParser_EncodeUTF8(codePoint, &output[outputLength]);
+                break;
+            }
+            default:
+                return escape;
+        }
+    }
+
+    parcBuffer_Clear(parser->scratch);
+    parcBuffer_SetLimit(parser->scratch, outputLength);
+    return length;
+}
+
+/*
+ * Parse the string starting with the '"' at position, leaving it in eventString.
+ * Return the position after the closing '"', or 0 (never the position after a string) if there is a syntax error,
+ * in which case errorPosition is the offending character.
+ */
+static size_t
+_parcJSONParser_String(PARCJSONParser *parser, const uint8_t *bytes, size_t position, size_t limit, size_t *errorPosition)
+{
+    size_t start = position + 1;
+    size_t end = start;
+    bool escaped = false;
+
+    while (end < limit && bytes[end] != '"') {
+        if (bytes[end] < 0x20) {
+            *errorPosition = end;
+            return 0;
+        }
+        if (bytes[end] == '\\') {
+            escaped = true;
+            end++;
+        }
+        end++;
+    }
+    if (end >= limit) {
+        *errorPosition = limit;
+        return 0;
+    }
+
+    if (escaped) {
+        size_t length = end - start;
+        size_t invalid = _parcJSONParser_Unescape(parser, &bytes[start], length);
+        if (invalid != length) {
+            *errorPosition = start + invalid;
+            return 0;
+        }
+        parser->eventString = parser->scratch;
+    } else {
+        parser->eventString = _parcJSONParser_SetView(parser, start, end);
+    }
+    return end + 1;
+}
+
+static bool
+_parcJSONParser_IsDigit(uint8_t c)
+{
+    return c >= '0' && c <= '9';
+}
+
+static PARCJSONParserEvent
+_parcJSONParser_Number(PARCJSONParser *parser, const uint8_t *bytes, size_t position, size_t limit)
+{
+    size_t start = position;
+    int sign = 1;
+    int64_t whole = 0;
+    int64_t fraction = 0;
+    int fractionLog10 = 0;
+    int64_t exponent = 0;
+    bool isInteger = true;
+
+    if (bytes[position] == '-') {
+        sign = -1;
+        position++;
+    }
+    if (position == limit || !_parcJSONParser_IsDigit(bytes[position])) {
+        return _parcJSONParser_Error(parser, position);
+    }
+    if (bytes[position] == '0') {
+        position++;
+    } else {
+        while (position < limit && _parcJSONParser_IsDigit(bytes[position])) {
+            whole = whole * 10 + (bytes[position++] - '0');
+        }
+    }
+
+    if (position < limit && bytes[position] == '.') {
+        isInteger = false;
+        position++;
+        if (position == limit || !_parcJSONParser_IsDigit(bytes[position])) {
+            return _parcJSONParser_Error(parser, position);
+        }
+        while (position < limit && _parcJSONParser_IsDigit(bytes[position])) {
+            if (fractionLog10 < _PARCJSONParser_MaxFractionDigits) {
+                fraction = fraction * 10 + (bytes[position] - '0');
+                fractionLog10++;
+            }
+            position++;
+        }
+    }
+
+    if (position < limit && (bytes[position] == 'e' || bytes[position] == 'E')) {
+        isInteger = false;
+        position++;
+        int exponentSign = 1;
+        if (position < limit && (bytes[position] == '+' || bytes[position] == '-')) {
+            exponentSign = (bytes[position] == '-') ? -1 : 1;
+            position++;
+        }
+        if (position == limit || !_parcJSONParser_IsDigit(bytes[position])) {
+            return _parcJSONParser_Error(parser, position);
+        }
+        while (position < limit && _parcJSONParser_IsDigit(bytes[position])) {
+            if (exponent < 100000) {
+                exponent = exponent * 10 + (bytes[position] - '0');
+            }
+            position++;
+        }
+        exponent *= exponentSign;
+    }
+
+    if (position < limit && !_parcJSONParser_IsDelimiter(bytes[position])) {
+        return _parcJSONParser_Error(parser, position);
+    }
+
+    parser->eventString = _parcJSONParser_SetView(parser, start, position);
+    parser->eventIsInteger = isInteger;
+    parser->eventSign = sign;
+    parser->eventWhole = whole;
+    parser->eventFraction = fraction;
+    parser->eventFractionLog10 = fractionLog10;
+    parser->eventExponent = exponent;
+
+    _parcJSONParser_ValueComplete(parser);
+    return _parcJSONParser_Event(parser, position, PARCJSONParserEvent_Number);
+}
+
+static PARCJSONParserEvent
+_parcJSONParser_Literal(PARCJSONParser *parser, const uint8_t *bytes, size_t position, size_t limit,
+                        const char *literal, PARCJSONParserEvent event)
+{
+    size_t length = strlen(literal);
+    if (limit - position < length || memcmp(&bytes[position], literal, length) != 0) {
+        return _parcJSONParser_Error(parser, position);
+    }
+    position += length;
+    if (position < limit && !_parcJSONParser_IsDelimiter(bytes[position])) {
+        return _parcJSONParser_Error(parser, position);
+    }
+
+    parser->eventBoolean = (literal[0] == 't');
+    _parcJSONParser_ValueComplete(parser);
+    return _parcJSONParser_Event(parser, position, event);
+}
+
+static PARCJSONParserEvent
+_parcJSONParser_Value(PARCJSONParser *parser, const uint8_t *bytes, size_t position, size_t limit)
+{
+    switch (bytes[position]) {
+        case '{':
+        case '[':
+            return _parcJSONParser_StartContainer(parser, position, bytes[position]);
+
+        case '"': {
+            size_t errorPosition;
+            size_t next = _parcJSONParser_String(parser, bytes, position, limit, &errorPosition);
+            if (next == 0) {
+                return _parcJSONParser_Error(parser, errorPosition);
+            }
+            _parcJSONParser_ValueComplete(parser);
+            return _parcJSONParser_Event(parser, next, PARCJSONParserEvent_String);
+        }
+
+        case 't':
+            return _parcJSONParser_Literal(parser, bytes, position, limit, "true", PARCJSONParserEvent_Boolean);
+
+        case 'f':
+            return _parcJSONParser_Literal(parser, bytes, position, limit, "false", PARCJSONParserEvent_Boolean);
+
+        case 'n':
+            return _parcJSONParser_Literal(parser, bytes, position, limit, "null", PARCJSONParserEvent_Null);
+
+        default:
+            if (bytes[position] == '-' || _parcJSONParser_IsDigit(bytes[position])) {
+                return _parcJSONParser_Number(parser, bytes, position, limit);
+            }
+            return _parcJSONParser_Error(parser, position);
+    }
+}
+
+static PARCJSONParserEvent
+_parcJSONParser_Key(PARCJSONParser *parser, const uint8_t *bytes, size_t position, size_t limit)
+{
+    if (bytes[position] != '"') {
+        return _parcJSONParser_Error(parser, position);
+    }
+
+    size_t errorPosition;
+    size_t next = _parcJSONParser_String(parser, bytes, position, limit, &errorPosition);
+    if (next == 0) {
+        return _parcJSONParser_Error(parser, errorPosition);
+    }
+
+    next = _parcJSONParser_SkipWhitespace(bytes, next, limit);
+    if (next == limit || bytes[next] != ':') {
+        return _parcJSONParser_Error(parser, next);
+    }
+
+    parser->state = _PARCJSONParserState_Value;
+    return _parcJSONParser_Event(parser, next + 1, PARCJSONParserEvent_Key);
+}
+
+PARCJSONParserEvent
+parcJSONParser_NextEvent(PARCJSONParser *parser)
+{
+    parcJSONParser_OptionalAssertValid(parser);
+
+    if (parser->state == _PARCJSONParserState_Done) {
+        parser->eventString = NULL;
+        return parser->event = PARCJSONParserEvent_EndDocument;
+    }
+    if (parser->state == _PARCJSONParserState_Error) {
+        return PARCJSONParserEvent_Error;
+    }
+
+    if (parser->bytes == NULL) {
+        PARCBuffer *buffer = _getBuffer(parser);
+        parser->bytes = parcByteArray_Array(parcBuffer_Array(buffer)) + parcBuffer_ArrayOffset(buffer);
+        parser->position = parcBuffer_Position(buffer);
+        parser->limit = parcBuffer_Limit(buffer);
+        parser->view = parcBuffer_Duplicate(buffer);
+    }
+    const uint8_t *bytes = parser->bytes;
+    size_t limit = parser->limit;
+    size_t position = _parcJSONParser_SkipWhitespace(bytes, parser->position, limit);
+
+    parser->eventString = NULL;
+
+    if (parser->state == _PARCJSONParserState_AfterValue) {
+        uint8_t closing = _parcJSONParser_Closing(parser->containers[parser->depth - 1]);
+        if (position < limit && bytes[position] == closing) {
+            return _parcJSONParser_EndContainer(parser, position);
+        }
+        if (position == limit || bytes[position] != ',') {
+            return _parcJSONParser_Error(parser, position);
+        }
+        position = _parcJSONParser_SkipWhitespace(bytes, position + 1, limit);
+        parser->state = (closing == '}') ? _PARCJSONParserState_Key : _PARCJSONParserState_Value;
+    }
+
+    if (position == limit) {
+        return _parcJSONParser_Error(parser, position);
+    }
+
+    switch (parser->state) {
+        case _PARCJSONParserState_FirstKey:
+            if (bytes[position] == '}') {
+                return _parcJSONParser_EndContainer(parser, position);
+            }
+            return _parcJSONParser_Key(parser, bytes, position, limit);
+
+        case _PARCJSONParserState_Key:
+            return _parcJSONParser_Key(parser, bytes, position, limit);
+
+        case _PARCJSONParserState_FirstElement:
+            if (bytes[position] == ']') {
+                return _parcJSONParser_EndContainer(parser, position);
+            }
+            return _parcJSONParser_Value(parser, bytes, position, limit);
+
+        default:
+            return _parcJSONParser_Value(parser, bytes, position, limit);
+    }
+}
+
+bool
+parcJSONParser_ParseEvents(PARCJSONParser *parser, PARCJSONParserEventHandler *handler, void *context)
+{
+    assertNotNull(handler, "The handler cannot be NULL");
+
+    for (;;) {
+        PARCJSONParserEvent event = parcJSONParser_NextEvent(parser);
+        if (handler(parser, event, context) == false) {
+            return false;
+        }
+        if (event == PARCJSONParserEvent_EndDocument) {
+            return true;
+        }
+        if (event == PARCJSONParserEvent_Error) {
+            return false;
+        }
+    }
+}
+
+bool
+parcJSONParser_SkipValue(PARCJSONParser *parser)
+{
+    PARCJSONParserEvent event = parcJSONParser_NextEvent(parser);
+
+    if (event == PARCJSONParserEvent_StartObject || event == PARCJSONParserEvent_StartArray) {
+        size_t depth = parser->depth - 1;
+        while (parser->depth > depth) {
+            event = parcJSONParser_NextEvent(parser);
+            if (event == PARCJSONParserEvent_Error) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    return event == PARCJSONParserEvent_String || event == PARCJSONParserEvent_Number
+           || event == PARCJSONParserEvent_Boolean || event == PARCJSONParserEvent_Null;
+}
+
+size_t
+parcJSONParser_GetDepth(const PARCJSONParser *parser)
+{
+    parcJSONParser_OptionalAssertValid(parser);
+
+    return parser->depth;
+}
+
+PARCBuffer *
+parcJSONParser_GetEventString(const PARCJSONParser *parser)
+{
+    parcJSONParser_OptionalAssertValid(parser);
+
+    trapUnexpectedStateIf(parser->eventString == NULL,
+                          "Expected the last event to be a key, string or number, actual event %d", parser->event);
+
+    if (parser->eventString == parser->view) {
+        parcBuffer_SetLimit(parser->view, parser->eventEnd);
+        parcBuffer_SetPosition(parser->view, parser->eventStart);
+    }
+    return parser->eventString;
+}
+
+int64_t
+parcJSONParser_GetEventInteger(const PARCJSONParser *parser)
+{
+    parcJSONParser_OptionalAssertValid(parser);
+
+    trapUnexpectedStateIf(parser->event != PARCJSONParserEvent_Number,
+                          "Expected the last event to be a number, actual event %d", parser->event);
+
+    if (parser->eventIsInteger) {
+        return parser->eventSign * parser->eventWhole;
+    }
+    return llrintl(parcJSONParser_GetEventFloat(parser));
+}
+
+long double
+parcJSONParser_GetEventFloat(const PARCJSONParser *parser)
+{
+    parcJSONParser_OptionalAssertValid(parser);
+
+    trapUnexpectedStateIf(parser->event != PARCJSONParserEvent_Number,
+                          "Expected the last event to be a number, actual event %d", parser->event);
+
+    long double fraction = parser->eventFraction / powl(10.0, parser->eventFractionLog10);
+    long double number = (long double) parser->eventSign * ((long double) parser->eventWhole + fraction);
+
+    return number * powl(10.0, (long double) parser->eventExponent);
+}
+
+bool
+parcJSONParser_GetEventBoolean(const PARCJSONParser *parser)
+{
+    parcJSONParser_OptionalAssertValid(parser);
+
+    trapUnexpectedStateIf(parser->event != PARCJSONParserEvent_Boolean,
+                          "Expected the last event to be a boolean, actual event %d", parser->event);
+
+    return parser->eventBoolean;
+}
@@ -68,6 +68,39 @@ typedef struct parc_buffer_parser PARCJSONParser;
 
 #include <parc/algol/parc_Buffer.h>
 
+/**
+ * @typedef PARCJSONParserEvent
+ * @brief The events produced by the event (pull) interface of `PARCJSONParser`.
+ *
+ * A JSON document produces a well-nested sequence of events terminated by `PARCJSONParserEvent_EndDocument`.
+ * Inside an object, every value is preceded by a `PARCJSONParserEvent_Key` event.
+ */
+typedef enum {
+    PARCJSONParserEvent_StartObject = 1,
+    PARCJSONParserEvent_EndObject = 2,
+    PARCJSONParserEvent_StartArray = 3,
+    PARCJSONParserEvent_EndArray = 4,
+    PARCJSONParserEvent_Key = 5,
+    PARCJSONParserEvent_String = 6,
+    PARCJSONParserEvent_Number = 7,
+    PARCJSONParserEvent_Boolean = 8,
+    PARCJSONParserEvent_Null = 9,
+    PARCJSONParserEvent_EndDocument = 10,
+    PARCJSONParserEvent_Error = 11
+} PARCJSONParserEvent;
+
+/**
+ * The function called for each event by {@link parcJSONParser_ParseEvents}.
+ *
+ * @param [in] parser A pointer to the `PARCJSONParser` producing the event.
+ * @param [in] event The event.
+ * @param [in] context The context pointer given to `parcJSONParser_ParseEvents`.
+ *
+ * @return true Continue parsing.
+ * @return false Stop parsing.
+ */
+typedef bool (PARCJSONParserEventHandler)(PARCJSONParser *parser, PARCJSONParserEvent event, void *context);
+
 /**
  * @def parcJSONValue_OptionalAssertValid
  * Optional validation of the given instance.
@@ -347,4 +380,231 @@ bool parcJSONParser_RequireString(PARCJSONParser *parser, const char *string);
  */
 PARCBuffer *parcJSONParser_ParseString(PARCJSONParser *parser);
 
+/**
+ * Parse the next event from the JSON document at the current position of the parser.
+ *
+ * This is the event, or pull, interface to the parser.
+ * Instead of building a tree of `PARCJSONValue` instances, the caller asks for one event at a time and
+ * retrieves the value of the event with {@link parcJSONParser_GetEventString}, {@link parcJSONParser_GetEventInteger},
+ * {@link parcJSONParser_GetEventFloat} or {@link parcJSONParser_GetEventBoolean}.
+ *
+ * Apart from growing the parser's reusable state to fit the document, parsing allocates nothing per event.
+ * Strings and numbers are returned as a view of the parser's buffer;
+ * only a string containing escape sequences is decoded, into a buffer the parser reuses.
+ *
+ * Once the top-level value is complete, the parser returns `PARCJSONParserEvent_EndDocument`,
+ * leaving its position after the value.
+ * After a syntax error the parser returns `PARCJSONParserEvent_Error`, leaving its position at the offending character.
+ * Both are returned again by every following call.
+ *
+ * Do not mix the event interface with the other parsing functions on the same parser.
+ *
+ * @param [in] parser A pointer to a valid `PARCJSONParser` instance.
+ *
+ * @return The next event.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBuffer *buffer = parcBuffer_WrapCString("{ \"name\" : 123 }");
+ *     PARCJSONParser *parser = parcJSONParser_Create(buffer);
+ *
+ *     PARCJSONParserEvent event;
+ *     while ((event = parcJSONParser_NextEvent(parser)) != PARCJSONParserEvent_EndDocument) {
+ *         if (event == PARCJSONParserEvent_Number) {
+ *             printf("%" PRId64 "\n", parcJSONParser_GetEventInteger(parser));
+ *         } else if (event == PARCJSONParserEvent_Error) {
+ *             break;
+ *         }
+ *     }
+ *
+ *     parcJSONParser_Release(&parser);
+ *     parcBuffer_Release(&buffer);
+ * }
+ * @endcode
+ *
+ * @see parcJSONParser_ParseEvents
+ */
+PARCJSONParserEvent parcJSONParser_NextEvent(PARCJSONParser *parser);
+
+/**
+ * Parse the JSON document at the current position of the parser, calling @p handler for each event.
+ *
+ * This is the callback, or SAX, form of {@link parcJSONParser_NextEvent}.
+ * The handler is called for every event, including the final `PARCJSONParserEvent_EndDocument` or
+ * `PARCJSONParserEvent_Error`, and may retrieve the value of the event from @p parser.
+ *
+ * @param [in] parser A pointer to a valid `PARCJSONParser` instance.
+ * @param [in] handler A pointer to a `PARCJSONParserEventHandler` function.
+ * @param [in] context A pointer passed to every call of @p handler.
+ *
+ * @return true The whole document was parsed.
+ * @return false There was a syntax error, or @p handler stopped parsing.
+ *
+ * Example:
+ * @code
+ * static bool
+ * _countNumbers(PARCJSONParser *parser, PARCJSONParserEvent event, void *context)
+ * {
+ *     if (event == PARCJSONParserEvent_Number) {
+ *         (*(size_t *) context)++;
+ *     }
+ *     return true;
+ * }
+ *
+ * {
+ *     PARCBuffer *buffer = parcBuffer_WrapCString("[ 1, 2, 3 ]");
+ *     PARCJSONParser *parser = parcJSONParser_Create(buffer);
+ *     size_t count = 0;
+ *     bool success = parcJSONParser_ParseEvents(parser, _countNumbers, &count);
+ *     parcJSONParser_Release(&parser);
+ *     parcBuffer_Release(&buffer);
+ * }
+ * @endcode
+ */
+bool parcJSONParser_ParseEvents(PARCJSONParser *parser, PARCJSONParserEventHandler *handler, void *context);
+
+/**
+ * Skip the next value, including everything in it if it is an object or an array.
+ *
+ * Call this where a value is expected, for example after a `PARCJSONParserEvent_Key` event
+ * to ignore the value of a member that is not of interest.
+ *
+ * @param [in] parser A pointer to a valid `PARCJSONParser` instance.
+ *
+ * @return true A value was skipped.
+ * @return false There was a syntax error, or no value was next.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBuffer *buffer = parcBuffer_WrapCString("{ \"skip\" : [ 1, 2 ], \"name\" : 123 }");
+ *     PARCJSONParser *parser = parcJSONParser_Create(buffer);
+ *     parcJSONParser_NextEvent(parser); // PARCJSONParserEvent_StartObject
+ *     parcJSONParser_NextEvent(parser); // PARCJSONParserEvent_Key "skip"
+ *     parcJSONParser_SkipValue(parser);
+ *     parcJSONParser_NextEvent(parser); // PARCJSONParserEvent_Key "name"
+ *     parcJSONParser_Release(&parser);
+ *     parcBuffer_Release(&buffer);
+ * }
+ * @endcode
+ */
+bool parcJSONParser_SkipValue(PARCJSONParser *parser);
+
+/**
+ * Get the number of objects and arrays that enclose the current position of the event parser.
+ *
+ * @param [in] parser A pointer to a valid `PARCJSONParser` instance.
+ *
+ * @return The nesting depth, 0 at the top level of the document.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBuffer *buffer = parcBuffer_WrapCString("{ \"name\" : 123 }");
+ *     PARCJSONParser *parser = parcJSONParser_Create(buffer);
+ *     parcJSONParser_NextEvent(parser);
+ *     size_t depth = parcJSONParser_GetDepth(parser); // 1
+ *     parcJSONParser_Release(&parser);
+ *     parcBuffer_Release(&buffer);
+ * }
+ * @endcode
+ */
+size_t parcJSONParser_GetDepth(const PARCJSONParser *parser);
+
+/**
+ * Get the text of the last `PARCJSONParserEvent_Key`, `PARCJSONParserEvent_String` or `PARCJSONParserEvent_Number` event.
+ *
+ * The result is owned by the parser and is valid only until the next event.
+ * For a key or string without escape sequences, and for a number, it is a view of the parser's buffer;
+ * a key or string with escape sequences is decoded into a buffer the parser reuses.
+ * Use {@link parcBuffer_Slice} on the result to keep a zero-copy reference to a string without escapes,
+ * or {@link parcBuffer_Copy} to keep a copy of any string.
+ *
+ * @param [in] parser A pointer to a valid `PARCJSONParser` instance.
+ *
+ * @return A pointer to a `PARCBuffer` whose remaining bytes are the text of the key, string or number.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBuffer *buffer = parcBuffer_WrapCString("\"name\"");
+ *     PARCJSONParser *parser = parcJSONParser_Create(buffer);
+ *     parcJSONParser_NextEvent(parser);
+ *     char *name = parcBuffer_ToString(parcJSONParser_GetEventString(parser));
+ *     parcMemory_Deallocate(&name);
+ *     parcJSONParser_Release(&parser);
+ *     parcBuffer_Release(&buffer);
+ * }
+ * @endcode
+ */
+PARCBuffer *parcJSONParser_GetEventString(const PARCJSONParser *parser);
+
+/**
+ * Get the value of the last `PARCJSONParserEvent_Number` event as an integer.
+ *
+ * A number with a fraction or an exponent is rounded to the nearest integer.
+ *
+ * @param [in] parser A pointer to a valid `PARCJSONParser` instance.
+ *
+ * @return The value of the number.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBuffer *buffer = parcBuffer_WrapCString("[ 123 ]");
+ *     PARCJSONParser *parser = parcJSONParser_Create(buffer);
+ *     parcJSONParser_NextEvent(parser);
+ *     parcJSONParser_NextEvent(parser);
+ *     int64_t value = parcJSONParser_GetEventInteger(parser);
+ *     parcJSONParser_Release(&parser);
+ *     parcBuffer_Release(&buffer);
+ * }
+ * @endcode
+ */
+int64_t parcJSONParser_GetEventInteger(const PARCJSONParser *parser);
+
+/**
+ * Get the value of the last `PARCJSONParserEvent_Number` event as a floating point number.
+ *
+ * @param [in] parser A pointer to a valid `PARCJSONParser` instance.
+ *
+ * @return The value of the number.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBuffer *buffer = parcBuffer_WrapCString("[ 3.14 ]");
+ *     PARCJSONParser *parser = parcJSONParser_Create(buffer);
+ *     parcJSONParser_NextEvent(parser);
+ *     parcJSONParser_NextEvent(parser);
+ *     long double value = parcJSONParser_GetEventFloat(parser);
+ *     parcJSONParser_Release(&parser);
+ *     parcBuffer_Release(&buffer);
+ * }
+ * @endcode
+ */
+long double parcJSONParser_GetEventFloat(const PARCJSONParser *parser);
+
+/**
+ * Get the value of the last `PARCJSONParserEvent_Boolean` event.
+ *
+ * @param [in] parser A pointer to a valid `PARCJSONParser` instance.
+ *
+ * @return The value of the boolean.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBuffer *buffer = parcBuffer_WrapCString("true");
+ *     PARCJSONParser *parser = parcJSONParser_Create(buffer);
+ *     parcJSONParser_NextEvent(parser);
+ *     bool value = parcJSONParser_GetEventBoolean(parser);
+ *     parcJSONParser_Release(&parser);
+ *     parcBuffer_Release(&buffer);
+ * }
+ * @endcode
+ */
+bool parcJSONParser_GetEventBoolean(const PARCJSONParser *parser);
+
 #endif
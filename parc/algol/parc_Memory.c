@@ -152,6 +152,15 @@ parcMemory_Outstanding(void)
     return ((PARCMemoryOutstanding *) parcMemory->Outstanding)();
 }
 
+bool
+parcMemory_GetStatistics(PARCMemoryStatistics *total, PARCMemoryStatistics *thread)
+{
+    if (parcMemory->Statistics == 0) {
+        return false;
+    }
+    return ((PARCMemoryGetStatistics *) parcMemory->Statistics)(total, thread);
+}
+
 char *
 parcMemory_Format(const char *format, ...)
 {
@@ -181,5 +190,6 @@ PARCMemoryInterface PARCMemoryAsPARCMemory = {
     .Deallocate       = (uintptr_t) parcMemory_DeallocateImpl,
     .Reallocate       = (uintptr_t) parcMemory_Reallocate,
     .StringDuplicate  = (uintptr_t) parcMemory_StringDuplicate,
-    .Outstanding      = (uintptr_t) parcMemory_Outstanding
+    .Outstanding      = (uintptr_t) parcMemory_Outstanding,
+    .Statistics       = (uintptr_t) parcMemory_GetStatistics
 };
@@ -70,6 +70,7 @@
 
 #include <stdlib.h>
 #include <stdint.h>
+#include <stdbool.h>
 
 /**
  * @typedef PARCMemoryAllocate
@@ -90,6 +91,22 @@ typedef char *(PARCMemoryStringDuplicate)(const char *string, size_t length);
 
 typedef uint32_t (PARCMemoryOutstanding)(void);
 
+/**
+ * @typedef PARCMemoryStatistics
+ * @brief Allocation counts and byte totals reported by a PARC Memory manager.
+ *
+ * All values are cumulative; the outstanding values are the difference between the
+ * allocated and deallocated values.
+ */
+typedef struct parc_memory_statistics {
+    uint64_t allocations;      // The number of allocations made.
+    uint64_t deallocations;    // The number of allocations deallocated.
+    uint64_t bytesAllocated;   // The number of bytes allocated.
+    uint64_t bytesDeallocated; // The number of bytes deallocated.
+} PARCMemoryStatistics;
+
+typedef bool (PARCMemoryGetStatistics)(PARCMemoryStatistics *total, PARCMemoryStatistics *thread);
+
 /**
  * @typedef PARCMemoryInterface
  * @brief A structure containing pointers to functions that implement a PARC Memory manager.
@@ -212,6 +229,21 @@ typedef struct parc_memory_interface {
      * @return The number of outstanding allocations known to this `PARCMemoryInterface`.
      */
     uintptr_t Outstanding;
+
+    /**
+     * Fill in the statistics of the whole process and of the calling thread.
+     *
+     * This member is optional and may be zero for an interface that does not keep statistics.
+     * Counts are attributed to the thread performing the operation,
+     * so a thread that deallocates memory allocated by another thread may deallocate more than it allocated.
+     *
+     * @param [out] total If not NULL, set to the statistics of every thread, including threads that have exited.
+     * @param [out] thread If not NULL, set to the statistics of the calling thread.
+     *
+     * @return true The statistics were filled in.
+     * @return false This `PARCMemoryInterface` does not keep statistics.
+     */
+    uintptr_t Statistics;
 } PARCMemoryInterface;
 
 /**
@@ -438,6 +470,28 @@ char *parcMemory_StringDuplicate(const char *string, const size_t length);
  */
 uint32_t parcMemory_Outstanding(void);
 
+/**
+ * Get the allocation statistics of the whole process and of the calling thread from the current memory interface.
+ *
+ * @param [out] total If not NULL, set to the statistics of every thread, including threads that have exited.
+ * @param [out] thread If not NULL, set to the statistics of the calling thread.
+ *
+ * @return true The statistics were filled in.
+ * @return false The current `PARCMemoryInterface` does not keep statistics.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCMemoryStatistics total;
+ *     PARCMemoryStatistics thread;
+ *     if (parcMemory_GetStatistics(&total, &thread)) {
+ *         printf("This thread has %" PRIu64 " bytes outstanding\n", thread.bytesAllocated - thread.bytesDeallocated);
+ *     }
+ * }
+ * @endcode
+ */
+bool parcMemory_GetStatistics(PARCMemoryStatistics *total, PARCMemoryStatistics *thread);
+
 /**
  * Round up a given number of bytes to be a multiple of the cache line size on the target computer.
  *
@@ -76,6 +76,7 @@
 #include <parc/algol/parc_DisplayIndented.h>
 #include <parc/algol/parc_Object.h>
 #include <parc/algol/parc_Memory.h>
+#include <parc/algol/parc_ObjectSlab.h>
 #include <parc/algol/parc_Hash.h>
 #include <parc/concurrent/parc_AtomicUint64.h>
 
@@ -94,15 +95,16 @@ typedef struct object_header {
     uint32_t magicGuardNumber;
     bool isAllocated;
     bool barrier;
+    // The identifier of the slab the object was allocated from, or 0 if it was allocated directly from parcMemory.
+    uint16_t slabId;
     PARCReferenceCount references;
     const PARCObjectDescriptor *descriptor;
 
-    // The locking member points to the locking structure or is NULL if the object does not support locking.
+    // The locking member points to the locking structure, or is NULL if the object has never been locked.
+    // The structure is allocated on the first lock of an object whose descriptor is lockable,
+    // so objects that are never locked pay neither the memory nor the pthread initialisation cost.
     _PARCObjectLocking *locking;
 
-    // Currently every object is lockable, but at some point in the future this will be controlled by the descriptor.
-    _PARCObjectLocking lock;
-
     void *data[];
 } _PARCObjectHeader;
 
@@ -160,10 +162,13 @@ _parcObject_Descriptor(const PARCObject *object)
     return (_parcObject_Header(object)->descriptor);
 }
 
+/*
+ * Return the locking structure of the given object, or NULL if the object has never been locked.
+ */
 static inline _PARCObjectLocking *
 _parcObjectHeader_Locking(const PARCObject *object)
 {
-    return _parcObject_Header(object)->locking;
+    return __atomic_load_n(&_parcObject_Header(object)->locking, __ATOMIC_ACQUIRE);
 }
 
 static inline bool
@@ -347,6 +352,7 @@ parcObject_DescriptorName(PARCObject) =
     .display         = _parcObject_Display,
     .super           = NULL,
     .isLockable      = true,
+    .isSlabAllocated = false,
     .objectSize      = 0,
     .objectAlignment = sizeof(void *)
 };
@@ -378,9 +384,6 @@ _parcObjectHeader_AssertValid(const _PARCObjectHeader *header, const PARCObject
 {
     trapIllegalValueIf(header->magicGuardNumber != PARCObject_HEADER_MAGIC_GUARD_NUMBER, "PARCObject@%p is corrupt.", object);
     trapIllegalValueIf(header->descriptor == NULL, "PARCObject@%p descriptor cannot be NULL.", object);
-    if (header->descriptor->isLockable) {
-        trapIllegalValueIf(header->locking == NULL, "PARCObject@%p is corrupt. Is Lockable but no locking structure", object);
-    }
 }
 
 static inline void
@@ -573,6 +576,44 @@ _parcObject_InitializeLocking(_PARCObjectLocking *locking)
     }
 }
 
+static inline void
+_parcObject_DestroyLocking(_PARCObjectLocking **lockingPtr)
+{
+    _PARCObjectLocking *locking = *lockingPtr;
+
+    pthread_cond_destroy(&locking->notification);
+    pthread_mutex_destroy(&locking->lock);
+    parcMemory_Deallocate(lockingPtr);
+}
+
+/*
+ * Return the locking structure of the given object, creating it if the object has never been locked.
+ *
+ * Concurrent first lockers race to install their structure, the losers destroy theirs and use the winner's.
+ * Return NULL if the object does not support locking.
+ */
+static _PARCObjectLocking *
+_parcObjectHeader_AttachLocking(const PARCObject *object)
+{
+    _PARCObjectHeader *header = _parcObject_Header(object);
+
+    _PARCObjectLocking *result = __atomic_load_n(&header->locking, __ATOMIC_ACQUIRE);
+
+    if (result == NULL && header->descriptor->isLockable) {
+        _PARCObjectLocking *locking = parcMemory_Allocate(sizeof(_PARCObjectLocking));
+        assertNotNull(locking, "parcMemory_Allocate(%zu) returned NULL", sizeof(_PARCObjectLocking));
+        _parcObject_InitializeLocking(locking);
+
+        if (__atomic_compare_exchange_n(&header->locking, &result, locking, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            result = locking;
+        } else {
+            _parcObject_DestroyLocking(&locking);
+        }
+    }
+
+    return result;
+}
+
 static inline _PARCObjectHeader *
 _parcObjectHeader_InitAllocated(_PARCObjectHeader *header, const PARCObjectDescriptor *descriptor)
 {
@@ -581,13 +622,8 @@ _parcObjectHeader_InitAllocated(_PARCObjectHeader *header, const PARCObjectDescr
     header->references = 1;
     header->descriptor = (PARCObjectDescriptor *) descriptor;
     header->isAllocated = true;
-
-    if (header->descriptor->isLockable) {
-        header->locking = &header->lock;
-        _parcObject_InitializeLocking(header->locking);
-    } else {
-        header->locking = NULL;
-    }
+    header->slabId = 0;
+    header->locking = NULL;
 
     return header;
 }
@@ -619,7 +655,12 @@ parcObject_CreateInstanceImpl(const PARCObjectDescriptor *descriptor)
     size_t totalMemoryLength = prefixLength + descriptor->objectSize;
 
     void *origin = NULL;
-    parcMemory_MemAlign(&origin, sizeof(void *), totalMemoryLength);
+    uint16_t slabId = 0;
+    if (descriptor->isSlabAllocated) {
+        origin = parcObjectSlab_Allocate(descriptor, totalMemoryLength, &slabId);
+    } else {
+        parcMemory_MemAlign(&origin, sizeof(void *), totalMemoryLength);
+    }
 
     if (origin == NULL) {
         errno = ENOMEM;
@@ -628,7 +669,7 @@ parcObject_CreateInstanceImpl(const PARCObjectDescriptor *descriptor)
 
     PARCObject *object = _pointerAdd(origin, prefixLength);
 
-    _parcObjectHeader_InitAllocated(_parcObject_Header(object), descriptor);
+    _parcObjectHeader_InitAllocated(_parcObject_Header(object), descriptor)->slabId = slabId;
 
     errno = 0;
     return object;
@@ -676,11 +717,15 @@ parcObject_Release(PARCObject **objectPointer)
     if (result == 0) {
         if (_parcObject_Destructor(header->descriptor, objectPointer)) {
             if (header->locking != NULL) {
-                pthread_cond_destroy(&header->locking->notification);
+                _parcObject_DestroyLocking(&header->locking);
             }
             if (header->isAllocated) {
                 void *origin = _parcObject_Origin(object);
-                parcMemory_Deallocate(&origin);
+                if (header->slabId != 0) {
+                    parcObjectSlab_Deallocate(header->slabId, &origin);
+                } else {
+                    parcMemory_Deallocate(&origin);
+                }
             }
             assertNotNull(*objectPointer, "Class implementation unnecessarily clears the object pointer.");
         } else {
@@ -831,7 +876,7 @@ parcObject_Lock(const PARCObject *object)
     parcObject_OptionalAssertValid(object);
 
     if (object != NULL) {
-        _PARCObjectLocking *locking = _parcObjectHeader_Locking(object);
+        _PARCObjectLocking *locking = _parcObjectHeader_AttachLocking(object);
         if (locking != NULL) {
             trapCannotObtainLockIf(pthread_equal(locking->locker, pthread_self()),
                                    "Recursive locks on %p are not supported.", object);
@@ -856,7 +901,7 @@ parcObject_TryLock(const PARCObject *object)
     if (object != NULL) {
         parcObject_OptionalAssertValid(object);
 
-        _PARCObjectLocking *locking = _parcObjectHeader_Locking(object);
+        _PARCObjectLocking *locking = _parcObjectHeader_AttachLocking(object);
         if (locking != NULL) {
             trapCannotObtainLockIf(pthread_equal(locking->locker, pthread_self()), "Recursive locks are not supported.");
 
@@ -231,6 +231,8 @@ struct PARCObjectDescriptor {
     size_t objectSize;
     unsigned objectAlignment;
     bool isLockable;
+    // If true, instances are allocated from a per-type slab cache (see parc_ObjectSlab.h) instead of directly from parcMemory.
+    bool isSlabAllocated;
     PARCObjectTypeState *typeState;
 };
 
@@ -657,6 +659,7 @@ const PARCObjectDescriptor *parcObject_SetDescriptor(PARCObject *object, const P
         .toJSON          = NULL,   \
         .display         = NULL,   \
         .isLockable      = true, \
+        .isSlabAllocated = false, \
         .typeState = NULL, \
         __VA_ARGS__  \
     }; \
@@ -964,7 +967,7 @@ PARCObject *parcObject_InitAndClearInstanceImpl(PARCObject *object, const PARCOb
  * @endcode
  */
 // The constant value here must be greater than or equal to the size of the internal _PARCObjectHeader structure.
-#define parcObject_PrefixLength(_alignment_) ((152 + (_alignment_ - 1)) & - _alignment_)
+#define parcObject_PrefixLength(_alignment_) ((32 + (_alignment_ - 1)) & - _alignment_)
 
 /**
  * Compute the number of bytes necessary for a PARC Object.
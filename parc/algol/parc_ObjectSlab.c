@@ -0,0 +1,618 @@
+/*
+ * Copyright (c) 2015, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * The allocator is organised after Bonwick's magazine layer.
+ * Each slab allocated type has a `_PARCObjectSlab` holding its statistics and a depot of magazines,
+ * each magazine being a fixed capacity stack of free blocks.
+ * Each thread holds two magazines per type, loaded and previous, and only visits the depot
+ * (under the slab's lock) when both are full on release or both are empty on allocation.
+ *
+ * Slabs are identified by a small integer, stored in the PARCObject header, so that an object can be returned
+ * to the slab it came from even if its descriptor has since been changed with `parcObject_SetDescriptor`.
+ *
+ * The allocation fast path touches only the calling thread's cache, so no statistic is maintained per allocation.
+ * Instead each slab counts the blocks it has obtained from parcMemory, each thread cache and the depot count the
+ * blocks they hold, and the number of live instances is derived from those when the statistics are read.
+ *
+ * The slab, magazine and thread cache bookkeeping outlives any particular `PARCMemoryInterface`,
+ * so it is allocated directly from the system, only the blocks themselves are allocated through parcMemory.
+ *
+ * @author Glenn Scott, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include <config.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#include <LongBow/runtime.h>
+
+#include <parc/algol/parc_Memory.h>
+#include <parc/algol/parc_DisplayIndented.h>
+#include <parc/algol/parc_ObjectSlab.h>
+
+// The number of blocks in a magazine.
+#define MAGAZINE_CAPACITY 32
+
+// The maximum number of full magazines a depot holds before released blocks are freed.
+#define DEPOT_LIMIT 32
+
+// The maximum number of slab allocated types.  Slab identifier 0 is reserved for "not slab allocated".
+#define SLAB_LIMIT 1024
+
+// A thread cache holds its per-slab state in chunks, allocated on demand and never moved,
+// so that statistics can be read from other threads.
+#define CHUNK_SIZE 16
+#define CHUNK_COUNT (SLAB_LIMIT / CHUNK_SIZE)
+
+// The number of entries in the per-thread descriptor to slab identifier cache.
+#define MEMO_SIZE 16
+
+typedef struct _parcObjectSlabMagazine {
+    size_t count;
+    struct _parcObjectSlabMagazine *next;
+    void *blocks[MAGAZINE_CAPACITY];
+} _PARCObjectSlabMagazine;
+
+typedef struct {
+    const PARCObjectDescriptor *descriptor;
+    char name[64];
+    size_t blockSize;
+
+    pthread_mutex_t depotLock;
+    _PARCObjectSlabMagazine *fullMagazines;
+    size_t fullMagazineCount;
+    _PARCObjectSlabMagazine *emptyMagazines;
+
+    // The number of blocks held by the depot.  Modified under the depot lock.
+    size_t depotCached;
+    // The number of blocks currently allocated from parcMemory, in use or cached.
+    size_t blocks;
+    // The largest value of blocks.
+    size_t highWater;
+} _PARCObjectSlab;
+
+typedef struct {
+    _PARCObjectSlabMagazine *loaded;
+    _PARCObjectSlabMagazine *previous;
+    // The number of blocks in loaded and previous.  Written only by the owning thread.
+    size_t cached;
+} _PARCObjectSlabThreadSlab;
+
+typedef struct _parcObjectSlabThreadCache {
+    _PARCObjectSlabThreadSlab *chunks[CHUNK_COUNT];
+    struct {
+        const PARCObjectDescriptor *descriptor;
+        uint16_t slabId;
+    } memo[MEMO_SIZE];
+    struct _parcObjectSlabThreadCache *next;
+} _PARCObjectSlabThreadCache;
+
+static _PARCObjectSlab *_parcObjectSlab_Slabs[SLAB_LIMIT];
+static uint16_t _parcObjectSlab_SlabCount = 0;
+
+// Guards the slab registry and the list of thread caches.
+static pthread_mutex_t _parcObjectSlab_RegistryLock = PTHREAD_MUTEX_INITIALIZER;
+static _PARCObjectSlabThreadCache *_parcObjectSlab_ThreadCaches = NULL;
+
+static pthread_key_t _parcObjectSlab_ThreadCacheKey;
+static pthread_once_t _parcObjectSlab_ThreadCacheOnce = PTHREAD_ONCE_INIT;
+
+static inline _PARCObjectSlab *
+_parcObjectSlab_Slab(uint16_t slabId)
+{
+    return __atomic_load_n(&_parcObjectSlab_Slabs[slabId], __ATOMIC_ACQUIRE);
+}
+
+static inline void
+_parcObjectSlab_SetThreadCached(_PARCObjectSlabThreadSlab *threadSlab, size_t cached)
+{
+    __atomic_store_n(&threadSlab->cached, cached, __ATOMIC_RELAXED);
+}
+
+static void *
+_parcObjectSlab_AllocateBlock(_PARCObjectSlab *slab)
+{
+    void *result = NULL;
+    parcMemory_MemAlign(&result, sizeof(void *), slab->blockSize);
+
+    if (result != NULL) {
+        size_t blocks = __atomic_add_fetch(&slab->blocks, 1, __ATOMIC_RELAXED);
+        size_t highWater = __atomic_load_n(&slab->highWater, __ATOMIC_RELAXED);
+        while (blocks > highWater
+               && !__atomic_compare_exchange_n(&slab->highWater, &highWater, blocks, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+            ;
+        }
+    }
+
+    return result;
+}
+
+static size_t
+_parcObjectSlab_FreeMagazineBlocks(_PARCObjectSlab *slab, _PARCObjectSlabMagazine *magazine)
+{
+    size_t result = magazine->count;
+
+    while (magazine->count > 0) {
+        parcMemory_Deallocate(&magazine->blocks[--magazine->count]);
+    }
+    __atomic_sub_fetch(&slab->blocks, result, __ATOMIC_RELAXED);
+
+    return result;
+}
+
+static _PARCObjectSlabMagazine *
+_parcObjectSlab_CreateMagazine(void)
+{
+    _PARCObjectSlabMagazine *result = calloc(1, sizeof(_PARCObjectSlabMagazine));
+    trapOutOfMemoryIf(result == NULL, "Cannot allocate a PARCObjectSlab magazine");
+    return result;
+}
+
+/*
+ * Give a full magazine to the depot, or free its blocks if the depot is already full.
+ * The magazine's blocks are no longer counted by the calling thread.
+ *
+ * Return an empty magazine for the caller to use in its place.
+ */
+static _PARCObjectSlabMagazine *
+_parcObjectSlab_ExchangeFull(_PARCObjectSlab *slab, _PARCObjectSlabMagazine *full)
+{
+    _PARCObjectSlabMagazine *result = NULL;
+
+    pthread_mutex_lock(&slab->depotLock);
+    if (slab->fullMagazineCount < DEPOT_LIMIT) {
+        full->next = slab->fullMagazines;
+        slab->fullMagazines = full;
+        slab->fullMagazineCount++;
+        __atomic_store_n(&slab->depotCached, slab->depotCached + full->count, __ATOMIC_RELAXED);
+
+        result = slab->emptyMagazines;
+        if (result != NULL) {
+            slab->emptyMagazines = result->next;
+        }
+    } else {
+        result = full;
+    }
+    pthread_mutex_unlock(&slab->depotLock);
+
+    if (result == NULL) {
+        result = _parcObjectSlab_CreateMagazine();
+    } else if (result == full) {
+        _parcObjectSlab_FreeMagazineBlocks(slab, full);
+    }
+
+    return result;
+}
+
+/*
+ * Take a full magazine from the depot in exchange for the given empty magazine.
+ *
+ * Return NULL if the depot has no full magazine, in which case the empty magazine is retained by the caller.
+ */
+static _PARCObjectSlabMagazine *
+_parcObjectSlab_ExchangeEmpty(_PARCObjectSlab *slab, _PARCObjectSlabMagazine *empty)
+{
+    pthread_mutex_lock(&slab->depotLock);
+    _PARCObjectSlabMagazine *result = slab->fullMagazines;
+    if (result != NULL) {
+        slab->fullMagazines = result->next;
+        slab->fullMagazineCount--;
+        __atomic_store_n(&slab->depotCached, slab->depotCached - result->count, __ATOMIC_RELAXED);
+
+        if (empty != NULL) {
+            empty->next = slab->emptyMagazines;
+            slab->emptyMagazines = empty;
+        }
+    }
+    pthread_mutex_unlock(&slab->depotLock);
+
+    return result;
+}
+
+/*
+ * Return the magazines of an exiting thread to the depot, freeing whatever the depot cannot hold.
+ */
+static void
+_parcObjectSlab_FlushThreadSlab(_PARCObjectSlab *slab, _PARCObjectSlabThreadSlab *threadSlab)
+{
+    _PARCObjectSlabMagazine *magazines[2] = { threadSlab->loaded, threadSlab->previous };
+
+    for (int i = 0; i < 2; i++) {
+        _PARCObjectSlabMagazine *magazine = magazines[i];
+        if (magazine != NULL) {
+            pthread_mutex_lock(&slab->depotLock);
+            if (magazine->count > 0 && slab->fullMagazineCount < DEPOT_LIMIT) {
+                magazine->next = slab->fullMagazines;
+                slab->fullMagazines = magazine;
+                slab->fullMagazineCount++;
+                __atomic_store_n(&slab->depotCached, slab->depotCached + magazine->count, __ATOMIC_RELAXED);
+                magazine = NULL;
+            }
+            pthread_mutex_unlock(&slab->depotLock);
+
+            if (magazine != NULL) {
+                _parcObjectSlab_FreeMagazineBlocks(slab, magazine);
+                free(magazine);
+            }
+        }
+    }
+    threadSlab->loaded = NULL;
+    threadSlab->previous = NULL;
+    _parcObjectSlab_SetThreadCached(threadSlab, 0);
+}
+
+static void
+_parcObjectSlab_ThreadCacheDestroy(void *value)
+{
+    _PARCObjectSlabThreadCache *cache = value;
+
+    pthread_mutex_lock(&_parcObjectSlab_RegistryLock);
+    _PARCObjectSlabThreadCache **link = &_parcObjectSlab_ThreadCaches;
+    while (*link != cache) {
+        link = &(*link)->next;
+    }
+    *link = cache->next;
+    pthread_mutex_unlock(&_parcObjectSlab_RegistryLock);
+
+    for (size_t chunk = 0; chunk < CHUNK_COUNT; chunk++) {
+        if (cache->chunks[chunk] != NULL) {
+            for (size_t i = 0; i < CHUNK_SIZE; i++) {
+                _PARCObjectSlabThreadSlab *threadSlab = &cache->chunks[chunk][i];
+                if (threadSlab->loaded != NULL || threadSlab->previous != NULL) {
+                    _parcObjectSlab_FlushThreadSlab(_parcObjectSlab_Slab(chunk * CHUNK_SIZE + i), threadSlab);
+                }
+            }
+            free(cache->chunks[chunk]);
+        }
+    }
+    free(cache);
+}
+
+static void
+_parcObjectSlab_ThreadCacheInitialize(void)
+{
+    int error = pthread_key_create(&_parcObjectSlab_ThreadCacheKey, _parcObjectSlab_ThreadCacheDestroy);
+    trapUnexpectedStateIf(error != 0, "Cannot create the PARCObjectSlab thread cache key: %d", error);
+}
+
+static _PARCObjectSlabThreadCache *
+_parcObjectSlab_ThreadCache(void)
+{
+    pthread_once(&_parcObjectSlab_ThreadCacheOnce, _parcObjectSlab_ThreadCacheInitialize);
+
+    _PARCObjectSlabThreadCache *result = pthread_getspecific(_parcObjectSlab_ThreadCacheKey);
+    if (result == NULL) {
+        result = calloc(1, sizeof(_PARCObjectSlabThreadCache));
+        trapOutOfMemoryIf(result == NULL, "Cannot allocate a PARCObjectSlab thread cache");
+        pthread_setspecific(_parcObjectSlab_ThreadCacheKey, result);
+
+        pthread_mutex_lock(&_parcObjectSlab_RegistryLock);
+        result->next = _parcObjectSlab_ThreadCaches;
+        _parcObjectSlab_ThreadCaches = result;
+        pthread_mutex_unlock(&_parcObjectSlab_RegistryLock);
+    }
+
+    return result;
+}
+
+static inline _PARCObjectSlabThreadSlab *
+_parcObjectSlab_ThreadSlab(_PARCObjectSlabThreadCache *cache, uint16_t slabId)
+{
+    _PARCObjectSlabThreadSlab *chunk = cache->chunks[slabId / CHUNK_SIZE];
+
+    if (chunk == NULL) {
+        chunk = calloc(CHUNK_SIZE, sizeof(_PARCObjectSlabThreadSlab));
+        trapOutOfMemoryIf(chunk == NULL, "Cannot allocate a PARCObjectSlab thread cache chunk");
+        __atomic_store_n(&cache->chunks[slabId / CHUNK_SIZE], chunk, __ATOMIC_RELEASE);
+    }
+
+    return &chunk[slabId % CHUNK_SIZE];
+}
+
+static _PARCObjectSlab *
+_parcObjectSlab_Create(const PARCObjectDescriptor *descriptor, size_t blockSize)
+{
+    _PARCObjectSlab *result = calloc(1, sizeof(_PARCObjectSlab));
+    trapOutOfMemoryIf(result == NULL, "Cannot allocate a PARCObjectSlab");
+
+    result->descriptor = descriptor;
+    strncpy(result->name, descriptor->name, sizeof(result->name) - 1);
+    result->blockSize = blockSize;
+    pthread_mutex_init(&result->depotLock, NULL);
+
+    return result;
+}
+
+/*
+ * Find the slab for the given descriptor, creating it if necessary.
+ *
+ * The block size is part of the key because a dynamically created descriptor may be destroyed
+ * and a different one created at the same address.
+ *
+ * Return 0 if there is no slab and none can be created.
+ */
+static uint16_t
+_parcObjectSlab_Find(const PARCObjectDescriptor *descriptor, size_t blockSize)
+{
+    uint16_t result = 0;
+
+    pthread_mutex_lock(&_parcObjectSlab_RegistryLock);
+
+    for (uint16_t slabId = 1; slabId <= _parcObjectSlab_SlabCount; slabId++) {
+        _PARCObjectSlab *slab = _parcObjectSlab_Slabs[slabId];
+        if (slab->descriptor == descriptor && slab->blockSize == blockSize) {
+            result = slabId;
+            break;
+        }
+    }
+
+    if (result == 0 && _parcObjectSlab_SlabCount + 1 < SLAB_LIMIT) {
+        result = _parcObjectSlab_SlabCount + 1;
+        __atomic_store_n(&_parcObjectSlab_Slabs[result], _parcObjectSlab_Create(descriptor, blockSize), __ATOMIC_RELEASE);
+        __atomic_store_n(&_parcObjectSlab_SlabCount, result, __ATOMIC_RELEASE);
+    }
+
+    pthread_mutex_unlock(&_parcObjectSlab_RegistryLock);
+
+    return result;
+}
+
+static inline uint16_t
+_parcObjectSlab_Lookup(_PARCObjectSlabThreadCache *cache, const PARCObjectDescriptor *descriptor, size_t blockSize)
+{
+    size_t memoIndex = ((uintptr_t) descriptor >> 4) % MEMO_SIZE;
+
+    uint16_t result = 0;
+    if (cache->memo[memoIndex].descriptor == descriptor) {
+        result = cache->memo[memoIndex].slabId;
+        if (_parcObjectSlab_Slab(result)->blockSize != blockSize) {
+            result = 0;
+        }
+    }
+
+    if (result == 0) {
+        result = _parcObjectSlab_Find(descriptor, blockSize);
+        if (result != 0) {
+            cache->memo[memoIndex].descriptor = descriptor;
+            cache->memo[memoIndex].slabId = result;
+        }
+    }
+
+    return result;
+}
+
+void *
+parcObjectSlab_Allocate(const PARCObjectDescriptor *descriptor, size_t size, uint16_t *slabId)
+{
+    _PARCObjectSlabThreadCache *cache = _parcObjectSlab_ThreadCache();
+
+    *slabId = _parcObjectSlab_Lookup(cache, descriptor, size);
+    if (*slabId == 0) {
+        void *result = NULL;
+        parcMemory_MemAlign(&result, sizeof(void *), size);
+        return result;
+    }
+
+    _PARCObjectSlab *slab = _parcObjectSlab_Slab(*slabId);
+    _PARCObjectSlabThreadSlab *threadSlab = _parcObjectSlab_ThreadSlab(cache, *slabId);
+
+    if (threadSlab->loaded == NULL || threadSlab->loaded->count == 0) {
+        if (threadSlab->previous != NULL && threadSlab->previous->count > 0) {
+            _PARCObjectSlabMagazine *magazine = threadSlab->loaded;
+            threadSlab->loaded = threadSlab->previous;
+            threadSlab->previous = magazine;
+        } else {
+            _PARCObjectSlabMagazine *full = _parcObjectSlab_ExchangeEmpty(slab, threadSlab->loaded);
+            if (full != NULL) {
+                threadSlab->loaded = full;
+                _parcObjectSlab_SetThreadCached(threadSlab, threadSlab->cached + full->count);
+            }
+        }
+    }
+
+    void *result = NULL;
+    if (threadSlab->loaded != NULL && threadSlab->loaded->count > 0) {
+        result = threadSlab->loaded->blocks[--threadSlab->loaded->count];
+        _parcObjectSlab_SetThreadCached(threadSlab, threadSlab->cached - 1);
+    } else {
+        result = _parcObjectSlab_AllocateBlock(slab);
+    }
+
+    return result;
+}
+
+void
+parcObjectSlab_Deallocate(uint16_t slabId, void **memoryPtr)
+{
+    if (slabId == 0) {
+        parcMemory_Deallocate(memoryPtr);
+        return;
+    }
+
+    _PARCObjectSlab *slab = _parcObjectSlab_Slab(slabId);
+    _PARCObjectSlabThreadSlab *threadSlab = _parcObjectSlab_ThreadSlab(_parcObjectSlab_ThreadCache(), slabId);
+
+    if (threadSlab->loaded == NULL) {
+        threadSlab->loaded = _parcObjectSlab_CreateMagazine();
+    } else if (threadSlab->loaded->count == MAGAZINE_CAPACITY) {
+        if (threadSlab->previous == NULL) {
+            threadSlab->previous = threadSlab->loaded;
+            threadSlab->loaded = _parcObjectSlab_CreateMagazine();
+        } else if (threadSlab->previous->count < MAGAZINE_CAPACITY) {
+            _PARCObjectSlabMagazine *magazine = threadSlab->loaded;
+            threadSlab->loaded = threadSlab->previous;
+            threadSlab->previous = magazine;
+        } else {
+            _parcObjectSlab_SetThreadCached(threadSlab, threadSlab->cached - threadSlab->previous->count);
+            _PARCObjectSlabMagazine *empty = _parcObjectSlab_ExchangeFull(slab, threadSlab->previous);
+            threadSlab->previous = threadSlab->loaded;
+            threadSlab->loaded = empty;
+        }
+    }
+
+    threadSlab->loaded->blocks[threadSlab->loaded->count++] = *memoryPtr;
+    _parcObjectSlab_SetThreadCached(threadSlab, threadSlab->cached + 1);
+
+    *memoryPtr = NULL;
+}
+
+/*
+ * Compute the statistics of a slab.  The caller must hold the registry lock.
+ */
+static void
+_parcObjectSlab_Statistics(uint16_t slabId, PARCObjectSlabStatistics *statistics)
+{
+    _PARCObjectSlab *slab = _parcObjectSlab_Slab(slabId);
+
+    size_t cached = __atomic_load_n(&slab->depotCached, __ATOMIC_RELAXED);
+    for (_PARCObjectSlabThreadCache *cache = _parcObjectSlab_ThreadCaches; cache != NULL; cache = cache->next) {
+        _PARCObjectSlabThreadSlab *chunk = __atomic_load_n(&cache->chunks[slabId / CHUNK_SIZE], __ATOMIC_ACQUIRE);
+        if (chunk != NULL) {
+            cached += __atomic_load_n(&chunk[slabId % CHUNK_SIZE].cached, __ATOMIC_RELAXED);
+        }
+    }
+    size_t blocks = __atomic_load_n(&slab->blocks, __ATOMIC_RELAXED);
+
+    statistics->name = slab->name;
+    statistics->blockSize = slab->blockSize;
+    statistics->cached = cached;
+    statistics->live = (blocks > cached) ? blocks - cached : 0;
+    statistics->highWater = __atomic_load_n(&slab->highWater, __ATOMIC_RELAXED);
+}
+
+bool
+parcObjectSlab_GetStatistics(const PARCObjectDescriptor *descriptor, PARCObjectSlabStatistics *statistics)
+{
+    bool result = false;
+
+    pthread_mutex_lock(&_parcObjectSlab_RegistryLock);
+    for (uint16_t slabId = 1; slabId <= _parcObjectSlab_SlabCount && result == false; slabId++) {
+        if (_parcObjectSlab_Slabs[slabId]->descriptor == descriptor) {
+            _parcObjectSlab_Statistics(slabId, statistics);
+            result = true;
+        }
+    }
+    pthread_mutex_unlock(&_parcObjectSlab_RegistryLock);
+
+    return result;
+}
+
+size_t
+parcObjectSlab_Drain(void)
+{
+    size_t result = 0;
+
+    _PARCObjectSlabThreadCache *cache = _parcObjectSlab_ThreadCache();
+
+    uint16_t slabCount = __atomic_load_n(&_parcObjectSlab_SlabCount, __ATOMIC_ACQUIRE);
+    for (uint16_t slabId = 1; slabId <= slabCount; slabId++) {
+        _PARCObjectSlab *slab = _parcObjectSlab_Slab(slabId);
+
+        _PARCObjectSlabThreadSlab *threadSlab = _parcObjectSlab_ThreadSlab(cache, slabId);
+        _PARCObjectSlabMagazine *magazines[2] = { threadSlab->loaded, threadSlab->previous };
+        for (int i = 0; i < 2; i++) {
+            if (magazines[i] != NULL) {
+                result += _parcObjectSlab_FreeMagazineBlocks(slab, magazines[i]);
+                free(magazines[i]);
+            }
+        }
+        threadSlab->loaded = NULL;
+        threadSlab->previous = NULL;
+        _parcObjectSlab_SetThreadCached(threadSlab, 0);
+
+        pthread_mutex_lock(&slab->depotLock);
+        _PARCObjectSlabMagazine *fullMagazines = slab->fullMagazines;
+        _PARCObjectSlabMagazine *emptyMagazines = slab->emptyMagazines;
+        slab->fullMagazines = NULL;
+        slab->fullMagazineCount = 0;
+        slab->emptyMagazines = NULL;
+        __atomic_store_n(&slab->depotCached, 0, __ATOMIC_RELAXED);
+        pthread_mutex_unlock(&slab->depotLock);
+
+        while (fullMagazines != NULL) {
+            _PARCObjectSlabMagazine *next = fullMagazines->next;
+            result += _parcObjectSlab_FreeMagazineBlocks(slab, fullMagazines);
+            free(fullMagazines);
+            fullMagazines = next;
+        }
+        while (emptyMagazines != NULL) {
+            _PARCObjectSlabMagazine *next = emptyMagazines->next;
+            free(emptyMagazines);
+            emptyMagazines = next;
+        }
+    }
+
+    return result;
+}
+
+void
+parcObjectSlab_Display(int indentation)
+{
+    parcDisplayIndented_PrintLine(indentation, "PARCObjectSlab {");
+
+    pthread_mutex_lock(&_parcObjectSlab_RegistryLock);
+    for (uint16_t slabId = 1; slabId <= _parcObjectSlab_SlabCount; slabId++) {
+        PARCObjectSlabStatistics statistics;
+        _parcObjectSlab_Statistics(slabId, &statistics);
+        parcDisplayIndented_PrintLine(indentation + 1, "%s { .blockSize=%zu, .live=%zu, .cached=%zu, .highWater=%zu }",
+                                      statistics.name, statistics.blockSize, statistics.live, statistics.cached, statistics.highWater);
+    }
+    pthread_mutex_unlock(&_parcObjectSlab_RegistryLock);
+
+    parcDisplayIndented_PrintLine(indentation, "}");
+}
@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2015, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @file parc_ObjectSlab.h
+ * @ingroup memory
+ * @brief Per-type caching allocator for PARCObject instances.
+ *
+ * A `PARCObjectDescriptor` with `.isSlabAllocated = true` has its instances allocated from a slab of fixed-size
+ * blocks dedicated to that type rather than directly from `parcMemory`.
+ * Released instances return their memory to a small cache owned by the releasing thread,
+ * and the next `parcObject_CreateInstance` of the same type on that thread reuses it without a call to the allocator.
+ * When a thread's cache fills (or empties) it exchanges a whole magazine of blocks with a depot shared by all threads,
+ * so memory released on one thread is reused on another.
+ *
+ * Cached blocks remain allocated from `parcMemory` until they are reused or drained by `parcObjectSlab_Drain`,
+ * so they count as outstanding allocations.
+ *
+ * @author Glenn Scott, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#ifndef PARCLibrary_parc_ObjectSlab_h
+#define PARCLibrary_parc_ObjectSlab_h
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <parc/algol/parc_Object.h>
+
+/**
+ * @typedef PARCObjectSlabStatistics
+ * @brief The allocation statistics of a single slab allocated type.
+ */
+typedef struct {
+    /** The name of the type, taken from its `PARCObjectDescriptor`. */
+    const char *name;
+    /** The number of bytes in each block, including the `PARCObject` header. */
+    size_t blockSize;
+    /** The number of instances currently in use. */
+    size_t live;
+    /** The number of released blocks held in thread caches and the shared depot. */
+    size_t cached;
+    /** The largest number of blocks held by the type at any one time, whether in use or cached. */
+    size_t highWater;
+} PARCObjectSlabStatistics;
+
+/**
+ * Allocate a block of @p size bytes from the slab of the given `PARCObjectDescriptor`.
+ *
+ * This is used by `parcObject_CreateInstanceImpl` when the descriptor is slab allocated.
+ * The slab identifier stored in @p slabId must be passed to `parcObjectSlab_Deallocate` when the block is freed.
+ *
+ * @param [in] descriptor A pointer to a valid `PARCObjectDescriptor`.
+ * @param [in] size The number of bytes to allocate. This must be the same for every allocation of @p descriptor.
+ * @param [out] slabId A pointer to a location to receive the identifier of the slab.
+ *
+ * @return non-NULL A pointer to the allocated memory.
+ * @return NULL The memory could not be allocated.
+ *
+ * Example:
+ * @code
+ * {
+ *     uint16_t slabId;
+ *     void *memory = parcObjectSlab_Allocate(descriptor, size, &slabId);
+ *
+ *     parcObjectSlab_Deallocate(slabId, &memory);
+ * }
+ * @endcode
+ */
+void *parcObjectSlab_Allocate(const PARCObjectDescriptor *descriptor, size_t size, uint16_t *slabId);
+
+/**
+ * Return a block obtained from `parcObjectSlab_Allocate` to its slab.
+ *
+ * The block is cached by the calling thread for reuse.
+ *
+ * @param [in] slabId The identifier of the slab the block was allocated from.
+ * @param [in,out] memoryPtr A pointer to a pointer to the block, which is set to NULL.
+ *
+ * Example:
+ * @code
+ * {
+ *     uint16_t slabId;
+ *     void *memory = parcObjectSlab_Allocate(descriptor, size, &slabId);
+ *
+ *     parcObjectSlab_Deallocate(slabId, &memory);
+ * }
+ * @endcode
+ */
+void parcObjectSlab_Deallocate(uint16_t slabId, void **memoryPtr);
+
+/**
+ * Get the allocation statistics for the slab of the given `PARCObjectDescriptor`.
+ *
+ * The statistics are updated concurrently by every thread allocating the type,
+ * so they are a snapshot that may be slightly inconsistent while allocations are in progress.
+ *
+ * @param [in] descriptor A pointer to a valid `PARCObjectDescriptor`.
+ * @param [out] statistics A pointer to a `PARCObjectSlabStatistics` to fill in.
+ *
+ * @return true The descriptor has a slab and @p statistics was filled in.
+ * @return false No instance of the descriptor has been slab allocated.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCObjectSlabStatistics statistics;
+ *     if (parcObjectSlab_GetStatistics(&parcObject_DescriptorName(MyType), &statistics)) {
+ *         printf("%s: %zu live, %zu cached, %zu high-water\n", statistics.name, statistics.live, statistics.cached, statistics.highWater);
+ *     }
+ * }
+ * @endcode
+ */
+bool parcObjectSlab_GetStatistics(const PARCObjectDescriptor *descriptor, PARCObjectSlabStatistics *statistics);
+
+/**
+ * Free every block cached by the calling thread and by the shared depot of every slab.
+ *
+ * Blocks cached by other running threads are not affected.
+ * They are returned to the depot when those threads exit.
+ *
+ * @return The number of blocks freed.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcObjectSlab_Drain();
+ *
+ *     assertTrue(parcMemory_Outstanding() == 0, "Memory leak");
+ * }
+ * @endcode
+ */
+size_t parcObjectSlab_Drain(void);
+
+/**
+ * Print the statistics of every slab.
+ *
+ * @param [in] indentation The indentation level to use for printing.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcObjectSlab_Display(0);
+ * }
+ * @endcode
+ */
+void parcObjectSlab_Display(int indentation);
+#endif // PARCLibrary_parc_ObjectSlab_h
@@ -107,6 +107,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
+#include <time.h>
 #include <sys/errno.h>
 #include <sys/queue.h>
 #include <pthread.h>
@@ -142,6 +143,16 @@ typedef struct memory_prefix {
     uint64_t guard;               // Try to detect underrun of the allocated memory.
 } _MemoryPrefix;
 
+// Allocations that are not sampled carry only this prefix.
+// The guard occupies the same position as _MemoryPrefix.guard, immediately before the usable memory,
+// so one word distinguishes the two kinds of allocation.
+static const uint64_t _parcSafeMemory_UnsampledGuard = 0x5afe5afe5afe5a00;
+static const uint64_t _parcSafeMemory_UnsampledAlignmentMask = 0xff;
+typedef struct memory_unsampled_prefix {
+    size_t requestedLength;       // The number of bytes the caller requested.
+    uint64_t guard;               // _parcSafeMemory_UnsampledGuard with the log2 of the alignment in the low byte.
+} _MemoryUnsampledPrefix;
+
 typedef void *PARCSafeMemoryOrigin;
 
 typedef void *PARCSafeMemoryUsable;
@@ -150,6 +161,14 @@ static PARCMemoryInterface *_parcMemory = &PARCStdlibMemoryAsPARCMemory;
 
 static pthread_mutex_t _parcSafeMemory_Mutex = PTHREAD_MUTEX_INITIALIZER;
 
+// One allocation in _parcSafeMemory_SampleRate (on average) is guarded and recorded.
+// Each thread counts down to its next sampled allocation in the value of _parcSafeMemory_SampleKey,
+// and keeps the state of its own interval generator in the value of _parcSafeMemory_SampleStateKey.
+static uint32_t _parcSafeMemory_SampleRate = 1;
+static pthread_once_t _parcSafeMemory_SampleOnce = PTHREAD_ONCE_INIT;
+static pthread_key_t _parcSafeMemory_SampleKey;
+static pthread_key_t _parcSafeMemory_SampleStateKey;
+
 
 /**
  * Return true if the given alignment value is greater than or equal to {@code sizeof(void *)} and
@@ -294,6 +313,159 @@ _parcSafeMemory_FormatSuffix(const PARCSafeMemoryUsable *memory)
     return suffix;
 }
 
+static void
+_parcSafeMemory_SampleKeyInit(void)
+{
+    pthread_key_create(&_parcSafeMemory_SampleKey, NULL);
+    pthread_key_create(&_parcSafeMemory_SampleStateKey, NULL);
+}
+
+/**
+ * Choose the number of allocations until the next sampled allocation.
+ *
+ * The interval is uniformly distributed over [1, 2 * rate - 1] so that it averages `rate`
+ * without falling into step with a periodic allocation pattern.
+ * Each thread steps its own generator, seeded from its thread identity the first time it is used.
+ */
+static uintptr_t
+_parcSafeMemory_SampleInterval(uint32_t rate)
+{
+    uintptr_t state = (uintptr_t) pthread_getspecific(_parcSafeMemory_SampleStateKey);
+    if (state == 0) {
+        state = (uintptr_t) pthread_self();
+    }
+    state += (uintptr_t) 0x9e3779b97f4a7c15ULL;
+    pthread_setspecific(_parcSafeMemory_SampleStateKey, (void *) state);
+
+    uint64_t x = state;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    x = x ^ (x >> 31);
+
+    return 1 + (uintptr_t) (x % (2 * (uint64_t) rate - 1));
+}
+
+static bool
+_parcSafeMemory_ShouldSample(void)
+{
+    uint32_t rate = __atomic_load_n(&_parcSafeMemory_SampleRate, __ATOMIC_RELAXED);
+    if (rate <= 1) {
+        return true;
+    }
+
+    pthread_once(&_parcSafeMemory_SampleOnce, _parcSafeMemory_SampleKeyInit);
+
+    // Zero means this thread has not allocated yet; a countdown beyond the range means the rate was lowered.
+    uintptr_t countdown = (uintptr_t) pthread_getspecific(_parcSafeMemory_SampleKey);
+    if (countdown == 0 || countdown >= 2 * (uintptr_t) rate) {
+        countdown = _parcSafeMemory_SampleInterval(rate);
+    }
+
+    bool result = false;
+    if (--countdown == 0) {
+        result = true;
+        countdown = _parcSafeMemory_SampleInterval(rate);
+    }
+    pthread_setspecific(_parcSafeMemory_SampleKey, (void *) countdown);
+
+    return result;
+}
+
+static size_t
+_computeUnsampledPrefixLength(const size_t alignment)
+{
+    return (sizeof(_MemoryUnsampledPrefix) + alignment - 1) & ~(alignment - 1);
+}
+
+static _MemoryUnsampledPrefix *
+_parcSafeMemory_GetUnsampledPrefix(const PARCSafeMemoryUsable *usable)
+{
+    _MemoryUnsampledPrefix *prefix = _pointerAdd(usable, -sizeof(_MemoryUnsampledPrefix));
+    return prefix;
+}
+
+static bool
+_parcSafeMemory_IsUnsampled(const PARCSafeMemoryUsable *usable)
+{
+    _MemoryUnsampledPrefix *prefix = _parcSafeMemory_GetUnsampledPrefix(usable);
+
+    return (prefix->guard & ~_parcSafeMemory_UnsampledAlignmentMask) == _parcSafeMemory_UnsampledGuard;
+}
+
+static size_t
+_parcSafeMemory_GetUnsampledAlignment(const PARCSafeMemoryUsable *usable)
+{
+    _MemoryUnsampledPrefix *prefix = _parcSafeMemory_GetUnsampledPrefix(usable);
+
+    return (size_t) 1 << (prefix->guard & _parcSafeMemory_UnsampledAlignmentMask);
+}
+
+static PARCSafeMemoryOrigin *
+_parcSafeMemory_GetUnsampledOrigin(const PARCSafeMemoryUsable *usable)
+{
+    return _pointerAdd(usable, -_computeUnsampledPrefixLength(_parcSafeMemory_GetUnsampledAlignment(usable)));
+}
+
+static PARCSafeMemoryUsable *
+_parcSafeMemory_FormatUnsampledPrefix(PARCSafeMemoryOrigin *origin, size_t requestedLength, size_t alignment)
+{
+    PARCSafeMemoryUsable *result = _pointerAdd(origin, _computeUnsampledPrefixLength(alignment));
+
+    _MemoryUnsampledPrefix *prefix = _parcSafeMemory_GetUnsampledPrefix(result);
+    prefix->requestedLength = requestedLength;
+    prefix->guard = _parcSafeMemory_UnsampledGuard | (uint64_t) __builtin_ctzl(alignment);
+
+    return result;
+}
+
+/**
+ * Allocate memory that is not guarded, has no backtrace and is not recorded in the list of allocations.
+ */
+static PARCSafeMemoryUsable *
+_parcSafeMemory_AllocateUnsampled(size_t requestedLength, size_t alignment)
+{
+    size_t prefixLength = _computeUnsampledPrefixLength(alignment);
+    size_t totalSize = prefixLength + requestedLength;
+    if (totalSize < requestedLength) {
+        return NULL;
+    }
+
+    void *base = NULL;
+    if (alignment == sizeof(void *)) {
+        base = ((PARCMemoryAllocate *) _parcMemory->Allocate)(totalSize);
+    } else if (((PARCMemoryMemAlign *) _parcMemory->MemAlign)(&base, alignment, totalSize) != 0) {
+        base = NULL;
+    }
+    if (base == NULL) {
+        return NULL;
+    }
+
+    return _parcSafeMemory_FormatUnsampledPrefix(base, requestedLength, alignment);
+}
+
+static void
+_parcSafeMemory_DestroyUnsampled(void **memoryPointer)
+{
+    PARCSafeMemoryOrigin *base = _parcSafeMemory_GetUnsampledOrigin(*memoryPointer);
+
+    // A second deallocation of this memory finds this guard and is reported as PARCSafeMemoryState_ALREADYFREE.
+    _MemoryUnsampledPrefix *prefix = _parcSafeMemory_GetUnsampledPrefix(*memoryPointer);
+    prefix->guard = _parcSafeMemory_GuardAlreadyFreed;
+
+    ((PARCMemoryDeallocate *) _parcMemory->Deallocate)((void **) &base);
+
+    *memoryPointer = 0;
+}
+
+static size_t
+_parcSafeMemory_GetRequestedLength(const PARCSafeMemoryUsable *usable)
+{
+    if (_parcSafeMemory_IsUnsampled(usable)) {
+        return _parcSafeMemory_GetUnsampledPrefix(usable)->requestedLength;
+    }
+    return _parcSafeMemory_GetPrefix(usable)->requestedLength;
+}
+
 static void
 _backtraceReport(const _MemoryBacktrace *backtrace, int outputFd)
 {
@@ -411,6 +583,187 @@ parcSafeMemory_ReportAllocation(int outputFd)
     return parcSafeMemory_Outstanding();
 }
 
+// The live sampled allocations that share an identical backtrace.
+typedef struct safememory_callsite {
+    const _MemoryBacktrace *backtrace;
+    size_t allocations;
+    size_t bytes;
+} _CallSite;
+
+static int
+_callSite_CompareBacktrace(const void *a, const void *b)
+{
+    const _MemoryBacktrace *x = ((const _CallSite *) a)->backtrace;
+    const _MemoryBacktrace *y = ((const _CallSite *) b)->backtrace;
+
+    if (x->actualFrameCount != y->actualFrameCount) {
+        return x->actualFrameCount < y->actualFrameCount ? -1 : 1;
+    }
+    for (int i = 0; i < x->actualFrameCount; i++) {
+        if (x->callstack[i] != y->callstack[i]) {
+            return (uintptr_t) x->callstack[i] < (uintptr_t) y->callstack[i] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+static int
+_callSite_CompareBytes(const void *a, const void *b)
+{
+    const _CallSite *x = a;
+    const _CallSite *y = b;
+
+    if (x->bytes != y->bytes) {
+        return x->bytes > y->bytes ? -1 : 1;
+    }
+    return x->allocations > y->allocations ? -1 : (x->allocations < y->allocations);
+}
+
+size_t
+parcSafeMemory_ReportCallSites(int outputFd)
+{
+    pthread_mutex_lock(&head_mutex);
+
+    size_t count = 0;
+    struct safememory_entry *e;
+    LIST_FOREACH(e, &head, entries)
+    {
+        count++;
+    }
+
+    _CallSite *sites = calloc(count == 0 ? 1 : count, sizeof(_CallSite));
+    if (sites == NULL) {
+        pthread_mutex_unlock(&head_mutex);
+        return 0;
+    }
+
+    size_t index = 0;
+    size_t totalBytes = 0;
+    LIST_FOREACH(e, &head, entries)
+    {
+        _MemoryPrefix *prefix = _parcSafeMemory_GetPrefix(e->memory);
+        sites[index].backtrace = prefix->backtrace;
+        sites[index].allocations = 1;
+        sites[index].bytes = prefix->requestedLength;
+        totalBytes += prefix->requestedLength;
+        index++;
+    }
+
+    // Sort identical backtraces next to each other, merge them, then order the call sites by bytes outstanding.
+    qsort(sites, count, sizeof(_CallSite), _callSite_CompareBacktrace);
+    size_t siteCount = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (siteCount > 0 && _callSite_CompareBacktrace(&sites[siteCount - 1], &sites[i]) == 0) {
+            sites[siteCount - 1].allocations++;
+            sites[siteCount - 1].bytes += sites[i].bytes;
+        } else {
+            sites[siteCount++] = sites[i];
+        }
+    }
+    qsort(sites, siteCount, sizeof(_CallSite), _callSite_CompareBytes);
+
+    if (outputFd != -1) {
+        dprintf(outputFd, "SafeMemory: %zu sampled allocations (1 in %u), %zu bytes, %zu call sites\n",
+                count, parcSafeMemory_GetSampleRate(), totalBytes, siteCount);
+        for (size_t i = 0; i < siteCount; i++) {
+            dprintf(outputFd, "\n%zu allocations, %zu bytes\n", sites[i].allocations, sites[i].bytes);
+            _backtraceReport(sites[i].backtrace, outputFd);
+        }
+    }
+
+    pthread_mutex_unlock(&head_mutex);
+    free(sites);
+
+    return siteCount;
+}
+
+static struct {
+    pthread_mutex_t mutex;
+    pthread_cond_t condition;
+    pthread_t thread;
+    bool running;
+    int outputFd;
+    unsigned int intervalSeconds;
+} _parcSafeMemory_Reporter = {
+    .mutex     = PTHREAD_MUTEX_INITIALIZER,
+    .condition = PTHREAD_COND_INITIALIZER,
+    .running   = false
+};
+
+static void *
+_parcSafeMemory_PeriodicReport(void *unused __attribute__((unused)))
+{
+    pthread_mutex_lock(&_parcSafeMemory_Reporter.mutex);
+
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    while (_parcSafeMemory_Reporter.running) {
+        deadline.tv_sec += _parcSafeMemory_Reporter.intervalSeconds;
+
+        int status = 0;
+        while (_parcSafeMemory_Reporter.running && status != ETIMEDOUT) {
+            status = pthread_cond_timedwait(&_parcSafeMemory_Reporter.condition, &_parcSafeMemory_Reporter.mutex, &deadline);
+        }
+
+        if (_parcSafeMemory_Reporter.running) {
+            int outputFd = _parcSafeMemory_Reporter.outputFd;
+            pthread_mutex_unlock(&_parcSafeMemory_Reporter.mutex);
+            parcSafeMemory_ReportCallSites(outputFd);
+            pthread_mutex_lock(&_parcSafeMemory_Reporter.mutex);
+        }
+    }
+
+    pthread_mutex_unlock(&_parcSafeMemory_Reporter.mutex);
+    return NULL;
+}
+
+bool
+parcSafeMemory_StartPeriodicReport(int outputFd, unsigned int intervalSeconds)
+{
+    bool result = false;
+
+    pthread_mutex_lock(&_parcSafeMemory_Reporter.mutex);
+    if (!_parcSafeMemory_Reporter.running && intervalSeconds > 0) {
+        _parcSafeMemory_Reporter.outputFd = outputFd;
+        _parcSafeMemory_Reporter.intervalSeconds = intervalSeconds;
+        _parcSafeMemory_Reporter.running = true;
+        if (pthread_create(&_parcSafeMemory_Reporter.thread, NULL, _parcSafeMemory_PeriodicReport, NULL) == 0) {
+            result = true;
+        } else {
+            _parcSafeMemory_Reporter.running = false;
+        }
+    }
+    pthread_mutex_unlock(&_parcSafeMemory_Reporter.mutex);
+
+    return result;
+}
+
+void
+parcSafeMemory_StopPeriodicReport(void)
+{
+    pthread_mutex_lock(&_parcSafeMemory_Reporter.mutex);
+    bool running = _parcSafeMemory_Reporter.running;
+    _parcSafeMemory_Reporter.running = false;
+    pthread_cond_signal(&_parcSafeMemory_Reporter.condition);
+    pthread_mutex_unlock(&_parcSafeMemory_Reporter.mutex);
+
+    if (running) {
+        pthread_join(_parcSafeMemory_Reporter.thread, NULL);
+    }
+}
+
+void
+parcSafeMemory_SetSampleRate(uint32_t rate)
+{
+    __atomic_store_n(&_parcSafeMemory_SampleRate, rate == 0 ? 1 : rate, __ATOMIC_RELAXED);
+}
+
+uint32_t
+parcSafeMemory_GetSampleRate(void)
+{
+    return __atomic_load_n(&_parcSafeMemory_SampleRate, __ATOMIC_RELAXED);
+}
+
 static void
 _backtraceDestroy(_MemoryBacktrace **backtrace)
 {
@@ -549,6 +902,11 @@ parcSafeMemory_MemAlign(void **memptr, size_t alignment, size_t requestedSize)
         return ERANGE;
     }
 
+    if (!_parcSafeMemory_ShouldSample()) {
+        *memptr = _parcSafeMemory_AllocateUnsampled(requestedSize, alignment);
+        return *memptr == NULL ? ENOMEM : 0;
+    }
+
     pthread_mutex_lock(&_parcSafeMemory_Mutex);
 
     void *base;
@@ -567,8 +925,8 @@ parcSafeMemory_MemAlign(void **memptr, size_t alignment, size_t requestedSize)
     return 0;
 }
 
-void *
-parcSafeMemory_Allocate(size_t requestedSize)
+static void *
+_parcSafeMemory_AllocateSampled(size_t requestedSize)
 {
     void *result = NULL;
 
@@ -590,6 +948,18 @@ parcSafeMemory_Allocate(size_t requestedSize)
     return result;
 }
 
+void *
+parcSafeMemory_Allocate(size_t requestedSize)
+{
+    if (requestedSize == 0) {
+        return NULL;
+    }
+    if (_parcSafeMemory_ShouldSample()) {
+        return _parcSafeMemory_AllocateSampled(requestedSize);
+    }
+    return _parcSafeMemory_AllocateUnsampled(requestedSize, sizeof(void *));
+}
+
 void *
 parcSafeMemory_AllocateAndClear(size_t requestedSize)
 {
@@ -605,6 +975,10 @@ parcSafeMemory_IsValid(const void *memory)
 {
     bool result = true;
 
+    if (_parcSafeMemory_IsUnsampled(memory)) {
+        return true;
+    }
+
     PARCSafeMemoryState state = _parcSafeMemory_GetState(memory);
     if (state != PARCSafeMemoryState_OK) {
         return false;
@@ -623,19 +997,36 @@ parcSafeMemory_Outstanding(void)
 void *
 parcSafeMemory_Reallocate(void *original, size_t newSize)
 {
-    void *result;
+    void *result = NULL;
+
+    if (newSize != 0) {
+        bool sample = _parcSafeMemory_ShouldSample();
+
+        // Unsampled memory that stays unsampled can be resized by the underlying allocator.
+        if (!sample && original != NULL && _parcSafeMemory_IsUnsampled(original)
+            && _parcSafeMemory_GetUnsampledAlignment(original) == sizeof(void *)) {
+            size_t totalSize = _computeUnsampledPrefixLength(sizeof(void *)) + newSize;
+            if (totalSize < newSize) {
+                return NULL;
+            }
+            void *base = ((PARCMemoryReallocate *) _parcMemory->Reallocate)(_parcSafeMemory_GetUnsampledOrigin(original), totalSize);
+            if (base == NULL) {
+                return NULL;
+            }
+            return _parcSafeMemory_FormatUnsampledPrefix(base, newSize, sizeof(void *));
+        }
 
-    result = parcSafeMemory_Allocate(newSize);
+        result = sample ? _parcSafeMemory_AllocateSampled(newSize) : _parcSafeMemory_AllocateUnsampled(newSize, sizeof(void *));
+    }
 
     if (original == NULL) {
         return result;
     }
 
     if (result != NULL) {
-        _MemoryPrefix *prefix = _parcSafeMemory_GetPrefix(original);
-        size_t originalSize = prefix->requestedLength;
+        size_t originalSize = _parcSafeMemory_GetRequestedLength(original);
 
-        memcpy(result, original, originalSize);
+        memcpy(result, original, originalSize < newSize ? originalSize : newSize);
         parcSafeMemory_Deallocate(&original);
     }
     return result;
@@ -660,7 +1051,11 @@ parcSafeMemory_StringDuplicate(const char *string, size_t length)
 void
 parcSafeMemory_Deallocate(void **pointer)
 {
-    _parcSafeMemory_Destroy(pointer);
+    if (*pointer != NULL && _parcSafeMemory_IsUnsampled(*pointer)) {
+        _parcSafeMemory_DestroyUnsampled(pointer);
+    } else {
+        _parcSafeMemory_Destroy(pointer);
+    }
 }
 
 void
@@ -668,6 +1063,19 @@ parcSafeMemory_Display(const void *memory, int indentation)
 {
     if (memory == NULL) {
         parcDisplayIndented_PrintLine(indentation, "PARCSafeMemory@NULL");
+    } else if (_parcSafeMemory_IsUnsampled(memory)) {
+        _MemoryUnsampledPrefix *prefix = _parcSafeMemory_GetUnsampledPrefix(memory);
+
+        parcDisplayIndented_PrintLine(indentation, "PARCSafeMemory@%p {", (void *) memory);
+        parcDisplayIndented_PrintLine(indentation + 1,
+                                      "%p=[ unsampled requestedLength=%zd, alignment=%zd ]",
+                                      _parcSafeMemory_GetUnsampledOrigin(memory),
+                                      prefix->requestedLength,
+                                      _parcSafeMemory_GetUnsampledAlignment(memory));
+
+        parcDisplayIndented_PrintMemory(indentation + 1, prefix->requestedLength, memory);
+
+        parcDisplayIndented_PrintLine(indentation, "}");
     } else {
         _MemoryPrefix *prefix = _parcSafeMemory_GetPrefix(memory);
 
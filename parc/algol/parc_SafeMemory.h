@@ -85,6 +85,14 @@
  * }
  * @endcode
  *
+ * By default every allocation is guarded and recorded.
+ * To run under production load, set a sample rate with `parcSafeMemory_SetSampleRate`:
+ * then on average only 1 in N allocations is guarded and recorded with its backtrace.
+ * The remaining allocations carry a small prefix that identifies them and are otherwise passed
+ * directly to the standard C library functions.
+ * `parcSafeMemory_ReportCallSites` and `parcSafeMemory_StartPeriodicReport` summarise the sampled
+ * allocations that are still live, grouped by the call stack that allocated them.
+ *
  * @author Glenn Scott, Palo Alto Research Center (Xerox PARC)
  * @copyright (c) 2013-2014, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
  */
@@ -318,6 +326,101 @@ uint32_t parcSafeMemory_Outstanding(void);
  */
 uint32_t parcSafeMemory_ReportAllocation(int outputFd);
 
+/**
+ * Set how many allocations, on average, are made for each allocation that is guarded and recorded.
+ *
+ * A rate of 1 (the default) guards and records every allocation.
+ * A rate of N guards and records 1 in N allocations chosen at random intervals, so the cost of
+ * the guards, the backtraces and the record of allocations is paid by only a sample of them.
+ * Overruns and underruns are detected only in sampled memory, and only sampled allocations appear
+ * in `parcSafeMemory_ReportAllocation` and `parcSafeMemory_ReportCallSites`.
+ *
+ * The rate may be changed at any time and applies to subsequent allocations.
+ * Memory may be deallocated regardless of the rate in effect when it was allocated.
+ *
+ * @param [in] rate The number of allocations per sampled allocation. Zero is treated as 1.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcSafeMemory_SetSampleRate(1000);
+ *     parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+ * }
+ * @endcode
+ */
+void parcSafeMemory_SetSampleRate(uint32_t rate);
+
+/**
+ * Get the current sample rate.
+ *
+ * @return The number of allocations per sampled allocation.
+ *
+ * Example:
+ * @code
+ * {
+ *     uint32_t rate = parcSafeMemory_GetSampleRate();
+ * }
+ * @endcode
+ */
+uint32_t parcSafeMemory_GetSampleRate(void);
+
+/**
+ * Report the live sampled allocations grouped by call site.
+ *
+ * Allocations are grouped by their complete backtrace.
+ * Each group is printed with its count, its total requested bytes and its backtrace,
+ * in decreasing order of bytes, so that the largest consumers and leaks appear first.
+ *
+ * @param [in] outputFd Output file descriptor, or -1 to only count the call sites.
+ *
+ * @return The number of distinct call sites with live sampled allocations.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcSafeMemory_ReportCallSites(STDERR_FILENO);
+ * }
+ * @endcode
+ */
+size_t parcSafeMemory_ReportCallSites(int outputFd);
+
+/**
+ * Start a thread that calls `parcSafeMemory_ReportCallSites` every @p intervalSeconds.
+ *
+ * Only one periodic report may run at a time.
+ *
+ * @param [in] outputFd Output file descriptor.
+ * @param [in] intervalSeconds The number of seconds between reports. Must be greater than zero.
+ *
+ * @return true The periodic report was started.
+ * @return false A periodic report is already running, the interval is zero, or the thread could not be created.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcSafeMemory_SetSampleRate(1000);
+ *     parcSafeMemory_StartPeriodicReport(STDERR_FILENO, 60);
+ *     ...
+ *     parcSafeMemory_StopPeriodicReport();
+ * }
+ * @endcode
+ */
+bool parcSafeMemory_StartPeriodicReport(int outputFd, unsigned int intervalSeconds);
+
+/**
+ * Stop the periodic report started by `parcSafeMemory_StartPeriodicReport`, waiting for its thread to exit.
+ *
+ * It is safe to call this function when no periodic report is running.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcSafeMemory_StopPeriodicReport();
+ * }
+ * @endcode
+ */
+void parcSafeMemory_StopPeriodicReport(void);
+
 /**
  * Determine if a pointer to Safe Memory is valid.
  *
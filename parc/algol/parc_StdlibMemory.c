@@ -70,42 +70,156 @@
 
 #include <parc/algol/parc_StdlibMemory.h>
 
-static uint32_t _parcStdlibMemory_OutstandingAllocations;
+#if defined(__APPLE__)
+#include <malloc/malloc.h>
+#define _parcStdlibMemory_UsableSize(_pointer_) malloc_size(_pointer_)
+#elif defined(__linux__)
+#include <malloc.h>
+#define _parcStdlibMemory_UsableSize(_pointer_) malloc_usable_size(_pointer_)
+#else
+#define _parcStdlibMemory_UsableSize(_pointer_) ((size_t) 0)
+#endif
+
+/*
+ * Allocation accounting is sharded per thread so that allocating and deallocating never write
+ * to a cache line shared with another thread.
+ * Each thread owns a shard that only it writes, and the process-wide values are the sum of all of the shards,
+ * computed only when they are requested.
+ * When a thread exits, its counts are folded into the retired totals and the shard is
+ * left for reuse by a later thread, so the number of shards is bounded by the peak number of threads.
+ *
+ * Byte counts are the usable sizes reported by the platform allocator, where it provides them.
+ */
+#define _PARCStdlibMemory_CacheLineSize 64
+
+typedef struct parc_stdlib_memory_shard {
+    PARCMemoryStatistics statistics;
+    struct parc_stdlib_memory_shard *next;
+    bool inUse;
+} _PARCStdlibMemoryShard;
 
-#ifdef PARCLibrary_DISABLE_ATOMICS
-static pthread_mutex_t _parcStdlibMemory_Mutex = PTHREAD_MUTEX_INITIALIZER;
+typedef union {
+    _PARCStdlibMemoryShard shard;
+    uint8_t padding[_PARCStdlibMemory_CacheLineSize * ((sizeof(_PARCStdlibMemoryShard) + _PARCStdlibMemory_CacheLineSize - 1) / _PARCStdlibMemory_CacheLineSize)];
+} _PARCStdlibMemoryPaddedShard;
+
+static pthread_mutex_t _parcStdlibMemory_RegistryLock = PTHREAD_MUTEX_INITIALIZER;
+static _PARCStdlibMemoryShard *_parcStdlibMemory_Shards;
+static PARCMemoryStatistics _parcStdlibMemory_Retired;
+
+static pthread_once_t _parcStdlibMemory_KeyOnce = PTHREAD_ONCE_INIT;
+static pthread_key_t _parcStdlibMemory_ShardKey;
 
 static inline void
-_parcStdlibMemory_IncrementOutstandingAllocations(void)
+_parcStdlibMemory_AddStatistics(PARCMemoryStatistics *sum, const PARCMemoryStatistics *statistics)
 {
-    pthread_mutex_lock(&_parcStdlibMemory_Mutex);
-    _parcStdlibMemory_OutstandingAllocations++;
-    pthread_mutex_unlock(&_parcStdlibMemory_Mutex);
+    sum->allocations += __atomic_load_n(&statistics->allocations, __ATOMIC_RELAXED);
+    sum->deallocations += __atomic_load_n(&statistics->deallocations, __ATOMIC_RELAXED);
+    sum->bytesAllocated += __atomic_load_n(&statistics->bytesAllocated, __ATOMIC_RELAXED);
+    sum->bytesDeallocated += __atomic_load_n(&statistics->bytesDeallocated, __ATOMIC_RELAXED);
 }
 
+// Only the owning thread writes a shard, so a relaxed load and store suffice for a reader to see whole values.
 static inline void
-_parcStdlibMemory_DecrementOutstandingAllocations(void)
+_parcStdlibMemory_Add(uint64_t *counter, uint64_t value)
 {
-    pthread_mutex_lock(&_parcStdlibMemory_Mutex);
-    _parcStdlibMemory_OutstandingAllocations--;
-    pthread_mutex_unlock(&_parcStdlibMemory_Mutex);
+    __atomic_store_n(counter, __atomic_load_n(counter, __ATOMIC_RELAXED) + value, __ATOMIC_RELAXED);
+}
+
+static void
+_parcStdlibMemory_ReleaseShard(void *value)
+{
+    _PARCStdlibMemoryShard *shard = value;
+
+    pthread_mutex_lock(&_parcStdlibMemory_RegistryLock);
+    _parcStdlibMemory_AddStatistics(&_parcStdlibMemory_Retired, &shard->statistics);
+    memset(&shard->statistics, 0, sizeof(shard->statistics));
+    shard->inUse = false;
+    pthread_mutex_unlock(&_parcStdlibMemory_RegistryLock);
+}
+
+static void
+_parcStdlibMemory_CreateKey(void)
+{
+    pthread_key_create(&_parcStdlibMemory_ShardKey, _parcStdlibMemory_ReleaseShard);
+}
+
+static _PARCStdlibMemoryShard *
+_parcStdlibMemory_AcquireShard(void)
+{
+    pthread_mutex_lock(&_parcStdlibMemory_RegistryLock);
+
+    _PARCStdlibMemoryShard *shard = _parcStdlibMemory_Shards;
+    while (shard != NULL && shard->inUse) {
+        shard = shard->next;
+    }
+
+    if (shard == NULL) {
+        void *memory;
+        if (posix_memalign(&memory, _PARCStdlibMemory_CacheLineSize, sizeof(_PARCStdlibMemoryPaddedShard)) == 0) {
+            shard = memset(memory, 0, sizeof(_PARCStdlibMemoryPaddedShard));
+            shard->next = _parcStdlibMemory_Shards;
+            __atomic_store_n(&_parcStdlibMemory_Shards, shard, __ATOMIC_RELEASE);
+        }
+    }
+    if (shard != NULL) {
+        shard->inUse = true;
+    }
+
+    pthread_mutex_unlock(&_parcStdlibMemory_RegistryLock);
+
+    trapOutOfMemoryIf(shard == NULL, "Cannot allocate the allocation accounting for this thread.");
+    pthread_setspecific(_parcStdlibMemory_ShardKey, shard);
+    return shard;
+}
+
+static inline _PARCStdlibMemoryShard *
+_parcStdlibMemory_GetShard(void)
+{
+    pthread_once(&_parcStdlibMemory_KeyOnce, _parcStdlibMemory_CreateKey);
+
+    _PARCStdlibMemoryShard *shard = pthread_getspecific(_parcStdlibMemory_ShardKey);
+    if (shard == NULL) {
+        shard = _parcStdlibMemory_AcquireShard();
+    }
+    return shard;
+}
+
+// Sum the statistics of every thread, including those that have exited.
+static PARCMemoryStatistics
+_parcStdlibMemory_Total(void)
+{
+    pthread_mutex_lock(&_parcStdlibMemory_RegistryLock);
+    PARCMemoryStatistics result = _parcStdlibMemory_Retired;
+    for (_PARCStdlibMemoryShard *shard = _parcStdlibMemory_Shards; shard != NULL; shard = shard->next) {
+        _parcStdlibMemory_AddStatistics(&result, &shard->statistics);
+    }
+    pthread_mutex_unlock(&_parcStdlibMemory_RegistryLock);
+
+    return result;
 }
-#else
 
 static inline void
-_parcStdlibMemory_IncrementOutstandingAllocations(void)
+_parcStdlibMemory_CountAllocation(void *pointer)
 {
-    __sync_add_and_fetch(&_parcStdlibMemory_OutstandingAllocations, 1);
+    _PARCStdlibMemoryShard *shard = _parcStdlibMemory_GetShard();
+    _parcStdlibMemory_Add(&shard->statistics.allocations, 1);
+    _parcStdlibMemory_Add(&shard->statistics.bytesAllocated, _parcStdlibMemory_UsableSize(pointer));
 }
 
 static inline void
-_parcStdlibMemory_DecrementOutstandingAllocations(void)
+_parcStdlibMemory_CountDeallocation(size_t usableSize)
 {
-    __sync_sub_and_fetch(&_parcStdlibMemory_OutstandingAllocations, 1);
+    // A thread may free what another thread allocated, so a shard's own counts say nothing about a double free,
+    // and summing every shard here would serialise all deallocations on the shard registry.
+    _PARCStdlibMemoryShard *shard = _parcStdlibMemory_GetShard();
+
+    _parcStdlibMemory_Add(&shard->statistics.deallocations, 1);
+    _parcStdlibMemory_Add(&shard->statistics.bytesDeallocated, usableSize);
 }
-#endif
 
-#if HAVE_REALLOC == 0
+// The build only defines HAVE_REALLOC (as 0) when the platform realloc is unusable.
+#if defined(HAVE_REALLOC) && HAVE_REALLOC == 0
 static void *
 _parcStdlibMemory_rplRealloc(void *oldAlloc, size_t newSize)
 {
@@ -132,7 +246,7 @@ parcStdlibMemory_Allocate(size_t size)
 
     void *result = malloc(size);
     if (result != NULL) {
-        _parcStdlibMemory_IncrementOutstandingAllocations();
+        _parcStdlibMemory_CountAllocation(result);
     }
 
     return result;
@@ -164,7 +278,7 @@ parcStdlibMemory_MemAlign(void **pointer, size_t alignment, size_t size)
         return ENOMEM;
     }
 
-    _parcStdlibMemory_IncrementOutstandingAllocations();
+    _parcStdlibMemory_CountAllocation(*pointer);
 
     return 0;
 }
@@ -172,27 +286,31 @@ parcStdlibMemory_MemAlign(void **pointer, size_t alignment, size_t size)
 void
 parcStdlibMemory_Deallocate(void **pointer)
 {
-#ifndef PARCLibrary_DISABLE_VALIDATION
-    trapIllegalValueIf(_parcStdlibMemory_OutstandingAllocations == 0,
-                       "parcStdlibMemory_Deallocate invoked with nothing left to free (double free somewhere?)\n");
-#endif
+    size_t usableSize = (*pointer == NULL) ? 0 : _parcStdlibMemory_UsableSize(*pointer);
+    _parcStdlibMemory_CountDeallocation(usableSize);
+
     free(*pointer);
     *pointer = NULL;
-
-    _parcStdlibMemory_DecrementOutstandingAllocations();
 }
 
 void *
 parcStdlibMemory_Reallocate(void *pointer, size_t newSize)
 {
-#if HAVE_REALLOC
+    size_t oldSize = (pointer == NULL) ? 0 : _parcStdlibMemory_UsableSize(pointer);
+
+#if !defined(HAVE_REALLOC) || HAVE_REALLOC
     void *result = realloc(pointer, newSize);
 #else
     void *result = _parcStdlibMemory_rplRealloc(pointer, newSize);
 #endif
 
-    if (pointer == NULL) {
-        _parcStdlibMemory_IncrementOutstandingAllocations();
+    if (result != NULL) {
+        _PARCStdlibMemoryShard *shard = _parcStdlibMemory_GetShard();
+        if (pointer == NULL) {
+            _parcStdlibMemory_Add(&shard->statistics.allocations, 1);
+        }
+        _parcStdlibMemory_Add(&shard->statistics.bytesDeallocated, oldSize);
+        _parcStdlibMemory_Add(&shard->statistics.bytesAllocated, _parcStdlibMemory_UsableSize(result));
     }
     return result;
 }
@@ -200,14 +318,31 @@ parcStdlibMemory_Reallocate(void *pointer, size_t newSize)
 char *
 parcStdlibMemory_StringDuplicate(const char *string, size_t length)
 {
-    _parcStdlibMemory_IncrementOutstandingAllocations();
-    return strndup(string, length);
+    char *result = strndup(string, length);
+    if (result != NULL) {
+        _parcStdlibMemory_CountAllocation(result);
+    }
+    return result;
 }
 
 uint32_t
 parcStdlibMemory_Outstanding(void)
 {
-    return _parcStdlibMemory_OutstandingAllocations;
+    PARCMemoryStatistics total = _parcStdlibMemory_Total();
+    return (uint32_t) (total.allocations - total.deallocations);
+}
+
+bool
+parcStdlibMemory_GetStatistics(PARCMemoryStatistics *total, PARCMemoryStatistics *thread)
+{
+    if (total != NULL) {
+        *total = _parcStdlibMemory_Total();
+    }
+    if (thread != NULL) {
+        memset(thread, 0, sizeof(*thread));
+        _parcStdlibMemory_AddStatistics(thread, &_parcStdlibMemory_GetShard()->statistics);
+    }
+    return true;
 }
 
 PARCMemoryInterface PARCStdlibMemoryAsPARCMemory = {
@@ -217,5 +352,6 @@ PARCMemoryInterface PARCStdlibMemoryAsPARCMemory = {
     .Deallocate       = (uintptr_t) parcStdlibMemory_Deallocate,
     .Reallocate       = (uintptr_t) parcStdlibMemory_Reallocate,
     .StringDuplicate  = (uintptr_t) parcStdlibMemory_StringDuplicate,
-    .Outstanding      = (uintptr_t) parcStdlibMemory_Outstanding
+    .Outstanding      = (uintptr_t) parcStdlibMemory_Outstanding,
+    .Statistics       = (uintptr_t) parcStdlibMemory_GetStatistics
 };
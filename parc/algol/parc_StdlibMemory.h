@@ -208,6 +208,30 @@ char *parcStdlibMemory_StringDuplicate(const char *string, size_t length);
  */
 uint32_t parcStdlibMemory_Outstanding(void);
 
+/**
+ * Get the allocation statistics of the whole process and of the calling thread.
+ *
+ * Each thread accumulates its own counts without sharing a cache line with any other thread;
+ * the process totals are summed from every thread only when requested.
+ * Byte counts are the usable sizes reported by the platform allocator and are zero on platforms that do not report them.
+ *
+ * @param [out] total If not NULL, set to the statistics of every thread, including threads that have exited.
+ * @param [out] thread If not NULL, set to the statistics of the calling thread.
+ *
+ * @return true Always.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCMemoryStatistics thread;
+ *     parcStdlibMemory_GetStatistics(NULL, &thread);
+ * }
+ * @endcode
+ *
+ * @see parcMemory_GetStatistics
+ */
+bool parcStdlibMemory_GetStatistics(PARCMemoryStatistics *total, PARCMemoryStatistics *thread);
+
 
 /**
  * Replacement function for realloc(3).
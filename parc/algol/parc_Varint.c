@@ -93,9 +93,8 @@ parcVarint_DecodeBuffer(PARCBuffer *buffer, size_t length)
     PARCVarint *result = parcVarint_Create();
     assertNotNull(result, "PARCVarint out of memory.");
 
-    for (size_t i = 0; i < length; i++) {
-        parcVarint_ShiftLeft(result, 8);
-        parcVarint_OrUint8(result, parcBuffer_GetUint8(buffer));
+    if (length > 0) {
+        parcVarint_Set(result, parcBuffer_GetUintN(buffer, length));
     }
 
     return result;
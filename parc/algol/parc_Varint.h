@@ -110,7 +110,10 @@ PARCVarint *parcVarint_Create(void);
  * {
  *     <#example#>
  * }
- * @endcode */
+ * @endcode
+ *
+ * @see parcBuffer_GetUintN to decode the value without allocating a `PARCVarint`.
+ */
 PARCVarint *parcVarint_DecodeBuffer(PARCBuffer *buffer, size_t length);
 
 /**
@@ -0,0 +1,643 @@
+/*
+ * Copyright (c) 2014, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @author Glenn Scott, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include "../parc_ArenaMemory.c"
+
+#include <LongBow/testing.h>
+#include <LongBow/debugging.h>
+
+#include <sys/time.h>
+
+#include <parc/algol/parc_JSON.h>
+#include <parc/algol/parc_URI.h>
+#include <parc/testing/parc_MemoryTesting.h>
+
+LONGBOW_TEST_RUNNER(test_parc_ArenaMemory)
+{
+    // The following Test Fixtures will run their corresponding Test Cases.
+    // Test Fixtures are run in the order specified, but all tests should be idempotent.
+    // Never rely on the execution order of tests or share state between them.
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+    LONGBOW_RUN_TEST_FIXTURE(Interface);
+    LONGBOW_RUN_TEST_FIXTURE(Threads);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
+}
+
+// The Test Runner calls this function once before any Test Fixtures are run.
+LONGBOW_TEST_RUNNER_SETUP(test_parc_ArenaMemory)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// The Test Runner calls this function once after all the Test Fixtures are run.
+LONGBOW_TEST_RUNNER_TEARDOWN(test_parc_ArenaMemory)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, parcArenaMemory_CreateDestroy);
+    LONGBOW_RUN_TEST_CASE(Global, parcArenaMemory_Allocate_Heap);
+    LONGBOW_RUN_TEST_CASE(Global, parcArenaMemory_Allocate_Arena);
+    LONGBOW_RUN_TEST_CASE(Global, parcArenaMemory_Allocate_Large);
+    LONGBOW_RUN_TEST_CASE(Global, parcArenaMemory_Allocate_Zero);
+    LONGBOW_RUN_TEST_CASE(Global, parcArenaMemory_AllocateAndClear);
+    LONGBOW_RUN_TEST_CASE(Global, parcArenaMemory_MemAlign);
+    LONGBOW_RUN_TEST_CASE(Global, parcArenaMemory_MemAlign_BadAlignment);
+    LONGBOW_RUN_TEST_CASE(Global, parcArenaMemory_Deallocate_Last);
+    LONGBOW_RUN_TEST_CASE(Global, parcArenaMemory_Deallocate_OtherArena);
+    LONGBOW_RUN_TEST_CASE(Global, parcArenaMemory_Reallocate_InPlace);
+    LONGBOW_RUN_TEST_CASE(Global, parcArenaMemory_Reallocate_Copy);
+    LONGBOW_RUN_TEST_CASE(Global, parcArenaMemory_Reallocate_Heap);
+    LONGBOW_RUN_TEST_CASE(Global, parcArenaMemory_StringDuplicate);
+    LONGBOW_RUN_TEST_CASE(Global, parcArenaMemory_Reset);
+    LONGBOW_RUN_TEST_CASE(Global, parcArenaMemory_SetCurrent);
+    LONGBOW_RUN_TEST_CASE(Global, parcArenaMemory_HugePages);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    if (!parcMemoryTesting_ExpectedOutstanding(0, "%s leaks allocations.", longBowTestCase_GetFullName(testCase))) {
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Global, parcArenaMemory_CreateDestroy)
+{
+    PARCArenaMemory *arena = parcArenaMemory_Create(0, PARCArenaMemoryFlags_None);
+    assertNotNull(arena, "Expected parcArenaMemory_Create to return a non-NULL value");
+    assertTrue(parcArenaMemory_BytesReserved(arena) == 0, "Expected an empty arena to hold no memory");
+
+    parcArenaMemory_Destroy(&arena);
+    assertNull(arena, "Expected parcArenaMemory_Destroy to set the pointer to NULL");
+}
+
+LONGBOW_TEST_CASE(Global, parcArenaMemory_Allocate_Heap)
+{
+    uint32_t before = parcArenaMemory_Outstanding();
+
+    void *memory = parcArenaMemory_Allocate(100);
+    assertNotNull(memory, "Expected a non-NULL result");
+    assertTrue(((uintptr_t) memory % sizeof(void *)) == 0, "Expected memory to be aligned");
+    memset(memory, 0xA5, 100);
+    assertTrue(parcArenaMemory_Outstanding() == before + 1, "Expected a heap allocation to be outstanding");
+
+    parcArenaMemory_Deallocate(&memory);
+    assertNull(memory, "Expected the pointer to be set to NULL");
+    assertTrue(parcArenaMemory_Outstanding() == before, "Expected the heap allocation to be freed");
+}
+
+LONGBOW_TEST_CASE(Global, parcArenaMemory_Allocate_Arena)
+{
+    PARCArenaMemory *arena = parcArenaMemory_Create(4096, PARCArenaMemoryFlags_None);
+    PARCArenaMemory *previous = parcArenaMemory_SetCurrent(arena);
+
+    uint8_t *memory[100];
+    for (int i = 0; i < 100; i++) {
+        memory[i] = parcArenaMemory_Allocate(i + 1);
+        assertNotNull(memory[i], "Expected a non-NULL result");
+        assertTrue(((uintptr_t) memory[i] % _PARCArenaMemory_Alignment) == 0, "Expected memory to be aligned");
+        memset(memory[i], i, i + 1);
+    }
+    for (int i = 0; i < 100; i++) {
+        for (int j = 0; j <= i; j++) {
+            assertTrue(memory[i][j] == i, "Expected allocations not to overlap");
+        }
+    }
+    assertTrue(parcArenaMemory_BytesUsed(arena) >= 5050, "Expected at least 5050 bytes used, actual %zu", parcArenaMemory_BytesUsed(arena));
+    assertTrue(arena->regions->next != NULL, "Expected the arena to have grown beyond its first region");
+
+    parcArenaMemory_SetCurrent(previous);
+    parcArenaMemory_Destroy(&arena);
+}
+
+LONGBOW_TEST_CASE(Global, parcArenaMemory_Allocate_Large)
+{
+    PARCArenaMemory *arena = parcArenaMemory_Create(4096, PARCArenaMemoryFlags_None);
+    PARCArenaMemory *previous = parcArenaMemory_SetCurrent(arena);
+
+    uint8_t *small = parcArenaMemory_Allocate(10);
+    uint8_t *large = parcArenaMemory_Allocate(1024 * 1024);
+    assertNotNull(large, "Expected a non-NULL result");
+    memset(large, 1, 1024 * 1024);
+    assertTrue(parcArenaMemory_BytesReserved(arena) >= 1024 * 1024 + 4096, "Expected a region of its own for a large allocation");
+    assertTrue(small != NULL, "Expected a non-NULL result");
+
+    assertNull(parcArenaMemory_Allocate(SIZE_MAX - 8), "Expected an impossible allocation to fail");
+
+    parcArenaMemory_SetCurrent(previous);
+    parcArenaMemory_Destroy(&arena);
+}
+
+LONGBOW_TEST_CASE(Global, parcArenaMemory_Allocate_Zero)
+{
+    assertNull(parcArenaMemory_Allocate(0), "Expected a NULL result for a zero length allocation");
+}
+
+LONGBOW_TEST_CASE(Global, parcArenaMemory_AllocateAndClear)
+{
+    PARCArenaMemory *arena = parcArenaMemory_Create(0, PARCArenaMemoryFlags_None);
+    PARCArenaMemory *previous = parcArenaMemory_SetCurrent(arena);
+
+    // Dirty the arena, then reset it so that the next allocation reuses the memory.
+    memset(parcArenaMemory_Allocate(100), 0xFF, 100);
+    parcArenaMemory_Reset(arena);
+
+    uint8_t *memory = parcArenaMemory_AllocateAndClear(100);
+    for (int i = 0; i < 100; i++) {
+        assertTrue(memory[i] == 0, "Expected byte %d to be zero", i);
+    }
+
+    parcArenaMemory_SetCurrent(previous);
+    parcArenaMemory_Destroy(&arena);
+}
+
+LONGBOW_TEST_CASE(Global, parcArenaMemory_MemAlign)
+{
+    PARCArenaMemory *arena = parcArenaMemory_Create(0, PARCArenaMemoryFlags_None);
+
+    for (size_t alignment = sizeof(void *); alignment <= 4096; alignment *= 2) {
+        void *memory;
+        assertTrue(parcArenaMemory_MemAlign(&memory, alignment, 24) == 0, "Expected a heap allocation to succeed");
+        assertTrue(((uintptr_t) memory % alignment) == 0, "Expected heap memory to be aligned on %zu", alignment);
+        parcArenaMemory_Deallocate(&memory);
+
+        PARCArenaMemory *previous = parcArenaMemory_SetCurrent(arena);
+        parcArenaMemory_Allocate(3);
+        assertTrue(parcArenaMemory_MemAlign(&memory, alignment, 24) == 0, "Expected an arena allocation to succeed");
+        assertTrue(((uintptr_t) memory % alignment) == 0, "Expected arena memory to be aligned on %zu", alignment);
+        parcArenaMemory_Deallocate(&memory);
+        parcArenaMemory_SetCurrent(previous);
+    }
+
+    parcArenaMemory_Destroy(&arena);
+}
+
+LONGBOW_TEST_CASE(Global, parcArenaMemory_MemAlign_BadAlignment)
+{
+    void *memory;
+    assertTrue(parcArenaMemory_MemAlign(&memory, 3, 24) == EINVAL, "Expected EINVAL for an alignment that is not a power of 2");
+    assertTrue(parcArenaMemory_MemAlign(&memory, 16, 0) == EINVAL, "Expected EINVAL for a zero size");
+}
+
+LONGBOW_TEST_CASE(Global, parcArenaMemory_Deallocate_Last)
+{
+    PARCArenaMemory *arena = parcArenaMemory_Create(0, PARCArenaMemoryFlags_None);
+    PARCArenaMemory *previous = parcArenaMemory_SetCurrent(arena);
+
+    void *first = parcArenaMemory_Allocate(100);
+    size_t used = parcArenaMemory_BytesUsed(arena);
+
+    void *second = parcArenaMemory_Allocate(100);
+    parcArenaMemory_Deallocate(&second);
+    assertTrue(parcArenaMemory_BytesUsed(arena) == used, "Expected the most recent allocation to be returned immediately");
+
+    void *third = parcArenaMemory_Allocate(100);
+    parcArenaMemory_Deallocate(&first);
+    assertTrue(parcArenaMemory_BytesUsed(arena) > used, "Expected an earlier allocation to remain until the arena is reset");
+    parcArenaMemory_Deallocate(&third);
+
+    parcArenaMemory_SetCurrent(previous);
+    parcArenaMemory_Destroy(&arena);
+}
+
+LONGBOW_TEST_CASE(Global, parcArenaMemory_Deallocate_OtherArena)
+{
+    PARCArenaMemory *arena = parcArenaMemory_Create(0, PARCArenaMemoryFlags_None);
+    PARCArenaMemory *previous = parcArenaMemory_SetCurrent(arena);
+    void *arenaMemory = parcArenaMemory_Allocate(100);
+    parcArenaMemory_SetCurrent(previous);
+
+    void *heapMemory = parcArenaMemory_Allocate(100);
+
+    // Memory may be deallocated regardless of the current arena.
+    parcArenaMemory_SetCurrent(arena);
+    parcArenaMemory_Deallocate(&heapMemory);
+    parcArenaMemory_SetCurrent(previous);
+    parcArenaMemory_Deallocate(&arenaMemory);
+
+    parcArenaMemory_Destroy(&arena);
+}
+
+LONGBOW_TEST_CASE(Global, parcArenaMemory_Reallocate_InPlace)
+{
+    PARCArenaMemory *arena = parcArenaMemory_Create(0, PARCArenaMemoryFlags_None);
+    PARCArenaMemory *previous = parcArenaMemory_SetCurrent(arena);
+
+    uint8_t *memory = parcArenaMemory_Allocate(10);
+    memset(memory, 7, 10);
+    uint8_t *grown = parcArenaMemory_Reallocate(memory, 1000);
+    assertTrue(grown == memory, "Expected the most recent allocation to grow in place");
+    for (int i = 0; i < 10; i++) {
+        assertTrue(grown[i] == 7, "Expected the content to be preserved");
+    }
+    assertTrue(parcArenaMemory_BytesUsed(arena) >= 1000, "Expected the grown allocation to be accounted for");
+
+    uint8_t *shrunk = parcArenaMemory_Reallocate(grown, 20);
+    assertTrue(shrunk == memory, "Expected the most recent allocation to shrink in place");
+    assertTrue(parcArenaMemory_BytesUsed(arena) < 100, "Expected the shrunk allocation to return memory, used %zu", parcArenaMemory_BytesUsed(arena));
+
+    parcArenaMemory_SetCurrent(previous);
+    parcArenaMemory_Destroy(&arena);
+}
+
+LONGBOW_TEST_CASE(Global, parcArenaMemory_Reallocate_Copy)
+{
+    PARCArenaMemory *arena = parcArenaMemory_Create(0, PARCArenaMemoryFlags_None);
+    PARCArenaMemory *previous = parcArenaMemory_SetCurrent(arena);
+
+    uint8_t *memory = parcArenaMemory_Allocate(10);
+    memset(memory, 7, 10);
+    parcArenaMemory_Allocate(10);
+
+    uint8_t *grown = parcArenaMemory_Reallocate(memory, 1000);
+    assertTrue(grown != memory, "Expected an earlier allocation to be copied");
+    for (int i = 0; i < 10; i++) {
+        assertTrue(grown[i] == 7, "Expected the content to be preserved");
+    }
+
+    // Reallocating arena memory with no current arena moves it to the heap.
+    parcArenaMemory_SetCurrent(previous);
+    uint32_t outstanding = parcArenaMemory_Outstanding();
+    uint8_t *moved = parcArenaMemory_Reallocate(grown, 2000);
+    assertTrue(moved[9] == 7, "Expected the content to be preserved");
+    assertTrue(parcArenaMemory_Outstanding() == outstanding + 1, "Expected a heap allocation");
+    parcArenaMemory_Deallocate((void **) &moved);
+
+    parcArenaMemory_Destroy(&arena);
+}
+
+LONGBOW_TEST_CASE(Global, parcArenaMemory_Reallocate_Heap)
+{
+    uint8_t *memory = parcArenaMemory_Reallocate(NULL, 10);
+    memset(memory, 7, 10);
+    memory = parcArenaMemory_Reallocate(memory, 100000);
+    for (int i = 0; i < 10; i++) {
+        assertTrue(memory[i] == 7, "Expected the content to be preserved");
+    }
+
+    void *aligned;
+    parcArenaMemory_MemAlign(&aligned, 256, 10);
+    memset(aligned, 9, 10);
+    aligned = parcArenaMemory_Reallocate(aligned, 100);
+    assertTrue(((uint8_t *) aligned)[9] == 9, "Expected the content to be preserved");
+
+    parcArenaMemory_Deallocate(&aligned);
+    parcArenaMemory_Deallocate((void **) &memory);
+}
+
+LONGBOW_TEST_CASE(Global, parcArenaMemory_StringDuplicate)
+{
+    PARCArenaMemory *arena = parcArenaMemory_Create(0, PARCArenaMemoryFlags_None);
+    PARCArenaMemory *previous = parcArenaMemory_SetCurrent(arena);
+
+    char *copy = parcArenaMemory_StringDuplicate("Hello World", 5);
+    assertTrue(strcmp(copy, "Hello") == 0, "Expected 'Hello', actual '%s'", copy);
+
+    copy = parcArenaMemory_StringDuplicate("Hi", 100);
+    assertTrue(strcmp(copy, "Hi") == 0, "Expected 'Hi', actual '%s'", copy);
+
+    parcArenaMemory_SetCurrent(previous);
+    parcArenaMemory_Destroy(&arena);
+}
+
+LONGBOW_TEST_CASE(Global, parcArenaMemory_Reset)
+{
+    uint32_t before = parcArenaMemory_Outstanding();
+
+    PARCArenaMemory *arena = parcArenaMemory_Create(1024, PARCArenaMemoryFlags_None);
+    PARCArenaMemory *previous = parcArenaMemory_SetCurrent(arena);
+
+    for (int i = 0; i < 1000; i++) {
+        parcArenaMemory_Allocate(100);
+    }
+    assertTrue(parcArenaMemory_Outstanding() > before + 1, "Expected the arena to hold several regions");
+    size_t reserved = parcArenaMemory_BytesReserved(arena);
+
+    parcArenaMemory_Reset(arena);
+    assertTrue(parcArenaMemory_BytesUsed(arena) == 0, "Expected no bytes used after a reset");
+    assertTrue(parcArenaMemory_Outstanding() == before + 1, "Expected the arena to retain one region");
+    assertTrue(parcArenaMemory_BytesReserved(arena) < reserved, "Expected the arena to release memory");
+
+    // The retained region is the largest, and is reused.
+    _PARCArenaMemoryRegion *retained = arena->regions;
+    uint8_t *memory = parcArenaMemory_Allocate(100);
+    assertTrue(memory > (uint8_t *) retained && memory < (uint8_t *) retained + retained->capacity,
+               "Expected the retained region to be reused");
+
+    parcArenaMemory_SetCurrent(previous);
+    parcArenaMemory_Destroy(&arena);
+    assertTrue(parcArenaMemory_Outstanding() == before, "Expected no regions after the arena is destroyed");
+}
+
+LONGBOW_TEST_CASE(Global, parcArenaMemory_SetCurrent)
+{
+    PARCArenaMemory *arena1 = parcArenaMemory_Create(0, PARCArenaMemoryFlags_None);
+    PARCArenaMemory *arena2 = parcArenaMemory_Create(0, PARCArenaMemoryFlags_None);
+
+    assertNull(parcArenaMemory_GetCurrent(), "Expected no current arena");
+    PARCArenaMemory *previous = parcArenaMemory_SetCurrent(arena1);
+    assertNull(previous, "Expected no previous arena");
+
+    previous = parcArenaMemory_SetCurrent(arena2);
+    assertTrue(previous == arena1, "Expected the previous arena to be returned");
+    assertTrue(parcArenaMemory_GetCurrent() == arena2, "Expected the current arena to be set");
+
+    // Destroying the current arena makes the thread allocate from the heap again.
+    parcArenaMemory_Destroy(&arena2);
+    assertNull(parcArenaMemory_GetCurrent(), "Expected no current arena after it is destroyed");
+
+    parcArenaMemory_Destroy(&arena1);
+}
+
+LONGBOW_TEST_CASE(Global, parcArenaMemory_HugePages)
+{
+    PARCArenaMemory *arena = parcArenaMemory_Create(0, PARCArenaMemoryFlags_HugePages);
+    PARCArenaMemory *previous = parcArenaMemory_SetCurrent(arena);
+
+    uint8_t *memory = parcArenaMemory_Allocate(100);
+    memset(memory, 1, 100);
+    assertTrue(parcArenaMemory_BytesReserved(arena) % _PARCArenaMemory_HugePageSize == 0,
+               "Expected the region to be a multiple of the huge page size, actual %zu", parcArenaMemory_BytesReserved(arena));
+    if (arena->regions->mapped) {
+        assertTrue(((uintptr_t) arena->regions % _PARCArenaMemory_HugePageSize) == 0, "Expected the region to be aligned on a huge page");
+    }
+
+    parcArenaMemory_SetCurrent(previous);
+    parcArenaMemory_Destroy(&arena);
+}
+
+// The arena interface installed process-wide, with request-scoped arenas.
+LONGBOW_TEST_FIXTURE(Interface)
+{
+    LONGBOW_RUN_TEST_CASE(Interface, parcJSON_ParseString);
+    LONGBOW_RUN_TEST_CASE(Interface, parcURI_Parse);
+    LONGBOW_RUN_TEST_CASE(Interface, parcArenaMemory_ThreadArena);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Interface)
+{
+    longBowTestCase_SetClipBoardData(testCase, (void *) parcMemory_SetInterface(&PARCArenaMemoryAsPARCMemory));
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Interface)
+{
+    parcMemory_SetInterface(longBowTestCase_GetClipBoardData(testCase));
+    if (!parcMemoryTesting_ExpectedOutstanding(0, "%s leaks allocations.", longBowTestCase_GetFullName(testCase))) {
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+static const char *_message = "{ \"name\" : \"ccnx:/a/b/c\", \"array\" : [ 1, 2, 3, \"four\", { \"five\" : 5 } ], \"nested\" : { \"x\" : true } }";
+
+LONGBOW_TEST_CASE(Interface, parcJSON_ParseString)
+{
+    PARCArenaMemory *arena = parcArenaMemory_Create(0, PARCArenaMemoryFlags_None);
+
+    PARCJSON *heapJSON = parcJSON_ParseString(_message);
+    char *expected = parcJSON_ToCompactString(heapJSON);
+
+    for (int i = 0; i < 10; i++) {
+        PARCArenaMemory *previous = parcArenaMemory_SetCurrent(arena);
+
+        PARCJSON *json = parcJSON_ParseString(_message);
+        char *actual = parcJSON_ToCompactString(json);
+        assertTrue(strcmp(expected, actual) == 0, "Expected %s, actual %s", expected, actual);
+        parcMemory_Deallocate(&actual);
+        parcJSON_Release(&json);
+
+        parcArenaMemory_SetCurrent(previous);
+        parcArenaMemory_Reset(arena);
+    }
+
+    parcMemory_Deallocate(&expected);
+    parcJSON_Release(&heapJSON);
+    parcArenaMemory_Destroy(&arena);
+}
+
+LONGBOW_TEST_CASE(Interface, parcURI_Parse)
+{
+    PARCArenaMemory *arena = parcArenaMemory_Create(0, PARCArenaMemoryFlags_None);
+    PARCArenaMemory *previous = parcArenaMemory_SetCurrent(arena);
+
+    // Deliberately not released: the arena reclaims everything at once.
+    PARCURI *uri = parcURI_Parse("http://user@example.com:8080/a/b/c?query#fragment");
+    assertNotNull(uri, "Expected the URI to parse");
+    char *string = parcURI_ToString(uri);
+    assertTrue(strcmp(string, "http://user@example.com:8080/a/b/c?query#fragment") == 0, "Unexpected URI %s", string);
+
+    parcArenaMemory_SetCurrent(previous);
+    parcArenaMemory_Destroy(&arena);
+}
+
+static void *
+_useThreadArena(void *unused)
+{
+    PARCArenaMemory *arena = parcArenaMemory_ThreadArena();
+    assertTrue(arena == parcArenaMemory_ThreadArena(), "Expected the same thread arena on each call");
+
+    PARCArenaMemory *previous = parcArenaMemory_SetCurrent(arena);
+    PARCJSON *json = parcJSON_ParseString(_message);
+    parcJSON_Release(&json);
+    parcArenaMemory_SetCurrent(previous);
+    parcArenaMemory_Reset(arena);
+
+    return arena;
+}
+
+LONGBOW_TEST_CASE(Interface, parcArenaMemory_ThreadArena)
+{
+    pthread_t thread;
+    void *otherArena;
+    pthread_create(&thread, NULL, _useThreadArena, NULL);
+    pthread_join(thread, &otherArena);
+
+    assertTrue(otherArena != parcArenaMemory_ThreadArena(), "Expected each thread to have its own arena");
+    assertTrue(parcMemory_Outstanding() == 0, "Expected the other thread's arena to be destroyed at exit, actual %u", parcMemory_Outstanding());
+
+    PARCArenaMemory *arena = parcArenaMemory_ThreadArena();
+    pthread_setspecific(_parcArenaMemory_ThreadArenaKey, NULL);
+    parcArenaMemory_Destroy(&arena);
+}
+
+LONGBOW_TEST_FIXTURE(Threads)
+{
+    LONGBOW_RUN_TEST_CASE(Threads, CrossThreadDeallocate);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Threads)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Threads)
+{
+    if (!parcMemoryTesting_ExpectedOutstanding(0, "%s leaks allocations.", longBowTestCase_GetFullName(testCase))) {
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+static void *
+_deallocate(void *memory)
+{
+    parcArenaMemory_Deallocate(&memory);
+    return NULL;
+}
+
+LONGBOW_TEST_CASE(Threads, CrossThreadDeallocate)
+{
+    PARCArenaMemory *arena = parcArenaMemory_Create(0, PARCArenaMemoryFlags_None);
+    PARCArenaMemory *previous = parcArenaMemory_SetCurrent(arena);
+    void *arenaMemory = parcArenaMemory_Allocate(100);
+    size_t used = parcArenaMemory_BytesUsed(arena);
+    parcArenaMemory_SetCurrent(previous);
+    void *heapMemory = parcArenaMemory_Allocate(100);
+
+    pthread_t thread;
+    pthread_create(&thread, NULL, _deallocate, arenaMemory);
+    pthread_join(thread, NULL);
+    pthread_create(&thread, NULL, _deallocate, heapMemory);
+    pthread_join(thread, NULL);
+
+    assertTrue(parcArenaMemory_BytesUsed(arena) == used, "Expected another thread not to modify the arena");
+    parcArenaMemory_Destroy(&arena);
+}
+
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, parcJSON_ParseString_Throughput);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    parcMemory_SetInterface(&PARCStdlibMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+#define PARSE_ITERATIONS 100000
+
+static double
+_elapsedSeconds(const struct timeval *start)
+{
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    return (double) (now.tv_sec - start->tv_sec) + (double) (now.tv_usec - start->tv_usec) / 1000000.0;
+}
+
+LONGBOW_TEST_CASE(Performance, parcJSON_ParseString_Throughput)
+{
+    struct timeval start;
+    gettimeofday(&start, NULL);
+    for (int i = 0; i < PARSE_ITERATIONS; i++) {
+        PARCJSON *json = parcJSON_ParseString(_message);
+        parcJSON_Release(&json);
+    }
+    double stdlib = _elapsedSeconds(&start);
+
+    parcMemory_SetInterface(&PARCArenaMemoryAsPARCMemory);
+    PARCArenaMemory *arena = parcArenaMemory_Create(0, PARCArenaMemoryFlags_None);
+
+    gettimeofday(&start, NULL);
+    for (int i = 0; i < PARSE_ITERATIONS; i++) {
+        PARCArenaMemory *previous = parcArenaMemory_SetCurrent(arena);
+        PARCJSON *json = parcJSON_ParseString(_message);
+        parcJSON_Release(&json);
+        parcArenaMemory_SetCurrent(previous);
+        parcArenaMemory_Reset(arena);
+    }
+    double released = _elapsedSeconds(&start);
+
+    gettimeofday(&start, NULL);
+    for (int i = 0; i < PARSE_ITERATIONS; i++) {
+        PARCArenaMemory *previous = parcArenaMemory_SetCurrent(arena);
+        parcJSON_ParseString(_message);
+        parcArenaMemory_SetCurrent(previous);
+        parcArenaMemory_Reset(arena);
+    }
+    double reset = _elapsedSeconds(&start);
+
+    parcArenaMemory_Destroy(&arena);
+    parcMemory_SetInterface(&PARCStdlibMemoryAsPARCMemory);
+
+    printf("parcJSON_ParseString: stdlib %.0f/s, arena with release %.0f/s, arena reset only %.0f/s\n",
+           PARSE_ITERATIONS / stdlib, PARSE_ITERATIONS / released, PARSE_ITERATIONS / reset);
+}
+
+int
+main(int argc, char *argv[argc])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(test_parc_ArenaMemory);
+    int exitStatus = LONGBOW_TEST_MAIN(argc, argv, testRunner, NULL);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
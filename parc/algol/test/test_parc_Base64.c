@@ -60,6 +60,8 @@
 #include "../parc_Base64.c"
 #include <parc/algol/parc_SafeMemory.h>
 
+#include <sys/time.h>
+
 LONGBOW_TEST_RUNNER(parc_Base64)
 {
     // The following Test Fixtures will run their corresponding Test Cases.
@@ -67,6 +69,7 @@ LONGBOW_TEST_RUNNER(parc_Base64)
     // Never rely on the execution order of tests or share state between them.
     LONGBOW_RUN_TEST_FIXTURE(Global);
     LONGBOW_RUN_TEST_FIXTURE(Local);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
 }
 
 // The Test Runner calls this function once before any Test Fixtures are run.
@@ -87,6 +90,15 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, parcBase64_Decode_Linefeeds);
     LONGBOW_RUN_TEST_CASE(Global, parcBase64_Encode);
     LONGBOW_RUN_TEST_CASE(Global, parcBase64_Encode_Binary);
+    LONGBOW_RUN_TEST_CASE(Global, parcBase64_EncodedLength);
+    LONGBOW_RUN_TEST_CASE(Global, parcBase64_DecodedLength);
+    LONGBOW_RUN_TEST_CASE(Global, parcBase64_EncodeArrayToBuffer);
+    LONGBOW_RUN_TEST_CASE(Global, parcBase64_EncodeArrayToBuffer_Overflow);
+    LONGBOW_RUN_TEST_CASE(Global, parcBase64_DecodeArrayToBuffer);
+    LONGBOW_RUN_TEST_CASE(Global, parcBase64_DecodeArrayToBuffer_Invalid);
+    LONGBOW_RUN_TEST_CASE(Global, parcBase64_EncodeToBuffer_DecodeToBuffer);
+    LONGBOW_RUN_TEST_CASE(Global, parcBase64_DecodeToBuffer_Linefeeds);
+    LONGBOW_RUN_TEST_CASE(Global, parcBase64_DecodeArray_Invalid);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Global)
@@ -255,6 +267,179 @@ LONGBOW_TEST_CASE(Global, parcBase64_Encode_Binary)
     }
 }
 
+LONGBOW_TEST_CASE(Global, parcBase64_EncodedLength)
+{
+    size_t expected[] = { 0, 4, 4, 4, 8, 8, 8, 12 };
+
+    for (size_t i = 0; i < sizeof(expected) / sizeof(expected[0]); i++) {
+        assertTrue(parcBase64_EncodedLength(i) == expected[i],
+                   "Expected %zu for %zu bytes, actual %zu", expected[i], i, parcBase64_EncodedLength(i));
+    }
+}
+
+LONGBOW_TEST_CASE(Global, parcBase64_DecodedLength)
+{
+    for (int i = 0; testvector[i].plaintext != NULL; i++) {
+        size_t actual = parcBase64_DecodedLength(strlen(testvector[i].encoded), (uint8_t *) testvector[i].encoded);
+        assertTrue(actual == strlen(testvector[i].plaintext),
+                   "Expected %zu for '%s', actual %zu", strlen(testvector[i].plaintext), testvector[i].encoded, actual);
+    }
+
+    char *encoded = "Zm9v\r\nYmE=\r\n";
+    size_t actual = parcBase64_DecodedLength(strlen(encoded), (uint8_t *) encoded);
+    assertTrue(actual == 5, "Expected 5 with line breaks, actual %zu", actual);
+}
+
+LONGBOW_TEST_CASE(Global, parcBase64_EncodeArrayToBuffer)
+{
+    for (int i = 0; testvector[i].plaintext != NULL; i++) {
+        size_t length = strlen(testvector[i].plaintext);
+        PARCBuffer *output = parcBuffer_Allocate(parcBase64_EncodedLength(length));
+
+        PARCBuffer *result = parcBase64_EncodeArrayToBuffer(output, length, (uint8_t *) testvector[i].plaintext);
+        assertTrue(result == output, "Expected the output buffer to be returned");
+        assertTrue(parcBuffer_Remaining(output) == 0, "Expected the encoding to fill the buffer exactly");
+
+        parcBuffer_Flip(output);
+        PARCBuffer *truth = parcBuffer_WrapCString(testvector[i].encoded);
+        assertTrue(parcBuffer_Equals(truth, output), "Expected '%s', actual '%s'",
+                   testvector[i].encoded, parcBuffer_ToString(output));
+
+        parcBuffer_Release(&truth);
+        parcBuffer_Release(&output);
+    }
+}
+
+LONGBOW_TEST_CASE_EXPECTS(Global, parcBase64_EncodeArrayToBuffer_Overflow, .event = &LongBowTrapOutOfBounds)
+{
+    PARCBuffer *output = parcBuffer_Allocate(7);
+
+    parcBase64_EncodeArrayToBuffer(output, 5, (uint8_t *) "fooba");
+}
+
+LONGBOW_TEST_CASE(Global, parcBase64_DecodeArrayToBuffer)
+{
+    for (int i = 0; testvector[i].plaintext != NULL; i++) {
+        size_t length = strlen(testvector[i].encoded);
+        PARCBuffer *output = parcBuffer_Allocate(strlen(testvector[i].plaintext));
+
+        PARCBuffer *result = parcBase64_DecodeArrayToBuffer(output, length, (uint8_t *) testvector[i].encoded);
+        assertTrue(result == output, "Expected '%s' to decode", testvector[i].encoded);
+        assertTrue(parcBuffer_Remaining(output) == 0, "Expected the decoding to fill the buffer exactly");
+
+        parcBuffer_Flip(output);
+        PARCBuffer *truth = parcBuffer_WrapCString(testvector[i].plaintext);
+        assertTrue(parcBuffer_Equals(truth, output), "Expected '%s', actual '%s'",
+                   testvector[i].plaintext, parcBuffer_ToString(output));
+
+        parcBuffer_Release(&truth);
+        parcBuffer_Release(&output);
+    }
+}
+
+LONGBOW_TEST_CASE(Global, parcBase64_DecodeArrayToBuffer_Invalid)
+{
+    // Long enough that the bad character lands inside a vector block as well as in the tail.
+    uint8_t plaintext[96];
+    for (size_t i = 0; i < sizeof(plaintext); i++) {
+        plaintext[i] = (uint8_t) (i * 37);
+    }
+    PARCBuffer *encoded = parcBuffer_Allocate(parcBase64_EncodedLength(sizeof(plaintext)));
+    parcBase64_EncodeArrayToBuffer(encoded, sizeof(plaintext), plaintext);
+    uint8_t *array = parcBuffer_Overlay(parcBuffer_Flip(encoded), 0);
+    size_t length = parcBuffer_Remaining(encoded);
+
+    PARCBuffer *output = parcBuffer_Allocate(sizeof(plaintext));
+    for (size_t i = 0; i < length; i++) {
+        uint8_t original = array[i];
+        array[i] = '@';
+        PARCBuffer *result = parcBase64_DecodeArrayToBuffer(output, length, array);
+        assertNull(result, "Expected a '@' at offset %zu to fail", i);
+        assertTrue(parcBuffer_Position(output) == 0, "Expected the position to be unchanged, actual %zu", parcBuffer_Position(output));
+        array[i] = original;
+    }
+
+    assertNull(parcBase64_DecodeArrayToBuffer(output, 3, (uint8_t *) "Zm9"), "Expected an incomplete quantum to fail");
+    assertNotNull(parcBase64_DecodeArrayToBuffer(output, length, array), "Expected the restored encoding to decode");
+
+    parcBuffer_Release(&output);
+    parcBuffer_Release(&encoded);
+}
+
+LONGBOW_TEST_CASE(Global, parcBase64_EncodeToBuffer_DecodeToBuffer)
+{
+    uint8_t plaintext[300];
+    for (size_t i = 0; i < sizeof(plaintext); i++) {
+        plaintext[i] = (uint8_t) random();
+    }
+
+    for (size_t length = 0; length <= sizeof(plaintext); length++) {
+        PARCBuffer *input = parcBuffer_Wrap(plaintext, length, 0, length);
+
+        PARCBuffer *encoded = parcBase64_EncodeToBuffer(input);
+        assertTrue(parcBuffer_Remaining(encoded) == parcBase64_EncodedLength(length),
+                   "Expected %zu characters, actual %zu", parcBase64_EncodedLength(length), parcBuffer_Remaining(encoded));
+
+        PARCBufferComposer *composer = parcBufferComposer_Create();
+        parcBase64_Encode(composer, input);
+        PARCBuffer *composed = parcBufferComposer_ProduceBuffer(composer);
+        assertTrue(parcBuffer_Equals(encoded, composed), "Expected the composer encoding to match at length %zu", length);
+
+        PARCBuffer *decoded = parcBase64_DecodeToBuffer(encoded);
+        assertTrue(parcBuffer_Equals(input, decoded), "Expected the round trip to match at length %zu", length);
+        assertTrue(parcBuffer_Position(encoded) == 0, "Expected the encoded position to be unchanged");
+
+        parcBuffer_Release(&decoded);
+        parcBuffer_Release(&composed);
+        parcBufferComposer_Release(&composer);
+        parcBuffer_Release(&encoded);
+        parcBuffer_Release(&input);
+    }
+}
+
+LONGBOW_TEST_CASE(Global, parcBase64_DecodeToBuffer_Linefeeds)
+{
+    uint8_t plaintext[1000];
+    for (size_t i = 0; i < sizeof(plaintext); i++) {
+        plaintext[i] = (uint8_t) random();
+    }
+    PARCBuffer *input = parcBuffer_Wrap(plaintext, sizeof(plaintext), 0, sizeof(plaintext));
+    PARCBuffer *encoded = parcBase64_EncodeToBuffer(input);
+
+    // Break the encoding into 64 character lines, as in a PEM file.
+    PARCBufferComposer *pem = parcBufferComposer_Create();
+    while (parcBuffer_Remaining(encoded) > 0) {
+        size_t line = parcBuffer_Remaining(encoded) < 64 ? parcBuffer_Remaining(encoded) : 64;
+        parcBufferComposer_PutArray(pem, parcBuffer_Overlay(encoded, line), line);
+        parcBufferComposer_PutString(pem, "\r\n");
+    }
+    PARCBuffer *pemBuffer = parcBufferComposer_ProduceBuffer(pem);
+
+    PARCBuffer *decoded = parcBase64_DecodeToBuffer(pemBuffer);
+    assertNotNull(decoded, "Expected the PEM body to decode");
+    assertTrue(parcBuffer_Equals(input, decoded), "Expected the PEM body to decode to the original");
+
+    parcBuffer_Release(&decoded);
+    parcBuffer_Release(&pemBuffer);
+    parcBufferComposer_Release(&pem);
+    parcBuffer_Release(&encoded);
+    parcBuffer_Release(&input);
+}
+
+LONGBOW_TEST_CASE(Global, parcBase64_DecodeArray_Invalid)
+{
+    PARCBufferComposer *output = parcBufferComposer_Create();
+    parcBufferComposer_PutString(output, "prefix");
+
+    PARCBufferComposer *result = parcBase64_DecodeString(output, "Zm9vYmFy@m9v");
+    assertNull(result, "Expected an invalid character to fail");
+    assertTrue(parcBuffer_Position(parcBufferComposer_GetBuffer(output)) == 6,
+               "Expected the composer to be unchanged, actual position %zu",
+               parcBuffer_Position(parcBufferComposer_GetBuffer(output)));
+
+    parcBufferComposer_Release(&output);
+}
+
 LONGBOW_TEST_FIXTURE(Local)
 {
     LONGBOW_RUN_TEST_CASE(Local, encodeWithPad_0);
@@ -264,6 +449,7 @@ LONGBOW_TEST_FIXTURE(Local)
     LONGBOW_RUN_TEST_CASE(Local, decode_1);
     LONGBOW_RUN_TEST_CASE(Local, decode_2);
     LONGBOW_RUN_TEST_CASE(Local, decode_3);
+    LONGBOW_RUN_TEST_CASE(Local, codec_MatchesScalar);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Local)
@@ -286,24 +472,12 @@ LONGBOW_TEST_FIXTURE_TEARDOWN(Local)
  */
 LONGBOW_TEST_CASE(Local, encodeWithPad_0)
 {
-    PARCBufferComposer *output = parcBufferComposer_Create();
     uint8_t input[] = "foobar";
-    PARCBufferComposer *truth = parcBufferComposer_Create();
-    parcBufferComposer_PutString(truth, "Zm9v");
-    PARCBuffer *truthBuffer = parcBufferComposer_ProduceBuffer(truth);
+    uint8_t output[4];
 
     _encodeWithPad(output, input, 0);
-    PARCBuffer *outputBuffer = parcBufferComposer_ProduceBuffer(output);
-    assertTrue(parcBuffer_Equals(truthBuffer, outputBuffer),
-               "Failed 3-byte encode, expected '%s' got '%s'",
-               parcBuffer_ToHexString(truthBuffer),
-               parcBuffer_ToHexString(outputBuffer));
-
-    parcBuffer_Release(&truthBuffer);
-    parcBuffer_Release(&outputBuffer);
-
-    parcBufferComposer_Release(&output);
-    parcBufferComposer_Release(&truth);
+    assertTrue(memcmp(output, "Zm9v", 4) == 0,
+               "Failed 3-byte encode, expected 'Zm9v' got '%.4s'", output);
 }
 
 /**
@@ -311,25 +485,12 @@ LONGBOW_TEST_CASE(Local, encodeWithPad_0)
  */
 LONGBOW_TEST_CASE(Local, encodeWithPad_1)
 {
-    PARCBufferComposer *output = parcBufferComposer_Create();
     uint8_t input[] = "foobar";
-    PARCBufferComposer *truth = parcBufferComposer_Create();
-    parcBufferComposer_PutString(truth, "Zm8=");
-    PARCBuffer *truthBuffer = parcBufferComposer_ProduceBuffer(truth);
+    uint8_t output[4];
 
     _encodeWithPad(output, input, 1);
-    PARCBuffer *outputBuffer = parcBufferComposer_ProduceBuffer(output);
-
-    assertTrue(parcBuffer_Equals(truthBuffer, outputBuffer),
-               "Failed 3-byte encode, expected '%s' got '%s'",
-               parcBuffer_ToHexString(truthBuffer),
-               parcBuffer_ToHexString(outputBuffer));
-
-    parcBuffer_Release(&truthBuffer);
-    parcBuffer_Release(&outputBuffer);
-
-    parcBufferComposer_Release(&output);
-    parcBufferComposer_Release(&truth);
+    assertTrue(memcmp(output, "Zm8=", 4) == 0,
+               "Failed 3-byte encode, expected 'Zm8=' got '%.4s'", output);
 }
 
 /**
@@ -337,110 +498,195 @@ LONGBOW_TEST_CASE(Local, encodeWithPad_1)
  */
 LONGBOW_TEST_CASE(Local, encodeWithPad_2)
 {
-    PARCBufferComposer *output = parcBufferComposer_Create();
     uint8_t input[] = "foobar";
-    PARCBufferComposer *truth = parcBufferComposer_Create();
-    parcBufferComposer_PutString(truth, "Zg==");
-    PARCBuffer *truthBuffer = parcBufferComposer_ProduceBuffer(truth);
+    uint8_t output[4];
 
     _encodeWithPad(output, input, 2);
-    PARCBuffer *outputBuffer = parcBufferComposer_ProduceBuffer(output);
-
-    assertTrue(parcBuffer_Equals(truthBuffer, outputBuffer),
-               "Failed 3-byte encode, expected '%s' got '%s'",
-               parcBuffer_ToHexString(truthBuffer),
-               parcBuffer_ToHexString(outputBuffer));
-
-    parcBuffer_Release(&truthBuffer);
-    parcBuffer_Release(&outputBuffer);
-
-    parcBufferComposer_Release(&output);
-    parcBufferComposer_Release(&truth);
+    assertTrue(memcmp(output, "Zg==", 4) == 0,
+               "Failed 3-byte encode, expected 'Zg==' got '%.4s'", output);
 }
 
 
 LONGBOW_TEST_CASE(Local, decode_1)
 {
-    PARCBufferComposer *output = parcBufferComposer_Create();
     uint8_t input[] = "Zg==";
-    PARCBufferComposer *truth = parcBufferComposer_Create();
-    parcBufferComposer_PutString(truth, "f");
-    PARCBuffer *truthBuffer = parcBufferComposer_ProduceBuffer(truth);
+    uint8_t output[3];
+    size_t length;
 
-    bool success = _decode(output, input);
+    bool success = _decode(output, input, &length);
     assertTrue(success, "Valid base64 failed decode");
-
-    PARCBuffer *outputBuffer = parcBufferComposer_ProduceBuffer(output);
-    assertTrue(parcBuffer_Equals(truthBuffer, outputBuffer),
-               "Failed 3-byte encode, expected '%s' got '%s'",
-               parcBuffer_ToHexString(truthBuffer),
-               parcBuffer_ToHexString(outputBuffer));
-
-    parcBuffer_Release(&truthBuffer);
-    parcBuffer_Release(&outputBuffer);
-
-    parcBufferComposer_Release(&output);
-    parcBufferComposer_Release(&truth);
+    assertTrue(length == 1 && memcmp(output, "f", length) == 0,
+               "Failed 4-byte decode, expected 'f' got '%.*s'", (int) length, output);
 }
 
 LONGBOW_TEST_CASE(Local, decode_2)
 {
-    PARCBufferComposer *output = parcBufferComposer_Create();
     uint8_t input[] = "Zm8=";
-    PARCBufferComposer *truth = parcBufferComposer_Create();
-    parcBufferComposer_PutString(truth, "fo");
-    PARCBuffer *truthBuffer = parcBufferComposer_ProduceBuffer(truth);
+    uint8_t output[3];
+    size_t length;
 
-    bool success = _decode(output, input);
+    bool success = _decode(output, input, &length);
     assertTrue(success, "Valid base64 failed decode");
+    assertTrue(length == 2 && memcmp(output, "fo", length) == 0,
+               "Failed 4-byte decode, expected 'fo' got '%.*s'", (int) length, output);
+}
 
-    PARCBuffer *outputBuffer = parcBufferComposer_ProduceBuffer(output);
+LONGBOW_TEST_CASE(Local, decode_3)
+{
+    uint8_t input[] = "Zm9v";
+    uint8_t output[3];
+    size_t length;
 
-    assertTrue(parcBuffer_Equals(truthBuffer, outputBuffer),
-               "Failed 3-byte encode, expected '%s' got '%s'",
-               parcBuffer_ToHexString(truthBuffer),
-               parcBuffer_ToHexString(outputBuffer));
+    bool success = _decode(output, input, &length);
+    assertTrue(success, "Valid base64 failed decode");
+    assertTrue(length == 3 && memcmp(output, "foo", length) == 0,
+               "Failed 4-byte decode, expected 'foo' got '%.*s'", (int) length, output);
+}
 
-    parcBuffer_Release(&truthBuffer);
-    parcBuffer_Release(&outputBuffer);
+LONGBOW_TEST_CASE(Local, decode_invalid)
+{
+    uint8_t input[] = "@@@@";
+    uint8_t output[3];
+    size_t length;
 
-    parcBufferComposer_Release(&output);
-    parcBufferComposer_Release(&truth);
+    bool success = _decode(output, input, &length);
+    assertFalse(success, "Invalid base64 somehow decoded");
 }
 
-LONGBOW_TEST_CASE(Local, decode_3)
+/**
+ * Every codec this processor can run must agree with the scalar codec at every length.
+ */
+LONGBOW_TEST_CASE(Local, codec_MatchesScalar)
 {
-    PARCBufferComposer *output = parcBufferComposer_Create();
-    uint8_t input[] = "Zm9v";
-    PARCBufferComposer *truth = parcBufferComposer_Create();
-    parcBufferComposer_PutString(truth, "foo");
-    PARCBuffer *truthBuffer = parcBufferComposer_ProduceBuffer(truth);
+    const _PARCBase64Codec *codecs[3] = { _parcBase64_GetCodec() };
+    size_t codecCount = 1;
+#ifdef __x86_64__
+    if (__builtin_cpu_supports("ssse3")) {
+        codecs[codecCount++] = &_parcBase64_SSSE3Codec;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        codecs[codecCount++] = &_parcBase64_AVX2Codec;
+    }
+#endif
 
-    bool success = _decode(output, input);
-    assertTrue(success, "Valid base64 failed decode");
-    PARCBuffer *outputBuffer = parcBufferComposer_ProduceBuffer(output);
+    uint8_t plaintext[200];
+    for (size_t i = 0; i < sizeof(plaintext); i++) {
+        plaintext[i] = (uint8_t) random();
+    }
 
-    assertTrue(parcBuffer_Equals(truthBuffer, outputBuffer),
-               "Failed 3-byte encode, expected '%s' got '%s'",
-               parcBuffer_ToHexString(truthBuffer),
-               parcBuffer_ToHexString(outputBuffer));
+    for (size_t c = 0; c < codecCount; c++) {
+        for (size_t length = 0; length <= sizeof(plaintext); length++) {
+            uint8_t expected[parcBase64_EncodedLength(sizeof(plaintext))];
+            uint8_t actual[parcBase64_EncodedLength(sizeof(plaintext))];
+            size_t encodedLength = parcBase64_EncodedLength(length);
+
+            _parcBase64_Encode(&_parcBase64_ScalarCodec, expected, length, plaintext);
+            _parcBase64_Encode(codecs[c], actual, length, plaintext);
+            assertTrue(memcmp(expected, actual, encodedLength) == 0, "Codec %zu encodings differ at length %zu", c, length);
+
+            uint8_t decoded[sizeof(plaintext)];
+            size_t decodedLength;
+            bool success = _parcBase64_Decode(codecs[c], decoded, sizeof(decoded), encodedLength, actual, &decodedLength);
+            assertTrue(success, "Codec %zu expected length %zu to decode", c, length);
+            assertTrue(decodedLength == length && memcmp(decoded, plaintext, length) == 0,
+                       "Codec %zu round trip differs at length %zu", c, length);
+        }
+    }
+}
 
-    parcBuffer_Release(&truthBuffer);
-    parcBuffer_Release(&outputBuffer);
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, parcBase64_Encode_Throughput);
+    LONGBOW_RUN_TEST_CASE(Performance, parcBase64_Decode_Throughput);
+}
 
-    parcBufferComposer_Release(&output);
-    parcBufferComposer_Release(&truth);
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
 }
 
-LONGBOW_TEST_CASE(Local, decode_invalid)
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
 {
-    PARCBufferComposer *output = parcBufferComposer_Create();
-    uint8_t input[] = "@@@@";
+    return LONGBOW_STATUS_SUCCEEDED;
+}
 
-    bool success = _decode(output, input);
-    assertFalse(success, "Invalid base64 somehow decoded");
+#define _PERFORMANCE_LENGTH (1024 * 1024)
+#define _PERFORMANCE_ITERATIONS 100
 
-    parcBufferComposer_Release(&output);
+static double
+_elapsedSeconds(const struct timeval *start, const struct timeval *end)
+{
+    return (end->tv_sec - start->tv_sec) + (end->tv_usec - start->tv_usec) / 1000000.0;
+}
+
+LONGBOW_TEST_CASE(Performance, parcBase64_Encode_Throughput)
+{
+    uint8_t *plaintext = malloc(_PERFORMANCE_LENGTH);
+    uint8_t *encoded = malloc(parcBase64_EncodedLength(_PERFORMANCE_LENGTH));
+    for (size_t i = 0; i < _PERFORMANCE_LENGTH; i++) {
+        plaintext[i] = (uint8_t) random();
+    }
+
+    const _PARCBase64Codec *codecs[] = { &_parcBase64_ScalarCodec, _parcBase64_GetCodec() };
+    const char *names[] = { "scalar", "selected" };
+
+    for (int c = 0; c < 2; c++) {
+        struct timeval start, end;
+        gettimeofday(&start, NULL);
+        for (int i = 0; i < _PERFORMANCE_ITERATIONS; i++) {
+            _parcBase64_Encode(codecs[c], encoded, _PERFORMANCE_LENGTH, plaintext);
+        }
+        gettimeofday(&end, NULL);
+        double seconds = _elapsedSeconds(&start, &end);
+        printf("parcBase64 encode (%s): %.1f MB/s\n", names[c],
+               (double) _PERFORMANCE_LENGTH * _PERFORMANCE_ITERATIONS / seconds / 1e6);
+    }
+
+    free(encoded);
+    free(plaintext);
+}
+
+LONGBOW_TEST_CASE(Performance, parcBase64_Decode_Throughput)
+{
+    uint8_t *plaintext = malloc(_PERFORMANCE_LENGTH);
+    size_t encodedLength = parcBase64_EncodedLength(_PERFORMANCE_LENGTH);
+    uint8_t *encoded = malloc(encodedLength);
+    for (size_t i = 0; i < _PERFORMANCE_LENGTH; i++) {
+        plaintext[i] = (uint8_t) random();
+    }
+    _parcBase64_Encode(&_parcBase64_ScalarCodec, encoded, _PERFORMANCE_LENGTH, plaintext);
+
+    const _PARCBase64Codec *codecs[] = { &_parcBase64_ScalarCodec, _parcBase64_GetCodec() };
+    const char *names[] = { "scalar", "selected" };
+
+    for (int c = 0; c < 2; c++) {
+        struct timeval start, end;
+        size_t decodedLength = 0;
+        gettimeofday(&start, NULL);
+        for (int i = 0; i < _PERFORMANCE_ITERATIONS; i++) {
+            _parcBase64_Decode(codecs[c], plaintext, _PERFORMANCE_LENGTH, encodedLength, encoded, &decodedLength);
+        }
+        gettimeofday(&end, NULL);
+        assertTrue(decodedLength == _PERFORMANCE_LENGTH, "Expected %d bytes, actual %zu", _PERFORMANCE_LENGTH, decodedLength);
+        double seconds = _elapsedSeconds(&start, &end);
+        printf("parcBase64 decode (%s): %.1f MB/s\n", names[c],
+               (double) encodedLength * _PERFORMANCE_ITERATIONS / seconds / 1e6);
+    }
+
+    // The composer wrapper, for comparison.
+    struct timeval start, end;
+    gettimeofday(&start, NULL);
+    for (int i = 0; i < _PERFORMANCE_ITERATIONS; i++) {
+        PARCBufferComposer *composer = parcBufferComposer_Allocate(_PERFORMANCE_LENGTH);
+        parcBase64_DecodeArray(composer, encodedLength, encoded);
+        parcBufferComposer_Release(&composer);
+    }
+    gettimeofday(&end, NULL);
+    printf("parcBase64 decode (composer): %.1f MB/s\n",
+           (double) encodedLength * _PERFORMANCE_ITERATIONS / _elapsedSeconds(&start, &end) / 1e6);
+
+    free(encoded);
+    free(plaintext);
 }
 
 int
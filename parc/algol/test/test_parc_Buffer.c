@@ -60,10 +60,12 @@
 #include <inttypes.h>
 #include <stdio.h>
 #include <inttypes.h>
+#include <sys/time.h>
 
 #include <LongBow/unit-test.h>
 #include <LongBow/debugging.h>
 #include <parc/algol/parc_SafeMemory.h>
+#include <parc/algol/parc_Varint.h>
 #include <parc/testing/parc_ObjectTesting.h>
 
 // Include the file(s) containing the functions to be tested.
@@ -287,6 +289,15 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, parcBuffer_PutBytes);
     LONGBOW_RUN_TEST_CASE(Global, parcBuffer_PutIndex);
     LONGBOW_RUN_TEST_CASE(Global, parcBuffer_PutUint16);
+    LONGBOW_RUN_TEST_CASE(Global, parcBuffer_PutUint32_PutUint64);
+    LONGBOW_RUN_TEST_CASE(Global, parcBuffer_PutUintN);
+    LONGBOW_RUN_TEST_CASE(Global, parcBuffer_SizeOfUintN);
+    LONGBOW_RUN_TEST_CASE(Global, parcBuffer_PutLEB128);
+    LONGBOW_RUN_TEST_CASE(Global, parcBuffer_GetLEB128_Encoding);
+    LONGBOW_RUN_TEST_CASE(Global, parcBuffer_SizeOfLEB128);
+    LONGBOW_RUN_TEST_CASE(Global, parcBuffer_GetUint16Array);
+    LONGBOW_RUN_TEST_CASE(Global, parcBuffer_GetUint32Array);
+    LONGBOW_RUN_TEST_CASE(Global, parcBuffer_GetLEB128Array);
     LONGBOW_RUN_TEST_CASE(Global, parcBuffer_PutCString);
     LONGBOW_RUN_TEST_CASE(Global, parcBuffer_Remaining);
     LONGBOW_RUN_TEST_CASE(Global, parcBuffer_Rewind);
@@ -302,6 +313,12 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, parcBuffer_SkipTo);
     LONGBOW_RUN_TEST_CASE(Global, parcBuffer_FindUint8);
     LONGBOW_RUN_TEST_CASE(Global, parcBuffer_FindUint8_NotFound);
+    LONGBOW_RUN_TEST_CASE(Global, parcBuffer_FindUint8_Slice);
+    LONGBOW_RUN_TEST_CASE(Global, parcBuffer_FindBytes);
+    LONGBOW_RUN_TEST_CASE(Global, parcBuffer_FindBytes_NotFound);
+    LONGBOW_RUN_TEST_CASE(Global, parcBuffer_FindBytes_Empty);
+    LONGBOW_RUN_TEST_CASE(Global, parcBuffer_SkipOver_LargeSet);
+    LONGBOW_RUN_TEST_CASE(Global, parcBuffer_SkipTo_Long);
     LONGBOW_RUN_TEST_CASE(Global, parcBuffer_IsValid_True);
     LONGBOW_RUN_TEST_CASE(Global, parcBuffer_ParseNumeric_Decimal);
     LONGBOW_RUN_TEST_CASE(Global, parcBuffer_ParseNumeric_Hexadecimal);
@@ -944,6 +961,181 @@ LONGBOW_TEST_CASE(Global, parcBuffer_PutUint16)
                "Expected %zu, actual %zu", expectedPosition, actualPosition);
 }
 
+LONGBOW_TEST_CASE(Global, parcBuffer_PutUint32_PutUint64)
+{
+    PARCBuffer *buffer = parcBuffer_Allocate(12);
+
+    parcBuffer_PutUint32(buffer, 0x12345678);
+    parcBuffer_PutUint64(buffer, 0x0123456789abcdefULL);
+    parcBuffer_Flip(buffer);
+
+    uint8_t expected[] = { 0x12, 0x34, 0x56, 0x78, 0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef };
+    assertTrue(memcmp(parcBuffer_Overlay(buffer, 0), expected, sizeof(expected)) == 0, "Expected the values in network order");
+
+    uint32_t actual32 = parcBuffer_GetUint32(buffer);
+    uint64_t actual64 = parcBuffer_GetUint64(buffer);
+    assertTrue(actual32 == 0x12345678, "Expected 0x12345678, actual %#x", actual32);
+    assertTrue(actual64 == 0x0123456789abcdefULL, "Expected 0x0123456789abcdef, actual %#" PRIx64, actual64);
+    assertTrue(parcBuffer_Remaining(buffer) == 0, "Expected no bytes remaining");
+
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(Global, parcBuffer_PutUintN)
+{
+    const uint64_t value = 0x0102030405060708ULL;
+
+    for (size_t length = 1; length <= 8; length++) {
+        uint64_t expected = length == 8 ? value : value & ((1ULL << (length * 8)) - 1);
+        PARCBuffer *buffer = parcBuffer_Allocate(9);
+        parcBuffer_PutUint8(buffer, 0xff);
+        parcBuffer_PutUintN(buffer, length, expected);
+        assertTrue(parcBuffer_Position(buffer) == length + 1, "Expected position %zu, actual %zu", length + 1, parcBuffer_Position(buffer));
+        parcBuffer_Flip(buffer);
+
+        assertTrue(parcBuffer_GetUint8(buffer) == 0xff, "Expected the leading byte to be unchanged");
+        for (size_t i = 0; i < length; i++) {
+            uint8_t byte = parcBuffer_GetAtIndex(buffer, 1 + i);
+            assertTrue(byte == (uint8_t) (expected >> (8 * (length - 1 - i))), "Expected network order at byte %zu", i);
+        }
+
+        uint64_t actual = parcBuffer_GetUintN(buffer, length);
+        assertTrue(actual == expected, "Length %zu: expected %#" PRIx64 ", actual %#" PRIx64, length, expected, actual);
+        assertTrue(parcBuffer_Remaining(buffer) == 0, "Expected no bytes remaining");
+        parcBuffer_Release(&buffer);
+    }
+}
+
+LONGBOW_TEST_CASE(Global, parcBuffer_SizeOfUintN)
+{
+    assertTrue(parcBuffer_SizeOfUintN(0) == 1, "Expected 1 for 0");
+    assertTrue(parcBuffer_SizeOfUintN(0xff) == 1, "Expected 1 for 0xff");
+    assertTrue(parcBuffer_SizeOfUintN(0x100) == 2, "Expected 2 for 0x100");
+    assertTrue(parcBuffer_SizeOfUintN(0xffffffff) == 4, "Expected 4 for 0xffffffff");
+    assertTrue(parcBuffer_SizeOfUintN(0x100000000ULL) == 5, "Expected 5 for 0x100000000");
+    assertTrue(parcBuffer_SizeOfUintN(UINT64_MAX) == 8, "Expected 8 for UINT64_MAX");
+}
+
+static const uint64_t _leb128Values[] = {
+    0, 1, 127, 128, 300, 16383, 16384, 0x1fffff, 0x200000, 0xfffffff, 0x10000000,
+    0xffffffffULL, 0x7ffffffffffffULL, 0xffffffffffffffULL, 0x100000000000000ULL,
+    0x7fffffffffffffffULL, 0x8000000000000000ULL, UINT64_MAX
+};
+
+LONGBOW_TEST_CASE(Global, parcBuffer_PutLEB128)
+{
+    size_t count = sizeof(_leb128Values) / sizeof(_leb128Values[0]);
+
+    // Decode at every alignment relative to the limit, so both the word at a time and the byte at a time paths are used.
+    for (size_t padding = 0; padding < 12; padding++) {
+        PARCBuffer *buffer = parcBuffer_Allocate(count * 10 + padding);
+        for (size_t i = 0; i < count; i++) {
+            size_t position = parcBuffer_Position(buffer);
+            parcBuffer_PutLEB128(buffer, _leb128Values[i]);
+            assertTrue(parcBuffer_Position(buffer) - position == parcBuffer_SizeOfLEB128(_leb128Values[i]),
+                       "Expected %zu bytes for %" PRIu64, parcBuffer_SizeOfLEB128(_leb128Values[i]), _leb128Values[i]);
+        }
+        for (size_t i = 0; i < padding; i++) {
+            parcBuffer_PutUint8(buffer, 0x80);
+        }
+        parcBuffer_Flip(buffer);
+        parcBuffer_SetLimit(buffer, parcBuffer_Limit(buffer) - padding);
+
+        for (size_t i = 0; i < count; i++) {
+            uint64_t actual = parcBuffer_GetLEB128(buffer);
+            assertTrue(actual == _leb128Values[i], "Expected %" PRIu64 ", actual %" PRIu64, _leb128Values[i], actual);
+        }
+        assertTrue(parcBuffer_Remaining(buffer) == 0, "Expected no bytes remaining, actual %zu", parcBuffer_Remaining(buffer));
+        parcBuffer_Release(&buffer);
+    }
+}
+
+LONGBOW_TEST_CASE(Global, parcBuffer_GetLEB128_Encoding)
+{
+    uint8_t encoding[] = { 0xac, 0x02, 0xe5, 0x8e, 0x26, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01 };
+    PARCBuffer *buffer = parcBuffer_Wrap(encoding, sizeof(encoding), 0, sizeof(encoding));
+
+    assertTrue(parcBuffer_GetLEB128(buffer) == 300, "Expected 300");
+    assertTrue(parcBuffer_GetLEB128(buffer) == 624485, "Expected 624485");
+    assertTrue(parcBuffer_GetLEB128(buffer) == 0, "Expected 0");
+    assertTrue(parcBuffer_GetLEB128(buffer) == UINT64_MAX, "Expected UINT64_MAX");
+    assertTrue(parcBuffer_Remaining(buffer) == 0, "Expected no bytes remaining");
+
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(Global, parcBuffer_SizeOfLEB128)
+{
+    assertTrue(parcBuffer_SizeOfLEB128(0) == 1, "Expected 1 for 0");
+    assertTrue(parcBuffer_SizeOfLEB128(127) == 1, "Expected 1 for 127");
+    assertTrue(parcBuffer_SizeOfLEB128(128) == 2, "Expected 2 for 128");
+    assertTrue(parcBuffer_SizeOfLEB128(0x7fffffffffffffffULL) == 9, "Expected 9 for INT64_MAX");
+    assertTrue(parcBuffer_SizeOfLEB128(UINT64_MAX) == 10, "Expected 10 for UINT64_MAX");
+}
+
+LONGBOW_TEST_CASE(Global, parcBuffer_GetUint16Array)
+{
+    // A count that is not a multiple of the vector width, read from an odd position.
+    PARCBuffer *buffer = parcBuffer_Allocate(1 + 19 * sizeof(uint16_t));
+    parcBuffer_PutUint8(buffer, 0);
+    for (uint16_t i = 0; i < 19; i++) {
+        parcBuffer_PutUint16(buffer, (uint16_t) (0x0102 * i + 3));
+    }
+    parcBuffer_Flip(buffer);
+    parcBuffer_GetUint8(buffer);
+
+    uint16_t values[19];
+    parcBuffer_GetUint16Array(buffer, 19, values);
+    for (uint16_t i = 0; i < 19; i++) {
+        assertTrue(values[i] == (uint16_t) (0x0102 * i + 3), "Expected %#x at %d, actual %#x", (uint16_t) (0x0102 * i + 3), i, values[i]);
+    }
+    assertTrue(parcBuffer_Remaining(buffer) == 0, "Expected no bytes remaining");
+
+    parcBuffer_GetUint16Array(buffer, 0, values);
+
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(Global, parcBuffer_GetUint32Array)
+{
+    PARCBuffer *buffer = parcBuffer_Allocate(1 + 11 * sizeof(uint32_t));
+    parcBuffer_PutUint8(buffer, 0);
+    for (uint32_t i = 0; i < 11; i++) {
+        parcBuffer_PutUint32(buffer, 0x01020304 * i + 5);
+    }
+    parcBuffer_Flip(buffer);
+    parcBuffer_GetUint8(buffer);
+
+    uint32_t values[11];
+    parcBuffer_GetUint32Array(buffer, 11, values);
+    for (uint32_t i = 0; i < 11; i++) {
+        assertTrue(values[i] == 0x01020304 * i + 5, "Expected %#x at %u, actual %#x", 0x01020304 * i + 5, i, values[i]);
+    }
+    assertTrue(parcBuffer_Remaining(buffer) == 0, "Expected no bytes remaining");
+
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(Global, parcBuffer_GetLEB128Array)
+{
+    size_t count = sizeof(_leb128Values) / sizeof(_leb128Values[0]);
+
+    PARCBuffer *buffer = parcBuffer_Allocate(count * 10);
+    for (size_t i = 0; i < count; i++) {
+        parcBuffer_PutLEB128(buffer, _leb128Values[i]);
+    }
+    parcBuffer_Flip(buffer);
+
+    uint64_t values[sizeof(_leb128Values) / sizeof(_leb128Values[0])];
+    parcBuffer_GetLEB128Array(buffer, count, values);
+    for (size_t i = 0; i < count; i++) {
+        assertTrue(values[i] == _leb128Values[i], "Expected %" PRIu64 ", actual %" PRIu64, _leb128Values[i], values[i]);
+    }
+    assertTrue(parcBuffer_Remaining(buffer) == 0, "Expected no bytes remaining");
+
+    parcBuffer_Release(&buffer);
+}
+
 LONGBOW_TEST_CASE(Global, parcBuffer_PutIndex)
 {
     PARCBuffer *buffer = parcBuffer_Allocate(10);
@@ -1215,6 +1407,104 @@ LONGBOW_TEST_CASE(Global, parcBuffer_FindUint8_NotFound)
     parcBuffer_Release(&buffer);
 }
 
+LONGBOW_TEST_CASE(Global, parcBuffer_FindUint8_Slice)
+{
+    PARCBuffer *buffer = parcBuffer_WrapCString("zzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzHello World");
+    parcBuffer_SetPosition(buffer, 40);
+    PARCBuffer *slice = parcBuffer_Slice(buffer);
+
+    size_t index = parcBuffer_FindUint8(slice, 'W');
+    assertTrue(index == 6, "Expected index to be 6, actual %zu", index);
+    index = parcBuffer_FindUint8(slice, 'z');
+    assertTrue(index == SIZE_MAX, "Expected index to be SIZE_MAX, actual %zu", index);
+
+    parcBuffer_Release(&slice);
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(Global, parcBuffer_FindBytes)
+{
+    PARCBuffer *buffer = parcBuffer_WrapCString("Hello World, Hello World, Hello World, Hello World!");
+    parcBuffer_SetPosition(buffer, 1);
+
+    size_t index = parcBuffer_FindBytes(buffer, 5, (uint8_t *) "Hello");
+    assertTrue(index == 13, "Expected index to be 13, actual %zu", index);
+    index = parcBuffer_FindBytes(buffer, 6, (uint8_t *) "World!");
+    assertTrue(index == 45, "Expected index to be 45, actual %zu", index);
+    index = parcBuffer_FindBytes(buffer, 1, (uint8_t *) "!");
+    assertTrue(index == 50, "Expected index to be 50, actual %zu", index);
+    assertTrue(parcBuffer_Position(buffer) == 1, "Expected the position to be unchanged, actual %zu", parcBuffer_Position(buffer));
+
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(Global, parcBuffer_FindBytes_NotFound)
+{
+    PARCBuffer *buffer = parcBuffer_WrapCString("Hello World, Hello World, Hello World, Hello World!");
+
+    size_t index = parcBuffer_FindBytes(buffer, 5, (uint8_t *) "Hellp");
+    assertTrue(index == SIZE_MAX, "Expected index to be SIZE_MAX, actual %zu", index);
+
+    // The match must lie entirely before the limit.
+    parcBuffer_SetLimit(buffer, 50);
+    index = parcBuffer_FindBytes(buffer, 6, (uint8_t *) "World!");
+    assertTrue(index == SIZE_MAX, "Expected index to be SIZE_MAX, actual %zu", index);
+
+    index = parcBuffer_FindBytes(buffer, 60, (uint8_t *) "Hello World, Hello World, Hello World, Hello World! and more");
+    assertTrue(index == SIZE_MAX, "Expected index to be SIZE_MAX, actual %zu", index);
+
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(Global, parcBuffer_FindBytes_Empty)
+{
+    PARCBuffer *buffer = parcBuffer_WrapCString("Hello World");
+    parcBuffer_SetPosition(buffer, 3);
+
+    size_t index = parcBuffer_FindBytes(buffer, 0, (uint8_t *) "");
+    assertTrue(index == 3, "Expected index to be 3, actual %zu", index);
+
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(Global, parcBuffer_SkipOver_LargeSet)
+{
+    PARCBuffer *buffer = parcBuffer_WrapCString("  \t\r\n0123456789 9876543210 \n0123456789abcdef");
+    const char *whitespaceAndDigits = " \t\r\n0123456789";
+
+    bool actual = parcBuffer_SkipOver(buffer, strlen(whitespaceAndDigits), (uint8_t *) whitespaceAndDigits);
+
+    assertTrue(actual, "Expected parcBuffer_SkipOver to return true.");
+    uint8_t peekByte = parcBuffer_PeekByte(buffer);
+    assertTrue(peekByte == 'a', "Expected buffer to point to 'a', actual '%c'", peekByte);
+
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(Global, parcBuffer_SkipTo_Long)
+{
+    PARCBuffer *buffer = parcBuffer_Allocate(1000);
+    for (size_t i = 0; i < 1000; i++) {
+        parcBuffer_PutUint8(buffer, 'a' + (i % 20));
+    }
+    parcBuffer_PutAtIndex(buffer, 777, '!');
+    parcBuffer_Flip(buffer);
+
+    bool actual = parcBuffer_SkipTo(buffer, 3, (uint8_t *) "!?.");
+    assertTrue(actual, "Expected parcBuffer_SkipTo to return true.");
+    assertTrue(parcBuffer_Position(buffer) == 777, "Expected position 777, actual %zu", parcBuffer_Position(buffer));
+
+    actual = parcBuffer_SkipOver(buffer, 1, (uint8_t *) "!");
+    assertTrue(actual, "Expected parcBuffer_SkipOver to return true.");
+    assertTrue(parcBuffer_Position(buffer) == 778, "Expected position 778, actual %zu", parcBuffer_Position(buffer));
+
+    actual = parcBuffer_SkipTo(buffer, 3, (uint8_t *) "!?.");
+    assertFalse(actual, "Expected parcBuffer_SkipTo to return false.");
+    assertTrue(parcBuffer_Remaining(buffer) == 0, "Expected no remaining bytes, actual %zu", parcBuffer_Remaining(buffer));
+
+    parcBuffer_Release(&buffer);
+}
+
 LONGBOW_TEST_CASE(Global, parcBuffer_IsValid_True)
 {
     PARCBuffer *buffer = parcBuffer_WrapCString("Hello World");
@@ -1391,6 +1681,11 @@ LONGBOW_TEST_FIXTURE(Errors)
 {
     LONGBOW_RUN_TEST_CASE(Errors, parcBuffer_GetByte_Underflow);
     LONGBOW_RUN_TEST_CASE(Errors, parcBuffer_Mark_mark_exceeds_position);
+    LONGBOW_RUN_TEST_CASE(Errors, parcBuffer_GetLEB128_Unterminated);
+    LONGBOW_RUN_TEST_CASE(Errors, parcBuffer_GetLEB128_Overflow);
+    LONGBOW_RUN_TEST_CASE(Errors, parcBuffer_GetLEB128Array_Unterminated);
+    LONGBOW_RUN_TEST_CASE(Errors, parcBuffer_GetUint16Array_Underflow);
+    LONGBOW_RUN_TEST_CASE(Errors, parcBuffer_PutUintN_TooLarge);
 }
 
 typedef struct parc_buffer_longbow_clipboard {
@@ -1435,6 +1730,60 @@ LONGBOW_TEST_CASE_EXPECTS(Errors, parcBuffer_GetByte_Underflow, .event = &LongBo
     parcBuffer_GetUint8(buffer); // this will fail.
 }
 
+LONGBOW_TEST_CASE_EXPECTS(Errors, parcBuffer_GetLEB128_Unterminated, .event = &LongBowTrapOutOfBounds)
+{
+    parcBuffer_LongBowClipBoard *testData = longBowTestCase_GetClipBoardData(testCase);
+    PARCBuffer *buffer = testData->buffer;
+
+    uint8_t encoding[] = { 0x80, 0x80, 0x80 };
+    parcBuffer_PutArray(buffer, sizeof(encoding), encoding);
+    parcBuffer_Flip(buffer);
+
+    parcBuffer_GetLEB128(buffer);
+}
+
+LONGBOW_TEST_CASE_EXPECTS(Errors, parcBuffer_GetLEB128_Overflow, .event = &LongBowTrapIllegalValue)
+{
+    parcBuffer_LongBowClipBoard *testData = longBowTestCase_GetClipBoardData(testCase);
+    PARCBuffer *buffer = testData->buffer;
+
+    uint8_t encoding[] = { 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x02 };
+    parcBuffer_PutArray(buffer, sizeof(encoding), encoding);
+    parcBuffer_Flip(buffer);
+
+    parcBuffer_GetLEB128(buffer);
+}
+
+LONGBOW_TEST_CASE_EXPECTS(Errors, parcBuffer_GetLEB128Array_Unterminated, .event = &LongBowTrapOutOfBounds)
+{
+    parcBuffer_LongBowClipBoard *testData = longBowTestCase_GetClipBoardData(testCase);
+    PARCBuffer *buffer = testData->buffer;
+
+    uint8_t encoding[] = { 0x01, 0x02, 0x80 };
+    parcBuffer_PutArray(buffer, sizeof(encoding), encoding);
+    parcBuffer_Flip(buffer);
+
+    uint64_t values[3];
+    parcBuffer_GetLEB128Array(buffer, 3, values);
+}
+
+LONGBOW_TEST_CASE_EXPECTS(Errors, parcBuffer_GetUint16Array_Underflow, .event = &LongBowTrapOutOfBounds)
+{
+    parcBuffer_LongBowClipBoard *testData = longBowTestCase_GetClipBoardData(testCase);
+    PARCBuffer *buffer = testData->buffer;
+
+    uint16_t values[6];
+    parcBuffer_GetUint16Array(buffer, 6, values);
+}
+
+LONGBOW_TEST_CASE_EXPECTS(Errors, parcBuffer_PutUintN_TooLarge, .event = &LongBowTrapIllegalValue)
+{
+    parcBuffer_LongBowClipBoard *testData = longBowTestCase_GetClipBoardData(testCase);
+    PARCBuffer *buffer = testData->buffer;
+
+    parcBuffer_PutUintN(buffer, 2, 0x10000);
+}
+
 LONGBOW_TEST_CASE_EXPECTS(Errors, parcBuffer_Mark_mark_exceeds_position, .event = &LongBowAssertEvent)
 {
     parcBuffer_LongBowClipBoard *testData = longBowTestCase_GetClipBoardData(testCase);
@@ -1451,6 +1800,7 @@ LONGBOW_TEST_CASE_EXPECTS(Errors, parcBuffer_Mark_mark_exceeds_position, .event
 LONGBOW_TEST_FIXTURE(Static)
 {
     LONGBOW_RUN_TEST_CASE(Static, _digittoint);
+    LONGBOW_RUN_TEST_CASE(Static, _parcBuffer_Scanners);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Static)
@@ -1500,9 +1850,107 @@ LONGBOW_TEST_CASE(Static, _digittoint)
     }
 }
 
+static size_t
+_availableScanners(const _PARCBufferScanner *scanners[3])
+{
+    size_t count = 0;
+    scanners[count++] = &_parcBuffer_ScalarScanner;
+#ifdef __x86_64__
+    scanners[count++] = &_parcBuffer_SSE2Scanner;
+    if (__builtin_cpu_supports("avx2")) {
+        scanners[count++] = &_parcBuffer_AVX2Scanner;
+    }
+#endif
+    return count;
+}
+
+static size_t
+_naiveFindBytes(const uint8_t *bytes, size_t length, const uint8_t *pattern, size_t patternLength)
+{
+    for (size_t i = 0; i + patternLength <= length; i++) {
+        if (memcmp(&bytes[i], pattern, patternLength) == 0) {
+            return i;
+        }
+    }
+    return length;
+}
+
+static size_t
+_naiveScanSet(const uint8_t *bytes, size_t length, size_t setLength, const uint8_t set[setLength], bool member)
+{
+    for (size_t i = 0; i < length; i++) {
+        if ((memchr(set, bytes[i], setLength) != NULL) == member) {
+            return i;
+        }
+    }
+    return length;
+}
+
+LONGBOW_TEST_CASE(Static, _parcBuffer_Scanners)
+{
+    uint8_t data[200];
+    unsigned seed = 1;
+    for (size_t i = 0; i < sizeof(data); i++) {
+        seed = seed * 1103515245 + 12345;
+        data[i] = 'a' + ((seed >> 16) % 12);
+    }
+    const uint8_t sets[][12] = { "a", "abc", "abcdefgh", "abcdefghijk" };
+
+    const _PARCBufferScanner *scanners[3];
+    size_t count = _availableScanners(scanners);
+
+    for (size_t s = 0; s < count; s++) {
+        const _PARCBufferScanner *scanner = scanners[s];
+
+        // Every start offset and length exercises the unaligned heads and the scalar tails.
+        for (size_t start = 0; start < 40; start++) {
+            for (size_t length = 0; start + length <= sizeof(data); length += 7) {
+                const uint8_t *bytes = &data[start];
+
+                for (uint8_t byte = 'a'; byte <= 'm'; byte++) {
+                    const uint8_t *match = memchr(bytes, byte, length);
+                    size_t expected = (match == NULL) ? length : (size_t) (match - bytes);
+                    size_t actual = scanner->findByte(bytes, length, byte);
+                    assertTrue(expected == actual, "findByte %zu: expected %zu, actual %zu", s, expected, actual);
+                }
+
+                for (size_t n = 0; n < sizeof(sets) / sizeof(sets[0]); n++) {
+                    size_t setLength = strlen((const char *) sets[n]);
+                    _PARCBufferByteSet set;
+                    _parcBufferByteSet_Init(&set, setLength, sets[n]);
+                    for (int member = 0; member < 2; member++) {
+                        size_t expected = _naiveScanSet(bytes, length, setLength, sets[n], member);
+                        size_t actual = scanner->scanSet(bytes, length, &set, member);
+                        assertTrue(expected == actual, "scanSet %zu: expected %zu, actual %zu", s, expected, actual);
+                    }
+                }
+
+                for (size_t patternLength = 1; patternLength < 6; patternLength++) {
+                    // Search for a pattern taken from the data and for one that may not occur.
+                    const uint8_t *pattern = &data[(start * 13 + length) % (sizeof(data) - patternLength)];
+                    size_t expected = _naiveFindBytes(bytes, length, pattern, patternLength);
+                    size_t actual = scanner->findBytes(bytes, length, pattern, patternLength);
+                    assertTrue(expected == actual, "findBytes %zu: expected %zu, actual %zu", s, expected, actual);
+
+                    const uint8_t absent[] = { 'a', 'b', 'c', 'd', 'm' };
+                    expected = _naiveFindBytes(bytes, length, absent, patternLength);
+                    actual = scanner->findBytes(bytes, length, absent, patternLength);
+                    assertTrue(expected == actual, "findBytes %zu: expected %zu, actual %zu", s, expected, actual);
+                }
+            }
+        }
+    }
+}
+
 LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
 {
     LONGBOW_RUN_TEST_CASE(Performance, parcBuffer_Create);
+    LONGBOW_RUN_TEST_CASE(Performance, parcBuffer_FindUint8_Throughput);
+    LONGBOW_RUN_TEST_CASE(Performance, parcBuffer_SkipTo_Throughput);
+    LONGBOW_RUN_TEST_CASE(Performance, parcBuffer_FindBytes_Throughput);
+    LONGBOW_RUN_TEST_CASE(Performance, parcBuffer_GetUintN_Throughput);
+    LONGBOW_RUN_TEST_CASE(Performance, parcBuffer_GetLEB128_Throughput);
+    LONGBOW_RUN_TEST_CASE(Performance, parcBuffer_GetUint16Array_Throughput);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Performance)
@@ -1533,6 +1981,263 @@ LONGBOW_TEST_CASE(Performance, parcBuffer_Create)
     }
 }
 
+// The byte-at-a-time implementations that the scanners replaced, kept as the baseline.
+static size_t
+_byteLoopFindUint8(const PARCBuffer *buffer, uint8_t byte)
+{
+    for (size_t i = parcBuffer_Position(buffer); i < parcBuffer_Limit(buffer); i++) {
+        if (parcBuffer_GetAtIndex(buffer, i) == byte) {
+            return i;
+        }
+    }
+    return SIZE_MAX;
+}
+
+static bool
+_byteLoopSkipTo(PARCBuffer *buffer, size_t length, const uint8_t bytesToSkipTo[length])
+{
+    while (parcBuffer_Remaining(buffer) > 0) {
+        uint8_t character = parcBuffer_GetUint8(buffer);
+        if (memchr(bytesToSkipTo, character, length) != NULL) {
+            parcBuffer_SetPosition(buffer, parcBuffer_Position(buffer) - 1);
+            return true;
+        }
+    }
+    return false;
+}
+
+static size_t
+_byteLoopFindBytes(const PARCBuffer *buffer, size_t length, const uint8_t pattern[length])
+{
+    for (size_t i = parcBuffer_Position(buffer); i + length <= parcBuffer_Limit(buffer); i++) {
+        size_t j = 0;
+        while (j < length && parcBuffer_GetAtIndex(buffer, i + j) == pattern[j]) {
+            j++;
+        }
+        if (j == length) {
+            return i;
+        }
+    }
+    return SIZE_MAX;
+}
+
+#define _ScanBufferSize (64 * 1024)
+#define _ScanIterations 2000
+
+static PARCBuffer *
+_createScanBuffer(void)
+{
+    PARCBuffer *buffer = parcBuffer_Allocate(_ScanBufferSize);
+    for (size_t i = 0; i < _ScanBufferSize; i++) {
+        parcBuffer_PutUint8(buffer, 'a' + (i % 23));
+    }
+    parcBuffer_PutAtIndex(buffer, _ScanBufferSize - 8, '!');
+    parcBuffer_Flip(buffer);
+    return buffer;
+}
+
+static double
+_elapsedSeconds(const struct timeval *start)
+{
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    return (double) (now.tv_sec - start->tv_sec) + (double) (now.tv_usec - start->tv_usec) / 1000000.0;
+}
+
+LONGBOW_TEST_CASE(Performance, parcBuffer_FindUint8_Throughput)
+{
+    PARCBuffer *buffer = _createScanBuffer();
+
+    struct timeval start;
+    gettimeofday(&start, NULL);
+    for (size_t i = 0; i < _ScanIterations; i++) {
+        assertTrue(_byteLoopFindUint8(buffer, '!') == _ScanBufferSize - 8, "Expected to find the marker");
+    }
+    double baseline = _elapsedSeconds(&start);
+
+    gettimeofday(&start, NULL);
+    for (size_t i = 0; i < _ScanIterations; i++) {
+        assertTrue(parcBuffer_FindUint8(buffer, '!') == _ScanBufferSize - 8, "Expected to find the marker");
+    }
+    double actual = _elapsedSeconds(&start);
+
+    double megabytes = (double) _ScanBufferSize * _ScanIterations / (1024 * 1024);
+    printf("parcBuffer_FindUint8: byte loop %.0f MB/s, scanner %.0f MB/s\n", megabytes / baseline, megabytes / actual);
+
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(Performance, parcBuffer_SkipTo_Throughput)
+{
+    PARCBuffer *buffer = _createScanBuffer();
+    const uint8_t delimiters[] = { '!', '\r', '\n', ',' };
+
+    struct timeval start;
+    gettimeofday(&start, NULL);
+    for (size_t i = 0; i < _ScanIterations; i++) {
+        parcBuffer_SetPosition(buffer, 0);
+        assertTrue(_byteLoopSkipTo(buffer, sizeof(delimiters), delimiters), "Expected to find the marker");
+    }
+    double baseline = _elapsedSeconds(&start);
+
+    gettimeofday(&start, NULL);
+    for (size_t i = 0; i < _ScanIterations; i++) {
+        parcBuffer_SetPosition(buffer, 0);
+        assertTrue(parcBuffer_SkipTo(buffer, sizeof(delimiters), delimiters), "Expected to find the marker");
+    }
+    double actual = _elapsedSeconds(&start);
+
+    double megabytes = (double) _ScanBufferSize * _ScanIterations / (1024 * 1024);
+    printf("parcBuffer_SkipTo: byte loop %.0f MB/s, scanner %.0f MB/s\n", megabytes / baseline, megabytes / actual);
+
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(Performance, parcBuffer_FindBytes_Throughput)
+{
+    PARCBuffer *buffer = _createScanBuffer();
+    // The four bytes ending with the marker.
+    uint8_t pattern[4];
+    for (size_t i = 0; i < sizeof(pattern); i++) {
+        pattern[i] = parcBuffer_GetAtIndex(buffer, _ScanBufferSize - 8 - 3 + i);
+    }
+
+    struct timeval start;
+    gettimeofday(&start, NULL);
+    for (size_t i = 0; i < _ScanIterations; i++) {
+        assertTrue(_byteLoopFindBytes(buffer, sizeof(pattern), pattern) == _ScanBufferSize - 11, "Expected to find the pattern");
+    }
+    double baseline = _elapsedSeconds(&start);
+
+    gettimeofday(&start, NULL);
+    for (size_t i = 0; i < _ScanIterations; i++) {
+        assertTrue(parcBuffer_FindBytes(buffer, sizeof(pattern), pattern) == _ScanBufferSize - 11, "Expected to find the pattern");
+    }
+    double actual = _elapsedSeconds(&start);
+
+    double megabytes = (double) _ScanBufferSize * _ScanIterations / (1024 * 1024);
+    printf("parcBuffer_FindBytes: byte loop %.0f MB/s, scanner %.0f MB/s\n", megabytes / baseline, megabytes / actual);
+
+    parcBuffer_Release(&buffer);
+}
+
+#define _IntegerCount 4096
+#define _IntegerIterations 1000
+
+LONGBOW_TEST_CASE(Performance, parcBuffer_GetUintN_Throughput)
+{
+    PARCBuffer *buffer = parcBuffer_Allocate(_IntegerCount * 3);
+    for (size_t i = 0; i < _IntegerCount; i++) {
+        parcBuffer_PutUintN(buffer, 3, i * 997);
+    }
+    parcBuffer_Flip(buffer);
+
+    uint64_t baselineSum = 0;
+    struct timeval start;
+    gettimeofday(&start, NULL);
+    for (size_t iteration = 0; iteration < _IntegerIterations; iteration++) {
+        parcBuffer_Rewind(buffer);
+        for (size_t i = 0; i < _IntegerCount; i++) {
+            PARCVarint *varint = parcVarint_DecodeBuffer(buffer, 3);
+            baselineSum += parcVarint_AsUint64(varint);
+            parcVarint_Destroy(&varint);
+        }
+    }
+    double baseline = _elapsedSeconds(&start);
+
+    uint64_t actualSum = 0;
+    gettimeofday(&start, NULL);
+    for (size_t iteration = 0; iteration < _IntegerIterations; iteration++) {
+        parcBuffer_Rewind(buffer);
+        for (size_t i = 0; i < _IntegerCount; i++) {
+            actualSum += parcBuffer_GetUintN(buffer, 3);
+        }
+    }
+    double actual = _elapsedSeconds(&start);
+
+    assertTrue(baselineSum == actualSum, "Expected the same sum, %" PRIu64 " != %" PRIu64, baselineSum, actualSum);
+    double millions = (double) _IntegerCount * _IntegerIterations / 1000000.0;
+    printf("3 byte integers: parcVarint_DecodeBuffer %.1f M/s, parcBuffer_GetUintN %.1f M/s\n", millions / baseline, millions / actual);
+
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(Performance, parcBuffer_GetLEB128_Throughput)
+{
+    PARCBuffer *buffer = parcBuffer_Allocate(_IntegerCount * 10);
+    for (size_t i = 0; i < _IntegerCount; i++) {
+        parcBuffer_PutLEB128(buffer, (i * 2654435761U) >> (i % 32));
+    }
+    parcBuffer_Flip(buffer);
+
+    uint64_t baselineSum = 0;
+    struct timeval start;
+    gettimeofday(&start, NULL);
+    for (size_t iteration = 0; iteration < _IntegerIterations; iteration++) {
+        parcBuffer_Rewind(buffer);
+        for (size_t i = 0; i < _IntegerCount; i++) {
+            baselineSum += parcBuffer_GetLEB128(buffer);
+        }
+    }
+    double single = _elapsedSeconds(&start);
+
+    uint64_t actualSum = 0;
+    uint64_t values[_IntegerCount];
+    gettimeofday(&start, NULL);
+    for (size_t iteration = 0; iteration < _IntegerIterations; iteration++) {
+        parcBuffer_Rewind(buffer);
+        parcBuffer_GetLEB128Array(buffer, _IntegerCount, values);
+        for (size_t i = 0; i < _IntegerCount; i++) {
+            actualSum += values[i];
+        }
+    }
+    double batched = _elapsedSeconds(&start);
+
+    assertTrue(baselineSum == actualSum, "Expected the same sum, %" PRIu64 " != %" PRIu64, baselineSum, actualSum);
+    double millions = (double) _IntegerCount * _IntegerIterations / 1000000.0;
+    printf("LEB128 integers: parcBuffer_GetLEB128 %.1f M/s, parcBuffer_GetLEB128Array %.1f M/s\n", millions / single, millions / batched);
+
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(Performance, parcBuffer_GetUint16Array_Throughput)
+{
+    PARCBuffer *buffer = parcBuffer_Allocate(_IntegerCount * sizeof(uint16_t));
+    for (size_t i = 0; i < _IntegerCount; i++) {
+        parcBuffer_PutUint16(buffer, (uint16_t) (i * 31));
+    }
+    parcBuffer_Flip(buffer);
+
+    uint64_t baselineSum = 0;
+    struct timeval start;
+    gettimeofday(&start, NULL);
+    for (size_t iteration = 0; iteration < _IntegerIterations; iteration++) {
+        parcBuffer_Rewind(buffer);
+        for (size_t i = 0; i < _IntegerCount; i++) {
+            baselineSum += parcBuffer_GetUint16(buffer);
+        }
+    }
+    double single = _elapsedSeconds(&start);
+
+    uint64_t actualSum = 0;
+    uint16_t values[_IntegerCount];
+    gettimeofday(&start, NULL);
+    for (size_t iteration = 0; iteration < _IntegerIterations; iteration++) {
+        parcBuffer_Rewind(buffer);
+        parcBuffer_GetUint16Array(buffer, _IntegerCount, values);
+        for (size_t i = 0; i < _IntegerCount; i++) {
+            actualSum += values[i];
+        }
+    }
+    double batched = _elapsedSeconds(&start);
+
+    assertTrue(baselineSum == actualSum, "Expected the same sum, %" PRIu64 " != %" PRIu64, baselineSum, actualSum);
+    double millions = (double) _IntegerCount * _IntegerIterations / 1000000.0;
+    printf("16 bit integers: parcBuffer_GetUint16 %.1f M/s, parcBuffer_GetUint16Array %.1f M/s\n", millions / single, millions / batched);
+
+    parcBuffer_Release(&buffer);
+}
+
 int
 main(int argc, char *argv[argc])
 {
@@ -58,10 +58,14 @@
 #include "../parc_BufferComposer.c"
 
 #include <inttypes.h>
+#include <fcntl.h>
+#include <sys/time.h>
 #include <LongBow/unit-test.h>
 #include <LongBow/debugging.h>
 
 #include <parc/algol/parc_SafeMemory.h>
+#include <parc/algol/parc_StdlibMemory.h>
+#include <parc/algol/parc_FileOutputStream.h>
 #include <parc/testing/parc_ObjectTesting.h>
 
 typedef struct {
@@ -100,6 +104,8 @@ LONGBOW_TEST_RUNNER(parc_BufferComposer)
     // Test Fixtures are run in the order specified, but all tests should be idempotent.
     // Never rely on the execution order of tests or share state between them.
     LONGBOW_RUN_TEST_FIXTURE(Global);
+    LONGBOW_RUN_TEST_FIXTURE(Chunked);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
 }
 
 // The Test Runner calls this function once before any Test Fixtures are run.
@@ -232,6 +238,7 @@ LONGBOW_TEST_CASE(Global, parcBufferComposer_Equals)
     PARCBufferComposer *y = parcBufferComposer_Create();
     PARCBufferComposer *z = parcBufferComposer_Create();
     PARCBufferComposer *u = parcBufferComposer_Allocate(10);
+    parcBufferComposer_PutChar(u, 'u');
 
     parcObjectTesting_AssertEqualsFunction(parcBufferComposer_Equals, x, y, z, u);
 
@@ -477,6 +484,324 @@ LONGBOW_TEST_CASE(Global, parcBufferComposer_PutString_Extend)
     parcBufferComposer_Release(&composer);
 }
 
+LONGBOW_TEST_FIXTURE(Chunked)
+{
+    LONGBOW_RUN_TEST_CASE(Chunked, parcBufferComposer_CreateChunked);
+    LONGBOW_RUN_TEST_CASE(Chunked, parcBufferComposer_CreateChunked_Equals);
+    LONGBOW_RUN_TEST_CASE(Chunked, parcBufferComposer_CreateChunked_EqualsUnchunked);
+    LONGBOW_RUN_TEST_CASE(Chunked, parcBufferComposer_CreateChunked_GetBuffer);
+    LONGBOW_RUN_TEST_CASE(Chunked, parcBufferComposer_CreateChunked_LargePut);
+    LONGBOW_RUN_TEST_CASE(Chunked, parcBufferComposer_CreateChunked_ToString);
+    LONGBOW_RUN_TEST_CASE(Chunked, parcBufferComposer_GetLength);
+    LONGBOW_RUN_TEST_CASE(Chunked, parcBufferComposer_WriteToFileDescriptor);
+    LONGBOW_RUN_TEST_CASE(Chunked, parcBufferComposer_WriteToOutputStream);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Chunked)
+{
+    longBowTestCase_SetInt(testCase, "initialAllocations", parcSafeMemory_Outstanding());
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Chunked)
+{
+    uint32_t initialAllocations = longBowTestCase_GetInt(testCase, "initialAllocations");
+    uint32_t outstandingAllocations = parcSafeMemory_ReportAllocation(STDOUT_FILENO) - initialAllocations;
+
+    if (outstandingAllocations != 0) {
+        printf("%s leaks %d memory allocations\n", longBowTestCase_GetName(testCase), outstandingAllocations);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+/*
+ * Compose `count` bytes of a known pattern, one byte at a time.
+ */
+static PARCBufferComposer *
+_composePattern(PARCBufferComposer *composer, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        parcBufferComposer_PutUint8(composer, (uint8_t) (i % 251));
+    }
+    return composer;
+}
+
+static void
+_assertPattern(PARCBuffer *buffer, size_t count)
+{
+    assertTrue(parcBuffer_Remaining(buffer) == count, "Expected %zu bytes, actual %zu", count, parcBuffer_Remaining(buffer));
+    for (size_t i = 0; i < count; i++) {
+        uint8_t actual = parcBuffer_GetAtIndex(buffer, parcBuffer_Position(buffer) + i);
+        assertTrue(actual == (uint8_t) (i % 251), "Expected %u at index %zu, actual %u", (unsigned) (i % 251), i, actual);
+    }
+}
+
+LONGBOW_TEST_CASE(Chunked, parcBufferComposer_CreateChunked)
+{
+    PARCBufferComposer *composer = parcBufferComposer_CreateChunked(16);
+    _composePattern(composer, 10000);
+
+    assertTrue(composer->segmentCount > 1, "Expected several segments, actual %zu", composer->segmentCount);
+    assertTrue(parcBuffer_Capacity(composer->buffer) <= _MaximumSegmentSize, "Expected segment sizes to be bounded");
+
+    PARCBuffer *buffer = parcBufferComposer_ProduceBuffer(composer);
+    assertTrue(composer->segmentCount == 0, "Expected the segments to be coalesced, actual %zu", composer->segmentCount);
+    _assertPattern(buffer, 10000);
+
+    parcBuffer_Release(&buffer);
+    parcBufferComposer_Release(&composer);
+}
+
+LONGBOW_TEST_CASE(Chunked, parcBufferComposer_CreateChunked_Equals)
+{
+    PARCBufferComposer *x = _composePattern(parcBufferComposer_CreateChunked(16), 1000);
+    PARCBufferComposer *y = _composePattern(parcBufferComposer_CreateChunked(16), 1000);
+    PARCBufferComposer *z = _composePattern(parcBufferComposer_CreateChunked(16), 999);
+
+    assertTrue(parcBufferComposer_Equals(x, y), "Expected chunked composers with the same content to be equal");
+    assertFalse(parcBufferComposer_Equals(x, z), "Expected composers with different content to be unequal");
+
+    parcBufferComposer_Release(&x);
+    parcBufferComposer_Release(&y);
+    parcBufferComposer_Release(&z);
+}
+
+LONGBOW_TEST_CASE(Chunked, parcBufferComposer_CreateChunked_EqualsUnchunked)
+{
+    PARCBufferComposer *x = _composePattern(parcBufferComposer_CreateChunked(16), 1000);
+    PARCBufferComposer *y = _composePattern(parcBufferComposer_Allocate(16), 1000);
+    size_t segmentCount = x->segmentCount;
+    size_t capacity = parcBuffer_Capacity(y->buffer);
+
+    assertTrue(parcBufferComposer_Equals(x, y), "Expected composers with the same content to be equal regardless of their segments");
+    assertTrue(parcBufferComposer_Equals(y, x), "Expected equality to be symmetric");
+    assertTrue(x->segmentCount == segmentCount, "Expected Equals to leave the segments alone, expected %zu actual %zu", segmentCount, x->segmentCount);
+    assertTrue(parcBuffer_Capacity(y->buffer) == capacity, "Expected Equals to leave the buffer alone");
+
+    parcBufferComposer_PutUint8(y, 0);
+    assertFalse(parcBufferComposer_Equals(x, y), "Expected composers of different lengths to be unequal");
+
+    parcBufferComposer_Release(&x);
+    parcBufferComposer_Release(&y);
+}
+
+LONGBOW_TEST_CASE(Chunked, parcBufferComposer_CreateChunked_GetBuffer)
+{
+    PARCBufferComposer *composer = _composePattern(parcBufferComposer_CreateChunked(16), 1000);
+
+    PARCBuffer *buffer = parcBufferComposer_GetBuffer(composer);
+    assertTrue(parcBuffer_Position(buffer) == 1000, "Expected the position to be 1000, actual %zu", parcBuffer_Position(buffer));
+
+    // The composer continues to append after the content has been coalesced.
+    for (size_t i = 1000; i < 2000; i++) {
+        parcBufferComposer_PutUint8(composer, (uint8_t) (i % 251));
+    }
+
+    buffer = parcBufferComposer_CreateBuffer(composer);
+    _assertPattern(parcBuffer_Flip(buffer), 2000);
+    parcBuffer_Release(&buffer);
+
+    parcBufferComposer_Release(&composer);
+}
+
+LONGBOW_TEST_CASE(Chunked, parcBufferComposer_CreateChunked_LargePut)
+{
+    PARCBufferComposer *composer = parcBufferComposer_CreateChunked(16);
+
+    // A put larger than any segment gets a segment of its own.
+    PARCBuffer *large = parcBuffer_Allocate(_MaximumSegmentSize * 2);
+    for (size_t i = 0; i < _MaximumSegmentSize * 2; i++) {
+        parcBuffer_PutUint8(large, (uint8_t) ((i + 3) % 251));
+    }
+    parcBuffer_Flip(large);
+
+    _composePattern(composer, 3);
+    parcBufferComposer_PutBuffer(composer, large);
+
+    PARCBuffer *buffer = parcBufferComposer_ProduceBuffer(composer);
+    _assertPattern(buffer, _MaximumSegmentSize * 2 + 3);
+
+    parcBuffer_Release(&buffer);
+    parcBuffer_Release(&large);
+    parcBufferComposer_Release(&composer);
+}
+
+LONGBOW_TEST_CASE(Chunked, parcBufferComposer_CreateChunked_ToString)
+{
+    PARCBufferComposer *composer = parcBufferComposer_CreateChunked(4);
+    parcBufferComposer_PutStrings(composer, "hello", " ", "chunked", " ", "world", NULL);
+
+    char *actual = parcBufferComposer_ToString(composer);
+    assertTrue(strcmp("hello chunked world", actual) == 0, "Expected strings to match. Got %s", actual);
+
+    parcMemory_Deallocate((void **) &actual);
+    parcBufferComposer_Release(&composer);
+}
+
+LONGBOW_TEST_CASE(Chunked, parcBufferComposer_GetLength)
+{
+    PARCBufferComposer *plain = _composePattern(parcBufferComposer_Allocate(16), 1000);
+    PARCBufferComposer *chunked = _composePattern(parcBufferComposer_CreateChunked(16), 1000);
+
+    assertTrue(parcBufferComposer_GetLength(plain) == 1000, "Expected 1000, actual %zu", parcBufferComposer_GetLength(plain));
+    assertTrue(parcBufferComposer_GetLength(chunked) == 1000, "Expected 1000, actual %zu", parcBufferComposer_GetLength(chunked));
+
+    parcBufferComposer_Release(&plain);
+    parcBufferComposer_Release(&chunked);
+}
+
+static int
+_temporaryFile(void)
+{
+    char path[] = "/tmp/test_parc_BufferComposerXXXXXX";
+    int fd = mkstemp(path);
+    assertTrue(fd >= 0, "mkstemp failed: %s", strerror(errno));
+    unlink(path);
+    return fd;
+}
+
+static void
+_assertFileContent(int fd, PARCBufferComposer *composer)
+{
+    size_t length = parcBufferComposer_GetLength(composer);
+
+    PARCBuffer *actual = parcBuffer_Allocate(length);
+    ssize_t nread = pread(fd, parcBuffer_Overlay(actual, 0), length, 0);
+    assertTrue(nread == (ssize_t) length, "Expected to read %zu bytes, actual %zd", length, nread);
+    assertTrue(lseek(fd, 0, SEEK_END) == (off_t) length, "Expected a file of %zu bytes", length);
+
+    PARCBuffer *expected = parcBufferComposer_CreateBuffer(composer);
+    parcBuffer_Flip(expected);
+    assertTrue(parcBuffer_Equals(expected, actual), "Expected the file to hold the composer's content");
+
+    parcBuffer_Release(&expected);
+    parcBuffer_Release(&actual);
+}
+
+LONGBOW_TEST_CASE(Chunked, parcBufferComposer_WriteToFileDescriptor)
+{
+    // More segments than are written by a single writev.
+    PARCBufferComposer *composer = parcBufferComposer_CreateChunked(16);
+    _composePattern(composer, 20);
+    while (composer->segmentCount < _WriteBatchSize + 10) {
+        PARCBuffer *segment = parcBuffer_Allocate(8);
+        parcBufferComposer_PutBuffer(composer, segment);
+        parcBuffer_Release(&segment);
+        composer = _appendSegment(composer, 1);
+    }
+    _composePattern(composer, 5);
+
+    size_t segmentCount = composer->segmentCount;
+    int fd = _temporaryFile();
+    ssize_t written = parcBufferComposer_WriteToFileDescriptor(composer, fd);
+    assertTrue(written == (ssize_t) parcBufferComposer_GetLength(composer),
+               "Expected %zu bytes written, actual %zd", parcBufferComposer_GetLength(composer), written);
+    assertTrue(composer->segmentCount == segmentCount, "Expected the segments to be left as they were");
+
+    _assertFileContent(fd, composer);
+    close(fd);
+
+    parcBufferComposer_Release(&composer);
+}
+
+LONGBOW_TEST_CASE(Chunked, parcBufferComposer_WriteToOutputStream)
+{
+    PARCBufferComposer *composer = _composePattern(parcBufferComposer_CreateChunked(16), 5000);
+    size_t segmentCount = composer->segmentCount;
+
+    int fd = _temporaryFile();
+    PARCFileOutputStream *fileOutput = parcFileOutputStream_Create(dup(fd));
+    PARCOutputStream *output = parcFileOutputStream_AsOutputStream(fileOutput);
+    parcBufferComposer_WriteToOutputStream(composer, output);
+    parcOutputStream_Release(&output);
+    parcFileOutputStream_Release(&fileOutput);
+
+    assertTrue(composer->segmentCount == segmentCount, "Expected the segments to be left as they were");
+
+    _assertFileContent(fd, composer);
+    close(fd);
+
+    parcBufferComposer_Release(&composer);
+}
+
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, parcBufferComposer_Allocate_Throughput);
+    LONGBOW_RUN_TEST_CASE(Performance, parcBufferComposer_CreateChunked_Throughput);
+    LONGBOW_RUN_TEST_CASE(Performance, parcBufferComposer_WriteToFileDescriptor_Throughput);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    parcMemory_SetInterface(&PARCStdlibMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+#define PERFORMANCE_BYTES (100 * 1024 * 1024)
+
+static double
+_performance_Elapsed(const struct timeval *start)
+{
+    struct timeval end, elapsed;
+    gettimeofday(&end, NULL);
+    timersub(&end, start, &elapsed);
+    return elapsed.tv_sec + elapsed.tv_usec / 1000000.0;
+}
+
+/*
+ * Compose 100 MB in 16 byte puts, then either produce a buffer or write it to /dev/null.
+ */
+static void
+_performance_Compose(const char *name, PARCBufferComposer *composer, bool write)
+{
+    const unsigned char line[16] = "0123456789abcde\n";
+
+    struct timeval start;
+    gettimeofday(&start, NULL);
+
+    for (size_t i = 0; i < PERFORMANCE_BYTES / sizeof(line); i++) {
+        parcBufferComposer_PutArray(composer, line, sizeof(line));
+    }
+
+    if (write) {
+        int fd = open("/dev/null", O_WRONLY);
+        ssize_t written = parcBufferComposer_WriteToFileDescriptor(composer, fd);
+        assertTrue(written == PERFORMANCE_BYTES, "Expected %d bytes written, actual %zd", PERFORMANCE_BYTES, written);
+        close(fd);
+    } else {
+        PARCBuffer *buffer = parcBufferComposer_ProduceBuffer(composer);
+        assertTrue(parcBuffer_Remaining(buffer) == PERFORMANCE_BYTES, "Expected %d bytes, actual %zu", PERFORMANCE_BYTES, parcBuffer_Remaining(buffer));
+        parcBuffer_Release(&buffer);
+    }
+
+    double seconds = _performance_Elapsed(&start);
+    printf("%s: %d bytes in %zu byte puts in %.6f seconds (%.1f MB/second)\n",
+           name, PERFORMANCE_BYTES, sizeof(line), seconds, PERFORMANCE_BYTES / seconds / (1024 * 1024));
+
+    parcBufferComposer_Release(&composer);
+}
+
+LONGBOW_TEST_CASE(Performance, parcBufferComposer_Allocate_Throughput)
+{
+    _performance_Compose("parcBufferComposer_Create+ProduceBuffer", parcBufferComposer_Create(), false);
+}
+
+LONGBOW_TEST_CASE(Performance, parcBufferComposer_CreateChunked_Throughput)
+{
+    _performance_Compose("parcBufferComposer_CreateChunked+ProduceBuffer", parcBufferComposer_CreateChunked(4096), false);
+}
+
+LONGBOW_TEST_CASE(Performance, parcBufferComposer_WriteToFileDescriptor_Throughput)
+{
+    _performance_Compose("parcBufferComposer_CreateChunked+WriteToFileDescriptor", parcBufferComposer_CreateChunked(4096), true);
+}
+
 int
 main(int argc, char *argv[argc])
 {
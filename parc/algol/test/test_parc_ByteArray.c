@@ -62,6 +62,8 @@
 #include <stdio.h>
 
 #include <LongBow/unit-test.h>
+
+#include <errno.h>
 #include <LongBow/debugging.h>
 #include <stdio.h>
 
@@ -100,6 +102,8 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, parcByteArray_Wrap_ZeroLength);
 
     LONGBOW_RUN_TEST_CASE(Global, parcByteArray_Wrap);
+    LONGBOW_RUN_TEST_CASE(Global, parcByteArray_WrapMapping);
+    LONGBOW_RUN_TEST_CASE(Global, parcByteArray_WrapMapping_Failed);
     LONGBOW_RUN_TEST_CASE(Global, parcByteArray_Array);
     LONGBOW_RUN_TEST_CASE(Global, parcByteArray_AddressOfIndex);
     LONGBOW_RUN_TEST_CASE(Global, parcByteArray_Capacity);
@@ -157,6 +161,29 @@ LONGBOW_TEST_CASE(Global, parcByteArray_Wrap)
     parcByteArray_Release(&actual);
 }
 
+LONGBOW_TEST_CASE(Global, parcByteArray_WrapMapping)
+{
+    size_t length = (size_t) sysconf(_SC_PAGESIZE);
+    uint8_t *mapping = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    assertTrue(mapping != MAP_FAILED, "mmap failed: %s", strerror(errno));
+
+    PARCByteArray *actual = parcByteArray_WrapMapping(length, mapping);
+    assertNotNull(actual, "Expected non-NULL result from parcByteArray_WrapMapping");
+    assertTrue(parcByteArray_Capacity(actual) == length, "Expected capacity %zu, actual %zu", length, parcByteArray_Capacity(actual));
+
+    parcByteArray_PutByte(actual, 1, 0x5a);
+    assertTrue(mapping[1] == 0x5a, "Expected the byte array to share the mapping");
+
+    parcByteArray_Release(&actual);
+    assertTrue(msync(mapping, length, MS_ASYNC) != 0 && errno == ENOMEM, "Expected the mapping to be removed on release");
+}
+
+LONGBOW_TEST_CASE(Global, parcByteArray_WrapMapping_Failed)
+{
+    PARCByteArray *actual = parcByteArray_WrapMapping(10, MAP_FAILED);
+    assertNull(actual, "Expected NULL for a failed mapping");
+}
+
 LONGBOW_TEST_CASE(Global, parcByteArray_Wrap_NULL)
 {
     PARCByteArray *actual = parcByteArray_Wrap(10, NULL);
@@ -68,6 +68,7 @@
 LONGBOW_TEST_RUNNER(parc_FileChunker)
 {
     LONGBOW_RUN_TEST_FIXTURE(Global);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
 }
 
 // The Test Runner calls this function once before any Test Fixtures are run.
@@ -93,6 +94,11 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, parc_Chunker_ReverseIterator_FilePartial);
     LONGBOW_RUN_TEST_CASE(Global, parc_Chunker_ReverseIterator_FileSmall);
     LONGBOW_RUN_TEST_CASE(Global, parc_Chunker_GetChunkSize);
+    LONGBOW_RUN_TEST_CASE(Global, parc_Chunker_CreateMapped);
+    LONGBOW_RUN_TEST_CASE(Global, parc_Chunker_CreateMapped_EmptyFile);
+    LONGBOW_RUN_TEST_CASE(Global, parc_Chunker_Mapped_MatchesRead);
+    LONGBOW_RUN_TEST_CASE(Global, parc_Chunker_Mapped_ChunkOutlivesChunker);
+    LONGBOW_RUN_TEST_CASE(Global, parc_Chunker_Mapped_ChunkIsPrivate);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Global)
@@ -462,6 +468,224 @@ LONGBOW_TEST_CASE(Global, parc_Chunker_GetChunkSize)
     parcBuffer_Release(&buffer);
 }
 
+LONGBOW_TEST_CASE(Global, parc_Chunker_CreateMapped)
+{
+    PARCBuffer *buffer = parcBuffer_Allocate(1024);
+    parcBuffer_SetPosition(buffer, 1024);
+    parcBuffer_Flip(buffer);
+    _createFile("/tmp/file_chunker.tmp", buffer);
+
+    PARCFile *file = parcFile_Create("/tmp/file_chunker.tmp");
+    PARCFileChunker *chunker = parcFileChunker_CreateMapped(file, 32);
+    assertNotNull(chunker, "Expected non-NULL Chunker");
+    assertTrue(parcFileChunker_IsMapped(chunker), "Expected a regular file to be mapped");
+
+    PARCFileChunker *unmapped = parcFileChunker_Create(file, 32);
+    assertFalse(parcFileChunker_IsMapped(unmapped), "Expected parcFileChunker_Create not to map the file");
+
+    parcFileChunker_Release(&unmapped);
+    parcFileChunker_Release(&chunker);
+    parcFile_Release(&file);
+
+    _deleteFile("/tmp/file_chunker.tmp");
+
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(Global, parc_Chunker_CreateMapped_EmptyFile)
+{
+    PARCFile *file = parcFile_Create("/tmp/file_chunker.tmp");
+    parcFile_CreateNewFile(file);
+
+    PARCFileChunker *chunker = parcFileChunker_CreateMapped(file, 32);
+    assertNotNull(chunker, "Expected non-NULL Chunker");
+    assertFalse(parcFileChunker_IsMapped(chunker), "Expected an empty file to fall back to reading");
+
+    parcFileChunker_Release(&chunker);
+    parcFile_Release(&file);
+
+    _deleteFile("/tmp/file_chunker.tmp");
+}
+
+static PARCIterator *
+_iterator(PARCFileChunker *chunker, bool forward)
+{
+    return forward ? parcFileChunker_ForwardIterator(chunker) : parcFileChunker_ReverseIterator(chunker);
+}
+
+LONGBOW_TEST_CASE(Global, parc_Chunker_Mapped_MatchesRead)
+{
+    PARCBuffer *buffer = parcBuffer_Allocate(1000);
+    for (size_t i = 0; i < 1000; i++) {
+        parcBuffer_PutUint8(buffer, (uint8_t) (i * 7));
+    }
+    parcBuffer_Flip(buffer);
+    _createFile("/tmp/file_chunker.tmp", buffer);
+
+    PARCFile *file = parcFile_Create("/tmp/file_chunker.tmp");
+    size_t chunkSizes[] = { 1, 7, 32, 100, 999, 1000, 4096 };
+
+    for (size_t c = 0; c < sizeof(chunkSizes) / sizeof(chunkSizes[0]); c++) {
+        for (int forward = 0; forward < 2; forward++) {
+            PARCFileChunker *reader = parcFileChunker_Create(file, chunkSizes[c]);
+            PARCFileChunker *mapper = parcFileChunker_CreateMapped(file, chunkSizes[c]);
+            assertTrue(parcFileChunker_IsMapped(mapper), "Expected the file to be mapped");
+
+            PARCIterator *expected = _iterator(reader, forward);
+            PARCIterator *actual = _iterator(mapper, forward);
+            size_t count = 0;
+            while (parcIterator_HasNext(expected)) {
+                assertTrue(parcIterator_HasNext(actual), "Mapped chunker ended early at chunk %zu", count);
+                PARCBuffer *expectedChunk = parcIterator_Next(expected);
+                PARCBuffer *actualChunk = parcIterator_Next(actual);
+
+                assertTrue(parcBuffer_Equals(expectedChunk, actualChunk),
+                           "Chunk %zu differs for chunk size %zu, %s", count, chunkSizes[c], forward ? "forward" : "reverse");
+
+                parcBuffer_Release(&expectedChunk);
+                parcBuffer_Release(&actualChunk);
+                count++;
+            }
+            assertFalse(parcIterator_HasNext(actual), "Mapped chunker has more than %zu chunks", count);
+
+            parcIterator_Release(&expected);
+            parcIterator_Release(&actual);
+            parcFileChunker_Release(&reader);
+            parcFileChunker_Release(&mapper);
+        }
+    }
+
+    parcFile_Release(&file);
+
+    _deleteFile("/tmp/file_chunker.tmp");
+
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(Global, parc_Chunker_Mapped_ChunkOutlivesChunker)
+{
+    PARCBuffer *buffer = parcBuffer_Allocate(64);
+    for (size_t i = 0; i < 64; i++) {
+        parcBuffer_PutUint8(buffer, (uint8_t) i);
+    }
+    parcBuffer_Flip(buffer);
+    _createFile("/tmp/file_chunker.tmp", buffer);
+
+    PARCFile *file = parcFile_Create("/tmp/file_chunker.tmp");
+    PARCFileChunker *chunker = parcFileChunker_CreateMapped(file, 32);
+    PARCIterator *itr = parcFileChunker_ForwardIterator(chunker);
+
+    PARCBuffer *chunk = parcIterator_Next(itr);
+    parcBuffer_Release(&chunk);
+    chunk = parcIterator_Next(itr);
+
+    parcIterator_Release(&itr);
+    parcFileChunker_Release(&chunker);
+    parcFile_Release(&file);
+    _deleteFile("/tmp/file_chunker.tmp");
+
+    assertTrue(parcBuffer_Remaining(chunk) == 32, "Expected 32 bytes, actual %zu", parcBuffer_Remaining(chunk));
+    for (size_t i = 0; i < 32; i++) {
+        assertTrue(parcBuffer_GetAtIndex(chunk, i) == 32 + i, "Expected %zu at index %zu", 32 + i, i);
+    }
+
+    parcBuffer_Release(&chunk);
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(Global, parc_Chunker_Mapped_ChunkIsPrivate)
+{
+    PARCBuffer *buffer = parcBuffer_Allocate(32);
+    parcBuffer_SetPosition(buffer, 32);
+    parcBuffer_Flip(buffer);
+    _createFile("/tmp/file_chunker.tmp", buffer);
+
+    PARCFile *file = parcFile_Create("/tmp/file_chunker.tmp");
+    PARCFileChunker *chunker = parcFileChunker_CreateMapped(file, 32);
+    PARCIterator *itr = parcFileChunker_ForwardIterator(chunker);
+    PARCBuffer *chunk = parcIterator_Next(itr);
+    parcBuffer_PutUint8(chunk, 0xFF);
+    parcBuffer_Release(&chunk);
+    parcIterator_Release(&itr);
+    parcFileChunker_Release(&chunker);
+
+    chunker = parcFileChunker_Create(file, 32);
+    itr = parcFileChunker_ForwardIterator(chunker);
+    chunk = parcIterator_Next(itr);
+    assertTrue(parcBuffer_GetAtIndex(chunk, 0) == 0, "Expected modifying a mapped chunk not to modify the file");
+    parcBuffer_Release(&chunk);
+    parcIterator_Release(&itr);
+    parcFileChunker_Release(&chunker);
+
+    parcFile_Release(&file);
+    _deleteFile("/tmp/file_chunker.tmp");
+
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, parc_Chunker_ForwardIterator_Throughput);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+static double
+_chunkThroughput(PARCFileChunker *chunker)
+{
+    struct timeval start, end;
+    gettimeofday(&start, NULL);
+
+    size_t bytes = 0;
+    PARCIterator *itr = parcFileChunker_ForwardIterator(chunker);
+    while (parcIterator_HasNext(itr)) {
+        PARCBuffer *chunk = parcIterator_Next(itr);
+        bytes += parcBuffer_Remaining(chunk);
+        parcBuffer_GetAtIndex(chunk, 0);
+        parcBuffer_Release(&chunk);
+    }
+    parcIterator_Release(&itr);
+
+    gettimeofday(&end, NULL);
+    double seconds = (end.tv_sec - start.tv_sec) + (end.tv_usec - start.tv_usec) / 1000000.0;
+    return bytes / seconds / 1e6;
+}
+
+LONGBOW_TEST_CASE(Performance, parc_Chunker_ForwardIterator_Throughput)
+{
+    size_t length = 256 * 1024 * 1024;
+    PARCBuffer *buffer = parcBuffer_Allocate(length);
+    parcBuffer_SetPosition(buffer, length);
+    parcBuffer_Flip(buffer);
+    _createFile("/tmp/file_chunker_throughput.tmp", buffer);
+    parcBuffer_Release(&buffer);
+
+    PARCFile *file = parcFile_Create("/tmp/file_chunker_throughput.tmp");
+
+    size_t chunkSizes[] = { 1024, 8192, 65536 };
+    for (size_t c = 0; c < sizeof(chunkSizes) / sizeof(chunkSizes[0]); c++) {
+        PARCFileChunker *reader = parcFileChunker_Create(file, chunkSizes[c]);
+        PARCFileChunker *mapper = parcFileChunker_CreateMapped(file, chunkSizes[c]);
+
+        printf("parcFileChunker %zu byte chunks: read %.0f MB/s, mapped %.0f MB/s\n",
+               chunkSizes[c], _chunkThroughput(reader), _chunkThroughput(mapper));
+
+        parcFileChunker_Release(&reader);
+        parcFileChunker_Release(&mapper);
+    }
+
+    parcFile_Release(&file);
+    _deleteFile("/tmp/file_chunker_throughput.tmp");
+}
+
 int
 main(int argc, char *argv[])
 {
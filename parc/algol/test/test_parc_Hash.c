@@ -55,7 +55,9 @@
 #include "../parc_Hash.c"
 
 #include <LongBow/testing.h>
+#include <inttypes.h>
 #include <stdio.h>
+#include <sys/time.h>
 
 #include <parc/algol/parc_SafeMemory.h>
 
@@ -66,6 +68,7 @@ LONGBOW_TEST_RUNNER(parc_Hash)
     // Never rely on the execution order of tests or share state between them.
     LONGBOW_RUN_TEST_FIXTURE(Global);
     LONGBOW_RUN_TEST_FIXTURE(Local);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
 }
 
 // The Test Runner calls this function once before any Test Fixtures are run.
@@ -95,6 +98,13 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, parc_Hash64_Data);
     LONGBOW_RUN_TEST_CASE(Global, parc_Hash64_Int32);
     LONGBOW_RUN_TEST_CASE(Global, parc_Hash64_Int64);
+
+    LONGBOW_RUN_TEST_CASE(Global, parcHash64Fast_Data);
+    LONGBOW_RUN_TEST_CASE(Global, parcHash64Fast_Data_Seed);
+    LONGBOW_RUN_TEST_CASE(Global, parcHash64Fast_Update);
+    LONGBOW_RUN_TEST_CASE(Global, parcHash64Fast_Digest_Continue);
+    LONGBOW_RUN_TEST_CASE(Global, parcHash64Fast_Collisions);
+    LONGBOW_RUN_TEST_CASE(Global, parcHash64Fast_Avalanche);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Global)
@@ -268,6 +278,171 @@ LONGBOW_TEST_CASE(Global, parc_Hash64_Int64)
     assertTrue(hash1 == hash3, "Hash different for same content");
 }
 
+LONGBOW_TEST_CASE(Global, parcHash64Fast_Data)
+{
+    // Reference values of XXH64 with a seed of 0.
+    struct {
+        const char *data;
+        uint64_t expected;
+    } vectors[] = {
+        { "",                                        0xEF46DB3751D8E999ULL },
+        { "a",                                       0xD24EC4F1A98C6E5BULL },
+        { "abc",                                     0x44BC2CF5AD770999ULL },
+        { "Nobody inspects the spammish repetition", 0xFBCEA83C8A378BF1ULL },
+    };
+
+    for (size_t i = 0; i < sizeof(vectors) / sizeof(vectors[0]); i++) {
+        uint64_t actual = parcHash64Fast_Data(vectors[i].data, strlen(vectors[i].data), 0);
+        assertTrue(actual == vectors[i].expected,
+                   "Expected %" PRIX64 " for \"%s\", actual %" PRIX64, vectors[i].expected, vectors[i].data, actual);
+    }
+}
+
+LONGBOW_TEST_CASE(Global, parcHash64Fast_Data_Seed)
+{
+    char *data = "Hello world of hashing";
+
+    uint64_t hash1 = parcHash64Fast_Data(data, strlen(data), 0);
+    uint64_t hash2 = parcHash64Fast_Data(data, strlen(data), 1);
+    uint64_t hash3 = parcHash64Fast_Data(data, strlen(data), 1);
+
+    assertTrue(hash1 != hash2, "Expected different seeds to produce different hashes");
+    assertTrue(hash2 == hash3, "Hash different for same content and seed");
+}
+
+LONGBOW_TEST_CASE(Global, parcHash64Fast_Update)
+{
+    uint8_t data[200];
+    for (size_t i = 0; i < sizeof(data); i++) {
+        data[i] = (uint8_t) (i * 7 + 3);
+    }
+
+    for (size_t length = 0; length <= sizeof(data); length += 13) {
+        uint64_t expected = parcHash64Fast_Data(data, length, 42);
+
+        // Every split of the input, including empty updates, must produce the same digest.
+        for (size_t split = 0; split <= length; split++) {
+            PARCHash64Fast state;
+            parcHash64Fast_Init(&state, 42);
+            parcHash64Fast_Update(&state, data, split);
+            parcHash64Fast_Update(&state, &data[split], 0);
+            parcHash64Fast_Update(&state, &data[split], length - split);
+            uint64_t actual = parcHash64Fast_Digest(&state);
+            assertTrue(expected == actual,
+                       "Length %zu split at %zu: expected %" PRIX64 ", actual %" PRIX64, length, split, expected, actual);
+        }
+
+        // One byte at a time.
+        PARCHash64Fast state;
+        parcHash64Fast_Init(&state, 42);
+        for (size_t i = 0; i < length; i++) {
+            parcHash64Fast_Update(&state, &data[i], 1);
+        }
+        uint64_t actual = parcHash64Fast_Digest(&state);
+        assertTrue(expected == actual, "Length %zu bytewise: expected %" PRIX64 ", actual %" PRIX64, length, expected, actual);
+    }
+}
+
+LONGBOW_TEST_CASE(Global, parcHash64Fast_Digest_Continue)
+{
+    char *data = "1234567890abcdefghij1234567890abcdefghij";
+
+    PARCHash64Fast state;
+    parcHash64Fast_Init(&state, 0);
+    parcHash64Fast_Update(&state, data, 20);
+    uint64_t partial = parcHash64Fast_Digest(&state);
+    parcHash64Fast_Update(&state, &data[20], 20);
+    uint64_t full = parcHash64Fast_Digest(&state);
+
+    assertTrue(partial == parcHash64Fast_Data(data, 20, 0), "Expected the partial digest to equal the hash of the first part");
+    assertTrue(full == parcHash64Fast_Data(data, 40, 0), "Expected the final digest to equal the hash of all of the data");
+}
+
+static int
+_compareUint64(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *) a;
+    uint64_t y = *(const uint64_t *) b;
+    return (x > y) - (x < y);
+}
+
+LONGBOW_TEST_CASE(Global, parcHash64Fast_Collisions)
+{
+    // Hash keys that differ in very few bits: consecutive integers and short decimal strings.
+    const size_t keyCount = 1 << 18;
+    const size_t bucketCount = 1024;
+
+    uint64_t *hashes = malloc(keyCount * 2 * sizeof(uint64_t));
+    uint32_t *lowBuckets = calloc(bucketCount, sizeof(uint32_t));
+    uint32_t *highBuckets = calloc(bucketCount, sizeof(uint32_t));
+
+    for (size_t i = 0; i < keyCount; i++) {
+        uint64_t key = i;
+        hashes[i] = parcHash64Fast_Data(&key, sizeof(key), 0);
+
+        char string[32];
+        int length = sprintf(string, "name-%zu", i);
+        hashes[keyCount + i] = parcHash64Fast_Data(string, (size_t) length, 0);
+
+        lowBuckets[hashes[i] % bucketCount]++;
+        highBuckets[hashes[keyCount + i] >> 54]++;
+    }
+
+    qsort(hashes, keyCount * 2, sizeof(uint64_t), _compareUint64);
+    for (size_t i = 1; i < keyCount * 2; i++) {
+        assertTrue(hashes[i] != hashes[i - 1], "Unexpected 64-bit collision %" PRIX64, hashes[i]);
+    }
+
+    // Chi-squared with 1023 degrees of freedom has a mean of 1023 and a standard deviation of about 45.
+    double expected = (double) keyCount / bucketCount;
+    double lowChiSquared = 0;
+    double highChiSquared = 0;
+    for (size_t i = 0; i < bucketCount; i++) {
+        lowChiSquared += (lowBuckets[i] - expected) * (lowBuckets[i] - expected) / expected;
+        highChiSquared += (highBuckets[i] - expected) * (highBuckets[i] - expected) / expected;
+    }
+    assertTrue(lowChiSquared < 1300, "Low bits are poorly distributed, chi-squared %f", lowChiSquared);
+    assertTrue(highChiSquared < 1300, "High bits are poorly distributed, chi-squared %f", highChiSquared);
+
+    free(highBuckets);
+    free(lowBuckets);
+    free(hashes);
+}
+
+LONGBOW_TEST_CASE(Global, parcHash64Fast_Avalanche)
+{
+    // Flipping any single input bit should flip each output bit with a probability close to one half.
+    const size_t trials = 1000;
+    uint32_t flips[64] = { 0 };
+    size_t samples = 0;
+
+    uint64_t seed = 1;
+    for (size_t trial = 0; trial < trials; trial++) {
+        uint8_t input[16];
+        for (size_t i = 0; i < sizeof(input); i++) {
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            input[i] = (uint8_t) (seed >> 56);
+        }
+        uint64_t hash = parcHash64Fast_Data(input, sizeof(input), 0);
+
+        for (size_t bit = 0; bit < sizeof(input) * 8; bit++) {
+            input[bit / 8] ^= (uint8_t) (1 << (bit % 8));
+            uint64_t difference = hash ^ parcHash64Fast_Data(input, sizeof(input), 0);
+            input[bit / 8] ^= (uint8_t) (1 << (bit % 8));
+
+            for (int i = 0; i < 64; i++) {
+                flips[i] += (difference >> i) & 1;
+            }
+            samples++;
+        }
+    }
+
+    for (int i = 0; i < 64; i++) {
+        double probability = (double) flips[i] / samples;
+        assertTrue(probability > 0.48 && probability < 0.52, "Output bit %d flipped with probability %f", i, probability);
+    }
+}
+
 LONGBOW_TEST_FIXTURE(Local)
 {
 }
@@ -282,6 +457,66 @@ LONGBOW_TEST_FIXTURE_TEARDOWN(Local)
     return LONGBOW_STATUS_SUCCEEDED;
 }
 
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, parcHash64Fast_Data_Throughput);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+static double
+_elapsedSeconds(const struct timeval *start)
+{
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    return (double) (now.tv_sec - start->tv_sec) + (double) (now.tv_usec - start->tv_usec) / 1000000.0;
+}
+
+LONGBOW_TEST_CASE(Performance, parcHash64Fast_Data_Throughput)
+{
+    const size_t lengths[] = { 8, 16, 64, 256, 1024, 4096, 16384, 65536 };
+    const size_t maximumLength = 65536;
+    const size_t bytesPerLength = 256 * 1024 * 1024;
+
+    uint8_t *data = malloc(maximumLength);
+    for (size_t i = 0; i < maximumLength; i++) {
+        data[i] = (uint8_t) (i * 31);
+    }
+
+    printf("%8s %12s %12s\n", "length", "FNV-1a MB/s", "fast MB/s");
+    for (size_t n = 0; n < sizeof(lengths) / sizeof(lengths[0]); n++) {
+        size_t length = lengths[n];
+        size_t iterations = bytesPerLength / length;
+        uint64_t sink = 0;
+
+        struct timeval start;
+        gettimeofday(&start, NULL);
+        for (size_t i = 0; i < iterations; i++) {
+            sink += parcHash64_Data_Cumulative(data, length, sink);
+        }
+        double fnv = _elapsedSeconds(&start);
+
+        gettimeofday(&start, NULL);
+        for (size_t i = 0; i < iterations; i++) {
+            sink += parcHash64Fast_Data(data, length, sink);
+        }
+        double fast = _elapsedSeconds(&start);
+
+        double megabytes = (double) bytesPerLength / (1024 * 1024);
+        printf("%8zu %12.0f %12.0f (%" PRIX64 ")\n", length, megabytes / fnv, megabytes / fast, sink);
+    }
+
+    free(data);
+}
+
 int
 main(int argc, char *argv[])
 {
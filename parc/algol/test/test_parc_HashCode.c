@@ -88,6 +88,7 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, parcHashCode_HashImpl);
     LONGBOW_RUN_TEST_CASE(Global, parcHashCode_HashHashCode);
     LONGBOW_RUN_TEST_CASE(Global, parcHashCode_Hash);
+    LONGBOW_RUN_TEST_CASE(Global, parcHashCode_HashData);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Global)
@@ -140,6 +141,20 @@ LONGBOW_TEST_CASE(Global, parcHashCode_Hash)
     assertTrue(hash1 != hash2, "Expected different hash values for testString1 and testString2");
 }
 
+LONGBOW_TEST_CASE(Global, parcHashCode_HashData)
+{
+    char *testString1 = "this is some test data";
+    char *testString2 = "this is different test data";
+
+    PARCHashCode hash1 = parcHashCode_HashData((uint8_t *) testString1, strlen(testString1));
+    PARCHashCode hash2 = parcHashCode_HashData((uint8_t *) testString2, strlen(testString2));
+    PARCHashCode hash3 = parcHashCode_HashData((uint8_t *) testString1, strlen(testString1));
+
+    assertTrue(hash1 != 0, "Expected a non zero hash value for testString1");
+    assertTrue(hash1 != hash2, "Expected different hash values for testString1 and testString2");
+    assertTrue(hash1 == hash3, "Expected equal hash values for equal data");
+}
+
 int
 main(int argc, char *argv[argc])
 {
@@ -66,6 +66,8 @@
 #include <parc/testing/parc_ObjectTesting.h>
 #include <parc/testing/parc_MemoryTesting.h>
 
+#include <sys/time.h>
+
 LONGBOW_TEST_RUNNER(parc_HashMap)
 {
     // The following Test Fixtures will run their corresponding Test Cases.
@@ -75,6 +77,8 @@ LONGBOW_TEST_RUNNER(parc_HashMap)
     LONGBOW_RUN_TEST_FIXTURE(CreateAcquireRelease);
     LONGBOW_RUN_TEST_FIXTURE(ObjectContract);
     LONGBOW_RUN_TEST_FIXTURE(Global);
+    LONGBOW_RUN_TEST_FIXTURE(Flat);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
 }
 
 // The Test Runner calls this function once before any Test Fixtures are run.
@@ -535,8 +539,11 @@ LONGBOW_TEST_CASE(Global, parcHashMap_Resize)
     }
     assertTrue(instance->capacity == (2 * testCapacity),
                "Expect capacity to be %zu got %zu", (2 * testCapacity), instance->capacity);
-    assertTrue(parcHashMap_GetClusteringNumber(instance) < averageBucketSize,
-               "Expect the average bucket size to be less then it was");
+    // The clustering number is weighted by the inverse of the load factor, so for a well distributed
+    // hash it rises when the capacity doubles. It should still indicate a normal distribution.
+    assertTrue(parcHashMap_GetClusteringNumber(instance) < 1.5,
+               "Expect a normal distribution after the expansion, clustering number was %f before and %f after",
+               averageBucketSize, parcHashMap_GetClusteringNumber(instance));
 
     // Now test multiple contractions.
     // If we remove all elements from index "smallSize" (eg. 8) up we will be left with a map of size smallSize,
@@ -947,6 +954,453 @@ LONGBOW_TEST_CASE(Static, parcHashMapEntry)
     _parcHashMapEntry_Release(&instance);
 }
 
+LONGBOW_TEST_FIXTURE(Flat)
+{
+    LONGBOW_RUN_TEST_CASE(Flat, parcHashMap_CreateFlat);
+    LONGBOW_RUN_TEST_CASE(Flat, parcHashMap_CreateFlatCapacity);
+    LONGBOW_RUN_TEST_CASE(Flat, parcHashMap_Copy);
+    LONGBOW_RUN_TEST_CASE(Flat, parcHashMap_Equals);
+    LONGBOW_RUN_TEST_CASE(Flat, parcHashMap_Equals_Chained);
+    LONGBOW_RUN_TEST_CASE(Flat, parcHashMap_HashCode);
+    LONGBOW_RUN_TEST_CASE(Flat, parcHashMap_ToString);
+    LONGBOW_RUN_TEST_CASE(Flat, parcHashMap_Put_Replace);
+    LONGBOW_RUN_TEST_CASE(Flat, parcHashMap_Remove);
+    LONGBOW_RUN_TEST_CASE(Flat, parcHashMap_Resize);
+    LONGBOW_RUN_TEST_CASE(Flat, parcHashMap_Collisions);
+    LONGBOW_RUN_TEST_CASE(Flat, parcHashMap_GetClusteringNumber);
+    LONGBOW_RUN_TEST_CASE(Flat, parcHashMap_ValueIterator);
+    LONGBOW_RUN_TEST_CASE(Flat, parcHashMap_KeyIterator_Remove);
+    LONGBOW_RUN_TEST_CASE(Flat, parcHashMap_KeyIterator_RemoveSome);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Flat)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Flat)
+{
+    if (!parcMemoryTesting_ExpectedOutstanding(0, "%s leaked memory.", longBowTestCase_GetFullName(testCase))) {
+        parcSafeMemory_ReportAllocation(1);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+static PARCHashMap *
+_flatHashMap_CreateWithIntegers(uint32_t count)
+{
+    PARCHashMap *result = parcHashMap_CreateFlat();
+
+    PARCBuffer *key = parcBuffer_Allocate(sizeof(uint32_t));
+    for (uint32_t i = 0; i < count; ++i) {
+        parcBuffer_PutUint32(key, i);
+        PARCBuffer *value = parcBuffer_Allocate(sizeof(uint32_t));
+        parcBuffer_Flip(parcBuffer_PutUint32(value, 1000 + i));
+        parcHashMap_Put(result, parcBuffer_Flip(key), value);
+        parcBuffer_Release(&value);
+    }
+    parcBuffer_Release(&key);
+
+    return result;
+}
+
+static void
+_flatHashMap_AssertIntegers(const PARCHashMap *hashMap, uint32_t from, uint32_t to)
+{
+    PARCBuffer *key = parcBuffer_Allocate(sizeof(uint32_t));
+    for (uint32_t i = from; i < to; ++i) {
+        parcBuffer_PutUint32(key, i);
+        const PARCBuffer *storedValue = parcHashMap_Get(hashMap, parcBuffer_Flip(key));
+        assertNotNull(storedValue, "Expected key %u to be present", i);
+        assertTrue(parcBuffer_GetUint32((PARCBuffer *) storedValue) == 1000 + i, "Expected the value for key %u to be %u", i, 1000 + i);
+        parcBuffer_Rewind((PARCBuffer *) storedValue);
+    }
+    parcBuffer_Release(&key);
+}
+
+LONGBOW_TEST_CASE(Flat, parcHashMap_CreateFlat)
+{
+    PARCHashMap *instance = parcHashMap_CreateFlat();
+    assertNotNull(instance, "Expeced non-null result from parcHashMap_CreateFlat();");
+    parcObjectTesting_AssertAcquireReleaseContract(parcHashMap_Acquire, instance);
+    assertTrue(parcHashMap_IsValid(instance), "Expected parcHashMap_CreateFlat to result in a valid instance.");
+    assertTrue(parcHashMap_Size(instance) == 0, "Expect size to be 0");
+
+    parcHashMap_Release(&instance);
+    assertNull(instance, "Expeced null result from parcHashMap_Release();");
+}
+
+LONGBOW_TEST_CASE(Flat, parcHashMap_CreateFlatCapacity)
+{
+    PARCHashMap *instance = parcHashMap_CreateFlatCapacity(1000);
+    assertTrue(instance->capacity == 1024, "Expect capacity to be rounded up to 1024, actual %zu", instance->capacity);
+    assertNull(instance->buckets, "Expect a flat PARCHashMap to have no buckets");
+
+    for (size_t i = 0; i < instance->capacity; ++i) {
+        assertTrue(instance->slots[i].probeLength == 0, "Expect the hashmap to be clear");
+    }
+
+    parcHashMap_Release(&instance);
+}
+
+LONGBOW_TEST_CASE(Flat, parcHashMap_Copy)
+{
+    PARCHashMap *instance = _flatHashMap_CreateWithIntegers(100);
+    PARCHashMap *copy = parcHashMap_Copy(instance);
+
+    assertTrue(parcHashMap_Equals(instance, copy), "Expected the copy to be equal to the original");
+    _flatHashMap_AssertIntegers(copy, 0, 100);
+
+    parcHashMap_Release(&instance);
+    parcHashMap_Release(&copy);
+}
+
+LONGBOW_TEST_CASE(Flat, parcHashMap_Equals)
+{
+    PARCBuffer *key = parcBuffer_WrapCString("key1");
+    PARCBuffer *value = parcBuffer_WrapCString("value1");
+    PARCBuffer *value2 = parcBuffer_WrapCString("value2");
+
+    PARCHashMap *x = parcHashMap_CreateFlat();
+    parcHashMap_Put(x, key, value);
+    PARCHashMap *y = parcHashMap_CreateFlatCapacity(1000);
+    parcHashMap_Put(y, key, value);
+    PARCHashMap *z = parcHashMap_CreateFlat();
+    parcHashMap_Put(z, key, value);
+
+    PARCHashMap *u1 = parcHashMap_CreateFlat();
+
+    PARCHashMap *u2 = parcHashMap_CreateFlat();
+    parcHashMap_Put(u2, key, value2);
+
+    parcObjectTesting_AssertEquals(x, y, z, u1, u2, NULL);
+
+    parcHashMap_Release(&x);
+    parcHashMap_Release(&y);
+    parcHashMap_Release(&z);
+    parcHashMap_Release(&u1);
+    parcHashMap_Release(&u2);
+
+    parcBuffer_Release(&key);
+    parcBuffer_Release(&value);
+    parcBuffer_Release(&value2);
+}
+
+LONGBOW_TEST_CASE(Flat, parcHashMap_Equals_Chained)
+{
+    PARCHashMap *flat = parcHashMap_CreateFlat();
+    PARCHashMap *chained = parcHashMap_Create();
+
+    assertFalse(parcHashMap_Equals(flat, chained), "Expected a flat PARCHashMap to never equal a chained PARCHashMap");
+    assertFalse(parcHashMap_Equals(chained, flat), "Expected a chained PARCHashMap to never equal a flat PARCHashMap");
+
+    parcHashMap_Release(&flat);
+    parcHashMap_Release(&chained);
+}
+
+LONGBOW_TEST_CASE(Flat, parcHashMap_HashCode)
+{
+    PARCHashMap *instance = parcHashMap_CreateFlat();
+    assertTrue(parcHashMap_HashCode(instance) == 0, "Expected 0 for an empty PARCHashMap");
+
+    PARCHashMap *x = _flatHashMap_CreateWithIntegers(50);
+    PARCHashMap *y = parcHashMap_CreateFlatCapacity(512);
+
+    // Same mappings, inserted in reverse order into a map of a different capacity.
+    PARCBuffer *key = parcBuffer_Allocate(sizeof(uint32_t));
+    for (uint32_t i = 50; i > 0; --i) {
+        parcBuffer_PutUint32(key, i - 1);
+        PARCBuffer *value = parcBuffer_Allocate(sizeof(uint32_t));
+        parcBuffer_Flip(parcBuffer_PutUint32(value, 1000 + i - 1));
+        parcHashMap_Put(y, parcBuffer_Flip(key), value);
+        parcBuffer_Release(&value);
+    }
+    parcBuffer_Release(&key);
+
+    assertTrue(parcHashMap_Equals(x, y), "Expected equal PARCHashMaps");
+    assertTrue(parcHashMap_HashCode(x) == parcHashMap_HashCode(y), "Expected equal PARCHashMaps to have equal hash codes");
+
+    parcHashMap_Release(&instance);
+    parcHashMap_Release(&x);
+    parcHashMap_Release(&y);
+}
+
+LONGBOW_TEST_CASE(Flat, parcHashMap_ToString)
+{
+    PARCHashMap *instance = _flatHashMap_CreateWithIntegers(3);
+
+    char *string = parcHashMap_ToString(instance);
+    assertNotNull(string, "Expected non-NULL result from parcHashMap_ToString");
+
+    parcMemory_Deallocate(&string);
+    parcHashMap_Release(&instance);
+}
+
+LONGBOW_TEST_CASE(Flat, parcHashMap_Put_Replace)
+{
+    PARCHashMap *instance = parcHashMap_CreateFlat();
+
+    PARCBuffer *key = parcBuffer_WrapCString("key1");
+    PARCBuffer *value1 = parcBuffer_WrapCString("value1");
+    PARCBuffer *value2 = parcBuffer_WrapCString("value2");
+
+    parcHashMap_Put(instance, key, value1);
+    parcHashMap_Put(instance, key, value2);
+
+    assertTrue(parcHashMap_Size(instance) == 1, "Expected 1, actual %zd", parcHashMap_Size(instance));
+    PARCBuffer *actual = (PARCBuffer *) parcHashMap_Get(instance, key);
+    assertTrue(parcBuffer_Equals(value2, actual), "Expected value was not returned from Get");
+    assertTrue(parcHashMap_Contains(instance, key), "Expected parcHashMap_Contains to return true");
+
+    parcBuffer_Release(&key);
+    parcBuffer_Release(&value1);
+    parcBuffer_Release(&value2);
+    parcHashMap_Release(&instance);
+}
+
+LONGBOW_TEST_CASE(Flat, parcHashMap_Remove)
+{
+    PARCHashMap *instance = _flatHashMap_CreateWithIntegers(100);
+
+    PARCBuffer *key = parcBuffer_Allocate(sizeof(uint32_t));
+    for (uint32_t i = 0; i < 100; i += 2) {
+        parcBuffer_PutUint32(key, i);
+        assertTrue(parcHashMap_Remove(instance, parcBuffer_Flip(key)), "Expected parcHashMap_Remove to return true.");
+        assertFalse(parcHashMap_Remove(instance, key), "Expected parcHashMap_Remove of a removed key to return false.");
+        assertFalse(parcHashMap_Contains(instance, key), "Expected parcHashMap_Contains of a removed key to return false.");
+    }
+    parcBuffer_Release(&key);
+
+    assertTrue(parcHashMap_Size(instance) == 50, "Expected 50, actual %zd", parcHashMap_Size(instance));
+    for (uint32_t i = 1; i < 100; i += 2) {
+        _flatHashMap_AssertIntegers(instance, i, i + 1);
+    }
+
+    parcHashMap_Release(&instance);
+}
+
+LONGBOW_TEST_CASE(Flat, parcHashMap_Resize)
+{
+    const uint32_t testRunSize = 1000;
+    PARCHashMap *instance = _flatHashMap_CreateWithIntegers(testRunSize);
+
+    assertTrue(parcHashMap_Size(instance) == testRunSize, "Expect the size to be %u", testRunSize);
+    assertTrue((instance->capacity & (instance->capacity - 1)) == 0, "Expect the capacity to be a power of 2, actual %zu", instance->capacity);
+    assertTrue(testRunSize < instance->capacity * instance->maxLoadFactor, "Expect the load factor to be below the maximum");
+    _flatHashMap_AssertIntegers(instance, 0, testRunSize);
+
+    size_t smallSize = 8;
+    PARCBuffer *key = parcBuffer_Allocate(sizeof(uint32_t));
+    for (uint32_t i = smallSize; i < testRunSize; ++i) {
+        parcBuffer_PutUint32(key, i);
+        assertTrue(parcHashMap_Remove(instance, parcBuffer_Flip(key)), "Expect Remove to succeed");
+    }
+    parcBuffer_Release(&key);
+
+    assertTrue(instance->size == smallSize, "Expect the hash map to have size %zu, got %zu", smallSize, instance->size);
+    assertTrue(instance->capacity == instance->minCapacity * 2,
+               "Expect capacity to contract to %zu, got %zu", instance->minCapacity * 2, instance->capacity);
+    _flatHashMap_AssertIntegers(instance, 0, smallSize);
+
+    parcHashMap_Release(&instance);
+}
+
+typedef struct {
+    int64_t number;
+} _Collider;
+
+static PARCHashCode
+_collider_hashCode(const _Collider *collider __attribute__((unused)))
+{
+    return 42;
+}
+
+parcObject_ExtendPARCObject(_Collider, NULL, NULL, NULL, NULL, NULL, _collider_hashCode, NULL);
+
+parcObject_ImplementRelease(_collider, _Collider);
+
+static _Collider *
+_collider_Create(int64_t number)
+{
+    _Collider *result = parcObject_CreateInstance(_Collider);
+    result->number = number;
+    return result;
+}
+
+LONGBOW_TEST_CASE(Flat, parcHashMap_Collisions)
+{
+    // Every key has the same hash code, so every lookup probes through a single cluster.
+    PARCHashMap *instance = parcHashMap_CreateFlat();
+
+    for (int i = 0; i < 100; ++i) {
+        _Collider *key = _collider_Create(i);
+        PARCBuffer *value = parcBuffer_Allocate(sizeof(uint32_t));
+        parcBuffer_Flip(parcBuffer_PutUint32(value, i));
+        parcHashMap_Put(instance, key, value);
+        parcBuffer_Release(&value);
+        _collider_Release(&key);
+    }
+
+    for (int i = 0; i < 100; ++i) {
+        _Collider *key = _collider_Create(i);
+        const PARCBuffer *value = parcHashMap_Get(instance, key);
+        assertNotNull(value, "Expected key %d to be present", i);
+        assertTrue(parcBuffer_GetUint32((PARCBuffer *) value) == i, "Expected the value for key %d", i);
+        if (i % 3 == 0) {
+            assertTrue(parcHashMap_Remove(instance, key), "Expect Remove to succeed");
+        }
+        _collider_Release(&key);
+    }
+    assertTrue(parcHashMap_Size(instance) == 66, "Expected 66, actual %zd", parcHashMap_Size(instance));
+
+    parcHashMap_Release(&instance);
+}
+
+LONGBOW_TEST_CASE(Flat, parcHashMap_GetClusteringNumber)
+{
+    PARCHashMap *instance = _flatHashMap_CreateWithIntegers(1000);
+
+    double clusteringNumber = parcHashMap_GetClusteringNumber(instance);
+    if (clusteringNumber > 3.0) {
+        testWarn("Oddly high clustering number detected.");
+    }
+
+    parcHashMap_Release(&instance);
+}
+
+LONGBOW_TEST_CASE(Flat, parcHashMap_ValueIterator)
+{
+    const uint32_t testRunSize = 100;
+    PARCHashMap *instance = _flatHashMap_CreateWithIntegers(testRunSize);
+
+    PARCIterator *iterator = parcHashMap_CreateValueIterator(instance);
+
+    uint32_t count = 0;
+    while (parcIterator_HasNext(iterator)) {
+        PARCBuffer *actual = parcIterator_Next(iterator);
+        assertNotNull(actual, "Expected parcIterator_Next to return non-null");
+        assertTrue(parcBuffer_Remaining(actual) > 0, "The same value appeared more than once in the iteration");
+        parcBuffer_SetPosition(actual, parcBuffer_Limit(actual));
+        count++;
+    }
+    parcIterator_Release(&iterator);
+
+    assertTrue(count == testRunSize, "Expected %u values, actual %u", testRunSize, count);
+
+    parcHashMap_Release(&instance);
+}
+
+LONGBOW_TEST_CASE(Flat, parcHashMap_KeyIterator_Remove)
+{
+    PARCHashMap *instance = _flatHashMap_CreateWithIntegers(100);
+
+    PARCIterator *iterator = parcHashMap_CreateKeyIterator(instance);
+
+    while (parcIterator_HasNext(iterator)) {
+        PARCBuffer *key = parcBuffer_Acquire(parcIterator_Next(iterator));
+        parcIterator_Remove(iterator);
+        assertNull(parcHashMap_Get(instance, key), "Expected deleted entry to not be gettable.");
+        parcBuffer_Release(&key);
+    }
+    parcIterator_Release(&iterator);
+
+    assertTrue(parcHashMap_Size(instance) == 0, "Expected 0, actual %zd", parcHashMap_Size(instance));
+    assertTrue(instance->tombstones == 0, "Expected releasing the iterator to purge all tombstones.");
+
+    parcHashMap_Release(&instance);
+}
+
+LONGBOW_TEST_CASE(Flat, parcHashMap_KeyIterator_RemoveSome)
+{
+    PARCHashMap *instance = _flatHashMap_CreateWithIntegers(1000);
+
+    PARCIterator *iterator = parcHashMap_CreateKeyIterator(instance);
+
+    size_t visited = 0;
+    while (parcIterator_HasNext(iterator)) {
+        PARCBuffer *key = parcIterator_Next(iterator);
+        if (parcBuffer_GetUint32(key) % 2 == 0) {
+            parcIterator_Remove(iterator);
+        } else {
+            parcBuffer_Rewind(key);
+        }
+        visited++;
+    }
+    parcIterator_Release(&iterator);
+
+    assertTrue(visited == 1000, "Expected to visit each key once, actual %zu", visited);
+    assertTrue(parcHashMap_Size(instance) == 500, "Expected 500, actual %zd", parcHashMap_Size(instance));
+    for (uint32_t i = 1; i < 1000; i += 2) {
+        _flatHashMap_AssertIntegers(instance, i, i + 1);
+    }
+
+    parcHashMap_Release(&instance);
+}
+
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, parcHashMap_Chained_PutGet);
+    LONGBOW_RUN_TEST_CASE(Performance, parcHashMap_Flat_PutGet);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    parcMemory_SetInterface(&PARCStdlibMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+static void
+_hashMapPerformance_PutGet(const char *name, PARCHashMap *instance)
+{
+    const int testRunSize = 1000000;
+
+    _Int **keys = parcMemory_Allocate(testRunSize * sizeof(_Int *));
+    for (int i = 0; i < testRunSize; ++i) {
+        keys[i] = _int_Create(i * 2654435761U);
+    }
+
+    struct timeval start, end, elapsed;
+
+    gettimeofday(&start, NULL);
+    for (int i = 0; i < testRunSize; ++i) {
+        parcHashMap_Put(instance, keys[i], keys[i]);
+    }
+    gettimeofday(&end, NULL);
+    timersub(&end, &start, &elapsed);
+    printf("%s: %d Puts in %ld.%06ld seconds\n", name, testRunSize, (long) elapsed.tv_sec, (long) elapsed.tv_usec);
+
+    gettimeofday(&start, NULL);
+    for (int i = 0; i < testRunSize; ++i) {
+        assertTrue(parcHashMap_Get(instance, keys[i]) == keys[i], "Expected to find key %d", i);
+    }
+    gettimeofday(&end, NULL);
+    timersub(&end, &start, &elapsed);
+    printf("%s: %d Gets in %ld.%06ld seconds\n", name, testRunSize, (long) elapsed.tv_sec, (long) elapsed.tv_usec);
+
+    parcHashMap_Release(&instance);
+    for (int i = 0; i < testRunSize; ++i) {
+        _int_Release(&keys[i]);
+    }
+    parcMemory_Deallocate(&keys);
+}
+
+LONGBOW_TEST_CASE(Performance, parcHashMap_Chained_PutGet)
+{
+    _hashMapPerformance_PutGet("chained", parcHashMap_Create());
+}
+
+LONGBOW_TEST_CASE(Performance, parcHashMap_Flat_PutGet)
+{
+    _hashMapPerformance_PutGet("flat", parcHashMap_CreateFlat());
+}
+
 int
 main(int argc, char *argv[argc])
 {
@@ -187,7 +187,7 @@ LONGBOW_TEST_CASE(JSON, parcJSON_HashCode)
 {
     TestData *data = longBowTestCase_GetClipBoardData(testCase);
 
-    PARCHashCode expected = parcHashCode_Hash((uint8_t *)data->compactExpected, strlen(data->compactExpected));
+    PARCHashCode expected = parcHashCode_HashData((uint8_t *)data->compactExpected, strlen(data->compactExpected));
 
     PARCHashCode hashCode = parcJSON_HashCode(data->json);
 
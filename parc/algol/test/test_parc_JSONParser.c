@@ -57,13 +57,16 @@
 
 #include <stdio.h>
 #include <fcntl.h>
+#include <inttypes.h>
 #include <math.h>
+#include <sys/time.h>
 
 // Include the file(s) containing the functions to be tested.
 // This permits internal static functions to be visible to this Test Framework.
 
 #include "../parc_JSONParser.c"
 
+#include <parc/algol/parc_JSON.h>
 #include <parc/algol/parc_JSONValue.h>
 
 #include <parc/algol/parc_List.h>
@@ -80,7 +83,8 @@ LONGBOW_TEST_RUNNER(parc_JSONParser)
     LONGBOW_RUN_TEST_FIXTURE(Static);
     LONGBOW_RUN_TEST_FIXTURE(JSONParse_CreateAcquireRelease);
     LONGBOW_RUN_TEST_FIXTURE(JSONParse);
-//    LONGBOW_RUN_TEST_FIXTURE(Performance);
+    LONGBOW_RUN_TEST_FIXTURE(JSONParseEvents);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
 }
 
 // The Test Runner calls this function once before any Test Fixtures are run.
@@ -289,6 +293,481 @@ LONGBOW_TEST_CASE(JSONParse, parcJSON_ParseFileToString)
     parcJSON_Release(&json);
 }
 
+LONGBOW_TEST_FIXTURE(JSONParseEvents)
+{
+    LONGBOW_RUN_TEST_CASE(JSONParseEvents, parcJSONParser_NextEvent);
+    LONGBOW_RUN_TEST_CASE(JSONParseEvents, parcJSONParser_NextEvent_Empty);
+    LONGBOW_RUN_TEST_CASE(JSONParseEvents, parcJSONParser_NextEvent_Scalar);
+    LONGBOW_RUN_TEST_CASE(JSONParseEvents, parcJSONParser_NextEvent_EndDocument);
+    LONGBOW_RUN_TEST_CASE(JSONParseEvents, parcJSONParser_NextEvent_Errors);
+    LONGBOW_RUN_TEST_CASE(JSONParseEvents, parcJSONParser_NextEvent_Nesting);
+    LONGBOW_RUN_TEST_CASE(JSONParseEvents, parcJSONParser_NextEvent_File);
+    LONGBOW_RUN_TEST_CASE(JSONParseEvents, parcJSONParser_GetEventString_ZeroCopy);
+    LONGBOW_RUN_TEST_CASE(JSONParseEvents, parcJSONParser_GetEventString_Escapes);
+    LONGBOW_RUN_TEST_CASE(JSONParseEvents, parcJSONParser_GetEventString_BadEscapes);
+    LONGBOW_RUN_TEST_CASE(JSONParseEvents, parcJSONParser_GetEventInteger);
+    LONGBOW_RUN_TEST_CASE(JSONParseEvents, parcJSONParser_GetEventFloat);
+    LONGBOW_RUN_TEST_CASE(JSONParseEvents, parcJSONParser_ParseEvents);
+    LONGBOW_RUN_TEST_CASE(JSONParseEvents, parcJSONParser_ParseEvents_Stop);
+    LONGBOW_RUN_TEST_CASE(JSONParseEvents, parcJSONParser_SkipValue);
+    LONGBOW_RUN_TEST_CASE(JSONParseEvents, parcJSONParser_ParseString_Empty);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(JSONParseEvents)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(JSONParseEvents)
+{
+    uint32_t outstandingAllocations = parcSafeMemory_ReportAllocation(STDOUT_FILENO);
+    if (outstandingAllocations != 0) {
+        printf("Errors %s leaks memory by %d allocations\n", longBowTestCase_GetName(testCase), outstandingAllocations);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+/*
+ * Append a compact description of an event to trace: { } [ ] k:<key> s:<string> n:<number> true false null $ and !
+ */
+static void
+_traceEvent(PARCJSONParser *parser, PARCJSONParserEvent event, PARCBufferComposer *trace)
+{
+    char *text = NULL;
+
+    switch (event) {
+        case PARCJSONParserEvent_StartObject:
+            parcBufferComposer_PutString(trace, "{ ");
+            break;
+        case PARCJSONParserEvent_EndObject:
+            parcBufferComposer_PutString(trace, "} ");
+            break;
+        case PARCJSONParserEvent_StartArray:
+            parcBufferComposer_PutString(trace, "[ ");
+            break;
+        case PARCJSONParserEvent_EndArray:
+            parcBufferComposer_PutString(trace, "] ");
+            break;
+        case PARCJSONParserEvent_Key:
+            text = parcBuffer_ToString(parcJSONParser_GetEventString(parser));
+            parcBufferComposer_Format(trace, "k:%s ", text);
+            break;
+        case PARCJSONParserEvent_String:
+            text = parcBuffer_ToString(parcJSONParser_GetEventString(parser));
+            parcBufferComposer_Format(trace, "s:%s ", text);
+            break;
+        case PARCJSONParserEvent_Number:
+            text = parcBuffer_ToString(parcJSONParser_GetEventString(parser));
+            parcBufferComposer_Format(trace, "n:%s ", text);
+            break;
+        case PARCJSONParserEvent_Boolean:
+            parcBufferComposer_PutString(trace, parcJSONParser_GetEventBoolean(parser) ? "true " : "false ");
+            break;
+        case PARCJSONParserEvent_Null:
+            parcBufferComposer_PutString(trace, "null ");
+            break;
+        case PARCJSONParserEvent_EndDocument:
+            parcBufferComposer_PutString(trace, "$");
+            break;
+        case PARCJSONParserEvent_Error:
+            parcBufferComposer_PutString(trace, "!");
+            break;
+    }
+
+    if (text != NULL) {
+        parcMemory_Deallocate(&text);
+    }
+}
+
+/*
+ * Parse the given JSON text with parcJSONParser_NextEvent and return the trace of its events.
+ */
+static char *
+_traceEvents(const char *json)
+{
+    PARCBuffer *buffer = parcBuffer_AllocateCString(json);
+    PARCJSONParser *parser = parcJSONParser_Create(buffer);
+    PARCBufferComposer *trace = parcBufferComposer_Create();
+
+    PARCJSONParserEvent event;
+    do {
+        event = parcJSONParser_NextEvent(parser);
+        _traceEvent(parser, event, trace);
+    } while (event != PARCJSONParserEvent_EndDocument && event != PARCJSONParserEvent_Error);
+
+    char *result = parcBufferComposer_ToString(trace);
+
+    parcBufferComposer_Release(&trace);
+    parcJSONParser_Release(&parser);
+    parcBuffer_Release(&buffer);
+    return result;
+}
+
+static void
+_assertTrace(const char *json, const char *expected)
+{
+    char *actual = _traceEvents(json);
+    assertTrue(strcmp(expected, actual) == 0, "For %s expected '%s', actual '%s'", json, expected, actual);
+    parcMemory_Deallocate(&actual);
+}
+
+LONGBOW_TEST_CASE(JSONParseEvents, parcJSONParser_NextEvent)
+{
+    _assertTrace("{ \"string\" : \"string\", \"null\" : null, \"true\" : true, \"false\" : false, \"integer\" : 31415, "
+                 "\"float\" : -3.1415e+2, \"array\" : [ null, false, true, 31415, \"string\", [ ], { } ] }",
+                 "{ k:string s:string k:null null k:true true k:false false k:integer n:31415 "
+                 "k:float n:-3.1415e+2 k:array [ null false true n:31415 s:string [ ] { } ] } $");
+
+    _assertTrace("\r\n\t[1,{\"a\":[]}]\r\n", "[ n:1 { k:a [ ] } ] $");
+}
+
+LONGBOW_TEST_CASE(JSONParseEvents, parcJSONParser_NextEvent_Empty)
+{
+    _assertTrace("", "!");
+    _assertTrace(" \n ", "!");
+    _assertTrace("{}", "{ } $");
+    _assertTrace("[]", "[ ] $");
+    _assertTrace("{\"\":\"\"}", "{ k: s: } $");
+}
+
+LONGBOW_TEST_CASE(JSONParseEvents, parcJSONParser_NextEvent_Scalar)
+{
+    _assertTrace("\"string\"", "s:string $");
+    _assertTrace("-0.5", "n:-0.5 $");
+    _assertTrace("true", "true $");
+    _assertTrace("null", "null $");
+}
+
+LONGBOW_TEST_CASE(JSONParseEvents, parcJSONParser_NextEvent_EndDocument)
+{
+    PARCBuffer *buffer = parcBuffer_WrapCString("{ \"a\" : 1 } [ 2 ]");
+    PARCJSONParser *parser = parcJSONParser_Create(buffer);
+
+    while (parcJSONParser_NextEvent(parser) != PARCJSONParserEvent_EndDocument) {
+    }
+    assertTrue(parcJSONParser_NextEvent(parser) == PARCJSONParserEvent_EndDocument,
+               "Expected PARCJSONParserEvent_EndDocument to be repeated");
+    assertTrue(parcJSONParser_Remaining(parser) == 6, "Expected the parser to stop after the first document");
+
+    parcJSONParser_Release(&parser);
+
+    // The rest of the buffer is the next document.
+    parser = parcJSONParser_Create(buffer);
+    assertTrue(parcJSONParser_NextEvent(parser) == PARCJSONParserEvent_StartArray, "Expected the second document");
+
+    parcJSONParser_Release(&parser);
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(JSONParseEvents, parcJSONParser_NextEvent_Errors)
+{
+    char *documents[] = {
+        "{",          "[",          "[1,]",      "[1 2]",    "[,1]",       "{\"a\" 1}",     "{\"a\":1,}",
+        "{\"a\":1 \"b\":2}", "{1:2}", "{\"a\"}",    "[}",         "{]",         "]",             "}",
+        ",",          "01",         "-",         "1.",       "1.e1",       "1e",            "1e+",
+        "+1",         ".5",         "1x",        "tru",      "nullx",      "True",          "\"abc",
+        "\"a\nb\"",   "[\"a\" : 1]", "'a'",      NULL
+    };
+
+    for (int i = 0; documents[i] != NULL; i++) {
+        char *trace = _traceEvents(documents[i]);
+        assertTrue(trace[strlen(trace) - 1] == '!', "Expected an error for %s, actual '%s'", documents[i], trace);
+        parcMemory_Deallocate(&trace);
+    }
+
+    // The error is sticky, and the parser is left at the offending character.
+    PARCBuffer *buffer = parcBuffer_WrapCString("[ 1, x ]");
+    PARCJSONParser *parser = parcJSONParser_Create(buffer);
+    parcJSONParser_NextEvent(parser);
+    parcJSONParser_NextEvent(parser);
+    assertTrue(parcJSONParser_NextEvent(parser) == PARCJSONParserEvent_Error, "Expected an error");
+    assertTrue(parcJSONParser_NextEvent(parser) == PARCJSONParserEvent_Error, "Expected the error to be repeated");
+    assertTrue(parcJSONParser_Remaining(parser) == 3, "Expected the parser at the offending character");
+
+    parcJSONParser_Release(&parser);
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(JSONParseEvents, parcJSONParser_NextEvent_Nesting)
+{
+    // Deeper than the initial container stack.
+    const int depth = 100;
+    PARCBufferComposer *composer = parcBufferComposer_Create();
+    for (int i = 0; i < depth; i++) {
+        parcBufferComposer_PutString(composer, "{\"a\":[");
+    }
+    for (int i = 0; i < depth; i++) {
+        parcBufferComposer_PutString(composer, "]}");
+    }
+    PARCBuffer *buffer = parcBufferComposer_ProduceBuffer(composer);
+    PARCJSONParser *parser = parcJSONParser_Create(buffer);
+
+    size_t maxDepth = 0;
+    size_t events = 0;
+    PARCJSONParserEvent event;
+    while ((event = parcJSONParser_NextEvent(parser)) != PARCJSONParserEvent_EndDocument) {
+        assertTrue(event != PARCJSONParserEvent_Error, "Unexpected error");
+        if (parcJSONParser_GetDepth(parser) > maxDepth) {
+            maxDepth = parcJSONParser_GetDepth(parser);
+        }
+        events++;
+    }
+    assertTrue(maxDepth == 2 * depth, "Expected depth %d, actual %zu", 2 * depth, maxDepth);
+    assertTrue(events == 5 * depth, "Expected %d events, actual %zu", 5 * depth, events);
+    assertTrue(parcJSONParser_GetDepth(parser) == 0, "Expected depth 0 at the end of the document");
+
+    parcJSONParser_Release(&parser);
+    parcBuffer_Release(&buffer);
+    parcBufferComposer_Release(&composer);
+}
+
+LONGBOW_TEST_CASE(JSONParseEvents, parcJSONParser_NextEvent_File)
+{
+    char *string = NULL;
+    size_t nread = longBowDebug_ReadFile("data.json", &string);
+    assertTrue(nread != -1, "Cannot read '%s'", "data.json");
+
+    char *trace = _traceEvents(string);
+    assertTrue(trace[strlen(trace) - 1] == '$', "Expected the whole file to be parsed");
+    parcMemory_Deallocate(&trace);
+    free(string);
+}
+
+LONGBOW_TEST_CASE(JSONParseEvents, parcJSONParser_GetEventString_ZeroCopy)
+{
+    PARCBuffer *buffer = parcBuffer_WrapCString("{ \"name\" : \"value\" }");
+    PARCJSONParser *parser = parcJSONParser_Create(buffer);
+
+    parcJSONParser_NextEvent(parser);
+    assertTrue(parcJSONParser_NextEvent(parser) == PARCJSONParserEvent_Key, "Expected a key");
+    PARCBuffer *key = parcJSONParser_GetEventString(parser);
+    assertTrue(parcBuffer_Array(key) == parcBuffer_Array(buffer), "Expected the key to share the parsed buffer");
+    assertTrue(parcBuffer_Remaining(key) == 4, "Expected 4 bytes, actual %zu", parcBuffer_Remaining(key));
+
+    assertTrue(parcJSONParser_NextEvent(parser) == PARCJSONParserEvent_String, "Expected a string");
+    PARCBuffer *value = parcJSONParser_GetEventString(parser);
+    assertTrue(parcBuffer_Array(value) == parcBuffer_Array(buffer), "Expected the value to share the parsed buffer");
+
+    // A slice outlives the event.
+    PARCBuffer *slice = parcBuffer_Slice(value);
+    parcJSONParser_NextEvent(parser);
+    PARCBuffer *expected = parcBuffer_WrapCString("value");
+    assertTrue(parcBuffer_Equals(expected, slice), "Expected the slice to keep the value");
+
+    parcBuffer_Release(&expected);
+    parcBuffer_Release(&slice);
+    parcJSONParser_Release(&parser);
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(JSONParseEvents, parcJSONParser_GetEventString_Escapes)
+{
+    PARCBuffer *buffer = parcBuffer_WrapCString("[ \"\\\" \\\\ \\/ \\b \\f \\n \\r \\t\", \"\\u0041\\u00e9\\u20ac\\ud83d\\ude00\", \"plain\" ]");
+    PARCJSONParser *parser = parcJSONParser_Create(buffer);
+    parcJSONParser_NextEvent(parser);
+
+    parcJSONParser_NextEvent(parser);
+    PARCBuffer *expected = parcBuffer_AllocateCString("\" \\ / \b \f \n \r \t");
+    assertTrue(parcBuffer_Equals(expected, parcJSONParser_GetEventString(parser)), "Expected the escapes to be decoded");
+    assertTrue(parcBuffer_Array(parcJSONParser_GetEventString(parser)) != parcBuffer_Array(buffer),
+               "Expected a decoded copy");
+    parcBuffer_Release(&expected);
+
+    parcJSONParser_NextEvent(parser);
+    expected = parcBuffer_AllocateCString("A\xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80");
+    assertTrue(parcBuffer_Equals(expected, parcJSONParser_GetEventString(parser)), "Expected UTF-8");
+    parcBuffer_Release(&expected);
+
+    parcJSONParser_NextEvent(parser);
+    expected = parcBuffer_AllocateCString("plain");
+    assertTrue(parcBuffer_Equals(expected, parcJSONParser_GetEventString(parser)), "Expected a plain string after escapes");
+    parcBuffer_Release(&expected);
+
+    parcJSONParser_Release(&parser);
+    parcBuffer_Release(&buffer);
+
+    // Keys are decoded too, and a long string grows the decoding buffer.
+    PARCBufferComposer *composer = parcBufferComposer_Create();
+    parcBufferComposer_PutString(composer, "{ \"k\\u0065y\" : \"");
+    for (int i = 0; i < 1000; i++) {
+        parcBufferComposer_PutString(composer, "\\n");
+    }
+    parcBufferComposer_PutString(composer, "\" }");
+    buffer = parcBufferComposer_ProduceBuffer(composer);
+    parser = parcJSONParser_Create(buffer);
+    parcJSONParser_NextEvent(parser);
+
+    parcJSONParser_NextEvent(parser);
+    expected = parcBuffer_WrapCString("key");
+    assertTrue(parcBuffer_Equals(expected, parcJSONParser_GetEventString(parser)), "Expected the key to be decoded");
+    parcBuffer_Release(&expected);
+
+    assertTrue(parcJSONParser_NextEvent(parser) == PARCJSONParserEvent_String, "Expected a string");
+    assertTrue(parcBuffer_Remaining(parcJSONParser_GetEventString(parser)) == 1000, "Expected 1000 new-lines");
+
+    parcJSONParser_Release(&parser);
+    parcBuffer_Release(&buffer);
+    parcBufferComposer_Release(&composer);
+}
+
+LONGBOW_TEST_CASE(JSONParseEvents, parcJSONParser_GetEventString_BadEscapes)
+{
+    _assertTrace("\"\\x\"", "!");
+    _assertTrace("\"\\u12\"", "!");
+    _assertTrace("\"\\u12g4\"", "!");
+    _assertTrace("\"\\ude00\"", "!");
+    _assertTrace("\"\\ud83d\"", "!");
+    _assertTrace("\"\\ud83d\\u0041\"", "!");
+    _assertTrace("\"\\", "!");
+    _assertTrace("{ \"\\q\" : 1 }", "{ !");
+}
+
+LONGBOW_TEST_CASE(JSONParseEvents, parcJSONParser_GetEventInteger)
+{
+    PARCBuffer *buffer = parcBuffer_WrapCString("[ 0, -0, 31415, -31415, 9223372036854775807, 2.5e2, 1e3, -7.6 ]");
+    PARCJSONParser *parser = parcJSONParser_Create(buffer);
+    parcJSONParser_NextEvent(parser);
+
+    int64_t expected[] = { 0, 0, 31415, -31415, INT64_MAX, 250, 1000, -8 };
+    for (int i = 0; i < sizeof(expected) / sizeof(expected[0]); i++) {
+        assertTrue(parcJSONParser_NextEvent(parser) == PARCJSONParserEvent_Number, "Expected a number");
+        int64_t actual = parcJSONParser_GetEventInteger(parser);
+        assertTrue(actual == expected[i], "Expected %" PRId64 ", actual %" PRId64, expected[i], actual);
+    }
+    assertTrue(parcJSONParser_NextEvent(parser) == PARCJSONParserEvent_EndArray, "Expected the end of the array");
+
+    parcJSONParser_Release(&parser);
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(JSONParseEvents, parcJSONParser_GetEventFloat)
+{
+    PARCBuffer *buffer = parcBuffer_WrapCString("[ 3.1415, -0.25, 1.5e3, 25E-2, 0.1234567890123456789, 7 ]");
+    PARCJSONParser *parser = parcJSONParser_Create(buffer);
+    parcJSONParser_NextEvent(parser);
+
+    long double expected[] = { 3.1415L, -0.25L, 1500.0L, 0.25L, 0.123456789012345678L, 7.0L };
+    for (int i = 0; i < sizeof(expected) / sizeof(expected[0]); i++) {
+        assertTrue(parcJSONParser_NextEvent(parser) == PARCJSONParserEvent_Number, "Expected a number");
+        long double actual = parcJSONParser_GetEventFloat(parser);
+        assertTrue(fabsl(actual - expected[i]) < 1e-12L, "Expected %Lf, actual %Lf", expected[i], actual);
+    }
+
+    parcJSONParser_Release(&parser);
+    parcBuffer_Release(&buffer);
+}
+
+static bool
+_traceHandler(PARCJSONParser *parser, PARCJSONParserEvent event, void *context)
+{
+    _traceEvent(parser, event, context);
+    return true;
+}
+
+LONGBOW_TEST_CASE(JSONParseEvents, parcJSONParser_ParseEvents)
+{
+    PARCBuffer *buffer = parcBuffer_WrapCString("{ \"a\" : [ 1, \"b\", null ] }");
+    PARCJSONParser *parser = parcJSONParser_Create(buffer);
+    PARCBufferComposer *trace = parcBufferComposer_Create();
+
+    bool success = parcJSONParser_ParseEvents(parser, _traceHandler, trace);
+    assertTrue(success, "Expected parcJSONParser_ParseEvents to succeed");
+
+    char *actual = parcBufferComposer_ToString(trace);
+    assertTrue(strcmp(actual, "{ k:a [ n:1 s:b null ] } $") == 0, "Unexpected events '%s'", actual);
+    parcMemory_Deallocate(&actual);
+    parcBufferComposer_Release(&trace);
+    parcJSONParser_Release(&parser);
+    parcBuffer_Release(&buffer);
+
+    buffer = parcBuffer_WrapCString("{ \"a\" : [ 1, \"b\", null }");
+    parser = parcJSONParser_Create(buffer);
+    trace = parcBufferComposer_Create();
+
+    success = parcJSONParser_ParseEvents(parser, _traceHandler, trace);
+    assertFalse(success, "Expected parcJSONParser_ParseEvents to fail");
+
+    actual = parcBufferComposer_ToString(trace);
+    assertTrue(strcmp(actual, "{ k:a [ n:1 s:b null !") == 0, "Unexpected events '%s'", actual);
+    parcMemory_Deallocate(&actual);
+    parcBufferComposer_Release(&trace);
+    parcJSONParser_Release(&parser);
+    parcBuffer_Release(&buffer);
+}
+
+static bool
+_stopAtNumber(PARCJSONParser *parser, PARCJSONParserEvent event, void *context)
+{
+    (*(int *) context)++;
+    return event != PARCJSONParserEvent_Number;
+}
+
+LONGBOW_TEST_CASE(JSONParseEvents, parcJSONParser_ParseEvents_Stop)
+{
+    PARCBuffer *buffer = parcBuffer_WrapCString("[ \"a\", 1, 2 ]");
+    PARCJSONParser *parser = parcJSONParser_Create(buffer);
+
+    int count = 0;
+    bool success = parcJSONParser_ParseEvents(parser, _stopAtNumber, &count);
+    assertFalse(success, "Expected parcJSONParser_ParseEvents to stop");
+    assertTrue(count == 3, "Expected 3 events, actual %d", count);
+
+    // Parsing can continue where the handler stopped.
+    assertTrue(parcJSONParser_NextEvent(parser) == PARCJSONParserEvent_Number, "Expected the next number");
+    assertTrue(parcJSONParser_GetEventInteger(parser) == 2, "Expected 2");
+
+    parcJSONParser_Release(&parser);
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(JSONParseEvents, parcJSONParser_SkipValue)
+{
+    PARCBuffer *buffer = parcBuffer_WrapCString("{ \"skip\" : { \"a\" : [ 1, { } ], \"b\" : 2 }, \"also\" : \"x\", \"name\" : 123 }");
+    PARCJSONParser *parser = parcJSONParser_Create(buffer);
+    PARCBuffer *name = parcBuffer_WrapCString("name");
+
+    parcJSONParser_NextEvent(parser);
+    int64_t value = 0;
+    while (parcJSONParser_NextEvent(parser) == PARCJSONParserEvent_Key) {
+        if (parcBuffer_Equals(parcJSONParser_GetEventString(parser), name)) {
+            parcJSONParser_NextEvent(parser);
+            value = parcJSONParser_GetEventInteger(parser);
+        } else {
+            assertTrue(parcJSONParser_SkipValue(parser), "Expected parcJSONParser_SkipValue to succeed");
+            assertTrue(parcJSONParser_GetDepth(parser) == 1, "Expected to be back in the outer object");
+        }
+    }
+    assertTrue(value == 123, "Expected 123, actual %" PRId64, value);
+    assertTrue(parcJSONParser_NextEvent(parser) == PARCJSONParserEvent_EndDocument, "Expected the end of the document");
+
+    parcBuffer_Release(&name);
+    parcJSONParser_Release(&parser);
+    parcBuffer_Release(&buffer);
+
+    buffer = parcBuffer_WrapCString("[ [ 1, ] ]");
+    parser = parcJSONParser_Create(buffer);
+    parcJSONParser_NextEvent(parser);
+    assertFalse(parcJSONParser_SkipValue(parser), "Expected parcJSONParser_SkipValue to fail on a syntax error");
+    parcJSONParser_Release(&parser);
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(JSONParseEvents, parcJSONParser_ParseString_Empty)
+{
+    PARCBuffer *buffer = parcBuffer_WrapCString("\"\"");
+    PARCJSONParser *parser = parcJSONParser_Create(buffer);
+
+    PARCBuffer *actual = parcJSONParser_ParseString(parser);
+    assertNotNull(actual, "Expected an empty string");
+    assertTrue(parcBuffer_Remaining(actual) == 0, "Expected an empty string");
+    assertTrue(parcJSONParser_Remaining(parser) == 0, "Expected the closing quote to be consumed");
+
+    parcBuffer_Release(&actual);
+    parcJSONParser_Release(&parser);
+    parcBuffer_Release(&buffer);
+}
+
 LONGBOW_TEST_FIXTURE(Static)
 {
 }
@@ -303,9 +782,10 @@ LONGBOW_TEST_FIXTURE_TEARDOWN(Static)
     return LONGBOW_STATUS_SUCCEEDED;
 }
 
-LONGBOW_TEST_FIXTURE(Performance)
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
 {
     LONGBOW_RUN_TEST_CASE(Performance, parcJSON_ParseFileToString);
+    LONGBOW_RUN_TEST_CASE(Performance, parcJSONParser_NextEvent_Throughput);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Performance)
@@ -339,6 +819,66 @@ LONGBOW_TEST_CASE(Performance, parcJSON_ParseFileToString)
     parcJSON_Release(&json);
 }
 
+/*
+ * A document of about 1 MB: an array of the small objects typical of configuration and telemetry.
+ */
+static PARCBuffer *
+_createDocument(void)
+{
+    PARCBufferComposer *composer = parcBufferComposer_Create();
+    parcBufferComposer_PutString(composer, "{ \"readings\" : [");
+    for (int i = 0; i < 10000; i++) {
+        parcBufferComposer_Format(composer,
+                                  "%s{ \"id\" : %d, \"name\" : \"sensor-%d\", \"value\" : %d.25, \"unit\" : \"kPa\", "
+                                  "\"tags\" : [ \"north\", \"level-2\" ], \"enabled\" : true, \"note\" : null }",
+                                  (i == 0) ? "" : ", ", i, i, i);
+    }
+    parcBufferComposer_PutString(composer, "] }");
+    PARCBuffer *result = parcBufferComposer_ProduceBuffer(composer);
+    parcBufferComposer_Release(&composer);
+    return result;
+}
+
+LONGBOW_TEST_CASE(Performance, parcJSONParser_NextEvent_Throughput)
+{
+    const int iterations = 20;
+    PARCBuffer *document = _createDocument();
+    size_t length = parcBuffer_Remaining(document);
+
+    struct timeval start, end;
+    gettimeofday(&start, NULL);
+    for (int i = 0; i < iterations; i++) {
+        PARCJSON *json = parcJSON_ParseBuffer(document);
+        assertNotNull(json, "parcJSON_ParseBuffer failed");
+        parcJSON_Release(&json);
+        parcBuffer_Rewind(document);
+    }
+    gettimeofday(&end, NULL);
+    double seconds = (end.tv_sec - start.tv_sec) + (end.tv_usec - start.tv_usec) / 1e6;
+    printf("parcJSON_ParseBuffer: %zu bytes, %.1f MB/s\n", length, iterations * length / seconds / 1e6);
+
+    gettimeofday(&start, NULL);
+    int64_t sum = 0;
+    for (int i = 0; i < iterations; i++) {
+        PARCJSONParser *parser = parcJSONParser_Create(document);
+        PARCJSONParserEvent event;
+        while ((event = parcJSONParser_NextEvent(parser)) != PARCJSONParserEvent_EndDocument) {
+            assertTrue(event != PARCJSONParserEvent_Error, "parcJSONParser_NextEvent failed");
+            if (event == PARCJSONParserEvent_Number) {
+                sum += parcJSONParser_GetEventInteger(parser);
+            }
+        }
+        parcJSONParser_Release(&parser);
+        parcBuffer_Rewind(document);
+    }
+    gettimeofday(&end, NULL);
+    seconds = (end.tv_sec - start.tv_sec) + (end.tv_usec - start.tv_usec) / 1e6;
+    printf("parcJSONParser_NextEvent: %zu bytes, %.1f MB/s (checksum %" PRId64 ")\n",
+           length, iterations * length / seconds / 1e6, sum);
+
+    parcBuffer_Release(&document);
+}
+
 int
 main(int argc, char *argv[])
 {
@@ -58,6 +58,7 @@
 #include <LongBow/unit-test.h>
 
 #include <parc/algol/parc_SafeMemory.h>
+#include <parc/algol/parc_StdlibMemory.h>
 
 // Include the file(s) containing the functions to be tested.
 // This permits internal static functions to be visible to this Test Framework.
@@ -94,6 +95,7 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, parcMemory_Reallocate);
     LONGBOW_RUN_TEST_CASE(Global, parcMemory_StringDuplicate);
     LONGBOW_RUN_TEST_CASE(Global, parcMemory_Outstanding);
+    LONGBOW_RUN_TEST_CASE(Global, parcMemory_GetStatistics);
     LONGBOW_RUN_TEST_CASE(Global, parcMemory_SetInterface);
     LONGBOW_RUN_TEST_CASE(Global, parcMemory_Format);
 }
@@ -217,6 +219,26 @@ LONGBOW_TEST_CASE(Global, parcMemory_Outstanding)
     assertTrue(expected == actual, "Expected %zd, actual %zd", expected, actual);
 }
 
+LONGBOW_TEST_CASE(Global, parcMemory_GetStatistics)
+{
+    const PARCMemoryInterface *old = parcMemory_SetInterface(&PARCStdlibMemoryAsPARCMemory);
+
+    PARCMemoryStatistics before;
+    PARCMemoryStatistics thread;
+    assertTrue(parcMemory_GetStatistics(&before, &thread), "Expected the stdlib interface to keep statistics");
+
+    void *pointer = parcMemory_Allocate(sizeof(int));
+    PARCMemoryStatistics after;
+    parcMemory_GetStatistics(&after, NULL);
+    assertTrue(after.allocations == before.allocations + 1, "Expected one more allocation");
+    parcMemory_Deallocate(&pointer);
+
+    parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+    assertFalse(parcMemory_GetStatistics(&before, &thread), "Expected the safe memory interface not to keep statistics");
+
+    parcMemory_SetInterface(old);
+}
+
 LONGBOW_TEST_CASE(Global, parcMemory_SetInterface)
 {
     const PARCMemoryInterface *old = parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
@@ -316,6 +316,8 @@ LONGBOW_TEST_CASE(Static, _parcObject_PrefixLength)
         size_t actual = _parcObject_PrefixLength(&descriptor);
         assertTrue((actual & (descriptor.objectAlignment - 1)) == 0,
                    "Alignment needs to be a multiple of %u", descriptor.objectAlignment);
+        assertTrue(actual >= sizeof(_PARCObjectHeader),
+                   "Expected the prefix length %zu to be at least the size of the header %zu", actual, sizeof(_PARCObjectHeader));
     }
 }
 
@@ -938,6 +940,8 @@ LONGBOW_TEST_FIXTURE(Locking)
     LONGBOW_RUN_TEST_CASE(Locking, parcObject_Lock_Unlock);
     LONGBOW_RUN_TEST_CASE(Locking, parcObject_TryLock_AlreadyLockedSameThread);
     LONGBOW_RUN_TEST_CASE(Locking, parcObject_Lock_AlreadyLocked);
+    LONGBOW_RUN_TEST_CASE(Locking, parcObject_Lock_AttachesLocking);
+    LONGBOW_RUN_TEST_CASE(Locking, parcObject_Lock_NotLockable);
 }
 static uint32_t initialAllocations;
 
@@ -1035,6 +1039,40 @@ LONGBOW_TEST_CASE_EXPECTS(Locking, parcObject_Lock_AlreadyLocked, .event = &Long
     parcObject_Lock(dummy);
 }
 
+LONGBOW_TEST_CASE(Locking, parcObject_Lock_AttachesLocking)
+{
+    _DummyObject *dummy = longBowTestCase_GetClipBoardData(testCase);
+
+    assertNull(_parcObjectHeader_Locking(dummy), "Expected a new object to have no locking structure.");
+    assertFalse(parcObject_IsLocked(dummy), "Expected a never locked object not to be locked.");
+
+    parcObject_Lock(dummy);
+    _PARCObjectLocking *locking = _parcObjectHeader_Locking(dummy);
+    assertNotNull(locking, "Expected parcObject_Lock to attach a locking structure.");
+    parcObject_Unlock(dummy);
+
+    parcObject_Lock(dummy);
+    assertTrue(_parcObjectHeader_Locking(dummy) == locking, "Expected subsequent locks to reuse the locking structure.");
+    parcObject_Unlock(dummy);
+}
+
+typedef struct {
+    int value;
+} _NotLockable;
+
+parcObject_Override(_NotLockable, PARCObject,
+                    .isLockable = false);
+
+LONGBOW_TEST_CASE(Locking, parcObject_Lock_NotLockable)
+{
+    PARCObject *object = parcObject_CreateInstanceImpl(&_NotLockable_Descriptor);
+
+    assertFalse(parcObject_Lock(object), "Expected parcObject_Lock to fail on an object that is not lockable.");
+    assertNull(_parcObjectHeader_Locking(object), "Expected no locking structure on an object that is not lockable.");
+
+    parcObject_Release(&object);
+}
+
 LONGBOW_TEST_FIXTURE(WaitNotify)
 {
     LONGBOW_RUN_TEST_CASE(WaitNotify, parcObject_WaitNotify);
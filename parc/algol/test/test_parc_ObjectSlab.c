@@ -0,0 +1,412 @@
+/*
+ * Copyright (c) 2015, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @author Glenn Scott, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include "../parc_ObjectSlab.c"
+
+#include <stdio.h>
+#include <pthread.h>
+#include <sys/time.h>
+
+#include <LongBow/testing.h>
+#include <LongBow/debugging.h>
+#include <parc/algol/parc_Memory.h>
+#include <parc/algol/parc_SafeMemory.h>
+#include <parc/algol/parc_StdlibMemory.h>
+
+#include <parc/testing/parc_MemoryTesting.h>
+
+typedef struct {
+    uint64_t value[4];
+} _SlabObject;
+
+parcObject_Override(_SlabObject, PARCObject,
+                    .isSlabAllocated = true);
+
+typedef struct {
+    uint64_t value[4];
+} _PlainObject;
+
+parcObject_Override(_PlainObject, PARCObject);
+
+LONGBOW_TEST_RUNNER(parc_ObjectSlab)
+{
+    // The following Test Fixtures will run their corresponding Test Cases.
+    // Test Fixtures are run in the order specified, but all tests should be idempotent.
+    // Never rely on the execution order of tests or share state between them.
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+    LONGBOW_RUN_TEST_FIXTURE(Threads);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
+}
+
+// The Test Runner calls this function once before any Test Fixtures are run.
+LONGBOW_TEST_RUNNER_SETUP(parc_ObjectSlab)
+{
+    parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// The Test Runner calls this function once after all the Test Fixtures are run.
+LONGBOW_TEST_RUNNER_TEARDOWN(parc_ObjectSlab)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, parcObjectSlab_CreateRelease);
+    LONGBOW_RUN_TEST_CASE(Global, parcObjectSlab_Reuse);
+    LONGBOW_RUN_TEST_CASE(Global, parcObjectSlab_GetStatistics);
+    LONGBOW_RUN_TEST_CASE(Global, parcObjectSlab_GetStatistics_NotSlabAllocated);
+    LONGBOW_RUN_TEST_CASE(Global, parcObjectSlab_Depot);
+    LONGBOW_RUN_TEST_CASE(Global, parcObjectSlab_Drain);
+    LONGBOW_RUN_TEST_CASE(Global, parcObjectSlab_SetDescriptor);
+    LONGBOW_RUN_TEST_CASE(Global, parcObjectSlab_Display);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    parcObjectSlab_Drain();
+
+    if (!parcMemoryTesting_ExpectedOutstanding(0, "%s mismanaged memory.", longBowTestCase_GetFullName(testCase))) {
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Global, parcObjectSlab_CreateRelease)
+{
+    _SlabObject *object = parcObject_CreateAndClearInstance(_SlabObject);
+    assertNotNull(object, "Expected parcObject_CreateAndClearInstance to return non-NULL");
+    assertTrue(parcObject_IsValid(object), "Expected a valid object.");
+
+    object->value[3] = 42;
+    _SlabObject *copy = parcObject_Copy(object);
+    assertTrue(parcObject_Equals(object, copy), "Expected the copy to be equal.");
+
+    parcObject_Release((PARCObject **) &object);
+    parcObject_Release((PARCObject **) &copy);
+}
+
+LONGBOW_TEST_CASE(Global, parcObjectSlab_Reuse)
+{
+    _SlabObject *object = parcObject_CreateInstance(_SlabObject);
+    void *expected = object;
+    parcObject_Release((PARCObject **) &object);
+
+    object = parcObject_CreateInstance(_SlabObject);
+    assertTrue((void *) object == expected, "Expected the released block to be reused, expected %p actual %p", expected, (void *) object);
+    parcObject_Release((PARCObject **) &object);
+}
+
+LONGBOW_TEST_CASE(Global, parcObjectSlab_GetStatistics)
+{
+    const int count = 100;
+    _SlabObject *objects[count];
+
+    for (int i = 0; i < count; i++) {
+        objects[i] = parcObject_CreateInstance(_SlabObject);
+    }
+
+    PARCObjectSlabStatistics statistics;
+    bool found = parcObjectSlab_GetStatistics(&_SlabObject_Descriptor, &statistics);
+    assertTrue(found, "Expected statistics for a slab allocated type.");
+    assertTrue(statistics.live == count, "Expected %d live, actual %zu", count, statistics.live);
+    assertTrue(statistics.highWater >= count, "Expected high-water of at least %d, actual %zu", count, statistics.highWater);
+    assertTrue(statistics.blockSize >= sizeof(_SlabObject), "Expected a block size of at least %zu, actual %zu",
+               sizeof(_SlabObject), statistics.blockSize);
+    assertTrue(strcmp(statistics.name, "_SlabObject") == 0, "Expected the descriptor name, actual %s", statistics.name);
+
+    for (int i = 0; i < count; i++) {
+        parcObject_Release((PARCObject **) &objects[i]);
+    }
+
+    parcObjectSlab_GetStatistics(&_SlabObject_Descriptor, &statistics);
+    assertTrue(statistics.live == 0, "Expected 0 live, actual %zu", statistics.live);
+    assertTrue(statistics.cached == count, "Expected %d cached, actual %zu", count, statistics.cached);
+    assertTrue(statistics.highWater >= count, "Expected high-water of at least %d, actual %zu", count, statistics.highWater);
+}
+
+LONGBOW_TEST_CASE(Global, parcObjectSlab_GetStatistics_NotSlabAllocated)
+{
+    _PlainObject *object = parcObject_CreateInstance(_PlainObject);
+
+    PARCObjectSlabStatistics statistics;
+    assertFalse(parcObjectSlab_GetStatistics(&_PlainObject_Descriptor, &statistics),
+                "Expected no statistics for a type that is not slab allocated.");
+
+    parcObject_Release((PARCObject **) &object);
+}
+
+LONGBOW_TEST_CASE(Global, parcObjectSlab_Depot)
+{
+    // Release more blocks than a thread's two magazines hold, so that full magazines move to the depot.
+    const int count = MAGAZINE_CAPACITY * 5;
+    _SlabObject *objects[count];
+
+    for (int i = 0; i < count; i++) {
+        objects[i] = parcObject_CreateInstance(_SlabObject);
+    }
+    for (int i = 0; i < count; i++) {
+        parcObject_Release((PARCObject **) &objects[i]);
+    }
+
+    uint16_t slabId = _parcObjectSlab_Lookup(_parcObjectSlab_ThreadCache(), &_SlabObject_Descriptor,
+                                             parcObject_TotalSize(sizeof(void *), sizeof(_SlabObject)));
+    _PARCObjectSlab *slab = _parcObjectSlab_Slab(slabId);
+    assertTrue(slab->fullMagazineCount > 0, "Expected full magazines in the depot.");
+
+    PARCObjectSlabStatistics statistics;
+    parcObjectSlab_GetStatistics(&_SlabObject_Descriptor, &statistics);
+    assertTrue(statistics.cached == count, "Expected %d cached, actual %zu", count, statistics.cached);
+
+    size_t outstanding = parcMemory_Outstanding();
+    for (int i = 0; i < count; i++) {
+        objects[i] = parcObject_CreateInstance(_SlabObject);
+    }
+    assertTrue(parcMemory_Outstanding() == outstanding, "Expected every allocation to be satisfied from the cache.");
+
+    for (int i = 0; i < count; i++) {
+        parcObject_Release((PARCObject **) &objects[i]);
+    }
+}
+
+LONGBOW_TEST_CASE(Global, parcObjectSlab_Drain)
+{
+    size_t outstanding = parcMemory_Outstanding();
+
+    _SlabObject *object = parcObject_CreateInstance(_SlabObject);
+    parcObject_Release((PARCObject **) &object);
+
+    assertTrue(parcMemory_Outstanding() == outstanding + 1, "Expected the released block to be cached.");
+
+    size_t drained = parcObjectSlab_Drain();
+    assertTrue(drained == 1, "Expected 1 block drained, actual %zu", drained);
+    assertTrue(parcMemory_Outstanding() == outstanding, "Expected the cached block to be freed.");
+
+    PARCObjectSlabStatistics statistics;
+    parcObjectSlab_GetStatistics(&_SlabObject_Descriptor, &statistics);
+    assertTrue(statistics.cached == 0, "Expected 0 cached, actual %zu", statistics.cached);
+}
+
+LONGBOW_TEST_CASE(Global, parcObjectSlab_SetDescriptor)
+{
+    // An object must return to the slab it came from, whatever its current descriptor.
+    _SlabObject *object = parcObject_CreateInstance(_SlabObject);
+    parcObject_SetDescriptor(object, &_PlainObject_Descriptor);
+    parcObject_Release((PARCObject **) &object);
+
+    PARCObjectSlabStatistics statistics;
+    parcObjectSlab_GetStatistics(&_SlabObject_Descriptor, &statistics);
+    assertTrue(statistics.live == 0, "Expected 0 live, actual %zu", statistics.live);
+    assertTrue(statistics.cached == 1, "Expected 1 cached, actual %zu", statistics.cached);
+}
+
+LONGBOW_TEST_CASE(Global, parcObjectSlab_Display)
+{
+    _SlabObject *object = parcObject_CreateInstance(_SlabObject);
+
+    parcObjectSlab_Display(0);
+
+    parcObject_Release((PARCObject **) &object);
+}
+
+LONGBOW_TEST_FIXTURE(Threads)
+{
+    LONGBOW_RUN_TEST_CASE(Threads, parcObjectSlab_ReleaseOnOtherThread);
+    LONGBOW_RUN_TEST_CASE(Threads, parcObjectSlab_ThreadExit);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Threads)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Threads)
+{
+    parcObjectSlab_Drain();
+
+    if (!parcMemoryTesting_ExpectedOutstanding(0, "%s mismanaged memory.", longBowTestCase_GetFullName(testCase))) {
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+#define THREAD_OBJECT_COUNT (MAGAZINE_CAPACITY * 8)
+
+static void *
+_releaseObjects(void *arg)
+{
+    _SlabObject **objects = arg;
+    for (int i = 0; i < THREAD_OBJECT_COUNT; i++) {
+        parcObject_Release((PARCObject **) &objects[i]);
+    }
+    return NULL;
+}
+
+LONGBOW_TEST_CASE(Threads, parcObjectSlab_ReleaseOnOtherThread)
+{
+    _SlabObject *objects[THREAD_OBJECT_COUNT];
+    for (int i = 0; i < THREAD_OBJECT_COUNT; i++) {
+        objects[i] = parcObject_CreateInstance(_SlabObject);
+    }
+
+    pthread_t thread;
+    pthread_create(&thread, NULL, _releaseObjects, objects);
+    pthread_join(thread, NULL);
+
+    PARCObjectSlabStatistics statistics;
+    parcObjectSlab_GetStatistics(&_SlabObject_Descriptor, &statistics);
+    assertTrue(statistics.live == 0, "Expected 0 live, actual %zu", statistics.live);
+    assertTrue(statistics.cached == THREAD_OBJECT_COUNT, "Expected %d cached, actual %zu", THREAD_OBJECT_COUNT, statistics.cached);
+}
+
+static void *
+_createAndReleaseObjects(void *arg)
+{
+    for (int i = 0; i < 1000; i++) {
+        _SlabObject *object = parcObject_CreateInstance(_SlabObject);
+        parcObject_Release((PARCObject **) &object);
+    }
+    return NULL;
+}
+
+LONGBOW_TEST_CASE(Threads, parcObjectSlab_ThreadExit)
+{
+    pthread_t threads[4];
+    for (int i = 0; i < 4; i++) {
+        pthread_create(&threads[i], NULL, _createAndReleaseObjects, NULL);
+    }
+    for (int i = 0; i < 4; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    // Every thread's cache was returned to the depot when it exited, so draining here frees everything.
+    PARCObjectSlabStatistics statistics;
+    parcObjectSlab_GetStatistics(&_SlabObject_Descriptor, &statistics);
+    assertTrue(statistics.live == 0, "Expected 0 live, actual %zu", statistics.live);
+
+    size_t drained = parcObjectSlab_Drain();
+    assertTrue(drained == statistics.cached, "Expected %zu drained, actual %zu", statistics.cached, drained);
+}
+
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, parcObject_CreateRelease_Plain);
+    LONGBOW_RUN_TEST_CASE(Performance, parcObject_CreateRelease_Slab);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    parcMemory_SetInterface(&PARCStdlibMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    parcObjectSlab_Drain();
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+#define PERFORMANCE_COUNT 10000000
+#define PERFORMANCE_BATCH 64
+
+static void
+_performance_CreateRelease(const char *name, const PARCObjectDescriptor *descriptor)
+{
+    PARCObject *objects[PERFORMANCE_BATCH];
+
+    struct timeval start, end, elapsed;
+    gettimeofday(&start, NULL);
+    for (int i = 0; i < PERFORMANCE_COUNT / PERFORMANCE_BATCH; i++) {
+        for (int j = 0; j < PERFORMANCE_BATCH; j++) {
+            objects[j] = parcObject_CreateInstanceImpl(descriptor);
+        }
+        for (int j = 0; j < PERFORMANCE_BATCH; j++) {
+            parcObject_Release(&objects[j]);
+        }
+    }
+    gettimeofday(&end, NULL);
+    timersub(&end, &start, &elapsed);
+    printf("%s: %d create/release in %ld.%06ld seconds\n", name, PERFORMANCE_COUNT, (long) elapsed.tv_sec, (long) elapsed.tv_usec);
+}
+
+LONGBOW_TEST_CASE(Performance, parcObject_CreateRelease_Plain)
+{
+    _performance_CreateRelease("parcMemory", &_PlainObject_Descriptor);
+}
+
+LONGBOW_TEST_CASE(Performance, parcObject_CreateRelease_Slab)
+{
+    _performance_CreateRelease("PARCObjectSlab", &_SlabObject_Descriptor);
+}
+
+int
+main(int argc, char *argv[argc])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(parc_ObjectSlab);
+    int exitStatus = longBowMain(argc, argv, testRunner, NULL);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
@@ -61,12 +61,14 @@
 #include <LongBow/unit-test.h>
 
 #include <fcntl.h>
+#include <sys/time.h>
 
 LONGBOW_TEST_RUNNER(safetyMemory)
 {
     LONGBOW_RUN_TEST_FIXTURE(Static);
     LONGBOW_RUN_TEST_FIXTURE(ReportAllocation);
     LONGBOW_RUN_TEST_FIXTURE(Global);
+    LONGBOW_RUN_TEST_FIXTURE(Sampling);
     LONGBOW_RUN_TEST_FIXTURE(Errors);
 
     LONGBOW_RUN_TEST_FIXTURE(Performance);
@@ -711,6 +713,246 @@ LONGBOW_TEST_CASE(Global, parcSafeMemory_Display_NULL)
     parcSafeMemory_Display(NULL, 0);
 }
 
+LONGBOW_TEST_FIXTURE(Sampling)
+{
+    LONGBOW_RUN_TEST_CASE(Sampling, parcSafeMemory_SetSampleRate);
+    LONGBOW_RUN_TEST_CASE(Sampling, parcSafeMemory_Allocate_Sampled);
+    LONGBOW_RUN_TEST_CASE(Sampling, parcSafeMemory_Allocate_Unsampled);
+    LONGBOW_RUN_TEST_CASE(Sampling, parcSafeMemory_MemAlign_Unsampled);
+    LONGBOW_RUN_TEST_CASE(Sampling, parcSafeMemory_Reallocate_Unsampled);
+    LONGBOW_RUN_TEST_CASE(Sampling, parcSafeMemory_Reallocate_Mixed);
+    LONGBOW_RUN_TEST_CASE(Sampling, parcSafeMemory_Display_Unsampled);
+    LONGBOW_RUN_TEST_CASE(Sampling, parcSafeMemory_ReportCallSites);
+    LONGBOW_RUN_TEST_CASE(Sampling, parcSafeMemory_ReportCallSites_Empty);
+    LONGBOW_RUN_TEST_CASE(Sampling, parcSafeMemory_StartPeriodicReport);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Sampling)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Sampling)
+{
+    parcSafeMemory_SetSampleRate(1);
+    assertTrue(parcSafeMemory_Outstanding() == 0, "Expected 0 outstanding allocations") {
+        printf("Leaking test case: %s", longBowTestCase_GetName(testCase));
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// Large enough that no allocation in a test case is sampled, barring a 1 in 2^30 chance.
+#define NEVER_SAMPLED (1U << 30)
+
+LONGBOW_TEST_CASE(Sampling, parcSafeMemory_SetSampleRate)
+{
+    assertTrue(parcSafeMemory_GetSampleRate() == 1, "Expected the default sample rate to be 1");
+
+    parcSafeMemory_SetSampleRate(100);
+    assertTrue(parcSafeMemory_GetSampleRate() == 100, "Expected 100, actual %u", parcSafeMemory_GetSampleRate());
+
+    parcSafeMemory_SetSampleRate(0);
+    assertTrue(parcSafeMemory_GetSampleRate() == 1, "Expected 0 to be treated as 1, actual %u", parcSafeMemory_GetSampleRate());
+}
+
+LONGBOW_TEST_CASE(Sampling, parcSafeMemory_Allocate_Sampled)
+{
+    parcSafeMemory_SetSampleRate(10);
+
+    void *memory[1000];
+    size_t sampled = 0;
+    for (int i = 0; i < 1000; i++) {
+        memory[i] = parcSafeMemory_Allocate(100);
+        memset(memory[i], i, 100);
+        assertTrue(parcSafeMemory_IsValid(memory[i]), "Expected memory to be valid");
+        if (!_parcSafeMemory_IsUnsampled(memory[i])) {
+            sampled++;
+        }
+    }
+    assertTrue(sampled > 50 && sampled < 200, "Expected about 100 sampled allocations, actual %zu", sampled);
+    assertTrue(parcSafeMemory_Outstanding() == 1000, "Expected every allocation to be outstanding, actual %u", parcSafeMemory_Outstanding());
+
+    int fd = open("/dev/null", O_WRONLY);
+    assertTrue(parcSafeMemory_ReportAllocation(fd) == 1000, "Expected every allocation to be outstanding");
+    close(fd);
+
+    for (int i = 0; i < 1000; i++) {
+        parcSafeMemory_Deallocate(&memory[i]);
+        assertNull(memory[i], "Expected the pointer to be set to NULL");
+    }
+}
+
+LONGBOW_TEST_CASE(Sampling, parcSafeMemory_Allocate_Unsampled)
+{
+    parcSafeMemory_SetSampleRate(NEVER_SAMPLED);
+
+    void *memory = parcSafeMemory_Allocate(100);
+    assertTrue(_parcSafeMemory_IsUnsampled(memory), "Expected the allocation not to be sampled");
+    assertAligned(memory, sizeof(void *), "Expected memory to be aligned");
+    memset(memory, 0, 100);
+
+    void *cleared = parcSafeMemory_AllocateAndClear(100);
+    for (int i = 0; i < 100; i++) {
+        assertTrue(((uint8_t *) cleared)[i] == 0, "Expected byte %d to be zero", i);
+    }
+
+    assertNull(parcSafeMemory_Allocate(0), "Expected NULL for a zero length allocation");
+    assertNull(parcSafeMemory_Allocate(SIZE_MAX - 4), "Expected NULL for an allocation that overflows");
+
+    int fd = open("/dev/null", O_WRONLY);
+    assertTrue(parcSafeMemory_ReportCallSites(fd) == 0, "Expected unsampled allocations not to be recorded");
+    close(fd);
+
+    parcSafeMemory_Deallocate(&memory);
+    parcSafeMemory_Deallocate(&cleared);
+}
+
+LONGBOW_TEST_CASE(Sampling, parcSafeMemory_MemAlign_Unsampled)
+{
+    parcSafeMemory_SetSampleRate(NEVER_SAMPLED);
+
+    for (size_t alignment = sizeof(void *); alignment <= 4096; alignment *= 2) {
+        void *memory;
+        int failure = parcSafeMemory_MemAlign(&memory, alignment, 24);
+        assertTrue(failure == 0, "Expected success for alignment %zu, actual %d", alignment, failure);
+        assertTrue(_parcSafeMemory_IsUnsampled(memory), "Expected the allocation not to be sampled");
+        assertAligned(memory, alignment, "Expected memory to be aligned on %zu", alignment);
+        assertTrue(_parcSafeMemory_GetUnsampledAlignment(memory) == alignment, "Expected the alignment to be recorded");
+        memset(memory, 0, 24);
+        parcSafeMemory_Deallocate(&memory);
+    }
+
+    void *memory;
+    assertTrue(parcSafeMemory_MemAlign(&memory, 3, 24) == EINVAL, "Expected EINVAL for a bad alignment");
+}
+
+LONGBOW_TEST_CASE(Sampling, parcSafeMemory_Reallocate_Unsampled)
+{
+    parcSafeMemory_SetSampleRate(NEVER_SAMPLED);
+
+    unsigned char *memory = parcSafeMemory_Allocate(10);
+    for (unsigned char i = 0; i < 10; i++) {
+        memory[i] = i;
+    }
+
+    memory = parcSafeMemory_Reallocate(memory, 100000);
+    assertTrue(_parcSafeMemory_IsUnsampled((void *) memory), "Expected the allocation not to be sampled");
+    assertTrue(_parcSafeMemory_GetRequestedLength((void *) memory) == 100000, "Expected the new length to be recorded");
+    for (unsigned char i = 0; i < 10; i++) {
+        assertTrue(memory[i] == i, "Expected the content to be preserved");
+    }
+
+    void *aligned;
+    parcSafeMemory_MemAlign(&aligned, 64, 10);
+    memcpy(aligned, memory, 10);
+    aligned = parcSafeMemory_Reallocate(aligned, 20);
+    assertTrue(memcmp(aligned, memory, 10) == 0, "Expected the content to be preserved");
+
+    parcSafeMemory_Deallocate(&aligned);
+    parcSafeMemory_Deallocate((void **) &memory);
+}
+
+LONGBOW_TEST_CASE(Sampling, parcSafeMemory_Reallocate_Mixed)
+{
+    // Sampled memory reallocated while sampling is effectively off, and back.
+    unsigned char *memory = parcSafeMemory_Allocate(100);
+    for (unsigned char i = 0; i < 100; i++) {
+        memory[i] = i;
+    }
+
+    parcSafeMemory_SetSampleRate(NEVER_SAMPLED);
+    memory = parcSafeMemory_Reallocate(memory, 50);
+    assertTrue(_parcSafeMemory_IsUnsampled((void *) memory), "Expected the allocation not to be sampled");
+
+    parcSafeMemory_SetSampleRate(1);
+    memory = parcSafeMemory_Reallocate(memory, 200);
+    assertFalse(_parcSafeMemory_IsUnsampled((void *) memory), "Expected the allocation to be sampled");
+    assertTrue(parcSafeMemory_IsValid(memory), "Expected memory to be valid");
+    for (unsigned char i = 0; i < 50; i++) {
+        assertTrue(memory[i] == i, "Expected the content to be preserved");
+    }
+
+    parcSafeMemory_Deallocate((void **) &memory);
+}
+
+LONGBOW_TEST_CASE(Sampling, parcSafeMemory_Display_Unsampled)
+{
+    parcSafeMemory_SetSampleRate(NEVER_SAMPLED);
+
+    void *memory = parcSafeMemory_Allocate(10);
+    memset(memory, 0, 10);
+    parcSafeMemory_Display(memory, 0);
+    parcSafeMemory_Deallocate(&memory);
+}
+
+__attribute__((noinline))
+static void *
+_allocateAtCallSiteA(void)
+{
+    return parcSafeMemory_Allocate(100);
+}
+
+__attribute__((noinline))
+static void *
+_allocateAtCallSiteB(void)
+{
+    return parcSafeMemory_Allocate(10);
+}
+
+LONGBOW_TEST_CASE(Sampling, parcSafeMemory_ReportCallSites)
+{
+    // Allocations group together only if their whole backtrace, including the return address here, is the same.
+    void *memory[5];
+    for (int i = 0; i < 5; i++) {
+        memory[i] = (i % 2 == 0) ? _allocateAtCallSiteB() : _allocateAtCallSiteA();
+    }
+
+    FILE *file = tmpfile();
+    size_t actual = parcSafeMemory_ReportCallSites(fileno(file));
+    assertTrue(actual == 2, "Expected 2 call sites, actual %zu", actual);
+
+    char report[8192];
+    rewind(file);
+    size_t length = fread(report, 1, sizeof(report) - 1, file);
+    report[length] = 0;
+    fclose(file);
+
+    assertNotNull(strstr(report, "5 sampled allocations (1 in 1), 230 bytes, 2 call sites"), "Unexpected summary: %s", report);
+    char *siteA = strstr(report, "2 allocations, 200 bytes");
+    char *siteB = strstr(report, "3 allocations, 30 bytes");
+    assertTrue(siteA != NULL && siteB != NULL && siteA < siteB, "Expected the call sites in decreasing order of bytes: %s", report);
+
+    for (int i = 0; i < 5; i++) {
+        parcSafeMemory_Deallocate(&memory[i]);
+    }
+}
+
+LONGBOW_TEST_CASE(Sampling, parcSafeMemory_ReportCallSites_Empty)
+{
+    _parcSafeMemory_DeallocateAll();
+    size_t actual = parcSafeMemory_ReportCallSites(-1);
+    assertTrue(actual == 0, "Expected 0 call sites, actual %zu", actual);
+}
+
+LONGBOW_TEST_CASE(Sampling, parcSafeMemory_StartPeriodicReport)
+{
+    void *memory = _allocateAtCallSiteA();
+
+    FILE *file = tmpfile();
+    assertFalse(parcSafeMemory_StartPeriodicReport(fileno(file), 0), "Expected a zero interval to be rejected");
+    assertTrue(parcSafeMemory_StartPeriodicReport(fileno(file), 1), "Expected the periodic report to start");
+    assertFalse(parcSafeMemory_StartPeriodicReport(fileno(file), 1), "Expected only one periodic report at a time");
+
+    sleep(2);
+    parcSafeMemory_StopPeriodicReport();
+    parcSafeMemory_StopPeriodicReport();
+
+    assertTrue(ftell(file) > 0 || lseek(fileno(file), 0, SEEK_END) > 0, "Expected at least one report to be written");
+    fclose(file);
+
+    parcSafeMemory_Deallocate(&memory);
+}
+
 LONGBOW_TEST_FIXTURE(Errors)
 {
     LONGBOW_RUN_TEST_CASE(Errors, parcSafeMemory_Reallocate_NULL);
@@ -793,6 +1035,7 @@ LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
     LONGBOW_RUN_TEST_CASE(Performance, parcSafeMemory_AllocateDeallocate_1000000_BestCase);
 
     LONGBOW_RUN_TEST_CASE(Performance, _computeUsableMemoryLength);
+    LONGBOW_RUN_TEST_CASE(Performance, parcSafeMemory_AllocateDeallocate_Sampled_Throughput);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Performance)
@@ -843,6 +1086,46 @@ LONGBOW_TEST_CASE(Performance, _computeUsableMemoryLength)
     }
 }
 
+#define THROUGHPUT_ITERATIONS 1000000
+
+static double
+_allocateDeallocateSeconds(uint32_t rate)
+{
+    parcSafeMemory_SetSampleRate(rate);
+
+    struct timeval start;
+    gettimeofday(&start, NULL);
+    for (int i = 0; i < THROUGHPUT_ITERATIONS; i++) {
+        void *memory = parcSafeMemory_Allocate(100);
+        parcSafeMemory_Deallocate(&memory);
+    }
+    struct timeval end;
+    gettimeofday(&end, NULL);
+
+    parcSafeMemory_SetSampleRate(1);
+    return (double) (end.tv_sec - start.tv_sec) + (double) (end.tv_usec - start.tv_usec) / 1000000.0;
+}
+
+LONGBOW_TEST_CASE(Performance, parcSafeMemory_AllocateDeallocate_Sampled_Throughput)
+{
+    struct timeval start;
+    gettimeofday(&start, NULL);
+    for (int i = 0; i < THROUGHPUT_ITERATIONS; i++) {
+        void *memory = parcStdlibMemory_Allocate(100);
+        parcStdlibMemory_Deallocate(&memory);
+    }
+    struct timeval end;
+    gettimeofday(&end, NULL);
+    double stdlib = (double) (end.tv_sec - start.tv_sec) + (double) (end.tv_usec - start.tv_usec) / 1000000.0;
+
+    uint32_t rates[] = { 1, 10, 100, 1000 };
+    printf("parcStdlibMemory: %.0f allocations/s\n", THROUGHPUT_ITERATIONS / stdlib);
+    for (size_t i = 0; i < sizeof(rates) / sizeof(rates[0]); i++) {
+        double seconds = _allocateDeallocateSeconds(rates[i]);
+        printf("parcSafeMemory 1 in %4u: %.0f allocations/s\n", rates[i], THROUGHPUT_ITERATIONS / seconds);
+    }
+}
+
 int
 main(int argc, char *argv[argc])
 {
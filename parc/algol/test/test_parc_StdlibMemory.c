@@ -63,6 +63,9 @@
 
 #include <parc/testing/parc_MemoryTesting.h>
 
+#include <inttypes.h>
+#include <sys/time.h>
+
 LONGBOW_TEST_RUNNER(test_parc_StdlibMemory)
 {
     // The following Test Fixtures will run their corresponding Test Cases.
@@ -95,6 +98,7 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, parcStdlibMemory_Reallocate);
     LONGBOW_RUN_TEST_CASE(Global, parcStdlibMemory_Reallocate_NULL);
     LONGBOW_RUN_TEST_CASE(Global, parcStdlibMemory_StringDuplicate);
+    LONGBOW_RUN_TEST_CASE(Global, parcStdlibMemory_GetStatistics);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Global)
@@ -251,9 +255,40 @@ LONGBOW_TEST_CASE(Global, parcStdlibMemory_StringDuplicate)
                "Expected 0 outstanding allocations, actual %d", parcStdlibMemory_Outstanding());
 }
 
+LONGBOW_TEST_CASE(Global, parcStdlibMemory_GetStatistics)
+{
+    PARCMemoryStatistics before;
+    PARCMemoryStatistics threadBefore;
+    assertTrue(parcStdlibMemory_GetStatistics(&before, &threadBefore), "Expected statistics to be available");
+
+    void *memory = parcStdlibMemory_Allocate(100);
+
+    PARCMemoryStatistics after;
+    PARCMemoryStatistics threadAfter;
+    parcStdlibMemory_GetStatistics(&after, &threadAfter);
+
+    assertTrue(after.allocations == before.allocations + 1, "Expected one more allocation in total");
+    assertTrue(threadAfter.allocations == threadBefore.allocations + 1, "Expected one more allocation in this thread");
+#if defined(__linux__) || defined(__APPLE__)
+    assertTrue(threadAfter.bytesAllocated >= threadBefore.bytesAllocated + 100,
+               "Expected at least 100 more bytes allocated, actual %" PRIu64, threadAfter.bytesAllocated - threadBefore.bytesAllocated);
+#endif
+
+    parcStdlibMemory_Deallocate(&memory);
+
+    parcStdlibMemory_GetStatistics(&after, &threadAfter);
+    assertTrue(threadAfter.deallocations == threadBefore.deallocations + 1, "Expected one more deallocation in this thread");
+    assertTrue(threadAfter.bytesAllocated - threadAfter.bytesDeallocated == threadBefore.bytesAllocated - threadBefore.bytesDeallocated,
+               "Expected the outstanding bytes of this thread to be unchanged");
+    assertTrue(after.allocations - after.deallocations == before.allocations - before.deallocations,
+               "Expected the total outstanding allocations to be unchanged");
+}
+
 LONGBOW_TEST_FIXTURE(Threads)
 {
     LONGBOW_RUN_TEST_CASE(Threads, Threads1000);
+    LONGBOW_RUN_TEST_CASE(Threads, GetStatistics_CrossThread);
+    LONGBOW_RUN_TEST_CASE(Threads, ShardReuse);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Threads)
@@ -289,12 +324,98 @@ LONGBOW_TEST_CASE(Threads, Threads1000)
     }
 }
 
+#define CROSS_THREAD_COUNT 8
+#define CROSS_THREAD_ALLOCATIONS 10
+
+static void *
+_allocateAndKeep(void *data)
+{
+    void **memory = data;
+    for (int i = 0; i < CROSS_THREAD_ALLOCATIONS; i++) {
+        memory[i] = parcStdlibMemory_Allocate(64);
+    }
+    return 0;
+}
+
+LONGBOW_TEST_CASE(Threads, GetStatistics_CrossThread)
+{
+    void *memory[CROSS_THREAD_COUNT][CROSS_THREAD_ALLOCATIONS];
+    pthread_t thread[CROSS_THREAD_COUNT];
+
+    PARCMemoryStatistics before;
+    PARCMemoryStatistics threadBefore;
+    parcStdlibMemory_GetStatistics(&before, &threadBefore);
+
+    for (int i = 0; i < CROSS_THREAD_COUNT; i++) {
+        pthread_create(&thread[i], NULL, _allocateAndKeep, memory[i]);
+    }
+    for (int i = 0; i < CROSS_THREAD_COUNT; i++) {
+        pthread_join(thread[i], NULL);
+    }
+
+    // The counts of the threads that have exited are retained.
+    uint32_t outstanding = parcStdlibMemory_Outstanding();
+    assertTrue(outstanding == CROSS_THREAD_COUNT * CROSS_THREAD_ALLOCATIONS,
+               "Expected %d outstanding allocations, actual %u", CROSS_THREAD_COUNT * CROSS_THREAD_ALLOCATIONS, outstanding);
+
+    for (int i = 0; i < CROSS_THREAD_COUNT; i++) {
+        for (int j = 0; j < CROSS_THREAD_ALLOCATIONS; j++) {
+            parcStdlibMemory_Deallocate(&memory[i][j]);
+        }
+    }
+
+    PARCMemoryStatistics after;
+    PARCMemoryStatistics threadAfter;
+    parcStdlibMemory_GetStatistics(&after, &threadAfter);
+
+    assertTrue(parcStdlibMemory_Outstanding() == 0, "Expected no outstanding allocations, actual %u", parcStdlibMemory_Outstanding());
+    assertTrue(after.allocations == before.allocations + CROSS_THREAD_COUNT * CROSS_THREAD_ALLOCATIONS,
+               "Expected the allocations of every thread in the total");
+    assertTrue(after.bytesAllocated - after.bytesDeallocated == before.bytesAllocated - before.bytesDeallocated,
+               "Expected no outstanding bytes");
+    assertTrue(threadAfter.allocations == threadBefore.allocations, "Expected no allocations by this thread");
+    assertTrue(threadAfter.deallocations == threadBefore.deallocations + CROSS_THREAD_COUNT * CROSS_THREAD_ALLOCATIONS,
+               "Expected this thread to account for the deallocations it made");
+}
+
+static size_t
+_shardCount(void)
+{
+    size_t result = 0;
+    pthread_mutex_lock(&_parcStdlibMemory_RegistryLock);
+    for (_PARCStdlibMemoryShard *shard = _parcStdlibMemory_Shards; shard != NULL; shard = shard->next) {
+        result++;
+    }
+    pthread_mutex_unlock(&_parcStdlibMemory_RegistryLock);
+    return result;
+}
+
+LONGBOW_TEST_CASE(Threads, ShardReuse)
+{
+    parcStdlibMemory_Outstanding();
+    allocator(NULL);
+
+    pthread_t thread;
+    pthread_create(&thread, NULL, allocator, NULL);
+    pthread_join(thread, NULL);
+    size_t shards = _shardCount();
+
+    // Threads that run one after another reuse the same shard.
+    for (int i = 0; i < 10; i++) {
+        pthread_create(&thread, NULL, allocator, NULL);
+        pthread_join(thread, NULL);
+    }
+    assertTrue(_shardCount() == shards, "Expected %zu shards, actual %zu", shards, _shardCount());
+    assertTrue(parcStdlibMemory_Outstanding() == 0, "Expected no outstanding allocations, actual %u", parcStdlibMemory_Outstanding());
+}
+
 LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
 {
     LONGBOW_RUN_TEST_CASE(Performance, parcStdlibMemory_AllocateDeallocate_Forward);
     LONGBOW_RUN_TEST_CASE(Performance, parcStdlibMemory_AllocateDeallocate_Reverse);
     LONGBOW_RUN_TEST_CASE(Performance, parcStdlibMemory_MemAlignDeallocate_Forward);
     LONGBOW_RUN_TEST_CASE(Performance, parcStdlibMemory_MemAlignDeallocate_Reverse);
+    LONGBOW_RUN_TEST_CASE(Performance, parcStdlibMemory_AllocateDeallocate_Throughput);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Performance)
@@ -357,6 +478,39 @@ LONGBOW_TEST_CASE(Performance, parcStdlibMemory_MemAlignDeallocate_Reverse)
     } while (i > 0);
 }
 
+#define THROUGHPUT_THREADS 4
+#define THROUGHPUT_OPERATIONS 5000000
+
+static void *
+_allocateDeallocateLoop(void *unused)
+{
+    for (int i = 0; i < THROUGHPUT_OPERATIONS; i++) {
+        void *memory = parcStdlibMemory_Allocate(ELEMENT_SIZE);
+        parcStdlibMemory_Deallocate(&memory);
+    }
+    return 0;
+}
+
+LONGBOW_TEST_CASE(Performance, parcStdlibMemory_AllocateDeallocate_Throughput)
+{
+    pthread_t thread[THROUGHPUT_THREADS];
+
+    struct timeval start;
+    gettimeofday(&start, NULL);
+    for (int i = 0; i < THROUGHPUT_THREADS; i++) {
+        pthread_create(&thread[i], NULL, _allocateDeallocateLoop, NULL);
+    }
+    for (int i = 0; i < THROUGHPUT_THREADS; i++) {
+        pthread_join(thread[i], NULL);
+    }
+    struct timeval end;
+    gettimeofday(&end, NULL);
+
+    double seconds = (double) (end.tv_sec - start.tv_sec) + (double) (end.tv_usec - start.tv_usec) / 1000000.0;
+    printf("%d threads: %.1f million allocate/deallocate pairs per second\n",
+           THROUGHPUT_THREADS, (double) THROUGHPUT_THREADS * THROUGHPUT_OPERATIONS / seconds / 1000000.0);
+}
+
 int
 main(int argc, char *argv[argc])
 {
@@ -0,0 +1,834 @@
+/*
+ * Copyright (c) 2015, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * Readers never take a lock.  The map is an array of buckets, each the head of a singly linked chain of immutable
+ * nodes.  Writers serialise on one of a fixed number of stripe locks, chosen from the high bits of the mixed hash
+ * code so that every bucket belongs to exactly one stripe at every table size, and publish their changes with
+ * release stores.  A replaced or removed node is unlinked and retired, never modified in place.
+ *
+ * Growing the table takes every stripe lock, builds a new table of fresh nodes and publishes it atomically.
+ * The old table and its nodes are retired.
+ *
+ * Retired memory is reclaimed with epoch based reclamation: every thread announces the global epoch when it enters
+ * a read-side critical section, the global epoch only advances when every active thread has announced the current
+ * epoch, and memory retired in epoch E is released once the global epoch reaches E + 2.
+ *
+ * @author Glenn Scott, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include <config.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+
+#include <LongBow/runtime.h>
+
+#include <parc/algol/parc_Object.h>
+#include <parc/algol/parc_Memory.h>
+#include <parc/algol/parc_DisplayIndented.h>
+
+#include <parc/concurrent/parc_ConcurrentHashMap.h>
+
+#define ATOMIC_LOAD(_pointer_) __atomic_load_n((_pointer_), __ATOMIC_ACQUIRE)
+#define ATOMIC_STORE(_pointer_, _value_) __atomic_store_n((_pointer_), (_value_), __ATOMIC_RELEASE)
+
+// The number of stripe locks.  Must be a power of 2.
+#define STRIPE_SHIFT 6
+#define STRIPE_COUNT (1 << STRIPE_SHIFT)
+
+// The smallest table has one bucket per stripe.
+#define MINIMUM_BUCKET_SHIFT STRIPE_SHIFT
+
+static const double _parcConcurrentHashMap_MaxLoadFactor = 0.75;
+
+// Attempt to reclaim retired memory once this many nodes are waiting.
+static const size_t _parcConcurrentHashMap_ReclaimThreshold = 64;
+
+typedef struct _parcConcurrentHashMapNode {
+    PARCHashCode hashCode;
+    PARCObject *key;
+    PARCObject *value;
+    struct _parcConcurrentHashMapNode *next;
+
+    struct _parcConcurrentHashMapNode *retiredNext;
+    uint64_t retiredEpoch;
+} _PARCConcurrentHashMapNode;
+
+typedef struct _parcConcurrentHashMapTable {
+    size_t bucketCount;
+    unsigned int bucketShift;
+
+    struct _parcConcurrentHashMapTable *retiredNext;
+    uint64_t retiredEpoch;
+
+    _PARCConcurrentHashMapNode *buckets[];
+} _PARCConcurrentHashMapTable;
+
+// Keep each stripe lock on its own cache line so writers in different stripes do not contend.
+typedef union {
+    pthread_mutex_t mutex;
+    uint8_t padding[64];
+} _PARCConcurrentHashMapStripe;
+
+struct PARCConcurrentHashMap {
+    _PARCConcurrentHashMapTable *table;
+    size_t size;
+
+    _PARCConcurrentHashMapStripe stripes[STRIPE_COUNT];
+
+    pthread_mutex_t retiredLock;
+    _PARCConcurrentHashMapNode *retiredNodes;
+    _PARCConcurrentHashMapTable *retiredTables;
+    size_t retiredCount;
+    // Reclaim again when retiredCount reaches this, so a stalled reader does not make every write walk the list.
+    size_t reclaimAt;
+};
+
+/*
+ * Epoch based reclamation.
+ *
+ * Each thread that reads a map owns an epoch record for its lifetime.  Records are never freed, a record released
+ * by an exiting thread is reused by the next new thread.  Because records outlive every map and every test case,
+ * they are allocated directly from the system rather than through parcMemory.
+ */
+typedef struct _parcConcurrentHashMapEpochRecord {
+    // (epoch << 1) | 1 while the owning thread is inside a read-side critical section, otherwise 0.
+    uint64_t announcement;
+    unsigned int depth;
+    bool inUse;
+    struct _parcConcurrentHashMapEpochRecord *next;
+} _PARCConcurrentHashMapEpochRecord;
+
+static uint64_t _parcConcurrentHashMap_GlobalEpoch = 0;
+static _PARCConcurrentHashMapEpochRecord *_parcConcurrentHashMap_EpochRecords = NULL;
+static pthread_key_t _parcConcurrentHashMap_EpochRecordKey;
+static pthread_once_t _parcConcurrentHashMap_EpochOnce = PTHREAD_ONCE_INIT;
+
+static void
+_parcConcurrentHashMap_EpochRecordRelease(void *value)
+{
+    _PARCConcurrentHashMapEpochRecord *record = value;
+    record->depth = 0;
+    ATOMIC_STORE(&record->announcement, 0);
+    ATOMIC_STORE(&record->inUse, false);
+}
+
+static void
+_parcConcurrentHashMap_EpochInitialize(void)
+{
+    int error = pthread_key_create(&_parcConcurrentHashMap_EpochRecordKey, _parcConcurrentHashMap_EpochRecordRelease);
+    trapUnexpectedStateIf(error != 0, "Cannot create the PARCConcurrentHashMap epoch key: %d", error);
+}
+
+static _PARCConcurrentHashMapEpochRecord *
+_parcConcurrentHashMap_EpochRecord(void)
+{
+    pthread_once(&_parcConcurrentHashMap_EpochOnce, _parcConcurrentHashMap_EpochInitialize);
+
+    _PARCConcurrentHashMapEpochRecord *result = pthread_getspecific(_parcConcurrentHashMap_EpochRecordKey);
+    if (result == NULL) {
+        for (_PARCConcurrentHashMapEpochRecord *record = ATOMIC_LOAD(&_parcConcurrentHashMap_EpochRecords);
+             record != NULL; record = record->next) {
+            bool expected = false;
+            if (ATOMIC_LOAD(&record->inUse) == false
+                && __atomic_compare_exchange_n(&record->inUse, &expected, true, false, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+                result = record;
+                break;
+            }
+        }
+
+        if (result == NULL) {
+            result = calloc(1, sizeof(_PARCConcurrentHashMapEpochRecord));
+            trapOutOfMemoryIf(result == NULL, "Cannot allocate a PARCConcurrentHashMap epoch record");
+            result->inUse = true;
+            result->next = ATOMIC_LOAD(&_parcConcurrentHashMap_EpochRecords);
+            while (!__atomic_compare_exchange_n(&_parcConcurrentHashMap_EpochRecords, &result->next, result,
+                                                false, __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {
+                ;
+            }
+        }
+        pthread_setspecific(_parcConcurrentHashMap_EpochRecordKey, result);
+    }
+
+    return result;
+}
+
+static _PARCConcurrentHashMapEpochRecord *
+_parcConcurrentHashMap_EnterCriticalSection(void)
+{
+    _PARCConcurrentHashMapEpochRecord *record = _parcConcurrentHashMap_EpochRecord();
+
+    if (record->depth++ == 0) {
+        uint64_t epoch = ATOMIC_LOAD(&_parcConcurrentHashMap_GlobalEpoch);
+        __atomic_store_n(&record->announcement, (epoch << 1) | 1, __ATOMIC_RELAXED);
+        // The announcement must be visible before any shared pointer is read.
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    }
+    return record;
+}
+
+static void
+_parcConcurrentHashMap_ExitCriticalSection(_PARCConcurrentHashMapEpochRecord *record)
+{
+    if (--record->depth == 0) {
+        ATOMIC_STORE(&record->announcement, 0);
+    }
+}
+
+/*
+ * Advance the global epoch if every thread inside a critical section has observed the current epoch.
+ */
+static void
+_parcConcurrentHashMap_TryAdvanceEpoch(void)
+{
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+    uint64_t epoch = ATOMIC_LOAD(&_parcConcurrentHashMap_GlobalEpoch);
+
+    for (_PARCConcurrentHashMapEpochRecord *record = ATOMIC_LOAD(&_parcConcurrentHashMap_EpochRecords);
+         record != NULL; record = record->next) {
+        uint64_t announcement = ATOMIC_LOAD(&record->announcement);
+        if ((announcement & 1) && (announcement >> 1) != epoch) {
+            return;
+        }
+    }
+
+    __atomic_compare_exchange_n(&_parcConcurrentHashMap_GlobalEpoch, &epoch, epoch + 1, false, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED);
+}
+
+static inline uint64_t
+_parcConcurrentHashMap_Mix(PARCHashCode hashCode)
+{
+    // Fibonacci hashing spreads poorly distributed hash codes over the high bits.
+    return (uint64_t) hashCode * UINT64_C(0x9E3779B97F4A7C15);
+}
+
+static inline size_t
+_parcConcurrentHashMap_BucketIndex(const _PARCConcurrentHashMapTable *table, PARCHashCode hashCode)
+{
+    return (size_t) (_parcConcurrentHashMap_Mix(hashCode) >> table->bucketShift);
+}
+
+static inline pthread_mutex_t *
+_parcConcurrentHashMap_Stripe(PARCConcurrentHashMap *map, PARCHashCode hashCode)
+{
+    return &map->stripes[_parcConcurrentHashMap_Mix(hashCode) >> (64 - STRIPE_SHIFT)].mutex;
+}
+
+static _PARCConcurrentHashMapTable *
+_parcConcurrentHashMap_CreateTable(unsigned int log2BucketCount)
+{
+    size_t bucketCount = (size_t) 1 << log2BucketCount;
+    _PARCConcurrentHashMapTable *result =
+        parcMemory_AllocateAndClear(sizeof(_PARCConcurrentHashMapTable) + bucketCount * sizeof(_PARCConcurrentHashMapNode *));
+    assertNotNull(result, "parcMemory_AllocateAndClear(%zu) returned NULL", bucketCount * sizeof(_PARCConcurrentHashMapNode *));
+
+    result->bucketCount = bucketCount;
+    result->bucketShift = 64 - log2BucketCount;
+
+    return result;
+}
+
+static _PARCConcurrentHashMapNode *
+_parcConcurrentHashMap_CreateNode(PARCHashCode hashCode, PARCObject *key, PARCObject *value, _PARCConcurrentHashMapNode *next)
+{
+    _PARCConcurrentHashMapNode *result = parcMemory_Allocate(sizeof(_PARCConcurrentHashMapNode));
+    assertNotNull(result, "parcMemory_Allocate(%zu) returned NULL", sizeof(_PARCConcurrentHashMapNode));
+
+    result->hashCode = hashCode;
+    result->key = key;
+    result->value = value;
+    result->next = next;
+    result->retiredNext = NULL;
+    result->retiredEpoch = 0;
+
+    return result;
+}
+
+static void
+_parcConcurrentHashMap_DestroyNode(_PARCConcurrentHashMapNode **nodePtr)
+{
+    _PARCConcurrentHashMapNode *node = *nodePtr;
+
+    parcObject_Release(&node->key);
+    parcObject_Release(&node->value);
+    parcMemory_Deallocate(nodePtr);
+}
+
+static void
+_parcConcurrentHashMap_DestroyTable(_PARCConcurrentHashMapTable **tablePtr, bool destroyNodes)
+{
+    _PARCConcurrentHashMapTable *table = *tablePtr;
+
+    if (destroyNodes) {
+        for (size_t i = 0; i < table->bucketCount; i++) {
+            _PARCConcurrentHashMapNode *node = table->buckets[i];
+            while (node != NULL) {
+                _PARCConcurrentHashMapNode *next = node->next;
+                _parcConcurrentHashMap_DestroyNode(&node);
+                node = next;
+            }
+        }
+    }
+    parcMemory_Deallocate(tablePtr);
+}
+
+/*
+ * Retire a node that has been unlinked from its chain.
+ * It is destroyed once no reader can hold a pointer to it.
+ */
+static void
+_parcConcurrentHashMap_RetireNode(PARCConcurrentHashMap *map, _PARCConcurrentHashMapNode *node)
+{
+    pthread_mutex_lock(&map->retiredLock);
+    node->retiredEpoch = ATOMIC_LOAD(&_parcConcurrentHashMap_GlobalEpoch);
+    node->retiredNext = map->retiredNodes;
+    map->retiredNodes = node;
+    __atomic_add_fetch(&map->retiredCount, 1, __ATOMIC_RELAXED);
+    pthread_mutex_unlock(&map->retiredLock);
+}
+
+static inline bool
+_parcConcurrentHashMap_ShouldReclaim(const PARCConcurrentHashMap *map)
+{
+    return __atomic_load_n(&map->retiredCount, __ATOMIC_RELAXED) >= __atomic_load_n(&map->reclaimAt, __ATOMIC_RELAXED);
+}
+
+static void
+_parcConcurrentHashMap_RetireTable(PARCConcurrentHashMap *map, _PARCConcurrentHashMapTable *table)
+{
+    pthread_mutex_lock(&map->retiredLock);
+    table->retiredEpoch = ATOMIC_LOAD(&_parcConcurrentHashMap_GlobalEpoch);
+    table->retiredNext = map->retiredTables;
+    map->retiredTables = table;
+    pthread_mutex_unlock(&map->retiredLock);
+}
+
+/*
+ * Destroy every retired node and table that no reader can still observe.
+ *
+ * Releasing a key or value may run arbitrary finalisers, so that is done after the lock is dropped.
+ */
+static void
+_parcConcurrentHashMap_Reclaim(PARCConcurrentHashMap *map)
+{
+    _PARCConcurrentHashMapNode *reclaimedNodes = NULL;
+    _PARCConcurrentHashMapTable *reclaimedTables = NULL;
+
+    pthread_mutex_lock(&map->retiredLock);
+
+    _parcConcurrentHashMap_TryAdvanceEpoch();
+    uint64_t epoch = ATOMIC_LOAD(&_parcConcurrentHashMap_GlobalEpoch);
+
+    _PARCConcurrentHashMapNode **nodePtr = &map->retiredNodes;
+    while (*nodePtr != NULL) {
+        _PARCConcurrentHashMapNode *node = *nodePtr;
+        if (node->retiredEpoch + 2 <= epoch) {
+            *nodePtr = node->retiredNext;
+            node->retiredNext = reclaimedNodes;
+            reclaimedNodes = node;
+            __atomic_sub_fetch(&map->retiredCount, 1, __ATOMIC_RELAXED);
+        } else {
+            nodePtr = &node->retiredNext;
+        }
+    }
+
+    _PARCConcurrentHashMapTable **tablePtr = &map->retiredTables;
+    while (*tablePtr != NULL) {
+        _PARCConcurrentHashMapTable *table = *tablePtr;
+        if (table->retiredEpoch + 2 <= epoch) {
+            *tablePtr = table->retiredNext;
+            table->retiredNext = reclaimedTables;
+            reclaimedTables = table;
+        } else {
+            tablePtr = &table->retiredNext;
+        }
+    }
+
+    __atomic_store_n(&map->reclaimAt, map->retiredCount + _parcConcurrentHashMap_ReclaimThreshold, __ATOMIC_RELAXED);
+
+    pthread_mutex_unlock(&map->retiredLock);
+
+    while (reclaimedNodes != NULL) {
+        _PARCConcurrentHashMapNode *next = reclaimedNodes->retiredNext;
+        _parcConcurrentHashMap_DestroyNode(&reclaimedNodes);
+        reclaimedNodes = next;
+    }
+    while (reclaimedTables != NULL) {
+        _PARCConcurrentHashMapTable *next = reclaimedTables->retiredNext;
+        _parcConcurrentHashMap_DestroyTable(&reclaimedTables, false);
+        reclaimedTables = next;
+    }
+}
+
+static void
+_parcConcurrentHashMap_LockAllStripes(PARCConcurrentHashMap *map)
+{
+    for (int i = 0; i < STRIPE_COUNT; i++) {
+        pthread_mutex_lock(&map->stripes[i].mutex);
+    }
+}
+
+static void
+_parcConcurrentHashMap_UnlockAllStripes(PARCConcurrentHashMap *map)
+{
+    for (int i = STRIPE_COUNT - 1; i >= 0; i--) {
+        pthread_mutex_unlock(&map->stripes[i].mutex);
+    }
+}
+
+/*
+ * Double the number of buckets, unless another writer has already replaced the table.
+ */
+static void
+_parcConcurrentHashMap_Grow(PARCConcurrentHashMap *map, const _PARCConcurrentHashMapTable *observed)
+{
+    _parcConcurrentHashMap_LockAllStripes(map);
+
+    _PARCConcurrentHashMapTable *oldTable = map->table;
+    if (oldTable == observed) {
+        _PARCConcurrentHashMapTable *newTable = _parcConcurrentHashMap_CreateTable(64 - oldTable->bucketShift + 1);
+
+        for (size_t i = 0; i < oldTable->bucketCount; i++) {
+            for (_PARCConcurrentHashMapNode *node = oldTable->buckets[i]; node != NULL; node = node->next) {
+                size_t index = _parcConcurrentHashMap_BucketIndex(newTable, node->hashCode);
+                newTable->buckets[index] =
+                    _parcConcurrentHashMap_CreateNode(node->hashCode, parcObject_Acquire(node->key),
+                                                      parcObject_Acquire(node->value), newTable->buckets[index]);
+            }
+        }
+
+        ATOMIC_STORE(&map->table, newTable);
+
+        for (size_t i = 0; i < oldTable->bucketCount; i++) {
+            for (_PARCConcurrentHashMapNode *node = oldTable->buckets[i]; node != NULL; node = node->next) {
+                _parcConcurrentHashMap_RetireNode(map, node);
+            }
+        }
+        _parcConcurrentHashMap_RetireTable(map, oldTable);
+    }
+
+    _parcConcurrentHashMap_UnlockAllStripes(map);
+}
+
+static void
+_parcConcurrentHashMap_Finalize(PARCConcurrentHashMap **instancePtr)
+{
+    assertNotNull(instancePtr, "Parameter must be a non-null pointer to a PARCConcurrentHashMap pointer.");
+    PARCConcurrentHashMap *map = *instancePtr;
+    parcConcurrentHashMap_OptionalAssertValid(map);
+
+    // No thread holds a reference, so nothing can be observing the retired memory either.
+    while (map->retiredNodes != NULL) {
+        _PARCConcurrentHashMapNode *next = map->retiredNodes->retiredNext;
+        _parcConcurrentHashMap_DestroyNode(&map->retiredNodes);
+        map->retiredNodes = next;
+    }
+    while (map->retiredTables != NULL) {
+        _PARCConcurrentHashMapTable *next = map->retiredTables->retiredNext;
+        _parcConcurrentHashMap_DestroyTable(&map->retiredTables, false);
+        map->retiredTables = next;
+    }
+    _parcConcurrentHashMap_DestroyTable(&map->table, true);
+
+    for (int i = 0; i < STRIPE_COUNT; i++) {
+        pthread_mutex_destroy(&map->stripes[i].mutex);
+    }
+    pthread_mutex_destroy(&map->retiredLock);
+}
+
+parcObject_ImplementAcquire(parcConcurrentHashMap, PARCConcurrentHashMap);
+
+parcObject_ImplementRelease(parcConcurrentHashMap, PARCConcurrentHashMap);
+
+parcObject_ExtendPARCObject(PARCConcurrentHashMap, _parcConcurrentHashMap_Finalize, parcConcurrentHashMap_Copy,
+                            parcConcurrentHashMap_ToString, parcConcurrentHashMap_Equals, NULL,
+                            parcConcurrentHashMap_HashCode, NULL);
+
+void
+parcConcurrentHashMap_AssertValid(const PARCConcurrentHashMap *instance)
+{
+    assertTrue(parcConcurrentHashMap_IsValid(instance),
+               "PARCConcurrentHashMap is not valid.");
+}
+
+static PARCConcurrentHashMap *
+_parcConcurrentHashMap_Create(unsigned int log2BucketCount)
+{
+    PARCConcurrentHashMap *result = parcObject_CreateInstance(PARCConcurrentHashMap);
+
+    if (result != NULL) {
+        result->table = _parcConcurrentHashMap_CreateTable(log2BucketCount);
+        result->size = 0;
+
+        for (int i = 0; i < STRIPE_COUNT; i++) {
+            pthread_mutex_init(&result->stripes[i].mutex, NULL);
+        }
+        pthread_mutex_init(&result->retiredLock, NULL);
+        result->retiredNodes = NULL;
+        result->retiredTables = NULL;
+        result->retiredCount = 0;
+        result->reclaimAt = _parcConcurrentHashMap_ReclaimThreshold;
+    }
+
+    return result;
+}
+
+PARCConcurrentHashMap *
+parcConcurrentHashMap_CreateCapacity(unsigned int capacity)
+{
+    unsigned int log2BucketCount = MINIMUM_BUCKET_SHIFT;
+    while (log2BucketCount < 63 && ((size_t) 1 << log2BucketCount) * _parcConcurrentHashMap_MaxLoadFactor < capacity) {
+        log2BucketCount++;
+    }
+
+    return _parcConcurrentHashMap_Create(log2BucketCount);
+}
+
+PARCConcurrentHashMap *
+parcConcurrentHashMap_Create(void)
+{
+    return _parcConcurrentHashMap_Create(MINIMUM_BUCKET_SHIFT);
+}
+
+PARCConcurrentHashMap *
+parcConcurrentHashMap_Copy(const PARCConcurrentHashMap *original)
+{
+    parcConcurrentHashMap_OptionalAssertValid(original);
+
+    PARCConcurrentHashMap *map = (PARCConcurrentHashMap *) original;
+
+    _parcConcurrentHashMap_LockAllStripes(map);
+
+    const _PARCConcurrentHashMapTable *table = map->table;
+    PARCConcurrentHashMap *result = _parcConcurrentHashMap_Create(64 - table->bucketShift);
+
+    for (size_t i = 0; i < table->bucketCount; i++) {
+        for (_PARCConcurrentHashMapNode *node = table->buckets[i]; node != NULL; node = node->next) {
+            result->table->buckets[i] =
+                _parcConcurrentHashMap_CreateNode(node->hashCode, parcObject_Acquire(node->key),
+                                                  parcObject_Acquire(node->value), result->table->buckets[i]);
+        }
+    }
+    result->size = map->size;
+
+    _parcConcurrentHashMap_UnlockAllStripes(map);
+
+    return result;
+}
+
+void
+parcConcurrentHashMap_Display(const PARCConcurrentHashMap *instance, int indentation)
+{
+    parcDisplayIndented_PrintLine(indentation, "PARCConcurrentHashMap@%p {", instance);
+
+    _PARCConcurrentHashMapEpochRecord *record = _parcConcurrentHashMap_EnterCriticalSection();
+
+    const _PARCConcurrentHashMapTable *table = ATOMIC_LOAD(&instance->table);
+    for (size_t i = 0; i < table->bucketCount; i++) {
+        for (const _PARCConcurrentHashMapNode *node = ATOMIC_LOAD(&table->buckets[i]); node != NULL; node = ATOMIC_LOAD(&node->next)) {
+            char *key = parcObject_ToString(node->key);
+            char *value = parcObject_ToString(node->value);
+            parcDisplayIndented_PrintLine(indentation + 1, "%s -> %s", key, value);
+            parcMemory_Deallocate(&key);
+            parcMemory_Deallocate(&value);
+        }
+    }
+
+    _parcConcurrentHashMap_ExitCriticalSection(record);
+
+    parcDisplayIndented_PrintLine(indentation, "}");
+}
+
+static const _PARCConcurrentHashMapNode *
+_parcConcurrentHashMap_Find(const PARCConcurrentHashMap *map, const PARCObject *key, PARCHashCode hashCode)
+{
+    const _PARCConcurrentHashMapTable *table = ATOMIC_LOAD(&map->table);
+
+    const _PARCConcurrentHashMapNode *node = ATOMIC_LOAD(&table->buckets[_parcConcurrentHashMap_BucketIndex(table, hashCode)]);
+    while (node != NULL) {
+        if (node->hashCode == hashCode && parcObject_Equals(key, node->key)) {
+            break;
+        }
+        node = ATOMIC_LOAD(&node->next);
+    }
+
+    return node;
+}
+
+bool
+parcConcurrentHashMap_Equals(const PARCConcurrentHashMap *x, const PARCConcurrentHashMap *y)
+{
+    bool result = false;
+
+    if (x == y) {
+        result = true;
+    } else if (x == NULL || y == NULL) {
+        result = false;
+    } else {
+        parcConcurrentHashMap_OptionalAssertValid(x);
+        parcConcurrentHashMap_OptionalAssertValid(y);
+
+        if (parcConcurrentHashMap_Size(x) == parcConcurrentHashMap_Size(y)) {
+            _PARCConcurrentHashMapEpochRecord *record = _parcConcurrentHashMap_EnterCriticalSection();
+
+            result = true;
+            const _PARCConcurrentHashMapTable *table = ATOMIC_LOAD(&x->table);
+            for (size_t i = 0; i < table->bucketCount && result; i++) {
+                for (const _PARCConcurrentHashMapNode *node = ATOMIC_LOAD(&table->buckets[i]); node != NULL && result;
+                     node = ATOMIC_LOAD(&node->next)) {
+                    const _PARCConcurrentHashMapNode *other = _parcConcurrentHashMap_Find(y, node->key, node->hashCode);
+                    result = (other != NULL) && parcObject_Equals(node->value, other->value);
+                }
+            }
+
+            _parcConcurrentHashMap_ExitCriticalSection(record);
+        }
+    }
+
+    return result;
+}
+
+PARCHashCode
+parcConcurrentHashMap_HashCode(const PARCConcurrentHashMap *instance)
+{
+    parcConcurrentHashMap_OptionalAssertValid(instance);
+
+    PARCHashCode result = 0;
+
+    _PARCConcurrentHashMapEpochRecord *record = _parcConcurrentHashMap_EnterCriticalSection();
+
+    const _PARCConcurrentHashMapTable *table = ATOMIC_LOAD(&instance->table);
+    for (size_t i = 0; i < table->bucketCount; i++) {
+        for (const _PARCConcurrentHashMapNode *node = ATOMIC_LOAD(&table->buckets[i]); node != NULL; node = ATOMIC_LOAD(&node->next)) {
+            result += node->hashCode;
+        }
+    }
+
+    _parcConcurrentHashMap_ExitCriticalSection(record);
+
+    return result;
+}
+
+bool
+parcConcurrentHashMap_IsValid(const PARCConcurrentHashMap *instance)
+{
+    bool result = false;
+
+    if (instance != NULL) {
+        result = (instance->table != NULL);
+    }
+
+    return result;
+}
+
+PARCBufferComposer *
+parcConcurrentHashMap_BuildString(const PARCConcurrentHashMap *map, PARCBufferComposer *composer)
+{
+    parcBufferComposer_Format(composer, "PARCConcurrentHashMap@%p { .size=%zu }", (void *) map, parcConcurrentHashMap_Size(map));
+
+    return composer;
+}
+
+char *
+parcConcurrentHashMap_ToString(const PARCConcurrentHashMap *instance)
+{
+    char *result = NULL;
+
+    PARCBufferComposer *composer = parcBufferComposer_Create();
+    if (composer != NULL) {
+        parcConcurrentHashMap_BuildString(instance, composer);
+        result = parcBufferComposer_ToString(composer);
+        parcBufferComposer_Release(&composer);
+    }
+
+    return result;
+}
+
+PARCConcurrentHashMap *
+parcConcurrentHashMap_Put(PARCConcurrentHashMap *map, const PARCObject *key, const PARCObject *value)
+{
+    parcConcurrentHashMap_OptionalAssertValid(map);
+    assertNotNull(key, "The key must be non-NULL");
+    assertNotNull(value, "The value must be non-NULL");
+
+    PARCHashCode hashCode = parcObject_HashCode(key);
+    bool retired = false;
+    bool grow = false;
+
+    pthread_mutex_t *stripe = _parcConcurrentHashMap_Stripe(map, hashCode);
+    pthread_mutex_lock(stripe);
+
+    // The table cannot be replaced while any stripe lock is held.
+    _PARCConcurrentHashMapTable *table = map->table;
+    _PARCConcurrentHashMapNode **link = &table->buckets[_parcConcurrentHashMap_BucketIndex(table, hashCode)];
+    _PARCConcurrentHashMapNode *node = *link;
+    while (node != NULL && !(node->hashCode == hashCode && parcObject_Equals(key, node->key))) {
+        link = &node->next;
+        node = node->next;
+    }
+
+    if (node != NULL) {
+        if (node->value != value) {
+            _PARCConcurrentHashMapNode *replacement =
+                _parcConcurrentHashMap_CreateNode(hashCode, parcObject_Acquire(node->key), parcObject_Acquire(value), node->next);
+            ATOMIC_STORE(link, replacement);
+            _parcConcurrentHashMap_RetireNode(map, node);
+            retired = true;
+        }
+    } else {
+        _PARCConcurrentHashMapNode **head = &table->buckets[_parcConcurrentHashMap_BucketIndex(table, hashCode)];
+        ATOMIC_STORE(head, _parcConcurrentHashMap_CreateNode(hashCode, parcObject_Copy(key), parcObject_Acquire(value), *head));
+        size_t size = __atomic_add_fetch(&map->size, 1, __ATOMIC_RELAXED);
+        // Decide while the stripe is held: once it is released, a concurrent grow may retire and free the table.
+        grow = size > table->bucketCount * _parcConcurrentHashMap_MaxLoadFactor;
+    }
+
+    pthread_mutex_unlock(stripe);
+
+    if (grow) {
+        _parcConcurrentHashMap_Grow(map, table);
+        retired = true;
+    }
+    if (retired && _parcConcurrentHashMap_ShouldReclaim(map)) {
+        _parcConcurrentHashMap_Reclaim(map);
+    }
+
+    return map;
+}
+
+PARCObject *
+parcConcurrentHashMap_Get(const PARCConcurrentHashMap *map, const PARCObject *key)
+{
+    parcConcurrentHashMap_OptionalAssertValid(map);
+
+    PARCObject *result = NULL;
+
+    PARCHashCode hashCode = parcObject_HashCode(key);
+
+    _PARCConcurrentHashMapEpochRecord *record = _parcConcurrentHashMap_EnterCriticalSection();
+
+    const _PARCConcurrentHashMapNode *node = _parcConcurrentHashMap_Find(map, key, hashCode);
+    if (node != NULL) {
+        // The reference held by a retired node is not released until this critical section ends.
+        result = parcObject_Acquire(node->value);
+    }
+
+    _parcConcurrentHashMap_ExitCriticalSection(record);
+
+    return result;
+}
+
+bool
+parcConcurrentHashMap_Contains(const PARCConcurrentHashMap *map, const PARCObject *key)
+{
+    parcConcurrentHashMap_OptionalAssertValid(map);
+
+    PARCHashCode hashCode = parcObject_HashCode(key);
+
+    _PARCConcurrentHashMapEpochRecord *record = _parcConcurrentHashMap_EnterCriticalSection();
+
+    bool result = (_parcConcurrentHashMap_Find(map, key, hashCode) != NULL);
+
+    _parcConcurrentHashMap_ExitCriticalSection(record);
+
+    return result;
+}
+
+bool
+parcConcurrentHashMap_Remove(PARCConcurrentHashMap *map, const PARCObject *key)
+{
+    parcConcurrentHashMap_OptionalAssertValid(map);
+
+    bool result = false;
+
+    PARCHashCode hashCode = parcObject_HashCode(key);
+
+    pthread_mutex_t *stripe = _parcConcurrentHashMap_Stripe(map, hashCode);
+    pthread_mutex_lock(stripe);
+
+    _PARCConcurrentHashMapTable *table = map->table;
+    _PARCConcurrentHashMapNode **link = &table->buckets[_parcConcurrentHashMap_BucketIndex(table, hashCode)];
+    _PARCConcurrentHashMapNode *node = *link;
+    while (node != NULL && !(node->hashCode == hashCode && parcObject_Equals(key, node->key))) {
+        link = &node->next;
+        node = node->next;
+    }
+
+    if (node != NULL) {
+        ATOMIC_STORE(link, node->next);
+        __atomic_sub_fetch(&map->size, 1, __ATOMIC_RELAXED);
+        _parcConcurrentHashMap_RetireNode(map, node);
+        result = true;
+    }
+
+    pthread_mutex_unlock(stripe);
+
+    if (result && _parcConcurrentHashMap_ShouldReclaim(map)) {
+        _parcConcurrentHashMap_Reclaim(map);
+    }
+
+    return result;
+}
+
+size_t
+parcConcurrentHashMap_Size(const PARCConcurrentHashMap *map)
+{
+    parcConcurrentHashMap_OptionalAssertValid(map);
+
+    return __atomic_load_n(&map->size, __ATOMIC_RELAXED);
+}
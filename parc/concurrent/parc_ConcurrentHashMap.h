@@ -0,0 +1,462 @@
+/*
+ * Copyright (c) 2015, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @file parc_ConcurrentHashMap.h
+ * @ingroup threading
+ * @brief A hash map that may be shared between threads without external locking.
+ *
+ * A `PARCConcurrentHashMap` maps `PARCObject` keys to `PARCObject` values using the same
+ * `parcObject_HashCode` and `parcObject_Equals` contracts as `PARCHashMap`.
+ *
+ * Lookups never block: readers traverse the bucket chains without taking any lock,
+ * so `parcConcurrentHashMap_Get` and `parcConcurrentHashMap_Contains` scale with the number of reader cores.
+ * Writers are serialised per stripe of buckets, so writers of keys in different stripes proceed in parallel.
+ *
+ * Entries that are removed or replaced are not released immediately because a concurrent reader may still be
+ * examining them. They are retired and reclaimed once every thread that could have observed them
+ * has left its read-side critical section (epoch based reclamation).
+ *
+ * Because a value may be removed by another thread at any time,
+ * `parcConcurrentHashMap_Get` returns a new reference to the value which the caller must release.
+ *
+ * @author Glenn Scott, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#ifndef PARCLibrary_parc_ConcurrentHashMap
+#define PARCLibrary_parc_ConcurrentHashMap
+#include <stdbool.h>
+
+#include <parc/algol/parc_Object.h>
+#include <parc/algol/parc_HashCode.h>
+#include <parc/algol/parc_BufferComposer.h>
+
+struct PARCConcurrentHashMap;
+typedef struct PARCConcurrentHashMap PARCConcurrentHashMap;
+
+/**
+ * Increase the number of references to a `PARCConcurrentHashMap` instance.
+ *
+ * Note that new `PARCConcurrentHashMap` is not created,
+ * only that the given `PARCConcurrentHashMap` reference count is incremented.
+ * Discard the reference by invoking `parcConcurrentHashMap_Release`.
+ *
+ * @param [in] instance A pointer to a valid PARCConcurrentHashMap instance.
+ *
+ * @return The same value as @p instance.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCConcurrentHashMap *a = parcConcurrentHashMap_Create();
+ *
+ *     PARCConcurrentHashMap *b = parcConcurrentHashMap_Acquire(a);
+ *
+ *     parcConcurrentHashMap_Release(&a);
+ *     parcConcurrentHashMap_Release(&b);
+ * }
+ * @endcode
+ */
+PARCConcurrentHashMap *parcConcurrentHashMap_Acquire(const PARCConcurrentHashMap *instance);
+
+#ifdef PARCLibrary_DISABLE_VALIDATION
+#  define parcConcurrentHashMap_OptionalAssertValid(_instance_)
+#else
+#  define parcConcurrentHashMap_OptionalAssertValid(_instance_) parcConcurrentHashMap_AssertValid(_instance_)
+#endif
+
+/**
+ * Assert that the given `PARCConcurrentHashMap` instance is valid.
+ *
+ * @param [in] instance A pointer to a valid PARCConcurrentHashMap instance.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCConcurrentHashMap *a = parcConcurrentHashMap_Create();
+ *
+ *     parcConcurrentHashMap_AssertValid(a);
+ *
+ *     parcConcurrentHashMap_Release(&a);
+ * }
+ * @endcode
+ */
+void parcConcurrentHashMap_AssertValid(const PARCConcurrentHashMap *instance);
+
+/**
+ * Create an instance of `PARCConcurrentHashMap` with a default initial capacity.
+ *
+ * @return non-NULL A pointer to a valid PARCConcurrentHashMap instance.
+ * @return NULL An error occurred.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCConcurrentHashMap *a = parcConcurrentHashMap_Create();
+ *
+ *     parcConcurrentHashMap_Release(&a);
+ * }
+ * @endcode
+ */
+PARCConcurrentHashMap *parcConcurrentHashMap_Create(void);
+
+/**
+ * Create an instance of `PARCConcurrentHashMap` able to hold at least @p capacity mappings before growing.
+ *
+ * The map grows automatically, so @p capacity is only a hint that avoids early resizing.
+ *
+ * @param [in] capacity The expected number of mappings.
+ *
+ * @return non-NULL A pointer to a valid PARCConcurrentHashMap instance.
+ * @return NULL An error occurred.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCConcurrentHashMap *a = parcConcurrentHashMap_CreateCapacity(1000);
+ *
+ *     parcConcurrentHashMap_Release(&a);
+ * }
+ * @endcode
+ */
+PARCConcurrentHashMap *parcConcurrentHashMap_CreateCapacity(unsigned int capacity);
+
+/**
+ * Create an independent copy of the given `PARCConcurrentHashMap`.
+ *
+ * The copy is a consistent snapshot of the original as of the time of the call.
+ * The keys and values are shared (acquired) with the original.
+ *
+ * @param [in] original A pointer to a valid PARCConcurrentHashMap instance.
+ *
+ * @return non-NULL A pointer to a new PARCConcurrentHashMap instance.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCConcurrentHashMap *a = parcConcurrentHashMap_Create();
+ *
+ *     PARCConcurrentHashMap *b = parcConcurrentHashMap_Copy(a);
+ *
+ *     parcConcurrentHashMap_Release(&a);
+ *     parcConcurrentHashMap_Release(&b);
+ * }
+ * @endcode
+ */
+PARCConcurrentHashMap *parcConcurrentHashMap_Copy(const PARCConcurrentHashMap *original);
+
+/**
+ * Print a human readable representation of the given `PARCConcurrentHashMap`.
+ *
+ * @param [in] instance A pointer to a valid PARCConcurrentHashMap instance.
+ * @param [in] indentation The indentation level to use for printing.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCConcurrentHashMap *a = parcConcurrentHashMap_Create();
+ *
+ *     parcConcurrentHashMap_Display(a, 0);
+ *
+ *     parcConcurrentHashMap_Release(&a);
+ * }
+ * @endcode
+ */
+void parcConcurrentHashMap_Display(const PARCConcurrentHashMap *instance, int indentation);
+
+/**
+ * Determine if two `PARCConcurrentHashMap` instances are equal.
+ *
+ * Two instances are equal if they contain the same number of mappings
+ * and every key in @p x maps to an equal value in @p y.
+ * If either map is concurrently modified the result reflects some interleaving of those modifications.
+ *
+ * @param [in] x A pointer to a valid PARCConcurrentHashMap instance.
+ * @param [in] y A pointer to a valid PARCConcurrentHashMap instance.
+ *
+ * @return true The instances x and y are equal.
+ * @return false The instances x and y are not equal.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCConcurrentHashMap *a = parcConcurrentHashMap_Create();
+ *     PARCConcurrentHashMap *b = parcConcurrentHashMap_Create();
+ *
+ *     if (parcConcurrentHashMap_Equals(a, b)) {
+ *         printf("Instances are equal.\n");
+ *     }
+ *
+ *     parcConcurrentHashMap_Release(&a);
+ *     parcConcurrentHashMap_Release(&b);
+ * }
+ * @endcode
+ */
+bool parcConcurrentHashMap_Equals(const PARCConcurrentHashMap *x, const PARCConcurrentHashMap *y);
+
+/**
+ * Returns a hash code value for the given instance.
+ *
+ * The hash code is independent of the order in which the mappings were made,
+ * so equal maps have equal hash codes.
+ *
+ * @param [in] instance A pointer to a valid PARCConcurrentHashMap instance.
+ *
+ * @return The hashcode for the given instance.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCConcurrentHashMap *a = parcConcurrentHashMap_Create();
+ *
+ *     PARCHashCode hashValue = parcConcurrentHashMap_HashCode(a);
+ *
+ *     parcConcurrentHashMap_Release(&a);
+ * }
+ * @endcode
+ */
+PARCHashCode parcConcurrentHashMap_HashCode(const PARCConcurrentHashMap *instance);
+
+/**
+ * Determine if an instance of `PARCConcurrentHashMap` is valid.
+ *
+ * @param [in] instance A pointer to a PARCConcurrentHashMap instance.
+ *
+ * @return true The instance is valid.
+ * @return false The instance is not valid.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCConcurrentHashMap *a = parcConcurrentHashMap_Create();
+ *
+ *     if (parcConcurrentHashMap_IsValid(a)) {
+ *         printf("Instance is valid.\n");
+ *     }
+ *
+ *     parcConcurrentHashMap_Release(&a);
+ * }
+ * @endcode
+ */
+bool parcConcurrentHashMap_IsValid(const PARCConcurrentHashMap *instance);
+
+/**
+ * Release a previously acquired reference to the given `PARCConcurrentHashMap` instance,
+ * decrementing the reference count for the instance.
+ *
+ * The pointer to the instance is set to NULL as a side-effect of this function.
+ *
+ * If the invocation causes the last reference to the instance to be released,
+ * the instance is deallocated and all of its keys and values, including retired ones, are released.
+ * The caller must ensure that no other thread is still using the instance.
+ *
+ * @param [in,out] instancePtr A pointer to a pointer to the instance to release.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCConcurrentHashMap *a = parcConcurrentHashMap_Create();
+ *
+ *     parcConcurrentHashMap_Release(&a);
+ * }
+ * @endcode
+ */
+void parcConcurrentHashMap_Release(PARCConcurrentHashMap **instancePtr);
+
+/**
+ * Append a human readable representation of the given `PARCConcurrentHashMap` to a `PARCBufferComposer`.
+ *
+ * @param [in] map A pointer to a valid PARCConcurrentHashMap instance.
+ * @param [in] composer A pointer to a valid PARCBufferComposer instance.
+ *
+ * @return The value of @p composer.
+ */
+PARCBufferComposer *parcConcurrentHashMap_BuildString(const PARCConcurrentHashMap *map, PARCBufferComposer *composer);
+
+/**
+ * Produce a null-terminated string representation of the specified `PARCConcurrentHashMap`.
+ *
+ * The result must be freed by the caller via {@link parcMemory_Deallocate}.
+ *
+ * @param [in] instance A pointer to a valid PARCConcurrentHashMap instance.
+ *
+ * @return NULL Cannot allocate memory.
+ * @return non-NULL A pointer to an allocated, null-terminated C string that must be deallocated via {@link parcMemory_Deallocate}.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCConcurrentHashMap *a = parcConcurrentHashMap_Create();
+ *
+ *     char *string = parcConcurrentHashMap_ToString(a);
+ *
+ *     parcConcurrentHashMap_Release(&a);
+ *
+ *     parcMemory_Deallocate(&string);
+ * }
+ * @endcode
+ */
+char *parcConcurrentHashMap_ToString(const PARCConcurrentHashMap *instance);
+
+/**
+ * Associate the specified value with the specified key in this map.
+ *
+ * As with `PARCHashMap`, the key is copied and the value is acquired.
+ * If the map previously contained a mapping for the key, the old value is replaced
+ * and released once no concurrent reader can still observe it.
+ *
+ * @param [in] map A pointer to a valid PARCConcurrentHashMap instance.
+ * @param [in] key A pointer to a valid PARCObject to use as the key.
+ * @param [in] value A pointer to a valid PARCObject to associate with the key.
+ *
+ * @return The value of @p map.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCConcurrentHashMap *map = parcConcurrentHashMap_Create();
+ *
+ *     parcConcurrentHashMap_Put(map, key, value);
+ *
+ *     parcConcurrentHashMap_Release(&map);
+ * }
+ * @endcode
+ */
+PARCConcurrentHashMap *parcConcurrentHashMap_Put(PARCConcurrentHashMap *map, const PARCObject *key, const PARCObject *value);
+
+/**
+ * Get a new reference to the value to which the specified key is mapped.
+ *
+ * This function never blocks and may run concurrently with any other operation on the map.
+ * The caller must release the result via `parcObject_Release`.
+ *
+ * @param [in] map A pointer to a valid PARCConcurrentHashMap instance.
+ * @param [in] key A pointer to a valid PARCObject.
+ *
+ * @return non-NULL A new reference to the value mapped to @p key.
+ * @return NULL The map contains no mapping for @p key.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCObject *value = parcConcurrentHashMap_Get(map, key);
+ *     if (value != NULL) {
+ *         ...
+ *         parcObject_Release(&value);
+ *     }
+ * }
+ * @endcode
+ */
+PARCObject *parcConcurrentHashMap_Get(const PARCConcurrentHashMap *map, const PARCObject *key);
+
+/**
+ * Determine if the map contains a mapping for the specified key.
+ *
+ * This function never blocks and may run concurrently with any other operation on the map.
+ *
+ * @param [in] map A pointer to a valid PARCConcurrentHashMap instance.
+ * @param [in] key A pointer to a valid PARCObject.
+ *
+ * @return true The map contains a mapping for @p key.
+ * @return false The map does not contain a mapping for @p key.
+ *
+ * Example:
+ * @code
+ * {
+ *     if (parcConcurrentHashMap_Contains(map, key)) {
+ *         ...
+ *     }
+ * }
+ * @endcode
+ */
+bool parcConcurrentHashMap_Contains(const PARCConcurrentHashMap *map, const PARCObject *key);
+
+/**
+ * Remove the mapping for the specified key from the map, if present.
+ *
+ * The key and value are released once no concurrent reader can still observe them.
+ *
+ * @param [in] map A pointer to a valid PARCConcurrentHashMap instance.
+ * @param [in] key A pointer to a valid PARCObject.
+ *
+ * @return true The key existed and was removed.
+ * @return false The key did not exist.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcConcurrentHashMap_Remove(map, key);
+ * }
+ * @endcode
+ */
+bool parcConcurrentHashMap_Remove(PARCConcurrentHashMap *map, const PARCObject *key);
+
+/**
+ * Get the number of mappings in the map.
+ *
+ * If the map is concurrently modified the result is only a snapshot.
+ *
+ * @param [in] map A pointer to a valid PARCConcurrentHashMap instance.
+ *
+ * @return The number of mappings in the map.
+ *
+ * Example:
+ * @code
+ * {
+ *     size_t size = parcConcurrentHashMap_Size(map);
+ * }
+ * @endcode
+ */
+size_t parcConcurrentHashMap_Size(const PARCConcurrentHashMap *map);
+#endif
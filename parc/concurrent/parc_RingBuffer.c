@@ -71,6 +71,8 @@
 #include <LongBow/runtime.h>
 
 #include <parc/concurrent/parc_RingBuffer.h>
+#include <parc/concurrent/parc_RingBuffer_1x1.h>
+#include <parc/concurrent/parc_RingBuffer_NxM.h>
 
 struct parc_ringbuffer {
     PARCRingBufferInterface *interface;
@@ -93,6 +95,58 @@ parcRingBuffer_Create(PARCRingBufferInterface *interface)
     return ring;
 }
 
+static void
+_parcRingBuffer_ReleaseNxM(PARCRingBufferInterface **interfacePtr)
+{
+    PARCRingBufferInterface *interface = *interfacePtr;
+    parcRingBufferNxM_Release((PARCRingBufferNxM **) &interface->instance);
+    parcMemory_Deallocate((void **) interfacePtr);
+}
+
+PARCRingBuffer *
+parcRingBuffer_CreateMultipleProducerMultipleConsumer(uint32_t elements, RingBufferEntryDestroyer *destroyer)
+{
+    PARCRingBufferInterface *interface = parcMemory_AllocateAndClear(sizeof(PARCRingBufferInterface));
+    assertNotNull(interface, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(PARCRingBufferInterface));
+
+    interface->instance = parcRingBufferNxM_Create(elements, destroyer);
+    interface->acquire = (void *(*)(const void *)) parcRingBufferNxM_Acquire;
+    interface->release = _parcRingBuffer_ReleaseNxM;
+    interface->put = (bool (*)(void *, void *)) parcRingBufferNxM_Put;
+    interface->get = (bool (*)(void *, void **)) parcRingBufferNxM_Get;
+    interface->remaining = (uint32_t (*)(void *)) parcRingBufferNxM_Remaining;
+    interface->putN = (uint32_t (*)(void *, void *const *, uint32_t)) parcRingBufferNxM_PutN;
+    interface->getN = (uint32_t (*)(void *, void **, uint32_t)) parcRingBufferNxM_GetN;
+
+    return parcRingBuffer_Create(interface);
+}
+
+static void
+_parcRingBuffer_Release1x1(PARCRingBufferInterface **interfacePtr)
+{
+    PARCRingBufferInterface *interface = *interfacePtr;
+    parcRingBuffer1x1_Release((PARCRingBuffer1x1 **) &interface->instance);
+    parcMemory_Deallocate((void **) interfacePtr);
+}
+
+PARCRingBuffer *
+parcRingBuffer_CreateSingleProducerSingleConsumer(uint32_t elements, RingBufferEntryDestroyer *destroyer)
+{
+    PARCRingBufferInterface *interface = parcMemory_AllocateAndClear(sizeof(PARCRingBufferInterface));
+    assertNotNull(interface, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(PARCRingBufferInterface));
+
+    interface->instance = parcRingBuffer1x1_Create(elements, destroyer);
+    interface->acquire = (void *(*)(const void *)) parcRingBuffer1x1_Acquire;
+    interface->release = _parcRingBuffer_Release1x1;
+    interface->put = (bool (*)(void *, void *)) parcRingBuffer1x1_Put;
+    interface->get = (bool (*)(void *, void **)) parcRingBuffer1x1_Get;
+    interface->remaining = (uint32_t (*)(void *)) parcRingBuffer1x1_Remaining;
+    interface->putN = (uint32_t (*)(void *, void *const *, uint32_t)) parcRingBuffer1x1_PutBatch;
+    interface->getN = (uint32_t (*)(void *, void **, uint32_t)) parcRingBuffer1x1_GetBatch;
+
+    return parcRingBuffer_Create(interface);
+}
+
 parcObject_ImplementAcquire(parcRingBuffer, PARCRingBuffer);
 
 parcObject_ImplementRelease(parcRingBuffer, PARCRingBuffer);
@@ -106,7 +160,39 @@ parcRingBuffer_Put(PARCRingBuffer *ring, void *data)
 bool
 parcRingBuffer_Get(PARCRingBuffer *ring, void **outputDataPtr)
 {
-    return ring->interface->put(ring->interface->instance, outputDataPtr);
+    return ring->interface->get(ring->interface->instance, outputDataPtr);
+}
+
+uint32_t
+parcRingBuffer_PutN(PARCRingBuffer *ring, void *const data[], uint32_t count)
+{
+    uint32_t result = 0;
+
+    if (ring->interface->putN != NULL) {
+        result = ring->interface->putN(ring->interface->instance, data, count);
+    } else {
+        while (result < count && ring->interface->put(ring->interface->instance, data[result])) {
+            result++;
+        }
+    }
+
+    return result;
+}
+
+uint32_t
+parcRingBuffer_GetN(PARCRingBuffer *ring, void *output[], uint32_t count)
+{
+    uint32_t result = 0;
+
+    if (ring->interface->getN != NULL) {
+        result = ring->interface->getN(ring->interface->instance, output, count);
+    } else {
+        while (result < count && ring->interface->get(ring->interface->instance, &output[result])) {
+            result++;
+        }
+    }
+
+    return result;
 }
 
 uint32_t
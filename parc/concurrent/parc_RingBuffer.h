@@ -62,8 +62,9 @@
  *
  * This is a non-blocking data structure.
  *
- * If the user knows there is only one producer and one consumer, you can create the ring buffer with
- * `parcRingBuffer_CreateSingleProducerSingleConsumer`. Such a ring buffer can have at most 2 references.
+ * Create the ring buffer with `parcRingBuffer_CreateMultipleProducerMultipleConsumer`, or, if the user
+ * knows there is only one producer and one consumer, with `parcRingBuffer_CreateSingleProducerSingleConsumer`.
+ * Such a ring buffer can have at most 2 references.  Callers switch between the two by changing the constructor.
  *
  * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
  * @copyright (c) 2013-2014, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
@@ -75,22 +76,23 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+#include <parc/concurrent/parc_RingBuffer_1x1.h>
+
 struct parc_ringbuffer;
 typedef struct parc_ringbuffer PARCRingBuffer;
 
-/**< Will be called for each data item on destroy */
-typedef void (RingBufferEntryDestroyer)(void **entryPtr);
-
 struct parc_ringbuffer_impl;
 typedef struct parc_ringbuffer_interface PARCRingBufferInterface;
 
 struct parc_ringbuffer_interface {
     void *instance;
-    void * (*acquire)(PARCRingBufferInterface *ring);
+    void * (*acquire)(const void *instance);
     void (*release)(PARCRingBufferInterface **ring);
-    bool (*put)(PARCRingBufferInterface *ring, void *data);
-    bool (*get)(PARCRingBufferInterface *ring, void *outputDataPtr);
-    bool (*remaining)(PARCRingBufferInterface *ring);
+    bool (*put)(void *instance, void *data);
+    bool (*get)(void *instance, void **outputDataPtr);
+    uint32_t (*remaining)(void *instance);
+    uint32_t (*putN)(void *instance, void *const data[], uint32_t count);
+    uint32_t (*getN)(void *instance, void *output[], uint32_t count);
 };
 
 /**
@@ -115,6 +117,44 @@ struct parc_ringbuffer_interface {
  */
 PARCRingBuffer *parcRingBuffer_Create(PARCRingBufferInterface *interface);
 
+/**
+ * Creates a ring buffer for any number of producers and consumers, backed by a lock-free `PARCRingBufferNxM`.
+ *
+ * @param [in] elements A power of 2, indicating the maximum size of the buffer.
+ * @param [in] destroyer Will be called for each ring entry when when the ring is destroyed.  May be null.
+ *
+ * @return non-null An pointer to a new allocated `PARCRingBuffer`.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCRingBuffer *ring = parcRingBuffer_CreateMultipleProducerMultipleConsumer(1024, NULL);
+ *     parcRingBuffer_Put(ring, data);
+ *     parcRingBuffer_Release(&ring);
+ * }
+ * @endcode
+ */
+PARCRingBuffer *parcRingBuffer_CreateMultipleProducerMultipleConsumer(uint32_t elements, RingBufferEntryDestroyer *destroyer);
+
+/**
+ * Creates a ring buffer for exactly one producer and one consumer, backed by a `PARCRingBuffer1x1`.
+ *
+ * @param [in] elements A power of 2, indicating the maximum size of the buffer.
+ * @param [in] destroyer Will be called for each ring entry when when the ring is destroyed.  May be null.
+ *
+ * @return non-null An pointer to a new allocated `PARCRingBuffer`.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCRingBuffer *ring = parcRingBuffer_CreateSingleProducerSingleConsumer(1024, NULL);
+ *     parcRingBuffer_Put(ring, data);
+ *     parcRingBuffer_Release(&ring);
+ * }
+ * @endcode
+ */
+PARCRingBuffer *parcRingBuffer_CreateSingleProducerSingleConsumer(uint32_t elements, RingBufferEntryDestroyer *destroyer);
+
 /**
  * Acquire a new reference to an instance of `PARCRingBuffer`.
  *
@@ -184,6 +224,46 @@ bool parcRingBuffer_Put(PARCRingBuffer *ring, void *data);
  */
 bool parcRingBuffer_Get(PARCRingBuffer *ring, void **outputDataPtr);
 
+/**
+ * Non-blocking attempt to put up to @p count items on the ring, in order.
+ *
+ * If the ring does not have room for all of them, only the first items are put.
+ *
+ * @param [in,out] ring The instance of `PARCRingBuffer` to modify
+ * @param [in] data An array of @p count pointers to put on the ring.
+ * @param [in] count The number of items in @p data.
+ *
+ * @return The number of items put on the ring.
+ *
+ * Example:
+ * @code
+ * {
+ *     void *items[2] = { a, b };
+ *     uint32_t put = parcRingBuffer_PutN(ring, items, 2);
+ * }
+ * @endcode
+ */
+uint32_t parcRingBuffer_PutN(PARCRingBuffer *ring, void *const data[], uint32_t count);
+
+/**
+ * Non-blocking attempt to get up to @p count items off the ring.
+ *
+ * @param [in] ring The pointer to the `PARCRingBuffer`
+ * @param [out] output An array with room for @p count pointers.
+ * @param [in] count The maximum number of items to get.
+ *
+ * @return The number of items stored in @p output, 0 if the ring was empty.
+ *
+ * Example:
+ * @code
+ * {
+ *     void *items[16];
+ *     uint32_t got = parcRingBuffer_GetN(ring, items, 16);
+ * }
+ * @endcode
+ */
+uint32_t parcRingBuffer_GetN(PARCRingBuffer *ring, void *output[], uint32_t count);
+
 /**
  * Returns the remaining capacity of the ring
  *
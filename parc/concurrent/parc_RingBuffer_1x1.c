@@ -108,6 +108,10 @@
  * If (writer_head + 1) & ring_mask == reader_tail, then the ring is full.
  * If writer_head == reader_tail, then the ring is empty.
  *
+ * A batch put stores all its entries and then publishes them with a single release store of writer_head,
+ * and a batch get reads all its entries and then frees them with a single release store of reader_tail.
+ * The other side reads the index with acquire semantics, so there are no full barriers on either path.
+ *
  * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
  * @copyright (c) 2013-2015, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
  */
@@ -126,34 +130,24 @@
 
 #include <parc/concurrent/parc_RingBuffer_1x1.h>
 
-#ifdef __GNUC__
-
-// on x86 or x86_64, simple assignment will work
-#if (__x86_64__ || __i386__)
-#define ATOMIC_ADD_AND_FETCH(ptr, increment)      __sync_add_and_fetch(ptr, increment)
-#define ATOMIC_BOOL_CAS(ptr, oldvalue, newvalue)  __sync_bool_compare_and_swap(ptr, oldvalue, newvalue)
-#define ATOMIC_FETCH(ptr)                        *(ptr)
-#define ATOMIC_SET(ptr, oldvalue, newvalue)      *(ptr) = newvalue
-#else
-#define ATOMIC_ADD_AND_FETCH(ptr, increment)      __sync_add_and_fetch(ptr, increment)
-#define ATOMIC_BOOL_CAS(ptr, oldvalue, newvalue)  __sync_bool_compare_and_swap(ptr, oldvalue, newvalue)
-#define ATOMIC_FETCH(ptr)                         ATOMIC_ADD_AND_FETCH(ptr, 0)
-#define ATOMIC_SET(ptr, oldvalue, newvalue)       ATOMIC_BOOL_CAS(ptr, oldvalue, newvalue)
-#endif
-
-#else
-#error "Only GNUC supported, we need atomic operations"
-#endif
+#define _PARCRingBuffer1x1_CacheLineSize 64
 
 struct parc_ringbuffer_1x1 {
-    // LP64     LP32
-    volatile uint32_t writer_head;          //  0- 3       0
-    volatile uint32_t reader_tail;          //  4- 7       4
-    uint32_t elements;                      //  8-11       8
-    uint32_t ring_mask;                     // 12-15      12
-
-    RingBufferEntryDestroyer *destroyer;    // 16-23      16
-    void **buffer;                          // 24-31      24
+    uint32_t elements;
+    uint32_t ring_mask;
+    RingBufferEntryDestroyer *destroyer;
+    void **buffer;
+
+    // Only the producer writes writer_head and only the consumer writes reader_tail.  Each side also keeps
+    // its last view of the other side's index next to its own, so it only reads the other side's cache line
+    // when the cached view says the ring is full (or empty).
+    uint8_t padding0[_PARCRingBuffer1x1_CacheLineSize];
+    uint32_t writer_head;
+    uint32_t producer_reader_tail;
+    uint8_t padding1[_PARCRingBuffer1x1_CacheLineSize - 2 * sizeof(uint32_t)];
+    uint32_t reader_tail;
+    uint32_t consumer_writer_head;
+    uint8_t padding2[_PARCRingBuffer1x1_CacheLineSize - 2 * sizeof(uint32_t)];
 };
 
 static bool
@@ -188,7 +182,9 @@ _create(uint32_t elements, RingBufferEntryDestroyer *destroyer)
     assertNotNull((ring->buffer), "parcMemory_AllocateAndClear() failed to allocate array of %u pointers", elements);
 
     ring->writer_head = 0;
+    ring->producer_reader_tail = 0;
     ring->reader_tail = 0;
+    ring->consumer_writer_head = 0;
     ring->elements = elements;
     ring->destroyer = destroyer;
     ring->ring_mask = elements - 1;
@@ -209,32 +205,86 @@ parcObject_ImplementAcquire(parcRingBuffer1x1, PARCRingBuffer1x1);
 parcObject_ImplementRelease(parcRingBuffer1x1, PARCRingBuffer1x1);
 
 /**
- * Put is protected by the writer mutex.  This means that the tail mutex could
- * actually increase while this is happening. That's ok.  Increasing the tail
- * just means there is _more_ room in the ring.  We only modify writer_head.
+ * Only the producer modifies writer_head.  The consumer may advance reader_tail while this is happening.
+ * That's ok.  Increasing the tail just means there is _more_ room in the ring.
+ *
+ * The entries are stored before writer_head is published with release semantics, and the consumer
+ * reads writer_head with acquire semantics, so the consumer never sees an index before its entry.
  */
+uint32_t
+parcRingBuffer1x1_PutBatch(PARCRingBuffer1x1 *ring, void *const data[], uint32_t count)
+{
+    uint32_t writer_head = ring->writer_head;
+    uint32_t available = (ring->ring_mask + ring->producer_reader_tail - writer_head) & ring->ring_mask;
+
+    if (available < count) {
+        ring->producer_reader_tail = __atomic_load_n(&ring->reader_tail, __ATOMIC_ACQUIRE);
+        available = (ring->ring_mask + ring->producer_reader_tail - writer_head) & ring->ring_mask;
+    }
+
+    uint32_t result = (count < available) ? count : available;
+    for (uint32_t i = 0; i < result; i++) {
+        uint32_t index = (writer_head + i) & ring->ring_mask;
+        assertNull(ring->buffer[index], "Ring index %u is not null!", index);
+        ring->buffer[index] = data[i];
+    }
+
+    if (result > 0) {
+        __atomic_store_n(&ring->writer_head, (writer_head + result) & ring->ring_mask, __ATOMIC_RELEASE);
+    }
+
+    return result;
+}
+
+/**
+ * Only the consumer modifies reader_tail.  The entries are read before reader_tail is published with
+ * release semantics, so the producer cannot overwrite them while they are being read.
+ */
+uint32_t
+parcRingBuffer1x1_GetBatch(PARCRingBuffer1x1 *ring, void *output[], uint32_t count)
+{
+    uint32_t reader_tail = ring->reader_tail;
+    uint32_t used = (ring->consumer_writer_head - reader_tail) & ring->ring_mask;
+
+    if (used < count) {
+        ring->consumer_writer_head = __atomic_load_n(&ring->writer_head, __ATOMIC_ACQUIRE);
+        used = (ring->consumer_writer_head - reader_tail) & ring->ring_mask;
+    }
+
+    uint32_t result = (count < used) ? count : used;
+    for (uint32_t i = 0; i < result; i++) {
+        uint32_t index = (reader_tail + i) & ring->ring_mask;
+        output[i] = ring->buffer[index];
+
+        // for sanity's sake
+        ring->buffer[index] = NULL;
+    }
+
+    if (result > 0) {
+        __atomic_store_n(&ring->reader_tail, (reader_tail + result) & ring->ring_mask, __ATOMIC_RELEASE);
+    }
+
+    return result;
+}
+
 bool
 parcRingBuffer1x1_Put(PARCRingBuffer1x1 *ring, void *data)
 {
-    // Our speculative operation
-    // The consumer modifies reader_tail, so make sure that's an atomic read.
-    // only the prodcuer modifies writer_head, so there's only us
-
     uint32_t writer_head = ring->writer_head;
-    uint32_t reader_tail = ATOMIC_FETCH(&ring->reader_tail);
-
     uint32_t writer_next = (writer_head + 1) & ring->ring_mask;
 
-    // ring is full
-    if (writer_next == reader_tail) {
-        return false;
+    if (writer_next == ring->producer_reader_tail) {
+        ring->producer_reader_tail = __atomic_load_n(&ring->reader_tail, __ATOMIC_ACQUIRE);
+
+        // ring is full
+        if (writer_next == ring->producer_reader_tail) {
+            return false;
+        }
     }
 
     assertNull(ring->buffer[writer_head], "Ring index %u is not null!", writer_head);
     ring->buffer[writer_head] = data;
-
-    // we're using this just for atomic write to the integer
-    ATOMIC_SET(&ring->writer_head, writer_head, writer_next);
+    __atomic_store_n(&ring->writer_head, writer_next, __ATOMIC_RELEASE);
 
     return true;
 }
@@ -242,26 +292,22 @@ parcRingBuffer1x1_Put(PARCRingBuffer1x1 *ring, void *data)
 bool
 parcRingBuffer1x1_Get(PARCRingBuffer1x1 *ring, void **outputDataPtr)
 {
-    // do our speculative operation.
-    // The producer modifies writer_head, so make sure that's an atomic read.
-    // only the consumer modifies reader_tail, so there's only us
-
-    uint32_t writer_head = ATOMIC_FETCH(&ring->writer_head); // native type assignment is atomic
     uint32_t reader_tail = ring->reader_tail;
-    uint32_t reader_next = (reader_tail + 1) & ring->ring_mask;
 
-    // ring is empty
-    if (writer_head == reader_tail) {
-        return false;
-    }
+    if (reader_tail == ring->consumer_writer_head) {
+        ring->consumer_writer_head = __atomic_load_n(&ring->writer_head, __ATOMIC_ACQUIRE);
 
-    // now try to commit it
-    ATOMIC_SET(&ring->reader_tail, reader_tail, reader_next);
+        // ring is empty
+        if (reader_tail == ring->consumer_writer_head) {
+            return false;
+        }
+    }
 
     *outputDataPtr = ring->buffer[reader_tail];
 
     // for sanity's sake
     ring->buffer[reader_tail] = NULL;
+    __atomic_store_n(&ring->reader_tail, (reader_tail + 1) & ring->ring_mask, __ATOMIC_RELEASE);
 
     return true;
 }
@@ -269,8 +315,8 @@ parcRingBuffer1x1_Get(PARCRingBuffer1x1 *ring, void **outputDataPtr)
 uint32_t
 parcRingBuffer1x1_Remaining(PARCRingBuffer1x1 *ring)
 {
-    uint32_t writer_head = ATOMIC_FETCH(&ring->writer_head);
-    uint32_t reader_tail = ATOMIC_FETCH(&ring->reader_tail);
+    uint32_t writer_head = __atomic_load_n(&ring->writer_head, __ATOMIC_ACQUIRE);
+    uint32_t reader_tail = __atomic_load_n(&ring->reader_tail, __ATOMIC_ACQUIRE);
 
     return (ring->ring_mask + reader_tail - writer_head) & ring->ring_mask;
 }
@@ -165,6 +165,53 @@ bool parcRingBuffer1x1_Put(PARCRingBuffer1x1 *ring, void *data);
  */
 bool parcRingBuffer1x1_Get(PARCRingBuffer1x1 *ring, void **outputDataPtr);
 
+/**
+ * Non-blocking attempt to put up to @p count items on the ring.
+ *
+ * The items are put on the ring in order, and the consumer sees all of them at once.
+ * Only the producer may call this function.
+ *
+ * @param [in,out] ring The instance of `PARCRingBuffer1x1` on which to put the @p data.
+ * @param [in] data An array of @p count items to put on the @p ring.
+ * @param [in] count The number of items in @p data.
+ *
+ * @return The number of items, from the start of @p data, put on the ring.  0 if the ring was full.
+ *
+ * Example:
+ * @code
+ * {
+ *     void *items[] = { a, b, c };
+ *     uint32_t put = parcRingBuffer1x1_PutBatch(ring, items, 3);
+ *     // items[put] onwards were not put on the ring.
+ * }
+ * @endcode
+ */
+uint32_t parcRingBuffer1x1_PutBatch(PARCRingBuffer1x1 *ring, void *const data[], uint32_t count);
+
+/**
+ * Non-blocking attempt to get up to @p count items off the ring.
+ *
+ * Only the consumer may call this function.
+ *
+ * @param [in] ring The ring buffer
+ * @param [out] output An array with room for @p count pointers.
+ * @param [in] count The maximum number of items to get.
+ *
+ * @return The number of items stored in @p output, 0 if the ring was empty.
+ *
+ * Example:
+ * @code
+ * {
+ *     void *items[16];
+ *     uint32_t got = parcRingBuffer1x1_GetBatch(ring, items, 16);
+ *     for (uint32_t i = 0; i < got; i++) {
+ *         process(items[i]);
+ *     }
+ * }
+ * @endcode
+ */
+uint32_t parcRingBuffer1x1_GetBatch(PARCRingBuffer1x1 *ring, void *output[], uint32_t count);
+
 /**
  * Returns the remaining capacity of the ring
  *
@@ -55,7 +55,19 @@
 /**
  * A thread-safe fixed size ring buffer.
  *
- * The multiple producer, multiple consumer version uses a pthread mutex around a NxM ring buffer.
+ * The multiple producer, multiple consumer version is lock-free, after Dmitry Vyukov's bounded MPMC queue.
+ *
+ * Every slot carries a sequence number.  A slot at position `p` (an unbounded uint32_t, masked with ring_mask
+ * to get the index) is free for a producer when its sequence equals `p`, and holds data for a consumer when its
+ * sequence equals `p + 1`.  After reading it, the consumer sets the sequence to `p + elements`, which makes the
+ * slot free for the producer of the next lap around the ring.
+ *
+ * Producers claim positions by a compare-and-swap on writer_head and consumers by a compare-and-swap on
+ * reader_tail, so producers never contend with consumers, and the only shared writes are to the slots themselves.
+ * A batch operation claims a run of consecutive slots with a single compare-and-swap.
+ *
+ * Like the 1x1 ring, it holds at most (elements-1) items: a producer only claims position `p` if the slot
+ * at `p + 1` is free as well.
  *
  * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
  * @copyright (c) 2013-2015, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
@@ -64,8 +76,6 @@
 #include <config.h>
 #include <stdio.h>
 #include <stdlib.h>
-#include <pthread.h>
-#include <errno.h>
 #include <string.h>
 
 #include <parc/algol/parc_Memory.h>
@@ -75,37 +85,32 @@
 #include <parc/concurrent/parc_RingBuffer_1x1.h>
 #include <parc/concurrent/parc_RingBuffer_NxM.h>
 
-struct parc_ringbuffer_NxM {
-    PARCRingBuffer1x1 *onebyone;
+#define _PARCRingBufferNxM_CacheLineSize 64
 
-    // This protectes the overall data structure for Acquire and Release
-    pthread_mutex_t allocation_mutex;
-
-    pthread_mutex_t writer_mutex;
-    pthread_mutex_t reader_mutex;
+typedef struct {
+    uint32_t sequence;
+    void *data;
+} _PARCRingBufferNxMSlot;
 
+struct parc_ringbuffer_NxM {
+    uint32_t elements;
+    uint32_t ring_mask;
+    _PARCRingBufferNxMSlot *slots;
     RingBufferEntryDestroyer *destroyer;
-};
 
-/*
- * Attemps a lock and returns false if we cannot get it.
- *
- * @endcode
- */
-static bool
-_lock(pthread_mutex_t *mutex)
-{
-    int failure = pthread_mutex_lock(mutex);
-    assertFalse(failure, "Error locking mutex: (%d) %s\n", errno, strerror(errno));
-    return true;
-}
+    // Producers only write writer_head and consumers only write reader_tail.
+    // Keep each on its own cache line, away from the read-mostly fields above.
+    uint8_t padding0[_PARCRingBufferNxM_CacheLineSize];
+    uint32_t writer_head;
+    uint8_t padding1[_PARCRingBufferNxM_CacheLineSize - sizeof(uint32_t)];
+    uint32_t reader_tail;
+    uint8_t padding2[_PARCRingBufferNxM_CacheLineSize - sizeof(uint32_t)];
+};
 
 static bool
-_unlock(pthread_mutex_t *mutex)
+_isPowerOfTwo(uint32_t x)
 {
-    int failure = pthread_mutex_unlock(mutex);
-    assertFalse(failure, "Error unlocking mutex: (%d) %s\n", errno, strerror(errno));
-    return true;
+    return ((x != 0) && !(x & (x - 1)));
 }
 
 static void
@@ -119,7 +124,7 @@ _destroy(PARCRingBufferNxM **ringptr)
             ring->destroyer(&ptr);
         }
     }
-    parcRingBuffer1x1_Release(&ring->onebyone);
+    parcMemory_Deallocate((void **) &(ring->slots));
 }
 
 
@@ -131,78 +136,146 @@ _create(uint32_t elements, RingBufferEntryDestroyer *destroyer)
     PARCRingBufferNxM *ring = parcObject_CreateInstance(PARCRingBufferNxM);
     assertNotNull(ring, "parcObject_Create returned NULL");
 
-    ring->onebyone = parcRingBuffer1x1_Create(elements, destroyer);
+    ring->slots = parcMemory_AllocateAndClear(sizeof(_PARCRingBufferNxMSlot) * elements);
+    assertNotNull((ring->slots), "parcMemory_AllocateAndClear() failed to allocate array of %u slots", elements);
+
+    for (uint32_t i = 0; i < elements; i++) {
+        ring->slots[i].sequence = i;
+    }
+
+    ring->elements = elements;
+    ring->ring_mask = elements - 1;
     ring->destroyer = destroyer;
-    pthread_mutex_init(&ring->allocation_mutex, NULL);
-    pthread_mutex_init(&ring->writer_mutex, NULL);
-    pthread_mutex_init(&ring->reader_mutex, NULL);
+    ring->writer_head = 0;
+    ring->reader_tail = 0;
+
     return ring;
 }
 
 PARCRingBufferNxM *
 parcRingBufferNxM_Create(uint32_t elements, RingBufferEntryDestroyer *destroyer)
 {
+    assertTrue(_isPowerOfTwo(elements), "Parameter elements must be a power of 2, got %u", elements);
     return _create(elements, destroyer);
 }
 
-PARCRingBufferNxM *
-parcRingBufferNxM_Acquire(PARCRingBufferNxM *ring)
+parcObject_ImplementAcquire(parcRingBufferNxM, PARCRingBufferNxM);
+
+parcObject_ImplementRelease(parcRingBufferNxM, PARCRingBufferNxM);
+
+static uint32_t
+_loadSequence(const PARCRingBufferNxM *ring, uint32_t position)
 {
-    PARCRingBufferNxM *acquired;
+    return __atomic_load_n(&ring->slots[position & ring->ring_mask].sequence, __ATOMIC_ACQUIRE);
+}
+
+uint32_t
+parcRingBufferNxM_PutN(PARCRingBufferNxM *ring, void *const data[], uint32_t count)
+{
+    uint32_t writer_head = __atomic_load_n(&ring->writer_head, __ATOMIC_RELAXED);
+    uint32_t claimed = 0;
 
-    _lock(&ring->allocation_mutex);
-    acquired = parcObject_Acquire(ring);
-    _unlock(&ring->allocation_mutex);
+    while (count > 0) {
+        int32_t difference = (int32_t) (_loadSequence(ring, writer_head) - writer_head);
+        if (difference < 0) {
+            // ring is full
+            return 0;
+        }
+        if (difference > 0) {
+            // another producer claimed this position, try again from the current head
+            writer_head = __atomic_load_n(&ring->writer_head, __ATOMIC_RELAXED);
+            continue;
+        }
 
-    return acquired;
+        // Extend the claim while the slot after each claimed slot is free too.
+        claimed = 0;
+        while (claimed < count) {
+            uint32_t next = writer_head + claimed + 1;
+            if ((int32_t) (_loadSequence(ring, next) - next) < 0) {
+                break;
+            }
+            claimed++;
+        }
+
+        if (claimed == 0) {
+            // ring is full
+            return 0;
+        }
+
+        if (__atomic_compare_exchange_n(&ring->writer_head, &writer_head, writer_head + claimed, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+            break;
+        }
+    }
+
+    for (uint32_t i = 0; i < claimed; i++) {
+        _PARCRingBufferNxMSlot *slot = &ring->slots[(writer_head + i) & ring->ring_mask];
+        slot->data = data[i];
+        __atomic_store_n(&slot->sequence, writer_head + i + 1, __ATOMIC_RELEASE);
+    }
+
+    return claimed;
 }
 
-void
-parcRingBufferNxM_Release(PARCRingBufferNxM **ringPtr)
+uint32_t
+parcRingBufferNxM_GetN(PARCRingBufferNxM *ring, void *output[], uint32_t count)
 {
-    PARCRingBufferNxM *ring = *ringPtr;
-    _lock(&ring->allocation_mutex);
-    parcObject_Release((void **) ringPtr);
-    _unlock(&ring->allocation_mutex);
+    uint32_t reader_tail = __atomic_load_n(&ring->reader_tail, __ATOMIC_RELAXED);
+    uint32_t claimed = 0;
+
+    while (count > 0) {
+        int32_t difference = (int32_t) (_loadSequence(ring, reader_tail) - (reader_tail + 1));
+        if (difference < 0) {
+            // ring is empty
+            return 0;
+        }
+        if (difference > 0) {
+            // another consumer claimed this position, try again from the current tail
+            reader_tail = __atomic_load_n(&ring->reader_tail, __ATOMIC_RELAXED);
+            continue;
+        }
+
+        // Extend the claim over the following slots that have been published.
+        claimed = 1;
+        while (claimed < count && _loadSequence(ring, reader_tail + claimed) == reader_tail + claimed + 1) {
+            claimed++;
+        }
+
+        if (__atomic_compare_exchange_n(&ring->reader_tail, &reader_tail, reader_tail + claimed, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+            break;
+        }
+    }
+
+    for (uint32_t i = 0; i < claimed; i++) {
+        _PARCRingBufferNxMSlot *slot = &ring->slots[(reader_tail + i) & ring->ring_mask];
+        output[i] = slot->data;
+
+        // for sanity's sake
+        slot->data = NULL;
+        __atomic_store_n(&slot->sequence, reader_tail + i + ring->elements, __ATOMIC_RELEASE);
+    }
+
+    return claimed;
 }
 
-/**
- * Put is protected by the writer mutex.  This means that the tail mutex could
- * actually increase while this is happening. That's ok.  Increasing the tail
- * just means there is _more_ room in the ring.  We only modify writer_head.
- */
 bool
 parcRingBufferNxM_Put(PARCRingBufferNxM *ring, void *data)
 {
-    // **** LOCK
-    _lock(&ring->writer_mutex);
-    bool success = parcRingBuffer1x1_Put(ring->onebyone, data);
-    // **** UNLOCK
-    _unlock(&ring->writer_mutex);
-    return success;
+    return parcRingBufferNxM_PutN(ring, &data, 1) == 1;
 }
 
 bool
 parcRingBufferNxM_Get(PARCRingBufferNxM *ring, void **outputDataPtr)
 {
-    // **** LOCK
-    _lock(&ring->reader_mutex);
-    bool success = parcRingBuffer1x1_Get(ring->onebyone, outputDataPtr);
-    // **** UNLOCK
-    _unlock(&ring->reader_mutex);
-    return success;
+    return parcRingBufferNxM_GetN(ring, outputDataPtr, 1) == 1;
 }
 
 uint32_t
 parcRingBufferNxM_Remaining(PARCRingBufferNxM *ring)
 {
-    _lock(&ring->writer_mutex);
-    _lock(&ring->reader_mutex);
-
-    uint32_t remaining = parcRingBuffer1x1_Remaining(ring->onebyone);
-
-    _unlock(&ring->reader_mutex);
-    _unlock(&ring->writer_mutex);
+    // Read the tail first: the head can only have moved further ahead of it.
+    uint32_t reader_tail = __atomic_load_n(&ring->reader_tail, __ATOMIC_ACQUIRE);
+    uint32_t writer_head = __atomic_load_n(&ring->writer_head, __ATOMIC_ACQUIRE);
 
-    return remaining;
+    uint32_t used = writer_head - reader_tail;
+    return (used >= ring->ring_mask) ? 0 : ring->ring_mask - used;
 }
@@ -58,7 +58,8 @@
  * @brief A multiple producer, multiple consumer ring buffer
  *
  * This is useful for synchronizing one or more producers with one or more consumers.
- * The implementation may use locks.
+ * The implementation is lock-free: producers and consumers claim slots with compare-and-swap
+ * operations and never block one another.
  *
  * Complies with the PARCRingBuffer generic facade.
  *
@@ -104,8 +105,6 @@ PARCRingBufferNxM *parcRingBufferNxM_Create(uint32_t elements, RingBufferEntryDe
 /**
  * A reference counted copy of the buffer.
  *
- * A RING WITHOUT LOCKS CAN ONLY HAVE 2 REFERENCES.
- *
  * @param [in] ring A pointer to the `PARCRingBufferNxM` to be acquired.
  *
  * @return non-null A reference counted copy of the ring buffer
@@ -115,7 +114,7 @@ PARCRingBufferNxM *parcRingBufferNxM_Create(uint32_t elements, RingBufferEntryDe
  * <#example#>
  * @endcode
  */
-PARCRingBufferNxM *parcRingBufferNxM_Acquire(PARCRingBufferNxM *ring);
+PARCRingBufferNxM *parcRingBufferNxM_Acquire(const PARCRingBufferNxM *ring);
 
 /**
  * Releases a reference.  The buffer will be destroyed after the last release.
@@ -168,6 +167,52 @@ bool parcRingBufferNxM_Put(PARCRingBufferNxM *ring, void *data);
  */
 bool parcRingBufferNxM_Get(PARCRingBufferNxM *ring, void **outputDataPtr);
 
+/**
+ * Non-blocking attempt to put up to @p count items on the ring.
+ *
+ * The items are put in order, and a run of slots is claimed with a single atomic operation,
+ * so the items put by one call are contiguous in the ring.
+ * If the ring does not have room for all of them, only the first items are put.
+ *
+ * @param [in,out] ring A pointer to the `PARCRingBufferNxM` on which to put @p data.
+ * @param [in] data An array of @p count pointers to put on @p ring.
+ * @param [in] count The number of items in @p data.
+ *
+ * @return The number of items put on the ring, from 0 (the ring was full) to @p count.
+ *
+ * Example:
+ * @code
+ * {
+ *     void *items[3] = { a, b, c };
+ *     uint32_t put = parcRingBufferNxM_PutN(ring, items, 3);
+ *     // items[put] onwards were not put on the ring.
+ * }
+ * @endcode
+ */
+uint32_t parcRingBufferNxM_PutN(PARCRingBufferNxM *ring, void *const data[], uint32_t count);
+
+/**
+ * Non-blocking attempt to get up to @p count items off the ring.
+ *
+ * @param [in] ring The ring buffer
+ * @param [out] output An array with room for @p count pointers.
+ * @param [in] count The maximum number of items to get.
+ *
+ * @return The number of items stored in @p output, 0 if the ring was empty.
+ *
+ * Example:
+ * @code
+ * {
+ *     void *items[16];
+ *     uint32_t got = parcRingBufferNxM_GetN(ring, items, 16);
+ *     for (uint32_t i = 0; i < got; i++) {
+ *         process(items[i]);
+ *     }
+ * }
+ * @endcode
+ */
+uint32_t parcRingBufferNxM_GetN(PARCRingBufferNxM *ring, void *output[], uint32_t count);
+
 /**
  * Returns the remaining capacity of the ring
  *
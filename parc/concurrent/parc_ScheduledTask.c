@@ -71,6 +71,11 @@
 struct PARCScheduledTask {
     PARCFutureTask *task;
     uint64_t executionTime;
+    int64_t period;
+
+    size_t queueIndex;
+    void *owner;
+    PARCScheduledTaskCancelCallback *onCancel;
 };
 
 static bool
@@ -106,30 +111,46 @@ parcScheduledTask_AssertValid(const PARCScheduledTask *instance)
 
 
 PARCScheduledTask *
-parcScheduledTask_Create(PARCFutureTask *task, uint64_t executionTime)
+parcScheduledTask_CreatePeriodic(PARCFutureTask *task, uint64_t executionTime, int64_t period)
 {
     PARCScheduledTask *result = parcObject_CreateInstance(PARCScheduledTask);
 
     if (result != NULL) {
         result->task = parcFutureTask_Acquire(task);
         result->executionTime = executionTime;
+        result->period = period;
+        result->queueIndex = PARCScheduledTask_NotQueued;
+        result->owner = NULL;
+        result->onCancel = NULL;
     }
 
     return result;
 }
 
+PARCScheduledTask *
+parcScheduledTask_Create(PARCFutureTask *task, uint64_t executionTime)
+{
+    return parcScheduledTask_CreatePeriodic(task, executionTime, 0);
+}
+
 int
 parcScheduledTask_Compare(const PARCScheduledTask *instance, const PARCScheduledTask *other)
 {
     int result = 0;
 
+    if (instance->executionTime < other->executionTime) {
+        result = -1;
+    } else if (instance->executionTime > other->executionTime) {
+        result = 1;
+    }
+
     return result;
 }
 
 PARCScheduledTask *
 parcScheduledTask_Copy(const PARCScheduledTask *original)
 {
-    PARCScheduledTask *result = parcScheduledTask_Create(original->task, original->executionTime);
+    PARCScheduledTask *result = parcScheduledTask_CreatePeriodic(original->task, original->executionTime, original->period);
 
     return result;
 }
@@ -207,10 +228,60 @@ parcScheduledTask_GetExecutionTime(const PARCScheduledTask *task)
     return task->executionTime;
 }
 
+void
+parcScheduledTask_SetExecutionTime(PARCScheduledTask *task, uint64_t executionTime)
+{
+    task->executionTime = executionTime;
+}
+
+int64_t
+parcScheduledTask_GetPeriod(const PARCScheduledTask *task)
+{
+    return task->period;
+}
+
+bool
+parcScheduledTask_IsPeriodic(const PARCScheduledTask *task)
+{
+    return task->period != 0;
+}
+
+size_t
+parcScheduledTask_GetQueueIndex(const PARCScheduledTask *task)
+{
+    return task->queueIndex;
+}
+
+void
+parcScheduledTask_SetQueueIndex(PARCScheduledTask *task, size_t index)
+{
+    task->queueIndex = index;
+}
+
+void
+parcScheduledTask_SetOwner(PARCScheduledTask *task, void *owner, PARCScheduledTaskCancelCallback *onCancel)
+{
+    task->owner = owner;
+    task->onCancel = onCancel;
+}
+
+void *
+parcScheduledTask_GetOwner(const PARCScheduledTask *task)
+{
+    return task->owner;
+}
+
 bool
 parcScheduledTask_Cancel(PARCScheduledTask *task, bool mayInterruptIfRunning)
 {
-    return parcFutureTask_Cancel(task->task, mayInterruptIfRunning);
+    bool result = parcFutureTask_Cancel(task->task, mayInterruptIfRunning);
+
+    PARCScheduledTaskCancelCallback *onCancel = task->onCancel;
+    if (result && onCancel != NULL) {
+        onCancel(task->owner, task);
+    }
+
+    return result;
 }
 
 PARCFutureTaskResult
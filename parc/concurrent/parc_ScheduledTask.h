@@ -67,6 +67,7 @@
 #define PARCLibrary_parc_ScheduledTask
 #include <stdbool.h>
 #include <stdint.h>
+#include <stddef.h>
 
 #include <parc/algol/parc_JSON.h>
 #include <parc/algol/parc_HashCode.h>
@@ -76,6 +77,18 @@
 struct PARCScheduledTask;
 typedef struct PARCScheduledTask PARCScheduledTask;
 
+/**
+ * The queue index of a `PARCScheduledTask` that is not in a queue.
+ */
+#define PARCScheduledTask_NotQueued ((size_t) -1)
+
+/**
+ * The function invoked when a `PARCScheduledTask` that has an owner is successfully cancelled.
+ *
+ * @see parcScheduledTask_SetOwner
+ */
+typedef void (PARCScheduledTaskCancelCallback)(void *owner, PARCScheduledTask *task);
+
 /**
  * Increase the number of references to a `PARCScheduledTask` instance.
  *
@@ -146,6 +159,23 @@ void parcScheduledTask_AssertValid(const PARCScheduledTask *instance);
  */
 PARCScheduledTask *parcScheduledTask_Create(PARCFutureTask *task, uint64_t executionTime);
 
+/**
+ * Create an instance of `PARCScheduledTask` that repeats with the given period.
+ *
+ * Following the convention of `parcScheduledThreadPool_ScheduleAtFixedRate` and
+ * `parcScheduledThreadPool_ScheduleWithFixedDelay`, a positive period is a fixed rate,
+ * a negative period is a fixed delay between the end of one execution and the start of the next,
+ * and a period of zero is a one-shot task.
+ *
+ * @param [in] task A pointer to a valid PARCFutureTask instance.
+ * @param [in] executionTime The time, in nanoseconds, of the first execution.
+ * @param [in] period The period in nanoseconds.
+ *
+ * @return non-NULL A pointer to a valid PARCScheduledTask instance.
+ * @return NULL An error occurred.
+ */
+PARCScheduledTask *parcScheduledTask_CreatePeriodic(PARCFutureTask *task, uint64_t executionTime, int64_t period);
+
 /**
  * Compares @p instance with @p other for order.
  *
@@ -414,6 +444,78 @@ char *parcScheduledTask_ToString(const PARCScheduledTask *instance);
  */
 uint64_t parcScheduledTask_GetExecutionTime(const PARCScheduledTask *task);
 
+/**
+ * Set the time, in nanoseconds, of the next execution of the given `PARCScheduledTask`.
+ *
+ * The task must not be in a queue ordered by execution time when it is changed.
+ *
+ * @param [in] task A pointer to a valid PARCScheduledTask instance.
+ * @param [in] executionTime The time, in nanoseconds, of the next execution.
+ */
+void parcScheduledTask_SetExecutionTime(PARCScheduledTask *task, uint64_t executionTime);
+
+/**
+ * Get the period, in nanoseconds, of the given `PARCScheduledTask`.
+ *
+ * @param [in] task A pointer to a valid PARCScheduledTask instance.
+ *
+ * @return A positive value for a fixed-rate task, a negative value for a fixed-delay task, or zero for a one-shot task.
+ *
+ * @see parcScheduledTask_CreatePeriodic
+ */
+int64_t parcScheduledTask_GetPeriod(const PARCScheduledTask *task);
+
+/**
+ * Determine if the given `PARCScheduledTask` repeats.
+ *
+ * @param [in] task A pointer to a valid PARCScheduledTask instance.
+ *
+ * @return true The task repeats.
+ * @return false The task is a one-shot task.
+ */
+bool parcScheduledTask_IsPeriodic(const PARCScheduledTask *task);
+
+/**
+ * Get the position of the given `PARCScheduledTask` in its owner's queue.
+ *
+ * This is maintained by the owning queue so that a task can be removed without searching for it.
+ *
+ * @param [in] task A pointer to a valid PARCScheduledTask instance.
+ *
+ * @return The index of the task, or `PARCScheduledTask_NotQueued`.
+ */
+size_t parcScheduledTask_GetQueueIndex(const PARCScheduledTask *task);
+
+/**
+ * Set the position of the given `PARCScheduledTask` in its owner's queue.
+ *
+ * @param [in] task A pointer to a valid PARCScheduledTask instance.
+ * @param [in] index The index of the task, or `PARCScheduledTask_NotQueued`.
+ */
+void parcScheduledTask_SetQueueIndex(PARCScheduledTask *task, size_t index);
+
+/**
+ * Set the owner of the given `PARCScheduledTask` and the function to invoke when the task is cancelled.
+ *
+ * A `PARCScheduledThreadPool` uses this to remove a cancelled task from its queue.
+ * The owner is not reference counted, and must clear itself (by setting a NULL owner and callback)
+ * before it is destroyed.
+ *
+ * @param [in] task A pointer to a valid PARCScheduledTask instance.
+ * @param [in] owner The owner of the task, passed to @p onCancel.
+ * @param [in] onCancel The function to invoke after the task has been successfully cancelled, or NULL.
+ */
+void parcScheduledTask_SetOwner(PARCScheduledTask *task, void *owner, PARCScheduledTaskCancelCallback *onCancel);
+
+/**
+ * Get the owner of the given `PARCScheduledTask`.
+ *
+ * @param [in] task A pointer to a valid PARCScheduledTask instance.
+ *
+ * @return The owner set by `parcScheduledTask_SetOwner`, or NULL.
+ */
+void *parcScheduledTask_GetOwner(const PARCScheduledTask *task);
+
 /**
  * Attempts to cancel execution of this task.
  *
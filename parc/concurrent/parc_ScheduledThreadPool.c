@@ -71,45 +71,269 @@
 #include <parc/concurrent/parc_Thread.h>
 #include <parc/concurrent/parc_ThreadPool.h>
 
+/*
+ * Pending tasks are kept in an indexed binary min-heap ordered by execution time.
+ * Each PARCScheduledTask records its own position in the heap,
+ * so a cancelled task is removed in O(log n) without searching for it.
+ */
 struct PARCScheduledThreadPool {
     bool continueExistingPeriodicTasksAfterShutdown;
     bool executeExistingDelayedTasksAfterShutdown;
     bool removeOnCancel;
-    PARCSortedList *workQueue;
+    bool isShutdown;
+    PARCScheduledTask **queue;
+    size_t queueSize;
+    size_t queueCapacity;
+    PARCLinkedList *inFlight;
     PARCThread *workerThread;
     PARCThreadPool *threadPool;
     int poolSize;
 };
 
+static inline void
+_parcScheduledThreadPool_SetAt(PARCScheduledThreadPool *pool, size_t index, PARCScheduledTask *task)
+{
+    pool->queue[index] = task;
+    parcScheduledTask_SetQueueIndex(task, index);
+}
+
+static void
+_parcScheduledThreadPool_SiftUp(PARCScheduledThreadPool *pool, size_t index, PARCScheduledTask *task)
+{
+    while (index > 0) {
+        size_t parent = (index - 1) / 2;
+        PARCScheduledTask *parentTask = pool->queue[parent];
+        if (parcScheduledTask_Compare(task, parentTask) >= 0) {
+            break;
+        }
+        _parcScheduledThreadPool_SetAt(pool, index, parentTask);
+        index = parent;
+    }
+    _parcScheduledThreadPool_SetAt(pool, index, task);
+}
+
+static void
+_parcScheduledThreadPool_SiftDown(PARCScheduledThreadPool *pool, size_t index, PARCScheduledTask *task)
+{
+    size_t half = pool->queueSize / 2;
+    while (index < half) {
+        size_t child = 2 * index + 1;
+        size_t right = child + 1;
+        if (right < pool->queueSize && parcScheduledTask_Compare(pool->queue[right], pool->queue[child]) < 0) {
+            child = right;
+        }
+        if (parcScheduledTask_Compare(task, pool->queue[child]) <= 0) {
+            break;
+        }
+        _parcScheduledThreadPool_SetAt(pool, index, pool->queue[child]);
+        index = child;
+    }
+    _parcScheduledThreadPool_SetAt(pool, index, task);
+}
+
+static void _parcScheduledThreadPool_OnCancel(PARCScheduledThreadPool *pool, PARCScheduledTask *task);
+
+/*
+ * Add the task to the queue, transferring the caller's reference to the queue.
+ * Must be called with the pool locked.
+ */
+static void
+_parcScheduledThreadPool_Offer(PARCScheduledThreadPool *pool, PARCScheduledTask *task)
+{
+    if (pool->queueSize == pool->queueCapacity) {
+        size_t capacity = (pool->queueCapacity == 0) ? 16 : pool->queueCapacity * 2;
+        PARCScheduledTask **queue = parcMemory_Reallocate(pool->queue, capacity * sizeof(PARCScheduledTask *));
+        assertNotNull(queue, "parcMemory_Reallocate(%zu) returned NULL", capacity * sizeof(PARCScheduledTask *));
+        pool->queue = queue;
+        pool->queueCapacity = capacity;
+    }
+
+    parcScheduledTask_SetOwner(task, pool, (PARCScheduledTaskCancelCallback *) _parcScheduledThreadPool_OnCancel);
+    pool->queueSize++;
+    _parcScheduledThreadPool_SiftUp(pool, pool->queueSize - 1, task);
+}
+
+/*
+ * Remove the task at the given index, transferring the queue's reference to the caller.
+ * Must be called with the pool locked.
+ */
+static PARCScheduledTask *
+_parcScheduledThreadPool_RemoveAt(PARCScheduledThreadPool *pool, size_t index)
+{
+    PARCScheduledTask *result = pool->queue[index];
+    parcScheduledTask_SetQueueIndex(result, PARCScheduledTask_NotQueued);
+
+    pool->queueSize--;
+    if (index != pool->queueSize) {
+        PARCScheduledTask *last = pool->queue[pool->queueSize];
+        _parcScheduledThreadPool_SiftDown(pool, index, last);
+        if (pool->queue[index] == last) {
+            _parcScheduledThreadPool_SiftUp(pool, index, last);
+        }
+    }
+    pool->queue[pool->queueSize] = NULL;
+
+    return result;
+}
+
+/*
+ * Release a task the pool no longer tracks.
+ * Must be called with the pool locked.
+ */
+static void
+_parcScheduledThreadPool_Discard(PARCScheduledTask **taskPtr)
+{
+    parcScheduledTask_SetOwner(*taskPtr, NULL, NULL);
+    parcScheduledTask_Release(taskPtr);
+}
+
+static void
+_parcScheduledThreadPool_OnCancel(PARCScheduledThreadPool *pool, PARCScheduledTask *task)
+{
+    if (parcObject_Lock(pool)) {
+        if (pool->removeOnCancel) {
+            size_t index = parcScheduledTask_GetQueueIndex(task);
+            if (index != PARCScheduledTask_NotQueued && index < pool->queueSize && pool->queue[index] == task) {
+                PARCScheduledTask *removed = _parcScheduledThreadPool_RemoveAt(pool, index);
+                _parcScheduledThreadPool_Discard(&removed);
+                if (pool->isShutdown) {
+                    // parcScheduledThreadPool_Shutdown may be waiting for this task.
+                    parcObject_NotifyAll(pool);
+                }
+            }
+        }
+        parcObject_Unlock(pool);
+    }
+}
+
+/*
+ * Remove the given task, by identity, from the in-flight list.
+ * Must be called with the pool locked.
+ */
+static bool
+_parcScheduledThreadPool_RemoveInFlight(PARCScheduledThreadPool *pool, const PARCScheduledTask *task)
+{
+    bool result = false;
+
+    PARCIterator *iterator = parcLinkedList_CreateIterator(pool->inFlight);
+    while (parcIterator_HasNext(iterator)) {
+        if (parcIterator_Next(iterator) == task) {
+            parcIterator_Remove(iterator);
+            result = true;
+            break;
+        }
+    }
+    parcIterator_Release(&iterator);
+
+    return result;
+}
+
+/*
+ * Runs one execution of a periodic task on the thread pool, then schedules the next execution.
+ * A fixed-rate task's next execution is computed from its previous scheduled time, not from when it ran,
+ * so the schedule does not drift; a fixed-delay task's next execution is measured from the end of this one.
+ *
+ * The runner's PARCFutureTask holds a reference to the scheduled task.
+ * The pool's in-flight list records the task so that shutdown can disown it if the runner never runs.
+ */
+static void *
+_parcScheduledThreadPool_RunPeriodic(PARCFutureTask *runner, void *parameter)
+{
+    PARCScheduledTask *task = parameter;
+    PARCScheduledThreadPool *pool = parcScheduledTask_GetOwner(task);
+
+    bool again = parcFutureTask_RunAndReset(parcScheduledTask_GetTask(task));
+
+    if (parcObject_Lock(pool)) {
+        if (_parcScheduledThreadPool_RemoveInFlight(pool, task)) {
+            if (pool->isShutdown && pool->continueExistingPeriodicTasksAfterShutdown == false) {
+                again = false;
+            }
+            if (again && parcScheduledTask_IsCancelled(task) == false) {
+                int64_t period = parcScheduledTask_GetPeriod(task);
+                uint64_t next = (period > 0)
+                    ? parcScheduledTask_GetExecutionTime(task) + (uint64_t) period
+                    : parcTime_NowNanoseconds() + (uint64_t) -period;
+                parcScheduledTask_SetExecutionTime(task, next);
+                _parcScheduledThreadPool_Offer(pool, parcScheduledTask_Acquire(task));
+                parcObject_NotifyAll(pool);
+            } else {
+                parcScheduledTask_SetOwner(task, NULL, NULL);
+            }
+        }
+        parcObject_Unlock(pool);
+    }
+
+    return NULL;
+}
+
+/*
+ * Hand an expired task to the thread pool.
+ * Must be called with the pool locked; the queue's reference to the task is consumed.
+ */
+static void
+_parcScheduledThreadPool_Dispatch(PARCScheduledThreadPool *pool, PARCScheduledTask *task)
+{
+    if (parcScheduledTask_IsCancelled(task)) {
+        _parcScheduledThreadPool_Discard(&task);
+    } else if (parcScheduledTask_IsPeriodic(task)) {
+        parcLinkedList_Append(pool->inFlight, task);
+        PARCFutureTask *runner = parcFutureTask_Create(_parcScheduledThreadPool_RunPeriodic, task);
+        parcThreadPool_Execute(pool->threadPool, runner);
+        parcFutureTask_Release(&runner);
+        parcScheduledTask_Release(&task);
+    } else {
+        parcThreadPool_Execute(pool->threadPool, parcScheduledTask_GetTask(task));
+        _parcScheduledThreadPool_Discard(&task);
+    }
+}
+
 static void *
 _workerThread(PARCThread *thread, PARCScheduledThreadPool *pool)
 {
-    while (parcThread_IsCancelled(thread) == false) {
-        if (parcSortedList_Lock(pool->workQueue)) {
-            if (parcSortedList_Size(pool->workQueue) > 0) {
-                PARCScheduledTask *task = parcSortedList_GetFirst(pool->workQueue);
+    if (parcObject_Lock(pool)) {
+        while (parcThread_IsCancelled(thread) == false) {
+            if (pool->queueSize > 0) {
+                PARCScheduledTask *task = pool->queue[0];
                 int64_t executionDelay = parcScheduledTask_GetExecutionTime(task) - parcTime_NowNanoseconds();
-                if (task != NULL && executionDelay <= 0) {
-                    parcSortedList_RemoveFirst(pool->workQueue);
-                    parcSortedList_Unlock(pool->workQueue);
-                    parcThreadPool_Execute(pool->threadPool, parcScheduledTask_GetTask(task));
-                    parcScheduledTask_Release(&task);
-                    parcSortedList_Lock(pool->workQueue);
-
-                    parcSortedList_Notify(pool->workQueue);
+                if (executionDelay <= 0) {
+                    task = _parcScheduledThreadPool_RemoveAt(pool, 0);
+                    _parcScheduledThreadPool_Dispatch(pool, task);
+                    if (pool->isShutdown) {
+                        // parcScheduledThreadPool_Shutdown may be waiting for this task.
+                        parcObject_NotifyAll(pool);
+                    }
                 } else {
-                    parcSortedList_WaitFor(pool->workQueue, executionDelay);
+                    parcObject_WaitFor(pool, executionDelay);
                 }
             } else {
-                parcSortedList_Wait(pool->workQueue);
+                parcObject_Wait(pool);
             }
         }
-        parcSortedList_Unlock(pool->workQueue);
+        parcObject_Unlock(pool);
     }
 
     return NULL;
 }
 
+/*
+ * Remove and release every queued and in-flight task.
+ * Must be called with the pool locked.
+ */
+static void
+_parcScheduledThreadPool_Clear(PARCScheduledThreadPool *pool)
+{
+    while (pool->queueSize > 0) {
+        PARCScheduledTask *task = _parcScheduledThreadPool_RemoveAt(pool, pool->queueSize - 1);
+        _parcScheduledThreadPool_Discard(&task);
+    }
+
+    while (parcLinkedList_Size(pool->inFlight) > 0) {
+        PARCScheduledTask *task = parcLinkedList_RemoveFirst(pool->inFlight);
+        _parcScheduledThreadPool_Discard(&task);
+    }
+}
+
 static bool
 _parcScheduledThreadPool_Destructor(PARCScheduledThreadPool **instancePtr)
 {
@@ -119,10 +343,10 @@ _parcScheduledThreadPool_Destructor(PARCScheduledThreadPool **instancePtr)
 
     parcThread_Release(&pool->workerThread);
 
-    if (parcObject_Lock(pool->workQueue)) {
-        parcSortedList_Release(&pool->workQueue);
-    } else {
-        assertTrue(false, "Cannot lock the work queue.");
+    _parcScheduledThreadPool_Clear(pool);
+    parcLinkedList_Release(&pool->inFlight);
+    if (pool->queue != NULL) {
+        parcMemory_Deallocate(&pool->queue);
     }
 
     return true;
@@ -155,7 +379,11 @@ parcScheduledThreadPool_Create(int poolSize)
 
     if (result != NULL) {
         result->poolSize = poolSize;
-        result->workQueue = parcSortedList_Create();
+        result->isShutdown = false;
+        result->queue = NULL;
+        result->queueSize = 0;
+        result->queueCapacity = 0;
+        result->inFlight = parcLinkedList_Create();
         result->threadPool = parcThreadPool_Create(poolSize);
 
         result->continueExistingPeriodicTasksAfterShutdown = false;
@@ -256,6 +484,10 @@ parcScheduledThreadPool_ToString(const PARCScheduledThreadPool *instance)
 void
 parcScheduledThreadPool_Execute(PARCScheduledThreadPool *pool, PARCFutureTask *command)
 {
+    PARCScheduledTask *scheduledTask = parcScheduledThreadPool_Schedule(pool, command, PARCTimeout_Immediate);
+    if (scheduledTask != NULL) {
+        parcScheduledTask_Release(&scheduledTask);
+    }
 }
 
 bool
@@ -273,7 +505,29 @@ parcScheduledThreadPool_GetExecuteExistingDelayedTasksAfterShutdownPolicy(PARCSc
 PARCSortedList *
 parcScheduledThreadPool_GetQueue(const PARCScheduledThreadPool *pool)
 {
-    return pool->workQueue;
+    PARCSortedList *result = parcSortedList_Create();
+
+    if (parcObject_Lock(pool)) {
+        for (size_t i = 0; i < pool->queueSize; i++) {
+            parcSortedList_Add(result, pool->queue[i]);
+        }
+        parcObject_Unlock(pool);
+    }
+
+    return result;
+}
+
+size_t
+parcScheduledThreadPool_GetQueueSize(const PARCScheduledThreadPool *pool)
+{
+    size_t result = 0;
+
+    if (parcObject_Lock(pool)) {
+        result = pool->queueSize;
+        parcObject_Unlock(pool);
+    }
+
+    return result;
 }
 
 bool
@@ -282,83 +536,170 @@ parcScheduledThreadPool_GetRemoveOnCancelPolicy(const PARCScheduledThreadPool *p
     return pool->removeOnCancel;
 }
 
-PARCScheduledTask *
-parcScheduledThreadPool_Schedule(PARCScheduledThreadPool *pool, PARCFutureTask *task, const PARCTimeout *delay)
+static PARCScheduledTask *
+_parcScheduledThreadPool_Enqueue(PARCScheduledThreadPool *pool, PARCFutureTask *task, uint64_t delay, int64_t period)
 {
-    uint64_t executionTime = parcTime_NowNanoseconds() + parcTimeout_InNanoSeconds(delay);
-
-    PARCScheduledTask *scheduledTask = parcScheduledTask_Create(task, executionTime);
+    PARCScheduledTask *result = NULL;
 
-    if (parcSortedList_Lock(pool->workQueue)) {
-        parcSortedList_Add(pool->workQueue, scheduledTask);
-        parcScheduledTask_Release(&scheduledTask);
-        parcSortedList_Notify(pool->workQueue);
-        parcSortedList_Unlock(pool->workQueue);
+    if (parcObject_Lock(pool)) {
+        if (pool->isShutdown == false) {
+            PARCScheduledTask *scheduledTask = parcScheduledTask_CreatePeriodic(task, parcTime_NowNanoseconds() + delay, period);
+            _parcScheduledThreadPool_Offer(pool, scheduledTask);
+            if (parcScheduledTask_GetQueueIndex(scheduledTask) == 0) {
+                parcObject_Notify(pool);
+            }
+            // Acquire the caller's reference before unlocking, a worker may run and release the queue's reference at once.
+            result = parcScheduledTask_Acquire(scheduledTask);
+        }
+        parcObject_Unlock(pool);
     }
-    return scheduledTask;
+
+    return result;
+}
+
+PARCScheduledTask *
+parcScheduledThreadPool_Schedule(PARCScheduledThreadPool *pool, PARCFutureTask *task, const PARCTimeout *delay)
+{
+    return _parcScheduledThreadPool_Enqueue(pool, task, parcTimeout_InNanoSeconds(delay), 0);
 }
 
 PARCScheduledTask *
 parcScheduledThreadPool_ScheduleAtFixedRate(PARCScheduledThreadPool *pool, PARCFutureTask *task, PARCTimeout initialDelay, PARCTimeout period)
 {
-    return NULL;
+    uint64_t nanoSeconds = parcTimeout_InNanoSeconds(&period);
+    assertTrue(nanoSeconds > 0 && nanoSeconds <= INT64_MAX, "The period must be positive.");
+
+    return _parcScheduledThreadPool_Enqueue(pool, task, parcTimeout_InNanoSeconds(&initialDelay), (int64_t) nanoSeconds);
 }
 
 PARCScheduledTask *
 parcScheduledThreadPool_ScheduleWithFixedDelay(PARCScheduledThreadPool *pool, PARCFutureTask *task, PARCTimeout initialDelay, PARCTimeout delay)
 {
-    return NULL;
+    uint64_t nanoSeconds = parcTimeout_InNanoSeconds(&delay);
+    assertTrue(nanoSeconds > 0 && nanoSeconds <= INT64_MAX, "The delay must be positive.");
+
+    return _parcScheduledThreadPool_Enqueue(pool, task, parcTimeout_InNanoSeconds(&initialDelay), -(int64_t) nanoSeconds);
 }
 
 void
 parcScheduledThreadPool_SetContinueExistingPeriodicTasksAfterShutdownPolicy(PARCScheduledThreadPool *pool, bool value)
 {
+    pool->continueExistingPeriodicTasksAfterShutdown = value;
 }
 
 void
 parcScheduledThreadPool_SetExecuteExistingDelayedTasksAfterShutdownPolicy(PARCScheduledThreadPool *pool, bool value)
 {
+    pool->executeExistingDelayedTasksAfterShutdown = value;
 }
 
 void
 parcScheduledThreadPool_SetRemoveOnCancelPolicy(PARCScheduledThreadPool *pool, bool value)
 {
+    if (parcObject_Lock(pool)) {
+        pool->removeOnCancel = value;
+
+        // Switching the policy on removes the cancelled tasks that were allowed to linger.
+        if (value) {
+            size_t i = 0;
+            while (i < pool->queueSize) {
+                if (parcScheduledTask_IsCancelled(pool->queue[i])) {
+                    PARCScheduledTask *task = _parcScheduledThreadPool_RemoveAt(pool, i);
+                    _parcScheduledThreadPool_Discard(&task);
+                } else {
+                    i++;
+                }
+            }
+        }
+        parcObject_Unlock(pool);
+    }
+}
+
+/*
+ * Determine if any one-shot delayed task is still waiting in the queue.
+ * Must be called with the pool locked.
+ */
+static bool
+_parcScheduledThreadPool_HasDelayedTasks(const PARCScheduledThreadPool *pool)
+{
+    for (size_t i = 0; i < pool->queueSize; i++) {
+        if (parcScheduledTask_IsPeriodic(pool->queue[i]) == false) {
+            return true;
+        }
+    }
+    return false;
 }
 
 void
 parcScheduledThreadPool_Shutdown(PARCScheduledThreadPool *pool)
 {
+    bool executeDelayedTasks = false;
+
+    if (parcObject_Lock(pool)) {
+        pool->isShutdown = true;
+        executeDelayedTasks = pool->executeExistingDelayedTasksAfterShutdown;
+
+        // Periodic tasks that are not to continue are dropped now, so they do not run again while the delayed tasks are awaited.
+        if (pool->continueExistingPeriodicTasksAfterShutdown == false) {
+            size_t i = 0;
+            while (i < pool->queueSize) {
+                if (parcScheduledTask_IsPeriodic(pool->queue[i])) {
+                    PARCScheduledTask *task = _parcScheduledThreadPool_RemoveAt(pool, i);
+                    _parcScheduledThreadPool_Discard(&task);
+                } else {
+                    i++;
+                }
+            }
+        }
+
+        if (executeDelayedTasks) {
+            while (_parcScheduledThreadPool_HasDelayedTasks(pool)) {
+                parcObject_Wait(pool);
+            }
+        }
+        parcObject_Unlock(pool);
+    }
+
+    if (executeDelayedTasks) {
+        // Every delayed task has been handed to the thread pool, let it finish them.
+        parcThreadPool_Shutdown(pool->threadPool);
+        parcThreadPool_AwaitTermination(pool->threadPool, PARCTimeout_Never);
+    }
+
     parcScheduledThreadPool_ShutdownNow(pool);
 }
 
 PARCList *
 parcScheduledThreadPool_ShutdownNow(PARCScheduledThreadPool *pool)
 {
+    if (parcObject_Lock(pool)) {
+        pool->isShutdown = true;
+        parcObject_Unlock(pool);
+    }
+
     parcThread_Cancel(pool->workerThread);
 
     parcThreadPool_ShutdownNow(pool->threadPool);
 
-    // Wake them all up so they detect that they are cancelled.
+    // Wake the worker so it detects that it is cancelled.
     if (parcObject_Lock(pool)) {
         parcObject_NotifyAll(pool);
         parcObject_Unlock(pool);
     }
-    if (parcObject_Lock(pool->workQueue)) {
-        parcObject_NotifyAll(pool->workQueue);
-        parcObject_Unlock(pool->workQueue);
-    }
 
     parcThread_Join(pool->workerThread);
 
+    // Periodic tasks whose runners were discarded by the thread pool are still held here.
+    if (parcObject_Lock(pool)) {
+        _parcScheduledThreadPool_Clear(pool);
+        parcObject_Unlock(pool);
+    }
+
     return NULL;
 }
 
 PARCScheduledTask *
 parcScheduledThreadPool_Submit(PARCScheduledThreadPool *pool, PARCFutureTask *task)
 {
-    PARCScheduledTask *scheduledTask = parcScheduledTask_Create(task, 0);
-
-    parcSortedList_Add(pool->workQueue, scheduledTask);
-
-    return scheduledTask;
+    return parcScheduledThreadPool_Schedule(pool, task, PARCTimeout_Immediate);
 }
@@ -400,6 +400,8 @@ char *parcScheduledThreadPool_ToString(const PARCScheduledThreadPool *instance);
 
 /**
  * Executes command with zero required delay.
+ *
+ * Unlike `parcScheduledThreadPool_Submit`, this returns nothing, so there is no reference for the caller to release.
  */
 void parcScheduledThreadPool_Execute(PARCScheduledThreadPool *pool, PARCFutureTask *command);
 
@@ -414,10 +416,35 @@ bool parcScheduledThreadPool_GetContinueExistingPeriodicTasksAfterShutdownPolicy
 bool parcScheduledThreadPool_GetExecuteExistingDelayedTasksAfterShutdownPolicy(PARCScheduledThreadPool *pool);
 
 /**
- * Returns the task queue used by this executor.
+ * Returns a snapshot of the tasks awaiting execution, ordered by execution time.
+ *
+ * **Ownership change:** earlier versions returned the pool's own work queue as a borrowed reference.
+ * The pool now keeps its pending tasks in an indexed binary heap, and this function returns a new
+ * `PARCSortedList` that the caller owns and must release with `parcSortedList_Release`.
+ * Callers written for the borrowed reference leak the snapshot.
+ *
+ * The snapshot holds its own references to the tasks, and does not change as the pool runs or cancels them.
+ *
+ * @param [in] pool A pointer to a valid `PARCScheduledThreadPool` instance.
+ *
+ * @return A new `PARCSortedList` of the queued `PARCScheduledTask` instances, which the caller must release.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCSortedList *queue = parcScheduledThreadPool_GetQueue(pool);
+ *     printf("%zu tasks are waiting\n", parcSortedList_Size(queue));
+ *     parcSortedList_Release(&queue);
+ * }
+ * @endcode
  */
 PARCSortedList *parcScheduledThreadPool_GetQueue(const PARCScheduledThreadPool *pool);
 
+/**
+ * Returns the number of tasks awaiting execution.
+ */
+size_t parcScheduledThreadPool_GetQueueSize(const PARCScheduledThreadPool *pool);
+
 /**
  * Gets the policy on whether cancelled tasks should be immediately removed from the work queue at time of cancellation.
  */
@@ -425,16 +452,30 @@ bool parcScheduledThreadPool_GetRemoveOnCancelPolicy(const PARCScheduledThreadPo
 
 /**
  * Creates and executes a one-shot action that becomes enabled after the given delay.
+ *
+ * The returned `PARCScheduledTask` is a new reference, acquired before any worker can run the task,
+ * which the caller must release with `parcScheduledTask_Release`.
+ * Use `parcScheduledThreadPool_Execute` to run a task without keeping a reference to it.
+ * When the remove-on-cancel policy is set (the default), cancelling the task removes it from the queue in O(log n).
+ *
+ * @return A new reference to the `PARCScheduledTask`, or NULL if the pool has been shut down.
  */
 PARCScheduledTask *parcScheduledThreadPool_Schedule(PARCScheduledThreadPool *pool, PARCFutureTask *task, const PARCTimeout *delay);
 
 /**
  * Creates and executes a periodic action that becomes enabled first after the given initial delay, and subsequently with the given period; that is executions will commence after initialDelay then initialDelay+period, then initialDelay + 2 * period, and so on.
+ *
+ * Each execution is scheduled relative to the previous scheduled time rather than to when it actually ran,
+ * so the schedule does not drift. If an execution runs late, the following ones run as soon as possible to catch up.
+ *
+ * @return A new reference to the `PARCScheduledTask`, which the caller must release, or NULL if the pool has been shut down.
  */
 PARCScheduledTask *parcScheduledThreadPool_ScheduleAtFixedRate(PARCScheduledThreadPool *pool, PARCFutureTask *task, PARCTimeout initialDelay, PARCTimeout period);
 
 /**
  * Creates and executes a periodic action that becomes enabled first after the given initial delay, and subsequently with the given delay between the termination of one execution and the commencement of the next.
+ *
+ * @return A new reference to the `PARCScheduledTask`, which the caller must release, or NULL if the pool has been shut down.
  */
 PARCScheduledTask *parcScheduledThreadPool_ScheduleWithFixedDelay(PARCScheduledThreadPool *pool, PARCFutureTask *task, PARCTimeout initialDelay, PARCTimeout delay);
 
@@ -454,7 +495,13 @@ void parcScheduledThreadPool_SetExecuteExistingDelayedTasksAfterShutdownPolicy(P
 void parcScheduledThreadPool_SetRemoveOnCancelPolicy(PARCScheduledThreadPool *pool, bool value);
 
 /**
- * Initiates an orderly shutdown in which previously submitted tasks are executed, but no new tasks will be accepted.
+ * Shut down the pool in order: no new tasks are accepted, then the pool stops as `parcScheduledThreadPool_ShutdownNow` does.
+ *
+ * If the execute-existing-delayed-tasks policy is set, this blocks until every one-shot delayed task already
+ * in the queue has become due and run; cancelled tasks are skipped.
+ * Otherwise the queued delayed tasks are discarded.
+ * Periodic tasks are discarded at once unless the continue-existing-periodic-tasks policy is set,
+ * in which case they keep running while the delayed tasks are awaited.
  */
 void parcScheduledThreadPool_Shutdown(PARCScheduledThreadPool *pool);
 
@@ -464,7 +511,9 @@ void parcScheduledThreadPool_Shutdown(PARCScheduledThreadPool *pool);
 PARCList *parcScheduledThreadPool_ShutdownNow(PARCScheduledThreadPool *pool);
 
 /**
- * Submits a PARCFutureTask task for execution and returns the PARCFutureTask representing that task.
+ * Submits a PARCFutureTask task for execution and returns the PARCScheduledTask representing that task.
+ *
+ * @return A new reference to the `PARCScheduledTask`, which the caller must release, or NULL if the pool has been shut down.
  */
 PARCScheduledTask *parcScheduledThreadPool_Submit(PARCScheduledThreadPool *pool, PARCFutureTask *task);
 #endif
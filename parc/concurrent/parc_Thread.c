@@ -71,6 +71,7 @@ struct PARCThread {
     PARCObject *argument;
     bool isCancelled;
     bool isRunning;
+    bool isJoined;
     pthread_t thread;
 };
 
@@ -124,6 +125,7 @@ parcThread_Create(void *(*runFunction)(PARCThread *, PARCObject *), PARCObject *
         result->argument = parcObject_Acquire(parameter);
         result->isCancelled = false;
         result->isRunning = false;
+        result->isJoined = false;
     }
 
     return result;
@@ -269,5 +271,8 @@ parcThread_IsCancelled(const PARCThread *thread)
 void
 parcThread_Join(PARCThread *thread)
 {
-    pthread_join(thread->thread, NULL);
+    // A thread may only be joined once; both ShutdownNow and the destructor attempt to join.
+    if (__sync_bool_compare_and_swap(&thread->isJoined, false, true)) {
+        pthread_join(thread->thread, NULL);
+    }
 }
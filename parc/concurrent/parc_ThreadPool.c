@@ -58,6 +58,12 @@
  */
 #include <config.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <pthread.h>
+#include <sys/time.h>
+
+#include <LongBow/runtime.h>
 
 #include <parc/algol/parc_Object.h>
 #include <parc/algol/parc_DisplayIndented.h>
@@ -70,68 +76,803 @@
 #include <parc/concurrent/parc_ThreadPool.h>
 #include <parc/concurrent/parc_Thread.h>
 
+/*
+ * Every worker thread owns a Chase-Lev work-stealing deque.
+ * A task submitted by a worker of the pool is pushed onto the bottom of that worker's deque;
+ * the owner takes from the bottom and idle workers steal from the top of other workers' deques.
+ * Tasks submitted from outside the pool go to the shared injection queue (`workQueue`),
+ * a ring of task pointers under its own mutex.
+ *
+ * Idle workers park on their own condition variable and are kept on an idle stack,
+ * so a submission wakes exactly one worker instead of every waiter.
+ *
+ * See: Chase and Lev, "Dynamic Circular Work-Stealing Deque", SPAA 2005, and
+ * Lê, Pop, Cohen and Zappa Nardelli, "Correct and Efficient Work-Stealing for Weak Memory Models", PPoPP 2013.
+ */
+
+#define _PARCThreadPool_InitialDequeCapacity 64
+#define _PARCThreadPool_InitialQueueCapacity 64
+#define _PARCThreadPool_MaxInjectionBatch 16
+
+typedef struct parc_threadpool_deque_array {
+    int64_t capacity;
+    struct parc_threadpool_deque_array *retired;
+    PARCFutureTask *tasks[];
+} _PARCThreadPoolDequeArray;
+
+typedef struct {
+    int64_t top;
+    char topPadding[64 - sizeof(int64_t)];
+    int64_t bottom;
+    _PARCThreadPoolDequeArray *array;
+    char bottomPadding[64 - sizeof(int64_t) - sizeof(_PARCThreadPoolDequeArray *)];
+} _PARCThreadPoolDeque;
+
+typedef struct parc_threadpool_worker {
+    _PARCThreadPoolDeque deque;
+    PARCThreadPool *pool;
+    pthread_t thread;
+    pthread_cond_t wakeup;
+    uint32_t seed;
+
+    // The following are guarded by the pool's lock.
+    struct parc_threadpool_worker *nextIdle;
+    bool isIdle;
+    bool isRunning;
+    bool mustJoin;
+} _PARCThreadPoolWorker;
+
+typedef struct {
+    pthread_mutex_t lock;
+    PARCFutureTask **tasks;
+    size_t capacity;
+    size_t head;
+    size_t count;
+} _PARCThreadPoolQueue;
+
+/*
+ * Worker slots are never freed while the pool exists, so a thief may index a table without locking.
+ * A table replaced by a larger one is kept until the pool is destroyed.
+ */
+typedef struct parc_threadpool_worker_table {
+    int capacity;
+    struct parc_threadpool_worker_table *retired;
+    _PARCThreadPoolWorker *slots[];
+} _PARCThreadPoolWorkerTable;
+
 struct PARCThreadPool {
     bool continueExistingPeriodicTasksAfterShutdown;
     bool executeExistingDelayedTasksAfterShutdown;
     bool removeOnCancel;
-    PARCLinkedList *workQueue;
-    PARCLinkedList *threads;
-    int poolSize;
+
+    _PARCThreadPoolQueue workQueue;
+    size_t workQueueSize;
+
+    pthread_mutex_t lock;
+    pthread_cond_t drained;
+    _PARCThreadPoolWorkerTable *workerTable;
+    int workerCount;
+    _PARCThreadPoolWorker *idleWorkers;
+    int idleCount;
+
+    int corePoolSize;
     int maximumPoolSize;
+    int poolSize;
+    int largestPoolSize;
+    bool allowCoreThreadTimeOut;
+    PARCTimeout keepAliveTime;
+
     long taskCount;
+    int activeCount;
+    size_t outstanding;
     bool isShutdown;
     bool isTerminated;
     bool isTerminating;
+    bool isStopping;
 
     PARCAtomicUint64 *completedTaskCount;
 };
 
-static void *
-_parcThreadPool_Worker(const PARCThread *thread, const PARCThreadPool *pool)
+static pthread_once_t _parcThreadPool_CurrentWorkerOnce = PTHREAD_ONCE_INIT;
+static pthread_key_t _parcThreadPool_CurrentWorkerKey;
+
+static void
+_parcThreadPool_CreateCurrentWorkerKey(void)
 {
-    while (parcThread_IsCancelled(thread) == false && pool->isTerminated == false) {
-        if (parcLinkedList_Lock(pool->workQueue)) {
-            PARCFutureTask *task = parcLinkedList_RemoveFirst(pool->workQueue);
-            if (task != NULL) {
-                parcAtomicUint64_Increment(pool->completedTaskCount);
-                parcLinkedList_Unlock(pool->workQueue);
-                parcFutureTask_Run(task);
-                parcFutureTask_Release(&task);
-                parcLinkedList_Lock(pool->workQueue);
+    int error = pthread_key_create(&_parcThreadPool_CurrentWorkerKey, NULL);
+    assertTrue(error == 0, "pthread_key_create failed: %d", error);
+}
+
+static _PARCThreadPoolWorker *
+_parcThreadPool_CurrentWorker(const PARCThreadPool *pool)
+{
+    _PARCThreadPoolWorker *worker = pthread_getspecific(_parcThreadPool_CurrentWorkerKey);
+
+    return (worker != NULL && worker->pool == pool) ? worker : NULL;
+}
+
+static _PARCThreadPoolDequeArray *
+_parcThreadPoolDequeArray_Create(int64_t capacity, _PARCThreadPoolDequeArray *retired)
+{
+    _PARCThreadPoolDequeArray *result = calloc(1, sizeof(_PARCThreadPoolDequeArray) + capacity * sizeof(PARCFutureTask *));
+    assertNotNull(result, "Cannot allocate a work-stealing deque of %" PRId64 " entries", capacity);
+
+    result->capacity = capacity;
+    result->retired = retired;
+
+    return result;
+}
+
+static void
+_parcThreadPoolDeque_Init(_PARCThreadPoolDeque *deque)
+{
+    deque->top = 0;
+    deque->bottom = 0;
+    deque->array = _parcThreadPoolDequeArray_Create(_PARCThreadPool_InitialDequeCapacity, NULL);
+}
+
+static void
+_parcThreadPoolDeque_Fini(_PARCThreadPoolDeque *deque)
+{
+    _PARCThreadPoolDequeArray *array = deque->array;
+    while (array != NULL) {
+        _PARCThreadPoolDequeArray *retired = array->retired;
+        free(array);
+        array = retired;
+    }
+    deque->array = NULL;
+}
+
+static bool
+_parcThreadPoolDeque_IsEmpty(_PARCThreadPoolDeque *deque)
+{
+    int64_t top = __atomic_load_n(&deque->top, __ATOMIC_ACQUIRE);
+    int64_t bottom = __atomic_load_n(&deque->bottom, __ATOMIC_ACQUIRE);
+
+    return bottom <= top;
+}
+
+/*
+ * Double the capacity of a full deque. Only the owner calls this.
+ * The old array stays readable by concurrent thieves until the deque is finalised.
+ */
+static _PARCThreadPoolDequeArray *
+_parcThreadPoolDeque_Grow(_PARCThreadPoolDeque *deque, _PARCThreadPoolDequeArray *array, int64_t top, int64_t bottom)
+{
+    _PARCThreadPoolDequeArray *result = _parcThreadPoolDequeArray_Create(array->capacity * 2, array);
+
+    for (int64_t i = top; i < bottom; i++) {
+        result->tasks[i & (result->capacity - 1)] = __atomic_load_n(&array->tasks[i & (array->capacity - 1)], __ATOMIC_RELAXED);
+    }
+    __atomic_store_n(&deque->array, result, __ATOMIC_RELEASE);
+
+    return result;
+}
+
+static void
+_parcThreadPoolDeque_Push(_PARCThreadPoolDeque *deque, PARCFutureTask *task)
+{
+    int64_t bottom = __atomic_load_n(&deque->bottom, __ATOMIC_RELAXED);
+    int64_t top = __atomic_load_n(&deque->top, __ATOMIC_ACQUIRE);
+    _PARCThreadPoolDequeArray *array = __atomic_load_n(&deque->array, __ATOMIC_RELAXED);
+
+    if (bottom - top > array->capacity - 1) {
+        array = _parcThreadPoolDeque_Grow(deque, array, top, bottom);
+    }
+    __atomic_store_n(&array->tasks[bottom & (array->capacity - 1)], task, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    __atomic_store_n(&deque->bottom, bottom + 1, __ATOMIC_RELAXED);
+}
+
+/*
+ * Take the most recently pushed task. Only the owner calls this.
+ */
+static PARCFutureTask *
+_parcThreadPoolDeque_Take(_PARCThreadPoolDeque *deque)
+{
+    int64_t bottom = __atomic_load_n(&deque->bottom, __ATOMIC_RELAXED) - 1;
+    _PARCThreadPoolDequeArray *array = __atomic_load_n(&deque->array, __ATOMIC_RELAXED);
+    __atomic_store_n(&deque->bottom, bottom, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    int64_t top = __atomic_load_n(&deque->top, __ATOMIC_RELAXED);
+
+    PARCFutureTask *result = NULL;
+    if (top <= bottom) {
+        result = __atomic_load_n(&array->tasks[bottom & (array->capacity - 1)], __ATOMIC_RELAXED);
+        if (top == bottom) {
+            // The last task: race any thief for it.
+            if (!__atomic_compare_exchange_n(&deque->top, &top, top + 1, false, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)) {
+                result = NULL;
+            }
+            __atomic_store_n(&deque->bottom, bottom + 1, __ATOMIC_RELAXED);
+        }
+    } else {
+        __atomic_store_n(&deque->bottom, bottom + 1, __ATOMIC_RELAXED);
+    }
+
+    return result;
+}
+
+/*
+ * Steal the oldest task. Any thread may call this.
+ * Returns NULL if the deque is empty or another thread won the race for the task.
+ */
+static PARCFutureTask *
+_parcThreadPoolDeque_Steal(_PARCThreadPoolDeque *deque)
+{
+    int64_t top = __atomic_load_n(&deque->top, __ATOMIC_ACQUIRE);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    int64_t bottom = __atomic_load_n(&deque->bottom, __ATOMIC_ACQUIRE);
+
+    PARCFutureTask *result = NULL;
+    if (top < bottom) {
+        _PARCThreadPoolDequeArray *array = __atomic_load_n(&deque->array, __ATOMIC_ACQUIRE);
+        result = __atomic_load_n(&array->tasks[top & (array->capacity - 1)], __ATOMIC_RELAXED);
+        if (!__atomic_compare_exchange_n(&deque->top, &top, top + 1, false, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)) {
+            result = NULL;
+        }
+    }
+
+    return result;
+}
+
+static void
+_parcThreadPoolQueue_Init(_PARCThreadPoolQueue *queue)
+{
+    pthread_mutex_init(&queue->lock, NULL);
+    queue->capacity = _PARCThreadPool_InitialQueueCapacity;
+    queue->tasks = calloc(queue->capacity, sizeof(PARCFutureTask *));
+    assertNotNull(queue->tasks, "Cannot allocate a queue of %zu entries", queue->capacity);
+    queue->head = 0;
+    queue->count = 0;
+}
+
+static void
+_parcThreadPoolQueue_Fini(_PARCThreadPoolQueue *queue)
+{
+    free(queue->tasks);
+    queue->tasks = NULL;
+    pthread_mutex_destroy(&queue->lock);
+}
+
+static PARCFutureTask **
+_parcThreadPoolQueue_At(_PARCThreadPoolQueue *queue, size_t index)
+{
+    return &queue->tasks[(queue->head + index) & (queue->capacity - 1)];
+}
+
+/*
+ * Append a task. Must be called with the queue lock held.
+ */
+static void
+_parcThreadPoolQueue_Append(_PARCThreadPoolQueue *queue, PARCFutureTask *task)
+{
+    if (queue->count == queue->capacity) {
+        PARCFutureTask **tasks = calloc(queue->capacity * 2, sizeof(PARCFutureTask *));
+        assertNotNull(tasks, "Cannot allocate a queue of %zu entries", queue->capacity * 2);
+        for (size_t i = 0; i < queue->count; i++) {
+            tasks[i] = *_parcThreadPoolQueue_At(queue, i);
+        }
+        free(queue->tasks);
+        queue->tasks = tasks;
+        queue->capacity *= 2;
+        queue->head = 0;
+    }
+    *_parcThreadPoolQueue_At(queue, queue->count) = task;
+    queue->count++;
+}
+
+/*
+ * Remove and return the oldest task, or NULL. Must be called with the queue lock held.
+ */
+static PARCFutureTask *
+_parcThreadPoolQueue_RemoveFirst(_PARCThreadPoolQueue *queue)
+{
+    PARCFutureTask *result = NULL;
+
+    if (queue->count > 0) {
+        result = *_parcThreadPoolQueue_At(queue, 0);
+        queue->head = (queue->head + 1) & (queue->capacity - 1);
+        queue->count--;
+    }
+
+    return result;
+}
+
+/*
+ * Release and remove every task for which `discard` returns true, keeping the order of the rest.
+ * Must be called with the queue lock held.
+ */
+static size_t
+_parcThreadPoolQueue_RemoveIf(_PARCThreadPoolQueue *queue, bool (*discard)(PARCFutureTask *task, const void *context), const void *context)
+{
+    size_t kept = 0;
+
+    for (size_t i = 0; i < queue->count; i++) {
+        PARCFutureTask *task = *_parcThreadPoolQueue_At(queue, i);
+        if (discard(task, context)) {
+            parcFutureTask_Release(&task);
+        } else {
+            *_parcThreadPoolQueue_At(queue, kept++) = task;
+        }
+    }
+
+    size_t result = queue->count - kept;
+    queue->count = kept;
+
+    return result;
+}
+
+static uint32_t
+_parcThreadPoolWorker_Random(_PARCThreadPoolWorker *worker)
+{
+    uint32_t x = worker->seed;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    worker->seed = x;
+
+    return x;
+}
+
+static bool
+_parcThreadPool_HasWork(PARCThreadPool *pool)
+{
+    bool result = __atomic_load_n(&pool->workQueueSize, __ATOMIC_ACQUIRE) > 0;
+
+    if (result == false) {
+        int count = __atomic_load_n(&pool->workerCount, __ATOMIC_ACQUIRE);
+        _PARCThreadPoolWorkerTable *table = __atomic_load_n(&pool->workerTable, __ATOMIC_ACQUIRE);
+        for (int i = 0; i < count && result == false; i++) {
+            result = !_parcThreadPoolDeque_IsEmpty(&table->slots[i]->deque);
+        }
+    }
+
+    return result;
+}
+
+static bool _parcThreadPool_IsStopping(const PARCThreadPool *pool);
+
+/*
+ * Account for `count` tasks that have left the pool, whether run, removed or discarded.
+ *
+ * The pool holds a reference to itself while any task is outstanding,
+ * so a pool released by its owner with work still queued stays alive until that work drains.
+ * Returns false if this call released the last reference to the pool.
+ */
+static bool
+_parcThreadPool_TasksDone(PARCThreadPool *pool, size_t count)
+{
+    bool result = true;
+
+    if (__atomic_sub_fetch(&pool->outstanding, count, __ATOMIC_ACQ_REL) == 0) {
+        pthread_mutex_lock(&pool->lock);
+        pthread_cond_broadcast(&pool->drained);
+        pthread_mutex_unlock(&pool->lock);
+
+        PARCThreadPool *self = pool;
+        result = parcObject_Release((PARCObject **) &self) > 0;
+    }
+
+    return result;
+}
+
+/*
+ * Remove the worker from the idle stack. Must be called with the pool lock held.
+ */
+static void
+_parcThreadPool_RemoveIdle(PARCThreadPool *pool, _PARCThreadPoolWorker *worker)
+{
+    for (_PARCThreadPoolWorker **link = &pool->idleWorkers; *link != NULL; link = &(*link)->nextIdle) {
+        if (*link == worker) {
+            *link = worker->nextIdle;
+            break;
+        }
+    }
+    worker->nextIdle = NULL;
+    worker->isIdle = false;
+    __atomic_sub_fetch(&pool->idleCount, 1, __ATOMIC_SEQ_CST);
+}
+
+static void *_parcThreadPool_Worker(_PARCThreadPoolWorker *worker);
+
+/*
+ * Find a slot whose thread has exited, or make a new one.
+ * Must be called with the pool lock held.
+ */
+static _PARCThreadPoolWorker *
+_parcThreadPool_AllocateWorker(PARCThreadPool *pool)
+{
+    _PARCThreadPoolWorkerTable *table = pool->workerTable;
+
+    for (int i = 0; i < pool->workerCount; i++) {
+        _PARCThreadPoolWorker *worker = table->slots[i];
+        if (worker->isRunning == false) {
+            if (worker->mustJoin) {
+                // The previous thread has left the pool and no longer takes the lock.
+                pthread_join(worker->thread, NULL);
+                worker->mustJoin = false;
+            }
+            return worker;
+        }
+    }
+
+    if (table == NULL || pool->workerCount == table->capacity) {
+        int capacity = (table == NULL) ? 4 : table->capacity * 2;
+        _PARCThreadPoolWorkerTable *larger = calloc(1, sizeof(_PARCThreadPoolWorkerTable) + capacity * sizeof(_PARCThreadPoolWorker *));
+        assertNotNull(larger, "Cannot allocate a table of %d PARCThreadPool workers", capacity);
+        larger->capacity = capacity;
+        larger->retired = table;
+        for (int i = 0; i < pool->workerCount; i++) {
+            larger->slots[i] = table->slots[i];
+        }
+        __atomic_store_n(&pool->workerTable, larger, __ATOMIC_RELEASE);
+        table = larger;
+    }
+
+    _PARCThreadPoolWorker *result = calloc(1, sizeof(_PARCThreadPoolWorker));
+    assertNotNull(result, "Cannot allocate a PARCThreadPool worker");
+    _parcThreadPoolDeque_Init(&result->deque);
+    pthread_cond_init(&result->wakeup, NULL);
+    result->pool = pool;
+    result->seed = 0x9E3779B9u * (uint32_t) (pool->workerCount + 1);
+
+    table->slots[pool->workerCount] = result;
+    __atomic_store_n(&pool->workerCount, pool->workerCount + 1, __ATOMIC_RELEASE);
+
+    return result;
+}
+
+/*
+ * Start a new worker thread if fewer than `limit` are running.
+ */
+static bool
+_parcThreadPool_AddWorker(PARCThreadPool *pool, int limit)
+{
+    bool result = false;
+
+    pthread_mutex_lock(&pool->lock);
+    if (_parcThreadPool_IsStopping(pool) == false && __atomic_load_n(&pool->poolSize, __ATOMIC_ACQUIRE) < limit) {
+        _PARCThreadPoolWorker *worker = _parcThreadPool_AllocateWorker(pool);
+        worker->isRunning = true;
+        worker->mustJoin = true;
+
+        int poolSize = __atomic_add_fetch(&pool->poolSize, 1, __ATOMIC_SEQ_CST);
+        if (poolSize > pool->largestPoolSize) {
+            pool->largestPoolSize = poolSize;
+        }
+
+        int failure = pthread_create(&worker->thread, NULL, (void *(*)(void *)) _parcThreadPool_Worker, worker);
+        assertFalse(failure, "pthread_create failed: %d", failure);
+        result = true;
+    }
+    pthread_mutex_unlock(&pool->lock);
+
+    return result;
+}
 
-                parcLinkedList_Notify(pool->workQueue);
+/*
+ * Called after new work has been made visible: wake one parked worker,
+ * or start a thread if the pool has fewer than its core number.
+ */
+static void
+_parcThreadPool_SignalWork(PARCThreadPool *pool)
+{
+    // Pairs with the fence in _parcThreadPool_Park so that either this thread sees the parked worker,
+    // or the parked worker sees the new work.
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+    if (__atomic_load_n(&pool->idleCount, __ATOMIC_RELAXED) > 0) {
+        pthread_mutex_lock(&pool->lock);
+        _PARCThreadPoolWorker *worker = pool->idleWorkers;
+        if (worker != NULL) {
+            _parcThreadPool_RemoveIdle(pool, worker);
+            pthread_cond_signal(&worker->wakeup);
+        }
+        pthread_mutex_unlock(&pool->lock);
+    } else {
+        int poolSize = __atomic_load_n(&pool->poolSize, __ATOMIC_RELAXED);
+        int core = __atomic_load_n(&pool->corePoolSize, __ATOMIC_RELAXED);
+        if (poolSize < core || poolSize == 0) {
+            _parcThreadPool_AddWorker(pool, core > 0 ? core : 1);
+        }
+    }
+}
+
+static bool
+_parcThreadPool_IsStopping(const PARCThreadPool *pool)
+{
+    return __atomic_load_n(&pool->isStopping, __ATOMIC_ACQUIRE);
+}
+
+/*
+ * Remove a batch of tasks from the injection queue.
+ * The first is returned, the rest are pushed onto the worker's own deque where idle workers may steal them.
+ */
+static PARCFutureTask *
+_parcThreadPool_PollQueue(PARCThreadPool *pool, _PARCThreadPoolWorker *worker)
+{
+    PARCFutureTask *result = NULL;
+
+    if (__atomic_load_n(&pool->workQueueSize, __ATOMIC_ACQUIRE) > 0) {
+        PARCFutureTask *batch[_PARCThreadPool_MaxInjectionBatch];
+        size_t count = 0;
+
+        pthread_mutex_lock(&pool->workQueue.lock);
+        int poolSize = __atomic_load_n(&pool->poolSize, __ATOMIC_RELAXED);
+        size_t share = pool->workQueue.count / (poolSize > 0 ? poolSize : 1);
+        size_t limit = (share < 1) ? 1 : (share > _PARCThreadPool_MaxInjectionBatch ? _PARCThreadPool_MaxInjectionBatch : share);
+
+        while (count < limit && pool->workQueue.count > 0) {
+            batch[count++] = _parcThreadPoolQueue_RemoveFirst(&pool->workQueue);
+        }
+        __atomic_store_n(&pool->workQueueSize, pool->workQueue.count, __ATOMIC_RELEASE);
+        pthread_mutex_unlock(&pool->workQueue.lock);
+
+        if (count > 0) {
+            result = batch[0];
+            // Push in reverse so the owner's LIFO takes still run them in submission order.
+            for (size_t i = count - 1; i > 0; i--) {
+                _parcThreadPoolDeque_Push(&worker->deque, batch[i]);
+            }
+            if (count > 1) {
+                _parcThreadPool_SignalWork(pool);
+            }
+        }
+    }
+
+    return result;
+}
+
+static PARCFutureTask *
+_parcThreadPool_StealTask(PARCThreadPool *pool, _PARCThreadPoolWorker *worker)
+{
+    PARCFutureTask *result = NULL;
+
+    int count = __atomic_load_n(&pool->workerCount, __ATOMIC_ACQUIRE);
+    if (count > 1) {
+        _PARCThreadPoolWorkerTable *table = __atomic_load_n(&pool->workerTable, __ATOMIC_ACQUIRE);
+        int start = (int) (_parcThreadPoolWorker_Random(worker) % (uint32_t) count);
+        for (int i = 0; i < count && result == NULL; i++) {
+            _PARCThreadPoolWorker *victim = table->slots[(start + i) % count];
+            if (victim != worker) {
+                result = _parcThreadPoolDeque_Steal(&victim->deque);
+            }
+        }
+    }
+
+    return result;
+}
+
+static PARCFutureTask *
+_parcThreadPool_FindTask(PARCThreadPool *pool, _PARCThreadPoolWorker *worker)
+{
+    PARCFutureTask *result = _parcThreadPoolDeque_Take(&worker->deque);
+
+    if (result == NULL) {
+        result = _parcThreadPool_PollQueue(pool, worker);
+    }
+    if (result == NULL) {
+        result = _parcThreadPool_StealTask(pool, worker);
+    }
+
+    return result;
+}
+
+/*
+ * Run a task and account for it.
+ * Returns false if the pool was destroyed when the task finished.
+ */
+static bool
+_parcThreadPool_RunTask(PARCThreadPool *pool, PARCFutureTask *task)
+{
+    __atomic_add_fetch(&pool->activeCount, 1, __ATOMIC_RELAXED);
+    if (parcFutureTask_IsCancelled(task) == false) {
+        parcFutureTask_Run(task);
+    }
+    parcFutureTask_Release(&task);
+    parcAtomicUint64_Increment(pool->completedTaskCount);
+    __atomic_sub_fetch(&pool->activeCount, 1, __ATOMIC_RELAXED);
+
+    return _parcThreadPool_TasksDone(pool, 1);
+}
+
+/*
+ * Give up one thread if the pool is larger than its core size.
+ * Must be called with the pool lock held.
+ */
+static bool
+_parcThreadPool_RetireExcess(PARCThreadPool *pool)
+{
+    int poolSize = __atomic_load_n(&pool->poolSize, __ATOMIC_ACQUIRE);
+
+    while (poolSize > pool->corePoolSize) {
+        if (__atomic_compare_exchange_n(&pool->poolSize, &poolSize, poolSize - 1, false, __ATOMIC_SEQ_CST, __ATOMIC_ACQUIRE)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static void
+_parcThreadPool_Deadline(struct timespec *deadline, uint64_t nanoseconds)
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    uint64_t now = (uint64_t) tv.tv_sec * 1000000000ULL + (uint64_t) tv.tv_usec * 1000ULL;
+    uint64_t when = (nanoseconds > UINT64_MAX - now) ? UINT64_MAX : now + nanoseconds;
+
+    deadline->tv_sec = (time_t) (when / 1000000000ULL);
+    deadline->tv_nsec = (long) (when % 1000000000ULL);
+}
+
+/*
+ * Wait for a signal that there is new work.
+ * Returns false if the worker has already left the pool's thread count and should exit.
+ */
+static bool
+_parcThreadPool_Park(PARCThreadPool *pool, _PARCThreadPoolWorker *worker)
+{
+    bool result = true;
+
+    pthread_mutex_lock(&pool->lock);
+    if (_parcThreadPool_RetireExcess(pool)) {
+        result = false;
+    } else {
+        worker->isIdle = true;
+        worker->nextIdle = pool->idleWorkers;
+        pool->idleWorkers = worker;
+        __atomic_add_fetch(&pool->idleCount, 1, __ATOMIC_SEQ_CST);
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+        if (_parcThreadPool_HasWork(pool) == false && _parcThreadPool_IsStopping(pool) == false) {
+            if (pool->allowCoreThreadTimeOut && parcTimeout_IsNever(&pool->keepAliveTime) == false) {
+                struct timespec deadline;
+                _parcThreadPool_Deadline(&deadline, pool->keepAliveTime);
+                int status = pthread_cond_timedwait(&worker->wakeup, &pool->lock, &deadline);
+                if (status == ETIMEDOUT && worker->isIdle && pool->allowCoreThreadTimeOut) {
+                    __atomic_sub_fetch(&pool->poolSize, 1, __ATOMIC_SEQ_CST);
+                    result = false;
+                }
             } else {
-                parcLinkedList_WaitFor(pool->workQueue, 1000000000);
+                pthread_cond_wait(&worker->wakeup, &pool->lock);
             }
-            parcLinkedList_Unlock(pool->workQueue);
+        }
+
+        if (worker->isIdle) {
+            _parcThreadPool_RemoveIdle(pool, worker);
         }
     }
+    pthread_mutex_unlock(&pool->lock);
+
+    return result;
+}
+
+/*
+ * A worker that has given up its place in the pool makes sure work submitted in the meantime is not stranded.
+ * Returns true if the worker took its place back and should continue.
+ */
+static bool
+_parcThreadPool_Revive(PARCThreadPool *pool)
+{
+    bool result = false;
+
+    // Pairs with the fence in _parcThreadPool_SignalWork.
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (_parcThreadPool_IsStopping(pool) == false && _parcThreadPool_HasWork(pool)) {
+        int expected = 0;
+        result = __atomic_compare_exchange_n(&pool->poolSize, &expected, 1, false, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED);
+    }
+
+    return result;
+}
 
+static void *
+_parcThreadPool_Worker(_PARCThreadPoolWorker *worker)
+{
+    PARCThreadPool *pool = worker->pool;
+    pthread_setspecific(_parcThreadPool_CurrentWorkerKey, worker);
+
+    bool running = true;
+    while (running && _parcThreadPool_IsStopping(pool) == false) {
+        PARCFutureTask *task = _parcThreadPool_FindTask(pool, worker);
+        if (task != NULL) {
+            if (_parcThreadPool_RunTask(pool, task) == false) {
+                // This thread released the last reference to the pool, which has detached it and freed this worker.
+                pthread_setspecific(_parcThreadPool_CurrentWorkerKey, NULL);
+                return NULL;
+            }
+        } else if (_parcThreadPool_Park(pool, worker) == false) {
+            running = _parcThreadPool_Revive(pool);
+        }
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    if (running) {
+        __atomic_sub_fetch(&pool->poolSize, 1, __ATOMIC_SEQ_CST);
+    }
+    worker->isRunning = false;
+    pthread_mutex_unlock(&pool->lock);
+
+    pthread_setspecific(_parcThreadPool_CurrentWorkerKey, NULL);
     return NULL;
 }
 
 static void
-_parcThreadPool_CancelAll(const PARCThreadPool *pool)
+_parcThreadPool_WakeAll(PARCThreadPool *pool)
 {
-    PARCIterator *iterator = parcLinkedList_CreateIterator(pool->threads);
-
-    while (parcIterator_HasNext(iterator)) {
-        PARCThread *thread = parcIterator_Next(iterator);
-        parcThread_Cancel(thread);
+    pthread_mutex_lock(&pool->lock);
+    for (int i = 0; i < pool->workerCount; i++) {
+        pthread_cond_signal(&pool->workerTable->slots[i]->wakeup);
     }
-    parcIterator_Release(&iterator);
+    pthread_mutex_unlock(&pool->lock);
 }
 
+/*
+ * Join every worker thread except the calling one, which cannot join itself.
+ */
 static void
-_parcThreadPool_JoinAll(const PARCThreadPool *pool)
+_parcThreadPool_JoinAll(PARCThreadPool *pool)
 {
-    PARCIterator *iterator = parcLinkedList_CreateIterator(pool->threads);
+    for (int i = 0; i < __atomic_load_n(&pool->workerCount, __ATOMIC_ACQUIRE); i++) {
+        pthread_mutex_lock(&pool->lock);
+        _PARCThreadPoolWorker *worker = pool->workerTable->slots[i];
+        bool mustJoin = worker->mustJoin && pthread_equal(worker->thread, pthread_self()) == 0;
+        if (mustJoin) {
+            worker->mustJoin = false;
+        }
+        pthread_mutex_unlock(&pool->lock);
+
+        if (mustJoin) {
+            pthread_join(worker->thread, NULL);
+        }
+    }
+}
+
+/*
+ * Release every task still waiting in the injection queue or a worker's deque.
+ * Returns false if this released the last reference to the pool.
+ */
+static bool
+_parcThreadPool_DiscardAll(PARCThreadPool *pool)
+{
+    size_t discarded = 0;
+
+    pthread_mutex_lock(&pool->workQueue.lock);
+    PARCFutureTask *task;
+    while ((task = _parcThreadPoolQueue_RemoveFirst(&pool->workQueue)) != NULL) {
+        parcFutureTask_Release(&task);
+        discarded++;
+    }
+    __atomic_store_n(&pool->workQueueSize, 0, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&pool->workQueue.lock);
 
-    while (parcIterator_HasNext(iterator)) {
-        PARCThread *thread = parcIterator_Next(iterator);
-        parcThread_Join(thread);
+    for (int i = 0; i < __atomic_load_n(&pool->workerCount, __ATOMIC_ACQUIRE); i++) {
+        _PARCThreadPoolDeque *deque = &pool->workerTable->slots[i]->deque;
+        while (_parcThreadPoolDeque_IsEmpty(deque) == false) {
+            task = _parcThreadPoolDeque_Steal(deque);
+            if (task != NULL) {
+                parcFutureTask_Release(&task);
+                discarded++;
+            }
+        }
     }
-    parcIterator_Release(&iterator);
+
+    return (discarded > 0) ? _parcThreadPool_TasksDone(pool, discarded) : true;
+}
+
+static void
+_parcThreadPool_Stop(PARCThreadPool *pool)
+{
+    pthread_mutex_lock(&pool->lock);
+    pool->isShutdown = true;
+    pool->isTerminating = true;
+    __atomic_store_n(&pool->isStopping, true, __ATOMIC_SEQ_CST);
+    pthread_mutex_unlock(&pool->lock);
+
+    _parcThreadPool_WakeAll(pool);
+    _parcThreadPool_JoinAll(pool);
 }
 
 static bool
@@ -140,17 +881,32 @@ _parcThreadPool_Destructor(PARCThreadPool **instancePtr)
     assertNotNull(instancePtr, "Parameter must be a non-null pointer to a PARCThreadPool pointer.");
     PARCThreadPool *pool = *instancePtr;
 
-    if (pool->isShutdown == false) {
-        _parcThreadPool_CancelAll(pool);
-        _parcThreadPool_JoinAll(pool);
+    // No task is outstanding, otherwise the pool would still hold a reference to itself.
+    _parcThreadPool_Stop(pool);
+
+    _PARCThreadPoolWorkerTable *table = pool->workerTable;
+    for (int i = 0; i < pool->workerCount; i++) {
+        _PARCThreadPoolWorker *worker = table->slots[i];
+        if (worker->mustJoin) {
+            // The last reference was released by a task running on this worker.
+            pthread_detach(worker->thread);
+        }
+        _parcThreadPoolDeque_Fini(&worker->deque);
+        pthread_cond_destroy(&worker->wakeup);
+        free(worker);
+    }
+    while (table != NULL) {
+        _PARCThreadPoolWorkerTable *retired = table->retired;
+        free(table);
+        table = retired;
     }
 
     parcAtomicUint64_Release(&pool->completedTaskCount);
-    parcLinkedList_Release(&pool->threads);
 
-    if (parcObject_Lock(pool->workQueue)) {
-        parcLinkedList_Release(&pool->workQueue);
-    }
+    _parcThreadPoolQueue_Fini(&pool->workQueue);
+
+    pthread_cond_destroy(&pool->drained);
+    pthread_mutex_destroy(&pool->lock);
 
     return true;
 }
@@ -179,33 +935,39 @@ parcThreadPool_AssertValid(const PARCThreadPool *instance)
 PARCThreadPool *
 parcThreadPool_Create(int poolSize)
 {
+    pthread_once(&_parcThreadPool_CurrentWorkerOnce, _parcThreadPool_CreateCurrentWorkerKey);
+
     PARCThreadPool *result = parcObject_CreateInstance(PARCThreadPool);
 
     if (result != NULL) {
-        result->poolSize = poolSize;
+        result->corePoolSize = poolSize;
         result->maximumPoolSize = poolSize;
+        result->poolSize = 0;
+        result->largestPoolSize = 0;
+        result->allowCoreThreadTimeOut = false;
+        result->keepAliveTime = UINT64_MAX;
         result->taskCount = 0;
+        result->activeCount = 0;
+        result->outstanding = 0;
         result->isShutdown = false;
         result->isTerminated = false;
         result->isTerminating = false;
-        result->workQueue = parcLinkedList_Create();
-        result->threads = parcLinkedList_Create();
+        result->isStopping = false;
+        _parcThreadPoolQueue_Init(&result->workQueue);
+        result->workQueueSize = 0;
+
+        pthread_mutex_init(&result->lock, NULL);
+        pthread_cond_init(&result->drained, NULL);
+        result->workerTable = NULL;
+        result->workerCount = 0;
+        result->idleWorkers = NULL;
+        result->idleCount = 0;
 
         result->completedTaskCount = parcAtomicUint64_Create(0);
 
         result->continueExistingPeriodicTasksAfterShutdown = false;
         result->executeExistingDelayedTasksAfterShutdown = false;
         result->removeOnCancel = true;
-
-        if (parcObject_Lock(result)) {
-            for (int i = 0; i < poolSize; i++) {
-                PARCThread *thread = parcThread_Create((void *(*)(PARCThread *, PARCObject *)) _parcThreadPool_Worker, (PARCObject *) result);
-                parcLinkedList_Append(result->threads, thread);
-                parcThread_Start(thread);
-                parcThread_Release(&thread);
-            }
-            parcObject_Unlock(result);
-        }
     }
 
     return result;
@@ -222,7 +984,7 @@ parcThreadPool_Compare(const PARCThreadPool *instance, const PARCThreadPool *oth
 PARCThreadPool *
 parcThreadPool_Copy(const PARCThreadPool *original)
 {
-    PARCThreadPool *result = parcThreadPool_Create(original->poolSize);
+    PARCThreadPool *result = parcThreadPool_Create(original->corePoolSize);
 
     return result;
 }
@@ -231,7 +993,9 @@ void
 parcThreadPool_Display(const PARCThreadPool *instance, int indentation)
 {
     parcDisplayIndented_PrintLine(indentation, "PARCThreadPool@%p {", instance);
-    /* Call Display() functions for the fields here. */
+    parcDisplayIndented_PrintLine(indentation + 1, ".corePoolSize=%d .poolSize=%d .activeCount=%d .queued=%zu",
+                                  instance->corePoolSize, parcThreadPool_GetPoolSize(instance),
+                                  parcThreadPool_GetActiveCount(instance), __atomic_load_n(&instance->workQueueSize, __ATOMIC_RELAXED));
     parcDisplayIndented_PrintLine(indentation, "}");
 }
 
@@ -246,7 +1010,7 @@ parcThreadPool_Equals(const PARCThreadPool *x, const PARCThreadPool *y)
         result = false;
     } else {
         /* perform instance specific equality tests here. */
-        if (x->poolSize == y->poolSize) {
+        if (x->corePoolSize == y->corePoolSize) {
             result = true;
         }
     }
@@ -296,12 +1060,20 @@ parcThreadPool_ToString(const PARCThreadPool *instance)
 void
 parcThreadPool_SetAllowCoreThreadTimeOut(PARCThreadPool *pool, bool value)
 {
+    pthread_mutex_lock(&pool->lock);
+    pool->allowCoreThreadTimeOut = value;
+    pthread_mutex_unlock(&pool->lock);
+
+    if (value) {
+        // Parked workers re-evaluate how long to wait.
+        _parcThreadPool_WakeAll(pool);
+    }
 }
 
 bool
 parcThreadPool_GetAllowsCoreThreadTimeOut(const PARCThreadPool *pool)
 {
-    return false;
+    return pool->allowCoreThreadTimeOut;
 }
 
 bool
@@ -310,19 +1082,22 @@ parcThreadPool_AwaitTermination(PARCThreadPool *pool, PARCTimeout *timeout)
     bool result = false;
 
     if (pool->isTerminating) {
-        if (parcLinkedList_Lock(pool->workQueue)) {
-            while (parcLinkedList_Size(pool->workQueue) > 0) {
-                if (parcTimeout_IsNever(timeout)) {
-                    parcLinkedList_Wait(pool->workQueue);
-                } else {
-                    // This is not accurate as this will continue the delay, rather than keep a cumulative amount of delay.
-                    uint64_t delay = parcTimeout_InNanoSeconds(timeout);
-                    parcLinkedList_WaitFor(pool->workQueue, delay);
-                }
+        struct timespec deadline;
+        if (!parcTimeout_IsNever(timeout)) {
+            _parcThreadPool_Deadline(&deadline, parcTimeout_InNanoSeconds(timeout));
+        }
+
+        pthread_mutex_lock(&pool->lock);
+        int status = 0;
+        while (__atomic_load_n(&pool->outstanding, __ATOMIC_ACQUIRE) > 0 && status != ETIMEDOUT) {
+            if (parcTimeout_IsNever(timeout)) {
+                pthread_cond_wait(&pool->drained, &pool->lock);
+            } else {
+                status = pthread_cond_timedwait(&pool->drained, &pool->lock, &deadline);
             }
-            result = true;
-            parcLinkedList_Unlock(pool->workQueue);
         }
+        result = (__atomic_load_n(&pool->outstanding, __ATOMIC_ACQUIRE) == 0);
+        pthread_mutex_unlock(&pool->lock);
 
         parcThreadPool_ShutdownNow(pool);
     }
@@ -335,17 +1110,28 @@ parcThreadPool_Execute(PARCThreadPool *pool, PARCFutureTask *task)
 {
     bool result = false;
 
-    if (parcThreadPool_Lock(pool)) {
-        if (pool->isShutdown == false) {
-            parcThreadPool_Unlock(pool);
-            if (parcLinkedList_Lock(pool->workQueue)) {
-                parcLinkedList_Append(pool->workQueue, task);
-                parcLinkedList_Notify(pool->workQueue);
-                parcLinkedList_Unlock(pool->workQueue);
-                result = true;
-            }
+    if (__atomic_load_n(&pool->isShutdown, __ATOMIC_ACQUIRE) == false) {
+        if (__atomic_fetch_add(&pool->outstanding, 1, __ATOMIC_ACQ_REL) == 0) {
+            parcThreadPool_Acquire(pool);
+        }
+        __atomic_add_fetch(&pool->taskCount, 1, __ATOMIC_RELAXED);
+
+        _PARCThreadPoolWorker *worker = _parcThreadPool_CurrentWorker(pool);
+        if (worker != NULL) {
+            _parcThreadPoolDeque_Push(&worker->deque, parcFutureTask_Acquire(task));
         } else {
-            parcThreadPool_Unlock(pool);
+            pthread_mutex_lock(&pool->workQueue.lock);
+            _parcThreadPoolQueue_Append(&pool->workQueue, parcFutureTask_Acquire(task));
+            __atomic_store_n(&pool->workQueueSize, pool->workQueue.count, __ATOMIC_RELEASE);
+            pthread_mutex_unlock(&pool->workQueue.lock);
+        }
+        result = true;
+
+        if (_parcThreadPool_IsStopping(pool)) {
+            // Lost a race with parcThreadPool_ShutdownNow, which may have already discarded the queued tasks.
+            _parcThreadPool_DiscardAll(pool);
+        } else {
+            _parcThreadPool_SignalWork(pool);
         }
     }
 
@@ -355,7 +1141,7 @@ parcThreadPool_Execute(PARCThreadPool *pool, PARCFutureTask *task)
 int
 parcThreadPool_GetActiveCount(const PARCThreadPool *pool)
 {
-    return pool->poolSize;
+    return __atomic_load_n(&pool->activeCount, __ATOMIC_RELAXED);
 }
 
 uint64_t
@@ -367,19 +1153,19 @@ parcThreadPool_GetCompletedTaskCount(const PARCThreadPool *pool)
 int
 parcThreadPool_GetCorePoolSize(const PARCThreadPool *pool)
 {
-    return pool->poolSize;
+    return pool->corePoolSize;
 }
 
 PARCTimeout *
 parcThreadPool_GetKeepAliveTime(const PARCThreadPool *pool)
 {
-    return PARCTimeout_Never;
+    return (pool->keepAliveTime == UINT64_MAX) ? PARCTimeout_Never : (PARCTimeout *) &pool->keepAliveTime;
 }
 
 int
 parcThreadPool_GetLargestPoolSize(const PARCThreadPool *pool)
 {
-    return pool->poolSize;
+    return pool->largestPoolSize;
 }
 
 int
@@ -391,19 +1177,28 @@ parcThreadPool_GetMaximumPoolSize(const PARCThreadPool *pool)
 int
 parcThreadPool_GetPoolSize(const PARCThreadPool *pool)
 {
-    return pool->poolSize;
+    return __atomic_load_n(&pool->poolSize, __ATOMIC_RELAXED);
 }
 
 PARCLinkedList *
 parcThreadPool_GetQueue(const PARCThreadPool *pool)
 {
-    return pool->workQueue;
+    PARCLinkedList *result = parcLinkedList_Create();
+
+    _PARCThreadPoolQueue *queue = (_PARCThreadPoolQueue *) &pool->workQueue;
+    pthread_mutex_lock(&queue->lock);
+    for (size_t i = 0; i < queue->count; i++) {
+        parcLinkedList_Append(result, *_parcThreadPoolQueue_At(queue, i));
+    }
+    pthread_mutex_unlock(&queue->lock);
+
+    return result;
 }
 
 long
 parcThreadPool_GetTaskCount(const PARCThreadPool *pool)
 {
-    return pool->taskCount;
+    return __atomic_load_n(&pool->taskCount, __ATOMIC_RELAXED);
 }
 
 bool
@@ -427,71 +1222,120 @@ parcThreadPool_IsTerminating(const PARCThreadPool *pool)
 int
 parcThreadPool_PrestartAllCoreThreads(PARCThreadPool *pool)
 {
-    return 0;
+    int result = 0;
+
+    while (_parcThreadPool_AddWorker(pool, pool->corePoolSize)) {
+        result++;
+    }
+
+    return result;
 }
 
 bool
 parcThreadPool_PrestartCoreThread(PARCThreadPool *pool)
 {
-    return 0;
+    return _parcThreadPool_AddWorker(pool, pool->corePoolSize);
+}
+
+static bool
+_parcThreadPool_IsCancelled(PARCFutureTask *task, const void *context)
+{
+    return parcFutureTask_IsCancelled(task);
 }
 
 void
 parcThreadPool_Purge(PARCThreadPool *pool)
 {
+    pthread_mutex_lock(&pool->workQueue.lock);
+    size_t removed = _parcThreadPoolQueue_RemoveIf(&pool->workQueue, _parcThreadPool_IsCancelled, NULL);
+    __atomic_store_n(&pool->workQueueSize, pool->workQueue.count, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&pool->workQueue.lock);
+
+    if (removed > 0) {
+        _parcThreadPool_TasksDone(pool, removed);
+    }
+}
+
+static bool
+_parcThreadPool_IsTask(PARCFutureTask *task, const void *context)
+{
+    return task == context;
 }
 
 bool
 parcThreadPool_Remove(PARCThreadPool *pool, PARCFutureTask *task)
 {
-    return false;
+    pthread_mutex_lock(&pool->workQueue.lock);
+    size_t removed = _parcThreadPoolQueue_RemoveIf(&pool->workQueue, _parcThreadPool_IsTask, task);
+    __atomic_store_n(&pool->workQueueSize, pool->workQueue.count, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&pool->workQueue.lock);
+
+    if (removed > 0) {
+        _parcThreadPool_TasksDone(pool, removed);
+    }
+
+    return removed > 0;
 }
 
 void
 parcThreadPool_SetCorePoolSize(PARCThreadPool *pool, int corePoolSize)
 {
+    pthread_mutex_lock(&pool->lock);
+    int previous = pool->corePoolSize;
+    pool->corePoolSize = corePoolSize;
+    if (corePoolSize > pool->maximumPoolSize) {
+        pool->maximumPoolSize = corePoolSize;
+    }
+    pthread_mutex_unlock(&pool->lock);
+
+    if (corePoolSize < previous) {
+        // Excess workers exit the next time they are idle.
+        _parcThreadPool_WakeAll(pool);
+    } else if (corePoolSize > previous) {
+        // Start enough new threads to handle any queued work.
+        while (_parcThreadPool_HasWork(pool) && _parcThreadPool_AddWorker(pool, corePoolSize)) {
+            ;
+        }
+    }
 }
 
 void
 parcThreadPool_SetKeepAliveTime(PARCThreadPool *pool, PARCTimeout *timeout)
 {
+    pthread_mutex_lock(&pool->lock);
+    pool->keepAliveTime = parcTimeout_InNanoSeconds(timeout);
+    pthread_mutex_unlock(&pool->lock);
 }
 
 void
 parcThreadPool_SetMaximumPoolSize(PARCThreadPool *pool, int maximumPoolSize)
 {
+    assertTrue(maximumPoolSize > 0 && maximumPoolSize >= pool->corePoolSize,
+               "The maximum pool size must be positive and not less than the core pool size %d, was %d",
+               pool->corePoolSize, maximumPoolSize);
+
+    pthread_mutex_lock(&pool->lock);
+    pool->maximumPoolSize = maximumPoolSize;
+    pthread_mutex_unlock(&pool->lock);
 }
 
 void
 parcThreadPool_Shutdown(PARCThreadPool *pool)
 {
-    if (parcThreadPool_Lock(pool)) {
-        pool->isShutdown = true;
-        pool->isTerminating = true;
-        parcThreadPool_Unlock(pool);
-    }
+    pthread_mutex_lock(&pool->lock);
+    __atomic_store_n(&pool->isShutdown, true, __ATOMIC_RELEASE);
+    pool->isTerminating = true;
+    pthread_mutex_unlock(&pool->lock);
 }
 
 PARCLinkedList *
 parcThreadPool_ShutdownNow(PARCThreadPool *pool)
 {
-    parcThreadPool_Shutdown(pool);
+    // Cause all of the worker threads to exit, waking them so they detect it,
+    // and join with them, thereby cleaning up all of them.
+    _parcThreadPool_Stop(pool);
 
-    // Cause all of the worker threads to exit.
-    _parcThreadPool_CancelAll(pool);
-
-    // Wake them all up so they detect that they are cancelled.
-    if (parcThreadPool_Lock(pool)) {
-        parcThreadPool_NotifyAll(pool);
-        parcThreadPool_Unlock(pool);
-    }
-
-    if (parcLinkedList_Lock(pool->workQueue)) {
-        parcLinkedList_NotifyAll(pool->workQueue);
-        parcLinkedList_Unlock(pool->workQueue);
-    }
-    // Join with all of them, thereby cleaning up all of them.
-    _parcThreadPool_JoinAll(pool);
+    _parcThreadPool_DiscardAll(pool);
 
     pool->isTerminated = true;
     return NULL;
@@ -129,7 +129,18 @@ void parcThreadPool_AssertValid(const PARCThreadPool *instance);
 /**
  * Create an instance of PARCThreadPool
  *
- * <#Paragraphs Of Explanation#>
+ * The pool runs up to @p poolSize core threads, started on demand as tasks are submitted
+ * (or ahead of time with `parcThreadPool_PrestartAllCoreThreads`).
+ *
+ * Each worker thread has its own work-stealing deque.
+ * Tasks submitted from a task already running on the pool go on that worker's deque,
+ * other tasks go on a shared injection queue, and an idle worker steals from the other workers' deques.
+ * Idle workers park individually and a new task wakes only one of them.
+ *
+ * While tasks are outstanding the pool holds a reference to itself,
+ * so releasing the pool does not discard work that has been submitted to it.
+ *
+ * @param [in] poolSize The core number of threads.
  *
  * @return non-NULL A pointer to a valid PARCThreadPool instance.
  * @return NULL An error occurred.
@@ -556,6 +567,9 @@ bool parcThreadPool_AwaitTermination(PARCThreadPool *pool, PARCTimeout *timeout)
 
 /**
  * Executes the given task sometime in the future.
+ *
+ * @return true The task was accepted.
+ * @return false The pool has been shut down.
  */
 bool parcThreadPool_Execute(PARCThreadPool *pool, PARCFutureTask *task);
 
@@ -595,7 +609,10 @@ int parcThreadPool_GetMaximumPoolSize(const PARCThreadPool *pool);
 int parcThreadPool_GetPoolSize(const PARCThreadPool *pool);
 
 /**
- * Returns the task queue used by this executor.
+ * Returns a snapshot of the tasks waiting in the queue used by this executor.
+ *
+ * This is the shared injection queue only, it does not include tasks held in the workers' deques.
+ * The returned list is a copy that the caller must release with `parcLinkedList_Release`.
  */
 PARCLinkedList *parcThreadPool_GetQueue(const PARCThreadPool *pool);
 
@@ -621,6 +638,8 @@ bool parcThreadPool_IsTerminating(const PARCThreadPool *pool);
 
 /**
  * Starts all core threads, causing them to idly wait for work.
+ *
+ * @return The number of threads started.
  */
 int parcThreadPool_PrestartAllCoreThreads(PARCThreadPool *pool);
 
@@ -631,16 +650,23 @@ bool parcThreadPool_PrestartCoreThread(PARCThreadPool *pool);
 
 /**
  * Tries to remove from the work queue all Future tasks that have been cancelled.
+ *
+ * Cancelled tasks already moved to a worker's deque are not removed, but are skipped when they are reached.
  */
 void parcThreadPool_Purge(PARCThreadPool *pool);
 
 /**
  * Removes this task from the executor's internal queue if it is present, thus causing it not to be run if it has not already started.
+ *
+ * Only the shared injection queue is searched.
  */
 bool parcThreadPool_Remove(PARCThreadPool *pool, PARCFutureTask *task);
 
 /**
  * Sets the core number of threads.
+ *
+ * If the new value is smaller, excess threads exit when they next become idle.
+ * If it is larger, new threads are started as needed to run queued tasks.
  */
 void parcThreadPool_SetCorePoolSize(PARCThreadPool *pool, int corePoolSize);
 
@@ -89,13 +89,13 @@ typedef uint64_t PARCTimeout;
  * @def PARCTimeout_MicroSeconds
  * This represents a timeout that will occur in the specified number of microseconds.
  */
-#define parcTimeout_MicroSeconds(_usec_) parcTimeout_NanoSeconds(_usec_ * 1000)
+#define parcTimeout_MicroSeconds(_usec_) parcTimeout_NanoSeconds((uint64_t) (_usec_) * 1000)
 
 /*
  * @def PARCTimeout_MilliSeconds
  * This represents a timeout that will occur in the specified number of microseconds.
  */
-#define parcTimeout_MilliSeconds(_msec_) parcTimeout_MicroSeconds(_msec_ * 1000)
+#define parcTimeout_MilliSeconds(_msec_) parcTimeout_MicroSeconds((uint64_t) (_msec_) * 1000)
 
 /**
  * Determine if two `PARCTimeout` instances are equal.
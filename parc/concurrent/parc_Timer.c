@@ -58,23 +58,489 @@
  */
 #include <config.h>
 
+#include <pthread.h>
+#include <sys/time.h>
+#include <time.h>
+
 #include <parc/algol/parc_Object.h>
 #include <parc/algol/parc_DisplayIndented.h>
 #include <parc/algol/parc_Memory.h>
+#include <parc/algol/parc_Clock.h>
 
 #include "parc_Timer.h"
 
+/*
+ * The timing wheel has four levels of 256 slots each, with a resolution of one millisecond.
+ * Level 0 covers the next 256 ms, level 1 the next 65 s, level 2 the next 4.6 hours and level 3 the next 49 days.
+ * Each slot is a circular, doubly-linked list headed by a sentinel so that insertion and removal are O(1).
+ * When the low level wraps around, the entries in the current slot of the next level up are redistributed (cascaded)
+ * into the lower levels according to their remaining time.
+ */
+#define _PARCTimer_WheelLevels 4
+#define _PARCTimer_WheelBits 8
+#define _PARCTimer_WheelSlots (1 << _PARCTimer_WheelBits)
+#define _PARCTimer_WheelMask (_PARCTimer_WheelSlots - 1)
+#define _PARCTimer_MaximumTicks ((((uint64_t) 1) << (_PARCTimer_WheelLevels * _PARCTimer_WheelBits)) - 1)
+
+typedef struct _parc_timer_entry {
+    struct _parc_timer_entry *previous;
+    struct _parc_timer_entry *next;
+    uint64_t expiration;
+    uint64_t period;
+    PARCFutureTask *task;
+} _PARCTimerEntry;
+
 struct PARCTimer {
-    int delay;
+    pthread_mutex_t mutex;
+    pthread_cond_t condition;
+    pthread_t thread;
+    bool threadStarted;
+    bool isCancelled;
+
+    PARCThreadPool *pool;
+    PARCClock *clock;
+
+    // Entries handed to the pool whose run has not yet finished. They are on no list until it does.
+    size_t pooledRuns;
+
+    // The next tick to be processed by the wheel.
+    uint64_t currentTick;
+    size_t scheduledCount;
+
+    _PARCTimerEntry *freeList;
+    _PARCTimerEntry wheel[_PARCTimer_WheelLevels][_PARCTimer_WheelSlots];
 };
 
+static inline void
+_parcTimerEntry_InitList(_PARCTimerEntry *head)
+{
+    head->previous = head;
+    head->next = head;
+}
+
+static inline bool
+_parcTimerEntry_ListIsEmpty(const _PARCTimerEntry *head)
+{
+    return head->next == head;
+}
+
+static inline void
+_parcTimerEntry_Unlink(_PARCTimerEntry *entry)
+{
+    entry->previous->next = entry->next;
+    entry->next->previous = entry->previous;
+    entry->previous = entry;
+    entry->next = entry;
+}
+
+static inline void
+_parcTimerEntry_Append(_PARCTimerEntry *head, _PARCTimerEntry *entry)
+{
+    entry->next = head;
+    entry->previous = head->previous;
+    head->previous->next = entry;
+    head->previous = entry;
+}
+
+// Move every entry in `from` to the end of `to`, leaving `from` empty.
+static inline void
+_parcTimerEntry_Splice(_PARCTimerEntry *to, _PARCTimerEntry *from)
+{
+    if (!_parcTimerEntry_ListIsEmpty(from)) {
+        from->next->previous = to->previous;
+        to->previous->next = from->next;
+        from->previous->next = to;
+        to->previous = from->previous;
+        _parcTimerEntry_InitList(from);
+    }
+}
+
+static _PARCTimerEntry *
+_parcTimer_AllocateEntry(PARCTimer *timer)
+{
+    _PARCTimerEntry *result = timer->freeList;
+    if (result != NULL) {
+        timer->freeList = result->next;
+    } else {
+        result = parcMemory_Allocate(sizeof(_PARCTimerEntry));
+        assertNotNull(result, "parcMemory_Allocate(%zu) returned NULL", sizeof(_PARCTimerEntry));
+    }
+    return result;
+}
+
+static void
+_parcTimer_FreeEntry(PARCTimer *timer, _PARCTimerEntry *entry)
+{
+    entry->task = NULL;
+    entry->next = timer->freeList;
+    timer->freeList = entry;
+}
+
+/*
+ * Place the entry in the wheel slot that corresponds to its expiration relative to the current tick.
+ * Entries already due are placed in the slot for the current tick, which is processed next.
+ * Must be called with the timer mutex held.
+ */
+static void
+_parcTimer_Place(PARCTimer *timer, _PARCTimerEntry *entry)
+{
+    uint64_t expiration = entry->expiration;
+    if (expiration < timer->currentTick) {
+        expiration = timer->currentTick;
+    }
+
+    uint64_t delta = expiration - timer->currentTick;
+    if (delta > _PARCTimer_MaximumTicks) {
+        // Parked in the farthest slot and re-evaluated when that slot cascades.
+        expiration = timer->currentTick + _PARCTimer_MaximumTicks;
+        delta = _PARCTimer_MaximumTicks;
+    }
+
+    int level = 0;
+    while (level < _PARCTimer_WheelLevels - 1 && delta >= (((uint64_t) 1) << ((level + 1) * _PARCTimer_WheelBits))) {
+        level++;
+    }
+
+    size_t slot = (expiration >> (level * _PARCTimer_WheelBits)) & _PARCTimer_WheelMask;
+    _parcTimerEntry_Append(&timer->wheel[level][slot], entry);
+}
+
+/*
+ * Redistribute the entries of the current slot at the given level into the lower levels.
+ * Returns the slot index that was cascaded so the caller can decide whether the next level up must cascade too.
+ */
+static size_t
+_parcTimer_Cascade(PARCTimer *timer, int level)
+{
+    size_t slot = (timer->currentTick >> (level * _PARCTimer_WheelBits)) & _PARCTimer_WheelMask;
+
+    _PARCTimerEntry list;
+    _parcTimerEntry_InitList(&list);
+    _parcTimerEntry_Splice(&list, &timer->wheel[level][slot]);
+
+    while (!_parcTimerEntry_ListIsEmpty(&list)) {
+        _PARCTimerEntry *entry = list.next;
+        _parcTimerEntry_Unlink(entry);
+        _parcTimer_Place(timer, entry);
+    }
+
+    return slot;
+}
+
+/*
+ * Advance the wheel up to and including the tick `now`, moving every expired entry onto the `expired` list.
+ * Must be called with the timer mutex held.
+ */
+static void
+_parcTimer_Advance(PARCTimer *timer, uint64_t now, _PARCTimerEntry *expired)
+{
+    if (timer->scheduledCount == 0) {
+        // Nothing can cascade, so there is no need to step through the idle ticks.
+        if (timer->currentTick <= now) {
+            timer->currentTick = now + 1;
+        }
+        return;
+    }
+
+    while (timer->currentTick <= now) {
+        size_t index = timer->currentTick & _PARCTimer_WheelMask;
+        if (index == 0) {
+            for (int level = 1; level < _PARCTimer_WheelLevels; level++) {
+                if (_parcTimer_Cascade(timer, level) != 0) {
+                    break;
+                }
+            }
+        }
+        _parcTimerEntry_Splice(expired, &timer->wheel[0][index]);
+        timer->currentTick++;
+    }
+}
+
+/*
+ * The number of milliseconds the background thread may sleep before it must process the wheel again.
+ * Must be called with the timer mutex held.
+ */
+static uint64_t
+_parcTimer_SleepTicks(const PARCTimer *timer, uint64_t now)
+{
+    if (now >= timer->currentTick) {
+        return 0;
+    }
+
+    // Look for the nearest occupied slot in level 0, stopping at the next cascade point.
+    uint64_t tick = timer->currentTick;
+    do {
+        if (!_parcTimerEntry_ListIsEmpty(&timer->wheel[0][tick & _PARCTimer_WheelMask])) {
+            break;
+        }
+        tick++;
+    } while ((tick & _PARCTimer_WheelMask) != 0);
+
+    return tick - now;
+}
+
+static void
+_parcTimer_RunTask(_PARCTimerEntry *entry)
+{
+    if (entry->period > 0) {
+        parcFutureTask_RunAndReset(entry->task);
+    } else {
+        parcFutureTask_Run(entry->task);
+    }
+}
+
+/*
+ * After a task has run, put a periodic task back on the wheel, or discard the entry.
+ * Must be called with the timer mutex held.
+ */
+static void
+_parcTimer_Rearm(PARCTimer *timer, _PARCTimerEntry *entry)
+{
+    if (entry->period > 0 && timer->isCancelled == false && !parcFutureTask_IsCancelled(entry->task)) {
+        entry->expiration = parcClock_GetTime(timer->clock) + entry->period;
+        _parcTimer_Place(timer, entry);
+    } else {
+        timer->scheduledCount--;
+        parcFutureTask_Release(&entry->task);
+        _parcTimer_FreeEntry(timer, entry);
+    }
+}
+
+/*
+ * A run of a timer entry on the thread pool.
+ * The entry is re-armed only when the run finishes, so a slow periodic task never overlaps its own next run.
+ * If the pool discards the run without executing it, the entry is discarded when the run is released.
+ */
+typedef struct {
+    PARCTimer *timer;
+    _PARCTimerEntry *entry;
+} _PARCTimerPooledRun;
+
+static pthread_once_t _parcTimer_PooledRunKeyOnce = PTHREAD_ONCE_INIT;
+static pthread_key_t _parcTimer_PooledRunKey;   // The timer whose task the current thread is running, if any.
+
+static void
+_parcTimer_CreatePooledRunKey(void)
+{
+    pthread_key_create(&_parcTimer_PooledRunKey, NULL);
+}
+
+/*
+ * Must be called with the timer mutex held.
+ */
+static void
+_parcTimer_FinishPooledRun(PARCTimer *timer, _PARCTimerPooledRun *run, bool ran)
+{
+    if (ran) {
+        _parcTimer_Rearm(timer, run->entry);
+    } else {
+        timer->scheduledCount--;
+        parcFutureTask_Release(&run->entry->task);
+        _parcTimer_FreeEntry(timer, run->entry);
+    }
+    run->entry = NULL;
+    timer->pooledRuns--;
+
+    // Wake the background thread for a re-armed entry, and _parcTimer_Stop waiting for the last run.
+    pthread_cond_broadcast(&timer->condition);
+}
+
+static void
+_parcTimerPooledRun_Finalize(_PARCTimerPooledRun **runPtr)
+{
+    _PARCTimerPooledRun *run = *runPtr;
+
+    if (run->entry != NULL) {
+        pthread_mutex_lock(&run->timer->mutex);
+        _parcTimer_FinishPooledRun(run->timer, run, false);
+        pthread_mutex_unlock(&run->timer->mutex);
+    }
+}
+
+parcObject_ExtendPARCObject(_PARCTimerPooledRun, _parcTimerPooledRun_Finalize, NULL, NULL, NULL, NULL, NULL, NULL);
+
+static void *
+_parcTimerPooledRun_Run(PARCFutureTask *task, void *parameter)
+{
+    _PARCTimerPooledRun *run = parameter;
+    PARCTimer *timer = run->timer;
+
+    pthread_setspecific(_parcTimer_PooledRunKey, timer);
+    _parcTimer_RunTask(run->entry);
+    pthread_setspecific(_parcTimer_PooledRunKey, NULL);
+
+    pthread_mutex_lock(&timer->mutex);
+    _parcTimer_FinishPooledRun(timer, run, true);
+    pthread_mutex_unlock(&timer->mutex);
+
+    return NULL;
+}
+
+/*
+ * Hand an expired task to the thread pool, or run it here if this timer has no pool.
+ * Called without the timer mutex held.
+ *
+ * @return true The task has run, and the caller must re-arm the entry.
+ * @return false The task was handed to the pool, which re-arms the entry when the run finishes.
+ */
+static bool
+_parcTimer_Dispatch(PARCTimer *timer, _PARCTimerEntry *entry)
+{
+    if (timer->pool == NULL) {
+        _parcTimer_RunTask(entry);
+        return true;
+    }
+
+    _PARCTimerPooledRun *run = parcObject_CreateInstance(_PARCTimerPooledRun);
+    assertNotNull(run, "parcObject_CreateInstance returned NULL");
+    run->timer = timer;
+    run->entry = entry;
+
+    pthread_mutex_lock(&timer->mutex);
+    timer->pooledRuns++;
+    pthread_mutex_unlock(&timer->mutex);
+
+    // The future task holds the only reference to the run, so a run the pool never executes is finalized with it.
+    PARCFutureTask *pooledTask = parcFutureTask_Create(_parcTimerPooledRun_Run, run);
+    parcObject_Release((PARCObject **) &run);
+    parcThreadPool_Execute(timer->pool, pooledTask);
+    parcFutureTask_Release(&pooledTask);
+
+    return false;
+}
+
+static void *
+_parcTimer_Run(PARCTimer *timer)
+{
+    _PARCTimerEntry expired;
+    _parcTimerEntry_InitList(&expired);
+
+    pthread_mutex_lock(&timer->mutex);
+    while (timer->isCancelled == false) {
+        uint64_t now = parcClock_GetTime(timer->clock);
+        _parcTimer_Advance(timer, now, &expired);
+
+        if (_parcTimerEntry_ListIsEmpty(&expired)) {
+            if (timer->scheduledCount == 0) {
+                pthread_cond_wait(&timer->condition, &timer->mutex);
+            } else {
+                uint64_t sleep = _parcTimer_SleepTicks(timer, now);
+                struct timeval tv;
+                gettimeofday(&tv, NULL);
+                uint64_t deadline = (uint64_t) tv.tv_sec * 1000000000ULL + (uint64_t) tv.tv_usec * 1000ULL + sleep * 1000000ULL;
+                struct timespec abstime = { .tv_sec = deadline / 1000000000ULL, .tv_nsec = deadline % 1000000000ULL };
+                pthread_cond_timedwait(&timer->condition, &timer->mutex, &abstime);
+            }
+            continue;
+        }
+
+        while (!_parcTimerEntry_ListIsEmpty(&expired) && timer->isCancelled == false) {
+            _PARCTimerEntry *entry = expired.next;
+            _parcTimerEntry_Unlink(entry);
+
+            if (parcFutureTask_IsCancelled(entry->task)) {
+                timer->scheduledCount--;
+                parcFutureTask_Release(&entry->task);
+                _parcTimer_FreeEntry(timer, entry);
+                continue;
+            }
+
+            pthread_mutex_unlock(&timer->mutex);
+            bool ran = _parcTimer_Dispatch(timer, entry);
+            pthread_mutex_lock(&timer->mutex);
+
+            if (ran) {
+                _parcTimer_Rearm(timer, entry);
+            }
+        }
+    }
+
+    // Entries removed from the wheel but not yet dispatched when the timer was cancelled.
+    while (!_parcTimerEntry_ListIsEmpty(&expired)) {
+        _PARCTimerEntry *entry = expired.next;
+        _parcTimerEntry_Unlink(entry);
+        timer->scheduledCount--;
+        parcFutureTask_Release(&entry->task);
+        _parcTimer_FreeEntry(timer, entry);
+    }
+    pthread_mutex_unlock(&timer->mutex);
+
+    return NULL;
+}
+
+/*
+ * Release every scheduled task, returning their entries to the free list.
+ * Must be called with the timer mutex held.
+ */
+static void
+_parcTimer_DiscardAll(PARCTimer *timer)
+{
+    for (int level = 0; level < _PARCTimer_WheelLevels; level++) {
+        for (size_t slot = 0; slot < _PARCTimer_WheelSlots; slot++) {
+            _PARCTimerEntry *head = &timer->wheel[level][slot];
+            while (!_parcTimerEntry_ListIsEmpty(head)) {
+                _PARCTimerEntry *entry = head->next;
+                _parcTimerEntry_Unlink(entry);
+                timer->scheduledCount--;
+                parcFutureTask_Release(&entry->task);
+                _parcTimer_FreeEntry(timer, entry);
+            }
+        }
+    }
+}
+
+static void
+_parcTimer_Stop(PARCTimer *timer)
+{
+    pthread_mutex_lock(&timer->mutex);
+    bool mustJoin = timer->threadStarted;
+    timer->isCancelled = true;
+    timer->threadStarted = false;
+    pthread_cond_signal(&timer->condition);
+    pthread_mutex_unlock(&timer->mutex);
+
+    // Calling parcTimer_Cancel from a task running on the timer thread must not join with itself.
+    if (mustJoin) {
+        if (pthread_equal(pthread_self(), timer->thread)) {
+            pthread_detach(timer->thread);
+        } else {
+            pthread_join(timer->thread, NULL);
+        }
+    }
+
+    pthread_mutex_lock(&timer->mutex);
+    _parcTimer_DiscardAll(timer);
+
+    // Wait for the runs still on the pool, which discard their entries as they finish.
+    // A task cancelling its own timer must not wait for its own run.
+    size_t ownRun = (pthread_getspecific(_parcTimer_PooledRunKey) == timer) ? 1 : 0;
+    while (timer->pooledRuns > ownRun) {
+        pthread_cond_wait(&timer->condition, &timer->mutex);
+    }
+    pthread_mutex_unlock(&timer->mutex);
+}
+
 static void
 _parcTimer_Finalize(PARCTimer **instancePtr)
 {
     assertNotNull(instancePtr, "Parameter must be a non-null pointer to a PARCTimer pointer.");
+    PARCTimer *timer = *instancePtr;
+
+    _parcTimer_Stop(timer);
+
+    while (timer->freeList != NULL) {
+        _PARCTimerEntry *entry = timer->freeList;
+        timer->freeList = entry->next;
+        parcMemory_Deallocate(&entry);
+    }
 
+    if (timer->pool != NULL) {
+        parcThreadPool_Release(&timer->pool);
+    }
+    parcClock_Release(&timer->clock);
 
-    /* cleanup the instance fields here */
+    pthread_cond_destroy(&timer->condition);
+    pthread_mutex_destroy(&timer->mutex);
 }
 
 parcObject_ImplementAcquire(parcTimer, PARCTimer);
@@ -92,16 +558,40 @@ parcTimer_AssertValid(const PARCTimer *instance)
 }
 
 PARCTimer *
-parcTimer_Create(void)
+parcTimer_CreateWithThreadPool(PARCThreadPool *pool)
 {
     PARCTimer *result = parcObject_CreateInstance(PARCTimer);
 
     if (result != NULL) {
+        pthread_mutex_init(&result->mutex, NULL);
+        pthread_cond_init(&result->condition, NULL);
+        result->threadStarted = false;
+        result->isCancelled = false;
+        result->pool = (pool != NULL) ? parcThreadPool_Acquire(pool) : NULL;
+        result->clock = parcClock_Monotonic();
+        result->currentTick = parcClock_GetTime(result->clock);
+        result->scheduledCount = 0;
+        result->pooledRuns = 0;
+        result->freeList = NULL;
+
+        pthread_once(&_parcTimer_PooledRunKeyOnce, _parcTimer_CreatePooledRunKey);
+
+        for (int level = 0; level < _PARCTimer_WheelLevels; level++) {
+            for (size_t slot = 0; slot < _PARCTimer_WheelSlots; slot++) {
+                _parcTimerEntry_InitList(&result->wheel[level][slot]);
+            }
+        }
     }
 
     return result;
 }
 
+PARCTimer *
+parcTimer_Create(void)
+{
+    return parcTimer_CreateWithThreadPool(NULL);
+}
+
 int
 parcTimer_Compare(const PARCTimer *instance, const PARCTimer *other)
 {
@@ -113,7 +603,7 @@ parcTimer_Compare(const PARCTimer *instance, const PARCTimer *other)
 PARCTimer *
 parcTimer_Copy(const PARCTimer *original)
 {
-    PARCTimer *result = parcTimer_Create();
+    PARCTimer *result = parcTimer_CreateWithThreadPool(original->pool);
 
     return result;
 }
@@ -122,7 +612,9 @@ void
 parcTimer_Display(const PARCTimer *instance, int indentation)
 {
     parcDisplayIndented_PrintLine(indentation, "PARCTimer@%p {", instance);
-    /* Call Display() functions for the fields here. */
+    parcDisplayIndented_PrintLine(indentation + 1, ".pool=%p", instance->pool);
+    parcDisplayIndented_PrintLine(indentation + 1, ".scheduledCount=%zu", parcTimer_GetScheduledCount(instance));
+    parcDisplayIndented_PrintLine(indentation + 1, ".isCancelled=%s", instance->isCancelled ? "true" : "false");
     parcDisplayIndented_PrintLine(indentation, "}");
 }
 
@@ -136,7 +628,7 @@ parcTimer_Equals(const PARCTimer *x, const PARCTimer *y)
     } else if (x == NULL || y == NULL) {
         result = false;
     } else {
-        return true;
+        result = (x->pool == y->pool);
     }
 
     return result;
@@ -168,6 +660,8 @@ parcTimer_ToJSON(const PARCTimer *instance)
     PARCJSON *result = parcJSON_Create();
 
     if (result != NULL) {
+        parcJSON_AddInteger(result, "scheduledCount", (int64_t) parcTimer_GetScheduledCount(instance));
+        parcJSON_AddBoolean(result, "isCancelled", instance->isCancelled);
     }
 
     return result;
@@ -184,31 +678,115 @@ parcTimer_ToString(const PARCTimer *instance)
 void
 parcTimer_Cancel(PARCTimer *timer)
 {
+    _parcTimer_Stop(timer);
 }
 
 int
 parcTimer_Purge(PARCTimer *timer)
 {
-    return 0;
+    int result = 0;
+
+    pthread_mutex_lock(&timer->mutex);
+    for (int level = 0; level < _PARCTimer_WheelLevels; level++) {
+        for (size_t slot = 0; slot < _PARCTimer_WheelSlots; slot++) {
+            _PARCTimerEntry *head = &timer->wheel[level][slot];
+            _PARCTimerEntry *entry = head->next;
+            while (entry != head) {
+                _PARCTimerEntry *next = entry->next;
+                if (parcFutureTask_IsCancelled(entry->task)) {
+                    _parcTimerEntry_Unlink(entry);
+                    timer->scheduledCount--;
+                    parcFutureTask_Release(&entry->task);
+                    _parcTimer_FreeEntry(timer, entry);
+                    result++;
+                }
+                entry = next;
+            }
+        }
+    }
+    pthread_mutex_unlock(&timer->mutex);
+
+    return result;
+}
+
+size_t
+parcTimer_GetScheduledCount(const PARCTimer *timer)
+{
+    PARCTimer *mutableTimer = (PARCTimer *) timer;
+
+    pthread_mutex_lock(&mutableTimer->mutex);
+    size_t result = timer->scheduledCount;
+    pthread_mutex_unlock(&mutableTimer->mutex);
+
+    return result;
+}
+
+static void
+_parcTimer_Schedule(PARCTimer *timer, PARCFutureTask *task, long delay, long period)
+{
+    parcTimer_OptionalAssertValid(timer);
+    parcFutureTask_OptionalAssertValid(task);
+    assertTrue(period >= 0, "The period must be non-negative: %ld", period);
+
+    pthread_mutex_lock(&timer->mutex);
+
+    trapUnexpectedStateIf(timer->isCancelled, "PARCTimer@%p has been cancelled.", (void *) timer);
+
+    if (timer->threadStarted == false) {
+        int failure = pthread_create(&timer->thread, NULL, (void *(*)(void *)) _parcTimer_Run, timer);
+        assertFalse(failure, "pthread_create failed: %d", failure);
+        timer->threadStarted = true;
+    }
+
+    uint64_t now = parcClock_GetTime(timer->clock);
+    if (timer->scheduledCount == 0 && timer->currentTick < now) {
+        // The wheel is empty and the background thread may have been idle for a long time.
+        timer->currentTick = now;
+    }
+
+    _PARCTimerEntry *entry = _parcTimer_AllocateEntry(timer);
+    entry->expiration = now + ((delay > 0) ? (uint64_t) delay : 0);
+    entry->period = (uint64_t) period;
+    entry->task = parcFutureTask_Acquire(task);
+    _parcTimer_Place(timer, entry);
+    timer->scheduledCount++;
+
+    // Only wake the background thread when the new task may expire before the thread's current deadline.
+    if (entry->expiration < timer->currentTick + _PARCTimer_WheelSlots || timer->scheduledCount == 1) {
+        pthread_cond_signal(&timer->condition);
+    }
+
+    pthread_mutex_unlock(&timer->mutex);
+}
+
+static long
+_parcTimer_DelayUntil(time_t absoluteTime)
+{
+    time_t now = time(NULL);
+
+    return (absoluteTime > now) ? (long) (absoluteTime - now) * 1000 : 0;
 }
 
 void
 parcTimer_ScheduleAtTime(PARCTimer *timer, PARCFutureTask *task, time_t absoluteTime)
 {
+    _parcTimer_Schedule(timer, task, _parcTimer_DelayUntil(absoluteTime), 0);
 }
 
 void
 parcTimer_ScheduleAtTimeAndRepeat(PARCTimer *timer, PARCFutureTask *task, time_t firstTime, long period)
 {
+    _parcTimer_Schedule(timer, task, _parcTimer_DelayUntil(firstTime), period);
 }
 
 void
 parcTimer_ScheduleAfterDelay(PARCTimer *timer, PARCFutureTask *task, long delay)
 {
+    _parcTimer_Schedule(timer, task, delay, 0);
 }
 
 void
 parcTimer_ScheduleAfterDelayAndRepeat(PARCTimer *timer, PARCFutureTask *task, long delay, long period)
 {
+    _parcTimer_Schedule(timer, task, delay, period);
 }
-
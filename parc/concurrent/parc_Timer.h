@@ -81,6 +81,12 @@
  *
  * This class does not offer real-time guarantees: it schedules tasks using the Object.wait(long) method.
  *
+ * Scheduled tasks are kept in a hierarchical timing wheel with a resolution of one millisecond
+ * (four levels of 256 slots each), so scheduling a task and cancelling it (via `parcFutureTask_Cancel`)
+ * are constant-time operations regardless of the number of outstanding tasks.
+ * A timer created with `parcTimer_CreateWithThreadPool` hands expired tasks to the given `PARCThreadPool`
+ * instead of running them on its own background thread.
+ *
  * @author Glenn Scott, Computing Science Laboratory, PARC
  * @copyright (c) 2013-2015, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
  */
@@ -91,6 +97,7 @@
 #include <parc/algol/parc_JSON.h>
 #include <parc/algol/parc_HashCode.h>
 #include <parc/concurrent/parc_FutureTask.h>
+#include <parc/concurrent/parc_ThreadPool.h>
 
 struct PARCTimer;
 typedef struct PARCTimer PARCTimer;
@@ -149,7 +156,8 @@ void parcTimer_AssertValid(const PARCTimer *instance);
 /**
  * Create an instance of PARCTimer
  *
- * <#Paragraphs Of Explanation#>
+ * Expired tasks are run sequentially on the timer's own background thread,
+ * which is started when the first task is scheduled.
  *
  * @return non-NULL A pointer to a valid PARCTimer instance.
  * @return NULL An error occurred.
@@ -165,6 +173,31 @@ void parcTimer_AssertValid(const PARCTimer *instance);
  */
 PARCTimer *parcTimer_Create(void);
 
+/**
+ * Create an instance of PARCTimer that dispatches expired tasks to the given `PARCThreadPool`.
+ *
+ * The timer's background thread only tracks expirations and hands each expired task to
+ * `parcThreadPool_Execute`, so long-running tasks do not delay the expiration of other tasks.
+ *
+ * @param [in] pool A pointer to a valid PARCThreadPool instance. A reference is acquired.
+ *
+ * @return non-NULL A pointer to a valid PARCTimer instance.
+ * @return NULL An error occurred.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCThreadPool *pool = parcThreadPool_Create(4);
+ *     PARCTimer *a = parcTimer_CreateWithThreadPool(pool);
+ *
+ *     parcTimer_Release(&a);
+ *     parcThreadPool_ShutdownNow(pool);
+ *     parcThreadPool_Release(&pool);
+ * }
+ * @endcode
+ */
+PARCTimer *parcTimer_CreateWithThreadPool(PARCThreadPool *pool);
+
 /**
  * Compares @p instance with @p other for order.
  *
@@ -450,23 +483,71 @@ void parcTimer_Cancel(PARCTimer *timer);
  */
 int parcTimer_Purge(PARCTimer *timer);
 
+/**
+ * Get the number of tasks currently scheduled on this timer.
+ *
+ * Cancelled tasks are counted until they expire or are removed by `parcTimer_Purge`.
+ *
+ * @param [in] timer A pointer to a valid PARCTimer instance.
+ *
+ * @return The number of scheduled tasks.
+ */
+size_t parcTimer_GetScheduledCount(const PARCTimer *timer);
+
 /**
  * Schedules the specified task for execution at the specified time.
+ *
+ * @param [in] timer A pointer to a valid PARCTimer instance.
+ * @param [in] task A pointer to a valid PARCFutureTask instance. A reference is acquired.
+ * @param [in] absoluteTime The time, in seconds since the Epoch, at which the task is to be executed.
  */
 void parcTimer_ScheduleAtTime(PARCTimer *timer, PARCFutureTask *task, time_t absoluteTime);
 
 /**
  * Schedules the specified task for repeated fixed-delay execution, beginning at the specified time.
+ *
+ * @param [in] timer A pointer to a valid PARCTimer instance.
+ * @param [in] task A pointer to a valid PARCFutureTask instance. A reference is acquired.
+ * @param [in] firstTime The time, in seconds since the Epoch, at which the task is first executed.
+ * @param [in] period The time in milliseconds between successive executions.
  */
 void parcTimer_ScheduleAtTimeAndRepeat(PARCTimer *timer, PARCFutureTask *task, time_t firstTime, long period);
 
 /**
  * Schedules the specified task for execution after the specified delay.
+ *
+ * @param [in] timer A pointer to a valid PARCTimer instance.
+ * @param [in] task A pointer to a valid PARCFutureTask instance. A reference is acquired.
+ * @param [in] delay The delay in milliseconds before the task is executed.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCTimer *timer = parcTimer_Create();
+ *     PARCFutureTask *task = parcFutureTask_Create(function, parameter);
+ *
+ *     parcTimer_ScheduleAfterDelay(timer, task, 100);
+ *
+ *     // Changed our mind; the task will be discarded when it expires or when the timer is purged.
+ *     parcFutureTask_Cancel(task, false);
+ *
+ *     parcFutureTask_Release(&task);
+ *     parcTimer_Release(&timer);
+ * }
+ * @endcode
  */
 void parcTimer_ScheduleAfterDelay(PARCTimer *timer, PARCFutureTask *task, long delay);
 
 /**
  * Schedules the specified task for repeated fixed-delay execution, beginning after the specified delay.
+ *
+ * The delay before each subsequent execution is measured from the end of the previous one,
+ * whether the task runs on the timer's own thread or on a `PARCThreadPool`, so runs of the task never overlap.
+ *
+ * @param [in] timer A pointer to a valid PARCTimer instance.
+ * @param [in] task A pointer to a valid PARCFutureTask instance. A reference is acquired.
+ * @param [in] delay The delay in milliseconds before the task is first executed.
+ * @param [in] period The time in milliseconds between successive executions.
  */
 void parcTimer_ScheduleAfterDelayAndRepeat(PARCTimer *timer, PARCFutureTask *task, long delay, long period);
 #endif
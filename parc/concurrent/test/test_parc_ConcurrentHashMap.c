@@ -0,0 +1,673 @@
+/*
+ * Copyright (c) 2015, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @author Glenn Scott, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include "../parc_ConcurrentHashMap.c"
+
+#include <stdio.h>
+#include <pthread.h>
+#include <sys/time.h>
+
+#include <LongBow/testing.h>
+#include <LongBow/debugging.h>
+#include <parc/algol/parc_Memory.h>
+#include <parc/algol/parc_SafeMemory.h>
+#include <parc/algol/parc_StdlibMemory.h>
+#include <parc/algol/parc_Buffer.h>
+#include <parc/algol/parc_HashMap.h>
+
+#include <parc/testing/parc_MemoryTesting.h>
+#include <parc/testing/parc_ObjectTesting.h>
+
+LONGBOW_TEST_RUNNER(parc_ConcurrentHashMap)
+{
+    // The following Test Fixtures will run their corresponding Test Cases.
+    // Test Fixtures are run in the order specified, but all tests should be idempotent.
+    // Never rely on the execution order of tests or share state between them.
+    LONGBOW_RUN_TEST_FIXTURE(CreateAcquireRelease);
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+    LONGBOW_RUN_TEST_FIXTURE(Concurrent);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
+}
+
+// The Test Runner calls this function once before any Test Fixtures are run.
+LONGBOW_TEST_RUNNER_SETUP(parc_ConcurrentHashMap)
+{
+    parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// The Test Runner calls this function once after all the Test Fixtures are run.
+LONGBOW_TEST_RUNNER_TEARDOWN(parc_ConcurrentHashMap)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+static PARCBuffer *
+_createKey(uint64_t value)
+{
+    return parcBuffer_Flip(parcBuffer_PutUint64(parcBuffer_Allocate(sizeof(uint64_t)), value));
+}
+
+LONGBOW_TEST_FIXTURE(CreateAcquireRelease)
+{
+    LONGBOW_RUN_TEST_CASE(CreateAcquireRelease, CreateRelease);
+    LONGBOW_RUN_TEST_CASE(CreateAcquireRelease, CreateCapacity);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(CreateAcquireRelease)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(CreateAcquireRelease)
+{
+    if (!parcMemoryTesting_ExpectedOutstanding(0, "%s leaked memory.", longBowTestCase_GetFullName(testCase))) {
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(CreateAcquireRelease, CreateRelease)
+{
+    PARCConcurrentHashMap *instance = parcConcurrentHashMap_Create();
+    assertNotNull(instance, "Expected non-null result from parcConcurrentHashMap_Create().");
+
+    parcObjectTesting_AssertAcquireReleaseContract(parcConcurrentHashMap_Acquire, instance);
+
+    parcConcurrentHashMap_Release(&instance);
+    assertNull(instance, "Expected null result from parcConcurrentHashMap_Release().");
+}
+
+LONGBOW_TEST_CASE(CreateAcquireRelease, CreateCapacity)
+{
+    PARCConcurrentHashMap *instance = parcConcurrentHashMap_CreateCapacity(10000);
+    assertNotNull(instance, "Expected non-null result from parcConcurrentHashMap_CreateCapacity().");
+    assertTrue(instance->table->bucketCount * _parcConcurrentHashMap_MaxLoadFactor >= 10000,
+               "Expected room for 10000 mappings, actual %zu buckets", instance->table->bucketCount);
+
+    parcConcurrentHashMap_Release(&instance);
+}
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, parcConcurrentHashMap_Put_Get);
+    LONGBOW_RUN_TEST_CASE(Global, parcConcurrentHashMap_Put_Replace);
+    LONGBOW_RUN_TEST_CASE(Global, parcConcurrentHashMap_Get_Missing);
+    LONGBOW_RUN_TEST_CASE(Global, parcConcurrentHashMap_Contains);
+    LONGBOW_RUN_TEST_CASE(Global, parcConcurrentHashMap_Remove);
+    LONGBOW_RUN_TEST_CASE(Global, parcConcurrentHashMap_Remove_Missing);
+    LONGBOW_RUN_TEST_CASE(Global, parcConcurrentHashMap_Grow);
+    LONGBOW_RUN_TEST_CASE(Global, parcConcurrentHashMap_Reclaim);
+    LONGBOW_RUN_TEST_CASE(Global, parcConcurrentHashMap_Copy);
+    LONGBOW_RUN_TEST_CASE(Global, parcConcurrentHashMap_Equals);
+    LONGBOW_RUN_TEST_CASE(Global, parcConcurrentHashMap_HashCode);
+    LONGBOW_RUN_TEST_CASE(Global, parcConcurrentHashMap_Display);
+    LONGBOW_RUN_TEST_CASE(Global, parcConcurrentHashMap_IsValid);
+    LONGBOW_RUN_TEST_CASE(Global, parcConcurrentHashMap_ToString);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    if (!parcMemoryTesting_ExpectedOutstanding(0, "%s mismanaged memory.", longBowTestCase_GetFullName(testCase))) {
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Global, parcConcurrentHashMap_Put_Get)
+{
+    PARCConcurrentHashMap *instance = parcConcurrentHashMap_Create();
+
+    PARCBuffer *key = parcBuffer_WrapCString("key1");
+    PARCBuffer *value = parcBuffer_WrapCString("value1");
+
+    parcConcurrentHashMap_Put(instance, key, value);
+    assertTrue(parcConcurrentHashMap_Size(instance) == 1, "Expected size 1, actual %zu", parcConcurrentHashMap_Size(instance));
+
+    PARCBuffer *equalKey = parcBuffer_WrapCString("key1");
+    PARCBuffer *actual = parcConcurrentHashMap_Get(instance, equalKey);
+    assertTrue(actual == value, "Expected the same value that was put.");
+    parcBuffer_Release(&actual);
+
+    parcBuffer_Release(&equalKey);
+    parcBuffer_Release(&key);
+    parcBuffer_Release(&value);
+    parcConcurrentHashMap_Release(&instance);
+}
+
+LONGBOW_TEST_CASE(Global, parcConcurrentHashMap_Put_Replace)
+{
+    PARCConcurrentHashMap *instance = parcConcurrentHashMap_Create();
+
+    PARCBuffer *key = parcBuffer_WrapCString("key1");
+    PARCBuffer *value1 = parcBuffer_WrapCString("value1");
+    PARCBuffer *value2 = parcBuffer_WrapCString("value2");
+
+    parcConcurrentHashMap_Put(instance, key, value1);
+    parcConcurrentHashMap_Put(instance, key, value2);
+    assertTrue(parcConcurrentHashMap_Size(instance) == 1, "Expected size 1, actual %zu", parcConcurrentHashMap_Size(instance));
+
+    PARCBuffer *actual = parcConcurrentHashMap_Get(instance, key);
+    assertTrue(actual == value2, "Expected the replacement value.");
+    parcBuffer_Release(&actual);
+
+    parcBuffer_Release(&key);
+    parcBuffer_Release(&value1);
+    parcBuffer_Release(&value2);
+    parcConcurrentHashMap_Release(&instance);
+}
+
+LONGBOW_TEST_CASE(Global, parcConcurrentHashMap_Get_Missing)
+{
+    PARCConcurrentHashMap *instance = parcConcurrentHashMap_Create();
+
+    PARCBuffer *key = parcBuffer_WrapCString("key1");
+    PARCObject *actual = parcConcurrentHashMap_Get(instance, key);
+    assertNull(actual, "Expected NULL for a key that is not mapped.");
+
+    parcBuffer_Release(&key);
+    parcConcurrentHashMap_Release(&instance);
+}
+
+LONGBOW_TEST_CASE(Global, parcConcurrentHashMap_Contains)
+{
+    PARCConcurrentHashMap *instance = parcConcurrentHashMap_Create();
+
+    PARCBuffer *key = parcBuffer_WrapCString("key1");
+    PARCBuffer *otherKey = parcBuffer_WrapCString("key2");
+    parcConcurrentHashMap_Put(instance, key, key);
+
+    assertTrue(parcConcurrentHashMap_Contains(instance, key), "Expected the map to contain the key.");
+    assertFalse(parcConcurrentHashMap_Contains(instance, otherKey), "Expected the map not to contain the other key.");
+
+    parcBuffer_Release(&key);
+    parcBuffer_Release(&otherKey);
+    parcConcurrentHashMap_Release(&instance);
+}
+
+LONGBOW_TEST_CASE(Global, parcConcurrentHashMap_Remove)
+{
+    PARCConcurrentHashMap *instance = parcConcurrentHashMap_Create();
+
+    PARCBuffer *key = parcBuffer_WrapCString("key1");
+    PARCBuffer *value = parcBuffer_WrapCString("value1");
+    parcConcurrentHashMap_Put(instance, key, value);
+
+    assertTrue(parcConcurrentHashMap_Remove(instance, key), "Expected parcConcurrentHashMap_Remove to return true.");
+    assertFalse(parcConcurrentHashMap_Contains(instance, key), "Expected the key to be removed.");
+    assertTrue(parcConcurrentHashMap_Size(instance) == 0, "Expected size 0, actual %zu", parcConcurrentHashMap_Size(instance));
+
+    parcBuffer_Release(&key);
+    parcBuffer_Release(&value);
+    parcConcurrentHashMap_Release(&instance);
+}
+
+LONGBOW_TEST_CASE(Global, parcConcurrentHashMap_Remove_Missing)
+{
+    PARCConcurrentHashMap *instance = parcConcurrentHashMap_Create();
+
+    PARCBuffer *key = parcBuffer_WrapCString("key1");
+    assertFalse(parcConcurrentHashMap_Remove(instance, key), "Expected parcConcurrentHashMap_Remove to return false.");
+
+    parcBuffer_Release(&key);
+    parcConcurrentHashMap_Release(&instance);
+}
+
+LONGBOW_TEST_CASE(Global, parcConcurrentHashMap_Grow)
+{
+    PARCConcurrentHashMap *instance = parcConcurrentHashMap_Create();
+    size_t initialBuckets = instance->table->bucketCount;
+
+    const uint64_t count = 1000;
+    for (uint64_t i = 0; i < count; i++) {
+        PARCBuffer *key = _createKey(i);
+        parcConcurrentHashMap_Put(instance, key, key);
+        parcBuffer_Release(&key);
+    }
+
+    assertTrue(instance->table->bucketCount > initialBuckets, "Expected the table to grow beyond %zu buckets", initialBuckets);
+    assertTrue(parcConcurrentHashMap_Size(instance) == count, "Expected size %" PRIu64 ", actual %zu", count, parcConcurrentHashMap_Size(instance));
+
+    for (uint64_t i = 0; i < count; i++) {
+        PARCBuffer *key = _createKey(i);
+        PARCBuffer *value = parcConcurrentHashMap_Get(instance, key);
+        assertTrue(parcBuffer_Equals(key, value), "Expected the value for key %" PRIu64, i);
+        parcBuffer_Release(&value);
+        parcBuffer_Release(&key);
+    }
+
+    parcConcurrentHashMap_Release(&instance);
+}
+
+LONGBOW_TEST_CASE(Global, parcConcurrentHashMap_Reclaim)
+{
+    PARCConcurrentHashMap *instance = parcConcurrentHashMap_Create();
+
+    PARCBuffer *key = _createKey(1);
+    for (uint64_t i = 0; i < 10000; i++) {
+        PARCBuffer *value = _createKey(i);
+        parcConcurrentHashMap_Put(instance, key, value);
+        parcBuffer_Release(&value);
+    }
+
+    assertTrue(instance->retiredCount < 2 * _parcConcurrentHashMap_ReclaimThreshold,
+               "Expected retired entries to be reclaimed, %zu remain", instance->retiredCount);
+
+    parcBuffer_Release(&key);
+    parcConcurrentHashMap_Release(&instance);
+}
+
+LONGBOW_TEST_CASE(Global, parcConcurrentHashMap_Copy)
+{
+    PARCConcurrentHashMap *instance = parcConcurrentHashMap_Create();
+    for (uint64_t i = 0; i < 100; i++) {
+        PARCBuffer *key = _createKey(i);
+        parcConcurrentHashMap_Put(instance, key, key);
+        parcBuffer_Release(&key);
+    }
+
+    PARCConcurrentHashMap *copy = parcConcurrentHashMap_Copy(instance);
+    assertTrue(parcConcurrentHashMap_Equals(instance, copy), "Expected the copy to be equal to the original");
+
+    parcConcurrentHashMap_Release(&instance);
+    parcConcurrentHashMap_Release(&copy);
+}
+
+LONGBOW_TEST_CASE(Global, parcConcurrentHashMap_Equals)
+{
+    PARCBuffer *key1 = parcBuffer_WrapCString("key1");
+    PARCBuffer *key2 = parcBuffer_WrapCString("key2");
+    PARCBuffer *value1 = parcBuffer_WrapCString("value1");
+    PARCBuffer *value2 = parcBuffer_WrapCString("value2");
+
+    PARCConcurrentHashMap *x = parcConcurrentHashMap_Create();
+    parcConcurrentHashMap_Put(x, key1, value1);
+    parcConcurrentHashMap_Put(x, key2, value2);
+    PARCConcurrentHashMap *y = parcConcurrentHashMap_Create();
+    parcConcurrentHashMap_Put(y, key2, value2);
+    parcConcurrentHashMap_Put(y, key1, value1);
+    PARCConcurrentHashMap *z = parcConcurrentHashMap_CreateCapacity(1000);
+    parcConcurrentHashMap_Put(z, key1, value1);
+    parcConcurrentHashMap_Put(z, key2, value2);
+
+    PARCConcurrentHashMap *u1 = parcConcurrentHashMap_Create();
+    parcConcurrentHashMap_Put(u1, key1, value1);
+    PARCConcurrentHashMap *u2 = parcConcurrentHashMap_Create();
+    parcConcurrentHashMap_Put(u2, key1, value2);
+    parcConcurrentHashMap_Put(u2, key2, value1);
+
+    parcObjectTesting_AssertEqualsFunction(parcConcurrentHashMap_Equals, x, y, z, u1, u2, NULL);
+
+    parcConcurrentHashMap_Release(&x);
+    parcConcurrentHashMap_Release(&y);
+    parcConcurrentHashMap_Release(&z);
+    parcConcurrentHashMap_Release(&u1);
+    parcConcurrentHashMap_Release(&u2);
+
+    parcBuffer_Release(&key1);
+    parcBuffer_Release(&key2);
+    parcBuffer_Release(&value1);
+    parcBuffer_Release(&value2);
+}
+
+LONGBOW_TEST_CASE(Global, parcConcurrentHashMap_HashCode)
+{
+    PARCBuffer *key1 = parcBuffer_WrapCString("key1");
+    PARCBuffer *key2 = parcBuffer_WrapCString("key2");
+
+    PARCConcurrentHashMap *x = parcConcurrentHashMap_Create();
+    parcConcurrentHashMap_Put(x, key1, key1);
+    parcConcurrentHashMap_Put(x, key2, key2);
+    PARCConcurrentHashMap *y = parcConcurrentHashMap_CreateCapacity(1000);
+    parcConcurrentHashMap_Put(y, key2, key2);
+    parcConcurrentHashMap_Put(y, key1, key1);
+
+    assertTrue(parcConcurrentHashMap_HashCode(x) == parcConcurrentHashMap_HashCode(y),
+               "Expected equal maps to have equal hash codes.");
+
+    parcConcurrentHashMap_Release(&x);
+    parcConcurrentHashMap_Release(&y);
+    parcBuffer_Release(&key1);
+    parcBuffer_Release(&key2);
+}
+
+LONGBOW_TEST_CASE(Global, parcConcurrentHashMap_Display)
+{
+    PARCConcurrentHashMap *instance = parcConcurrentHashMap_Create();
+    PARCBuffer *key = parcBuffer_WrapCString("key1");
+    parcConcurrentHashMap_Put(instance, key, key);
+
+    parcConcurrentHashMap_Display(instance, 0);
+
+    parcBuffer_Release(&key);
+    parcConcurrentHashMap_Release(&instance);
+}
+
+LONGBOW_TEST_CASE(Global, parcConcurrentHashMap_IsValid)
+{
+    PARCConcurrentHashMap *instance = parcConcurrentHashMap_Create();
+    assertTrue(parcConcurrentHashMap_IsValid(instance), "Expected parcConcurrentHashMap_Create to result in a valid instance.");
+
+    parcConcurrentHashMap_Release(&instance);
+    assertFalse(parcConcurrentHashMap_IsValid(instance), "Expected parcConcurrentHashMap_Release to result in an invalid instance.");
+}
+
+LONGBOW_TEST_CASE(Global, parcConcurrentHashMap_ToString)
+{
+    PARCConcurrentHashMap *instance = parcConcurrentHashMap_Create();
+
+    char *string = parcConcurrentHashMap_ToString(instance);
+    assertNotNull(string, "Expected non-NULL result from parcConcurrentHashMap_ToString");
+
+    parcMemory_Deallocate(&string);
+    parcConcurrentHashMap_Release(&instance);
+}
+
+typedef struct {
+    PARCConcurrentHashMap *map;
+    uint64_t keyCount;
+    uint64_t iterations;
+    unsigned int seed;
+    uint64_t found;
+} _ConcurrentTestData;
+
+static void *
+_concurrentReader(void *arg)
+{
+    _ConcurrentTestData *data = arg;
+
+    PARCBuffer **keys = parcMemory_Allocate(data->keyCount * sizeof(PARCBuffer *));
+    for (uint64_t i = 0; i < data->keyCount; i++) {
+        keys[i] = _createKey(i);
+    }
+
+    for (uint64_t i = 0; i < data->iterations; i++) {
+        PARCBuffer *key = keys[rand_r(&data->seed) % data->keyCount];
+        PARCBuffer *value = parcConcurrentHashMap_Get(data->map, key);
+        if (value != NULL) {
+            assertTrue(parcBuffer_Equals(key, value), "Expected every value to equal its key.");
+            parcBuffer_Release(&value);
+            data->found++;
+        }
+    }
+
+    for (uint64_t i = 0; i < data->keyCount; i++) {
+        parcBuffer_Release(&keys[i]);
+    }
+    parcMemory_Deallocate(&keys);
+
+    return NULL;
+}
+
+static void *
+_concurrentWriter(void *arg)
+{
+    _ConcurrentTestData *data = arg;
+
+    for (uint64_t i = 0; i < data->iterations; i++) {
+        PARCBuffer *key = _createKey(rand_r(&data->seed) % data->keyCount);
+        if (rand_r(&data->seed) & 1) {
+            PARCBuffer *value = parcBuffer_Copy(key);
+            parcConcurrentHashMap_Put(data->map, key, value);
+            parcBuffer_Release(&value);
+        } else {
+            parcConcurrentHashMap_Remove(data->map, key);
+        }
+        parcBuffer_Release(&key);
+    }
+
+    return NULL;
+}
+
+LONGBOW_TEST_FIXTURE(Concurrent)
+{
+    LONGBOW_RUN_TEST_CASE(Concurrent, ReadersAndWriters);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Concurrent)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Concurrent)
+{
+    if (!parcMemoryTesting_ExpectedOutstanding(0, "%s mismanaged memory.", longBowTestCase_GetFullName(testCase))) {
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Concurrent, ReadersAndWriters)
+{
+    PARCConcurrentHashMap *map = parcConcurrentHashMap_Create();
+
+    const int readerCount = 4;
+    const int writerCount = 2;
+    pthread_t threads[readerCount + writerCount];
+    _ConcurrentTestData data[readerCount + writerCount];
+
+    for (int i = 0; i < readerCount + writerCount; i++) {
+        data[i] = (_ConcurrentTestData) {
+            .map = map, .keyCount = 500, .iterations = 20000, .seed = i + 1, .found = 0
+        };
+        pthread_create(&threads[i], NULL, (i < readerCount) ? _concurrentReader : _concurrentWriter, &data[i]);
+    }
+    for (int i = 0; i < readerCount + writerCount; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    size_t expected = 0;
+    for (uint64_t i = 0; i < 500; i++) {
+        PARCBuffer *key = _createKey(i);
+        if (parcConcurrentHashMap_Contains(map, key)) {
+            expected++;
+        }
+        parcBuffer_Release(&key);
+    }
+    assertTrue(parcConcurrentHashMap_Size(map) == expected,
+               "Expected size %zu, actual %zu", expected, parcConcurrentHashMap_Size(map));
+
+    parcConcurrentHashMap_Release(&map);
+}
+
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, parcHashMap_Locked_Get);
+    LONGBOW_RUN_TEST_CASE(Performance, parcConcurrentHashMap_Get);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    parcMemory_SetInterface(&PARCStdlibMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+#define PERFORMANCE_KEYS 100000
+#define PERFORMANCE_GETS 500000
+
+typedef struct {
+    PARCObject *map;
+    PARCBuffer **keys;
+    unsigned int seed;
+} _PerformanceData;
+
+static void *
+_lockedHashMapReader(void *arg)
+{
+    _PerformanceData *data = arg;
+
+    for (int i = 0; i < PERFORMANCE_GETS; i++) {
+        PARCBuffer *key = data->keys[rand_r(&data->seed) % PERFORMANCE_KEYS];
+        parcObject_Lock(data->map);
+        const PARCObject *value = parcHashMap_Get(data->map, key);
+        parcObject_Unlock(data->map);
+        assertNotNull(value, "Expected every key to be mapped.");
+    }
+    return NULL;
+}
+
+static void *
+_concurrentHashMapReader(void *arg)
+{
+    _PerformanceData *data = arg;
+
+    for (int i = 0; i < PERFORMANCE_GETS; i++) {
+        PARCBuffer *key = data->keys[rand_r(&data->seed) % PERFORMANCE_KEYS];
+        PARCObject *value = parcConcurrentHashMap_Get(data->map, key);
+        assertNotNull(value, "Expected every key to be mapped.");
+        parcObject_Release(&value);
+    }
+    return NULL;
+}
+
+static void
+_performance_Readers(const char *name, PARCObject *map, PARCBuffer **keys, void *(*reader)(void *))
+{
+    for (int readerCount = 1; readerCount <= 8; readerCount *= 2) {
+        pthread_t threads[readerCount];
+        _PerformanceData data[readerCount];
+
+        struct timeval start, end, elapsed;
+        gettimeofday(&start, NULL);
+        for (int i = 0; i < readerCount; i++) {
+            data[i] = (_PerformanceData) { .map = map, .keys = keys, .seed = i + 1 };
+            pthread_create(&threads[i], NULL, reader, &data[i]);
+        }
+        for (int i = 0; i < readerCount; i++) {
+            pthread_join(threads[i], NULL);
+        }
+        gettimeofday(&end, NULL);
+        timersub(&end, &start, &elapsed);
+
+        double seconds = elapsed.tv_sec + elapsed.tv_usec / 1000000.0;
+        printf("%s: %d readers, %d Gets each in %ld.%06ld seconds (%.0f Gets/second)\n", name, readerCount, PERFORMANCE_GETS,
+               (long) elapsed.tv_sec, (long) elapsed.tv_usec, (readerCount * (double) PERFORMANCE_GETS) / seconds);
+    }
+}
+
+static PARCBuffer **
+_performance_CreateKeys(void)
+{
+    PARCBuffer **keys = parcMemory_Allocate(PERFORMANCE_KEYS * sizeof(PARCBuffer *));
+    for (int i = 0; i < PERFORMANCE_KEYS; i++) {
+        keys[i] = _createKey(i);
+    }
+    return keys;
+}
+
+static void
+_performance_ReleaseKeys(PARCBuffer ***keysPtr)
+{
+    PARCBuffer **keys = *keysPtr;
+    for (int i = 0; i < PERFORMANCE_KEYS; i++) {
+        parcBuffer_Release(&keys[i]);
+    }
+    parcMemory_Deallocate(keysPtr);
+}
+
+LONGBOW_TEST_CASE(Performance, parcHashMap_Locked_Get)
+{
+    PARCBuffer **keys = _performance_CreateKeys();
+
+    PARCHashMap *map = parcHashMap_Create();
+    for (int i = 0; i < PERFORMANCE_KEYS; i++) {
+        parcHashMap_Put(map, keys[i], keys[i]);
+    }
+
+    _performance_Readers("PARCHashMap with parcObject_Lock", map, keys, _lockedHashMapReader);
+
+    parcHashMap_Release(&map);
+    _performance_ReleaseKeys(&keys);
+}
+
+LONGBOW_TEST_CASE(Performance, parcConcurrentHashMap_Get)
+{
+    PARCBuffer **keys = _performance_CreateKeys();
+
+    PARCConcurrentHashMap *map = parcConcurrentHashMap_Create();
+    for (int i = 0; i < PERFORMANCE_KEYS; i++) {
+        parcConcurrentHashMap_Put(map, keys[i], keys[i]);
+    }
+
+    _performance_Readers("PARCConcurrentHashMap", map, keys, _concurrentHashMapReader);
+
+    parcConcurrentHashMap_Release(&map);
+    _performance_ReleaseKeys(&keys);
+}
+
+int
+main(int argc, char *argv[argc])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(parc_ConcurrentHashMap);
+    int exitStatus = longBowMain(argc, argv, testRunner, NULL);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2014, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+// Include the file(s) containing the functions to be tested.
+// This permits internal static functions to be visible to this Test Framework.
+#include "../parc_RingBuffer.c"
+
+#include <parc/algol/parc_Buffer.h>
+#include <parc/algol/parc_SafeMemory.h>
+#include <LongBow/unit-test.h>
+
+LONGBOW_TEST_RUNNER(parc_RingBuffer)
+{
+    // The following Test Fixtures will run their corresponding Test Cases.
+    // Test Fixtures are run in the order specified, but all tests should be idempotent.
+    // Never rely on the execution order of tests or share state between them.
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+}
+
+// The Test Runner calls this function once before any Test Fixtures are run.
+LONGBOW_TEST_RUNNER_SETUP(parc_RingBuffer)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// The Test Runner calls this function once after all the Test Fixtures are run.
+LONGBOW_TEST_RUNNER_TEARDOWN(parc_RingBuffer)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, parcRingBuffer_CreateMultipleProducerMultipleConsumer);
+    LONGBOW_RUN_TEST_CASE(Global, parcRingBuffer_CreateSingleProducerSingleConsumer);
+    LONGBOW_RUN_TEST_CASE(Global, parcRingBuffer_Release_Destroyer);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    uint32_t outstandingAllocations = parcSafeMemory_ReportAllocation(STDERR_FILENO);
+    if (outstandingAllocations != 0) {
+        printf("Tests leak memory by %d allocations\n", outstandingAllocations);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+/*
+ * Exercise a facade the same way regardless of the ring behind it.
+ */
+static void
+_assertRingBehaviour(PARCRingBuffer *ring, uint32_t capacity)
+{
+    assertTrue(parcRingBuffer_Remaining(ring) == capacity - 1, "Got wrong remaining, got %u expecting %u",
+               parcRingBuffer_Remaining(ring), capacity - 1);
+
+    void *items[8];
+    for (uintptr_t i = 0; i < 8; i++) {
+        items[i] = (void *) (i + 1);
+    }
+
+    assertTrue(parcRingBuffer_Put(ring, items[0]), "Put should have succeeded");
+    uint32_t put = parcRingBuffer_PutN(ring, &items[1], 7);
+    assertTrue(put == capacity - 2, "Expected %u items put, got %u", capacity - 2, put);
+    assertTrue(parcRingBuffer_Remaining(ring) == 0, "Expected a full ring, remaining %u", parcRingBuffer_Remaining(ring));
+
+    void *data = NULL;
+    assertTrue(parcRingBuffer_Get(ring, &data), "Get should have succeeded");
+    assertTrue(data == items[0], "Got %p expected %p", data, items[0]);
+
+    void *output[8];
+    uint32_t got = parcRingBuffer_GetN(ring, output, 8);
+    assertTrue(got == capacity - 2, "Expected %u items, got %u", capacity - 2, got);
+    for (uint32_t i = 0; i < got; i++) {
+        assertTrue(output[i] == items[i + 1], "Got out of order item %p expected %p", output[i], items[i + 1]);
+    }
+    assertFalse(parcRingBuffer_Get(ring, &data), "Get from an empty ring should fail");
+}
+
+LONGBOW_TEST_CASE(Global, parcRingBuffer_CreateMultipleProducerMultipleConsumer)
+{
+    PARCRingBuffer *ring = parcRingBuffer_CreateMultipleProducerMultipleConsumer(4, NULL);
+    _assertRingBehaviour(ring, 4);
+    parcRingBuffer_Release(&ring);
+}
+
+LONGBOW_TEST_CASE(Global, parcRingBuffer_CreateSingleProducerSingleConsumer)
+{
+    PARCRingBuffer *ring = parcRingBuffer_CreateSingleProducerSingleConsumer(4, NULL);
+    _assertRingBehaviour(ring, 4);
+    parcRingBuffer_Release(&ring);
+}
+
+static void
+_testDestroyer(void **ptr)
+{
+    parcBuffer_Release((PARCBuffer **) ptr);
+}
+
+LONGBOW_TEST_CASE(Global, parcRingBuffer_Release_Destroyer)
+{
+    PARCRingBuffer *multiple = parcRingBuffer_CreateMultipleProducerMultipleConsumer(8, _testDestroyer);
+    PARCRingBuffer *single = parcRingBuffer_CreateSingleProducerSingleConsumer(8, _testDestroyer);
+
+    parcRingBuffer_Put(multiple, parcBuffer_Allocate(5));
+    parcRingBuffer_Put(single, parcBuffer_Allocate(5));
+
+    parcRingBuffer_Release(&multiple);
+    parcRingBuffer_Release(&single);
+    assertTrue(parcMemory_Outstanding() == 0, "Memory imbalance, expected 0 got %u", parcMemory_Outstanding());
+}
+
+int
+main(int argc, char *argv[])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(parc_RingBuffer);
+    int exitStatus = LONGBOW_TEST_MAIN(argc, argv, testRunner);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
@@ -61,9 +61,11 @@
 // This permits internal static functions to be visible to this Test Framework.
 #include "../parc_RingBuffer_1x1.c"
 
+#include <sched.h>
 #include <sys/time.h>
 
 #include <parc/algol/parc_SafeMemory.h>
+#include <parc/algol/parc_StdlibMemory.h>
 #include <LongBow/unit-test.h>
 
 LONGBOW_TEST_RUNNER(parc_RingBuffer_1x1)
@@ -73,6 +75,7 @@ LONGBOW_TEST_RUNNER(parc_RingBuffer_1x1)
     // Never rely on the execution order of tests or share state between them.
     LONGBOW_RUN_TEST_FIXTURE(Global);
     LONGBOW_RUN_TEST_FIXTURE(Local);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
 }
 
 // The Test Runner calls this function once before any Test Fixtures are run.
@@ -97,6 +100,9 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, parcRingBuffer1x1_Remaining_Half);
     LONGBOW_RUN_TEST_CASE(Global, parcRingBuffer1x1_Remaining_Full);
     LONGBOW_RUN_TEST_CASE(Global, parcRingBuffer1x1_Put_ToCapacity);
+    LONGBOW_RUN_TEST_CASE(Global, parcRingBuffer1x1_PutBatch_Partial);
+    LONGBOW_RUN_TEST_CASE(Global, parcRingBuffer1x1_GetBatch_Partial);
+    LONGBOW_RUN_TEST_CASE(Global, parcRingBuffer1x1_GetBatch_PutBatch);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Global)
@@ -297,6 +303,119 @@ LONGBOW_TEST_CASE(Global, parcRingBuffer1x1_Put_ToCapacity)
     assertFalse(success, "Should have failed on final put because data structure is full\n");
 }
 
+LONGBOW_TEST_CASE(Global, parcRingBuffer1x1_PutBatch_Partial)
+{
+    uint32_t capacity = 8;
+    PARCRingBuffer1x1 *ring = parcRingBuffer1x1_Create(capacity, NULL);
+
+    void *items[10];
+    for (uintptr_t i = 0; i < 10; i++) {
+        items[i] = (void *) (i + 1);
+    }
+
+    uint32_t put = parcRingBuffer1x1_PutBatch(ring, items, 5);
+    assertTrue(put == 5, "Expected 5 items put, got %u", put);
+
+    // Only (capacity - 1) items fit, so only 2 of the next 5 go on the ring.
+    put = parcRingBuffer1x1_PutBatch(ring, &items[5], 5);
+    assertTrue(put == 2, "Expected 2 items put, got %u", put);
+
+    put = parcRingBuffer1x1_PutBatch(ring, &items[7], 3);
+    assertTrue(put == 0, "Expected a full ring to take no items, got %u", put);
+
+    uint32_t remaining = parcRingBuffer1x1_Remaining(ring);
+    assertTrue(remaining == 0, "Got wrong remaining, got %u expecting 0", remaining);
+
+    parcRingBuffer1x1_Release(&ring);
+}
+
+LONGBOW_TEST_CASE(Global, parcRingBuffer1x1_GetBatch_Partial)
+{
+    uint32_t capacity = 8;
+    PARCRingBuffer1x1 *ring = parcRingBuffer1x1_Create(capacity, NULL);
+
+    void *output[8];
+    uint32_t got = parcRingBuffer1x1_GetBatch(ring, output, 8);
+    assertTrue(got == 0, "Expected an empty ring to return no items, got %u", got);
+
+    // Go around the ring a few times so the batches straddle the end of the buffer.
+    uintptr_t next = 1;
+    uintptr_t expected = 1;
+    for (int lap = 0; lap < 5; lap++) {
+        void *items[5];
+        for (int i = 0; i < 5; i++) {
+            items[i] = (void *) next++;
+        }
+        uint32_t put = parcRingBuffer1x1_PutBatch(ring, items, 5);
+        assertTrue(put == 5, "Expected 5 items put, got %u", put);
+
+        got = parcRingBuffer1x1_GetBatch(ring, output, 3);
+        assertTrue(got == 3, "Expected 3 items, got %u", got);
+        got += parcRingBuffer1x1_GetBatch(ring, &output[3], 8);
+        assertTrue(got == 5, "Expected 5 items, got %u", got);
+
+        for (uint32_t i = 0; i < got; i++) {
+            assertTrue(output[i] == (void *) expected, "Got out of order item %p expected %p", output[i], (void *) expected);
+            expected++;
+        }
+    }
+
+    parcRingBuffer1x1_Release(&ring);
+}
+
+typedef struct test_batch_ringbuffer {
+    PARCRingBuffer1x1 *ring;
+    uintptr_t itemsToWrite;
+} TestBatchRingBuffer;
+
+static void *
+_batchProducer(void *p)
+{
+    TestBatchRingBuffer *trb = (TestBatchRingBuffer *) p;
+
+    void *items[16];
+    uintptr_t next = 1;
+    while (next <= trb->itemsToWrite) {
+        uint32_t count = 0;
+        while (count < 16 && next + count <= trb->itemsToWrite) {
+            items[count] = (void *) (next + count);
+            count++;
+        }
+
+        uint32_t put = parcRingBuffer1x1_PutBatch(trb->ring, items, count);
+        if (put == 0) {
+            sched_yield();
+        }
+        next += put;
+    }
+
+    return NULL;
+}
+
+LONGBOW_TEST_CASE(Global, parcRingBuffer1x1_GetBatch_PutBatch)
+{
+    TestBatchRingBuffer trb = { .ring = parcRingBuffer1x1_Create(64, NULL), .itemsToWrite = 100000 };
+
+    pthread_t producerThread;
+    pthread_create(&producerThread, NULL, _batchProducer, &trb);
+
+    uintptr_t expected = 1;
+    while (expected <= trb.itemsToWrite) {
+        void *output[8];
+        uint32_t got = parcRingBuffer1x1_GetBatch(trb.ring, output, 8);
+        if (got == 0) {
+            sched_yield();
+        }
+        for (uint32_t i = 0; i < got; i++) {
+            assertTrue(output[i] == (void *) expected, "Got out of order item %p expected %p", output[i], (void *) expected);
+            expected++;
+        }
+    }
+
+    pthread_join(producerThread, NULL);
+    parcRingBuffer1x1_Release(&trb.ring);
+}
+
 LONGBOW_TEST_FIXTURE(Local)
 {
     LONGBOW_RUN_TEST_CASE(Local, _create);
@@ -356,6 +475,92 @@ LONGBOW_TEST_CASE(Local, _isPowerOfTwo)
     }
 }
 
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, parcRingBuffer1x1_Put_Get_Throughput);
+    LONGBOW_RUN_TEST_CASE(Performance, parcRingBuffer1x1_PutBatch_GetBatch_Throughput);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    parcMemory_SetInterface(&PARCStdlibMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+static void *
+_performance_SingleProducer(void *p)
+{
+    TestBatchRingBuffer *trb = (TestBatchRingBuffer *) p;
+
+    for (uintptr_t next = 1; next <= trb->itemsToWrite; ) {
+        if (parcRingBuffer1x1_Put(trb->ring, (void *) next)) {
+            next++;
+        } else {
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+static void
+_performance_Run(const char *name, bool batched)
+{
+    TestBatchRingBuffer trb = { .ring = parcRingBuffer1x1_Create(1024, NULL), .itemsToWrite = 20000000 };
+
+    struct timeval t0, t1;
+    gettimeofday(&t0, NULL);
+
+    pthread_t producerThread;
+    pthread_create(&producerThread, NULL, batched ? _batchProducer : _performance_SingleProducer, &trb);
+
+    uintptr_t sum = 0;
+    uintptr_t itemsRead = 0;
+    while (itemsRead < trb.itemsToWrite) {
+        void *output[16];
+        uint32_t got;
+        if (batched) {
+            got = parcRingBuffer1x1_GetBatch(trb.ring, output, 16);
+        } else {
+            got = parcRingBuffer1x1_Get(trb.ring, &output[0]) ? 1 : 0;
+        }
+        if (got == 0) {
+            sched_yield();
+        }
+        for (uint32_t i = 0; i < got; i++) {
+            sum += (uintptr_t) output[i];
+        }
+        itemsRead += got;
+    }
+
+    pthread_join(producerThread, NULL);
+    gettimeofday(&t1, NULL);
+    timersub(&t1, &t0, &t1);
+
+    uintptr_t expected = trb.itemsToWrite * (trb.itemsToWrite + 1) / 2;
+    assertTrue(sum == expected, "Wrong checksum, got %" PRIuPTR " expected %" PRIuPTR, sum, expected);
+
+    double sec = t1.tv_sec + t1.tv_usec * 1E-6;
+    printf("%s: passed %" PRIuPTR " items in %.6f seconds, %.2f items/sec\n", name, itemsRead, sec, itemsRead / sec);
+
+    parcRingBuffer1x1_Release(&trb.ring);
+}
+
+LONGBOW_TEST_CASE(Performance, parcRingBuffer1x1_Put_Get_Throughput)
+{
+    _performance_Run("parcRingBuffer1x1_Put", false);
+}
+
+LONGBOW_TEST_CASE(Performance, parcRingBuffer1x1_PutBatch_GetBatch_Throughput)
+{
+    _performance_Run("parcRingBuffer1x1_PutBatch", true);
+}
+
 int
 main(int argc, char *argv[])
 {
@@ -57,7 +57,12 @@
 // This permits internal static functions to be visible to this Test Framework.
 #include "../parc_RingBuffer_NxM.c"
 
+#include <pthread.h>
+#include <sched.h>
+#include <sys/time.h>
+
 #include <parc/algol/parc_SafeMemory.h>
+#include <parc/algol/parc_StdlibMemory.h>
 #include <LongBow/unit-test.h>
 
 LONGBOW_TEST_RUNNER(parc_RingBuffer_NxM)
@@ -67,6 +72,7 @@ LONGBOW_TEST_RUNNER(parc_RingBuffer_NxM)
     // Never rely on the execution order of tests or share state between them.
     LONGBOW_RUN_TEST_FIXTURE(Global);
     LONGBOW_RUN_TEST_FIXTURE(Local);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
 }
 
 // The Test Runner calls this function once before any Test Fixtures are run.
@@ -83,6 +89,14 @@ LONGBOW_TEST_RUNNER_TEARDOWN(parc_RingBuffer_NxM)
 
 LONGBOW_TEST_FIXTURE(Global)
 {
+    LONGBOW_RUN_TEST_CASE(Global, parcRingBufferNxM_Create_NonPower2);
+    LONGBOW_RUN_TEST_CASE(Global, parcRingBufferNxM_Put_ToCapacity);
+    LONGBOW_RUN_TEST_CASE(Global, parcRingBufferNxM_Get_Order);
+    LONGBOW_RUN_TEST_CASE(Global, parcRingBufferNxM_Remaining);
+    LONGBOW_RUN_TEST_CASE(Global, parcRingBufferNxM_PutN_Partial);
+    LONGBOW_RUN_TEST_CASE(Global, parcRingBufferNxM_GetN_Partial);
+    LONGBOW_RUN_TEST_CASE(Global, parcRingBufferNxM_Wraparound);
+    LONGBOW_RUN_TEST_CASE(Global, parcRingBufferNxM_MultipleProducerMultipleConsumer);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Global)
@@ -100,6 +114,255 @@ LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
     return LONGBOW_STATUS_SUCCEEDED;
 }
 
+LONGBOW_TEST_CASE_EXPECTS(Global, parcRingBufferNxM_Create_NonPower2, .event = &LongBowAssertEvent)
+{
+    // this will assert because the number of elements is not a power of 2
+    parcRingBufferNxM_Create(3, NULL);
+}
+
+LONGBOW_TEST_CASE(Global, parcRingBufferNxM_Put_ToCapacity)
+{
+    uint32_t capacity = 128;
+    PARCRingBufferNxM *ring = parcRingBufferNxM_Create(capacity, NULL);
+    for (uint32_t i = 0; i < capacity - 1; i++) {
+        assertTrue(parcRingBufferNxM_Put(ring, &capacity), "Put %u should have succeeded", i);
+    }
+
+    // this next put should fail, the ring holds (elements-1) items
+    bool success = parcRingBufferNxM_Put(ring, &capacity);
+
+    parcRingBufferNxM_Release(&ring);
+
+    assertFalse(success, "Should have failed on final put because data structure is full\n");
+}
+
+LONGBOW_TEST_CASE(Global, parcRingBufferNxM_Get_Order)
+{
+    uintptr_t items = 16;
+    PARCRingBufferNxM *ring = parcRingBufferNxM_Create(32, NULL);
+    for (uintptr_t i = 1; i <= items; i++) {
+        parcRingBufferNxM_Put(ring, (void *) i);
+    }
+
+    for (uintptr_t i = 1; i <= items; i++) {
+        void *data = NULL;
+        assertTrue(parcRingBufferNxM_Get(ring, &data), "Get %" PRIuPTR " should have succeeded", i);
+        assertTrue((uintptr_t) data == i, "Got out of order item %" PRIuPTR " expected %" PRIuPTR, (uintptr_t) data, i);
+    }
+
+    void *data = NULL;
+    assertFalse(parcRingBufferNxM_Get(ring, &data), "Get from an empty ring should fail");
+
+    parcRingBufferNxM_Release(&ring);
+}
+
+LONGBOW_TEST_CASE(Global, parcRingBufferNxM_Remaining)
+{
+    uint32_t capacity = 128;
+    PARCRingBufferNxM *ring = parcRingBufferNxM_Create(capacity, NULL);
+    assertTrue(parcRingBufferNxM_Remaining(ring) == capacity - 1, "Got wrong remaining, got %u expecting %u",
+               parcRingBufferNxM_Remaining(ring), capacity - 1);
+
+    for (uint32_t i = 0; i < capacity / 2; i++) {
+        parcRingBufferNxM_Put(ring, &capacity);
+    }
+    assertTrue(parcRingBufferNxM_Remaining(ring) == capacity / 2 - 1, "Got wrong remaining, got %u expecting %u",
+               parcRingBufferNxM_Remaining(ring), capacity / 2 - 1);
+
+    while (parcRingBufferNxM_Put(ring, &capacity)) {
+    }
+    assertTrue(parcRingBufferNxM_Remaining(ring) == 0, "Got wrong remaining, got %u expecting 0", parcRingBufferNxM_Remaining(ring));
+
+    parcRingBufferNxM_Release(&ring);
+}
+
+LONGBOW_TEST_CASE(Global, parcRingBufferNxM_PutN_Partial)
+{
+    PARCRingBufferNxM *ring = parcRingBufferNxM_Create(8, NULL);
+    void *items[10];
+    for (uintptr_t i = 0; i < 10; i++) {
+        items[i] = (void *) (i + 1);
+    }
+
+    uint32_t put = parcRingBufferNxM_PutN(ring, items, 5);
+    assertTrue(put == 5, "Expected 5 items put, got %u", put);
+
+    put = parcRingBufferNxM_PutN(ring, &items[5], 5);
+    assertTrue(put == 2, "Expected only 2 items to fit, got %u", put);
+
+    put = parcRingBufferNxM_PutN(ring, &items[7], 3);
+    assertTrue(put == 0, "Expected a full ring to take no items, got %u", put);
+
+    void *output[10];
+    uint32_t got = parcRingBufferNxM_GetN(ring, output, 10);
+    assertTrue(got == 7, "Expected 7 items, got %u", got);
+    for (uint32_t i = 0; i < got; i++) {
+        assertTrue(output[i] == items[i], "Got out of order item %p expected %p", output[i], items[i]);
+    }
+
+    parcRingBufferNxM_Release(&ring);
+}
+
+LONGBOW_TEST_CASE(Global, parcRingBufferNxM_GetN_Partial)
+{
+    PARCRingBufferNxM *ring = parcRingBufferNxM_Create(16, NULL);
+    void *items[6];
+    for (uintptr_t i = 0; i < 6; i++) {
+        items[i] = (void *) (i + 1);
+    }
+    parcRingBufferNxM_PutN(ring, items, 6);
+
+    void *output[6];
+    uint32_t got = parcRingBufferNxM_GetN(ring, output, 4);
+    assertTrue(got == 4, "Expected 4 items, got %u", got);
+    got = parcRingBufferNxM_GetN(ring, &output[4], 4);
+    assertTrue(got == 2, "Expected the remaining 2 items, got %u", got);
+    got = parcRingBufferNxM_GetN(ring, output, 4);
+    assertTrue(got == 0, "Expected an empty ring, got %u", got);
+
+    parcRingBufferNxM_Release(&ring);
+}
+
+LONGBOW_TEST_CASE(Global, parcRingBufferNxM_Wraparound)
+{
+    // Start the indexes just short of the uint32_t wrap.
+    PARCRingBufferNxM *ring = parcRingBufferNxM_Create(8, NULL);
+    uint32_t start = UINT32_MAX - 20;
+    ring->writer_head = start;
+    ring->reader_tail = start;
+    for (uint32_t i = 0; i < ring->elements; i++) {
+        uint32_t position = start + ((i - start) & ring->ring_mask);
+        ring->slots[position & ring->ring_mask].sequence = position;
+    }
+
+    for (uintptr_t i = 1; i <= 100; i++) {
+        assertTrue(parcRingBufferNxM_Put(ring, (void *) i), "Put %" PRIuPTR " should have succeeded", i);
+        void *data = NULL;
+        assertTrue(parcRingBufferNxM_Get(ring, &data), "Get %" PRIuPTR " should have succeeded", i);
+        assertTrue((uintptr_t) data == i, "Got %" PRIuPTR " expected %" PRIuPTR, (uintptr_t) data, i);
+    }
+    assertTrue(parcRingBufferNxM_Remaining(ring) == 7, "Expected an empty ring after wrapping");
+
+    parcRingBufferNxM_Release(&ring);
+}
+
+#define NXM_PRODUCERS 4
+#define NXM_CONSUMERS 4
+#define NXM_BATCH 8
+
+typedef struct {
+    PARCRingBufferNxM *ring;
+    uint32_t itemsPerProducer;
+    uint32_t producerIndex;
+    uint64_t consumed;
+    uint64_t sum;
+    volatile uint32_t *remaining;
+} NxMTestThread;
+
+static void *
+_nxmProducer(void *p)
+{
+    NxMTestThread *thread = p;
+    uint32_t next = 0;
+
+    while (next < thread->itemsPerProducer) {
+        // Encode the producer in the top bits so every item is distinct; never put NULL.
+        void *batch[NXM_BATCH];
+        uint32_t count = 0;
+        while (count < NXM_BATCH && next + count < thread->itemsPerProducer) {
+            batch[count] = (void *) (((uintptr_t) thread->producerIndex << 24) | (next + count + 1));
+            count++;
+        }
+        uint32_t put = (next % 2 == 0) ? parcRingBufferNxM_PutN(thread->ring, batch, count)
+                       : (parcRingBufferNxM_Put(thread->ring, batch[0]) ? 1 : 0);
+        if (put == 0) {
+            sched_yield();
+        }
+        next += put;
+    }
+
+    return NULL;
+}
+
+static void *
+_nxmSingleProducer(void *p)
+{
+    NxMTestThread *thread = p;
+
+    for (uint32_t next = 0; next < thread->itemsPerProducer; ) {
+        if (parcRingBufferNxM_Put(thread->ring, (void *) (((uintptr_t) thread->producerIndex << 24) | (next + 1)))) {
+            next++;
+        } else {
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+static void *
+_nxmConsumer(void *p)
+{
+    NxMTestThread *thread = p;
+
+    while (__atomic_load_n(thread->remaining, __ATOMIC_ACQUIRE) > 0) {
+        void *batch[NXM_BATCH];
+        uint32_t got = parcRingBufferNxM_GetN(thread->ring, batch, NXM_BATCH);
+        if (got == 0) {
+            sched_yield();
+        }
+        for (uint32_t i = 0; i < got; i++) {
+            assertNotNull(batch[i], "Got a NULL item");
+            thread->sum += (uintptr_t) batch[i];
+        }
+        thread->consumed += got;
+        __atomic_sub_fetch(thread->remaining, got, __ATOMIC_RELEASE);
+    }
+
+    return NULL;
+}
+
+LONGBOW_TEST_CASE(Global, parcRingBufferNxM_MultipleProducerMultipleConsumer)
+{
+    uint32_t itemsPerProducer = 20000;
+    volatile uint32_t remaining = itemsPerProducer * NXM_PRODUCERS;
+    PARCRingBufferNxM *ring = parcRingBufferNxM_Create(64, NULL);
+
+    NxMTestThread producers[NXM_PRODUCERS];
+    NxMTestThread consumers[NXM_CONSUMERS];
+    pthread_t threads[NXM_PRODUCERS + NXM_CONSUMERS];
+
+    for (int i = 0; i < NXM_CONSUMERS; i++) {
+        consumers[i] = (NxMTestThread) { .ring = ring, .remaining = &remaining };
+        pthread_create(&threads[NXM_PRODUCERS + i], NULL, _nxmConsumer, &consumers[i]);
+    }
+    for (int i = 0; i < NXM_PRODUCERS; i++) {
+        producers[i] = (NxMTestThread) { .ring = ring, .itemsPerProducer = itemsPerProducer, .producerIndex = i, .remaining = &remaining };
+        pthread_create(&threads[i], NULL, _nxmProducer, &producers[i]);
+    }
+    for (int i = 0; i < NXM_PRODUCERS + NXM_CONSUMERS; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    uint64_t expectedSum = 0;
+    for (uint64_t producer = 0; producer < NXM_PRODUCERS; producer++) {
+        expectedSum += (producer << 24) * itemsPerProducer + (uint64_t) itemsPerProducer * (itemsPerProducer + 1) / 2;
+    }
+
+    uint64_t consumed = 0;
+    uint64_t sum = 0;
+    for (int i = 0; i < NXM_CONSUMERS; i++) {
+        consumed += consumers[i].consumed;
+        sum += consumers[i].sum;
+    }
+
+    assertTrue(consumed == (uint64_t) itemsPerProducer * NXM_PRODUCERS, "Expected %u items, got %" PRIu64,
+               itemsPerProducer * NXM_PRODUCERS, consumed);
+    assertTrue(sum == expectedSum, "Every item should be consumed exactly once, sum %" PRIu64 " expected %" PRIu64, sum, expectedSum);
+
+    parcRingBufferNxM_Release(&ring);
+}
+
 LONGBOW_TEST_FIXTURE(Local)
 {
     LONGBOW_RUN_TEST_CASE(Local, _destroy);
@@ -135,6 +398,75 @@ LONGBOW_TEST_CASE(Local, _destroy)
     assertTrue(parcMemory_Outstanding() == 0, "Memory imbalance, expected 0 got %u", parcMemory_Outstanding());
 }
 
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, parcRingBufferNxM_Put_Get);
+    LONGBOW_RUN_TEST_CASE(Performance, parcRingBufferNxM_PutN_GetN);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    parcMemory_SetInterface(&PARCStdlibMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+static double
+_performance_Elapsed(const struct timeval *start)
+{
+    struct timeval end, elapsed;
+    gettimeofday(&end, NULL);
+    timersub(&end, start, &elapsed);
+    return elapsed.tv_sec + elapsed.tv_usec / 1000000.0;
+}
+
+static void
+_performance_Run(const char *name, bool batched)
+{
+    uint32_t itemsPerProducer = 2000000;
+    volatile uint32_t remaining = itemsPerProducer * NXM_PRODUCERS;
+    PARCRingBufferNxM *ring = parcRingBufferNxM_Create(1024, NULL);
+
+    NxMTestThread producers[NXM_PRODUCERS];
+    NxMTestThread consumers[NXM_CONSUMERS];
+    pthread_t threads[NXM_PRODUCERS + NXM_CONSUMERS];
+
+    struct timeval start;
+    gettimeofday(&start, NULL);
+    for (int i = 0; i < NXM_CONSUMERS; i++) {
+        consumers[i] = (NxMTestThread) { .ring = ring, .remaining = &remaining };
+        pthread_create(&threads[NXM_PRODUCERS + i], NULL, _nxmConsumer, &consumers[i]);
+    }
+    for (int i = 0; i < NXM_PRODUCERS; i++) {
+        producers[i] = (NxMTestThread) { .ring = ring, .itemsPerProducer = itemsPerProducer, .producerIndex = i, .remaining = &remaining };
+        pthread_create(&threads[i], NULL, batched ? _nxmProducer : _nxmSingleProducer, &producers[i]);
+    }
+    for (int i = 0; i < NXM_PRODUCERS + NXM_CONSUMERS; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    double seconds = _performance_Elapsed(&start);
+
+    uint32_t total = itemsPerProducer * NXM_PRODUCERS;
+    printf("%s: %u items, %d producers, %d consumers in %.6f seconds (%.0f/second)\n",
+           name, total, NXM_PRODUCERS, NXM_CONSUMERS, seconds, total / seconds);
+
+    parcRingBufferNxM_Release(&ring);
+}
+
+LONGBOW_TEST_CASE(Performance, parcRingBufferNxM_Put_Get)
+{
+    _performance_Run("parcRingBufferNxM_Put", false);
+}
+
+LONGBOW_TEST_CASE(Performance, parcRingBufferNxM_PutN_GetN)
+{
+    _performance_Run("parcRingBufferNxM_PutN", true);
+}
+
 int
 main(int argc, char *argv[])
 {
@@ -156,8 +156,20 @@ LONGBOW_TEST_FIXTURE_TEARDOWN(Object)
 
 LONGBOW_TEST_CASE(Object,  parcScheduledTask_Compare)
 {
-    testUnimplemented("");
+    PARCFutureTask *task = parcFutureTask_Create(_function, _function);
+
+    PARCScheduledTask *early = parcScheduledTask_Create(task, 10);
+    PARCScheduledTask *late = parcScheduledTask_Create(task, 20);
+    PARCScheduledTask *lateToo = parcScheduledTask_Create(task, 20);
 
+    assertTrue(parcScheduledTask_Compare(early, late) < 0, "Expected the earlier task to compare less.");
+    assertTrue(parcScheduledTask_Compare(late, early) > 0, "Expected the later task to compare greater.");
+    assertTrue(parcScheduledTask_Compare(late, lateToo) == 0, "Expected tasks with the same execution time to compare equal.");
+
+    parcScheduledTask_Release(&early);
+    parcScheduledTask_Release(&late);
+    parcScheduledTask_Release(&lateToo);
+    parcFutureTask_Release(&task);
 }
 
 LONGBOW_TEST_CASE(Object, parcScheduledTask_Copy)
@@ -257,6 +269,8 @@ LONGBOW_TEST_CASE(Object, parcScheduledTask_ToString)
 
 LONGBOW_TEST_FIXTURE(Specialization)
 {
+    LONGBOW_RUN_TEST_CASE(Specialization, parcScheduledTask_CreatePeriodic);
+    LONGBOW_RUN_TEST_CASE(Specialization, parcScheduledTask_Cancel_Owner);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Specialization)
@@ -273,6 +287,52 @@ LONGBOW_TEST_FIXTURE_TEARDOWN(Specialization)
     return LONGBOW_STATUS_SUCCEEDED;
 }
 
+LONGBOW_TEST_CASE(Specialization, parcScheduledTask_CreatePeriodic)
+{
+    PARCFutureTask *task = parcFutureTask_Create(_function, _function);
+
+    PARCScheduledTask *oneShot = parcScheduledTask_Create(task, 0);
+    PARCScheduledTask *fixedRate = parcScheduledTask_CreatePeriodic(task, 0, 1000);
+    PARCScheduledTask *fixedDelay = parcScheduledTask_CreatePeriodic(task, 0, -1000);
+
+    assertFalse(parcScheduledTask_IsPeriodic(oneShot), "Expected a one-shot task not to be periodic.");
+    assertTrue(parcScheduledTask_IsPeriodic(fixedRate), "Expected a fixed-rate task to be periodic.");
+    assertTrue(parcScheduledTask_GetPeriod(fixedDelay) == -1000, "Expected the fixed-delay period to be preserved.");
+    assertTrue(parcScheduledTask_GetQueueIndex(fixedRate) == PARCScheduledTask_NotQueued, "Expected a new task not to be queued.");
+
+    parcScheduledTask_SetExecutionTime(fixedRate, 1000);
+    assertTrue(parcScheduledTask_GetExecutionTime(fixedRate) == 1000, "Expected the new execution time.");
+
+    parcScheduledTask_Release(&oneShot);
+    parcScheduledTask_Release(&fixedRate);
+    parcScheduledTask_Release(&fixedDelay);
+    parcFutureTask_Release(&task);
+}
+
+static void
+_onCancel(void *owner, PARCScheduledTask *task)
+{
+    int *count = owner;
+    (*count)++;
+}
+
+LONGBOW_TEST_CASE(Specialization, parcScheduledTask_Cancel_Owner)
+{
+    int count = 0;
+    PARCFutureTask *task = parcFutureTask_Create(_function, _function);
+    PARCScheduledTask *instance = parcScheduledTask_Create(task, 0);
+
+    parcScheduledTask_SetOwner(instance, &count, _onCancel);
+    assertTrue(parcScheduledTask_GetOwner(instance) == &count, "Expected the owner to be set.");
+
+    assertTrue(parcScheduledTask_Cancel(instance, false), "Expected the task to be cancelled.");
+    assertTrue(count == 1, "Expected the owner to be notified of the cancellation.");
+    assertTrue(parcScheduledTask_IsCancelled(instance), "Expected the task to be cancelled.");
+
+    parcScheduledTask_Release(&instance);
+    parcFutureTask_Release(&task);
+}
+
 int
 main(int argc, char *argv[argc])
 {
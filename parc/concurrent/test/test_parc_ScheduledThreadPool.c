@@ -65,9 +65,14 @@
 #include <parc/algol/parc_SafeMemory.h>
 #include <parc/algol/parc_DisplayIndented.h>
 
+#include <parc/algol/parc_StdlibMemory.h>
+#include <parc/concurrent/parc_AtomicUint64.h>
+
 #include <parc/testing/parc_MemoryTesting.h>
 #include <parc/testing/parc_ObjectTesting.h>
 
+#include <sys/time.h>
+
 LONGBOW_TEST_RUNNER(parc_ScheduledThreadPool)
 {
     // The following Test Fixtures will run their corresponding Test Cases.
@@ -76,6 +81,7 @@ LONGBOW_TEST_RUNNER(parc_ScheduledThreadPool)
     LONGBOW_RUN_TEST_FIXTURE(CreateAcquireRelease);
     LONGBOW_RUN_TEST_FIXTURE(Object);
     LONGBOW_RUN_TEST_FIXTURE(Specialization);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
 }
 
 // The Test Runner calls this function once before any Test Fixtures are run.
@@ -258,6 +264,15 @@ LONGBOW_TEST_FIXTURE(Specialization)
     LONGBOW_RUN_TEST_CASE(Specialization, OneJob);
     LONGBOW_RUN_TEST_CASE(Specialization, Idle);
     LONGBOW_RUN_TEST_CASE(Specialization, parcScheduledThreadPool_Schedule);
+    LONGBOW_RUN_TEST_CASE(Specialization, parcScheduledThreadPool_Schedule_Order);
+    LONGBOW_RUN_TEST_CASE(Specialization, parcScheduledThreadPool_Submit);
+    LONGBOW_RUN_TEST_CASE(Specialization, parcScheduledThreadPool_Shutdown_ExecuteDelayedTasks);
+    LONGBOW_RUN_TEST_CASE(Specialization, parcScheduledThreadPool_Shutdown_DiscardDelayedTasks);
+    LONGBOW_RUN_TEST_CASE(Specialization, parcScheduledThreadPool_ScheduleAtFixedRate);
+    LONGBOW_RUN_TEST_CASE(Specialization, parcScheduledThreadPool_ScheduleWithFixedDelay);
+    LONGBOW_RUN_TEST_CASE(Specialization, parcScheduledThreadPool_RemoveOnCancel);
+    LONGBOW_RUN_TEST_CASE(Specialization, parcScheduledThreadPool_RemoveOnCancel_Disabled);
+    LONGBOW_RUN_TEST_CASE(Specialization, parcScheduledThreadPool_GetQueue);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Specialization)
@@ -295,13 +310,21 @@ _function(PARCFutureTask *task, void *parameter)
     return parameter;
 }
 
+// Schedule a task that the test does not need to refer to again.
+static void
+_schedule(PARCScheduledThreadPool *pool, PARCFutureTask *task, const PARCTimeout *delay)
+{
+    PARCScheduledTask *scheduled = parcScheduledThreadPool_Schedule(pool, task, delay);
+    parcScheduledTask_Release(&scheduled);
+}
+
 LONGBOW_TEST_CASE(Specialization, OneJob)
 {
     PARCScheduledThreadPool *pool = parcScheduledThreadPool_Create(3);
    
     PARCFutureTask *task = parcFutureTask_Create(_function, _function);
    
-    parcScheduledThreadPool_Schedule(pool, task, parcTimeout_MilliSeconds(2000));
+    _schedule(pool, task, parcTimeout_MilliSeconds(2000));
     printf("references %lld\n", parcObject_GetReferenceCount(task));
     parcFutureTask_Release(&task);
    
@@ -318,7 +341,7 @@ LONGBOW_TEST_CASE(Specialization, parcScheduledThreadPool_Schedule)
    
     PARCFutureTask *task = parcFutureTask_Create(_function, _function);
    
-    parcScheduledThreadPool_Schedule(pool, task, parcTimeout_MilliSeconds(2000));
+    _schedule(pool, task, parcTimeout_MilliSeconds(2000));
    
     parcFutureTask_Release(&task);
    
@@ -333,6 +356,312 @@ LONGBOW_TEST_CASE(Specialization, parcScheduledThreadPool_Schedule)
     parcScheduledThreadPool_Release(&pool);
 }
 
+static void *
+_countingFunction(PARCFutureTask *task, void *parameter)
+{
+    parcAtomicUint64_Increment((PARCAtomicUint64 *) parameter);
+    return NULL;
+}
+
+// Wait up to two seconds for the count to reach the expected value.
+static bool
+_awaitCount(const PARCAtomicUint64 *count, uint64_t expected)
+{
+    for (int i = 0; i < 2000 && parcAtomicUint64_GetValue(count) < expected; i++) {
+        usleep(1000);
+    }
+    return parcAtomicUint64_GetValue(count) >= expected;
+}
+
+static void
+_assertHeapOrdered(const PARCScheduledThreadPool *pool)
+{
+    for (size_t i = 0; i < pool->queueSize; i++) {
+        assertTrue(parcScheduledTask_GetQueueIndex(pool->queue[i]) == i, "Expected task %zu to know its position.", i);
+        if (i > 0) {
+            assertTrue(parcScheduledTask_Compare(pool->queue[(i - 1) / 2], pool->queue[i]) <= 0,
+                       "Expected the heap property to hold at %zu", i);
+        }
+    }
+}
+
+LONGBOW_TEST_CASE(Specialization, parcScheduledThreadPool_Schedule_Order)
+{
+    PARCAtomicUint64 *count = parcAtomicUint64_Create(0);
+    PARCScheduledThreadPool *pool = parcScheduledThreadPool_Create(1);
+    PARCFutureTask *task = parcFutureTask_Create(_countingFunction, count);
+
+    unsigned int seed = 1;
+    for (int i = 0; i < 200; i++) {
+        _schedule(pool, task, parcTimeout_MilliSeconds(10000 + rand_r(&seed) % 10000));
+    }
+    assertTrue(parcScheduledThreadPool_GetQueueSize(pool) == 200, "Expected 200 queued tasks.");
+
+    if (parcObject_Lock(pool)) {
+        _assertHeapOrdered(pool);
+
+        // Remove from the middle and check the heap is repaired.
+        for (int i = 0; i < 50; i++) {
+            PARCScheduledTask *removed = _parcScheduledThreadPool_RemoveAt(pool, rand_r(&seed) % pool->queueSize);
+            _parcScheduledThreadPool_Discard(&removed);
+            _assertHeapOrdered(pool);
+        }
+        parcObject_Unlock(pool);
+    }
+    assertTrue(parcScheduledThreadPool_GetQueueSize(pool) == 150, "Expected 150 queued tasks.");
+
+    parcFutureTask_Release(&task);
+    parcScheduledThreadPool_ShutdownNow(pool);
+    parcScheduledThreadPool_Release(&pool);
+    assertTrue(parcAtomicUint64_GetValue(count) == 0, "Expected no task to have run.");
+    parcAtomicUint64_Release(&count);
+}
+
+LONGBOW_TEST_CASE(Specialization, parcScheduledThreadPool_Submit)
+{
+    PARCAtomicUint64 *count = parcAtomicUint64_Create(0);
+    PARCScheduledThreadPool *pool = parcScheduledThreadPool_Create(2);
+    PARCFutureTask *task = parcFutureTask_Create(_countingFunction, count);
+
+    PARCScheduledTask *submitted = parcScheduledThreadPool_Submit(pool, task);
+    parcScheduledThreadPool_Execute(pool, task);
+    assertTrue(_awaitCount(count, 2), "Expected both tasks to run, ran %" PRIu64, parcAtomicUint64_GetValue(count));
+
+    // The pool has run and dropped the task, the caller's reference remains valid.
+    parcScheduledTask_AssertValid(submitted);
+    assertTrue(parcScheduledTask_GetTask(submitted) == task, "Expected the submitted task to refer to the given PARCFutureTask");
+    parcScheduledTask_Release(&submitted);
+
+    parcFutureTask_Release(&task);
+    parcScheduledThreadPool_ShutdownNow(pool);
+    parcScheduledThreadPool_Release(&pool);
+    parcAtomicUint64_Release(&count);
+}
+
+LONGBOW_TEST_CASE(Specialization, parcScheduledThreadPool_Shutdown_ExecuteDelayedTasks)
+{
+    PARCAtomicUint64 *count = parcAtomicUint64_Create(0);
+    PARCAtomicUint64 *periodicCount = parcAtomicUint64_Create(0);
+    PARCScheduledThreadPool *pool = parcScheduledThreadPool_Create(2);
+    parcScheduledThreadPool_SetExecuteExistingDelayedTasksAfterShutdownPolicy(pool, true);
+    assertTrue(parcScheduledThreadPool_GetExecuteExistingDelayedTasksAfterShutdownPolicy(pool), "Expected the policy to be set");
+
+    PARCFutureTask *task = parcFutureTask_Create(_countingFunction, count);
+    PARCFutureTask *periodic = parcFutureTask_Create(_countingFunction, periodicCount);
+    _schedule(pool, task, parcTimeout_MilliSeconds(50));
+    _schedule(pool, task, parcTimeout_MilliSeconds(100));
+    PARCScheduledTask *scheduled = parcScheduledThreadPool_ScheduleAtFixedRate(pool, periodic, *parcTimeout_MilliSeconds(20), *parcTimeout_MilliSeconds(10));
+    parcScheduledTask_Release(&scheduled);
+    parcFutureTask_Release(&task);
+    parcFutureTask_Release(&periodic);
+
+    parcScheduledThreadPool_Shutdown(pool);
+    assertTrue(parcAtomicUint64_GetValue(count) == 2,
+               "Expected both delayed tasks to run before Shutdown returned, ran %" PRIu64, parcAtomicUint64_GetValue(count));
+    // Left alone the periodic task would have run about ten times while the delayed tasks were awaited.
+    assertTrue(parcAtomicUint64_GetValue(periodicCount) <= 1,
+               "Expected the periodic task to be discarded, ran %" PRIu64, parcAtomicUint64_GetValue(periodicCount));
+    assertTrue(parcScheduledThreadPool_GetQueueSize(pool) == 0, "Expected an empty queue after Shutdown");
+
+    parcScheduledThreadPool_Release(&pool);
+    parcAtomicUint64_Release(&count);
+    parcAtomicUint64_Release(&periodicCount);
+}
+
+LONGBOW_TEST_CASE(Specialization, parcScheduledThreadPool_Shutdown_DiscardDelayedTasks)
+{
+    PARCAtomicUint64 *count = parcAtomicUint64_Create(0);
+    PARCScheduledThreadPool *pool = parcScheduledThreadPool_Create(2);
+
+    PARCFutureTask *task = parcFutureTask_Create(_countingFunction, count);
+    _schedule(pool, task, parcTimeout_MilliSeconds(50));
+    parcFutureTask_Release(&task);
+
+    parcScheduledThreadPool_Shutdown(pool);
+    usleep(100 * 1000);
+    assertTrue(parcAtomicUint64_GetValue(count) == 0,
+               "Expected the delayed task to be discarded, ran %" PRIu64, parcAtomicUint64_GetValue(count));
+
+    parcScheduledThreadPool_Release(&pool);
+    parcAtomicUint64_Release(&count);
+}
+
+LONGBOW_TEST_CASE(Specialization, parcScheduledThreadPool_ScheduleAtFixedRate)
+{
+    PARCAtomicUint64 *count = parcAtomicUint64_Create(0);
+    PARCScheduledThreadPool *pool = parcScheduledThreadPool_Create(2);
+    PARCFutureTask *task = parcFutureTask_Create(_countingFunction, count);
+
+    PARCScheduledTask *scheduled =
+        parcScheduledThreadPool_ScheduleAtFixedRate(pool, task, *parcTimeout_MilliSeconds(1), *parcTimeout_MilliSeconds(5));
+    uint64_t first = parcScheduledTask_GetExecutionTime(scheduled);
+
+    assertTrue(_awaitCount(count, 4), "Expected the task to run repeatedly, ran %" PRIu64, parcAtomicUint64_GetValue(count));
+
+    assertTrue(parcScheduledTask_Cancel(scheduled, false), "Expected the periodic task to be cancelled.");
+    uint64_t ranBefore = parcAtomicUint64_GetValue(count);
+
+    // Each execution time is an exact multiple of the period after the first, regardless of when it ran.
+    uint64_t delta = parcScheduledTask_GetExecutionTime(scheduled) - first;
+    assertTrue(delta % 5000000 == 0, "Expected no drift in the schedule, delta %" PRIu64, delta);
+
+    usleep(30000);
+    assertTrue(parcAtomicUint64_GetValue(count) <= ranBefore + 1, "Expected the cancelled task to stop, ran %" PRIu64 " after %" PRIu64,
+               parcAtomicUint64_GetValue(count), ranBefore);
+
+    parcScheduledTask_Release(&scheduled);
+    parcFutureTask_Release(&task);
+    parcScheduledThreadPool_ShutdownNow(pool);
+    parcScheduledThreadPool_Release(&pool);
+    parcAtomicUint64_Release(&count);
+}
+
+LONGBOW_TEST_CASE(Specialization, parcScheduledThreadPool_ScheduleWithFixedDelay)
+{
+    PARCAtomicUint64 *count = parcAtomicUint64_Create(0);
+    PARCScheduledThreadPool *pool = parcScheduledThreadPool_Create(2);
+    PARCFutureTask *task = parcFutureTask_Create(_countingFunction, count);
+
+    PARCScheduledTask *scheduled =
+        parcScheduledThreadPool_ScheduleWithFixedDelay(pool, task, *parcTimeout_MilliSeconds(1), *parcTimeout_MilliSeconds(5));
+    assertTrue(parcScheduledTask_GetPeriod(scheduled) == -5000000, "Expected a negative period for a fixed delay.");
+
+    assertTrue(_awaitCount(count, 3), "Expected the task to run repeatedly, ran %" PRIu64, parcAtomicUint64_GetValue(count));
+
+    parcScheduledTask_Release(&scheduled);
+    parcFutureTask_Release(&task);
+    parcScheduledThreadPool_ShutdownNow(pool);
+    parcScheduledThreadPool_Release(&pool);
+    parcAtomicUint64_Release(&count);
+}
+
+LONGBOW_TEST_CASE(Specialization, parcScheduledThreadPool_RemoveOnCancel)
+{
+    PARCAtomicUint64 *count = parcAtomicUint64_Create(0);
+    PARCScheduledThreadPool *pool = parcScheduledThreadPool_Create(1);
+    PARCFutureTask *task = parcFutureTask_Create(_countingFunction, count);
+
+    assertTrue(parcScheduledThreadPool_GetRemoveOnCancelPolicy(pool), "Expected remove-on-cancel by default.");
+
+    PARCScheduledTask *scheduled[10];
+    for (int i = 0; i < 10; i++) {
+        PARCFutureTask *each = parcFutureTask_Create(_countingFunction, count);
+        scheduled[i] = parcScheduledThreadPool_Schedule(pool, each, parcTimeout_MilliSeconds(10000 + i));
+        parcFutureTask_Release(&each);
+    }
+
+    for (int i = 0; i < 10; i += 2) {
+        parcScheduledTask_Cancel(scheduled[i], false);
+    }
+    assertTrue(parcScheduledThreadPool_GetQueueSize(pool) == 5, "Expected cancelled tasks to be removed at once.");
+
+    for (int i = 0; i < 10; i++) {
+        parcScheduledTask_Release(&scheduled[i]);
+    }
+    parcFutureTask_Release(&task);
+    parcScheduledThreadPool_ShutdownNow(pool);
+    parcScheduledThreadPool_Release(&pool);
+    parcAtomicUint64_Release(&count);
+}
+
+LONGBOW_TEST_CASE(Specialization, parcScheduledThreadPool_RemoveOnCancel_Disabled)
+{
+    PARCAtomicUint64 *count = parcAtomicUint64_Create(0);
+    PARCScheduledThreadPool *pool = parcScheduledThreadPool_Create(1);
+    PARCFutureTask *task = parcFutureTask_Create(_countingFunction, count);
+
+    parcScheduledThreadPool_SetRemoveOnCancelPolicy(pool, false);
+    PARCScheduledTask *scheduled = parcScheduledThreadPool_Schedule(pool, task, parcTimeout_MilliSeconds(10000));
+
+    parcScheduledTask_Cancel(scheduled, false);
+    assertTrue(parcScheduledThreadPool_GetQueueSize(pool) == 1, "Expected the cancelled task to remain queued.");
+
+    parcScheduledThreadPool_SetRemoveOnCancelPolicy(pool, true);
+    assertTrue(parcScheduledThreadPool_GetQueueSize(pool) == 0, "Expected enabling the policy to remove cancelled tasks.");
+
+    parcScheduledTask_Release(&scheduled);
+    parcFutureTask_Release(&task);
+    parcScheduledThreadPool_ShutdownNow(pool);
+    parcScheduledThreadPool_Release(&pool);
+    parcAtomicUint64_Release(&count);
+}
+
+LONGBOW_TEST_CASE(Specialization, parcScheduledThreadPool_GetQueue)
+{
+    PARCAtomicUint64 *count = parcAtomicUint64_Create(0);
+    PARCScheduledThreadPool *pool = parcScheduledThreadPool_Create(1);
+    PARCFutureTask *task = parcFutureTask_Create(_countingFunction, count);
+
+    _schedule(pool, task, parcTimeout_MilliSeconds(30000));
+    _schedule(pool, task, parcTimeout_MilliSeconds(10000));
+    _schedule(pool, task, parcTimeout_MilliSeconds(20000));
+
+    PARCSortedList *queue = parcScheduledThreadPool_GetQueue(pool);
+    assertTrue(parcSortedList_Size(queue) == 3, "Expected 3 queued tasks.");
+    PARCScheduledTask *first = parcSortedList_GetFirst(queue);
+    PARCScheduledTask *last = parcSortedList_GetLast(queue);
+    assertTrue(parcScheduledTask_Compare(first, last) < 0, "Expected the snapshot to be ordered by execution time.");
+    parcSortedList_Release(&queue);
+
+    parcFutureTask_Release(&task);
+    parcScheduledThreadPool_ShutdownNow(pool);
+    parcScheduledThreadPool_Release(&pool);
+    parcAtomicUint64_Release(&count);
+}
+
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, parcScheduledThreadPool_ScheduleCancel);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    parcMemory_SetInterface(&PARCStdlibMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+#define PERFORMANCE_TASKS 100000
+
+LONGBOW_TEST_CASE(Performance, parcScheduledThreadPool_ScheduleCancel)
+{
+    PARCAtomicUint64 *count = parcAtomicUint64_Create(0);
+    PARCScheduledThreadPool *pool = parcScheduledThreadPool_Create(1);
+    PARCFutureTask *task = parcFutureTask_Create(_countingFunction, count);
+    PARCScheduledTask **scheduled = parcMemory_Allocate(PERFORMANCE_TASKS * sizeof(PARCScheduledTask *));
+
+    unsigned int seed = 1;
+    struct timeval start, end, elapsed;
+    gettimeofday(&start, NULL);
+    for (int i = 0; i < PERFORMANCE_TASKS; i++) {
+        scheduled[i] = parcScheduledThreadPool_Schedule(pool, task, parcTimeout_MilliSeconds(60000 + rand_r(&seed) % 60000));
+    }
+    gettimeofday(&end, NULL);
+    timersub(&end, &start, &elapsed);
+    printf("parcScheduledThreadPool_Schedule: %d tasks in %ld.%06ld seconds\n", PERFORMANCE_TASKS, (long) elapsed.tv_sec, (long) elapsed.tv_usec);
+
+    gettimeofday(&start, NULL);
+    for (int i = 0; i < PERFORMANCE_TASKS; i++) {
+        parcScheduledTask_Cancel(scheduled[i], false);
+    }
+    gettimeofday(&end, NULL);
+    timersub(&end, &start, &elapsed);
+    printf("parcScheduledTask_Cancel: %d tasks in %ld.%06ld seconds\n", PERFORMANCE_TASKS, (long) elapsed.tv_sec, (long) elapsed.tv_usec);
+
+    for (int i = 0; i < PERFORMANCE_TASKS; i++) {
+        parcScheduledTask_Release(&scheduled[i]);
+    }
+    parcMemory_Deallocate(&scheduled);
+    parcFutureTask_Release(&task);
+    parcScheduledThreadPool_ShutdownNow(pool);
+    parcScheduledThreadPool_Release(&pool);
+    parcAtomicUint64_Release(&count);
+}
+
 int
 main(int argc, char *argv[argc])
 {
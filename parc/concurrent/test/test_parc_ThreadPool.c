@@ -60,12 +60,15 @@
 #include "../parc_ThreadPool.c"
 
 #include <stdio.h>
+#include <unistd.h>
+#include <sys/time.h>
 
 #include <LongBow/testing.h>
 #include <LongBow/debugging.h>
 
 #include <parc/algol/parc_Memory.h>
 #include <parc/algol/parc_SafeMemory.h>
+#include <parc/algol/parc_StdlibMemory.h>
 #include <parc/algol/parc_DisplayIndented.h>
 
 #include <parc/testing/parc_MemoryTesting.h>
@@ -79,6 +82,8 @@ LONGBOW_TEST_RUNNER(parc_ThreadPool)
     LONGBOW_RUN_TEST_FIXTURE(CreateAcquireRelease);
     LONGBOW_RUN_TEST_FIXTURE(Object);
     LONGBOW_RUN_TEST_FIXTURE(Specialization);
+    LONGBOW_RUN_TEST_FIXTURE(WorkStealing);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
 }
 
 // The Test Runner calls this function once before any Test Fixtures are run.
@@ -303,6 +308,400 @@ LONGBOW_TEST_CASE(Object, parcThreadPool_Execute)
     parcThreadPool_Release(&pool);
 }
 
+LONGBOW_TEST_FIXTURE(WorkStealing)
+{
+    LONGBOW_RUN_TEST_CASE(WorkStealing, parcThreadPool_Execute_Many);
+    LONGBOW_RUN_TEST_CASE(WorkStealing, parcThreadPool_Execute_Nested);
+    LONGBOW_RUN_TEST_CASE(WorkStealing, parcThreadPool_Execute_AfterShutdown);
+    LONGBOW_RUN_TEST_CASE(WorkStealing, parcThreadPool_Release_Outstanding);
+    LONGBOW_RUN_TEST_CASE(WorkStealing, parcThreadPool_PrestartAllCoreThreads);
+    LONGBOW_RUN_TEST_CASE(WorkStealing, parcThreadPool_SetCorePoolSize);
+    LONGBOW_RUN_TEST_CASE(WorkStealing, parcThreadPool_SetAllowCoreThreadTimeOut);
+    LONGBOW_RUN_TEST_CASE(WorkStealing, parcThreadPool_Purge);
+    LONGBOW_RUN_TEST_CASE(WorkStealing, parcThreadPool_Remove);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(WorkStealing)
+{
+    parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(WorkStealing)
+{
+    if (!parcMemoryTesting_ExpectedOutstanding(0, "%s mismanaged memory.", longBowTestCase_GetFullName(testCase))) {
+        parcSafeMemory_ReportAllocation(1);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+static void *
+_increment(PARCFutureTask *task, void *parameter)
+{
+    parcAtomicUint64_Increment((PARCAtomicUint64 *) parameter);
+    return parameter;
+}
+
+/*
+ * Spin until the predicate holds, or about five seconds pass.
+ */
+#define _waitUntil(_predicate_) \
+    for (int _tries_ = 0; !(_predicate_) && _tries_ < 5000; _tries_++) { usleep(1000); }
+
+LONGBOW_TEST_CASE(WorkStealing, parcThreadPool_Execute_Many)
+{
+    PARCThreadPool *pool = parcThreadPool_Create(4);
+    PARCAtomicUint64 *counter = parcAtomicUint64_Create(0);
+    PARCFutureTask *task = parcFutureTask_Create(_increment, counter);
+
+    for (int i = 0; i < 10000; i++) {
+        assertTrue(parcThreadPool_Execute(pool, task), "Expected parcThreadPool_Execute to accept the task.");
+    }
+    parcFutureTask_Release(&task);
+
+    parcThreadPool_Shutdown(pool);
+    assertTrue(parcThreadPool_AwaitTermination(pool, PARCTimeout_Never), "parcThreadPool_AwaitTermination timed-out");
+
+    assertTrue(parcAtomicUint64_GetValue(counter) == 10000, "Expected 10000 executions, actual %" PRIu64, parcAtomicUint64_GetValue(counter));
+    assertTrue(parcThreadPool_GetCompletedTaskCount(pool) == 10000, "Expected 10000 completed tasks, actual %" PRIu64,
+               parcThreadPool_GetCompletedTaskCount(pool));
+    assertTrue(parcThreadPool_GetTaskCount(pool) == 10000, "Expected a task count of 10000, actual %ld", parcThreadPool_GetTaskCount(pool));
+    assertTrue(parcThreadPool_GetLargestPoolSize(pool) <= 4, "Expected no more than 4 threads, actual %d", parcThreadPool_GetLargestPoolSize(pool));
+    assertTrue(parcThreadPool_IsTerminated(pool), "Expected the pool to be terminated.");
+
+    parcAtomicUint64_Release(&counter);
+    parcThreadPool_Release(&pool);
+}
+
+static PARCThreadPool *_nestedPool;
+static PARCFutureTask *_nestedLeaf;
+
+static void *
+_spawn(PARCFutureTask *task, void *parameter)
+{
+    // Runs on a worker, so these go to the worker's own deque for the other workers to steal.
+    for (int i = 0; i < 100; i++) {
+        parcThreadPool_Execute(_nestedPool, _nestedLeaf);
+    }
+    return parameter;
+}
+
+LONGBOW_TEST_CASE(WorkStealing, parcThreadPool_Execute_Nested)
+{
+    _nestedPool = parcThreadPool_Create(4);
+    PARCAtomicUint64 *counter = parcAtomicUint64_Create(0);
+    _nestedLeaf = parcFutureTask_Create(_increment, counter);
+    PARCFutureTask *spawn = parcFutureTask_Create(_spawn, _spawn);
+
+    for (int i = 0; i < 50; i++) {
+        parcThreadPool_Execute(_nestedPool, spawn);
+    }
+
+    _waitUntil(parcAtomicUint64_GetValue(counter) == 5000);
+
+    parcThreadPool_Shutdown(_nestedPool);
+    assertTrue(parcThreadPool_AwaitTermination(_nestedPool, PARCTimeout_Never), "parcThreadPool_AwaitTermination timed-out");
+    assertTrue(parcAtomicUint64_GetValue(counter) == 5000, "Expected 5000 executions, actual %" PRIu64, parcAtomicUint64_GetValue(counter));
+    assertTrue(parcThreadPool_GetCompletedTaskCount(_nestedPool) == 5050, "Expected 5050 completed tasks, actual %" PRIu64,
+               parcThreadPool_GetCompletedTaskCount(_nestedPool));
+
+    parcFutureTask_Release(&spawn);
+    parcFutureTask_Release(&_nestedLeaf);
+    parcAtomicUint64_Release(&counter);
+    parcThreadPool_Release(&_nestedPool);
+}
+
+LONGBOW_TEST_CASE(WorkStealing, parcThreadPool_Execute_AfterShutdown)
+{
+    PARCThreadPool *pool = parcThreadPool_Create(2);
+    PARCAtomicUint64 *counter = parcAtomicUint64_Create(0);
+    PARCFutureTask *task = parcFutureTask_Create(_increment, counter);
+
+    parcThreadPool_Shutdown(pool);
+    assertFalse(parcThreadPool_Execute(pool, task), "Expected parcThreadPool_Execute to reject a task after shutdown.");
+    assertTrue(parcThreadPool_GetTaskCount(pool) == 0, "Expected a rejected task not to be counted.");
+
+    parcThreadPool_ShutdownNow(pool);
+
+    parcFutureTask_Release(&task);
+    parcAtomicUint64_Release(&counter);
+    parcThreadPool_Release(&pool);
+}
+
+LONGBOW_TEST_CASE(WorkStealing, parcThreadPool_Release_Outstanding)
+{
+    PARCThreadPool *pool = parcThreadPool_Create(2);
+    PARCAtomicUint64 *counter = parcAtomicUint64_Create(0);
+    PARCFutureTask *task = parcFutureTask_Create(_increment, counter);
+
+    for (int i = 0; i < 1000; i++) {
+        parcThreadPool_Execute(pool, task);
+    }
+    parcFutureTask_Release(&task);
+
+    // The queued work keeps the pool alive; the last task to finish destroys it.
+    parcThreadPool_Release(&pool);
+
+    _waitUntil(parcMemory_Outstanding() == 1);
+    assertTrue(parcAtomicUint64_GetValue(counter) == 1000, "Expected 1000 executions, actual %" PRIu64, parcAtomicUint64_GetValue(counter));
+    parcAtomicUint64_Release(&counter);
+}
+
+LONGBOW_TEST_CASE(WorkStealing, parcThreadPool_PrestartAllCoreThreads)
+{
+    PARCThreadPool *pool = parcThreadPool_Create(4);
+    assertTrue(parcThreadPool_GetPoolSize(pool) == 0, "Expected threads to be started on demand.");
+
+    assertTrue(parcThreadPool_PrestartCoreThread(pool), "Expected a core thread to be started.");
+    int started = parcThreadPool_PrestartAllCoreThreads(pool);
+    assertTrue(started == 3, "Expected 3 more threads to be started, actual %d", started);
+    assertFalse(parcThreadPool_PrestartCoreThread(pool), "Expected no thread to be started beyond the core pool size.");
+
+    assertTrue(parcThreadPool_GetPoolSize(pool) == 4, "Expected 4 threads, actual %d", parcThreadPool_GetPoolSize(pool));
+    assertTrue(parcThreadPool_GetLargestPoolSize(pool) == 4, "Expected 4 threads, actual %d", parcThreadPool_GetLargestPoolSize(pool));
+
+    parcThreadPool_ShutdownNow(pool);
+    parcThreadPool_Release(&pool);
+}
+
+LONGBOW_TEST_CASE(WorkStealing, parcThreadPool_SetCorePoolSize)
+{
+    PARCThreadPool *pool = parcThreadPool_Create(4);
+    parcThreadPool_PrestartAllCoreThreads(pool);
+
+    parcThreadPool_SetCorePoolSize(pool, 1);
+    assertTrue(parcThreadPool_GetCorePoolSize(pool) == 1, "Expected a core pool size of 1");
+    _waitUntil(parcThreadPool_GetPoolSize(pool) == 1);
+    assertTrue(parcThreadPool_GetPoolSize(pool) == 1, "Expected excess threads to exit, actual %d", parcThreadPool_GetPoolSize(pool));
+
+    parcThreadPool_SetCorePoolSize(pool, 3);
+    assertTrue(parcThreadPool_PrestartAllCoreThreads(pool) == 2, "Expected 2 threads to be started.");
+
+    PARCAtomicUint64 *counter = parcAtomicUint64_Create(0);
+    PARCFutureTask *task = parcFutureTask_Create(_increment, counter);
+    for (int i = 0; i < 100; i++) {
+        parcThreadPool_Execute(pool, task);
+    }
+    parcFutureTask_Release(&task);
+
+    parcThreadPool_Shutdown(pool);
+    assertTrue(parcThreadPool_AwaitTermination(pool, PARCTimeout_Never), "parcThreadPool_AwaitTermination timed-out");
+    assertTrue(parcAtomicUint64_GetValue(counter) == 100, "Expected 100 executions, actual %" PRIu64, parcAtomicUint64_GetValue(counter));
+
+    parcAtomicUint64_Release(&counter);
+    parcThreadPool_Release(&pool);
+}
+
+LONGBOW_TEST_CASE(WorkStealing, parcThreadPool_SetAllowCoreThreadTimeOut)
+{
+    PARCThreadPool *pool = parcThreadPool_Create(2);
+    assertTrue(parcTimeout_IsNever(parcThreadPool_GetKeepAliveTime(pool)), "Expected the default keep-alive time to be Never.");
+
+    parcThreadPool_SetKeepAliveTime(pool, parcTimeout_MilliSeconds(10));
+    assertTrue(parcTimeout_InNanoSeconds(parcThreadPool_GetKeepAliveTime(pool)) == 10000000, "Expected a 10ms keep-alive time.");
+    parcThreadPool_PrestartAllCoreThreads(pool);
+
+    parcThreadPool_SetAllowCoreThreadTimeOut(pool, true);
+    assertTrue(parcThreadPool_GetAllowsCoreThreadTimeOut(pool), "Expected core threads to be allowed to time out.");
+    _waitUntil(parcThreadPool_GetPoolSize(pool) == 0);
+    assertTrue(parcThreadPool_GetPoolSize(pool) == 0, "Expected idle threads to time out, actual %d", parcThreadPool_GetPoolSize(pool));
+
+    // A thread is started again for new work.
+    PARCAtomicUint64 *counter = parcAtomicUint64_Create(0);
+    PARCFutureTask *task = parcFutureTask_Create(_increment, counter);
+    parcThreadPool_Execute(pool, task);
+    parcFutureTask_Release(&task);
+    _waitUntil(parcAtomicUint64_GetValue(counter) == 1);
+    assertTrue(parcAtomicUint64_GetValue(counter) == 1, "Expected the task to run after the threads timed out.");
+
+    parcThreadPool_ShutdownNow(pool);
+    parcAtomicUint64_Release(&counter);
+    parcThreadPool_Release(&pool);
+}
+
+static void *
+_block(PARCFutureTask *task, void *parameter)
+{
+    PARCAtomicUint64 *gate = parameter;
+    parcAtomicUint64_Increment(gate);
+    while (parcAtomicUint64_GetValue(gate) == 1) {
+        usleep(1000);
+    }
+    return parameter;
+}
+
+/*
+ * Occupy the only worker of a single-thread pool so that later tasks stay in the injection queue.
+ */
+static PARCFutureTask *
+_blockPool(PARCThreadPool *pool, PARCAtomicUint64 *gate)
+{
+    PARCFutureTask *blocker = parcFutureTask_Create(_block, gate);
+    parcThreadPool_Execute(pool, blocker);
+    _waitUntil(parcAtomicUint64_GetValue(gate) == 1);
+    return blocker;
+}
+
+LONGBOW_TEST_CASE(WorkStealing, parcThreadPool_Purge)
+{
+    PARCThreadPool *pool = parcThreadPool_Create(1);
+    PARCAtomicUint64 *gate = parcAtomicUint64_Create(0);
+    PARCAtomicUint64 *counter = parcAtomicUint64_Create(0);
+    PARCFutureTask *blocker = _blockPool(pool, gate);
+
+    PARCFutureTask *tasks[10];
+    for (int i = 0; i < 10; i++) {
+        tasks[i] = parcFutureTask_Create(_increment, counter);
+        parcThreadPool_Execute(pool, tasks[i]);
+        if (i % 2 == 0) {
+            parcFutureTask_Cancel(tasks[i], false);
+        }
+    }
+    PARCLinkedList *queue = parcThreadPool_GetQueue(pool);
+    assertTrue(parcLinkedList_Size(queue) == 10, "Expected 10 queued tasks, actual %zu", parcLinkedList_Size(queue));
+    parcLinkedList_Release(&queue);
+
+    parcThreadPool_Purge(pool);
+    queue = parcThreadPool_GetQueue(pool);
+    assertTrue(parcLinkedList_Size(queue) == 5, "Expected 5 queued tasks, actual %zu", parcLinkedList_Size(queue));
+    for (int i = 0; i < 5; i++) {
+        assertTrue(parcLinkedList_GetAtIndex(queue, i) == tasks[2 * i + 1], "Expected the remaining tasks to keep their order.");
+    }
+    parcLinkedList_Release(&queue);
+
+    parcAtomicUint64_Increment(gate);
+    parcThreadPool_Shutdown(pool);
+    assertTrue(parcThreadPool_AwaitTermination(pool, PARCTimeout_Never), "parcThreadPool_AwaitTermination timed-out");
+    assertTrue(parcAtomicUint64_GetValue(counter) == 5, "Expected 5 executions, actual %" PRIu64, parcAtomicUint64_GetValue(counter));
+
+    for (int i = 0; i < 10; i++) {
+        parcFutureTask_Release(&tasks[i]);
+    }
+    parcFutureTask_Release(&blocker);
+    parcAtomicUint64_Release(&counter);
+    parcAtomicUint64_Release(&gate);
+    parcThreadPool_Release(&pool);
+}
+
+LONGBOW_TEST_CASE(WorkStealing, parcThreadPool_Remove)
+{
+    PARCThreadPool *pool = parcThreadPool_Create(1);
+    PARCAtomicUint64 *gate = parcAtomicUint64_Create(0);
+    PARCAtomicUint64 *counter = parcAtomicUint64_Create(0);
+    PARCFutureTask *blocker = _blockPool(pool, gate);
+
+    PARCFutureTask *keep = parcFutureTask_Create(_increment, counter);
+    PARCFutureTask *removed = parcFutureTask_Create(_increment, counter);
+    parcThreadPool_Execute(pool, keep);
+    parcThreadPool_Execute(pool, removed);
+
+    assertTrue(parcThreadPool_Remove(pool, removed), "Expected the queued task to be removed.");
+    assertFalse(parcThreadPool_Remove(pool, removed), "Expected the task to be removed only once.");
+    assertFalse(parcThreadPool_Remove(pool, blocker), "Expected a running task not to be removed.");
+
+    parcAtomicUint64_Increment(gate);
+    parcThreadPool_Shutdown(pool);
+    assertTrue(parcThreadPool_AwaitTermination(pool, PARCTimeout_Never), "parcThreadPool_AwaitTermination timed-out");
+    assertTrue(parcAtomicUint64_GetValue(counter) == 1, "Expected 1 execution, actual %" PRIu64, parcAtomicUint64_GetValue(counter));
+
+    parcFutureTask_Release(&keep);
+    parcFutureTask_Release(&removed);
+    parcFutureTask_Release(&blocker);
+    parcAtomicUint64_Release(&counter);
+    parcAtomicUint64_Release(&gate);
+    parcThreadPool_Release(&pool);
+}
+
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, parcThreadPool_Execute_Throughput);
+    LONGBOW_RUN_TEST_CASE(Performance, parcThreadPool_Execute_Nested_Throughput);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    parcMemory_SetInterface(&PARCStdlibMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+#define PERFORMANCE_TASKS 1000000
+#define PERFORMANCE_THREADS 8
+
+static double
+_performance_Elapsed(const struct timeval *start)
+{
+    struct timeval end, elapsed;
+    gettimeofday(&end, NULL);
+    timersub(&end, start, &elapsed);
+    return elapsed.tv_sec + elapsed.tv_usec / 1000000.0;
+}
+
+LONGBOW_TEST_CASE(Performance, parcThreadPool_Execute_Throughput)
+{
+    PARCThreadPool *pool = parcThreadPool_Create(PERFORMANCE_THREADS);
+    parcThreadPool_PrestartAllCoreThreads(pool);
+    PARCAtomicUint64 *counter = parcAtomicUint64_Create(0);
+    PARCFutureTask *task = parcFutureTask_Create(_increment, counter);
+
+    struct timeval start;
+    gettimeofday(&start, NULL);
+    for (int i = 0; i < PERFORMANCE_TASKS; i++) {
+        parcThreadPool_Execute(pool, task);
+    }
+    parcThreadPool_Shutdown(pool);
+    parcThreadPool_AwaitTermination(pool, PARCTimeout_Never);
+    double seconds = _performance_Elapsed(&start);
+    printf("parcThreadPool_Execute: %d tasks on %d threads in %.6f seconds (%.0f/second)\n",
+           PERFORMANCE_TASKS, PERFORMANCE_THREADS, seconds, PERFORMANCE_TASKS / seconds);
+
+    parcFutureTask_Release(&task);
+    parcAtomicUint64_Release(&counter);
+    parcThreadPool_Release(&pool);
+}
+
+static void *
+_spawnMany(PARCFutureTask *task, void *parameter)
+{
+    for (int i = 0; i < 1000; i++) {
+        parcThreadPool_Execute(_nestedPool, _nestedLeaf);
+    }
+    return parameter;
+}
+
+LONGBOW_TEST_CASE(Performance, parcThreadPool_Execute_Nested_Throughput)
+{
+    _nestedPool = parcThreadPool_Create(PERFORMANCE_THREADS);
+    parcThreadPool_PrestartAllCoreThreads(_nestedPool);
+    PARCAtomicUint64 *counter = parcAtomicUint64_Create(0);
+    _nestedLeaf = parcFutureTask_Create(_increment, counter);
+    PARCFutureTask *spawn = parcFutureTask_Create(_spawnMany, _spawnMany);
+
+    struct timeval start;
+    gettimeofday(&start, NULL);
+    for (int i = 0; i < PERFORMANCE_TASKS / 1000; i++) {
+        parcThreadPool_Execute(_nestedPool, spawn);
+    }
+    while (parcAtomicUint64_GetValue(counter) < PERFORMANCE_TASKS) {
+        usleep(100);
+    }
+    double seconds = _performance_Elapsed(&start);
+    printf("parcThreadPool_Execute (from tasks): %d tasks on %d threads in %.6f seconds (%.0f/second)\n",
+           PERFORMANCE_TASKS, PERFORMANCE_THREADS, seconds, PERFORMANCE_TASKS / seconds);
+
+    parcThreadPool_ShutdownNow(_nestedPool);
+    parcFutureTask_Release(&spawn);
+    parcFutureTask_Release(&_nestedLeaf);
+    parcAtomicUint64_Release(&counter);
+    parcThreadPool_Release(&_nestedPool);
+}
+
 int
 main(int argc, char *argv[argc])
 {
@@ -65,9 +65,14 @@
 #include <parc/algol/parc_SafeMemory.h>
 #include <parc/algol/parc_DisplayIndented.h>
 
+#include <parc/algol/parc_StdlibMemory.h>
+#include <parc/concurrent/parc_AtomicUint64.h>
+
 #include <parc/testing/parc_MemoryTesting.h>
 #include <parc/testing/parc_ObjectTesting.h>
 
+#include <unistd.h>
+
 LONGBOW_TEST_RUNNER(parc_Timer)
 {
     // The following Test Fixtures will run their corresponding Test Cases.
@@ -76,11 +81,14 @@ LONGBOW_TEST_RUNNER(parc_Timer)
     LONGBOW_RUN_TEST_FIXTURE(CreateAcquireRelease);
     LONGBOW_RUN_TEST_FIXTURE(Object);
     LONGBOW_RUN_TEST_FIXTURE(Specialization);
+    LONGBOW_RUN_TEST_FIXTURE(Wheel);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
 }
 
 // The Test Runner calls this function once before any Test Fixtures are run.
 LONGBOW_TEST_RUNNER_SETUP(parc_Timer)
 {
+    parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
     return LONGBOW_STATUS_SUCCEEDED;
 }
 
@@ -227,6 +235,14 @@ LONGBOW_TEST_CASE(Object, parcTimer_ToString)
 
 LONGBOW_TEST_FIXTURE(Specialization)
 {
+    LONGBOW_RUN_TEST_CASE(Specialization, parcTimer_ScheduleAfterDelay);
+    LONGBOW_RUN_TEST_CASE(Specialization, parcTimer_ScheduleAtTime);
+    LONGBOW_RUN_TEST_CASE(Specialization, parcTimer_ScheduleAfterDelayAndRepeat);
+    LONGBOW_RUN_TEST_CASE(Specialization, parcTimer_ScheduleAfterDelay_Cancelled);
+    LONGBOW_RUN_TEST_CASE(Specialization, parcTimer_Purge);
+    LONGBOW_RUN_TEST_CASE(Specialization, parcTimer_Cancel);
+    LONGBOW_RUN_TEST_CASE(Specialization, parcTimer_CreateWithThreadPool);
+    LONGBOW_RUN_TEST_CASE(Specialization, parcTimer_CreateWithThreadPool_Repeat);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Specialization)
@@ -243,6 +259,373 @@ LONGBOW_TEST_FIXTURE_TEARDOWN(Specialization)
     return LONGBOW_STATUS_SUCCEEDED;
 }
 
+static void *
+_timerTestFunction(PARCFutureTask *task, void *parameter)
+{
+    parcAtomicUint64_Increment((PARCAtomicUint64 *) parameter);
+    return NULL;
+}
+
+// Wait up to two seconds for the count to reach the expected value.
+static bool
+_timerTestAwaitCount(const PARCAtomicUint64 *count, uint64_t expected)
+{
+    for (int i = 0; i < 2000 && parcAtomicUint64_GetValue(count) < expected; i++) {
+        usleep(1000);
+    }
+    return parcAtomicUint64_GetValue(count) >= expected;
+}
+
+LONGBOW_TEST_CASE(Specialization, parcTimer_ScheduleAfterDelay)
+{
+    PARCAtomicUint64 *count = parcAtomicUint64_Create(0);
+    PARCTimer *timer = parcTimer_Create();
+    PARCFutureTask *task = parcFutureTask_Create(_timerTestFunction, count);
+
+    parcTimer_ScheduleAfterDelay(timer, task, 10);
+    assertTrue(_timerTestAwaitCount(count, 1), "Expected the task to run.");
+    assertTrue(parcFutureTask_IsDone(task), "Expected the task to be done.");
+
+    parcFutureTask_Release(&task);
+    parcTimer_Release(&timer);
+    parcAtomicUint64_Release(&count);
+}
+
+LONGBOW_TEST_CASE(Specialization, parcTimer_ScheduleAtTime)
+{
+    PARCAtomicUint64 *count = parcAtomicUint64_Create(0);
+    PARCTimer *timer = parcTimer_Create();
+    PARCFutureTask *task = parcFutureTask_Create(_timerTestFunction, count);
+
+    parcTimer_ScheduleAtTime(timer, task, time(NULL) - 1);
+    assertTrue(_timerTestAwaitCount(count, 1), "Expected a task scheduled in the past to run immediately.");
+
+    parcFutureTask_Release(&task);
+    parcTimer_Release(&timer);
+    parcAtomicUint64_Release(&count);
+}
+
+LONGBOW_TEST_CASE(Specialization, parcTimer_ScheduleAfterDelayAndRepeat)
+{
+    PARCAtomicUint64 *count = parcAtomicUint64_Create(0);
+    PARCTimer *timer = parcTimer_Create();
+    PARCFutureTask *task = parcFutureTask_Create(_timerTestFunction, count);
+
+    parcTimer_ScheduleAfterDelayAndRepeat(timer, task, 1, 5);
+    assertTrue(_timerTestAwaitCount(count, 3), "Expected the task to run repeatedly, ran %" PRIu64 " times.", parcAtomicUint64_GetValue(count));
+    assertTrue(parcTimer_GetScheduledCount(timer) == 1, "Expected a repeating task to remain scheduled.");
+
+    parcTimer_Cancel(timer);
+    assertTrue(parcTimer_GetScheduledCount(timer) == 0, "Expected no scheduled tasks after cancelling the timer.");
+
+    parcFutureTask_Release(&task);
+    parcTimer_Release(&timer);
+    parcAtomicUint64_Release(&count);
+}
+
+LONGBOW_TEST_CASE(Specialization, parcTimer_ScheduleAfterDelay_Cancelled)
+{
+    PARCAtomicUint64 *count = parcAtomicUint64_Create(0);
+    PARCTimer *timer = parcTimer_Create();
+    PARCFutureTask *cancelled = parcFutureTask_Create(_timerTestFunction, count);
+    PARCFutureTask *task = parcFutureTask_Create(_timerTestFunction, count);
+
+    parcTimer_ScheduleAfterDelay(timer, cancelled, 5);
+    parcFutureTask_Cancel(cancelled, false);
+    parcTimer_ScheduleAfterDelay(timer, task, 20);
+
+    assertTrue(_timerTestAwaitCount(count, 1), "Expected the uncancelled task to run.");
+    usleep(20000);
+    assertTrue(parcAtomicUint64_GetValue(count) == 1, "Expected the cancelled task not to run, count %" PRIu64, parcAtomicUint64_GetValue(count));
+    assertTrue(parcTimer_GetScheduledCount(timer) == 0, "Expected expired tasks to be removed.");
+
+    parcFutureTask_Release(&cancelled);
+    parcFutureTask_Release(&task);
+    parcTimer_Release(&timer);
+    parcAtomicUint64_Release(&count);
+}
+
+LONGBOW_TEST_CASE(Specialization, parcTimer_Purge)
+{
+    PARCAtomicUint64 *count = parcAtomicUint64_Create(0);
+    PARCTimer *timer = parcTimer_Create();
+
+    PARCFutureTask *tasks[10];
+    for (int i = 0; i < 10; i++) {
+        tasks[i] = parcFutureTask_Create(_timerTestFunction, count);
+        parcTimer_ScheduleAfterDelay(timer, tasks[i], 1000 + i * 100000);
+    }
+    for (int i = 0; i < 10; i += 2) {
+        parcFutureTask_Cancel(tasks[i], false);
+    }
+
+    assertTrue(parcTimer_GetScheduledCount(timer) == 10, "Expected cancelled tasks to remain until purged.");
+    int purged = parcTimer_Purge(timer);
+    assertTrue(purged == 5, "Expected 5 tasks to be purged, actual %d", purged);
+    assertTrue(parcTimer_GetScheduledCount(timer) == 5, "Expected 5 remaining tasks.");
+    assertTrue(parcTimer_Purge(timer) == 0, "Expected nothing further to purge.");
+
+    for (int i = 0; i < 10; i++) {
+        parcFutureTask_Release(&tasks[i]);
+    }
+    parcTimer_Release(&timer);
+    assertTrue(parcAtomicUint64_GetValue(count) == 0, "Expected no task to have run.");
+    parcAtomicUint64_Release(&count);
+}
+
+LONGBOW_TEST_CASE(Specialization, parcTimer_Cancel)
+{
+    PARCAtomicUint64 *count = parcAtomicUint64_Create(0);
+    PARCTimer *timer = parcTimer_Create();
+    PARCFutureTask *task = parcFutureTask_Create(_timerTestFunction, count);
+
+    parcTimer_ScheduleAfterDelay(timer, task, 10000);
+    parcTimer_ScheduleAfterDelay(timer, task, 20000);
+
+    parcTimer_Cancel(timer);
+    assertTrue(parcTimer_GetScheduledCount(timer) == 0, "Expected all tasks to be discarded.");
+    parcTimer_Cancel(timer);
+
+    parcFutureTask_Release(&task);
+    parcTimer_Release(&timer);
+    parcAtomicUint64_Release(&count);
+}
+
+LONGBOW_TEST_CASE(Specialization, parcTimer_CreateWithThreadPool)
+{
+    PARCAtomicUint64 *count = parcAtomicUint64_Create(0);
+    PARCThreadPool *pool = parcThreadPool_Create(2);
+    PARCTimer *timer = parcTimer_CreateWithThreadPool(pool);
+
+    PARCFutureTask *tasks[5];
+    for (int i = 0; i < 5; i++) {
+        tasks[i] = parcFutureTask_Create(_timerTestFunction, count);
+        parcTimer_ScheduleAfterDelay(timer, tasks[i], i);
+    }
+
+    assertTrue(_timerTestAwaitCount(count, 5), "Expected all tasks to run on the pool, ran %" PRIu64, parcAtomicUint64_GetValue(count));
+
+    parcTimer_Release(&timer);
+    for (int i = 0; i < 5; i++) {
+        parcFutureTask_Release(&tasks[i]);
+    }
+    parcThreadPool_ShutdownNow(pool);
+    parcThreadPool_Release(&pool);
+    parcAtomicUint64_Release(&count);
+}
+
+typedef struct {
+    PARCAtomicUint64 *count;
+    int running;
+    int maxRunning;
+} _OverlapTest;
+
+static void *
+_timerTestSlowFunction(PARCFutureTask *task, void *parameter)
+{
+    _OverlapTest *test = parameter;
+
+    int running = __atomic_add_fetch(&test->running, 1, __ATOMIC_SEQ_CST);
+    if (running > test->maxRunning) {
+        test->maxRunning = running;
+    }
+    usleep(20000);
+    __atomic_sub_fetch(&test->running, 1, __ATOMIC_SEQ_CST);
+
+    parcAtomicUint64_Increment(test->count);
+    return NULL;
+}
+
+LONGBOW_TEST_CASE(Specialization, parcTimer_CreateWithThreadPool_Repeat)
+{
+    _OverlapTest test = { .count = parcAtomicUint64_Create(0), .running = 0, .maxRunning = 0 };
+    PARCThreadPool *pool = parcThreadPool_Create(4);
+    PARCTimer *timer = parcTimer_CreateWithThreadPool(pool);
+    PARCFutureTask *task = parcFutureTask_Create(_timerTestSlowFunction, &test);
+
+    // The period is much shorter than the task, so runs would overlap if the task were re-armed before it finished.
+    parcTimer_ScheduleAfterDelayAndRepeat(timer, task, 1, 1);
+    assertTrue(_timerTestAwaitCount(test.count, 4), "Expected the task to run repeatedly, ran %" PRIu64 " times.",
+               parcAtomicUint64_GetValue(test.count));
+    assertTrue(test.maxRunning == 1, "Expected runs of a periodic task never to overlap, %d did", test.maxRunning);
+    assertFalse(parcFutureTask_IsDone(task), "Expected a periodic task to be reset after each run.");
+
+    parcTimer_Release(&timer);
+    assertTrue(test.running == 0, "Expected releasing the timer to wait for the pooled run.");
+
+    parcFutureTask_Release(&task);
+    parcThreadPool_ShutdownNow(pool);
+    parcThreadPool_Release(&pool);
+    parcAtomicUint64_Release(&test.count);
+}
+
+LONGBOW_TEST_FIXTURE(Wheel)
+{
+    LONGBOW_RUN_TEST_CASE(Wheel, Advance_Cascade);
+    LONGBOW_RUN_TEST_CASE(Wheel, Advance_Overdue);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Wheel)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Wheel)
+{
+    if (!parcMemoryTesting_ExpectedOutstanding(0, "%s mismanaged memory.", longBowTestCase_GetFullName(testCase))) {
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// Insert an entry directly into the wheel, bypassing the background thread.
+static void
+_wheelTest_Insert(PARCTimer *timer, PARCFutureTask *task, uint64_t expiration)
+{
+    _PARCTimerEntry *entry = _parcTimer_AllocateEntry(timer);
+    entry->expiration = expiration;
+    entry->period = 0;
+    entry->task = parcFutureTask_Acquire(task);
+    _parcTimer_Place(timer, entry);
+    timer->scheduledCount++;
+}
+
+static size_t
+_wheelTest_Drain(PARCTimer *timer, _PARCTimerEntry *expired, uint64_t now)
+{
+    size_t result = 0;
+    while (!_parcTimerEntry_ListIsEmpty(expired)) {
+        _PARCTimerEntry *entry = expired->next;
+        assertTrue(entry->expiration <= now, "Entry expiring at %" PRIu64 " dispatched early at %" PRIu64, entry->expiration, now);
+        _parcTimerEntry_Unlink(entry);
+        timer->scheduledCount--;
+        parcFutureTask_Release(&entry->task);
+        _parcTimer_FreeEntry(timer, entry);
+        result++;
+    }
+    return result;
+}
+
+LONGBOW_TEST_CASE(Wheel, Advance_Cascade)
+{
+    PARCAtomicUint64 *count = parcAtomicUint64_Create(0);
+    PARCTimer *timer = parcTimer_Create();
+    PARCFutureTask *task = parcFutureTask_Create(_timerTestFunction, count);
+
+    // One expiration in each level of the wheel.
+    uint64_t base = timer->currentTick;
+    uint64_t delays[] = { 1, 300, 70000, 17000000 };
+    for (size_t i = 0; i < sizeof(delays) / sizeof(delays[0]); i++) {
+        _wheelTest_Insert(timer, task, base + delays[i]);
+    }
+
+    _PARCTimerEntry expired;
+    _parcTimerEntry_InitList(&expired);
+    for (size_t i = 0; i < sizeof(delays) / sizeof(delays[0]); i++) {
+        _parcTimer_Advance(timer, base + delays[i] - 1, &expired);
+        assertTrue(_wheelTest_Drain(timer, &expired, base + delays[i] - 1) == 0, "Expected nothing to expire before %" PRIu64, delays[i]);
+
+        _parcTimer_Advance(timer, base + delays[i], &expired);
+        assertTrue(_wheelTest_Drain(timer, &expired, base + delays[i]) == 1, "Expected one expiration at %" PRIu64, delays[i]);
+    }
+    assertTrue(timer->scheduledCount == 0, "Expected the wheel to be empty.");
+
+    parcFutureTask_Release(&task);
+    parcTimer_Release(&timer);
+    parcAtomicUint64_Release(&count);
+}
+
+LONGBOW_TEST_CASE(Wheel, Advance_Overdue)
+{
+    PARCAtomicUint64 *count = parcAtomicUint64_Create(0);
+    PARCTimer *timer = parcTimer_Create();
+    PARCFutureTask *task = parcFutureTask_Create(_timerTestFunction, count);
+
+    uint64_t base = timer->currentTick;
+    _wheelTest_Insert(timer, task, base - 100);
+    _wheelTest_Insert(timer, task, base + 1000);
+
+    _PARCTimerEntry expired;
+    _parcTimerEntry_InitList(&expired);
+    _parcTimer_Advance(timer, base, &expired);
+    assertTrue(_wheelTest_Drain(timer, &expired, base) == 1, "Expected the overdue entry to expire at once.");
+
+    // Catching up over a long interval must still expire everything that is due.
+    _parcTimer_Advance(timer, base + 5000, &expired);
+    assertTrue(_wheelTest_Drain(timer, &expired, base + 5000) == 1, "Expected the remaining entry to expire.");
+
+    parcFutureTask_Release(&task);
+    parcTimer_Release(&timer);
+    parcAtomicUint64_Release(&count);
+}
+
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, parcTimer_ScheduleCancel);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    parcMemory_SetInterface(&PARCStdlibMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+#define PERFORMANCE_TIMERS 1000000
+
+static double
+_performance_Elapsed(const struct timeval *start)
+{
+    struct timeval end, elapsed;
+    gettimeofday(&end, NULL);
+    timersub(&end, start, &elapsed);
+    return elapsed.tv_sec + elapsed.tv_usec / 1000000.0;
+}
+
+LONGBOW_TEST_CASE(Performance, parcTimer_ScheduleCancel)
+{
+    PARCAtomicUint64 *count = parcAtomicUint64_Create(0);
+    PARCTimer *timer = parcTimer_Create();
+
+    PARCFutureTask **tasks = parcMemory_Allocate(PERFORMANCE_TIMERS * sizeof(PARCFutureTask *));
+    for (int i = 0; i < PERFORMANCE_TIMERS; i++) {
+        tasks[i] = parcFutureTask_Create(_timerTestFunction, count);
+    }
+
+    // Spread the expirations over an hour so every level of the wheel below the top is populated.
+    struct timeval start;
+    gettimeofday(&start, NULL);
+    for (int i = 0; i < PERFORMANCE_TIMERS; i++) {
+        parcTimer_ScheduleAfterDelay(timer, tasks[i], 1000 + (i % 3600000));
+    }
+    double seconds = _performance_Elapsed(&start);
+    printf("parcTimer_ScheduleAfterDelay: %d timers in %.6f seconds (%.0f/second)\n", PERFORMANCE_TIMERS, seconds, PERFORMANCE_TIMERS / seconds);
+
+    gettimeofday(&start, NULL);
+    for (int i = 0; i < PERFORMANCE_TIMERS; i++) {
+        parcFutureTask_Cancel(tasks[i], false);
+    }
+    seconds = _performance_Elapsed(&start);
+    printf("parcFutureTask_Cancel: %d timers in %.6f seconds (%.0f/second)\n", PERFORMANCE_TIMERS, seconds, PERFORMANCE_TIMERS / seconds);
+
+    gettimeofday(&start, NULL);
+    int purged = parcTimer_Purge(timer);
+    seconds = _performance_Elapsed(&start);
+    printf("parcTimer_Purge: %d timers in %.6f seconds\n", purged, seconds);
+
+    parcTimer_Release(&timer);
+    for (int i = 0; i < PERFORMANCE_TIMERS; i++) {
+        parcFutureTask_Release(&tasks[i]);
+    }
+    parcMemory_Deallocate(&tasks);
+    parcAtomicUint64_Release(&count);
+}
+
 int
 main(int argc, char *argv[argc])
 {
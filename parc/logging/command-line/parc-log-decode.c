@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2015, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * Render binary logs written by PARCLogFormatBinary as text or syslog lines.
+ *
+ * @author Glenn Scott, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include <config.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <parc/algol/parc_Buffer.h>
+#include <parc/logging/parc_LogFormatBinary.h>
+#include <parc/logging/parc_LogFormatSyslog.h>
+#include <parc/logging/parc_LogFormatText.h>
+
+typedef struct {
+    PARCBuffer *(*formatEntry)(const PARCLogEntry *entry);
+} _Renderer;
+
+static bool
+_writeEntry(void *context, const PARCLogEntry *entry)
+{
+    _Renderer *renderer = context;
+
+    PARCBuffer *formatted = renderer->formatEntry(entry);
+    bool result = fwrite(parcBuffer_Overlay(formatted, 0), 1, parcBuffer_Remaining(formatted), stdout) == parcBuffer_Remaining(formatted);
+    parcBuffer_Release(&formatted);
+    return result;
+}
+
+static PARCBuffer *
+_readFile(const char *fileName)
+{
+    int fd = open(fileName, O_RDONLY);
+    if (fd < 0) {
+        return NULL;
+    }
+
+    PARCBuffer *result = NULL;
+    struct stat statbuf;
+    if (fstat(fd, &statbuf) == 0) {
+        result = parcBuffer_Allocate((size_t) statbuf.st_size);
+        while (parcBuffer_Remaining(result) > 0) {
+            ssize_t nread = read(fd, parcBuffer_Overlay(result, 0), parcBuffer_Remaining(result));
+            if (nread < 0 && errno == EINTR) {
+                continue;
+            }
+            if (nread <= 0) {
+                break;
+            }
+            parcBuffer_SetPosition(result, parcBuffer_Position(result) + nread);
+        }
+        parcBuffer_Flip(result);
+    }
+    close(fd);
+    return result;
+}
+
+void
+printUsage(char *progName)
+{
+    printf("usage: %s [-h | --help] [-t | --text | -s | --syslog] fileName...\n", progName);
+    printf("\n");
+    printf("Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).\n");
+    printf("\n");
+    printf("All Rights Reserved. Use is subject to license terms.\n");
+    printf("\n");
+    printf("Render binary logs written by PARCLogFormatBinary.\n");
+    printf("\n");
+    printf("optional arguments:\n");
+    printf("\t-h, --help\tShow this help message and exit\n");
+    printf("\t-t, --text\tRender each message as parcLogFormatText does (the default)\n");
+    printf("\t-s, --syslog\tRender each message as an RFC 5424 syslog line, as parcLogFormatSyslog does\n");
+    printf("\n");
+    printf("\t\t\texample: ./parc-log-decode -s myApp.plog\n");
+    printf("\n");
+}
+
+int
+main(int argc, char *argv[])
+{
+    char *programName = "parc-log-decode";
+    _Renderer renderer = { .formatEntry = parcLogFormatText_FormatEntry };
+
+    int first = 1;
+    if (argc > 1) {
+        char *arg = argv[1];
+        if (strcmp(arg, "-h") == 0 || strcmp(arg, "--help") == 0) {
+            printUsage(programName);
+            return 0;
+        } else if (strcmp(arg, "-t") == 0 || strcmp(arg, "--text") == 0) {
+            first = 2;
+        } else if (strcmp(arg, "-s") == 0 || strcmp(arg, "--syslog") == 0) {
+            renderer.formatEntry = parcLogFormatSyslog_FormatEntry;
+            first = 2;
+        }
+    }
+    if (first >= argc) {
+        printUsage(programName);
+        exit(1);
+    }
+
+    int status = 0;
+    for (int i = first; i < argc; i++) {
+        PARCBuffer *contents = _readFile(argv[i]);
+        if (contents == NULL) {
+            fprintf(stderr, "Error: %s %s\n", argv[i], strerror(errno));
+            status = 1;
+            continue;
+        }
+        if (!parcLogFormatBinary_Decode(contents, _writeEntry, &renderer)) {
+            fprintf(stderr, "Error: %s is not a complete binary log, stopped at byte %zu\n",
+                    argv[i], parcBuffer_Position(contents));
+            status = 1;
+        }
+        parcBuffer_Release(&contents);
+    }
+
+    return status;
+}
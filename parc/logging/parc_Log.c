@@ -58,6 +58,7 @@
  */
 #include <config.h>
 
+#include <inttypes.h>
 #include <stdio.h>
 #include <sys/time.h>
 
@@ -76,6 +77,7 @@ struct PARCLog {
     uint64_t messageId;
     PARCLogLevel level;
     PARCLogReporter *reporter;
+    PARCLogFormatBinary *binary;
 };
 
 static void
@@ -87,6 +89,9 @@ _parcLogger_Destroy(PARCLog **loggerPtr)
     parcMemory_Deallocate((void **) &logger->applicationName);
     parcMemory_Deallocate((void **) &logger->processId);
     parcLogReporter_Release(&logger->reporter);
+    if (logger->binary != NULL) {
+        parcLogFormatBinary_Release(&logger->binary);
+    }
 }
 
 parcObject_ExtendPARCObject(PARCLog, _parcLogger_Destroy, NULL, NULL, NULL, NULL, NULL, NULL);
@@ -117,6 +122,7 @@ parcLog_Create(const char *hostName, const char *applicationName, const char *pr
     result->messageId = 0;
     result->level = PARCLogLevel_Off;
     result->reporter = parcLogReporter_Acquire(reporter);
+    result->binary = NULL;
     return result;
 }
 
@@ -139,6 +145,34 @@ parcLog_SetLevel(PARCLog *logger, const PARCLogLevel level)
     return oldLevel;
 }
 
+void
+parcLog_SetFormatBinary(PARCLog *log, PARCLogFormatBinary *binary)
+{
+    if (log->binary != NULL) {
+        parcLogFormatBinary_Release(&log->binary);
+    }
+    if (binary != NULL) {
+        log->binary = parcLogFormatBinary_Acquire(binary);
+    }
+}
+
+PARCLogFormatBinary *
+parcLog_GetFormatBinary(const PARCLog *log)
+{
+    return log->binary;
+}
+
+static bool
+_parcLog_MessageBinary(PARCLog *log, PARCLogLevel level, uint64_t messageId, const char *format, va_list ap)
+{
+    va_list copy;
+    va_copy(copy, ap);
+    bool result = parcLogFormatBinary_MessageVaList(log->binary, level, messageId, format, copy);
+    va_end(copy);
+
+    return result;
+}
+
 static PARCLogEntry *
 _parcLog_CreateEntry(PARCLog *log, PARCLogLevel level, uint64_t messageId, const char *format, va_list ap)
 {
@@ -169,10 +203,12 @@ parcLog_MessageVaList(PARCLog *log, PARCLogLevel level, uint64_t messageId, cons
     bool result = false;
 
     if (parcLog_IsLoggable(log, level)) {
-        PARCLogEntry *entry = _parcLog_CreateEntry(log, level, messageId, format, ap);
+        if (log->binary == NULL || !_parcLog_MessageBinary(log, level, messageId, format, ap)) {
+            PARCLogEntry *entry = _parcLog_CreateEntry(log, level, messageId, format, ap);
 
-        parcLogReporter_Report(log->reporter, entry);
-        parcLogEntry_Release(&entry);
+            parcLogReporter_Report(log->reporter, entry);
+            parcLogEntry_Release(&entry);
+        }
         result = true;
     }
     return result;
@@ -189,6 +225,38 @@ parcLog_Message(PARCLog *log, PARCLogLevel level, uint64_t messageId, const char
     return result;
 }
 
+bool
+parcLog_MessageLimitedVaList(PARCLog *log, PARCLogRateLimit *limit, PARCLogLevel level, uint64_t messageId,
+                             const char *format, va_list ap)
+{
+    bool result = false;
+
+    uint64_t suppressed;
+    if (parcLog_IsLoggable(log, level) && parcLogRateLimit_Admit(limit, &suppressed)) {
+        if (suppressed > 0) {
+            if (limit->file != NULL) {
+                parcLog_Message(log, level, messageId, "%" PRIu64 " similar messages suppressed at %s:%d",
+                                suppressed, limit->file, limit->line);
+            } else {
+                parcLog_Message(log, level, messageId, "%" PRIu64 " similar messages suppressed", suppressed);
+            }
+        }
+        result = parcLog_MessageVaList(log, level, messageId, format, ap);
+    }
+    return result;
+}
+
+bool
+parcLog_MessageLimited(PARCLog *log, PARCLogRateLimit *limit, PARCLogLevel level, uint64_t messageId, const char *format, ...)
+{
+    va_list ap;
+    va_start(ap, format);
+    bool result = parcLog_MessageLimitedVaList(log, limit, level, messageId, format, ap);
+    va_end(ap);
+
+    return result;
+}
+
 bool
 parcLog_Warning(PARCLog *logger, const char *format, ...)
 {
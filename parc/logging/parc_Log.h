@@ -78,6 +78,8 @@
 #include <stdarg.h>
 
 #include <parc/logging/parc_LogReporter.h>
+#include <parc/logging/parc_LogFormatBinary.h>
+#include <parc/logging/parc_LogRateLimit.h>
 #include <parc/logging/parc_LogEntry.h>
 #include <parc/logging/parc_LogLevel.h>
 
@@ -247,6 +249,42 @@ PARCLogLevel parcLog_SetLevel(PARCLog *log, const PARCLogLevel level);
  */
 PARCLogLevel parcLog_GetLevel(const PARCLog *log);
 
+/**
+ * Send the messages whose identifiers are registered with the given PARCLogFormatBinary to it, instead of the PARCLogReporter.
+ *
+ * A message logged with a registered `messageId` and the format registered for it is appended to the
+ * binary log without being formatted.
+ * Every other message is formatted and reported as before.
+ * Supplying NULL turns the binary format off.
+ *
+ * @param [in] log A pointer to valid instance of PARCLog.
+ * @param [in] binary A pointer to a valid PARCLogFormatBinary instance, or NULL.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCLogFormatBinary *binary = parcLogFormatBinary_Create(fd, "localhost", "myApp", "daemon");
+ *     parcLogFormatBinary_Register(binary, 42, "Received %zu bytes from %s");
+ *
+ *     parcLog_SetFormatBinary(log, binary);
+ *     parcLogFormatBinary_Release(&binary);
+ *
+ *     parcLog_Message(log, PARCLogLevel_Debug, 42, "Received %zu bytes from %s", length, peerName);
+ * }
+ * @endcode
+ */
+void parcLog_SetFormatBinary(PARCLog *log, PARCLogFormatBinary *binary);
+
+/**
+ * Get the PARCLogFormatBinary set by `parcLog_SetFormatBinary`.
+ *
+ * @param [in] log A pointer to valid instance of PARCLog.
+ *
+ * @return NULL The log does not use a binary format.
+ * @return non-NULL The PARCLogFormatBinary instance, which the caller must acquire to keep.
+ */
+PARCLogFormatBinary *parcLog_GetFormatBinary(const PARCLog *log);
+
 /**
  * Test if a PARCLogLevel would be logged by the current state of the given PARCLog instance.
  *
@@ -280,7 +318,7 @@ PARCLogLevel parcLog_GetLevel(const PARCLog *log);
  */
 
 #define parcLog_IsLoggable(_log_, _level_) \
-    (_level_ == PARCLogLevel_Emergency) || (parcLogLevel_Compare(parcLog_GetLevel(_log_), _level_) >= 0)
+    (((_level_) == PARCLogLevel_Emergency) || (parcLogLevel_Compare(parcLog_GetLevel(_log_), _level_) >= 0))
 //bool parcLog_IsLoggable(const PARCLog *log, const PARCLogLevel level);
 
 /**
@@ -321,6 +359,164 @@ bool parcLog_MessageVaList(PARCLog *log, PARCLogLevel level, uint64_t messageId,
  */
 bool parcLog_Message(PARCLog *log, PARCLogLevel level, uint64_t messageId, const char * restrict format, ...);
 
+/**
+ * Compose and emit a log message if the given PARCLogRateLimit admits it.
+ *
+ * The message is first subject to the log severity threshold, in the same way as `parcLog_MessageVaList`;
+ * only a message that would be logged is offered to the rate limit.
+ * If the rate limit suppressed any messages since it last admitted one,
+ * a summary line with their number is logged before the message.
+ *
+ * Most callers use one of the `parcLog_...RateLimited` or `parcLog_MessageSampled` macros,
+ * which declare a static PARCLogRateLimit for the call site.
+ *
+ * @param [in] log A pointer to a valid PARCLog instance.
+ * @param [in,out] limit A pointer to a valid PARCLogRateLimit.
+ * @param [in] level An instance of PARCLogLevel.
+ * @param [in] messageId A value for the message identifier.
+ * @param [in] format A pointer to a nul-terminated C string containing a printf format specification.
+ * @param [in] ap A `va_list` representing the parameters for the format specification.
+ *
+ * @return true The message was logged.
+ * @return false The message was not logged, because of the severity threshold or the rate limit.
+ *
+ * Example:
+ * @code
+ * {
+ *     static PARCLogRateLimit limit = parcLogRateLimit_Initializer(10, 5, 1);
+ *
+ *     parcLog_MessageLimitedVaList(log, &limit, PARCLogLevel_Warning, 0, format, ap);
+ * }
+ * @endcode
+ */
+bool parcLog_MessageLimitedVaList(PARCLog *log, PARCLogRateLimit *limit, PARCLogLevel level, uint64_t messageId,
+                                  const char *format, va_list ap);
+
+/**
+ * Compose and emit a log message if the given PARCLogRateLimit admits it.
+ *
+ * See `parcLog_MessageLimitedVaList`.
+ *
+ * @param [in] log A pointer to a valid PARCLog instance.
+ * @param [in,out] limit A pointer to a valid PARCLogRateLimit.
+ * @param [in] level An instance of PARCLogLevel.
+ * @param [in] messageId A value for the message identifier.
+ * @param [in] format A pointer to a nul-terminated C string containing a printf format specification.
+ * @param [in] ... Zero or more parameters as input for the format specification).
+ *
+ * @return true The message was logged.
+ * @return false The message was not logged, because of the severity threshold or the rate limit.
+ *
+ * Example:
+ * @code
+ * {
+ *     static PARCLogRateLimit limit = parcLogRateLimit_Initializer(10, 5, 1);
+ *
+ *     parcLog_MessageLimited(log, &limit, PARCLogLevel_Warning, 0, "Bad packet from %s", peerName);
+ * }
+ * @endcode
+ */
+bool parcLog_MessageLimited(PARCLog *log, PARCLogRateLimit *limit, PARCLogLevel level, uint64_t messageId,
+                            const char * restrict format, ...);
+
+/**
+ * Compose and emit a log message, limited to a rate for this call site.
+ *
+ * The macro declares a static PARCLogRateLimit for the call site (see {@link parcLogRateLimit_Initializer})
+ * and calls `parcLog_MessageLimited`.  It is a statement, not an expression.
+ *
+ * @param [in] _log_ A pointer to a valid PARCLog instance.
+ * @param [in] _level_ An instance of PARCLogLevel.
+ * @param [in] _messageId_ A value for the message identifier.
+ * @param [in] _perSecond_ The long-term number of messages logged per second from this call site.
+ * @param [in] _burst_ The number of messages that may be logged at once after a quiet period.
+ * @param [in] ... A printf format specification and zero or more parameters for it.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcLog_MessageRateLimited(log, PARCLogLevel_Warning, 42, 10, 5, "Bad packet from %s", peerName);
+ * }
+ * @endcode
+ */
+#define parcLog_MessageRateLimited(_log_, _level_, _messageId_, _perSecond_, _burst_, ...) \
+    do { \
+        static PARCLogRateLimit _parcLog_RateLimit = parcLogRateLimit_Initializer(_perSecond_, _burst_, 1); \
+        parcLog_MessageLimited(_log_, &_parcLog_RateLimit, _level_, _messageId_, __VA_ARGS__); \
+    } while (0)
+
+/**
+ * Compose and emit one log message in every `_sampleEvery_` from this call site.
+ *
+ * The macro declares a static PARCLogRateLimit for the call site (see {@link parcLogRateLimit_Initializer})
+ * and calls `parcLog_MessageLimited`.  It is a statement, not an expression.
+ *
+ * @param [in] _log_ A pointer to a valid PARCLog instance.
+ * @param [in] _level_ An instance of PARCLogLevel.
+ * @param [in] _messageId_ A value for the message identifier.
+ * @param [in] _sampleEvery_ Log one message in this many.
+ * @param [in] ... A printf format specification and zero or more parameters for it.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcLog_MessageSampled(log, PARCLogLevel_Debug, 0, 1000, "Forwarded packet %" PRIu64, sequence);
+ * }
+ * @endcode
+ */
+#define parcLog_MessageSampled(_log_, _level_, _messageId_, _sampleEvery_, ...) \
+    do { \
+        static PARCLogRateLimit _parcLog_RateLimit = parcLogRateLimit_Initializer(0, 1, _sampleEvery_); \
+        parcLog_MessageLimited(_log_, &_parcLog_RateLimit, _level_, _messageId_, __VA_ARGS__); \
+    } while (0)
+
+/**
+ * Compose and emit a PARCLogLevel_Error message, limited to a rate for this call site.
+ *
+ * See `parcLog_MessageRateLimited`.
+ */
+#define parcLog_ErrorRateLimited(_log_, _perSecond_, _burst_, ...) \
+    parcLog_MessageRateLimited(_log_, PARCLogLevel_Error, 0, _perSecond_, _burst_, __VA_ARGS__)
+
+/**
+ * Compose and emit a PARCLogLevel_Warning message, limited to a rate for this call site.
+ *
+ * See `parcLog_MessageRateLimited`.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcLog_WarningRateLimited(log, 10, 5, "Bad packet from %s", peerName);
+ * }
+ * @endcode
+ */
+#define parcLog_WarningRateLimited(_log_, _perSecond_, _burst_, ...) \
+    parcLog_MessageRateLimited(_log_, PARCLogLevel_Warning, 0, _perSecond_, _burst_, __VA_ARGS__)
+
+/**
+ * Compose and emit a PARCLogLevel_Notice message, limited to a rate for this call site.
+ *
+ * See `parcLog_MessageRateLimited`.
+ */
+#define parcLog_NoticeRateLimited(_log_, _perSecond_, _burst_, ...) \
+    parcLog_MessageRateLimited(_log_, PARCLogLevel_Notice, 0, _perSecond_, _burst_, __VA_ARGS__)
+
+/**
+ * Compose and emit a PARCLogLevel_Info message, limited to a rate for this call site.
+ *
+ * See `parcLog_MessageRateLimited`.
+ */
+#define parcLog_InfoRateLimited(_log_, _perSecond_, _burst_, ...) \
+    parcLog_MessageRateLimited(_log_, PARCLogLevel_Info, 0, _perSecond_, _burst_, __VA_ARGS__)
+
+/**
+ * Compose and emit a PARCLogLevel_Debug message, limited to a rate for this call site.
+ *
+ * See `parcLog_MessageRateLimited`.
+ */
+#define parcLog_DebugRateLimited(_log_, _perSecond_, _burst_, ...) \
+    parcLog_MessageRateLimited(_log_, PARCLogLevel_Debug, 0, _perSecond_, _burst_, __VA_ARGS__)
+
 /**
  * Compose and emit a PARCLogLevel_Warning message.
  *
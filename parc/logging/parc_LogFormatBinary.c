@@ -0,0 +1,1058 @@
+/*
+ * Copyright (c) 2015, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * A binary log is a file header followed by records.
+ *
+ * The file header is the magic "PARCLOGB", a one byte version, the 16-bit value 0x0102 in the byte order of the writer,
+ * and the host, application and process names, each as a 16-bit length followed by that many bytes.
+ *
+ * Every record is a one byte type and a 32-bit length, followed by that many bytes of body.
+ * A definition record holds a 64-bit message identifier, a 32-bit length and the bytes of the format string.
+ * A message record holds a 64-bit timestamp in nanoseconds since the epoch, the 64-bit message identifier,
+ * the one byte level, and then one value for each conversion in the format:
+ * 8 bytes for integers, characters, pointers and doubles, or a 32-bit length and the bytes of a string.
+ * All multi-byte values are in the byte order of the writer, and unaligned.
+ *
+ * Definitions are looked up in an open-addressing table that readers search without locking.
+ * Registration, which is rare, takes a mutex, and publishes a new slot, or a whole new table when the table
+ * must grow, with a release store.  Tables that have been replaced are kept until the instance is destroyed,
+ * because a reader may still be searching one.
+ *
+ * Each thread appends records to its own buffer under its own, uncontended, mutex.  Buffers are written whole,
+ * under a mutex for the file descriptor, so records from different threads never interleave within a record.
+ * The lock order is: the list of buffers, then a buffer, then the file descriptor.
+ *
+ * @author Glenn Scott, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include <config.h>
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/time.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <LongBow/runtime.h>
+
+#include <parc/logging/parc_LogFormatBinary.h>
+
+#include <parc/algol/parc_BufferComposer.h>
+#include <parc/algol/parc_Memory.h>
+#include <parc/algol/parc_Object.h>
+
+#define _parcLogFormatBinary_Magic "PARCLOGB"
+#define _parcLogFormatBinary_MagicLength 8
+#define _parcLogFormatBinary_Version 1
+#define _parcLogFormatBinary_ByteOrderMark 0x0102
+#define _parcLogFormatBinary_BufferSize (64 * 1024)
+#define _parcLogFormatBinary_MaxConversions 32
+#define _parcLogFormatBinary_MaxSpecificationLength 32
+#define _parcLogFormatBinary_InitialTableSize 64
+
+typedef enum {
+    _PARCLogFormatBinaryRecord_Definition = 1,
+    _PARCLogFormatBinaryRecord_Message = 2
+} _PARCLogFormatBinaryRecord;
+
+// The record type and the length of the record body.
+#define _parcLogFormatBinary_RecordHeaderSize (1 + 4)
+
+// The timestamp, message identifier and level that start a message record.
+#define _parcLogFormatBinary_MessageHeaderSize (8 + 8 + 1)
+
+typedef enum {
+    _PARCLogFormatBinaryKind_Signed,
+    _PARCLogFormatBinaryKind_Unsigned,
+    _PARCLogFormatBinaryKind_Char,
+    _PARCLogFormatBinaryKind_Double,
+    _PARCLogFormatBinaryKind_String,
+    _PARCLogFormatBinaryKind_Pointer
+} _PARCLogFormatBinaryKind;
+
+typedef enum {
+    _PARCLogFormatBinaryLength_None,
+    _PARCLogFormatBinaryLength_hh,
+    _PARCLogFormatBinaryLength_h,
+    _PARCLogFormatBinaryLength_l,
+    _PARCLogFormatBinaryLength_ll,
+    _PARCLogFormatBinaryLength_z,
+    _PARCLogFormatBinaryLength_j,
+    _PARCLogFormatBinaryLength_t
+} _PARCLogFormatBinaryLength;
+
+/*
+ * One conversion specification in a format string: format[start] is the '%' and format[end - 1] the conversion
+ * character.  The length modifier, if any, occupies modifierSize characters from format[modifierStart].
+ */
+typedef struct {
+    size_t start;
+    size_t end;
+    size_t modifierStart;
+    size_t modifierSize;
+    _PARCLogFormatBinaryKind kind;
+    _PARCLogFormatBinaryLength length;
+} _PARCLogFormatBinaryConversion;
+
+typedef struct {
+    uint64_t messageId;
+    char *format;
+    size_t conversionCount;
+    _PARCLogFormatBinaryConversion conversions[_parcLogFormatBinary_MaxConversions];
+} _PARCLogFormatBinaryDefinition;
+
+typedef struct _PARCLogFormatBinaryTable {
+    size_t mask;
+    size_t count;
+    struct _PARCLogFormatBinaryTable *replaced;
+    _PARCLogFormatBinaryDefinition *slots[];
+} _PARCLogFormatBinaryTable;
+
+typedef struct _PARCLogFormatBinaryThreadBuffer {
+    PARCLogFormatBinary *binary;
+    pthread_mutex_t lock;
+    struct _PARCLogFormatBinaryThreadBuffer *previous;
+    struct _PARCLogFormatBinaryThreadBuffer *next;
+    size_t length;
+    uint8_t data[_parcLogFormatBinary_BufferSize];
+} _PARCLogFormatBinaryThreadBuffer;
+
+struct PARCLogFormatBinary {
+    int fd;
+    pthread_key_t key;
+
+    pthread_mutex_t registryLock;
+    _PARCLogFormatBinaryTable *table;
+
+    pthread_mutex_t listLock;
+    _PARCLogFormatBinaryThreadBuffer *buffers;
+
+    pthread_mutex_t writeLock;
+};
+
+/*
+ * Parse a printf format string into its conversions.
+ * Return false if it uses anything that cannot be captured as raw values and rendered later.
+ */
+static bool
+_parcLogFormatBinary_ParseFormat(const char *format, _PARCLogFormatBinaryConversion conversions[], size_t *countPtr)
+{
+    size_t count = 0;
+    size_t i = 0;
+
+    while (format[i] != 0) {
+        if (format[i] != '%') {
+            i++;
+            continue;
+        }
+        size_t start = i++;
+        if (format[i] == '%') {
+            i++;
+            continue;
+        }
+        if (count == _parcLogFormatBinary_MaxConversions) {
+            return false;
+        }
+
+        while (format[i] != 0 && strchr("-+ #0'", format[i]) != NULL) {
+            i++;
+        }
+        if (format[i] == '*') {
+            return false;
+        }
+        while (format[i] >= '0' && format[i] <= '9') {
+            i++;
+        }
+        if (format[i] == '.') {
+            i++;
+            if (format[i] == '*') {
+                return false;
+            }
+            while (format[i] >= '0' && format[i] <= '9') {
+                i++;
+            }
+        }
+
+        _PARCLogFormatBinaryConversion *conversion = &conversions[count];
+        conversion->start = start;
+        conversion->modifierStart = i;
+        conversion->length = _PARCLogFormatBinaryLength_None;
+        switch (format[i]) {
+            case 'h':
+                conversion->length = _PARCLogFormatBinaryLength_h;
+                if (format[i + 1] == 'h') {
+                    conversion->length = _PARCLogFormatBinaryLength_hh;
+                    i++;
+                }
+                i++;
+                break;
+            case 'l':
+                conversion->length = _PARCLogFormatBinaryLength_l;
+                if (format[i + 1] == 'l') {
+                    conversion->length = _PARCLogFormatBinaryLength_ll;
+                    i++;
+                }
+                i++;
+                break;
+            case 'z':
+                conversion->length = _PARCLogFormatBinaryLength_z;
+                i++;
+                break;
+            case 'j':
+                conversion->length = _PARCLogFormatBinaryLength_j;
+                i++;
+                break;
+            case 't':
+                conversion->length = _PARCLogFormatBinaryLength_t;
+                i++;
+                break;
+            default:
+                break;
+        }
+        conversion->modifierSize = i - conversion->modifierStart;
+
+        bool hasModifier = conversion->length != _PARCLogFormatBinaryLength_None;
+        switch (format[i]) {
+            case 'd': case 'i':
+                conversion->kind = _PARCLogFormatBinaryKind_Signed;
+                break;
+            case 'o': case 'u': case 'x': case 'X':
+                conversion->kind = _PARCLogFormatBinaryKind_Unsigned;
+                break;
+            case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+                if (hasModifier && conversion->length != _PARCLogFormatBinaryLength_l) {
+                    return false;
+                }
+                conversion->kind = _PARCLogFormatBinaryKind_Double;
+                break;
+            case 'c':
+                conversion->kind = _PARCLogFormatBinaryKind_Char;
+                break;
+            case 's':
+                conversion->kind = _PARCLogFormatBinaryKind_String;
+                break;
+            case 'p':
+                conversion->kind = _PARCLogFormatBinaryKind_Pointer;
+                break;
+            default:
+                return false;
+        }
+        if (hasModifier && (conversion->kind == _PARCLogFormatBinaryKind_Char
+                            || conversion->kind == _PARCLogFormatBinaryKind_String
+                            || conversion->kind == _PARCLogFormatBinaryKind_Pointer)) {
+            return false;
+        }
+
+        conversion->end = ++i;
+        if (conversion->end - conversion->start > _parcLogFormatBinary_MaxSpecificationLength) {
+            return false;
+        }
+        count++;
+    }
+
+    *countPtr = count;
+    return true;
+}
+
+static size_t
+_parcLogFormatBinary_Hash(uint64_t messageId)
+{
+    return (size_t) ((messageId * 0x9e3779b97f4a7c15ULL) >> 32);
+}
+
+static _PARCLogFormatBinaryTable *
+_parcLogFormatBinaryTable_Create(size_t capacity)
+{
+    _PARCLogFormatBinaryTable *result =
+        parcMemory_AllocateAndClear(sizeof(_PARCLogFormatBinaryTable) + capacity * sizeof(_PARCLogFormatBinaryDefinition *));
+    assertNotNull(result, "parcMemory_AllocateAndClear returned NULL");
+    result->mask = capacity - 1;
+    return result;
+}
+
+static _PARCLogFormatBinaryDefinition *
+_parcLogFormatBinaryTable_Lookup(_PARCLogFormatBinaryTable *const *tablePtr, uint64_t messageId)
+{
+    _PARCLogFormatBinaryTable *table = __atomic_load_n(tablePtr, __ATOMIC_ACQUIRE);
+
+    for (size_t i = _parcLogFormatBinary_Hash(messageId) & table->mask;; i = (i + 1) & table->mask) {
+        _PARCLogFormatBinaryDefinition *definition = __atomic_load_n(&table->slots[i], __ATOMIC_ACQUIRE);
+        if (definition == NULL || definition->messageId == messageId) {
+            return definition;
+        }
+    }
+}
+
+static void
+_parcLogFormatBinaryTable_Place(_PARCLogFormatBinaryTable *table, _PARCLogFormatBinaryDefinition *definition)
+{
+    size_t i = _parcLogFormatBinary_Hash(definition->messageId) & table->mask;
+    while (table->slots[i] != NULL) {
+        i = (i + 1) & table->mask;
+    }
+    __atomic_store_n(&table->slots[i], definition, __ATOMIC_RELEASE);
+    table->count++;
+}
+
+/*
+ * Add a definition to the table, growing it to keep it at most half full.  The caller serialises insertions.
+ */
+static void
+_parcLogFormatBinaryTable_Insert(_PARCLogFormatBinaryTable **tablePtr, _PARCLogFormatBinaryDefinition *definition)
+{
+    _PARCLogFormatBinaryTable *table = *tablePtr;
+
+    if ((table->count + 1) * 2 > table->mask + 1) {
+        _PARCLogFormatBinaryTable *larger = _parcLogFormatBinaryTable_Create((table->mask + 1) * 2);
+        for (size_t i = 0; i <= table->mask; i++) {
+            if (table->slots[i] != NULL) {
+                _parcLogFormatBinaryTable_Place(larger, table->slots[i]);
+            }
+        }
+        larger->replaced = table;
+        __atomic_store_n(tablePtr, larger, __ATOMIC_RELEASE);
+        table = larger;
+    }
+
+    _parcLogFormatBinaryTable_Place(table, definition);
+}
+
+static void
+_parcLogFormatBinaryTable_Destroy(_PARCLogFormatBinaryTable **tablePtr)
+{
+    _PARCLogFormatBinaryTable *table = *tablePtr;
+
+    for (size_t i = 0; i <= table->mask; i++) {
+        _PARCLogFormatBinaryDefinition *definition = table->slots[i];
+        if (definition != NULL) {
+            parcMemory_Deallocate(&definition->format);
+            parcMemory_Deallocate(&definition);
+        }
+    }
+    while (table != NULL) {
+        _PARCLogFormatBinaryTable *replaced = table->replaced;
+        parcMemory_Deallocate(&table);
+        table = replaced;
+    }
+    *tablePtr = NULL;
+}
+
+/*
+ * Copy length bytes into a nul-terminated string.
+ * Unlike parcMemory_StringDuplicate, the bytes need not be nul-terminated themselves, as in a decoded record.
+ */
+static char *
+_parcLogFormatBinary_CopyString(const void *bytes, size_t length)
+{
+    char *result = parcMemory_Allocate(length + 1);
+    assertNotNull(result, "parcMemory_Allocate(%zu) returned NULL", length + 1);
+    memcpy(result, bytes, length);
+    result[length] = 0;
+    return result;
+}
+
+static _PARCLogFormatBinaryDefinition *
+_parcLogFormatBinaryDefinition_Create(uint64_t messageId, const char *format, size_t formatLength)
+{
+    _PARCLogFormatBinaryDefinition *result = parcMemory_AllocateAndClear(sizeof(_PARCLogFormatBinaryDefinition));
+    assertNotNull(result, "parcMemory_AllocateAndClear returned NULL");
+    result->messageId = messageId;
+    result->format = _parcLogFormatBinary_CopyString(format, formatLength);
+
+    if (!_parcLogFormatBinary_ParseFormat(result->format, result->conversions, &result->conversionCount)) {
+        parcMemory_Deallocate(&result->format);
+        parcMemory_Deallocate(&result);
+    }
+    return result;
+}
+
+static void
+_parcLogFormatBinary_WriteAll(PARCLogFormatBinary *binary, const uint8_t *data, size_t length)
+{
+    pthread_mutex_lock(&binary->writeLock);
+    while (length > 0) {
+        ssize_t nwritten = write(binary->fd, data, length);
+        if (nwritten < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        data += nwritten;
+        length -= nwritten;
+    }
+    pthread_mutex_unlock(&binary->writeLock);
+}
+
+static void
+_parcLogFormatBinary_FlushBuffer(_PARCLogFormatBinaryThreadBuffer *buffer)
+{
+    if (buffer->length > 0) {
+        _parcLogFormatBinary_WriteAll(buffer->binary, buffer->data, buffer->length);
+        buffer->length = 0;
+    }
+}
+
+static void
+_parcLogFormatBinary_Unlink(_PARCLogFormatBinaryThreadBuffer *buffer)
+{
+    if (buffer->previous != NULL) {
+        buffer->previous->next = buffer->next;
+    } else {
+        buffer->binary->buffers = buffer->next;
+    }
+    if (buffer->next != NULL) {
+        buffer->next->previous = buffer->previous;
+    }
+}
+
+static void
+_parcLogFormatBinary_DestroyBuffer(_PARCLogFormatBinaryThreadBuffer **bufferPtr)
+{
+    pthread_mutex_destroy(&(*bufferPtr)->lock);
+    parcMemory_Deallocate(bufferPtr);
+}
+
+/*
+ * The thread-specific data destructor: a thread that logged is exiting.
+ */
+static void
+_parcLogFormatBinary_ThreadExit(void *value)
+{
+    _PARCLogFormatBinaryThreadBuffer *buffer = value;
+    PARCLogFormatBinary *binary = buffer->binary;
+
+    pthread_mutex_lock(&binary->listLock);
+    pthread_mutex_lock(&buffer->lock);
+    _parcLogFormatBinary_FlushBuffer(buffer);
+    pthread_mutex_unlock(&buffer->lock);
+    _parcLogFormatBinary_Unlink(buffer);
+    pthread_mutex_unlock(&binary->listLock);
+
+    _parcLogFormatBinary_DestroyBuffer(&buffer);
+}
+
+static _PARCLogFormatBinaryThreadBuffer *
+_parcLogFormatBinary_GetThreadBuffer(PARCLogFormatBinary *binary)
+{
+    _PARCLogFormatBinaryThreadBuffer *result = pthread_getspecific(binary->key);
+    if (result == NULL) {
+        result = parcMemory_Allocate(sizeof(_PARCLogFormatBinaryThreadBuffer));
+        assertNotNull(result, "parcMemory_Allocate returned NULL");
+        result->binary = binary;
+        result->length = 0;
+        result->previous = NULL;
+        pthread_mutex_init(&result->lock, NULL);
+
+        pthread_mutex_lock(&binary->listLock);
+        result->next = binary->buffers;
+        if (result->next != NULL) {
+            result->next->previous = result;
+        }
+        binary->buffers = result;
+        pthread_mutex_unlock(&binary->listLock);
+
+        pthread_setspecific(binary->key, result);
+    }
+    return result;
+}
+
+static void
+_parcLogFormatBinary_Destroy(PARCLogFormatBinary **binaryPtr)
+{
+    PARCLogFormatBinary *binary = *binaryPtr;
+
+    // After this no thread-exit destructor can run for this instance.
+    pthread_key_delete(binary->key);
+
+    pthread_mutex_lock(&binary->listLock);
+    while (binary->buffers != NULL) {
+        _PARCLogFormatBinaryThreadBuffer *buffer = binary->buffers;
+        _parcLogFormatBinary_FlushBuffer(buffer);
+        _parcLogFormatBinary_Unlink(buffer);
+        _parcLogFormatBinary_DestroyBuffer(&buffer);
+    }
+    pthread_mutex_unlock(&binary->listLock);
+
+    close(binary->fd);
+    _parcLogFormatBinaryTable_Destroy(&binary->table);
+
+    pthread_mutex_destroy(&binary->writeLock);
+    pthread_mutex_destroy(&binary->listLock);
+    pthread_mutex_destroy(&binary->registryLock);
+}
+
+parcObject_ExtendPARCObject(PARCLogFormatBinary, _parcLogFormatBinary_Destroy, NULL, NULL, NULL, NULL, NULL, NULL);
+
+static uint8_t *
+_parcLogFormatBinary_Put(uint8_t *cursor, const void *value, size_t length)
+{
+    memcpy(cursor, value, length);
+    return cursor + length;
+}
+
+static uint8_t *
+_parcLogFormatBinary_PutName(uint8_t *cursor, const char *name)
+{
+    uint16_t length = (uint16_t) strnlen(name, UINT16_MAX);
+    cursor = _parcLogFormatBinary_Put(cursor, &length, sizeof(length));
+    return _parcLogFormatBinary_Put(cursor, name, length);
+}
+
+static const char *_nilvalue = "-";
+
+PARCLogFormatBinary *
+parcLogFormatBinary_Create(int fileDescriptor, const char *hostName, const char *applicationName, const char *processId)
+{
+    const char *names[3] = {
+        hostName == NULL ? _nilvalue : hostName,
+        applicationName == NULL ? _nilvalue : applicationName,
+        processId == NULL ? _nilvalue : processId
+    };
+
+    PARCLogFormatBinary *result = parcObject_CreateInstance(PARCLogFormatBinary);
+    if (result == NULL) {
+        return NULL;
+    }
+    result->fd = fileDescriptor;
+    result->buffers = NULL;
+    result->table = _parcLogFormatBinaryTable_Create(_parcLogFormatBinary_InitialTableSize);
+    pthread_mutex_init(&result->registryLock, NULL);
+    pthread_mutex_init(&result->listLock, NULL);
+    pthread_mutex_init(&result->writeLock, NULL);
+    pthread_key_create(&result->key, _parcLogFormatBinary_ThreadExit);
+
+    size_t headerLength = _parcLogFormatBinary_MagicLength + 1 + 2;
+    for (int i = 0; i < 3; i++) {
+        headerLength += 2 + strnlen(names[i], UINT16_MAX);
+    }
+    uint8_t *header = parcMemory_Allocate(headerLength);
+    assertNotNull(header, "parcMemory_Allocate returned NULL");
+
+    uint8_t version = _parcLogFormatBinary_Version;
+    uint16_t byteOrderMark = _parcLogFormatBinary_ByteOrderMark;
+    uint8_t *cursor = _parcLogFormatBinary_Put(header, _parcLogFormatBinary_Magic, _parcLogFormatBinary_MagicLength);
+    cursor = _parcLogFormatBinary_Put(cursor, &version, sizeof(version));
+    cursor = _parcLogFormatBinary_Put(cursor, &byteOrderMark, sizeof(byteOrderMark));
+    for (int i = 0; i < 3; i++) {
+        cursor = _parcLogFormatBinary_PutName(cursor, names[i]);
+    }
+    _parcLogFormatBinary_WriteAll(result, header, headerLength);
+    parcMemory_Deallocate(&header);
+
+    return result;
+}
+
+parcObject_ImplementAcquire(parcLogFormatBinary, PARCLogFormatBinary);
+
+parcObject_ImplementRelease(parcLogFormatBinary, PARCLogFormatBinary);
+
+bool
+parcLogFormatBinary_Register(PARCLogFormatBinary *binary, uint64_t messageId, const char *format)
+{
+    bool result;
+
+    pthread_mutex_lock(&binary->registryLock);
+
+    _PARCLogFormatBinaryDefinition *existing = _parcLogFormatBinaryTable_Lookup(&binary->table, messageId);
+    if (existing != NULL) {
+        result = strcmp(existing->format, format) == 0;
+    } else {
+        size_t formatLength = strlen(format);
+        _PARCLogFormatBinaryDefinition *definition = _parcLogFormatBinaryDefinition_Create(messageId, format, formatLength);
+        result = definition != NULL;
+        if (result) {
+            uint32_t bodyLength = (uint32_t) (8 + 4 + formatLength);
+            uint32_t length32 = (uint32_t) formatLength;
+            uint8_t type = _PARCLogFormatBinaryRecord_Definition;
+            uint8_t *record = parcMemory_Allocate(_parcLogFormatBinary_RecordHeaderSize + bodyLength);
+            assertNotNull(record, "parcMemory_Allocate returned NULL");
+
+            uint8_t *cursor = _parcLogFormatBinary_Put(record, &type, sizeof(type));
+            cursor = _parcLogFormatBinary_Put(cursor, &bodyLength, sizeof(bodyLength));
+            cursor = _parcLogFormatBinary_Put(cursor, &messageId, sizeof(messageId));
+            cursor = _parcLogFormatBinary_Put(cursor, &length32, sizeof(length32));
+            _parcLogFormatBinary_Put(cursor, format, formatLength);
+
+            // Written before the definition is visible to loggers, so it precedes every record that uses it.
+            _parcLogFormatBinary_WriteAll(binary, record, _parcLogFormatBinary_RecordHeaderSize + bodyLength);
+            parcMemory_Deallocate(&record);
+
+            _parcLogFormatBinaryTable_Insert(&binary->table, definition);
+        }
+    }
+
+    pthread_mutex_unlock(&binary->registryLock);
+    return result;
+}
+
+bool
+parcLogFormatBinary_IsRegistered(const PARCLogFormatBinary *binary, uint64_t messageId)
+{
+    return _parcLogFormatBinaryTable_Lookup(&binary->table, messageId) != NULL;
+}
+
+/*
+ * Take the arguments for each conversion off the va_list as raw 64-bit values or string pointers.
+ * Return the number of bytes they occupy in a record.
+ */
+static size_t
+_parcLogFormatBinary_CaptureArguments(const _PARCLogFormatBinaryDefinition *definition, va_list ap,
+                                      uint64_t values[], const char *strings[])
+{
+    size_t result = 0;
+
+    for (size_t n = 0; n < definition->conversionCount; n++) {
+        const _PARCLogFormatBinaryConversion *conversion = &definition->conversions[n];
+        switch (conversion->kind) {
+            case _PARCLogFormatBinaryKind_Signed: {
+                int64_t value;
+                switch (conversion->length) {
+                    case _PARCLogFormatBinaryLength_hh: value = (signed char) va_arg(ap, int); break;
+                    case _PARCLogFormatBinaryLength_h: value = (short) va_arg(ap, int); break;
+                    case _PARCLogFormatBinaryLength_l: value = va_arg(ap, long); break;
+                    case _PARCLogFormatBinaryLength_ll: value = va_arg(ap, long long); break;
+                    case _PARCLogFormatBinaryLength_z: value = va_arg(ap, ssize_t); break;
+                    case _PARCLogFormatBinaryLength_j: value = va_arg(ap, intmax_t); break;
+                    case _PARCLogFormatBinaryLength_t: value = va_arg(ap, ptrdiff_t); break;
+                    default: value = va_arg(ap, int); break;
+                }
+                values[n] = (uint64_t) value;
+                result += 8;
+                break;
+            }
+            case _PARCLogFormatBinaryKind_Unsigned: {
+                uint64_t value;
+                switch (conversion->length) {
+                    case _PARCLogFormatBinaryLength_hh: value = (unsigned char) va_arg(ap, unsigned int); break;
+                    case _PARCLogFormatBinaryLength_h: value = (unsigned short) va_arg(ap, unsigned int); break;
+                    case _PARCLogFormatBinaryLength_l: value = va_arg(ap, unsigned long); break;
+                    case _PARCLogFormatBinaryLength_ll: value = va_arg(ap, unsigned long long); break;
+                    case _PARCLogFormatBinaryLength_z: value = va_arg(ap, size_t); break;
+                    case _PARCLogFormatBinaryLength_j: value = va_arg(ap, uintmax_t); break;
+                    case _PARCLogFormatBinaryLength_t: value = (uint64_t) va_arg(ap, ptrdiff_t); break;
+                    default: value = va_arg(ap, unsigned int); break;
+                }
+                values[n] = value;
+                result += 8;
+                break;
+            }
+            case _PARCLogFormatBinaryKind_Char:
+                values[n] = (uint64_t) (int64_t) va_arg(ap, int);
+                result += 8;
+                break;
+            case _PARCLogFormatBinaryKind_Double: {
+                double value = va_arg(ap, double);
+                memcpy(&values[n], &value, sizeof(value));
+                result += 8;
+                break;
+            }
+            case _PARCLogFormatBinaryKind_Pointer:
+                values[n] = (uint64_t) (uintptr_t) va_arg(ap, void *);
+                result += 8;
+                break;
+            case _PARCLogFormatBinaryKind_String: {
+                const char *string = va_arg(ap, const char *);
+                strings[n] = (string == NULL) ? "(null)" : string;
+                values[n] = strlen(strings[n]);
+                result += 4 + values[n];
+                break;
+            }
+        }
+    }
+
+    return result;
+}
+
+bool
+parcLogFormatBinary_MessageVaList(PARCLogFormatBinary *binary, PARCLogLevel level, uint64_t messageId,
+                                  const char *format, va_list ap)
+{
+    _PARCLogFormatBinaryDefinition *definition = _parcLogFormatBinaryTable_Lookup(&binary->table, messageId);
+    if (definition == NULL) {
+        return false;
+    }
+    // The caller's format may be a reused buffer, so compare its content rather than its address.
+    if (format != NULL && strcmp(format, definition->format) != 0) {
+        return false;
+    }
+
+    struct timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+    uint64_t timestamp = (uint64_t) now.tv_sec * 1000000000ULL + (uint64_t) now.tv_nsec;
+
+    uint64_t values[_parcLogFormatBinary_MaxConversions];
+    const char *strings[_parcLogFormatBinary_MaxConversions];
+    va_list copy;
+    va_copy(copy, ap);
+    size_t argumentsLength = _parcLogFormatBinary_CaptureArguments(definition, copy, values, strings);
+    va_end(copy);
+
+    uint32_t bodyLength = (uint32_t) (_parcLogFormatBinary_MessageHeaderSize + argumentsLength);
+    size_t recordLength = _parcLogFormatBinary_RecordHeaderSize + (size_t) bodyLength;
+    if (recordLength > _parcLogFormatBinary_BufferSize) {
+        return false;
+    }
+
+    _PARCLogFormatBinaryThreadBuffer *buffer = _parcLogFormatBinary_GetThreadBuffer(binary);
+    pthread_mutex_lock(&buffer->lock);
+
+    if (buffer->length + recordLength > _parcLogFormatBinary_BufferSize) {
+        _parcLogFormatBinary_FlushBuffer(buffer);
+    }
+
+    uint8_t type = _PARCLogFormatBinaryRecord_Message;
+    uint8_t *cursor = _parcLogFormatBinary_Put(buffer->data + buffer->length, &type, sizeof(type));
+    cursor = _parcLogFormatBinary_Put(cursor, &bodyLength, sizeof(bodyLength));
+    cursor = _parcLogFormatBinary_Put(cursor, &timestamp, sizeof(timestamp));
+    cursor = _parcLogFormatBinary_Put(cursor, &messageId, sizeof(messageId));
+    cursor = _parcLogFormatBinary_Put(cursor, &level, sizeof(level));
+    for (size_t n = 0; n < definition->conversionCount; n++) {
+        if (definition->conversions[n].kind == _PARCLogFormatBinaryKind_String) {
+            uint32_t length = (uint32_t) values[n];
+            cursor = _parcLogFormatBinary_Put(cursor, &length, sizeof(length));
+            cursor = _parcLogFormatBinary_Put(cursor, strings[n], length);
+        } else {
+            cursor = _parcLogFormatBinary_Put(cursor, &values[n], sizeof(values[n]));
+        }
+    }
+    buffer->length += recordLength;
+
+    pthread_mutex_unlock(&buffer->lock);
+    return true;
+}
+
+bool
+parcLogFormatBinary_Message(PARCLogFormatBinary *binary, PARCLogLevel level, uint64_t messageId, ...)
+{
+    va_list ap;
+    va_start(ap, messageId);
+    bool result = parcLogFormatBinary_MessageVaList(binary, level, messageId, NULL, ap);
+    va_end(ap);
+
+    return result;
+}
+
+void
+parcLogFormatBinary_Flush(PARCLogFormatBinary *binary)
+{
+    pthread_mutex_lock(&binary->listLock);
+    for (_PARCLogFormatBinaryThreadBuffer *buffer = binary->buffers; buffer != NULL; buffer = buffer->next) {
+        pthread_mutex_lock(&buffer->lock);
+        _parcLogFormatBinary_FlushBuffer(buffer);
+        pthread_mutex_unlock(&buffer->lock);
+    }
+    pthread_mutex_unlock(&binary->listLock);
+}
+
+/*
+ * Decoding.
+ */
+
+static const uint8_t *
+_parcLogFormatBinary_Take(PARCBuffer *input, size_t length)
+{
+    if (parcBuffer_Remaining(input) < length) {
+        return NULL;
+    }
+    return parcBuffer_Overlay(input, length);
+}
+
+static char *
+_parcLogFormatBinary_TakeName(PARCBuffer *input)
+{
+    const uint8_t *lengthBytes = _parcLogFormatBinary_Take(input, sizeof(uint16_t));
+    if (lengthBytes == NULL) {
+        return NULL;
+    }
+    uint16_t length;
+    memcpy(&length, lengthBytes, sizeof(length));
+
+    const uint8_t *name = _parcLogFormatBinary_Take(input, length);
+    if (name == NULL) {
+        return NULL;
+    }
+    return _parcLogFormatBinary_CopyString(name, length);
+}
+
+static void
+_parcLogFormatBinary_PutLiteral(PARCBufferComposer *composer, const char *text, size_t length)
+{
+    size_t i = 0;
+    while (i < length) {
+        const char *percent = memchr(text + i, '%', length - i);
+        size_t run = (percent == NULL) ? length - i : (size_t) (percent - (text + i));
+        if (run > 0) {
+            parcBufferComposer_PutArray(composer, (const unsigned char *) text + i, run);
+        }
+        i += run;
+        if (i < length) {
+            // A literal in a parsed format can only contain "%%".
+            parcBufferComposer_PutChar(composer, '%');
+            i += 2;
+        }
+    }
+}
+
+/*
+ * Render a message record's arguments with the definition's format, one conversion at a time.
+ * Integer conversions are rendered with an "ll" length modifier in place of the original, because the
+ * captured value has already been narrowed to the original type.
+ */
+static PARCBuffer *
+_parcLogFormatBinary_Render(const _PARCLogFormatBinaryDefinition *definition, const uint8_t *arguments, size_t length)
+{
+    PARCBufferComposer *composer = parcBufferComposer_Create();
+    const char *format = definition->format;
+    size_t literalStart = 0;
+    bool valid = true;
+
+    for (size_t n = 0; valid && n < definition->conversionCount; n++) {
+        const _PARCLogFormatBinaryConversion *conversion = &definition->conversions[n];
+        _parcLogFormatBinary_PutLiteral(composer, format + literalStart, conversion->start - literalStart);
+        literalStart = conversion->end;
+
+        char specification[_parcLogFormatBinary_MaxSpecificationLength + 3];
+        size_t prefix = conversion->modifierStart - conversion->start;
+        memcpy(specification, format + conversion->start, prefix);
+        size_t s = prefix;
+        if (conversion->kind == _PARCLogFormatBinaryKind_Signed || conversion->kind == _PARCLogFormatBinaryKind_Unsigned) {
+            specification[s++] = 'l';
+            specification[s++] = 'l';
+        }
+        size_t suffix = conversion->end - (conversion->modifierStart + conversion->modifierSize);
+        memcpy(specification + s, format + conversion->modifierStart + conversion->modifierSize, suffix);
+        specification[s + suffix] = 0;
+
+        if (conversion->kind == _PARCLogFormatBinaryKind_String) {
+            uint32_t stringLength;
+            if (length < sizeof(stringLength)) {
+                valid = false;
+                break;
+            }
+            memcpy(&stringLength, arguments, sizeof(stringLength));
+            arguments += sizeof(stringLength);
+            length -= sizeof(stringLength);
+            if (length < stringLength) {
+                valid = false;
+                break;
+            }
+            char *string = _parcLogFormatBinary_CopyString(arguments, stringLength);
+            parcBufferComposer_Format(composer, specification, string);
+            parcMemory_Deallocate(&string);
+            arguments += stringLength;
+            length -= stringLength;
+            continue;
+        }
+
+        uint64_t value;
+        if (length < sizeof(value)) {
+            valid = false;
+            break;
+        }
+        memcpy(&value, arguments, sizeof(value));
+        arguments += sizeof(value);
+        length -= sizeof(value);
+
+        switch (conversion->kind) {
+            case _PARCLogFormatBinaryKind_Signed:
+                parcBufferComposer_Format(composer, specification, (long long) (int64_t) value);
+                break;
+            case _PARCLogFormatBinaryKind_Unsigned:
+                parcBufferComposer_Format(composer, specification, (unsigned long long) value);
+                break;
+            case _PARCLogFormatBinaryKind_Char:
+                parcBufferComposer_Format(composer, specification, (int) (int64_t) value);
+                break;
+            case _PARCLogFormatBinaryKind_Double: {
+                double d;
+                memcpy(&d, &value, sizeof(d));
+                parcBufferComposer_Format(composer, specification, d);
+                break;
+            }
+            case _PARCLogFormatBinaryKind_Pointer:
+                parcBufferComposer_Format(composer, specification, (void *) (uintptr_t) value);
+                break;
+            default:
+                valid = false;
+                break;
+        }
+    }
+
+    PARCBuffer *result = NULL;
+    if (valid && length == 0) {
+        _parcLogFormatBinary_PutLiteral(composer, format + literalStart, strlen(format + literalStart));
+        result = parcBufferComposer_ProduceBuffer(composer);
+    }
+    parcBufferComposer_Release(&composer);
+    return result;
+}
+
+static bool
+_parcLogFormatBinary_DecodeDefinition(_PARCLogFormatBinaryTable **tablePtr, const uint8_t *body, uint32_t bodyLength)
+{
+    uint64_t messageId;
+    uint32_t formatLength;
+    if (bodyLength < sizeof(messageId) + sizeof(formatLength)) {
+        return false;
+    }
+    memcpy(&messageId, body, sizeof(messageId));
+    memcpy(&formatLength, body + sizeof(messageId), sizeof(formatLength));
+    if (bodyLength != sizeof(messageId) + sizeof(formatLength) + formatLength) {
+        return false;
+    }
+
+    const char *format = (const char *) body + sizeof(messageId) + sizeof(formatLength);
+    _PARCLogFormatBinaryDefinition *existing = _parcLogFormatBinaryTable_Lookup(tablePtr, messageId);
+    if (existing != NULL) {
+        return strlen(existing->format) == formatLength && memcmp(existing->format, format, formatLength) == 0;
+    }
+
+    _PARCLogFormatBinaryDefinition *definition = _parcLogFormatBinaryDefinition_Create(messageId, format, formatLength);
+    if (definition == NULL) {
+        return false;
+    }
+    _parcLogFormatBinaryTable_Insert(tablePtr, definition);
+    return true;
+}
+
+bool
+parcLogFormatBinary_Decode(PARCBuffer *input, PARCLogFormatBinaryCallback *callback, void *context)
+{
+    const uint8_t *magic = _parcLogFormatBinary_Take(input, _parcLogFormatBinary_MagicLength);
+    if (magic == NULL || memcmp(magic, _parcLogFormatBinary_Magic, _parcLogFormatBinary_MagicLength) != 0) {
+        return false;
+    }
+    const uint8_t *version = _parcLogFormatBinary_Take(input, 1);
+    const uint8_t *byteOrderBytes = _parcLogFormatBinary_Take(input, sizeof(uint16_t));
+    if (version == NULL || *version != _parcLogFormatBinary_Version || byteOrderBytes == NULL) {
+        return false;
+    }
+    uint16_t byteOrderMark;
+    memcpy(&byteOrderMark, byteOrderBytes, sizeof(byteOrderMark));
+    if (byteOrderMark != _parcLogFormatBinary_ByteOrderMark) {
+        return false;
+    }
+
+    char *names[3] = { NULL, NULL, NULL };
+    bool result = true;
+    for (int i = 0; result && i < 3; i++) {
+        names[i] = _parcLogFormatBinary_TakeName(input);
+        result = names[i] != NULL;
+    }
+
+    _PARCLogFormatBinaryTable *table = _parcLogFormatBinaryTable_Create(_parcLogFormatBinary_InitialTableSize);
+
+    while (result && parcBuffer_Remaining(input) > 0) {
+        const uint8_t *recordHeader = _parcLogFormatBinary_Take(input, _parcLogFormatBinary_RecordHeaderSize);
+        if (recordHeader == NULL) {
+            result = false;
+            break;
+        }
+        uint32_t bodyLength;
+        memcpy(&bodyLength, recordHeader + 1, sizeof(bodyLength));
+        const uint8_t *body = _parcLogFormatBinary_Take(input, bodyLength);
+        if (body == NULL) {
+            result = false;
+            break;
+        }
+
+        if (recordHeader[0] == _PARCLogFormatBinaryRecord_Definition) {
+            result = _parcLogFormatBinary_DecodeDefinition(&table, body, bodyLength);
+        } else if (recordHeader[0] == _PARCLogFormatBinaryRecord_Message && bodyLength >= _parcLogFormatBinary_MessageHeaderSize) {
+            uint64_t timestamp;
+            uint64_t messageId;
+            memcpy(&timestamp, body, sizeof(timestamp));
+            memcpy(&messageId, body + 8, sizeof(messageId));
+            PARCLogLevel level = body[16];
+
+            _PARCLogFormatBinaryDefinition *definition = _parcLogFormatBinaryTable_Lookup(&table, messageId);
+            PARCBuffer *payload = NULL;
+            if (definition != NULL) {
+                payload = _parcLogFormatBinary_Render(definition, body + _parcLogFormatBinary_MessageHeaderSize,
+                                                      bodyLength - _parcLogFormatBinary_MessageHeaderSize);
+            }
+            if (payload == NULL) {
+                result = false;
+                break;
+            }
+
+            struct timeval timeStamp = {
+                .tv_sec  = (time_t) (timestamp / 1000000000ULL),
+                .tv_usec = (suseconds_t) ((timestamp % 1000000000ULL) / 1000)
+            };
+            PARCLogEntry *entry = parcLogEntry_Create(level, names[0], names[1], names[2], messageId, timeStamp, payload);
+            parcBuffer_Release(&payload);
+
+            bool more = callback(context, entry);
+            parcLogEntry_Release(&entry);
+            if (!more) {
+                break;
+            }
+        } else {
+            result = false;
+        }
+    }
+
+    _parcLogFormatBinaryTable_Destroy(&table);
+    for (int i = 0; i < 3; i++) {
+        if (names[i] != NULL) {
+            parcMemory_Deallocate(&names[i]);
+        }
+    }
+    return result;
+}
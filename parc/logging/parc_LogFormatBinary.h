@@ -0,0 +1,308 @@
+/*
+ * Copyright (c) 2015, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @file parc_LogFormatBinary.h
+ * @brief A compact binary log format that defers all text formatting until the log is read.
+ *
+ * Formatting a log message costs a `vasprintf`, an RFC 3339 time conversion and several allocations,
+ * all paid by the thread that logs, even though most log messages are never read.
+ * The binary format moves that work out of the process entirely.
+ *
+ * Each message is identified by a `messageId` registered once, together with its printf format string,
+ * by `parcLogFormatBinary_Register`.
+ * Logging a registered message appends a small record to a buffer owned by the calling thread:
+ * a nanosecond timestamp, the message identifier, the level and the raw values of the arguments.
+ * Nothing is formatted.
+ * The buffer is written to the file descriptor when it fills, when `parcLogFormatBinary_Flush` is called,
+ * when the thread exits and when the `PARCLogFormatBinary` is released.
+ *
+ * `parcLogFormatBinary_Decode` turns the records back into `PARCLogEntry` instances,
+ * which `parcLogFormatText_FormatEntry` or `parcLogFormatSyslog_FormatEntry` render as usual.
+ * The `parc-log-decode` command does this for a file.
+ *
+ * A `PARCLog` uses a `PARCLogFormatBinary` for its registered messages once it is given one with
+ * `parcLog_SetFormatBinary`, and formats everything else as before.
+ *
+ * Format strings may use the conversions `d i o u x X c s p f F e E g G a A`,
+ * with the flags, field widths, precisions and the length modifiers `hh h l ll z j t`.
+ * Widths and precisions given as `*`, the `L` modifier, wide characters and strings, and `%n` are not supported.
+ * The file is written in the byte order of the host that writes it.
+ *
+ * @author Glenn Scott, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#ifndef PARC_Library_parc_LogFormatBinary_h
+#define PARC_Library_parc_LogFormatBinary_h
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <parc/algol/parc_Buffer.h>
+#include <parc/logging/parc_LogEntry.h>
+#include <parc/logging/parc_LogLevel.h>
+
+struct PARCLogFormatBinary;
+typedef struct PARCLogFormatBinary PARCLogFormatBinary;
+
+/**
+ * Create a new `PARCLogFormatBinary` writing to the given file descriptor.
+ *
+ * The file header, containing the host, application and process names, is written immediately.
+ * The instance takes ownership of the file descriptor and closes it when the instance is destroyed,
+ * in the same way as {@link parcFileOutputStream_Create}.
+ *
+ * @param [in] fileDescriptor An open file descriptor.
+ * @param [in] hostName The host name recorded for every message, or NULL.
+ * @param [in] applicationName The application name recorded for every message, or NULL.
+ * @param [in] processId The process identifier recorded for every message, or NULL.
+ *
+ * @return NULL Memory could not be allocated.
+ * @return non-NULL A pointer to a valid `PARCLogFormatBinary` instance.
+ *
+ * Example:
+ * @code
+ * {
+ *     int fd = open("myApp.plog", O_WRONLY | O_CREAT | O_APPEND, 0600);
+ *     PARCLogFormatBinary *binary = parcLogFormatBinary_Create(fd, "localhost", "myApp", "daemon");
+ *
+ *     parcLogFormatBinary_Register(binary, 1, "Accepted connection from %s port %d");
+ *
+ *     parcLogFormatBinary_Release(&binary);
+ * }
+ * @endcode
+ */
+PARCLogFormatBinary *parcLogFormatBinary_Create(int fileDescriptor, const char *hostName, const char *applicationName, const char *processId);
+
+/**
+ * Increase the number of references to a `PARCLogFormatBinary` instance.
+ *
+ * @param [in] instance A pointer to a valid `PARCLogFormatBinary` instance.
+ *
+ * @return The input `PARCLogFormatBinary` pointer.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCLogFormatBinary *x_2 = parcLogFormatBinary_Acquire(binary);
+ *
+ *     parcLogFormatBinary_Release(&x_2);
+ * }
+ * @endcode
+ */
+PARCLogFormatBinary *parcLogFormatBinary_Acquire(const PARCLogFormatBinary *instance);
+
+/**
+ * Release a previously acquired reference to the specified instance,
+ * decrementing the reference count for the instance.
+ *
+ * The pointer to the instance is set to NULL as a side-effect of this function.
+ *
+ * If the invocation causes the last reference to the instance to be released,
+ * the buffers of every thread are written and the file descriptor is closed.
+ * Threads must have stopped logging to the instance by then.
+ *
+ * @param [in,out] instancePtr A pointer to a pointer to a `PARCLogFormatBinary`. The parameter is set to NULL.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcLogFormatBinary_Release(&binary);
+ * }
+ * @endcode
+ */
+void parcLogFormatBinary_Release(PARCLogFormatBinary **instancePtr);
+
+/**
+ * Register the printf format string for a message identifier.
+ *
+ * The definition is written to the file immediately, so that the decoder can render the messages that follow it.
+ * Registering the same identifier again with an identical format has no effect.
+ * Format strings are expected to be string literals:
+ * a format passed to `parcLogFormatBinary_MessageVaList` at the registered address is taken to be the registered format.
+ *
+ * @param [in] binary A pointer to a valid `PARCLogFormatBinary` instance.
+ * @param [in] messageId The message identifier.
+ * @param [in] format A nul-terminated printf format specification.
+ *
+ * @return true The format was registered.
+ * @return false The format uses an unsupported conversion, or the identifier is registered with a different format.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcLogFormatBinary_Register(binary, 1, "Accepted connection from %s port %d");
+ * }
+ * @endcode
+ */
+bool parcLogFormatBinary_Register(PARCLogFormatBinary *binary, uint64_t messageId, const char *format);
+
+/**
+ * Determine if a message identifier has been registered.
+ *
+ * @param [in] binary A pointer to a valid `PARCLogFormatBinary` instance.
+ * @param [in] messageId The message identifier.
+ *
+ * @return true The identifier has a registered format.
+ * @return false The identifier has not been registered.
+ */
+bool parcLogFormatBinary_IsRegistered(const PARCLogFormatBinary *binary, uint64_t messageId);
+
+/**
+ * Append a record for a registered message to the calling thread's buffer.
+ *
+ * The arguments in @p ap must match the format registered for @p messageId.
+ * The caller's `va_list` is not consumed.
+ * If @p format is not NULL the record is only appended if it is the format registered for @p messageId,
+ * which lets a caller that holds a format string, such as `parcLog_MessageVaList`, fall back to text for anything else.
+ *
+ * @param [in] binary A pointer to a valid `PARCLogFormatBinary` instance.
+ * @param [in] level The `PARCLogLevel` of the message.
+ * @param [in] messageId A registered message identifier.
+ * @param [in] format The format the caller expects to be registered for @p messageId, or NULL.
+ * @param [in] ap The arguments for the registered format.
+ *
+ * @return true The record was appended.
+ * @return false The identifier is not registered with @p format, or the record is larger than a thread buffer.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcLogFormatBinary_MessageVaList(binary, PARCLogLevel_Info, messageId, NULL, ap);
+ * }
+ * @endcode
+ */
+bool parcLogFormatBinary_MessageVaList(PARCLogFormatBinary *binary, PARCLogLevel level, uint64_t messageId,
+                                       const char *format, va_list ap);
+
+/**
+ * Append a record for a registered message to the calling thread's buffer.
+ *
+ * @param [in] binary A pointer to a valid `PARCLogFormatBinary` instance.
+ * @param [in] level The `PARCLogLevel` of the message.
+ * @param [in] messageId A registered message identifier.
+ * @param [in] ... The arguments for the registered format.
+ *
+ * @return true The record was appended.
+ * @return false The identifier is not registered, or the record is larger than a thread buffer.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcLogFormatBinary_Register(binary, 1, "Accepted connection from %s port %d");
+ *
+ *     parcLogFormatBinary_Message(binary, PARCLogLevel_Info, 1, "10.1.1.1", 9695);
+ * }
+ * @endcode
+ */
+bool parcLogFormatBinary_Message(PARCLogFormatBinary *binary, PARCLogLevel level, uint64_t messageId, ...);
+
+/**
+ * Write the buffered records of every thread to the file descriptor.
+ *
+ * @param [in] binary A pointer to a valid `PARCLogFormatBinary` instance.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcLogFormatBinary_Flush(binary);
+ * }
+ * @endcode
+ */
+void parcLogFormatBinary_Flush(PARCLogFormatBinary *binary);
+
+/**
+ * The function called by `parcLogFormatBinary_Decode` for each decoded message.
+ *
+ * @param [in] context The context supplied to `parcLogFormatBinary_Decode`.
+ * @param [in] entry A `PARCLogEntry` whose payload is the rendered message. Acquire it to keep it.
+ *
+ * @return true Continue decoding.
+ * @return false Stop decoding.
+ */
+typedef bool (PARCLogFormatBinaryCallback)(void *context, const PARCLogEntry *entry);
+
+/**
+ * Decode binary log records, from the position to the limit of @p input,
+ * rendering each message with its registered format and invoking @p callback with the resulting `PARCLogEntry`.
+ *
+ * The input must start with a file header.
+ * The position of @p input is advanced past the records consumed.
+ *
+ * @param [in] input A pointer to a valid `PARCBuffer` holding the contents of a binary log.
+ * @param [in] callback The function to invoke for each message.
+ * @param [in] context A pointer passed to @p callback.
+ *
+ * @return true The input was decoded to its end, or until @p callback returned false.
+ * @return false The input is not a binary log, was written with a different byte order, or is truncated or corrupt.
+ *
+ * Example:
+ * @code
+ * static bool
+ * _printText(void *context, const PARCLogEntry *entry)
+ * {
+ *     PARCBuffer *text = parcLogFormatText_FormatEntry(entry);
+ *     write(STDOUT_FILENO, parcBuffer_Overlay(text, 0), parcBuffer_Remaining(text));
+ *     parcBuffer_Release(&text);
+ *     return true;
+ * }
+ *
+ * {
+ *     parcLogFormatBinary_Decode(contents, _printText, NULL);
+ * }
+ * @endcode
+ */
+bool parcLogFormatBinary_Decode(PARCBuffer *input, PARCLogFormatBinaryCallback *callback, void *context);
+#endif /* PARC_Library_parc_LogFormatBinary_h */
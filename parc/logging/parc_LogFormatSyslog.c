@@ -59,6 +59,7 @@
 #include <config.h>
 
 #include <inttypes.h>
+#include <stdio.h>
 
 #include <parc/logging/parc_LogFormatSyslog.h>
 #include <parc/algol/parc_BufferComposer.h>
@@ -161,3 +162,22 @@ parcLogFormatSyslog_FormatEntry(const PARCLogEntry *entry)
 
     return result;
 }
+
+size_t
+parcLogFormatSyslog_FormatHeader(const PARCLogEntry *entry, char *header, size_t size)
+{
+    char theTime[64];
+    parcTime_TimevalAsRFC3339(parcLogEntry_GetTimeStamp(entry), theTime);
+
+    int length = snprintf(header, size, "<%s> %d %s %s %s %s %" PRId64 " [ ",
+                          parcLogLevel_ToString(parcLogEntry_GetLevel(entry)), parcLogEntry_GetVersion(entry),
+                          theTime,
+                          parcLogEntry_GetHostName(entry),
+                          parcLogEntry_GetApplicationName(entry),
+                          parcLogEntry_GetProcessName(entry),
+                          parcLogEntry_GetMessageId(entry));
+    if (length < 0 || (size_t) length >= size) {
+        return 0;
+    }
+    return (size_t) length;
+}
@@ -69,4 +69,28 @@
 
 PARCBuffer *parcLogFormatSyslog_FormatEntry(const PARCLogEntry *entry);
 
+/**
+ * Format the RFC 5424 header of a PARCLogEntry, everything that `parcLogFormatSyslog_FormatEntry` puts before
+ * the payload, into the caller's storage.
+ *
+ * The complete formatted entry is the header, the payload, and the three characters " ]\n".
+ * This lets a reporter assemble entries in its own buffers without allocating a PARCBuffer for each one.
+ *
+ * @param [in] entry A pointer to a valid instance of PARCLogEntry.
+ * @param [out] header A pointer to storage for the nul-terminated header.
+ * @param [in] size The size of the storage.
+ *
+ * @return 0 The header does not fit in the storage.
+ * @return >0 The length of the header, excluding the terminating nul.
+ *
+ * Example:
+ * @code
+ * {
+ *     char header[512];
+ *     size_t length = parcLogFormatSyslog_FormatHeader(entry, header, sizeof(header));
+ * }
+ * @endcode
+ */
+size_t parcLogFormatSyslog_FormatHeader(const PARCLogEntry *entry, char *header, size_t size);
+
 #endif /* defined(__PARC_Library__parc_LogFormatSyslog__) */
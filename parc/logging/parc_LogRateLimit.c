@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2015, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * The token bucket is the generic cell rate algorithm (GCRA).  The bucket is represented by its theoretical arrival
+ * time: the instant at which it will be full again.  A message is admitted if that instant is no more than the
+ * tolerance (the credit of a full bucket, less one token) after the current time, and admitting it moves the
+ * instant one interval later.  A suppressed message makes no change to the bucket, so the common case of a flood
+ * costs one atomic load of the bucket and one atomic increment of the suppressed count.
+ *
+ * All of the atomic operations are relaxed: the counters and the bucket are independent, and nothing else is
+ * published through them.
+ *
+ * @author Glenn Scott, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include <config.h>
+
+#include <time.h>
+
+#include <LongBow/runtime.h>
+
+#include <parc/logging/parc_LogRateLimit.h>
+
+/*
+ * The coarse clock is read without a system call and is precise to a scheduler tick,
+ * which is enough to meter log messages.
+ */
+static inline uint64_t
+_parcLogRateLimit_Now(void)
+{
+    struct timespec now;
+#if __linux__
+    clock_gettime(CLOCK_MONOTONIC_COARSE, &now);
+#else
+    clock_gettime(CLOCK_MONOTONIC, &now);
+#endif
+    return (uint64_t) now.tv_sec * 1000000000ULL + (uint64_t) now.tv_nsec;
+}
+
+void
+parcLogRateLimit_Init(PARCLogRateLimit *limit, uint32_t perSecond, uint32_t burst, uint32_t sampleEvery)
+{
+    assertNotNull(limit, "Parameter limit must be a non-null pointer to a PARCLogRateLimit");
+
+    limit->interval = (perSecond == 0) ? 0 : 1000000000ULL / perSecond;
+    limit->tolerance = (burst < 1) ? 0 : (burst - 1) * limit->interval;
+    limit->sampleEvery = sampleEvery;
+    limit->file = NULL;
+    limit->line = 0;
+
+    limit->theoreticalArrival = 0;
+    limit->sampled = 0;
+    limit->suppressed = 0;
+    limit->reported = 0;
+}
+
+static bool
+_parcLogRateLimit_TakeToken(PARCLogRateLimit *limit)
+{
+    uint64_t now = _parcLogRateLimit_Now();
+    uint64_t arrival = __atomic_load_n(&limit->theoreticalArrival, __ATOMIC_RELAXED);
+
+    do {
+        if (arrival > now + limit->tolerance) {
+            return false;
+        }
+        uint64_t next = ((arrival > now) ? arrival : now) + limit->interval;
+        if (__atomic_compare_exchange_n(&limit->theoreticalArrival, &arrival, next, true,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+            return true;
+        }
+    } while (true);
+}
+
+bool
+parcLogRateLimit_Admit(PARCLogRateLimit *limit, uint64_t *suppressedPtr)
+{
+    bool admit = true;
+
+    if (limit->sampleEvery > 1) {
+        uint64_t n = __atomic_fetch_add(&limit->sampled, 1, __ATOMIC_RELAXED);
+        admit = (n % limit->sampleEvery) == 0;
+    }
+    if (admit && limit->interval != 0) {
+        admit = _parcLogRateLimit_TakeToken(limit);
+    }
+
+    if (admit) {
+        if (suppressedPtr != NULL) {
+            *suppressedPtr = parcLogRateLimit_TakeSuppressed(limit);
+        }
+    } else {
+        __atomic_fetch_add(&limit->suppressed, 1, __ATOMIC_RELAXED);
+    }
+    return admit;
+}
+
+uint64_t
+parcLogRateLimit_TakeSuppressed(PARCLogRateLimit *limit)
+{
+    // Checking first keeps the cache line shared while nothing has been suppressed.
+    if (__atomic_load_n(&limit->suppressed, __ATOMIC_RELAXED) == 0) {
+        return 0;
+    }
+    uint64_t result = __atomic_exchange_n(&limit->suppressed, 0, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&limit->reported, result, __ATOMIC_RELAXED);
+    return result;
+}
+
+uint64_t
+parcLogRateLimit_GetSuppressedCount(const PARCLogRateLimit *limit)
+{
+    return __atomic_load_n(&limit->reported, __ATOMIC_RELAXED) + __atomic_load_n(&limit->suppressed, __ATOMIC_RELAXED);
+}
@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2015, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @file parc_LogRateLimit.h
+ * @brief Per-call-site rate limiting and sampling of log messages.
+ *
+ * `parcLog_IsLoggable` only compares severity levels, so a call site that is reached millions of times a second
+ * (for example, a warning about a misbehaving peer) emits millions of identical messages and saturates the reporter.
+ * A `PARCLogRateLimit` holds the state for one call site and decides which of its messages are admitted.
+ *
+ * Two policies may be combined:
+ *   * Sampling admits one message in every `sampleEvery`.
+ *   * Rate limiting is a token bucket holding up to `burst` tokens and refilled at `perSecond` tokens per second.
+ *     It is implemented as the generic cell rate algorithm: the only state is the time at which the bucket would be
+ *     full again, so no timer is needed to refill it.
+ *
+ * Messages that are not admitted are counted.
+ * The count accumulated since the previous admitted message is handed to the caller when the next message is
+ * admitted, so that it can report a single summary line in place of the suppressed messages.
+ *
+ * Checking a message costs a read of a monotonic clock and a few relaxed atomic operations, with no locks.
+ *
+ * A `PARCLogRateLimit` is normally a static variable declared by one of the `parcLog_...RateLimited`
+ * or `parcLog_...Sampled` macros in {@link parc_Log.h}, and is initialised at compile time with
+ * `parcLogRateLimit_Initializer`.
+ *
+ * @author Glenn Scott, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#ifndef PARC_Library_parc_LogRateLimit_h
+#define PARC_Library_parc_LogRateLimit_h
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @typedef PARCLogRateLimit
+ * @brief The configuration and state of the rate limit for one call site.
+ *
+ * The members are public only so that an instance can be a statically initialised variable.
+ * Use `parcLogRateLimit_Initializer` or `parcLogRateLimit_Init` to set them, and the functions below to use them.
+ */
+typedef struct {
+    uint64_t interval;           /**< Nanoseconds per token, or 0 for no rate limit. */
+    uint64_t tolerance;          /**< Nanoseconds of credit a full bucket holds: (burst - 1) * interval. */
+    uint32_t sampleEvery;        /**< Admit one message in this many, or 0 or 1 for every message. */
+    const char *file;            /**< The source file of the call site, or NULL. */
+    int line;                    /**< The line of the call site. */
+
+    uint64_t theoreticalArrival; /**< The monotonic time, in nanoseconds, at which the bucket is full again. */
+    uint64_t sampled;            /**< The number of messages offered to the sampler. */
+    uint64_t suppressed;         /**< Messages suppressed since the last admitted message. */
+    uint64_t reported;           /**< Messages suppressed and handed to the caller by `parcLogRateLimit_Admit`. */
+} PARCLogRateLimit;
+
+/**
+ * A static initializer for a `PARCLogRateLimit`.
+ *
+ * @param [in] _perSecond_ The long-term number of messages admitted per second, or 0 for no rate limit.
+ * @param [in] _burst_ The number of messages that may be admitted at once after a quiet period (at least 1).
+ * @param [in] _sampleEvery_ Admit one message in this many, or 0 or 1 to admit every message.
+ *
+ * Example:
+ * @code
+ * {
+ *     // At most 10 messages a second, in bursts of up to 5.
+ *     static PARCLogRateLimit limit = parcLogRateLimit_Initializer(10, 5, 1);
+ * }
+ * @endcode
+ *
+ * The divisors are never zero, so that the initializer remains a constant expression when `_perSecond_` is 0.
+ */
+#define parcLogRateLimit_Initializer(_perSecond_, _burst_, _sampleEvery_) \
+    { \
+        .interval = ((_perSecond_) == 0) ? 0 : 1000000000ULL / ((_perSecond_) + ((_perSecond_) == 0)), \
+        .tolerance = ((_perSecond_) == 0 || (_burst_) < 1) ? 0 : \
+                     ((_burst_) - 1) * (1000000000ULL / ((_perSecond_) + ((_perSecond_) == 0))), \
+        .sampleEvery = (_sampleEvery_), \
+        .file = __FILE__, \
+        .line = __LINE__ \
+    }
+
+/**
+ * Initialise a `PARCLogRateLimit` at run time.
+ *
+ * This is the equivalent of `parcLogRateLimit_Initializer` for an instance that is not a static variable.
+ * The instance has no call site: `file` is NULL.
+ *
+ * @param [out] limit A pointer to the `PARCLogRateLimit` to initialise.
+ * @param [in] perSecond The long-term number of messages admitted per second, or 0 for no rate limit.
+ * @param [in] burst The number of messages that may be admitted at once after a quiet period (at least 1).
+ * @param [in] sampleEvery Admit one message in this many, or 0 or 1 to admit every message.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCLogRateLimit limit;
+ *     parcLogRateLimit_Init(&limit, 100, 10, 0);
+ * }
+ * @endcode
+ */
+void parcLogRateLimit_Init(PARCLogRateLimit *limit, uint32_t perSecond, uint32_t burst, uint32_t sampleEvery);
+
+/**
+ * Decide whether to admit a message.
+ *
+ * The message must first pass the sampler, then take a token from the bucket.
+ * A message that is not admitted is counted as suppressed.
+ *
+ * This function is safe to call from any number of threads at once.
+ *
+ * @param [in,out] limit A pointer to a valid `PARCLogRateLimit`.
+ * @param [out] suppressedPtr If the message is admitted, set to the number of messages suppressed since
+ *                            the previous admitted message. May be NULL.
+ *
+ * @return true The message is admitted and should be logged.
+ * @return false The message is suppressed.
+ *
+ * Example:
+ * @code
+ * {
+ *     static PARCLogRateLimit limit = parcLogRateLimit_Initializer(10, 5, 1);
+ *
+ *     uint64_t suppressed;
+ *     if (parcLogRateLimit_Admit(&limit, &suppressed)) {
+ *         if (suppressed > 0) {
+ *             printf("%" PRIu64 " messages suppressed\n", suppressed);
+ *         }
+ *         printf("Bad packet from %s\n", peerName);
+ *     }
+ * }
+ * @endcode
+ */
+bool parcLogRateLimit_Admit(PARCLogRateLimit *limit, uint64_t *suppressedPtr);
+
+/**
+ * Get the total number of messages suppressed by the given `PARCLogRateLimit`.
+ *
+ * This includes the messages not yet handed to a caller by `parcLogRateLimit_Admit`.
+ *
+ * @param [in] limit A pointer to a valid `PARCLogRateLimit`.
+ *
+ * @return The number of messages suppressed since the instance was initialised.
+ *
+ * Example:
+ * @code
+ * {
+ *     printf("%" PRIu64 " messages suppressed\n", parcLogRateLimit_GetSuppressedCount(&limit));
+ * }
+ * @endcode
+ */
+uint64_t parcLogRateLimit_GetSuppressedCount(const PARCLogRateLimit *limit);
+
+/**
+ * Get the number of messages suppressed since the last admitted message, and reset it to zero.
+ *
+ * Use this to report suppressed messages from a call site that has stopped logging,
+ * for example from a periodic timer, since they would otherwise be reported only with the next admitted message.
+ *
+ * @param [in,out] limit A pointer to a valid `PARCLogRateLimit`.
+ *
+ * @return The number of messages suppressed since the last admitted message.
+ *
+ * Example:
+ * @code
+ * {
+ *     uint64_t pending = parcLogRateLimit_TakeSuppressed(&limit);
+ * }
+ * @endcode
+ */
+uint64_t parcLogRateLimit_TakeSuppressed(PARCLogRateLimit *limit);
+#endif // PARC_Library_parc_LogRateLimit_h
@@ -0,0 +1,451 @@
+/*
+ * Copyright (c) 2015, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * Producers acquire the entry and put it on a lock-free PARCRingBufferNxM; nothing else happens on the calling
+ * thread unless the ring is full.  The writer thread drains the ring _parcLogReporterAsync_BatchSize entries at a
+ * time and writes the whole batch with one writev(2).  Each entry is formatted into a header slot and the payload is
+ * written straight from the entry's PARCBuffer, so the writer makes no allocation and no copy of the payload.
+ *
+ * The writer sleeps on a condition variable when the ring is empty.  A producer only takes the mutex to wake it
+ * when the writer has announced that it is sleeping, and the writer re-examines the ring after the announcement,
+ * so the common path of a report is one compare-and-swap on the ring.  The writer also wakes periodically,
+ * so a lost wakeup can only delay an entry, never strand it.
+ *
+ * Flush and the Block overflow policy wait on a second condition variable that the writer broadcasts after
+ * each batch, but only when someone has registered as waiting.
+ *
+ * @author Glenn Scott, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include <config.h>
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <sys/time.h>
+#include <sys/uio.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <LongBow/runtime.h>
+
+#include <parc/logging/parc_LogReporterAsync.h>
+#include <parc/logging/parc_LogFormatSyslog.h>
+
+#include <parc/algol/parc_Memory.h>
+#include <parc/algol/parc_Object.h>
+#include <parc/concurrent/parc_RingBuffer_NxM.h>
+
+#define _parcLogReporterAsync_BatchSize 64
+#define _parcLogReporterAsync_IdleWaitNanoseconds (10 * 1000 * 1000)
+#define _parcLogReporterAsync_HeaderSize 512
+
+typedef struct {
+    int fd;
+    PARCRingBufferNxM *ring;
+    PARCLogReporterAsyncOverflow overflow;
+
+    pthread_t writer;
+    bool writerStarted;
+    pthread_mutex_t mutex;
+    pthread_cond_t wakeWriter;
+    pthread_cond_t progress;
+    bool stopping;
+
+    uint32_t writerSleeping;
+    uint32_t waiters;
+
+    uint64_t enqueued;
+    uint64_t completed;
+    uint64_t written;
+    uint64_t dropped;
+    uint64_t blocked;
+
+    // Only the writer thread touches these.
+    char headers[_parcLogReporterAsync_BatchSize][_parcLogReporterAsync_HeaderSize];
+} _PARCLogReporterAsync;
+
+static void
+_parcLogReporterAsync_DestroyEntry(void **entryPtr)
+{
+    parcLogEntry_Release((PARCLogEntry **) entryPtr);
+}
+
+static void
+_parcLogReporterAsync_AbsoluteTimeout(struct timespec *deadline, long nanoseconds)
+{
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    deadline->tv_sec = now.tv_sec;
+    deadline->tv_nsec = now.tv_usec * 1000 + nanoseconds;
+    if (deadline->tv_nsec >= 1000000000) {
+        deadline->tv_sec += deadline->tv_nsec / 1000000000;
+        deadline->tv_nsec %= 1000000000;
+    }
+}
+
+/*
+ * Write every byte described by the iovec array, resuming after short writes.
+ * A write error other than EINTR abandons the rest of the batch: there is nowhere to report it.
+ */
+static void
+_parcLogReporterAsync_WriteAll(int fd, struct iovec *iov, int iovcnt)
+{
+    while (iovcnt > 0) {
+        ssize_t nwritten = writev(fd, iov, iovcnt);
+        if (nwritten < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        while (iovcnt > 0 && (size_t) nwritten >= iov->iov_len) {
+            nwritten -= iov->iov_len;
+            iov++;
+            iovcnt--;
+        }
+        if (iovcnt > 0) {
+            iov->iov_base = (uint8_t *) iov->iov_base + nwritten;
+            iov->iov_len -= nwritten;
+        }
+    }
+}
+
+/*
+ * Each entry is written as three iovecs: the formatted header, the payload bytes in place, and the trailer.
+ * An entry whose header does not fit in a header slot falls back to parcLogFormatSyslog_FormatEntry.
+ */
+static void
+_parcLogReporterAsync_WriteBatch(_PARCLogReporterAsync *async, PARCLogEntry *entries[], uint32_t count)
+{
+    static char trailer[] = " ]\n";
+
+    struct iovec iov[3 * _parcLogReporterAsync_BatchSize];
+    PARCBuffer *fallback[_parcLogReporterAsync_BatchSize];
+    int iovcnt = 0;
+
+    for (uint32_t i = 0; i < count; i++) {
+        fallback[i] = NULL;
+
+        size_t headerLength = parcLogFormatSyslog_FormatHeader(entries[i], async->headers[i], _parcLogReporterAsync_HeaderSize);
+        if (headerLength == 0) {
+            fallback[i] = parcLogFormatSyslog_FormatEntry(entries[i]);
+            iov[iovcnt].iov_len = parcBuffer_Remaining(fallback[i]);
+            iov[iovcnt].iov_base = parcBuffer_Overlay(fallback[i], 0);
+            iovcnt++;
+            continue;
+        }
+
+        iov[iovcnt].iov_base = async->headers[i];
+        iov[iovcnt].iov_len = headerLength;
+        iovcnt++;
+
+        PARCBuffer *payload = parcLogEntry_GetPayload(entries[i]);
+        size_t payloadLength = parcBuffer_Remaining(payload);
+        if (payloadLength > 0) {
+            iov[iovcnt].iov_base = parcByteArray_AddressOfIndex(parcBuffer_Array(payload),
+                                                                parcBuffer_ArrayOffset(payload) + parcBuffer_Position(payload));
+            iov[iovcnt].iov_len = payloadLength;
+            iovcnt++;
+        }
+
+        iov[iovcnt].iov_base = trailer;
+        iov[iovcnt].iov_len = sizeof(trailer) - 1;
+        iovcnt++;
+    }
+
+    _parcLogReporterAsync_WriteAll(async->fd, iov, iovcnt);
+
+    for (uint32_t i = 0; i < count; i++) {
+        if (fallback[i] != NULL) {
+            parcBuffer_Release(&fallback[i]);
+        }
+        parcLogEntry_Release(&entries[i]);
+    }
+
+    __atomic_add_fetch(&async->written, count, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&async->completed, count, __ATOMIC_SEQ_CST);
+}
+
+static void
+_parcLogReporterAsync_SignalProgress(_PARCLogReporterAsync *async)
+{
+    if (__atomic_load_n(&async->waiters, __ATOMIC_SEQ_CST) > 0) {
+        pthread_mutex_lock(&async->mutex);
+        pthread_cond_broadcast(&async->progress);
+        pthread_mutex_unlock(&async->mutex);
+    }
+}
+
+static void *
+_parcLogReporterAsync_Writer(void *context)
+{
+    _PARCLogReporterAsync *async = context;
+    PARCLogEntry *entries[_parcLogReporterAsync_BatchSize];
+
+    while (true) {
+        uint32_t count = parcRingBufferNxM_GetN(async->ring, (void **) entries, _parcLogReporterAsync_BatchSize);
+        if (count > 0) {
+            _parcLogReporterAsync_WriteBatch(async, entries, count);
+            _parcLogReporterAsync_SignalProgress(async);
+            continue;
+        }
+
+        pthread_mutex_lock(&async->mutex);
+        if (async->stopping) {
+            pthread_mutex_unlock(&async->mutex);
+            break;
+        }
+        __atomic_store_n(&async->writerSleeping, 1, __ATOMIC_SEQ_CST);
+        count = parcRingBufferNxM_GetN(async->ring, (void **) entries, _parcLogReporterAsync_BatchSize);
+        if (count == 0) {
+            struct timespec deadline;
+            _parcLogReporterAsync_AbsoluteTimeout(&deadline, _parcLogReporterAsync_IdleWaitNanoseconds);
+            pthread_cond_timedwait(&async->wakeWriter, &async->mutex, &deadline);
+        }
+        __atomic_store_n(&async->writerSleeping, 0, __ATOMIC_RELAXED);
+        pthread_mutex_unlock(&async->mutex);
+
+        if (count > 0) {
+            _parcLogReporterAsync_WriteBatch(async, entries, count);
+            _parcLogReporterAsync_SignalProgress(async);
+        }
+    }
+
+    return NULL;
+}
+
+static void
+_parcLogReporterAsync_WakeWriter(_PARCLogReporterAsync *async)
+{
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&async->writerSleeping, __ATOMIC_SEQ_CST)) {
+        pthread_mutex_lock(&async->mutex);
+        pthread_cond_signal(&async->wakeWriter);
+        pthread_mutex_unlock(&async->mutex);
+    }
+}
+
+static void
+_parcLogReporterAsync_Destroy(_PARCLogReporterAsync **asyncPtr)
+{
+    _PARCLogReporterAsync *async = *asyncPtr;
+
+    pthread_mutex_lock(&async->mutex);
+    async->stopping = true;
+    pthread_cond_signal(&async->wakeWriter);
+    pthread_mutex_unlock(&async->mutex);
+    if (async->writerStarted) {
+        pthread_join(async->writer, NULL);
+    }
+
+    parcRingBufferNxM_Release(&async->ring);
+    close(async->fd);
+
+    pthread_cond_destroy(&async->progress);
+    pthread_cond_destroy(&async->wakeWriter);
+    pthread_mutex_destroy(&async->mutex);
+}
+
+parcObject_ExtendPARCObject(_PARCLogReporterAsync, _parcLogReporterAsync_Destroy, NULL, NULL, NULL, NULL, NULL, NULL);
+
+static uint32_t
+_parcLogReporterAsync_RingElements(uint32_t capacity)
+{
+    // The ring holds one fewer entry than it has elements.
+    uint32_t elements = 2;
+    while (elements - 1 < capacity) {
+        elements <<= 1;
+    }
+    return elements;
+}
+
+PARCLogReporter *
+parcLogReporterAsync_Create(int fileDescriptor, uint32_t capacity, PARCLogReporterAsyncOverflow overflow)
+{
+    _PARCLogReporterAsync *async = parcObject_CreateAndClearInstance(_PARCLogReporterAsync);
+    if (async == NULL) {
+        return NULL;
+    }
+
+    pthread_mutex_init(&async->mutex, NULL);
+    pthread_cond_init(&async->wakeWriter, NULL);
+    pthread_cond_init(&async->progress, NULL);
+    async->fd = fileDescriptor;
+    async->overflow = overflow;
+    async->ring = parcRingBufferNxM_Create(_parcLogReporterAsync_RingElements(capacity), _parcLogReporterAsync_DestroyEntry);
+
+    async->writerStarted = (pthread_create(&async->writer, NULL, _parcLogReporterAsync_Writer, async) == 0);
+    if (!async->writerStarted) {
+        parcObject_Release((PARCObject **) &async);
+        return NULL;
+    }
+
+    PARCLogReporter *result = parcLogReporter_Create(&parcLogReporterAsync_Acquire,
+                                                     parcLogReporterAsync_Release,
+                                                     parcLogReporterAsync_Report,
+                                                     async);
+    return result;
+}
+
+PARCLogReporter *
+parcLogReporterAsync_Acquire(const PARCLogReporter *reporter)
+{
+    return parcObject_Acquire(reporter);
+}
+
+void
+parcLogReporterAsync_Release(PARCLogReporter **reporterP)
+{
+    parcObject_Release((void **) reporterP);
+}
+
+static void
+_parcLogReporterAsync_PutBlocking(_PARCLogReporterAsync *async, PARCLogEntry *entry)
+{
+    __atomic_add_fetch(&async->blocked, 1, __ATOMIC_RELAXED);
+
+    pthread_mutex_lock(&async->mutex);
+    __atomic_add_fetch(&async->waiters, 1, __ATOMIC_SEQ_CST);
+    while (!parcRingBufferNxM_Put(async->ring, entry)) {
+        pthread_cond_signal(&async->wakeWriter);
+        struct timespec deadline;
+        _parcLogReporterAsync_AbsoluteTimeout(&deadline, _parcLogReporterAsync_IdleWaitNanoseconds);
+        pthread_cond_timedwait(&async->progress, &async->mutex, &deadline);
+    }
+    __atomic_sub_fetch(&async->waiters, 1, __ATOMIC_SEQ_CST);
+    pthread_mutex_unlock(&async->mutex);
+}
+
+void
+parcLogReporterAsync_Report(PARCLogReporter *reporter, const PARCLogEntry *entry)
+{
+    _PARCLogReporterAsync *async = parcLogReporter_GetPrivateObject(reporter);
+
+    // Count the entry before publishing it. Otherwise the writer could complete it before it is counted,
+    // and a concurrent Flush would see completed reach its target while an earlier entry is still in the ring.
+    __atomic_add_fetch(&async->enqueued, 1, __ATOMIC_SEQ_CST);
+
+    PARCLogEntry *queued = parcLogEntry_Acquire(entry);
+    if (!parcRingBufferNxM_Put(async->ring, queued)) {
+        switch (async->overflow) {
+            case PARCLogReporterAsyncOverflow_Block:
+                _parcLogReporterAsync_PutBlocking(async, queued);
+                break;
+
+            case PARCLogReporterAsyncOverflow_DropOldest:
+                do {
+                    void *oldest;
+                    if (parcRingBufferNxM_Get(async->ring, &oldest)) {
+                        parcLogEntry_Release((PARCLogEntry **) &oldest);
+                        __atomic_add_fetch(&async->dropped, 1, __ATOMIC_RELAXED);
+                        __atomic_add_fetch(&async->completed, 1, __ATOMIC_SEQ_CST);
+                    }
+                } while (!parcRingBufferNxM_Put(async->ring, queued));
+                break;
+
+            case PARCLogReporterAsyncOverflow_DropNewest:
+                parcLogEntry_Release(&queued);
+                __atomic_add_fetch(&async->dropped, 1, __ATOMIC_RELAXED);
+                __atomic_add_fetch(&async->completed, 1, __ATOMIC_SEQ_CST);
+                return;
+
+            default:
+                trapIllegalValue(async->overflow, "Unknown PARCLogReporterAsyncOverflow %d", async->overflow);
+        }
+    }
+
+    _parcLogReporterAsync_WakeWriter(async);
+}
+
+void
+parcLogReporterAsync_Flush(PARCLogReporter *reporter)
+{
+    _PARCLogReporterAsync *async = parcLogReporter_GetPrivateObject(reporter);
+
+    uint64_t target = __atomic_load_n(&async->enqueued, __ATOMIC_SEQ_CST);
+
+    pthread_mutex_lock(&async->mutex);
+    __atomic_add_fetch(&async->waiters, 1, __ATOMIC_SEQ_CST);
+    while (__atomic_load_n(&async->completed, __ATOMIC_SEQ_CST) < target) {
+        pthread_cond_signal(&async->wakeWriter);
+        struct timespec deadline;
+        _parcLogReporterAsync_AbsoluteTimeout(&deadline, _parcLogReporterAsync_IdleWaitNanoseconds);
+        pthread_cond_timedwait(&async->progress, &async->mutex, &deadline);
+    }
+    __atomic_sub_fetch(&async->waiters, 1, __ATOMIC_SEQ_CST);
+    pthread_mutex_unlock(&async->mutex);
+}
+
+uint64_t
+parcLogReporterAsync_GetWrittenCount(const PARCLogReporter *reporter)
+{
+    _PARCLogReporterAsync *async = parcLogReporter_GetPrivateObject(reporter);
+    return __atomic_load_n(&async->written, __ATOMIC_ACQUIRE);
+}
+
+uint64_t
+parcLogReporterAsync_GetDroppedCount(const PARCLogReporter *reporter)
+{
+    _PARCLogReporterAsync *async = parcLogReporter_GetPrivateObject(reporter);
+    return __atomic_load_n(&async->dropped, __ATOMIC_ACQUIRE);
+}
+
+uint64_t
+parcLogReporterAsync_GetBlockedCount(const PARCLogReporter *reporter)
+{
+    _PARCLogReporterAsync *async = parcLogReporter_GetPrivateObject(reporter);
+    return __atomic_load_n(&async->blocked, __ATOMIC_ACQUIRE);
+}
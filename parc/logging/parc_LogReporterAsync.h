@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2015, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @file parc_LogReporterAsync.h
+ * @brief A PARCLogReporter that formats and writes log entries on a background thread.
+ *
+ * `parcLogReporterFile_Report` formats each entry and writes it to its output stream on the calling thread,
+ * which is often an event loop that should not wait for disk or terminal I/O.
+ * The asynchronous reporter only acquires the entry and puts it on a lock-free {@link PARCRingBufferNxM}.
+ * A dedicated writer thread takes entries off the ring in batches, formats them as RFC 5424 syslog lines
+ * (the same format as {@link parcLogReporterFile_Report}) and writes each batch with a single `writev(2)`.
+ *
+ * When the ring is full, the reporter applies the `PARCLogReporterAsyncOverflow` policy it was created with,
+ * and counts the entries that the policy discarded or the reports that had to wait.
+ *
+ * Releasing the last reference to the reporter writes every entry still on the ring,
+ * stops the writer thread and closes the file descriptor.
+ *
+ * @author Glenn Scott, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#ifndef PARC_Library_parc_LogReporterAsync_h
+#define PARC_Library_parc_LogReporterAsync_h
+
+#include <stdint.h>
+
+#include <parc/logging/parc_LogReporter.h>
+
+/**
+ * @typedef PARCLogReporterAsyncOverflow
+ * @brief What `parcLogReporterAsync_Report` does when the ring is full.
+ */
+typedef enum {
+    PARCLogReporterAsyncOverflow_Block,      /**< Wait for the writer thread to make room. Nothing is lost. */
+    PARCLogReporterAsyncOverflow_DropOldest, /**< Discard the oldest entry on the ring to make room for the new one. */
+    PARCLogReporterAsyncOverflow_DropNewest  /**< Discard the new entry. */
+} PARCLogReporterAsyncOverflow;
+
+/**
+ * Create a new instance of an asynchronous `PARCLogReporter` writing to the given file descriptor.
+ *
+ * The reporter takes ownership of the file descriptor and closes it when the reporter is destroyed,
+ * in the same way as {@link parcFileOutputStream_Create}.
+ *
+ * @param [in] fileDescriptor An open file descriptor.
+ * @param [in] capacity The minimum number of entries the ring holds before the overflow policy applies.
+ * @param [in] overflow The `PARCLogReporterAsyncOverflow` policy for a full ring.
+ *
+ * @return NULL Memory could not be allocated, or the writer thread could not be started.
+ * @return non-NULL A pointer to a valid `PARCLogReporter` instance.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCLogReporter *reporter = parcLogReporterAsync_Create(dup(STDOUT_FILENO), 1024,
+ *                                                             PARCLogReporterAsyncOverflow_DropOldest);
+ *
+ *     PARCLog *log = parcLog_Create("localhost", "myApp", "daemon", reporter);
+ *     parcLogReporter_Release(&reporter);
+ *
+ *     parcLog_Info(log, "Hello World");
+ *
+ *     parcLog_Release(&log);
+ * }
+ * @endcode
+ */
+PARCLogReporter *parcLogReporterAsync_Create(int fileDescriptor, uint32_t capacity, PARCLogReporterAsyncOverflow overflow);
+
+/**
+ * Increase the number of references to a `PARCLogReporter` instance.
+ *
+ * Note that new `PARCLogReporter` is not created,
+ * only that the given `PARCLogReporter` reference count is incremented.
+ * Discard the reference by invoking `parcLogReporterAsync_Release`.
+ *
+ * @param [in] instance A pointer to a `PARCLogReporter` instance.
+ *
+ * @return The input `PARCLogReporter` pointer.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCLogReporter *x = parcLogReporterAsync_Create(...);
+ *
+ *     PARCLogReporter *x_2 = parcLogReporterAsync_Acquire(x);
+ *
+ *     parcLogReporterAsync_Release(&x);
+ *     parcLogReporterAsync_Release(&x_2);
+ * }
+ * @endcode
+ */
+PARCLogReporter *parcLogReporterAsync_Acquire(const PARCLogReporter *instance);
+
+/**
+ * Release a previously acquired reference to the specified instance,
+ * decrementing the reference count for the instance.
+ *
+ * The pointer to the instance is set to NULL as a side-effect of this function.
+ *
+ * If the invocation causes the last reference to the instance to be released,
+ * every entry still waiting is written, the writer thread is stopped and the file descriptor is closed.
+ *
+ * @param [in,out] reporterP A pointer to a PARCLogReporter instance pointer, which will be set to zero on return.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCLogReporter *x = parcLogReporterAsync_Create(...);
+ *
+ *     parcLogReporterAsync_Release(&x);
+ * }
+ * @endcode
+ */
+void parcLogReporterAsync_Release(PARCLogReporter **reporterP);
+
+/**
+ * Queue the given PARCLogEntry to be written by the writer thread.
+ *
+ * The reporter acquires its own reference to the entry, so the caller may release it immediately.
+ * May be called from any number of threads at once.
+ *
+ * @param [in] reporter A pointer to a valid PARCLogReporter instance.
+ * @param [in] entry A pointer to a valid PARCLogEntry instance.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcLogReporter_Report(reporter, entry);
+ * }
+ * @endcode
+ */
+void parcLogReporterAsync_Report(PARCLogReporter *reporter, const PARCLogEntry *entry);
+
+/**
+ * Wait until every entry reported before this call has been written or discarded.
+ *
+ * @param [in] reporter A pointer to a valid PARCLogReporter instance created by `parcLogReporterAsync_Create`.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcLog_Critical(log, "Shutting down");
+ *     parcLogReporterAsync_Flush(reporter);
+ * }
+ * @endcode
+ */
+void parcLogReporterAsync_Flush(PARCLogReporter *reporter);
+
+/**
+ * Get the number of entries the writer thread has written.
+ *
+ * @param [in] reporter A pointer to a valid PARCLogReporter instance created by `parcLogReporterAsync_Create`.
+ *
+ * @return The number of entries written so far.
+ */
+uint64_t parcLogReporterAsync_GetWrittenCount(const PARCLogReporter *reporter);
+
+/**
+ * Get the number of entries discarded by the `PARCLogReporterAsyncOverflow_DropOldest`
+ * or `PARCLogReporterAsyncOverflow_DropNewest` policy.
+ *
+ * @param [in] reporter A pointer to a valid PARCLogReporter instance created by `parcLogReporterAsync_Create`.
+ *
+ * @return The number of entries discarded so far.
+ */
+uint64_t parcLogReporterAsync_GetDroppedCount(const PARCLogReporter *reporter);
+
+/**
+ * Get the number of reports that found the ring full and waited,
+ * under the `PARCLogReporterAsyncOverflow_Block` policy.
+ *
+ * @param [in] reporter A pointer to a valid PARCLogReporter instance created by `parcLogReporterAsync_Create`.
+ *
+ * @return The number of reports that waited so far.
+ */
+uint64_t parcLogReporterAsync_GetBlockedCount(const PARCLogReporter *reporter);
+#endif /* PARC_Library_parc_LogReporterAsync_h */
@@ -0,0 +1,482 @@
+/*
+ * Copyright (c) 2015, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * Every operation takes the reporter's mutex.  An entry is formatted straight into the buffer: the syslog header
+ * with parcLogFormatSyslog_FormatHeader, then the payload and the trailer, so a buffered report makes no allocation.
+ * An entry larger than the whole buffer is written by itself with writev(2).
+ *
+ * The size of the file is tracked as it is written, starting from its size when it was opened, so deciding whether
+ * to rotate needs no system call.  The age of the file is measured from when this reporter opened it.
+ *
+ * @author Glenn Scott, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include <config.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <LongBow/runtime.h>
+
+#include <parc/logging/parc_LogReporterRotating.h>
+#include <parc/logging/parc_LogFormatSyslog.h>
+
+#include <parc/algol/parc_Memory.h>
+#include <parc/algol/parc_Object.h>
+
+#define _parcLogReporterRotating_DefaultBufferSize (64 * 1024)
+#define _parcLogReporterRotating_DefaultFlushInterval 1000
+#define _parcLogReporterRotating_SyncDisabled UINT32_MAX
+#define _parcLogReporterRotating_HeaderSize 512
+
+static const char _parcLogReporterRotating_Trailer[] = " ]\n";
+#define _parcLogReporterRotating_TrailerLength (sizeof(_parcLogReporterRotating_Trailer) - 1)
+
+typedef struct {
+    pthread_mutex_t mutex;
+
+    char *path;
+    int fd;
+    size_t fileSize;
+    uint64_t openedAt;
+    size_t maxFileSize;
+    uint64_t maxFileAge;
+    uint32_t retainedFiles;
+
+    uint8_t *buffer;
+    size_t bufferSize;
+    size_t buffered;
+    uint64_t bufferedSince;
+    uint64_t flushInterval;
+    PARCLogLevel flushLevel;
+
+    uint32_t syncInterval;
+    uint64_t lastSync;
+    bool unsynced;
+
+    uint64_t rotations;
+    uint64_t writes;
+    uint64_t syncs;
+} _PARCLogReporterRotating;
+
+static uint64_t
+_parcLogReporterRotating_Now(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000000000ULL + (uint64_t) now.tv_nsec;
+}
+
+static void
+_parcLogReporterRotating_Open(_PARCLogReporterRotating *rotating)
+{
+    rotating->fd = open(rotating->path, O_WRONLY | O_APPEND | O_CREAT, 0644);
+    rotating->fileSize = 0;
+    if (rotating->fd >= 0) {
+        struct stat statbuf;
+        if (fstat(rotating->fd, &statbuf) == 0) {
+            rotating->fileSize = (size_t) statbuf.st_size;
+        }
+    }
+    rotating->openedAt = _parcLogReporterRotating_Now();
+}
+
+/*
+ * Write every byte described by the iovec array, resuming after short writes.
+ * A write error other than EINTR abandons the rest: there is nowhere to report it.
+ */
+static void
+_parcLogReporterRotating_WriteAll(_PARCLogReporterRotating *rotating, struct iovec *iov, int iovcnt)
+{
+    if (rotating->fd < 0) {
+        return;
+    }
+    while (iovcnt > 0) {
+        ssize_t nwritten = writev(rotating->fd, iov, iovcnt);
+        if (nwritten < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        rotating->writes++;
+        rotating->fileSize += (size_t) nwritten;
+        rotating->unsynced = true;
+        while (iovcnt > 0 && (size_t) nwritten >= iov->iov_len) {
+            nwritten -= iov->iov_len;
+            iov++;
+            iovcnt--;
+        }
+        if (iovcnt > 0) {
+            iov->iov_base = (uint8_t *) iov->iov_base + nwritten;
+            iov->iov_len -= nwritten;
+        }
+    }
+}
+
+static void
+_parcLogReporterRotating_WriteBuffer(_PARCLogReporterRotating *rotating)
+{
+    if (rotating->buffered > 0) {
+        struct iovec iov = { .iov_base = rotating->buffer, .iov_len = rotating->buffered };
+        _parcLogReporterRotating_WriteAll(rotating, &iov, 1);
+        rotating->buffered = 0;
+    }
+}
+
+static void
+_parcLogReporterRotating_Sync(_PARCLogReporterRotating *rotating, uint64_t now)
+{
+    if (rotating->unsynced && rotating->fd >= 0) {
+#if defined(__APPLE__)
+        fsync(rotating->fd);
+#else
+        fdatasync(rotating->fd);
+#endif
+        rotating->syncs++;
+        rotating->unsynced = false;
+    }
+    rotating->lastSync = now;
+}
+
+static void
+_parcLogReporterRotating_Flush(_PARCLogReporterRotating *rotating, uint64_t now)
+{
+    _parcLogReporterRotating_WriteBuffer(rotating);
+    if (rotating->syncInterval != _parcLogReporterRotating_SyncDisabled) {
+        _parcLogReporterRotating_Sync(rotating, now);
+    }
+}
+
+/*
+ * Rename path.(n-1) to path.n, down to path to path.1, after removing the file that would fall off the end.
+ * With no files to retain, the current file is simply removed.
+ */
+static void
+_parcLogReporterRotating_ShiftFiles(const _PARCLogReporterRotating *rotating)
+{
+    size_t nameLength = strlen(rotating->path) + 16;
+    char from[nameLength];
+    char to[nameLength];
+
+    if (rotating->retainedFiles == 0) {
+        unlink(rotating->path);
+        return;
+    }
+
+    snprintf(to, nameLength, "%s.%u", rotating->path, rotating->retainedFiles);
+    unlink(to);
+    for (uint32_t n = rotating->retainedFiles; n > 1; n--) {
+        snprintf(from, nameLength, "%s.%u", rotating->path, n - 1);
+        snprintf(to, nameLength, "%s.%u", rotating->path, n);
+        rename(from, to);
+    }
+    snprintf(to, nameLength, "%s.1", rotating->path);
+    rename(rotating->path, to);
+}
+
+static bool
+_parcLogReporterRotating_Rotate(_PARCLogReporterRotating *rotating, uint64_t now)
+{
+    _parcLogReporterRotating_Flush(rotating, now);
+    if (rotating->fd >= 0) {
+        close(rotating->fd);
+    }
+    _parcLogReporterRotating_ShiftFiles(rotating);
+    _parcLogReporterRotating_Open(rotating);
+    rotating->rotations++;
+
+    return rotating->fd >= 0;
+}
+
+static void
+_parcLogReporterRotating_Destroy(_PARCLogReporterRotating **rotatingPtr)
+{
+    _PARCLogReporterRotating *rotating = *rotatingPtr;
+
+    _parcLogReporterRotating_Flush(rotating, _parcLogReporterRotating_Now());
+    if (rotating->fd >= 0) {
+        close(rotating->fd);
+    }
+    if (rotating->buffer != NULL) {
+        parcMemory_Deallocate(&rotating->buffer);
+    }
+    parcMemory_Deallocate(&rotating->path);
+    pthread_mutex_destroy(&rotating->mutex);
+}
+
+parcObject_ExtendPARCObject(_PARCLogReporterRotating, _parcLogReporterRotating_Destroy, NULL, NULL, NULL, NULL, NULL, NULL);
+
+static void
+_parcLogReporterRotating_SetBufferSize(_PARCLogReporterRotating *rotating, size_t bufferSize)
+{
+    if (rotating->buffer != NULL) {
+        parcMemory_Deallocate(&rotating->buffer);
+    }
+    rotating->bufferSize = bufferSize;
+    if (bufferSize > 0) {
+        rotating->buffer = parcMemory_Allocate(bufferSize);
+        assertNotNull(rotating->buffer, "parcMemory_Allocate(%zu) returned NULL", bufferSize);
+    }
+}
+
+PARCLogReporter *
+parcLogReporterRotating_Create(const char *path, size_t maxFileSize, uint32_t maxFileAgeSeconds, uint32_t retainedFiles)
+{
+    _PARCLogReporterRotating *rotating = parcObject_CreateAndClearInstance(_PARCLogReporterRotating);
+    if (rotating == NULL) {
+        return NULL;
+    }
+
+    pthread_mutex_init(&rotating->mutex, NULL);
+    rotating->path = parcMemory_StringDuplicate(path, strlen(path));
+    rotating->maxFileSize = maxFileSize;
+    rotating->maxFileAge = (uint64_t) maxFileAgeSeconds * 1000000000ULL;
+    rotating->retainedFiles = retainedFiles;
+    rotating->flushInterval = _parcLogReporterRotating_DefaultFlushInterval * 1000000ULL;
+    rotating->flushLevel = PARCLogLevel_Error;
+    rotating->syncInterval = _parcLogReporterRotating_SyncDisabled;
+    _parcLogReporterRotating_SetBufferSize(rotating, _parcLogReporterRotating_DefaultBufferSize);
+
+    _parcLogReporterRotating_Open(rotating);
+    if (rotating->fd < 0) {
+        parcObject_Release((PARCObject **) &rotating);
+        return NULL;
+    }
+    rotating->lastSync = rotating->openedAt;
+
+    PARCLogReporter *result = parcLogReporter_Create(&parcLogReporterRotating_Acquire,
+                                                     parcLogReporterRotating_Release,
+                                                     parcLogReporterRotating_Report,
+                                                     rotating);
+    return result;
+}
+
+PARCLogReporter *
+parcLogReporterRotating_Acquire(const PARCLogReporter *reporter)
+{
+    return parcObject_Acquire(reporter);
+}
+
+void
+parcLogReporterRotating_Release(PARCLogReporter **reporterP)
+{
+    parcObject_Release((void **) reporterP);
+}
+
+void
+parcLogReporterRotating_Report(PARCLogReporter *reporter, const PARCLogEntry *entry)
+{
+    _PARCLogReporterRotating *rotating = parcLogReporter_GetPrivateObject(reporter);
+
+    char header[_parcLogReporterRotating_HeaderSize];
+    size_t headerLength = parcLogFormatSyslog_FormatHeader(entry, header, sizeof(header));
+
+    PARCBuffer *formatted = NULL;
+    PARCBuffer *payload = parcLogEntry_GetPayload(entry);
+    if (headerLength == 0) {
+        // Only an unusually long host, application or process name gets here.
+        formatted = parcLogFormatSyslog_FormatEntry(entry);
+        payload = formatted;
+    }
+    size_t payloadLength = parcBuffer_Remaining(payload);
+    const uint8_t *payloadBytes = NULL;
+    if (payloadLength > 0) {
+        payloadBytes = parcByteArray_AddressOfIndex(parcBuffer_Array(payload),
+                                                    parcBuffer_ArrayOffset(payload) + parcBuffer_Position(payload));
+    }
+    size_t trailerLength = (formatted == NULL) ? _parcLogReporterRotating_TrailerLength : 0;
+    size_t entryLength = headerLength + payloadLength + trailerLength;
+
+    pthread_mutex_lock(&rotating->mutex);
+    uint64_t now = _parcLogReporterRotating_Now();
+
+    size_t pending = rotating->fileSize + rotating->buffered;
+    if ((rotating->maxFileAge > 0 && now - rotating->openedAt >= rotating->maxFileAge)
+        || (rotating->maxFileSize > 0 && pending > 0 && pending + entryLength > rotating->maxFileSize)) {
+        _parcLogReporterRotating_Rotate(rotating, now);
+    }
+
+    if (rotating->buffered + entryLength > rotating->bufferSize) {
+        _parcLogReporterRotating_WriteBuffer(rotating);
+    }
+    if (entryLength > rotating->bufferSize) {
+        struct iovec iov[3] = {
+            { .iov_base = header,                                  .iov_len = headerLength  },
+            { .iov_base = (void *) payloadBytes,                   .iov_len = payloadLength },
+            { .iov_base = (void *) _parcLogReporterRotating_Trailer, .iov_len = trailerLength }
+        };
+        _parcLogReporterRotating_WriteAll(rotating, iov, 3);
+    } else {
+        if (rotating->buffered == 0) {
+            rotating->bufferedSince = now;
+        }
+        uint8_t *next = rotating->buffer + rotating->buffered;
+        memcpy(next, header, headerLength);
+        if (payloadLength > 0) {
+            memcpy(next + headerLength, payloadBytes, payloadLength);
+        }
+        memcpy(next + headerLength + payloadLength, _parcLogReporterRotating_Trailer, trailerLength);
+        rotating->buffered += entryLength;
+    }
+
+    if (parcLogLevel_Compare(rotating->flushLevel, parcLogEntry_GetLevel(entry)) >= 0) {
+        _parcLogReporterRotating_Flush(rotating, now);
+    } else {
+        if (rotating->buffered > 0 && rotating->flushInterval > 0 && now - rotating->bufferedSince >= rotating->flushInterval) {
+            _parcLogReporterRotating_WriteBuffer(rotating);
+        }
+        if (rotating->syncInterval != _parcLogReporterRotating_SyncDisabled
+            && now - rotating->lastSync >= (uint64_t) rotating->syncInterval * 1000000ULL) {
+            _parcLogReporterRotating_Sync(rotating, now);
+        }
+    }
+    pthread_mutex_unlock(&rotating->mutex);
+
+    if (formatted != NULL) {
+        parcBuffer_Release(&formatted);
+    }
+}
+
+void
+parcLogReporterRotating_SetBuffering(PARCLogReporter *reporter, size_t bufferSize, uint32_t flushIntervalMilliseconds,
+                                     PARCLogLevel flushLevel)
+{
+    _PARCLogReporterRotating *rotating = parcLogReporter_GetPrivateObject(reporter);
+
+    pthread_mutex_lock(&rotating->mutex);
+    _parcLogReporterRotating_WriteBuffer(rotating);
+    if (bufferSize != rotating->bufferSize) {
+        _parcLogReporterRotating_SetBufferSize(rotating, bufferSize);
+    }
+    rotating->flushInterval = (uint64_t) flushIntervalMilliseconds * 1000000ULL;
+    rotating->flushLevel = flushLevel;
+    pthread_mutex_unlock(&rotating->mutex);
+}
+
+void
+parcLogReporterRotating_SetSyncInterval(PARCLogReporter *reporter, uint32_t syncIntervalMilliseconds)
+{
+    _PARCLogReporterRotating *rotating = parcLogReporter_GetPrivateObject(reporter);
+
+    pthread_mutex_lock(&rotating->mutex);
+    rotating->syncInterval = syncIntervalMilliseconds;
+    pthread_mutex_unlock(&rotating->mutex);
+}
+
+void
+parcLogReporterRotating_Flush(PARCLogReporter *reporter)
+{
+    _PARCLogReporterRotating *rotating = parcLogReporter_GetPrivateObject(reporter);
+
+    pthread_mutex_lock(&rotating->mutex);
+    _parcLogReporterRotating_Flush(rotating, _parcLogReporterRotating_Now());
+    pthread_mutex_unlock(&rotating->mutex);
+}
+
+bool
+parcLogReporterRotating_Rotate(PARCLogReporter *reporter)
+{
+    _PARCLogReporterRotating *rotating = parcLogReporter_GetPrivateObject(reporter);
+
+    pthread_mutex_lock(&rotating->mutex);
+    bool result = _parcLogReporterRotating_Rotate(rotating, _parcLogReporterRotating_Now());
+    pthread_mutex_unlock(&rotating->mutex);
+
+    return result;
+}
+
+uint64_t
+parcLogReporterRotating_GetRotationCount(const PARCLogReporter *reporter)
+{
+    _PARCLogReporterRotating *rotating = parcLogReporter_GetPrivateObject(reporter);
+
+    pthread_mutex_lock(&rotating->mutex);
+    uint64_t result = rotating->rotations;
+    pthread_mutex_unlock(&rotating->mutex);
+
+    return result;
+}
+
+uint64_t
+parcLogReporterRotating_GetWriteCount(const PARCLogReporter *reporter)
+{
+    _PARCLogReporterRotating *rotating = parcLogReporter_GetPrivateObject(reporter);
+
+    pthread_mutex_lock(&rotating->mutex);
+    uint64_t result = rotating->writes;
+    pthread_mutex_unlock(&rotating->mutex);
+
+    return result;
+}
+
+uint64_t
+parcLogReporterRotating_GetSyncCount(const PARCLogReporter *reporter)
+{
+    _PARCLogReporterRotating *rotating = parcLogReporter_GetPrivateObject(reporter);
+
+    pthread_mutex_lock(&rotating->mutex);
+    uint64_t result = rotating->syncs;
+    pthread_mutex_unlock(&rotating->mutex);
+
+    return result;
+}
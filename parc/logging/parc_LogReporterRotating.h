@@ -0,0 +1,285 @@
+/*
+ * Copyright (c) 2015, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @file parc_LogReporterRotating.h
+ * @brief A PARCLogReporter that writes buffered log entries to a file that it rotates by size and age.
+ *
+ * `parcLogReporterFile_Report` writes every entry to its output stream as it is reported, and leaves rotation to
+ * an external tool such as logrotate, whose copytruncate mode loses the lines written while it copies.
+ * This reporter owns the log file instead.
+ *
+ * Entries are formatted as RFC 5424 syslog lines (the same format as {@link parcLogReporterFile_Report})
+ * into an in-memory buffer, which is written to the file with one `write(2)` when:
+ *   * the next entry would not fit in it,
+ *   * its oldest entry has been buffered for longer than the flush interval,
+ *   * an entry at the flush level (by default `PARCLogLevel_Error`) or more severe is reported,
+ *   * `parcLogReporterRotating_Flush` is called, or the reporter is released.
+ * There is no timer: a buffer that has outlived the flush interval is written by the next report.
+ *
+ * The file is opened with `O_APPEND`.  It is rotated when the next entry would make it larger than the maximum
+ * size, when it has been open for longer than the maximum age, or when `parcLogReporterRotating_Rotate` is called.
+ * Rotation writes the buffer, renames `path` to `path.1`, `path.1` to `path.2` and so on, deletes the oldest file
+ * beyond the number to retain, and opens a new `path`.  Nothing is copied, so nothing is lost.
+ *
+ * Optionally, the reporter calls `fdatasync(2)` after writing, at most once per sync interval,
+ * so that many writes share the cost of one sync.  A flush, a rotation and an entry at the flush level
+ * are always synced when syncing is enabled.
+ *
+ * The reporter may be used from any number of threads; reports are serialised by a mutex.
+ *
+ * @author Glenn Scott, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#ifndef PARC_Library_parc_LogReporterRotating_h
+#define PARC_Library_parc_LogReporterRotating_h
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <parc/logging/parc_LogReporter.h>
+#include <parc/logging/parc_LogLevel.h>
+
+/**
+ * Create a new instance of a rotating, buffered `PARCLogReporter` writing to the file at the given path.
+ *
+ * The file is created if it does not exist, and appended to if it does.
+ * The reporter starts with a 64 KB buffer, a flush interval of one second, a flush level of `PARCLogLevel_Error`,
+ * and syncing disabled.  See `parcLogReporterRotating_SetBuffering` and `parcLogReporterRotating_SetSyncInterval`.
+ *
+ * @param [in] path A pointer to a nul-terminated C string naming the log file.
+ * @param [in] maxFileSize The size in bytes beyond which the file is rotated, or 0 for no limit.
+ * @param [in] maxFileAgeSeconds The number of seconds after which the file is rotated, or 0 for no limit.
+ * @param [in] retainedFiles The number of rotated files to keep, `path.1` being the most recent.
+ *
+ * @return NULL The file could not be opened.
+ * @return non-NULL A pointer to a valid `PARCLogReporter` instance.
+ *
+ * Example:
+ * @code
+ * {
+ *     // Rotate at 10 MB or daily, keeping a week of files.
+ *     PARCLogReporter *reporter = parcLogReporterRotating_Create("/var/log/myApp.log", 10 * 1024 * 1024, 86400, 7);
+ *
+ *     PARCLog *log = parcLog_Create("localhost", "myApp", "daemon", reporter);
+ *     parcLogReporter_Release(&reporter);
+ * }
+ * @endcode
+ */
+PARCLogReporter *parcLogReporterRotating_Create(const char *path, size_t maxFileSize, uint32_t maxFileAgeSeconds,
+                                                uint32_t retainedFiles);
+
+/**
+ * Increase the number of references to a `PARCLogReporter` instance.
+ *
+ * Note that a new `PARCLogReporter` is not created,
+ * only that the given `PARCLogReporter` reference count is incremented.
+ * Discard the reference by invoking `parcLogReporterRotating_Release`.
+ *
+ * @param [in] reporter A pointer to a `PARCLogReporter` instance.
+ *
+ * @return The input `PARCLogReporter` pointer.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCLogReporter *reporter = parcLogReporterRotating_Create("myApp.log", 0, 0, 0);
+ *     PARCLogReporter *x = parcLogReporterRotating_Acquire(reporter);
+ *
+ *     parcLogReporterRotating_Release(&reporter);
+ *     parcLogReporterRotating_Release(&x);
+ * }
+ * @endcode
+ */
+PARCLogReporter *parcLogReporterRotating_Acquire(const PARCLogReporter *reporter);
+
+/**
+ * Release a previously acquired reference to the specified instance,
+ * decrementing the reference count for the instance.
+ *
+ * The pointer to the instance is set to NULL as a side-effect of this function.
+ *
+ * If the invocation causes the last reference to the instance to be released,
+ * the buffer is written, synced if syncing is enabled, and the file is closed.
+ *
+ * @param [in,out] reporterP A pointer to a `PARCLogReporter` instance pointer, which will be set to zero on return.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCLogReporter *reporter = parcLogReporterRotating_Create("myApp.log", 0, 0, 0);
+ *
+ *     parcLogReporterRotating_Release(&reporter);
+ * }
+ * @endcode
+ */
+void parcLogReporterRotating_Release(PARCLogReporter **reporterP);
+
+/**
+ * Format the given `PARCLogEntry` into the buffer, writing the buffer and rotating the file as required.
+ *
+ * @param [in] reporter A pointer to a valid `PARCLogReporter` instance created by `parcLogReporterRotating_Create`.
+ * @param [in] entry A pointer to a valid `PARCLogEntry` instance.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCLogReporter *reporter = parcLogReporterRotating_Create("myApp.log", 0, 0, 0);
+ *
+ *     parcLogReporter_Report(reporter, entry);
+ *
+ *     parcLogReporterRotating_Release(&reporter);
+ * }
+ * @endcode
+ */
+void parcLogReporterRotating_Report(PARCLogReporter *reporter, const PARCLogEntry *entry);
+
+/**
+ * Set when the buffer is written to the file.
+ *
+ * The buffer is written first, so no buffered entry is lost when it shrinks.
+ *
+ * @param [in] reporter A pointer to a valid `PARCLogReporter` instance created by `parcLogReporterRotating_Create`.
+ * @param [in] bufferSize The size of the buffer in bytes, or 0 to write every entry as it is reported.
+ * @param [in] flushIntervalMilliseconds The longest time an entry stays in the buffer while entries are reported,
+ *                                       or 0 for no limit.
+ * @param [in] flushLevel Entries at this level or more severe are written as they are reported.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcLogReporterRotating_SetBuffering(reporter, 256 * 1024, 5000, PARCLogLevel_Warning);
+ * }
+ * @endcode
+ */
+void parcLogReporterRotating_SetBuffering(PARCLogReporter *reporter, size_t bufferSize, uint32_t flushIntervalMilliseconds,
+                                          PARCLogLevel flushLevel);
+
+/**
+ * Enable or disable syncing the file to storage with `fdatasync(2)` after writes.
+ *
+ * @param [in] reporter A pointer to a valid `PARCLogReporter` instance created by `parcLogReporterRotating_Create`.
+ * @param [in] syncIntervalMilliseconds The shortest time between syncs after ordinary writes,
+ *                                      0 to sync after every write, or `UINT32_MAX` to disable syncing.
+ *
+ * Example:
+ * @code
+ * {
+ *     // Sync at most ten times a second.
+ *     parcLogReporterRotating_SetSyncInterval(reporter, 100);
+ * }
+ * @endcode
+ */
+void parcLogReporterRotating_SetSyncInterval(PARCLogReporter *reporter, uint32_t syncIntervalMilliseconds);
+
+/**
+ * Write the buffer to the file, and sync it if syncing is enabled.
+ *
+ * @param [in] reporter A pointer to a valid `PARCLogReporter` instance created by `parcLogReporterRotating_Create`.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcLogReporterRotating_Flush(reporter);
+ * }
+ * @endcode
+ */
+void parcLogReporterRotating_Flush(PARCLogReporter *reporter);
+
+/**
+ * Rotate the file now, regardless of its size and age.
+ *
+ * @param [in] reporter A pointer to a valid `PARCLogReporter` instance created by `parcLogReporterRotating_Create`.
+ *
+ * @return true The file was rotated and a new file opened.
+ * @return false The new file could not be opened; entries are discarded until a later rotation succeeds.
+ *
+ * Example:
+ * @code
+ * {
+ *     // On SIGHUP
+ *     parcLogReporterRotating_Rotate(reporter);
+ * }
+ * @endcode
+ */
+bool parcLogReporterRotating_Rotate(PARCLogReporter *reporter);
+
+/**
+ * Get the number of times the file has been rotated.
+ *
+ * @param [in] reporter A pointer to a valid `PARCLogReporter` instance created by `parcLogReporterRotating_Create`.
+ *
+ * @return The number of rotations since the reporter was created.
+ */
+uint64_t parcLogReporterRotating_GetRotationCount(const PARCLogReporter *reporter);
+
+/**
+ * Get the number of `write(2)` calls the reporter has made to its file.
+ *
+ * @param [in] reporter A pointer to a valid `PARCLogReporter` instance created by `parcLogReporterRotating_Create`.
+ *
+ * @return The number of writes since the reporter was created.
+ */
+uint64_t parcLogReporterRotating_GetWriteCount(const PARCLogReporter *reporter);
+
+/**
+ * Get the number of `fdatasync(2)` calls the reporter has made.
+ *
+ * @param [in] reporter A pointer to a valid `PARCLogReporter` instance created by `parcLogReporterRotating_Create`.
+ *
+ * @return The number of syncs since the reporter was created.
+ */
+uint64_t parcLogReporterRotating_GetSyncCount(const PARCLogReporter *reporter);
+#endif // PARC_Library_parc_LogReporterRotating_h
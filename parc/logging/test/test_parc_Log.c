@@ -162,6 +162,10 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, parcLog_Debug);
     LONGBOW_RUN_TEST_CASE(Global, parcLog_Info);
     LONGBOW_RUN_TEST_CASE(Global, parcLog_Message);
+    LONGBOW_RUN_TEST_CASE(Global, parcLog_MessageLimited);
+    LONGBOW_RUN_TEST_CASE(Global, parcLog_MessageLimited_WrongLevel);
+    LONGBOW_RUN_TEST_CASE(Global, parcLog_MessageLimited_Summary);
+    LONGBOW_RUN_TEST_CASE(Global, parcLog_WarningRateLimited);
     LONGBOW_RUN_TEST_CASE(Global, parcLog_IsLoggable_True);
     LONGBOW_RUN_TEST_CASE(Global, parcLog_IsLoggable_False);
 
@@ -376,6 +380,89 @@ LONGBOW_TEST_CASE(Global, parcLog_Message)
                 "Expected message to be logged");
 }
 
+LONGBOW_TEST_CASE(Global, parcLog_MessageLimited)
+{
+    PARCLog *log = (PARCLog *) longBowTestCase_GetClipBoardData(testCase);
+
+    PARCLogRateLimit limit;
+    parcLogRateLimit_Init(&limit, 1, 2, 0);
+
+    assertTrue(parcLog_MessageLimited(log, &limit, PARCLogLevel_Warning, 0, "This is warning %d", 1),
+               "Expected message to be logged");
+    assertTrue(parcLog_MessageLimited(log, &limit, PARCLogLevel_Warning, 0, "This is warning %d", 2),
+               "Expected message to be logged");
+    assertFalse(parcLog_MessageLimited(log, &limit, PARCLogLevel_Warning, 0, "This is warning %d", 3),
+                "Expected message to be suppressed");
+    assertFalse(parcLog_MessageLimited(log, &limit, PARCLogLevel_Emergency, 0, "This is an emergency message"),
+                "Expected an emergency message to be rate limited too");
+    assertTrue(parcLogRateLimit_GetSuppressedCount(&limit) == 2, "Expected 2 suppressed messages");
+}
+
+LONGBOW_TEST_CASE(Global, parcLog_MessageLimited_WrongLevel)
+{
+    PARCLog *log = (PARCLog *) longBowTestCase_GetClipBoardData(testCase);
+    parcLog_SetLevel(log, PARCLogLevel_Error);
+
+    PARCLogRateLimit limit;
+    parcLogRateLimit_Init(&limit, 1, 1, 0);
+
+    for (int i = 0; i < 10; i++) {
+        assertFalse(parcLog_MessageLimited(log, &limit, PARCLogLevel_Debug, 0, "This is a debug message"),
+                    "Expected message to not be logged");
+    }
+    assertTrue(parcLogRateLimit_GetSuppressedCount(&limit) == 0,
+               "Expected messages below the threshold not to be counted by the rate limit");
+    assertTrue(parcLog_MessageLimited(log, &limit, PARCLogLevel_Error, 0, "This is an error message"),
+               "Expected the token to be unused");
+}
+
+LONGBOW_TEST_CASE(Global, parcLog_MessageLimited_Summary)
+{
+    char fileName[] = "/tmp/test_parc_LogXXXXXX";
+    int fd = mkstemp(fileName);
+    unlink(fileName);
+
+    PARCFileOutputStream *fileOutput = parcFileOutputStream_Create(dup(fd));
+    PARCOutputStream *output = parcFileOutputStream_AsOutputStream(fileOutput);
+    parcFileOutputStream_Release(&fileOutput);
+    PARCLogReporter *reporter = parcLogReporterFile_Create(output);
+    parcOutputStream_Release(&output);
+    PARCLog *log = parcLog_Create("localhost", "test_parc_Log", NULL, reporter);
+    parcLogReporter_Release(&reporter);
+    parcLog_SetLevel(log, PARCLogLevel_All);
+
+    // Sampling one in four logs messages 0, 4 and 8, and the last two are preceded by a summary.
+    int line = __LINE__ + 2;
+    for (int i = 0; i < 10; i++) {
+        parcLog_MessageSampled(log, PARCLogLevel_Warning, 0, 4, "Sampled message %d", i);
+    }
+    parcLog_Release(&log);
+
+    char contents[2048];
+    ssize_t length = pread(fd, contents, sizeof(contents) - 1, 0);
+    close(fd);
+    assertTrue(length > 0, "Expected the log to have been written");
+    contents[length] = 0;
+
+    char summary[256];
+    snprintf(summary, sizeof(summary), "3 similar messages suppressed at %s:%d", __FILE__, line);
+
+    const char *first = strstr(contents, summary);
+    assertNotNull(first, "Expected '%s' in the log:\n%s", summary, contents);
+    assertNotNull(strstr(first + 1, summary), "Expected a second summary in the log:\n%s", contents);
+    assertNotNull(strstr(contents, "Sampled message 8"), "Expected message 8 in the log:\n%s", contents);
+    assertNull(strstr(contents, "Sampled message 5"), "Expected message 5 to be suppressed:\n%s", contents);
+}
+
+LONGBOW_TEST_CASE(Global, parcLog_WarningRateLimited)
+{
+    PARCLog *log = (PARCLog *) longBowTestCase_GetClipBoardData(testCase);
+
+    for (int i = 0; i < 100; i++) {
+        parcLog_WarningRateLimited(log, 1, 3, "This is rate limited warning %d of 100, only 3 are logged", i);
+    }
+}
+
 int
 main(int argc, char *argv[argc])
 {
@@ -0,0 +1,730 @@
+/*
+ * Copyright (c) 2015, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+// Include the file(s) containing the functions to be tested.
+// This permits internal static functions to be visible to this Test Runner.
+#include "../parc_LogFormatBinary.c"
+
+#include <fcntl.h>
+#include <stdlib.h>
+
+#include <parc/logging/parc_Log.h>
+#include <parc/logging/parc_LogFormatText.h>
+#include <parc/logging/parc_LogReporterFile.h>
+#include <parc/algol/parc_FileOutputStream.h>
+#include <parc/testing/parc_ObjectTesting.h>
+
+#include <parc/algol/parc_SafeMemory.h>
+#include <parc/algol/parc_StdlibMemory.h>
+
+#include <LongBow/unit-test.h>
+
+LONGBOW_TEST_RUNNER(parc_LogFormatBinary)
+{
+    // The following Test Fixtures will run their corresponding Test Cases.
+    // Test Fixtures are run in the order specified here, but every test must be idempotent.
+    // Never rely on the execution order of tests or share state between them.
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+    LONGBOW_RUN_TEST_FIXTURE(Static);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
+}
+
+// The Test Runner calls this function once before any Test Fixtures are run.
+LONGBOW_TEST_RUNNER_SETUP(parc_LogFormatBinary)
+{
+    parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// The Test Runner calls this function once after all the Test Fixtures are run.
+LONGBOW_TEST_RUNNER_TEARDOWN(parc_LogFormatBinary)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, parcLogFormatBinary_AcquireRelease);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogFormatBinary_Register);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogFormatBinary_Register_Many);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogFormatBinary_Register_Unsupported);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogFormatBinary_Message_Unregistered);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogFormatBinary_Message_TooLarge);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogFormatBinary_MessageVaList_Format);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogFormatBinary_Decode);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogFormatBinary_Decode_Header);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogFormatBinary_Decode_Malformed);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogFormatBinary_Decode_Stop);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogFormatBinary_Decode_FormatText);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogFormatBinary_Flush);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogFormatBinary_Threads);
+    LONGBOW_RUN_TEST_CASE(Global, parcLog_SetFormatBinary);
+}
+
+/*
+ * Each test writes to an unlinked temporary file and reads it back through a second descriptor.
+ */
+typedef struct {
+    int fd;
+    PARCLogFormatBinary *binary;
+} _TestData;
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    _TestData *data = parcMemory_Allocate(sizeof(_TestData));
+
+    char fileName[] = "/tmp/test_parc_LogFormatBinaryXXXXXX";
+    data->fd = mkstemp(fileName);
+    unlink(fileName);
+    data->binary = parcLogFormatBinary_Create(dup(data->fd), "hostname", "applicationname", "processid");
+
+    longBowTestCase_SetClipBoardData(testCase, data);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    _TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    if (data->binary != NULL) {
+        parcLogFormatBinary_Release(&data->binary);
+    }
+    close(data->fd);
+    parcMemory_Deallocate(&data);
+
+    uint32_t outstandingAllocations = parcSafeMemory_ReportAllocation(STDOUT_FILENO);
+    if (outstandingAllocations != 0) {
+        printf("%s leaks %d memory allocations\n", longBowTestCase_GetName(testCase), outstandingAllocations);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+/*
+ * Release the binary log, which writes every buffered record, and return the contents of the file.
+ */
+static PARCBuffer *
+_finish(_TestData *data)
+{
+    if (data->binary != NULL) {
+        parcLogFormatBinary_Release(&data->binary);
+    }
+
+    off_t length = lseek(data->fd, 0, SEEK_END);
+    PARCBuffer *result = parcBuffer_Allocate((size_t) length);
+    ssize_t nread = pread(data->fd, parcBuffer_Overlay(result, 0), (size_t) length, 0);
+    assertTrue(nread == length, "Expected to read %jd bytes, read %zd", (intmax_t) length, nread);
+    return result;
+}
+
+typedef struct {
+    size_t count;
+    size_t capacity;
+    PARCLogEntry **entries;
+    size_t stopAfter;
+} _Collected;
+
+static bool
+_collect(void *context, const PARCLogEntry *entry)
+{
+    _Collected *collected = context;
+    if (collected->count == collected->capacity) {
+        collected->capacity = (collected->capacity == 0) ? 16 : collected->capacity * 2;
+        collected->entries = realloc(collected->entries, collected->capacity * sizeof(PARCLogEntry *));
+    }
+    collected->entries[collected->count++] = parcLogEntry_Acquire(entry);
+    return collected->count != collected->stopAfter;
+}
+
+static void
+_collected_Release(_Collected *collected)
+{
+    for (size_t i = 0; i < collected->count; i++) {
+        parcLogEntry_Release(&collected->entries[i]);
+    }
+    free(collected->entries);
+}
+
+static void
+_assertPayload(const PARCLogEntry *entry, const char *expected)
+{
+    PARCBuffer *payload = parcLogEntry_GetPayload(entry);
+    char *actual = parcBuffer_ToString(payload);
+    assertTrue(strcmp(actual, expected) == 0, "Expected '%s', actual '%s'", expected, actual);
+    parcMemory_Deallocate(&actual);
+}
+
+LONGBOW_TEST_CASE(Global, parcLogFormatBinary_AcquireRelease)
+{
+    _TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    parcObjectTesting_AssertAcquireReleaseContract(parcLogFormatBinary_Acquire, data->binary);
+}
+
+LONGBOW_TEST_CASE(Global, parcLogFormatBinary_Register)
+{
+    _TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    assertFalse(parcLogFormatBinary_IsRegistered(data->binary, 1), "Expected message 1 not to be registered");
+    assertTrue(parcLogFormatBinary_Register(data->binary, 1, "Hello %s"), "Expected the format to be registered");
+    assertTrue(parcLogFormatBinary_IsRegistered(data->binary, 1), "Expected message 1 to be registered");
+
+    assertTrue(parcLogFormatBinary_Register(data->binary, 1, "Hello %s"), "Expected re-registering the same format to succeed");
+    assertFalse(parcLogFormatBinary_Register(data->binary, 1, "Goodbye %s"), "Expected a conflicting format to be refused");
+}
+
+LONGBOW_TEST_CASE(Global, parcLogFormatBinary_Register_Many)
+{
+    _TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    // Enough to grow the table several times.
+    for (uint64_t id = 0; id < 1000; id++) {
+        assertTrue(parcLogFormatBinary_Register(data->binary, id * 7919, "message %d"), "Expected message %" PRIu64 " to be registered", id);
+    }
+    for (uint64_t id = 0; id < 1000; id++) {
+        assertTrue(parcLogFormatBinary_IsRegistered(data->binary, id * 7919), "Expected message %" PRIu64 " to be registered", id);
+        assertTrue(parcLogFormatBinary_Message(data->binary, PARCLogLevel_Info, id * 7919, (int) id), "Expected message to be logged");
+    }
+
+    PARCBuffer *contents = _finish(data);
+    _Collected collected = { 0 };
+    assertTrue(parcLogFormatBinary_Decode(contents, _collect, &collected), "Expected the log to decode");
+    assertTrue(collected.count == 1000, "Expected 1000 messages, actual %zu", collected.count);
+    _assertPayload(collected.entries[999], "message 999");
+
+    _collected_Release(&collected);
+    parcBuffer_Release(&contents);
+}
+
+LONGBOW_TEST_CASE(Global, parcLogFormatBinary_Register_Unsupported)
+{
+    _TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    const char *unsupported[] = {
+        "%n", "%*d", "%.*s", "%Lf", "%ls", "%lc", "%hp", "%q", "trailing %", "%hhf",
+        "%d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d",
+        NULL
+    };
+    for (int i = 0; unsupported[i] != NULL; i++) {
+        assertFalse(parcLogFormatBinary_Register(data->binary, i, unsupported[i]), "Expected '%s' to be refused", unsupported[i]);
+        assertFalse(parcLogFormatBinary_IsRegistered(data->binary, i), "Expected '%s' not to be registered", unsupported[i]);
+    }
+
+    assertTrue(parcLogFormatBinary_Register(data->binary, 100, "100%% of %'d %-+ #08.3x"), "Expected flags and %%%% to be accepted");
+}
+
+LONGBOW_TEST_CASE(Global, parcLogFormatBinary_Message_Unregistered)
+{
+    _TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    assertFalse(parcLogFormatBinary_Message(data->binary, PARCLogLevel_Info, 1, 2), "Expected an unregistered message to be refused");
+}
+
+LONGBOW_TEST_CASE(Global, parcLogFormatBinary_Message_TooLarge)
+{
+    _TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    parcLogFormatBinary_Register(data->binary, 1, "%s");
+
+    size_t length = _parcLogFormatBinary_BufferSize;
+    char *string = parcMemory_Allocate(length + 1);
+    memset(string, 'x', length);
+    string[length] = 0;
+
+    assertFalse(parcLogFormatBinary_Message(data->binary, PARCLogLevel_Info, 1, string),
+                "Expected a record larger than a thread buffer to be refused");
+    parcMemory_Deallocate(&string);
+}
+
+static bool
+_messageVaList(PARCLogFormatBinary *binary, uint64_t messageId, const char *format, ...)
+{
+    va_list ap;
+    va_start(ap, format);
+    bool result = parcLogFormatBinary_MessageVaList(binary, PARCLogLevel_Info, messageId, format, ap);
+    va_end(ap);
+    return result;
+}
+
+LONGBOW_TEST_CASE(Global, parcLogFormatBinary_MessageVaList_Format)
+{
+    _TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    const char *format = "value %d";
+    parcLogFormatBinary_Register(data->binary, 1, format);
+
+    char copy[16];
+    strcpy(copy, format);
+
+    assertTrue(_messageVaList(data->binary, 1, format, 1), "Expected the registered format to be accepted");
+    assertTrue(_messageVaList(data->binary, 1, copy, 2), "Expected an identical format to be accepted");
+    assertTrue(_messageVaList(data->binary, 1, NULL, 3), "Expected no format to mean the registered one");
+    assertFalse(_messageVaList(data->binary, 1, "other %d", 4), "Expected a different format to be refused");
+
+    // A format registered from a buffer that is later reused is checked by its content, not its address.
+    parcLogFormatBinary_Register(data->binary, 2, copy);
+    strcpy(copy, "other %s");
+    assertFalse(_messageVaList(data->binary, 2, copy, "x"), "Expected a reused format buffer to be refused");
+}
+
+LONGBOW_TEST_CASE(Global, parcLogFormatBinary_Decode)
+{
+    _TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    struct {
+        uint64_t id;
+        const char *format;
+    } formats[] = {
+        { 1, "%d %i %5d %-5d| %+d %hhd %hd %ld %lld %zd %jd %td"   },
+        { 2, "%u %o %x %X %#x %08x %hhx %hx %lu %llu %zu %ju"      },
+        { 3, "%f %.2f %e %g %10.3f %lf %a"                         },
+        { 4, "%c%c%c"                                              },
+        { 5, "%s|%10s|%-10s|%.3s|%s"                               },
+        { 6, "%p"                                                  },
+        { 7, "100%% done, %d%%"                                    },
+        { 8, "no conversions"                                      },
+    };
+    for (size_t i = 0; i < sizeof(formats) / sizeof(formats[0]); i++) {
+        assertTrue(parcLogFormatBinary_Register(data->binary, formats[i].id, formats[i].format),
+                   "Expected '%s' to be registered", formats[i].format);
+    }
+
+    char expected[8][256];
+    void *pointer = &expected;
+
+    parcLogFormatBinary_Message(data->binary, PARCLogLevel_Debug, 1,
+                                -1, 2, 3, 4, 5, (signed char) -6, (short) -7, -8L, -9LL, (ssize_t) -10, (intmax_t) -11, (ptrdiff_t) -12);
+    snprintf(expected[0], 256, formats[0].format,
+             -1, 2, 3, 4, 5, (signed char) -6, (short) -7, -8L, -9LL, (ssize_t) -10, (intmax_t) -11, (ptrdiff_t) -12);
+
+    parcLogFormatBinary_Message(data->binary, PARCLogLevel_Info, 2,
+                                4000000000U, 8U, 255U, 255U, 255U, 255U, (unsigned char) 200, (unsigned short) 60000,
+                                123UL, 18446744073709551615ULL, (size_t) 42, (uintmax_t) 43);
+    snprintf(expected[1], 256, formats[1].format,
+             4000000000U, 8U, 255U, 255U, 255U, 255U, (unsigned char) 200, (unsigned short) 60000,
+             123UL, 18446744073709551615ULL, (size_t) 42, (uintmax_t) 43);
+
+    parcLogFormatBinary_Message(data->binary, PARCLogLevel_Notice, 3, 3.14159, 2.71828, 1e10, 0.0001, -1.5, 6.02e23, 1.0);
+    snprintf(expected[2], 256, formats[2].format, 3.14159, 2.71828, 1e10, 0.0001, -1.5, 6.02e23, 1.0);
+
+    parcLogFormatBinary_Message(data->binary, PARCLogLevel_Warning, 4, 'a', 'b', 'c');
+    snprintf(expected[3], 256, formats[3].format, 'a', 'b', 'c');
+
+    parcLogFormatBinary_Message(data->binary, PARCLogLevel_Error, 5, "one", "two", "three", "four", (char *) NULL);
+    snprintf(expected[4], 256, "%s|%10s|%-10s|%.3s|%s", "one", "two", "three", "four", "(null)");
+
+    parcLogFormatBinary_Message(data->binary, PARCLogLevel_Critical, 6, pointer);
+    snprintf(expected[5], 256, formats[5].format, pointer);
+
+    parcLogFormatBinary_Message(data->binary, PARCLogLevel_Alert, 7, 99);
+    snprintf(expected[6], 256, formats[6].format, 99);
+
+    parcLogFormatBinary_Message(data->binary, PARCLogLevel_Emergency, 8);
+    snprintf(expected[7], 256, "%s", formats[7].format);
+
+    struct timeval before;
+    gettimeofday(&before, NULL);
+
+    PARCBuffer *contents = _finish(data);
+    _Collected collected = { 0 };
+    assertTrue(parcLogFormatBinary_Decode(contents, _collect, &collected), "Expected the log to decode");
+    assertTrue(collected.count == 8, "Expected 8 messages, actual %zu", collected.count);
+
+    PARCLogLevel levels[] = {
+        PARCLogLevel_Debug, PARCLogLevel_Info, PARCLogLevel_Notice, PARCLogLevel_Warning,
+        PARCLogLevel_Error, PARCLogLevel_Critical, PARCLogLevel_Alert, PARCLogLevel_Emergency
+    };
+    for (size_t i = 0; i < collected.count; i++) {
+        PARCLogEntry *entry = collected.entries[i];
+        _assertPayload(entry, expected[i]);
+        assertTrue(parcLogEntry_GetMessageId(entry) == formats[i].id, "Wrong message identifier for message %zu", i);
+        assertTrue(parcLogEntry_GetLevel(entry) == levels[i], "Wrong level for message %zu", i);
+        assertTrue(strcmp(parcLogEntry_GetHostName(entry), "hostname") == 0, "Wrong host name");
+        assertTrue(strcmp(parcLogEntry_GetApplicationName(entry), "applicationname") == 0, "Wrong application name");
+        assertTrue(strcmp(parcLogEntry_GetProcessName(entry), "processid") == 0, "Wrong process name");
+
+        const struct timeval *timeStamp = parcLogEntry_GetTimeStamp(entry);
+        assertTrue(timeStamp->tv_sec <= before.tv_sec && timeStamp->tv_sec >= before.tv_sec - 60,
+                   "Expected a recent timestamp, got %ld", (long) timeStamp->tv_sec);
+    }
+
+    _collected_Release(&collected);
+    parcBuffer_Release(&contents);
+}
+
+LONGBOW_TEST_CASE(Global, parcLogFormatBinary_Decode_Header)
+{
+    _TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    parcLogFormatBinary_Release(&data->binary);
+    ftruncate(data->fd, 0);
+    lseek(data->fd, 0, SEEK_SET);
+
+    data->binary = parcLogFormatBinary_Create(dup(data->fd), NULL, NULL, NULL);
+    parcLogFormatBinary_Register(data->binary, 1, "x");
+    parcLogFormatBinary_Message(data->binary, PARCLogLevel_Info, 1);
+
+    PARCBuffer *contents = _finish(data);
+    _Collected collected = { 0 };
+    assertTrue(parcLogFormatBinary_Decode(contents, _collect, &collected), "Expected the log to decode");
+    assertTrue(collected.count == 1, "Expected 1 message, actual %zu", collected.count);
+    assertTrue(strcmp(parcLogEntry_GetHostName(collected.entries[0]), "-") == 0, "Expected the nil value for the host name");
+    assertTrue(strcmp(parcLogEntry_GetProcessName(collected.entries[0]), "-") == 0, "Expected the nil value for the process");
+
+    _collected_Release(&collected);
+    parcBuffer_Release(&contents);
+}
+
+LONGBOW_TEST_CASE(Global, parcLogFormatBinary_Decode_Malformed)
+{
+    _TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    parcLogFormatBinary_Register(data->binary, 1, "value %d");
+    parcLogFormatBinary_Message(data->binary, PARCLogLevel_Info, 1, 1);
+    parcLogFormatBinary_Message(data->binary, PARCLogLevel_Info, 1, 2);
+    PARCBuffer *contents = _finish(data);
+    size_t length = parcBuffer_Remaining(contents);
+
+    // Truncated in the middle of the last record: everything before it is still delivered.
+    _Collected collected = { 0 };
+    parcBuffer_SetLimit(contents, length - 3);
+    assertFalse(parcLogFormatBinary_Decode(contents, _collect, &collected), "Expected a truncated log to be refused");
+    assertTrue(collected.count == 1, "Expected the complete record to be delivered, actual %zu", collected.count);
+    _collected_Release(&collected);
+
+    // Not a binary log at all.
+    parcBuffer_SetLimit(contents, length);
+    parcBuffer_PutUint8(parcBuffer_Rewind(contents), 'X');
+    parcBuffer_Rewind(contents);
+    collected = (_Collected) { 0 };
+    assertFalse(parcLogFormatBinary_Decode(contents, _collect, &collected), "Expected a bad magic number to be refused");
+    assertTrue(collected.count == 0, "Expected nothing to be delivered");
+
+    parcBuffer_Release(&contents);
+}
+
+LONGBOW_TEST_CASE(Global, parcLogFormatBinary_Decode_Stop)
+{
+    _TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    parcLogFormatBinary_Register(data->binary, 1, "value %d");
+    for (int i = 0; i < 10; i++) {
+        parcLogFormatBinary_Message(data->binary, PARCLogLevel_Info, 1, i);
+    }
+    PARCBuffer *contents = _finish(data);
+
+    _Collected collected = { .stopAfter = 3 };
+    assertTrue(parcLogFormatBinary_Decode(contents, _collect, &collected), "Expected stopping early to succeed");
+    assertTrue(collected.count == 3, "Expected 3 messages, actual %zu", collected.count);
+
+    _collected_Release(&collected);
+    parcBuffer_Release(&contents);
+}
+
+LONGBOW_TEST_CASE(Global, parcLogFormatBinary_Decode_FormatText)
+{
+    _TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    parcLogFormatBinary_Register(data->binary, 42, "Received %zu bytes from %s");
+    parcLogFormatBinary_Message(data->binary, PARCLogLevel_Info, 42, (size_t) 1500, "peer");
+    PARCBuffer *contents = _finish(data);
+
+    _Collected collected = { 0 };
+    parcLogFormatBinary_Decode(contents, _collect, &collected);
+
+    // The decoded entry renders exactly as an entry logged as text with the same fields.
+    PARCLogEntry *decoded = collected.entries[0];
+    PARCBuffer *payload = parcBuffer_AllocateCString("Received 1500 bytes from peer");
+    PARCLogEntry *logged = parcLogEntry_Create(PARCLogLevel_Info, "hostname", "applicationname", "processid", 42,
+                                               *parcLogEntry_GetTimeStamp(decoded), payload);
+    parcBuffer_Release(&payload);
+
+    PARCBuffer *expected = parcLogFormatText_FormatEntry(logged);
+    PARCBuffer *actual = parcLogFormatText_FormatEntry(decoded);
+    assertTrue(parcBuffer_Equals(expected, actual), "Expected the decoded entry to format like a text entry");
+
+    parcBuffer_Release(&actual);
+    parcBuffer_Release(&expected);
+    parcLogEntry_Release(&logged);
+    _collected_Release(&collected);
+    parcBuffer_Release(&contents);
+}
+
+LONGBOW_TEST_CASE(Global, parcLogFormatBinary_Flush)
+{
+    _TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    off_t headerLength = lseek(data->fd, 0, SEEK_END);
+    parcLogFormatBinary_Register(data->binary, 1, "value %d");
+    off_t definitionLength = lseek(data->fd, 0, SEEK_END);
+    assertTrue(definitionLength > headerLength, "Expected the definition to be written when it is registered");
+
+    parcLogFormatBinary_Message(data->binary, PARCLogLevel_Info, 1, 1);
+    assertTrue(lseek(data->fd, 0, SEEK_END) == definitionLength, "Expected the message to stay in the thread buffer");
+
+    parcLogFormatBinary_Flush(data->binary);
+    assertTrue(lseek(data->fd, 0, SEEK_END) > definitionLength, "Expected the message to be written by a flush");
+}
+
+typedef struct {
+    PARCLogFormatBinary *binary;
+    int thread;
+    int count;
+} _ProducerArgs;
+
+static void *
+_producer(void *context)
+{
+    _ProducerArgs *args = context;
+    for (int i = 0; i < args->count; i++) {
+        parcLogFormatBinary_Message(args->binary, PARCLogLevel_Info, 1, args->thread, i);
+    }
+    return NULL;
+}
+
+typedef struct {
+    size_t count;
+    int next[4];
+} _Sequences;
+
+static bool
+_checkSequence(void *context, const PARCLogEntry *entry)
+{
+    _Sequences *sequences = context;
+
+    char *text = parcBuffer_ToString(parcLogEntry_GetPayload(entry));
+    int thread, sequence;
+    sscanf(text, "%d %d", &thread, &sequence);
+    parcMemory_Deallocate(&text);
+
+    assertTrue(sequence == sequences->next[thread],
+               "Thread %d: expected message %d, actual %d", thread, sequences->next[thread], sequence);
+    sequences->next[thread]++;
+    sequences->count++;
+    return true;
+}
+
+LONGBOW_TEST_CASE(Global, parcLogFormatBinary_Threads)
+{
+    _TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    parcLogFormatBinary_Register(data->binary, 1, "%d %d");
+
+    // Enough records to fill and write each thread buffer several times.
+    const int count = 5000;
+    pthread_t threads[4];
+    _ProducerArgs args[4];
+    for (int t = 0; t < 4; t++) {
+        args[t] = (_ProducerArgs) { .binary = data->binary, .thread = t, .count = count };
+        pthread_create(&threads[t], NULL, _producer, &args[t]);
+    }
+    for (int t = 0; t < 4; t++) {
+        pthread_join(threads[t], NULL);
+    }
+
+    // The threads have exited, so their buffers have been written without a flush.
+    PARCBuffer *contents = _finish(data);
+    _Sequences sequences = { 0 };
+    assertTrue(parcLogFormatBinary_Decode(contents, _checkSequence, &sequences), "Expected the log to decode");
+    assertTrue(sequences.count == 4 * count, "Expected %d messages, actual %zu", 4 * count, sequences.count);
+
+    parcBuffer_Release(&contents);
+}
+
+LONGBOW_TEST_CASE(Global, parcLog_SetFormatBinary)
+{
+    _TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    PARCFileOutputStream *fileOutput = parcFileOutputStream_Create(open("/dev/null", O_WRONLY));
+    PARCOutputStream *output = parcFileOutputStream_AsOutputStream(fileOutput);
+    parcFileOutputStream_Release(&fileOutput);
+    PARCLogReporter *reporter = parcLogReporterFile_Create(output);
+    parcOutputStream_Release(&output);
+
+    PARCLog *log = parcLog_Create("localhost", "test_parc_LogFormatBinary", NULL, reporter);
+    parcLogReporter_Release(&reporter);
+    parcLog_SetLevel(log, PARCLogLevel_Info);
+
+    const char *format = "Received %zu bytes from %s";
+    parcLogFormatBinary_Register(data->binary, 42, format);
+    parcLog_SetFormatBinary(log, data->binary);
+    assertTrue(parcLog_GetFormatBinary(log) == data->binary, "Expected the binary format to be set");
+
+    assertTrue(parcLog_Message(log, PARCLogLevel_Info, 42, format, (size_t) 10, "a"), "Expected a binary message");
+    assertTrue(parcLog_Message(log, PARCLogLevel_Info, 43, "unregistered %d", 1), "Expected a text message");
+    assertTrue(parcLog_Message(log, PARCLogLevel_Info, 42, "a different format %d", 1), "Expected a text message");
+    assertFalse(parcLog_Message(log, PARCLogLevel_Debug, 42, format, (size_t) 11, "b"), "Expected Debug to be filtered");
+
+    parcLog_SetFormatBinary(log, NULL);
+    assertNull(parcLog_GetFormatBinary(log), "Expected the binary format to be cleared");
+    assertTrue(parcLog_Message(log, PARCLogLevel_Info, 42, format, (size_t) 12, "c"), "Expected a text message");
+    parcLog_Release(&log);
+
+    PARCBuffer *contents = _finish(data);
+    _Collected collected = { 0 };
+    assertTrue(parcLogFormatBinary_Decode(contents, _collect, &collected), "Expected the log to decode");
+    assertTrue(collected.count == 1, "Expected only the registered message in the binary log, actual %zu", collected.count);
+    _assertPayload(collected.entries[0], "Received 10 bytes from a");
+
+    _collected_Release(&collected);
+    parcBuffer_Release(&contents);
+}
+
+LONGBOW_TEST_FIXTURE(Static)
+{
+    LONGBOW_RUN_TEST_CASE(Static, _parcLogFormatBinary_ParseFormat);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Static)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Static)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Static, _parcLogFormatBinary_ParseFormat)
+{
+    _PARCLogFormatBinaryConversion conversions[_parcLogFormatBinary_MaxConversions];
+    size_t count;
+
+    const char *format = "a %-08.3lld b %% c %hhu %s";
+    assertTrue(_parcLogFormatBinary_ParseFormat(format, conversions, &count), "Expected the format to parse");
+    assertTrue(count == 3, "Expected 3 conversions, actual %zu", count);
+
+    assertTrue(conversions[0].start == 2 && conversions[0].end == 11, "Wrong bounds for the first conversion");
+    assertTrue(conversions[0].kind == _PARCLogFormatBinaryKind_Signed, "Expected a signed conversion");
+    assertTrue(conversions[0].length == _PARCLogFormatBinaryLength_ll, "Expected the ll modifier");
+    assertTrue(conversions[0].modifierStart == 8 && conversions[0].modifierSize == 2, "Wrong modifier bounds");
+
+    assertTrue(conversions[1].kind == _PARCLogFormatBinaryKind_Unsigned, "Expected an unsigned conversion");
+    assertTrue(conversions[1].length == _PARCLogFormatBinaryLength_hh, "Expected the hh modifier");
+
+    assertTrue(conversions[2].kind == _PARCLogFormatBinaryKind_String, "Expected a string conversion");
+    assertTrue(conversions[2].modifierSize == 0, "Expected no modifier");
+}
+
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, parcLogFormatBinary_Message_Throughput);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    parcMemory_SetInterface(&PARCStdlibMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+static double
+_nanosecondsSince(const struct timeval *start, int iterations)
+{
+    struct timeval end;
+    gettimeofday(&end, NULL);
+    return ((end.tv_sec - start->tv_sec) * 1e9 + (end.tv_usec - start->tv_usec) * 1e3) / iterations;
+}
+
+LONGBOW_TEST_CASE(Performance, parcLogFormatBinary_Message_Throughput)
+{
+    const int iterations = 1000000;
+    const char *format = "Received %zu bytes from %s on interface %d";
+
+    PARCFileOutputStream *fileOutput = parcFileOutputStream_Create(open("/dev/null", O_WRONLY));
+    PARCOutputStream *output = parcFileOutputStream_AsOutputStream(fileOutput);
+    parcFileOutputStream_Release(&fileOutput);
+    PARCLogReporter *reporter = parcLogReporterFile_Create(output);
+    parcOutputStream_Release(&output);
+
+    PARCLog *log = parcLog_Create("localhost", "test_parc_LogFormatBinary", NULL, reporter);
+    parcLogReporter_Release(&reporter);
+    parcLog_SetLevel(log, PARCLogLevel_Debug);
+
+    struct timeval start;
+    gettimeofday(&start, NULL);
+    for (int i = 0; i < iterations; i++) {
+        parcLog_Message(log, PARCLogLevel_Debug, 42, format, (size_t) i, "peer.example.com", 3);
+    }
+    printf("parcLog_Message, text to parcLogReporterFile: %.0f ns per message\n", _nanosecondsSince(&start, iterations));
+
+    PARCLogFormatBinary *binary = parcLogFormatBinary_Create(open("/dev/null", O_WRONLY), "localhost", "test", NULL);
+    parcLogFormatBinary_Register(binary, 42, format);
+    parcLog_SetFormatBinary(log, binary);
+
+    gettimeofday(&start, NULL);
+    for (int i = 0; i < iterations; i++) {
+        parcLog_Message(log, PARCLogLevel_Debug, 42, format, (size_t) i, "peer.example.com", 3);
+    }
+    printf("parcLog_Message, PARCLogFormatBinary: %.0f ns per message\n", _nanosecondsSince(&start, iterations));
+
+    gettimeofday(&start, NULL);
+    for (int i = 0; i < iterations; i++) {
+        parcLogFormatBinary_Message(binary, PARCLogLevel_Debug, 42, (size_t) i, "peer.example.com", 3);
+    }
+    printf("parcLogFormatBinary_Message: %.0f ns per message\n", _nanosecondsSince(&start, iterations));
+
+    parcLogFormatBinary_Release(&binary);
+    parcLog_Release(&log);
+}
+
+int
+main(int argc, char *argv[])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(parc_LogFormatBinary);
+    int exitStatus = LONGBOW_TEST_MAIN(argc, argv, testRunner);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
@@ -58,6 +58,7 @@
 #include "../parc_LogFormatSyslog.c"
 
 #include <parc/logging/parc_LogEntry.h>
+#include <parc/algol/parc_Memory.h>
 
 #include <LongBow/unit-test.h>
 
@@ -85,6 +86,7 @@ LONGBOW_TEST_RUNNER_TEARDOWN(parc_LogFormatSyslog)
 LONGBOW_TEST_FIXTURE(Global)
 {
     LONGBOW_RUN_TEST_CASE(Global, parcLogFormatSyslog_FormatEntry);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogFormatSyslog_FormatHeader);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Global)
@@ -112,6 +114,35 @@ LONGBOW_TEST_CASE(Global, parcLogFormatSyslog_FormatEntry)
     parcBuffer_Release(&actual);
 }
 
+LONGBOW_TEST_CASE(Global, parcLogFormatSyslog_FormatHeader)
+{
+    PARCBuffer *payload = parcBuffer_AllocateCString("hello");
+
+    struct timeval timeStamp;
+    gettimeofday(&timeStamp, NULL);
+    PARCLogEntry *entry =
+        parcLogEntry_Create(PARCLogLevel_Info, "hostname", "applicationname", "processid", 1234, timeStamp, payload);
+    parcBuffer_Release(&payload);
+
+    char header[512];
+    size_t length = parcLogFormatSyslog_FormatHeader(entry, header, sizeof(header));
+    assertTrue(length == strlen(header), "Expected the length of the header, actual %zu", length);
+
+    // The header, the payload and the trailer are exactly the formatted entry.
+    char expected[sizeof(header) + 16];
+    snprintf(expected, sizeof(expected), "%shello ]\n", header);
+    PARCBuffer *formatted = parcLogFormatSyslog_FormatEntry(entry);
+    char *actual = parcBuffer_ToString(formatted);
+    assertTrue(strcmp(actual, expected) == 0, "Expected '%s', actual '%s'", expected, actual);
+    parcMemory_Deallocate(&actual);
+    parcBuffer_Release(&formatted);
+
+    assertTrue(parcLogFormatSyslog_FormatHeader(entry, header, length) == 0, "Expected 0 when the header does not fit");
+    assertTrue(parcLogFormatSyslog_FormatHeader(entry, header, length + 1) == length, "Expected the header to just fit");
+
+    parcLogEntry_Release(&entry);
+}
+
 LONGBOW_TEST_FIXTURE(Static)
 {
 }
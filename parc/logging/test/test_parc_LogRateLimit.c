@@ -0,0 +1,395 @@
+/*
+ * Copyright (c) 2015, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+// Include the file(s) containing the functions to be tested.
+// This permits internal static functions to be visible to this Test Runner.
+#include "../parc_LogRateLimit.c"
+
+#include <fcntl.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <parc/logging/parc_Log.h>
+#include <parc/logging/parc_LogReporterFile.h>
+#include <parc/algol/parc_FileOutputStream.h>
+
+#include <parc/algol/parc_SafeMemory.h>
+#include <parc/algol/parc_StdlibMemory.h>
+
+#include <LongBow/unit-test.h>
+
+LONGBOW_TEST_RUNNER(parc_LogRateLimit)
+{
+    // The following Test Fixtures will run their corresponding Test Cases.
+    // Test Fixtures are run in the order specified here, but every test must be idempotent.
+    // Never rely on the execution order of tests or share state between them.
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
+}
+
+// The Test Runner calls this function once before any Test Fixtures are run.
+LONGBOW_TEST_RUNNER_SETUP(parc_LogRateLimit)
+{
+    parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// The Test Runner calls this function once after all the Test Fixtures are run.
+LONGBOW_TEST_RUNNER_TEARDOWN(parc_LogRateLimit)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, parcLogRateLimit_Initializer);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogRateLimit_Init);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogRateLimit_Admit_Unlimited);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogRateLimit_Admit_Burst);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogRateLimit_Admit_Refill);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogRateLimit_Admit_Sample);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogRateLimit_Admit_SampleAndRate);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogRateLimit_TakeSuppressed);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogRateLimit_Threads);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    uint32_t outstandingAllocations = parcSafeMemory_ReportAllocation(STDOUT_FILENO);
+    if (outstandingAllocations != 0) {
+        printf("%s leaks %d memory allocations\n", longBowTestCase_GetName(testCase), outstandingAllocations);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Global, parcLogRateLimit_Initializer)
+{
+    static PARCLogRateLimit limit = parcLogRateLimit_Initializer(10, 5, 3);
+    int line = __LINE__ - 1;
+
+    assertTrue(limit.interval == 100000000ULL, "Expected an interval of 100 ms, actual %" PRIu64, limit.interval);
+    assertTrue(limit.tolerance == 400000000ULL, "Expected a tolerance of 400 ms, actual %" PRIu64, limit.tolerance);
+    assertTrue(limit.sampleEvery == 3, "Expected to sample 1 in 3, actual %u", limit.sampleEvery);
+    assertTrue(strcmp(limit.file, __FILE__) == 0, "Expected the file of the call site, actual %s", limit.file);
+    assertTrue(limit.line == line, "Expected line %d, actual %d", line, limit.line);
+
+    static PARCLogRateLimit unlimited = parcLogRateLimit_Initializer(0, 0, 0);
+    assertTrue(unlimited.interval == 0 && unlimited.tolerance == 0, "Expected no rate limit");
+}
+
+LONGBOW_TEST_CASE(Global, parcLogRateLimit_Init)
+{
+    PARCLogRateLimit limit;
+    parcLogRateLimit_Init(&limit, 10, 5, 3);
+
+    static PARCLogRateLimit expected = parcLogRateLimit_Initializer(10, 5, 3);
+    assertTrue(limit.interval == expected.interval, "Expected the same interval as the initializer");
+    assertTrue(limit.tolerance == expected.tolerance, "Expected the same tolerance as the initializer");
+    assertTrue(limit.sampleEvery == expected.sampleEvery, "Expected the same sampling as the initializer");
+    assertNull(limit.file, "Expected no call site");
+    assertTrue(parcLogRateLimit_GetSuppressedCount(&limit) == 0, "Expected nothing suppressed");
+}
+
+LONGBOW_TEST_CASE(Global, parcLogRateLimit_Admit_Unlimited)
+{
+    PARCLogRateLimit limit;
+    parcLogRateLimit_Init(&limit, 0, 1, 0);
+
+    for (int i = 0; i < 1000; i++) {
+        uint64_t suppressed = 99;
+        assertTrue(parcLogRateLimit_Admit(&limit, &suppressed), "Expected every message to be admitted");
+        assertTrue(suppressed == 0, "Expected nothing suppressed, actual %" PRIu64, suppressed);
+    }
+    assertTrue(parcLogRateLimit_GetSuppressedCount(&limit) == 0, "Expected nothing suppressed");
+}
+
+LONGBOW_TEST_CASE(Global, parcLogRateLimit_Admit_Burst)
+{
+    PARCLogRateLimit limit;
+    parcLogRateLimit_Init(&limit, 1, 5, 0);
+
+    for (int i = 0; i < 5; i++) {
+        assertTrue(parcLogRateLimit_Admit(&limit, NULL), "Expected message %d of the burst to be admitted", i);
+    }
+    for (int i = 0; i < 10; i++) {
+        assertFalse(parcLogRateLimit_Admit(&limit, NULL), "Expected message %d after the burst to be suppressed", i);
+    }
+    assertTrue(parcLogRateLimit_GetSuppressedCount(&limit) == 10,
+               "Expected 10 suppressed, actual %" PRIu64, parcLogRateLimit_GetSuppressedCount(&limit));
+}
+
+LONGBOW_TEST_CASE(Global, parcLogRateLimit_Admit_Refill)
+{
+    PARCLogRateLimit limit;
+    parcLogRateLimit_Init(&limit, 20, 1, 0);
+
+    assertTrue(parcLogRateLimit_Admit(&limit, NULL), "Expected the first message to be admitted");
+    assertFalse(parcLogRateLimit_Admit(&limit, NULL), "Expected the bucket to be empty");
+    assertFalse(parcLogRateLimit_Admit(&limit, NULL), "Expected the bucket to be empty");
+
+    // Several intervals, allowing for the precision of the coarse clock.
+    usleep(200000);
+
+    uint64_t suppressed;
+    assertTrue(parcLogRateLimit_Admit(&limit, &suppressed), "Expected the bucket to have refilled");
+    assertTrue(suppressed == 2, "Expected 2 suppressed, actual %" PRIu64, suppressed);
+
+    // The bucket holds a single token, however long it was idle.
+    assertFalse(parcLogRateLimit_Admit(&limit, NULL), "Expected the bucket to be empty");
+}
+
+LONGBOW_TEST_CASE(Global, parcLogRateLimit_Admit_Sample)
+{
+    PARCLogRateLimit limit;
+    parcLogRateLimit_Init(&limit, 0, 1, 4);
+
+    size_t admitted = 0;
+    for (int i = 0; i < 100; i++) {
+        uint64_t suppressed;
+        bool admit = parcLogRateLimit_Admit(&limit, &suppressed);
+        assertTrue(admit == (i % 4 == 0), "Expected message %d to be %s", i, (i % 4 == 0) ? "admitted" : "suppressed");
+        if (admit) {
+            uint64_t expected = (i == 0) ? 0 : 3;
+            assertTrue(suppressed == expected, "Expected %" PRIu64 " suppressed, actual %" PRIu64, expected, suppressed);
+            admitted++;
+        }
+    }
+    assertTrue(admitted == 25, "Expected 25 admitted, actual %zu", admitted);
+    assertTrue(parcLogRateLimit_GetSuppressedCount(&limit) == 75,
+               "Expected 75 suppressed, actual %" PRIu64, parcLogRateLimit_GetSuppressedCount(&limit));
+}
+
+LONGBOW_TEST_CASE(Global, parcLogRateLimit_Admit_SampleAndRate)
+{
+    PARCLogRateLimit limit;
+    parcLogRateLimit_Init(&limit, 1, 2, 10);
+
+    size_t admitted = 0;
+    for (int i = 0; i < 100; i++) {
+        if (parcLogRateLimit_Admit(&limit, NULL)) {
+            admitted++;
+        }
+    }
+    // Ten messages pass the sampler, and the bucket admits the first two of them.
+    assertTrue(admitted == 2, "Expected 2 admitted, actual %zu", admitted);
+    assertTrue(parcLogRateLimit_GetSuppressedCount(&limit) == 98,
+               "Expected 98 suppressed, actual %" PRIu64, parcLogRateLimit_GetSuppressedCount(&limit));
+}
+
+LONGBOW_TEST_CASE(Global, parcLogRateLimit_TakeSuppressed)
+{
+    PARCLogRateLimit limit;
+    parcLogRateLimit_Init(&limit, 1, 1, 0);
+
+    assertTrue(parcLogRateLimit_TakeSuppressed(&limit) == 0, "Expected nothing suppressed");
+
+    parcLogRateLimit_Admit(&limit, NULL);
+    for (int i = 0; i < 7; i++) {
+        parcLogRateLimit_Admit(&limit, NULL);
+    }
+    assertTrue(parcLogRateLimit_TakeSuppressed(&limit) == 7, "Expected 7 suppressed");
+    assertTrue(parcLogRateLimit_TakeSuppressed(&limit) == 0, "Expected the count to have been reset");
+    assertTrue(parcLogRateLimit_GetSuppressedCount(&limit) == 7, "Expected the total to include the taken count");
+}
+
+typedef struct {
+    PARCLogRateLimit *limit;
+    int count;
+    size_t admitted;
+    uint64_t reported;
+} _OfferArgs;
+
+static void *
+_offer(void *context)
+{
+    _OfferArgs *args = context;
+    for (int i = 0; i < args->count; i++) {
+        uint64_t suppressed;
+        if (parcLogRateLimit_Admit(args->limit, &suppressed)) {
+            args->admitted++;
+            args->reported += suppressed;
+        }
+    }
+    return NULL;
+}
+
+LONGBOW_TEST_CASE(Global, parcLogRateLimit_Threads)
+{
+    const int count = 100000;
+    PARCLogRateLimit limit;
+    parcLogRateLimit_Init(&limit, 1, 100, 3);
+
+    struct timeval start;
+    gettimeofday(&start, NULL);
+
+    pthread_t threads[4];
+    _OfferArgs args[4];
+    for (int t = 0; t < 4; t++) {
+        args[t] = (_OfferArgs) { .limit = &limit, .count = count };
+        pthread_create(&threads[t], NULL, _offer, &args[t]);
+    }
+    size_t admitted = 0;
+    uint64_t reported = 0;
+    for (int t = 0; t < 4; t++) {
+        pthread_join(threads[t], NULL);
+        admitted += args[t].admitted;
+        reported += args[t].reported;
+    }
+
+    struct timeval end;
+    gettimeofday(&end, NULL);
+    size_t refills = (size_t) (end.tv_sec - start.tv_sec) + 1;
+
+    // Every message is either admitted or counted exactly once, and the bucket admits the burst plus its refills.
+    uint64_t suppressed = parcLogRateLimit_GetSuppressedCount(&limit);
+    assertTrue(admitted + suppressed == 4 * (uint64_t) count,
+               "Expected %d messages, admitted %zu suppressed %" PRIu64, 4 * count, admitted, suppressed);
+    assertTrue(admitted >= 100 && admitted <= 100 + refills, "Expected about 100 admitted, actual %zu", admitted);
+    assertTrue(reported + parcLogRateLimit_TakeSuppressed(&limit) == suppressed,
+               "Expected every suppressed message to be reported once");
+}
+
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, parcLogRateLimit_Admit_Throughput);
+    LONGBOW_RUN_TEST_CASE(Performance, parcLog_WarningRateLimited_Throughput);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    parcMemory_SetInterface(&PARCStdlibMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+static double
+_nanosecondsSince(const struct timeval *start, int iterations)
+{
+    struct timeval end;
+    gettimeofday(&end, NULL);
+    return ((end.tv_sec - start->tv_sec) * 1e9 + (end.tv_usec - start->tv_usec) * 1e3) / iterations;
+}
+
+LONGBOW_TEST_CASE(Performance, parcLogRateLimit_Admit_Throughput)
+{
+    const int iterations = 10000000;
+    PARCLogRateLimit limit;
+
+    parcLogRateLimit_Init(&limit, 10, 5, 0);
+    struct timeval start;
+    gettimeofday(&start, NULL);
+    for (int i = 0; i < iterations; i++) {
+        parcLogRateLimit_Admit(&limit, NULL);
+    }
+    printf("parcLogRateLimit_Admit, rate limit: %.1f ns per message\n", _nanosecondsSince(&start, iterations));
+
+    parcLogRateLimit_Init(&limit, 0, 1, 1000);
+    gettimeofday(&start, NULL);
+    for (int i = 0; i < iterations; i++) {
+        parcLogRateLimit_Admit(&limit, NULL);
+    }
+    printf("parcLogRateLimit_Admit, 1 in 1000: %.1f ns per message\n", _nanosecondsSince(&start, iterations));
+}
+
+LONGBOW_TEST_CASE(Performance, parcLog_WarningRateLimited_Throughput)
+{
+    const int iterations = 1000000;
+
+    PARCFileOutputStream *fileOutput = parcFileOutputStream_Create(open("/dev/null", O_WRONLY));
+    PARCOutputStream *output = parcFileOutputStream_AsOutputStream(fileOutput);
+    parcFileOutputStream_Release(&fileOutput);
+    PARCLogReporter *reporter = parcLogReporterFile_Create(output);
+    parcOutputStream_Release(&output);
+
+    PARCLog *log = parcLog_Create("localhost", "test_parc_LogRateLimit", NULL, reporter);
+    parcLogReporter_Release(&reporter);
+    parcLog_SetLevel(log, PARCLogLevel_Warning);
+
+    struct timeval start;
+    gettimeofday(&start, NULL);
+    for (int i = 0; i < iterations; i++) {
+        parcLog_Warning(log, "Bad packet %d from %s", i, "peer.example.com");
+    }
+    printf("parcLog_Warning: %.0f ns per message\n", _nanosecondsSince(&start, iterations));
+
+    gettimeofday(&start, NULL);
+    for (int i = 0; i < iterations; i++) {
+        parcLog_WarningRateLimited(log, 10, 5, "Bad packet %d from %s", i, "peer.example.com");
+    }
+    printf("parcLog_WarningRateLimited: %.1f ns per message\n", _nanosecondsSince(&start, iterations));
+
+    parcLog_Release(&log);
+}
+
+int
+main(int argc, char *argv[])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(parc_LogRateLimit);
+    int exitStatus = LONGBOW_TEST_MAIN(argc, argv, testRunner);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
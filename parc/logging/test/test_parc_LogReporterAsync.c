@@ -0,0 +1,549 @@
+/*
+ * Copyright (c) 2015, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+// Include the file(s) containing the functions to be tested.
+// This permits internal static functions to be visible to this Test Runner.
+#include "../parc_LogReporterAsync.c"
+
+#include <fcntl.h>
+#include <stdio.h>
+
+#include <parc/logging/parc_LogReporterFile.h>
+#include <parc/algol/parc_FileOutputStream.h>
+#include <parc/testing/parc_ObjectTesting.h>
+
+#include <parc/algol/parc_SafeMemory.h>
+#include <parc/algol/parc_StdlibMemory.h>
+
+#include <LongBow/unit-test.h>
+
+LONGBOW_TEST_RUNNER(parc_LogReporterAsync)
+{
+    // The following Test Fixtures will run their corresponding Test Cases.
+    // Test Fixtures are run in the order specified here, but every test must be idempotent.
+    // Never rely on the execution order of tests or share state between them.
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+    LONGBOW_RUN_TEST_FIXTURE(Static);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
+}
+
+// The Test Runner calls this function once before any Test Fixtures are run.
+LONGBOW_TEST_RUNNER_SETUP(parc_LogReporterAsync)
+{
+    parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// The Test Runner calls this function once after all the Test Fixtures are run.
+LONGBOW_TEST_RUNNER_TEARDOWN(parc_LogReporterAsync)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, parcLogReporterAsync_AcquireRelease);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogReporterAsync_Create);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogReporterAsync_Report);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogReporterAsync_Report_LongHeader);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogReporterAsync_Report_Threads);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogReporterAsync_Overflow_Block);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogReporterAsync_Overflow_DropOldest);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogReporterAsync_Overflow_DropNewest);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogReporterAsync_Release_Drains);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    uint32_t outstandingAllocations = parcSafeMemory_ReportAllocation(STDOUT_FILENO);
+    if (outstandingAllocations != 0) {
+        printf("%s leaks %d memory allocations\n", longBowTestCase_GetName(testCase), outstandingAllocations);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+static PARCLogEntry *
+_createEntry(uint64_t messageId)
+{
+    struct timeval timeStamp = { .tv_sec = 1456000000, .tv_usec = (suseconds_t) (messageId % 1000000) };
+    PARCBuffer *payload = parcBuffer_AllocateCString("hello");
+    PARCLogEntry *result =
+        parcLogEntry_Create(PARCLogLevel_Info, "hostname", "applicationname", "processid", messageId, timeStamp, payload);
+    parcBuffer_Release(&payload);
+    return result;
+}
+
+static void
+_report(PARCLogReporter *reporter, uint64_t messageId)
+{
+    PARCLogEntry *entry = _createEntry(messageId);
+    parcLogReporter_Report(reporter, entry);
+    parcLogEntry_Release(&entry);
+}
+
+/*
+ * Reads everything written to a pipe, on its own thread, until the write end is closed.
+ */
+typedef struct {
+    int fd;
+    pthread_t thread;
+    char *data;
+    size_t length;
+    size_t capacity;
+} _PipeReader;
+
+static void *
+_pipeReader_Run(void *context)
+{
+    _PipeReader *reader = context;
+    while (true) {
+        if (reader->capacity - reader->length < 4096) {
+            reader->capacity *= 2;
+            reader->data = realloc(reader->data, reader->capacity);
+        }
+        ssize_t nread = read(reader->fd, reader->data + reader->length, reader->capacity - reader->length - 1);
+        if (nread <= 0) {
+            break;
+        }
+        reader->length += nread;
+    }
+    reader->data[reader->length] = 0;
+    return NULL;
+}
+
+static void
+_pipeReader_Start(_PipeReader *reader, int fd)
+{
+    reader->fd = fd;
+    reader->length = 0;
+    reader->capacity = 65536;
+    reader->data = malloc(reader->capacity);
+    pthread_create(&reader->thread, NULL, _pipeReader_Run, reader);
+}
+
+static size_t
+_pipeReader_Finish(_PipeReader *reader)
+{
+    pthread_join(reader->thread, NULL);
+    close(reader->fd);
+
+    size_t lines = 0;
+    for (size_t i = 0; i < reader->length; i++) {
+        if (reader->data[i] == '\n') {
+            lines++;
+        }
+    }
+    return lines;
+}
+
+static void
+_pipeReader_Destroy(_PipeReader *reader)
+{
+    free(reader->data);
+}
+
+static char *
+_expectedLine(uint64_t messageId)
+{
+    PARCLogEntry *entry = _createEntry(messageId);
+    PARCBuffer *formatted = parcLogFormatSyslog_FormatEntry(entry);
+    char *result = parcBuffer_ToString(formatted);
+    parcBuffer_Release(&formatted);
+    parcLogEntry_Release(&entry);
+    return result;
+}
+
+LONGBOW_TEST_CASE(Global, parcLogReporterAsync_Create)
+{
+    PARCLogReporter *reporter = parcLogReporterAsync_Create(dup(STDOUT_FILENO), 16, PARCLogReporterAsyncOverflow_Block);
+    assertNotNull(reporter, "Expected non-null result from parcLogReporterAsync_Create");
+
+    assertTrue(parcLogReporterAsync_GetWrittenCount(reporter) == 0, "Expected nothing written");
+    assertTrue(parcLogReporterAsync_GetDroppedCount(reporter) == 0, "Expected nothing dropped");
+    assertTrue(parcLogReporterAsync_GetBlockedCount(reporter) == 0, "Expected nothing blocked");
+
+    parcLogReporterAsync_Release(&reporter);
+    assertNull(reporter, "Expected parcLogReporterAsync_Release to null the pointer");
+}
+
+LONGBOW_TEST_CASE(Global, parcLogReporterAsync_AcquireRelease)
+{
+    PARCLogReporter *reporter = parcLogReporterAsync_Create(dup(STDOUT_FILENO), 16, PARCLogReporterAsyncOverflow_Block);
+
+    parcObjectTesting_AssertAcquireReleaseContract(parcLogReporterAsync_Acquire, reporter);
+
+    parcLogReporterAsync_Release(&reporter);
+}
+
+LONGBOW_TEST_CASE(Global, parcLogReporterAsync_Report)
+{
+    int fds[2];
+    pipe(fds);
+    _PipeReader reader;
+    _pipeReader_Start(&reader, fds[0]);
+
+    PARCLogReporter *reporter = parcLogReporterAsync_Create(fds[1], 16, PARCLogReporterAsyncOverflow_Block);
+    for (uint64_t i = 0; i < 100; i++) {
+        _report(reporter, i);
+    }
+    parcLogReporterAsync_Flush(reporter);
+    assertTrue(parcLogReporterAsync_GetWrittenCount(reporter) == 100,
+               "Expected 100 written after a flush, actual %" PRIu64, parcLogReporterAsync_GetWrittenCount(reporter));
+    parcLogReporter_Release(&reporter);
+
+    size_t lines = _pipeReader_Finish(&reader);
+    assertTrue(lines == 100, "Expected 100 lines, actual %zu", lines);
+
+    char *cursor = reader.data;
+    for (uint64_t i = 0; i < 100; i++) {
+        char *expected = _expectedLine(i);
+        assertTrue(strncmp(cursor, expected, strlen(expected)) == 0, "Line %" PRIu64 " is wrong or out of order", i);
+        cursor += strlen(expected);
+        parcMemory_Deallocate(&expected);
+    }
+
+    _pipeReader_Destroy(&reader);
+}
+
+LONGBOW_TEST_CASE(Global, parcLogReporterAsync_Report_LongHeader)
+{
+    char hostName[1024];
+    memset(hostName, 'h', sizeof(hostName) - 1);
+    hostName[sizeof(hostName) - 1] = 0;
+
+    struct timeval timeStamp = { .tv_sec = 1456000000, .tv_usec = 0 };
+    PARCBuffer *payload = parcBuffer_AllocateCString("hello");
+    PARCLogEntry *entry =
+        parcLogEntry_Create(PARCLogLevel_Info, hostName, "applicationname", "processid", 1, timeStamp, payload);
+    parcBuffer_Release(&payload);
+
+    PARCBuffer *formatted = parcLogFormatSyslog_FormatEntry(entry);
+    char *expected = parcBuffer_ToString(formatted);
+    parcBuffer_Release(&formatted);
+
+    int fds[2];
+    pipe(fds);
+    _PipeReader reader;
+    _pipeReader_Start(&reader, fds[0]);
+
+    PARCLogReporter *reporter = parcLogReporterAsync_Create(fds[1], 16, PARCLogReporterAsyncOverflow_Block);
+    parcLogReporter_Report(reporter, entry);
+    _report(reporter, 2);
+    parcLogReporter_Release(&reporter);
+    parcLogEntry_Release(&entry);
+
+    _pipeReader_Finish(&reader);
+    assertTrue(strncmp(reader.data, expected, strlen(expected)) == 0,
+               "Expected a header too long for a header slot to be formatted in full");
+
+    char *second = _expectedLine(2);
+    assertTrue(strcmp(reader.data + strlen(expected), second) == 0, "Expected the next entry to follow");
+    parcMemory_Deallocate(&second);
+    parcMemory_Deallocate(&expected);
+    _pipeReader_Destroy(&reader);
+}
+
+typedef struct {
+    PARCLogReporter *reporter;
+    uint64_t first;
+    uint64_t count;
+} _ProducerArgs;
+
+static void *
+_producer(void *context)
+{
+    _ProducerArgs *args = context;
+    for (uint64_t i = 0; i < args->count; i++) {
+        _report(args->reporter, args->first + i);
+    }
+    return NULL;
+}
+
+LONGBOW_TEST_CASE(Global, parcLogReporterAsync_Report_Threads)
+{
+    int fds[2];
+    pipe(fds);
+    _PipeReader reader;
+    _pipeReader_Start(&reader, fds[0]);
+
+    PARCLogReporter *reporter = parcLogReporterAsync_Create(fds[1], 8, PARCLogReporterAsyncOverflow_Block);
+
+    pthread_t threads[4];
+    _ProducerArgs args[4];
+    for (int i = 0; i < 4; i++) {
+        args[i] = (_ProducerArgs) { .reporter = reporter, .first = i * 1000, .count = 1000 };
+        pthread_create(&threads[i], NULL, _producer, &args[i]);
+    }
+    for (int i = 0; i < 4; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    parcLogReporterAsync_Flush(reporter);
+    assertTrue(parcLogReporterAsync_GetWrittenCount(reporter) == 4000,
+               "Expected 4000 written, actual %" PRIu64, parcLogReporterAsync_GetWrittenCount(reporter));
+    assertTrue(parcLogReporterAsync_GetDroppedCount(reporter) == 0, "The Block policy must not drop entries");
+    parcLogReporter_Release(&reporter);
+
+    size_t lines = _pipeReader_Finish(&reader);
+    assertTrue(lines == 4000, "Expected 4000 lines, actual %zu", lines);
+    _pipeReader_Destroy(&reader);
+}
+
+/*
+ * Report far more entries than a pipe and a small ring can hold while nothing reads the pipe,
+ * so the writer thread stalls in writev and the overflow policy must act.
+ */
+static void
+_assertOverflow(PARCLogReporterAsyncOverflow overflow, size_t *linesPtr, uint64_t *droppedPtr, char **lastLinePtr)
+{
+    const uint64_t total = 20000;
+
+    int fds[2];
+    pipe(fds);
+
+    PARCLogReporter *reporter = parcLogReporterAsync_Create(fds[1], 4, overflow);
+
+    _PipeReader reader;
+    if (overflow == PARCLogReporterAsyncOverflow_Block) {
+        _pipeReader_Start(&reader, fds[0]);
+    }
+    for (uint64_t i = 0; i < total; i++) {
+        _report(reporter, i);
+    }
+    if (overflow != PARCLogReporterAsyncOverflow_Block) {
+        _pipeReader_Start(&reader, fds[0]);
+    }
+
+    parcLogReporterAsync_Flush(reporter);
+    uint64_t written = parcLogReporterAsync_GetWrittenCount(reporter);
+    *droppedPtr = parcLogReporterAsync_GetDroppedCount(reporter);
+    assertTrue(written + *droppedPtr == total,
+               "Expected written %" PRIu64 " + dropped %" PRIu64 " == %" PRIu64, written, *droppedPtr, total);
+    parcLogReporter_Release(&reporter);
+
+    *linesPtr = _pipeReader_Finish(&reader);
+    assertTrue(*linesPtr == written, "Expected %" PRIu64 " lines, actual %zu", written, *linesPtr);
+
+    char *lastLine = reader.data + reader.length - 1;
+    while (lastLine > reader.data && lastLine[-1] != '\n') {
+        lastLine--;
+    }
+    *lastLinePtr = strdup(lastLine);
+    _pipeReader_Destroy(&reader);
+}
+
+LONGBOW_TEST_CASE(Global, parcLogReporterAsync_Overflow_Block)
+{
+    size_t lines;
+    uint64_t dropped;
+    char *lastLine;
+    _assertOverflow(PARCLogReporterAsyncOverflow_Block, &lines, &dropped, &lastLine);
+
+    assertTrue(dropped == 0, "The Block policy must not drop entries, dropped %" PRIu64, dropped);
+    assertTrue(lines == 20000, "Expected every entry to be written, actual %zu", lines);
+    free(lastLine);
+}
+
+LONGBOW_TEST_CASE(Global, parcLogReporterAsync_Overflow_DropOldest)
+{
+    size_t lines;
+    uint64_t dropped;
+    char *lastLine;
+    _assertOverflow(PARCLogReporterAsyncOverflow_DropOldest, &lines, &dropped, &lastLine);
+
+    assertTrue(dropped > 0, "Expected entries to be dropped");
+
+    char *expected = _expectedLine(19999);
+    assertTrue(strcmp(lastLine, expected) == 0, "Expected the newest entry to survive, last line: %s", lastLine);
+    parcMemory_Deallocate(&expected);
+    free(lastLine);
+}
+
+LONGBOW_TEST_CASE(Global, parcLogReporterAsync_Overflow_DropNewest)
+{
+    size_t lines;
+    uint64_t dropped;
+    char *lastLine;
+    _assertOverflow(PARCLogReporterAsyncOverflow_DropNewest, &lines, &dropped, &lastLine);
+
+    assertTrue(dropped > 0, "Expected entries to be dropped");
+
+    char *expected = _expectedLine(19999);
+    assertTrue(strcmp(lastLine, expected) != 0, "Expected the newest entry to be dropped");
+    parcMemory_Deallocate(&expected);
+    free(lastLine);
+}
+
+LONGBOW_TEST_CASE(Global, parcLogReporterAsync_Release_Drains)
+{
+    int fds[2];
+    pipe(fds);
+    _PipeReader reader;
+    _pipeReader_Start(&reader, fds[0]);
+
+    PARCLogReporter *reporter = parcLogReporterAsync_Create(fds[1], 1024, PARCLogReporterAsyncOverflow_Block);
+    for (uint64_t i = 0; i < 1000; i++) {
+        _report(reporter, i);
+    }
+    parcLogReporter_Release(&reporter);
+
+    size_t lines = _pipeReader_Finish(&reader);
+    assertTrue(lines == 1000, "Expected release to write all 1000 entries, actual %zu", lines);
+    _pipeReader_Destroy(&reader);
+}
+
+LONGBOW_TEST_FIXTURE(Static)
+{
+    LONGBOW_RUN_TEST_CASE(Static, _parcLogReporterAsync_RingElements);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Static)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Static)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Static, _parcLogReporterAsync_RingElements)
+{
+    assertTrue(_parcLogReporterAsync_RingElements(0) == 2, "Expected 2");
+    assertTrue(_parcLogReporterAsync_RingElements(1) == 2, "Expected 2");
+    assertTrue(_parcLogReporterAsync_RingElements(3) == 4, "Expected 4");
+    assertTrue(_parcLogReporterAsync_RingElements(4) == 8, "Expected 8");
+    assertTrue(_parcLogReporterAsync_RingElements(1023) == 1024, "Expected 1024");
+}
+
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, parcLogReporterAsync_Report_Throughput);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    parcMemory_SetInterface(&PARCStdlibMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+static double
+_reportNanoseconds(PARCLogReporter *reporter, PARCLogEntry *entry, int iterations)
+{
+    struct timeval start, end;
+    gettimeofday(&start, NULL);
+    for (int i = 0; i < iterations; i++) {
+        parcLogReporter_Report(reporter, entry);
+    }
+    gettimeofday(&end, NULL);
+    return ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_usec - start.tv_usec) * 1e3) / iterations;
+}
+
+LONGBOW_TEST_CASE(Performance, parcLogReporterAsync_Report_Throughput)
+{
+    const int iterations = 1000000;
+    PARCLogEntry *entry = _createEntry(1234);
+
+    PARCFileOutputStream *fileOutput = parcFileOutputStream_Create(open("/dev/null", O_WRONLY));
+    PARCOutputStream *out = parcFileOutputStream_AsOutputStream(fileOutput);
+    parcFileOutputStream_Release(&fileOutput);
+    PARCLogReporter *reporter = parcLogReporterFile_Create(out);
+    parcOutputStream_Release(&out);
+    printf("parcLogReporterFile_Report: %.0f ns per entry on the calling thread\n",
+           _reportNanoseconds(reporter, entry, iterations));
+    parcLogReporter_Release(&reporter);
+
+    PARCLogReporterAsyncOverflow policies[] = {
+        PARCLogReporterAsyncOverflow_Block, PARCLogReporterAsyncOverflow_DropNewest
+    };
+    const char *names[] = { "Block", "DropNewest" };
+    for (int p = 0; p < 2; p++) {
+        reporter = parcLogReporterAsync_Create(open("/dev/null", O_WRONLY), 4096, policies[p]);
+
+        struct timeval start, end;
+        gettimeofday(&start, NULL);
+        double perEntry = _reportNanoseconds(reporter, entry, iterations);
+        parcLogReporterAsync_Flush(reporter);
+        gettimeofday(&end, NULL);
+        double total = (end.tv_sec - start.tv_sec) * 1e9 + (end.tv_usec - start.tv_usec) * 1e3;
+
+        printf("parcLogReporterAsync_Report %s: %.0f ns per entry on the calling thread, %.0f ns per entry written,"
+               " %" PRIu64 " dropped, %" PRIu64 " blocked\n",
+               names[p], perEntry, total / parcLogReporterAsync_GetWrittenCount(reporter),
+               parcLogReporterAsync_GetDroppedCount(reporter), parcLogReporterAsync_GetBlockedCount(reporter));
+        parcLogReporter_Release(&reporter);
+    }
+
+    parcLogEntry_Release(&entry);
+}
+
+int
+main(int argc, char *argv[])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(parc_LogReporterAsync);
+    int exitStatus = LONGBOW_TEST_MAIN(argc, argv, testRunner);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
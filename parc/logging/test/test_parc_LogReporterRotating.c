@@ -0,0 +1,713 @@
+/*
+ * Copyright (c) 2015, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+// Include the file(s) containing the functions to be tested.
+// This permits internal static functions to be visible to this Test Runner.
+#include "../parc_LogReporterRotating.c"
+
+#include <dirent.h>
+#include <inttypes.h>
+#include <stdlib.h>
+#include <sys/time.h>
+
+#include <parc/logging/parc_LogReporterFile.h>
+#include <parc/algol/parc_FileOutputStream.h>
+#include <parc/testing/parc_ObjectTesting.h>
+
+#include <parc/algol/parc_SafeMemory.h>
+#include <parc/algol/parc_StdlibMemory.h>
+
+#include <LongBow/unit-test.h>
+
+LONGBOW_TEST_RUNNER(parc_LogReporterRotating)
+{
+    // The following Test Fixtures will run their corresponding Test Cases.
+    // Test Fixtures are run in the order specified here, but every test must be idempotent.
+    // Never rely on the execution order of tests or share state between them.
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
+}
+
+// The Test Runner calls this function once before any Test Fixtures are run.
+LONGBOW_TEST_RUNNER_SETUP(parc_LogReporterRotating)
+{
+    parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// The Test Runner calls this function once after all the Test Fixtures are run.
+LONGBOW_TEST_RUNNER_TEARDOWN(parc_LogReporterRotating)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, parcLogReporterRotating_AcquireRelease);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogReporterRotating_Create);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogReporterRotating_Create_BadPath);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogReporterRotating_Create_Appends);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogReporterRotating_Report_Buffered);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogReporterRotating_Report_BufferFull);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogReporterRotating_Report_FlushLevel);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogReporterRotating_Report_FlushInterval);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogReporterRotating_Report_Unbuffered);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogReporterRotating_Report_LargeEntry);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogReporterRotating_Report_LongHeader);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogReporterRotating_Report_Threads);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogReporterRotating_Rotate);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogReporterRotating_Rotate_NoRetainedFiles);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogReporterRotating_Rotate_Size);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogReporterRotating_Rotate_Age);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogReporterRotating_SetSyncInterval);
+}
+
+/*
+ * Each test logs to "log" in its own temporary directory, which the teardown removes with everything in it.
+ */
+typedef struct {
+    char directory[64];
+    char path[80];
+} _TestData;
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    _TestData *data = parcMemory_Allocate(sizeof(_TestData));
+    strcpy(data->directory, "/tmp/test_parc_LogReporterRotatingXXXXXX");
+    assertNotNull(mkdtemp(data->directory), "mkdtemp failed: %s", strerror(errno));
+    snprintf(data->path, sizeof(data->path), "%s/log", data->directory);
+
+    longBowTestCase_SetClipBoardData(testCase, data);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+static void
+_removeDirectory(const char *directory)
+{
+    DIR *dir = opendir(directory);
+    struct dirent *dirent;
+    while ((dirent = readdir(dir)) != NULL) {
+        if (dirent->d_name[0] != '.') {
+            char path[PATH_MAX];
+            snprintf(path, sizeof(path), "%s/%s", directory, dirent->d_name);
+            unlink(path);
+        }
+    }
+    closedir(dir);
+    rmdir(directory);
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    _TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    _removeDirectory(data->directory);
+    parcMemory_Deallocate(&data);
+
+    uint32_t outstandingAllocations = parcSafeMemory_ReportAllocation(STDOUT_FILENO);
+    if (outstandingAllocations != 0) {
+        printf("%s leaks %d memory allocations\n", longBowTestCase_GetName(testCase), outstandingAllocations);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+static PARCLogEntry *
+_createEntry(PARCLogLevel level, uint64_t messageId)
+{
+    struct timeval timeStamp = { .tv_sec = 1456000000, .tv_usec = (suseconds_t) (messageId % 1000000) };
+    PARCBuffer *payload = parcBuffer_AllocateCString("hello");
+    PARCLogEntry *result =
+        parcLogEntry_Create(level, "hostname", "applicationname", "processid", messageId, timeStamp, payload);
+    parcBuffer_Release(&payload);
+    return result;
+}
+
+static void
+_report(PARCLogReporter *reporter, PARCLogLevel level, uint64_t messageId)
+{
+    PARCLogEntry *entry = _createEntry(level, messageId);
+    parcLogReporter_Report(reporter, entry);
+    parcLogEntry_Release(&entry);
+}
+
+static size_t
+_expectedLengthAtLevel(PARCLogLevel level)
+{
+    PARCLogEntry *entry = _createEntry(level, 0);
+    PARCBuffer *formatted = parcLogFormatSyslog_FormatEntry(entry);
+    size_t result = parcBuffer_Remaining(formatted);
+    parcBuffer_Release(&formatted);
+    parcLogEntry_Release(&entry);
+    return result;
+}
+
+static size_t
+_expectedLength(void)
+{
+    return _expectedLengthAtLevel(PARCLogLevel_Info);
+}
+
+/*
+ * The size of the file at path, or -1 if it does not exist.
+ */
+static off_t
+_fileSize(const char *path)
+{
+    struct stat statbuf;
+    if (stat(path, &statbuf) != 0) {
+        return -1;
+    }
+    return statbuf.st_size;
+}
+
+static off_t
+_rotatedFileSize(const char *path, int n)
+{
+    char name[128];
+    snprintf(name, sizeof(name), "%s.%d", path, n);
+    return _fileSize(name);
+}
+
+/*
+ * Read the whole file at path into a nul-terminated C string, which the caller must free.
+ */
+static char *
+_readFile(const char *path)
+{
+    off_t length = _fileSize(path);
+    assertTrue(length >= 0, "Expected %s to exist", path);
+
+    char *result = malloc((size_t) length + 1);
+    int fd = open(path, O_RDONLY);
+    ssize_t nread = read(fd, result, (size_t) length);
+    close(fd);
+    assertTrue(nread == length, "Expected to read %jd bytes, read %zd", (intmax_t) length, nread);
+    result[length] = 0;
+    return result;
+}
+
+static size_t
+_countLines(const char *text)
+{
+    size_t result = 0;
+    for (const char *p = text; *p != 0; p++) {
+        if (*p == '\n') {
+            result++;
+        }
+    }
+    return result;
+}
+
+LONGBOW_TEST_CASE(Global, parcLogReporterRotating_AcquireRelease)
+{
+    _TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    PARCLogReporter *reporter = parcLogReporterRotating_Create(data->path, 0, 0, 0);
+
+    parcObjectTesting_AssertAcquireReleaseContract(parcLogReporterRotating_Acquire, reporter);
+
+    parcLogReporterRotating_Release(&reporter);
+}
+
+LONGBOW_TEST_CASE(Global, parcLogReporterRotating_Create)
+{
+    _TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    PARCLogReporter *reporter = parcLogReporterRotating_Create(data->path, 0, 0, 0);
+    assertNotNull(reporter, "Expected non-null result from parcLogReporterRotating_Create");
+    assertTrue(_fileSize(data->path) == 0, "Expected an empty file to be created");
+
+    assertTrue(parcLogReporterRotating_GetRotationCount(reporter) == 0, "Expected no rotations");
+    assertTrue(parcLogReporterRotating_GetWriteCount(reporter) == 0, "Expected no writes");
+    assertTrue(parcLogReporterRotating_GetSyncCount(reporter) == 0, "Expected no syncs");
+
+    parcLogReporterRotating_Release(&reporter);
+    assertNull(reporter, "Expected parcLogReporterRotating_Release to null the pointer");
+}
+
+LONGBOW_TEST_CASE(Global, parcLogReporterRotating_Create_BadPath)
+{
+    _TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    char path[128];
+    snprintf(path, sizeof(path), "%s/missing/log", data->directory);
+    PARCLogReporter *reporter = parcLogReporterRotating_Create(path, 0, 0, 0);
+    assertNull(reporter, "Expected NULL for a file that cannot be created");
+}
+
+LONGBOW_TEST_CASE(Global, parcLogReporterRotating_Create_Appends)
+{
+    _TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    int fd = open(data->path, O_WRONLY | O_CREAT, 0644);
+    write(fd, "existing\n", 9);
+    close(fd);
+
+    // The existing content counts towards the size limit.
+    size_t maxFileSize = 9 + _expectedLength();
+    PARCLogReporter *reporter = parcLogReporterRotating_Create(data->path, maxFileSize, 0, 1);
+    _report(reporter, PARCLogLevel_Info, 1);
+    _report(reporter, PARCLogLevel_Info, 2);
+    parcLogReporterRotating_Release(&reporter);
+
+    char *rotated = _readFile(strcat(strcpy((char[128]) { 0 }, data->path), ".1"));
+    assertTrue(strncmp(rotated, "existing\n", 9) == 0, "Expected the existing content to be kept");
+    assertTrue(_countLines(rotated) == 2, "Expected the first entry to be appended to the existing file");
+    free(rotated);
+
+    assertTrue(_fileSize(data->path) == (off_t) _expectedLength(), "Expected the second entry in a new file");
+}
+
+LONGBOW_TEST_CASE(Global, parcLogReporterRotating_Report_Buffered)
+{
+    _TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    PARCLogReporter *reporter = parcLogReporterRotating_Create(data->path, 0, 0, 0);
+
+    for (uint64_t i = 0; i < 10; i++) {
+        _report(reporter, PARCLogLevel_Info, i);
+    }
+    assertTrue(_fileSize(data->path) == 0, "Expected the entries to be buffered");
+
+    parcLogReporterRotating_Flush(reporter);
+    assertTrue(parcLogReporterRotating_GetWriteCount(reporter) == 1, "Expected a single write");
+
+    char *contents = _readFile(data->path);
+    char *cursor = contents;
+    for (uint64_t i = 0; i < 10; i++) {
+        PARCLogEntry *entry = _createEntry(PARCLogLevel_Info, i);
+        PARCBuffer *formatted = parcLogFormatSyslog_FormatEntry(entry);
+        char *expected = parcBuffer_ToString(formatted);
+        assertTrue(strncmp(cursor, expected, strlen(expected)) == 0, "Line %" PRIu64 " is wrong or out of order", i);
+        cursor += strlen(expected);
+        parcMemory_Deallocate(&expected);
+        parcBuffer_Release(&formatted);
+        parcLogEntry_Release(&entry);
+    }
+    assertTrue(*cursor == 0, "Expected nothing after the entries");
+    free(contents);
+
+    parcLogReporterRotating_Release(&reporter);
+}
+
+LONGBOW_TEST_CASE(Global, parcLogReporterRotating_Report_BufferFull)
+{
+    _TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    PARCLogReporter *reporter = parcLogReporterRotating_Create(data->path, 0, 0, 0);
+
+    size_t length = _expectedLength();
+    parcLogReporterRotating_SetBuffering(reporter, 4 * length, 0, PARCLogLevel_Emergency);
+
+    for (uint64_t i = 0; i < 4; i++) {
+        _report(reporter, PARCLogLevel_Info, i);
+    }
+    assertTrue(_fileSize(data->path) == 0, "Expected 4 entries to fill the buffer");
+
+    _report(reporter, PARCLogLevel_Info, 4);
+    assertTrue(_fileSize(data->path) == (off_t) (4 * length), "Expected the full buffer to be written");
+
+    parcLogReporterRotating_Release(&reporter);
+    assertTrue(_fileSize(data->path) == (off_t) (5 * length), "Expected the release to write the buffer");
+}
+
+LONGBOW_TEST_CASE(Global, parcLogReporterRotating_Report_FlushLevel)
+{
+    _TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    PARCLogReporter *reporter = parcLogReporterRotating_Create(data->path, 0, 0, 0);
+    size_t warning = _expectedLengthAtLevel(PARCLogLevel_Warning);
+    size_t error = _expectedLengthAtLevel(PARCLogLevel_Error);
+    size_t emergency = _expectedLengthAtLevel(PARCLogLevel_Emergency);
+
+    _report(reporter, PARCLogLevel_Warning, 1);
+    assertTrue(_fileSize(data->path) == 0, "Expected a warning to be buffered");
+
+    _report(reporter, PARCLogLevel_Error, 2);
+    assertTrue(_fileSize(data->path) == (off_t) (warning + error), "Expected an error to write the buffer");
+
+    _report(reporter, PARCLogLevel_Emergency, 3);
+    assertTrue(_fileSize(data->path) == (off_t) (warning + error + emergency),
+               "Expected an emergency to write the buffer");
+
+    parcLogReporterRotating_Release(&reporter);
+}
+
+LONGBOW_TEST_CASE(Global, parcLogReporterRotating_Report_FlushInterval)
+{
+    _TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    PARCLogReporter *reporter = parcLogReporterRotating_Create(data->path, 0, 0, 0);
+    parcLogReporterRotating_SetBuffering(reporter, 64 * 1024, 50, PARCLogLevel_Error);
+    size_t length = _expectedLength();
+
+    _report(reporter, PARCLogLevel_Info, 1);
+    _report(reporter, PARCLogLevel_Info, 2);
+    assertTrue(_fileSize(data->path) == 0, "Expected the entries to be buffered");
+
+    usleep(100000);
+    _report(reporter, PARCLogLevel_Info, 3);
+    assertTrue(_fileSize(data->path) == (off_t) (3 * length), "Expected the interval to have expired");
+
+    // The interval starts again with the next entry buffered.
+    _report(reporter, PARCLogLevel_Info, 4);
+    assertTrue(_fileSize(data->path) == (off_t) (3 * length), "Expected the entry to be buffered");
+
+    parcLogReporterRotating_Release(&reporter);
+}
+
+LONGBOW_TEST_CASE(Global, parcLogReporterRotating_Report_Unbuffered)
+{
+    _TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    PARCLogReporter *reporter = parcLogReporterRotating_Create(data->path, 0, 0, 0);
+    parcLogReporterRotating_SetBuffering(reporter, 0, 0, PARCLogLevel_Error);
+    size_t length = _expectedLength();
+
+    for (uint64_t i = 1; i <= 3; i++) {
+        _report(reporter, PARCLogLevel_Info, i);
+        assertTrue(_fileSize(data->path) == (off_t) (i * length), "Expected entry %" PRIu64 " to be written", i);
+    }
+    assertTrue(parcLogReporterRotating_GetWriteCount(reporter) == 3, "Expected a write per entry");
+
+    parcLogReporterRotating_Release(&reporter);
+}
+
+LONGBOW_TEST_CASE(Global, parcLogReporterRotating_Report_LargeEntry)
+{
+    _TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    PARCLogReporter *reporter = parcLogReporterRotating_Create(data->path, 0, 0, 0);
+    parcLogReporterRotating_SetBuffering(reporter, 256, 0, PARCLogLevel_Error);
+
+    _report(reporter, PARCLogLevel_Info, 1);
+
+    char text[1024];
+    memset(text, 'x', sizeof(text) - 1);
+    text[sizeof(text) - 1] = 0;
+    PARCBuffer *payload = parcBuffer_AllocateCString(text);
+    struct timeval timeStamp = { .tv_sec = 1456000000, .tv_usec = 0 };
+    PARCLogEntry *entry = parcLogEntry_Create(PARCLogLevel_Info, "hostname", "applicationname", "processid", 2,
+                                              timeStamp, payload);
+    parcBuffer_Release(&payload);
+    parcLogReporter_Report(reporter, entry);
+
+    assertTrue(parcBuffer_Position(parcLogEntry_GetPayload(entry)) == 0, "Expected the payload to be left unchanged");
+    parcLogReporterRotating_Release(&reporter);
+
+    PARCBuffer *formatted = parcLogFormatSyslog_FormatEntry(entry);
+    char *expected = parcBuffer_ToString(formatted);
+    char *contents = _readFile(data->path);
+    assertTrue(_countLines(contents) == 2, "Expected 2 lines");
+    assertTrue(strcmp(strchr(contents, '\n') + 1, expected) == 0, "Expected the buffered entry, then the large entry");
+
+    free(contents);
+    parcMemory_Deallocate(&expected);
+    parcBuffer_Release(&formatted);
+    parcLogEntry_Release(&entry);
+}
+
+LONGBOW_TEST_CASE(Global, parcLogReporterRotating_Report_LongHeader)
+{
+    _TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    PARCLogReporter *reporter = parcLogReporterRotating_Create(data->path, 0, 0, 0);
+
+    char hostName[1024];
+    memset(hostName, 'h', sizeof(hostName) - 1);
+    hostName[sizeof(hostName) - 1] = 0;
+    PARCBuffer *payload = parcBuffer_AllocateCString("hello");
+    struct timeval timeStamp = { .tv_sec = 1456000000, .tv_usec = 0 };
+    PARCLogEntry *entry = parcLogEntry_Create(PARCLogLevel_Info, hostName, "applicationname", "processid", 1,
+                                              timeStamp, payload);
+    parcBuffer_Release(&payload);
+
+    parcLogReporter_Report(reporter, entry);
+    parcLogReporterRotating_Release(&reporter);
+
+    PARCBuffer *formatted = parcLogFormatSyslog_FormatEntry(entry);
+    char *expected = parcBuffer_ToString(formatted);
+    char *contents = _readFile(data->path);
+    assertTrue(strcmp(contents, expected) == 0, "Expected an entry with a long header to be formatted in full");
+
+    free(contents);
+    parcMemory_Deallocate(&expected);
+    parcBuffer_Release(&formatted);
+    parcLogEntry_Release(&entry);
+}
+
+typedef struct {
+    PARCLogReporter *reporter;
+    int thread;
+    int count;
+} _ProducerArgs;
+
+static void *
+_producer(void *context)
+{
+    _ProducerArgs *args = context;
+    for (int i = 0; i < args->count; i++) {
+        _report(args->reporter, PARCLogLevel_Info, (uint64_t) args->thread * 1000000 + i);
+    }
+    return NULL;
+}
+
+LONGBOW_TEST_CASE(Global, parcLogReporterRotating_Report_Threads)
+{
+    _TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    PARCLogReporter *reporter = parcLogReporterRotating_Create(data->path, 0, 0, 0);
+    parcLogReporterRotating_SetBuffering(reporter, 4096, 0, PARCLogLevel_Error);
+
+    const int count = 1000;
+    pthread_t threads[4];
+    _ProducerArgs args[4];
+    for (int t = 0; t < 4; t++) {
+        args[t] = (_ProducerArgs) { .reporter = reporter, .thread = t, .count = count };
+        pthread_create(&threads[t], NULL, _producer, &args[t]);
+    }
+    for (int t = 0; t < 4; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    parcLogReporterRotating_Release(&reporter);
+
+    // Every line is whole, and each thread's lines are in order.
+    char *contents = _readFile(data->path);
+    assertTrue(_countLines(contents) == 4 * count, "Expected %d lines, actual %zu", 4 * count, _countLines(contents));
+    int next[4] = { 0, 0, 0, 0 };
+    for (char *line = strtok(contents, "\n"); line != NULL; line = strtok(NULL, "\n")) {
+        uint64_t messageId;
+        assertTrue(sscanf(line, "<Info> 1 %*s hostname applicationname processid %" SCNu64 " [ hello ]", &messageId) == 1,
+                   "Malformed line '%s'", line);
+        int thread = (int) (messageId / 1000000);
+        int sequence = (int) (messageId % 1000000);
+        assertTrue(sequence == next[thread], "Thread %d: expected %d, actual %d", thread, next[thread], sequence);
+        next[thread]++;
+    }
+    free(contents);
+}
+
+LONGBOW_TEST_CASE(Global, parcLogReporterRotating_Rotate)
+{
+    _TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    PARCLogReporter *reporter = parcLogReporterRotating_Create(data->path, 0, 0, 3);
+    size_t length = _expectedLength();
+
+    // Each rotation leaves a file one entry longer than the last.
+    for (int n = 1; n <= 5; n++) {
+        for (int i = 0; i < n; i++) {
+            _report(reporter, PARCLogLevel_Info, i);
+        }
+        assertTrue(parcLogReporterRotating_Rotate(reporter), "Expected rotation %d to succeed", n);
+    }
+    assertTrue(parcLogReporterRotating_GetRotationCount(reporter) == 5, "Expected 5 rotations");
+    parcLogReporterRotating_Release(&reporter);
+
+    assertTrue(_fileSize(data->path) == 0, "Expected a new, empty file");
+    assertTrue(_rotatedFileSize(data->path, 1) == (off_t) (5 * length), "Expected the most recent file as .1");
+    assertTrue(_rotatedFileSize(data->path, 2) == (off_t) (4 * length), "Expected the previous file as .2");
+    assertTrue(_rotatedFileSize(data->path, 3) == (off_t) (3 * length), "Expected the oldest retained file as .3");
+    assertTrue(_rotatedFileSize(data->path, 4) == -1, "Expected only 3 files to be retained");
+}
+
+LONGBOW_TEST_CASE(Global, parcLogReporterRotating_Rotate_NoRetainedFiles)
+{
+    _TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    PARCLogReporter *reporter = parcLogReporterRotating_Create(data->path, 0, 0, 0);
+
+    _report(reporter, PARCLogLevel_Info, 1);
+    parcLogReporterRotating_Rotate(reporter);
+    _report(reporter, PARCLogLevel_Info, 2);
+    parcLogReporterRotating_Release(&reporter);
+
+    assertTrue(_fileSize(data->path) == (off_t) _expectedLength(), "Expected only the entry after the rotation");
+    assertTrue(_rotatedFileSize(data->path, 1) == -1, "Expected no rotated file");
+}
+
+LONGBOW_TEST_CASE(Global, parcLogReporterRotating_Rotate_Size)
+{
+    _TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    size_t length = _expectedLength();
+
+    // Room for 3 entries in each file.
+    PARCLogReporter *reporter = parcLogReporterRotating_Create(data->path, 3 * length + length / 2, 0, 2);
+    for (uint64_t i = 0; i < 10; i++) {
+        _report(reporter, PARCLogLevel_Info, i);
+    }
+    assertTrue(parcLogReporterRotating_GetRotationCount(reporter) == 3,
+               "Expected 3 rotations, actual %" PRIu64, parcLogReporterRotating_GetRotationCount(reporter));
+    parcLogReporterRotating_Release(&reporter);
+
+    assertTrue(_fileSize(data->path) == (off_t) length, "Expected the last entry in the current file");
+    assertTrue(_rotatedFileSize(data->path, 1) == (off_t) (3 * length), "Expected 3 entries in .1");
+    assertTrue(_rotatedFileSize(data->path, 2) == (off_t) (3 * length), "Expected 3 entries in .2");
+    assertTrue(_rotatedFileSize(data->path, 3) == -1, "Expected only 2 files to be retained");
+}
+
+LONGBOW_TEST_CASE(Global, parcLogReporterRotating_Rotate_Age)
+{
+    _TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    PARCLogReporter *reporter = parcLogReporterRotating_Create(data->path, 0, 1, 1);
+
+    _report(reporter, PARCLogLevel_Info, 1);
+    _report(reporter, PARCLogLevel_Info, 2);
+    assertTrue(parcLogReporterRotating_GetRotationCount(reporter) == 0, "Expected no rotation yet");
+
+    usleep(1100000);
+    _report(reporter, PARCLogLevel_Info, 3);
+    assertTrue(parcLogReporterRotating_GetRotationCount(reporter) == 1, "Expected the file to have expired");
+    parcLogReporterRotating_Release(&reporter);
+
+    assertTrue(_rotatedFileSize(data->path, 1) == (off_t) (2 * _expectedLength()), "Expected the first entries in .1");
+    assertTrue(_fileSize(data->path) == (off_t) _expectedLength(), "Expected the last entry in the new file");
+}
+
+LONGBOW_TEST_CASE(Global, parcLogReporterRotating_SetSyncInterval)
+{
+    _TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    PARCLogReporter *reporter = parcLogReporterRotating_Create(data->path, 0, 0, 0);
+    parcLogReporterRotating_SetBuffering(reporter, 0, 0, PARCLogLevel_Error);
+
+    _report(reporter, PARCLogLevel_Info, 1);
+    assertTrue(parcLogReporterRotating_GetSyncCount(reporter) == 0, "Expected syncing to be disabled by default");
+
+    parcLogReporterRotating_SetSyncInterval(reporter, 0);
+    for (uint64_t i = 0; i < 3; i++) {
+        _report(reporter, PARCLogLevel_Info, i);
+    }
+    assertTrue(parcLogReporterRotating_GetSyncCount(reporter) == 3, "Expected a sync after every write");
+
+    // Within one long interval, ordinary writes share a sync, but an error is synced at once.
+    parcLogReporterRotating_SetSyncInterval(reporter, 60000);
+    for (uint64_t i = 0; i < 10; i++) {
+        _report(reporter, PARCLogLevel_Info, i);
+    }
+    assertTrue(parcLogReporterRotating_GetSyncCount(reporter) == 3, "Expected no sync within the interval");
+    _report(reporter, PARCLogLevel_Error, 10);
+    assertTrue(parcLogReporterRotating_GetSyncCount(reporter) == 4, "Expected an error to be synced");
+
+    parcLogReporterRotating_SetSyncInterval(reporter, UINT32_MAX);
+    _report(reporter, PARCLogLevel_Error, 11);
+    parcLogReporterRotating_Flush(reporter);
+    assertTrue(parcLogReporterRotating_GetSyncCount(reporter) == 4, "Expected syncing to be disabled");
+
+    parcLogReporterRotating_Release(&reporter);
+}
+
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, parcLogReporterRotating_Report_Throughput);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    parcMemory_SetInterface(&PARCStdlibMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+static double
+_linesPerSecond(PARCLogReporter *reporter, PARCLogEntry *entry, int iterations)
+{
+    struct timeval start, end;
+    gettimeofday(&start, NULL);
+    for (int i = 0; i < iterations; i++) {
+        parcLogReporter_Report(reporter, entry);
+    }
+    parcLogReporter_Release(&reporter);
+    gettimeofday(&end, NULL);
+    return iterations / ((end.tv_sec - start.tv_sec) + (end.tv_usec - start.tv_usec) / 1e6);
+}
+
+LONGBOW_TEST_CASE(Performance, parcLogReporterRotating_Report_Throughput)
+{
+    const int iterations = 500000;
+    PARCLogEntry *entry = _createEntry(PARCLogLevel_Info, 1234);
+
+    char directory[] = "/tmp/test_parc_LogReporterRotatingXXXXXX";
+    mkdtemp(directory);
+    char path[128];
+    snprintf(path, sizeof(path), "%s/log", directory);
+
+    PARCFileOutputStream *fileOutput = parcFileOutputStream_Create(open(path, O_WRONLY | O_APPEND | O_CREAT, 0644));
+    PARCOutputStream *out = parcFileOutputStream_AsOutputStream(fileOutput);
+    parcFileOutputStream_Release(&fileOutput);
+    PARCLogReporter *reporter = parcLogReporterFile_Create(out);
+    parcOutputStream_Release(&out);
+    printf("parcLogReporterFile_Report: %.0f lines per second\n", _linesPerSecond(reporter, entry, iterations));
+    unlink(path);
+
+    reporter = parcLogReporterRotating_Create(path, 0, 0, 0);
+    parcLogReporterRotating_SetBuffering(reporter, 0, 0, PARCLogLevel_Error);
+    printf("parcLogReporterRotating_Report, unbuffered: %.0f lines per second\n",
+           _linesPerSecond(reporter, entry, iterations));
+    unlink(path);
+
+    reporter = parcLogReporterRotating_Create(path, 0, 0, 0);
+    printf("parcLogReporterRotating_Report, 64 KB buffer: %.0f lines per second\n",
+           _linesPerSecond(reporter, entry, iterations));
+    unlink(path);
+
+    reporter = parcLogReporterRotating_Create(path, 16 * 1024 * 1024, 0, 2);
+    parcLogReporterRotating_SetSyncInterval(reporter, 100);
+    printf("parcLogReporterRotating_Report, 64 KB buffer, 16 MB files, sync every 100 ms: %.0f lines per second\n",
+           _linesPerSecond(reporter, entry, iterations));
+
+    _removeDirectory(directory);
+    parcLogEntry_Release(&entry);
+}
+
+int
+main(int argc, char *argv[])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(parc_LogReporterRotating);
+    int exitStatus = LONGBOW_TEST_MAIN(argc, argv, testRunner);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
@@ -53,30 +53,369 @@
  * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
  */
 /**
+ * The free buffers of a pool are held in magazines, fixed capacity stacks of buffers, after Bonwick's magazine layer.
+ * Each thread using a pool holds two magazines for it, loaded and previous, and only visits the pool's depot when
+ * both are empty on get or both are full on release.
+ * The depot is a pair of lock-free (Treiber) stacks, one of full magazines and one of empty magazines.
+ *
+ * Magazines are never freed while the pool exists, so a depot stack can link them by their index in the pool's
+ * magazine table, and the stack head carries a modification count alongside the index to defeat the ABA problem.
+ *
+ * The number of cached buffers is kept in a single counter so that the limit, `parcBufferPool_GetCurrentPoolSize`
+ * and `parcBufferPool_GetLargestPoolSize` are exact.  The cache hit and instance counts are kept per thread and
+ * summed when they are read.
+ *
+ * `parcBufferPool_Drain` cannot reach into the magazines of other running threads.  Instead it advances the pool's
+ * drain epoch, and each thread frees its share of the excess the next time it uses the pool and sees the new epoch.
+ *
+ * The magazine and thread cache bookkeeping is allocated directly from the system,
+ * only the buffers themselves are allocated through parcMemory.
+ *
  * @author Glenn Scott, Palo Alto Research Center (PARC)
  * @copyright 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
  */
 #include <config.h>
 
+#include <stdlib.h>
+#include <pthread.h>
+
 #include <parc/algol/parc_Object.h>
 #include <parc/algol/parc_DisplayIndented.h>
 #include <parc/algol/parc_Memory.h>
 
-#include <parc/algol/parc_LinkedList.h>
-
 #include "parc_BufferPool.h"
 
+// The number of buffers in a magazine.
+#define MAGAZINE_CAPACITY 16
+
+// Magazines are allocated in blocks, which are never moved, so that depot stacks can refer to them by index.
+#define MAGAZINE_BLOCK_SIZE 64
+#define MAGAZINE_BLOCK_COUNT 256
+
+typedef struct {
+    // The position of this magazine in the pool's magazine table, plus 1.
+    uint32_t index;
+    // The index of the next magazine in the depot stack holding this magazine, 0 for none.
+    uint32_t next;
+    size_t count;
+    PARCBuffer *buffers[MAGAZINE_CAPACITY];
+} _PARCBufferPoolMagazine;
+
+typedef struct _parcBufferPoolThreadCache {
+    // NULL once the pool has been destroyed.  The owning thread then frees this cache.
+    PARCBufferPool *pool;
+    _PARCBufferPoolMagazine *loaded;
+    _PARCBufferPoolMagazine *previous;
+
+    // Written only by the owning thread.
+    size_t totalInstances;
+    size_t cacheHits;
+    uint32_t drainEpoch;
+
+    struct _parcBufferPoolThreadCache *nextInThread;
+    struct _parcBufferPoolThreadCache *nextInPool;
+} _PARCBufferPoolThreadCache;
+
 struct PARCBufferPool {
     size_t bufferSize;
     size_t limit;
+    // Advanced by every parcBufferPool_Drain, so that threads know to drain their own magazines.
+    uint32_t drainEpoch;
     size_t largestPoolSize;
+    size_t poolSize;
+
+    // The counts of the thread caches that no longer exist.
     size_t totalInstances;
     size_t cacheHits;
-    PARCLinkedList *freeList;
+
+    // Depot stack heads: the modification count in the high 32 bits, the top magazine index in the low 32 bits.
+    uint64_t fullMagazines;
+    uint64_t emptyMagazines;
+
+    uint32_t magazineCount;
+    _PARCBufferPoolMagazine *magazineBlocks[MAGAZINE_BLOCK_COUNT];
+
+    // The thread caches for this pool, guarded by the registry lock.
+    _PARCBufferPoolThreadCache *threadCaches;
+
     PARCObjectDescriptor *descriptor;
     const PARCObjectDescriptor *originalDescriptor;
 };
 
+// Guards the thread cache lists of all pools, and the growth of their magazine tables.
+static pthread_mutex_t _parcBufferPool_RegistryLock = PTHREAD_MUTEX_INITIALIZER;
+
+static pthread_key_t _parcBufferPool_ThreadCacheKey;
+static pthread_once_t _parcBufferPool_ThreadCacheOnce = PTHREAD_ONCE_INIT;
+
+static inline _PARCBufferPoolMagazine *
+_parcBufferPool_Magazine(const PARCBufferPool *pool, uint32_t index)
+{
+    _PARCBufferPoolMagazine *block = __atomic_load_n(&pool->magazineBlocks[(index - 1) / MAGAZINE_BLOCK_SIZE], __ATOMIC_ACQUIRE);
+    return &block[(index - 1) % MAGAZINE_BLOCK_SIZE];
+}
+
+/*
+ * Allocate a new empty magazine for the pool.
+ *
+ * Return NULL if the pool's magazine table is full.
+ */
+static _PARCBufferPoolMagazine *
+_parcBufferPool_CreateMagazine(PARCBufferPool *pool)
+{
+    _PARCBufferPoolMagazine *result = NULL;
+
+    pthread_mutex_lock(&_parcBufferPool_RegistryLock);
+    uint32_t index = pool->magazineCount;
+    if (index < MAGAZINE_BLOCK_SIZE * MAGAZINE_BLOCK_COUNT) {
+        _PARCBufferPoolMagazine *block = pool->magazineBlocks[index / MAGAZINE_BLOCK_SIZE];
+        if (block == NULL) {
+            block = calloc(MAGAZINE_BLOCK_SIZE, sizeof(_PARCBufferPoolMagazine));
+            trapOutOfMemoryIf(block == NULL, "Cannot allocate a block of PARCBufferPool magazines");
+            for (uint32_t i = 0; i < MAGAZINE_BLOCK_SIZE; i++) {
+                block[i].index = index + i + 1;
+            }
+            __atomic_store_n(&pool->magazineBlocks[index / MAGAZINE_BLOCK_SIZE], block, __ATOMIC_RELEASE);
+        }
+        result = &block[index % MAGAZINE_BLOCK_SIZE];
+        pool->magazineCount = index + 1;
+    }
+    pthread_mutex_unlock(&_parcBufferPool_RegistryLock);
+
+    return result;
+}
+
+static void
+_parcBufferPool_DepotPush(uint64_t *depot, _PARCBufferPoolMagazine *magazine)
+{
+    uint64_t top = __atomic_load_n(depot, __ATOMIC_RELAXED);
+    uint64_t newTop;
+    do {
+        __atomic_store_n(&magazine->next, (uint32_t) top, __ATOMIC_RELAXED);
+        newTop = (((top >> 32) + 1) << 32) | magazine->index;
+    } while (!__atomic_compare_exchange_n(depot, &top, newTop, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+}
+
+static _PARCBufferPoolMagazine *
+_parcBufferPool_DepotPop(const PARCBufferPool *pool, uint64_t *depot)
+{
+    uint64_t top = __atomic_load_n(depot, __ATOMIC_ACQUIRE);
+
+    while ((uint32_t) top != 0) {
+        _PARCBufferPoolMagazine *magazine = _parcBufferPool_Magazine(pool, (uint32_t) top);
+
+        // The magazine may be popped and pushed again before the exchange below,
+        // in which case the modification count will have changed and the exchange will fail.
+        uint64_t newTop = (((top >> 32) + 1) << 32) | __atomic_load_n(&magazine->next, __ATOMIC_RELAXED);
+        if (__atomic_compare_exchange_n(depot, &top, newTop, true, __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE)) {
+            return magazine;
+        }
+    }
+
+    return NULL;
+}
+
+/*
+ * Give a magazine back to the depot, on the stack of full magazines if it holds any buffers.
+ */
+static void
+_parcBufferPool_DepotReturn(PARCBufferPool *pool, _PARCBufferPoolMagazine *magazine)
+{
+    if (magazine != NULL) {
+        _parcBufferPool_DepotPush(magazine->count > 0 ? &pool->fullMagazines : &pool->emptyMagazines, magazine);
+    }
+}
+
+/*
+ * Restore a cached buffer to a plain PARCBuffer and release it.
+ */
+static void
+_parcBufferPool_FreeBuffer(PARCBuffer *buffer)
+{
+    parcObject_SetDescriptor(buffer, &PARCBuffer_Descriptor);
+    parcBuffer_Release(&buffer);
+}
+
+/*
+ * Free up to `count` buffers from the top of a magazine, returning the number freed.
+ */
+static size_t
+_parcBufferPool_FreeMagazineBuffers(PARCBufferPool *pool, _PARCBufferPoolMagazine *magazine, size_t count)
+{
+    size_t result = 0;
+
+    if (magazine != NULL) {
+        while (result < count && magazine->count > 0) {
+            _parcBufferPool_FreeBuffer(magazine->buffers[--magazine->count]);
+            result++;
+        }
+        __atomic_sub_fetch(&pool->poolSize, result, __ATOMIC_RELAXED);
+    }
+
+    return result;
+}
+
+/*
+ * Free the calling thread's cached buffers in excess of the pool's limit, returning the number freed.
+ */
+static size_t
+_parcBufferPool_ThreadCacheDrain(PARCBufferPool *pool, _PARCBufferPoolThreadCache *cache)
+{
+    size_t result = 0;
+
+    size_t poolSize = __atomic_load_n(&pool->poolSize, __ATOMIC_RELAXED);
+    if (poolSize > pool->limit) {
+        size_t excess = poolSize - pool->limit;
+        result += _parcBufferPool_FreeMagazineBuffers(pool, cache->loaded, excess);
+        result += _parcBufferPool_FreeMagazineBuffers(pool, cache->previous, excess - result);
+    }
+
+    return result;
+}
+
+static void
+_parcBufferPool_ThreadCacheDestroy(void *value)
+{
+    _PARCBufferPoolThreadCache *cache = value;
+
+    pthread_mutex_lock(&_parcBufferPool_RegistryLock);
+    while (cache != NULL) {
+        PARCBufferPool *pool = cache->pool;
+        if (pool != NULL) {
+            _parcBufferPool_DepotReturn(pool, cache->loaded);
+            _parcBufferPool_DepotReturn(pool, cache->previous);
+
+            pool->totalInstances += cache->totalInstances;
+            pool->cacheHits += cache->cacheHits;
+
+            _PARCBufferPoolThreadCache **link = &pool->threadCaches;
+            while (*link != cache) {
+                link = &(*link)->nextInPool;
+            }
+            *link = cache->nextInPool;
+        }
+
+        _PARCBufferPoolThreadCache *next = cache->nextInThread;
+        free(cache);
+        cache = next;
+    }
+    pthread_mutex_unlock(&_parcBufferPool_RegistryLock);
+}
+
+static void
+_parcBufferPool_ThreadCacheInitialize(void)
+{
+    int error = pthread_key_create(&_parcBufferPool_ThreadCacheKey, _parcBufferPool_ThreadCacheDestroy);
+    trapUnexpectedStateIf(error != 0, "Cannot create the PARCBufferPool thread cache key: %d", error);
+}
+
+/*
+ * Find the calling thread's cache for the given pool, creating it if necessary.
+ *
+ * If the pool has been drained since this thread last looked, the cache first frees its share of the excess.
+ * Caches left behind by pools that have since been destroyed are freed along the way.
+ */
+static _PARCBufferPoolThreadCache *
+_parcBufferPool_ThreadCache(PARCBufferPool *pool)
+{
+    pthread_once(&_parcBufferPool_ThreadCacheOnce, _parcBufferPool_ThreadCacheInitialize);
+
+    _PARCBufferPoolThreadCache *first = pthread_getspecific(_parcBufferPool_ThreadCacheKey);
+
+    _PARCBufferPoolThreadCache **link = &first;
+    while (*link != NULL) {
+        _PARCBufferPoolThreadCache *cache = *link;
+        PARCBufferPool *cachePool = __atomic_load_n(&cache->pool, __ATOMIC_ACQUIRE);
+        if (cachePool == pool) {
+            uint32_t drainEpoch = __atomic_load_n(&pool->drainEpoch, __ATOMIC_RELAXED);
+            if (cache->drainEpoch != drainEpoch) {
+                cache->drainEpoch = drainEpoch;
+                _parcBufferPool_ThreadCacheDrain(pool, cache);
+            }
+            return cache;
+        }
+        if (cachePool == NULL) {
+            *link = cache->nextInThread;
+            free(cache);
+            pthread_setspecific(_parcBufferPool_ThreadCacheKey, first);
+        } else {
+            link = &cache->nextInThread;
+        }
+    }
+
+    _PARCBufferPoolThreadCache *result = calloc(1, sizeof(_PARCBufferPoolThreadCache));
+    trapOutOfMemoryIf(result == NULL, "Cannot allocate a PARCBufferPool thread cache");
+    result->pool = pool;
+    result->drainEpoch = __atomic_load_n(&pool->drainEpoch, __ATOMIC_RELAXED);
+    result->nextInThread = first;
+    pthread_setspecific(_parcBufferPool_ThreadCacheKey, result);
+
+    pthread_mutex_lock(&_parcBufferPool_RegistryLock);
+    result->nextInPool = pool->threadCaches;
+    pool->threadCaches = result;
+    pthread_mutex_unlock(&_parcBufferPool_RegistryLock);
+
+    return result;
+}
+
+/*
+ * Take a buffer from the calling thread's magazines, refilling them from the depot if they are both empty.
+ *
+ * Return NULL if there are no cached buffers available to this thread.
+ */
+static PARCBuffer *
+_parcBufferPool_ThreadCacheGet(PARCBufferPool *pool, _PARCBufferPoolThreadCache *cache)
+{
+    if (cache->loaded == NULL || cache->loaded->count == 0) {
+        if (cache->previous != NULL && cache->previous->count > 0) {
+            _PARCBufferPoolMagazine *magazine = cache->loaded;
+            cache->loaded = cache->previous;
+            cache->previous = magazine;
+        } else {
+            _PARCBufferPoolMagazine *full = _parcBufferPool_DepotPop(pool, &pool->fullMagazines);
+            if (full == NULL) {
+                return NULL;
+            }
+            _parcBufferPool_DepotReturn(pool, cache->previous);
+            cache->previous = cache->loaded;
+            cache->loaded = full;
+        }
+    }
+
+    return cache->loaded->buffers[--cache->loaded->count];
+}
+
+/*
+ * Put a buffer in the calling thread's magazines, exchanging a full magazine for an empty one at the depot if they are both full.
+ *
+ * Return false if there is no magazine available to hold the buffer.
+ */
+static bool
+_parcBufferPool_ThreadCachePut(PARCBufferPool *pool, _PARCBufferPoolThreadCache *cache, PARCBuffer *buffer)
+{
+    if (cache->loaded == NULL || cache->loaded->count == MAGAZINE_CAPACITY) {
+        if (cache->previous != NULL && cache->previous->count == 0) {
+            _PARCBufferPoolMagazine *magazine = cache->loaded;
+            cache->loaded = cache->previous;
+            cache->previous = magazine;
+        } else {
+            _PARCBufferPoolMagazine *empty = _parcBufferPool_DepotPop(pool, &pool->emptyMagazines);
+            if (empty == NULL) {
+                empty = _parcBufferPool_CreateMagazine(pool);
+                if (empty == NULL) {
+                    return false;
+                }
+            }
+            _parcBufferPool_DepotReturn(pool, cache->previous);
+            cache->previous = cache->loaded;
+            cache->loaded = empty;
+        }
+    }
+
+    cache->loaded->buffers[cache->loaded->count++] = buffer;
+    return true;
+}
+
 static bool
 _parcBufferPool_Destructor(PARCBufferPool **instancePtr)
 {
@@ -84,9 +423,30 @@ _parcBufferPool_Destructor(PARCBufferPool **instancePtr)
 
     PARCBufferPool *pool = *instancePtr;
 
-    parcLinkedList_Apply(pool->freeList, (void (*))parcObject_SetDescriptor, (const void *) &PARCBuffer_Descriptor);
+    pthread_mutex_lock(&_parcBufferPool_RegistryLock);
+    _PARCBufferPoolThreadCache *cache = pool->threadCaches;
+    while (cache != NULL) {
+        _PARCBufferPoolThreadCache *next = cache->nextInPool;
+        _parcBufferPool_FreeMagazineBuffers(pool, cache->loaded, MAGAZINE_CAPACITY);
+        _parcBufferPool_FreeMagazineBuffers(pool, cache->previous, MAGAZINE_CAPACITY);
+        cache->loaded = NULL;
+        cache->previous = NULL;
+        // From here on the cache belongs solely to its thread, which frees it.
+        __atomic_store_n(&cache->pool, NULL, __ATOMIC_RELEASE);
+        cache = next;
+    }
+    pool->threadCaches = NULL;
+    pthread_mutex_unlock(&_parcBufferPool_RegistryLock);
+
+    _PARCBufferPoolMagazine *magazine;
+    while ((magazine = _parcBufferPool_DepotPop(pool, &pool->fullMagazines)) != NULL) {
+        _parcBufferPool_FreeMagazineBuffers(pool, magazine, MAGAZINE_CAPACITY);
+    }
+
+    for (size_t i = 0; i < MAGAZINE_BLOCK_COUNT; i++) {
+        free(pool->magazineBlocks[i]);
+    }
 
-    parcLinkedList_Release(&pool->freeList);
     parcObjectDescriptor_Destroy(&pool->descriptor);
 
     return true;
@@ -99,20 +459,24 @@ _parcBufferPool_ObjectDestructor(PARCBuffer **bufferPtr)
 
     PARCBufferPool *bufferPool = parcObjectDescriptor_GetTypeState(parcObject_GetDescriptor(buffer));
 
-    parcObject_Synchronize(bufferPool->freeList) {
-        size_t freeListSize = parcLinkedList_Size(bufferPool->freeList);
+    // A cached buffer holds one reference, which is handed to the caller of parcBufferPool_GetInstance.
+    parcBuffer_Acquire(buffer);
 
-        if (bufferPool->limit > freeListSize) {
-            parcLinkedList_Append(bufferPool->freeList, buffer);
-            freeListSize++;
-            if (bufferPool->largestPoolSize < freeListSize) {
-                bufferPool->largestPoolSize = freeListSize;
-            }
-        } else {
-            parcBuffer_Acquire(buffer);
-            parcObject_SetDescriptor(buffer, &PARCBuffer_Descriptor);
-            parcBuffer_Release(&buffer);
+    bool cached = false;
+    size_t poolSize = __atomic_add_fetch(&bufferPool->poolSize, 1, __ATOMIC_RELAXED);
+    if (poolSize <= bufferPool->limit) {
+        cached = _parcBufferPool_ThreadCachePut(bufferPool, _parcBufferPool_ThreadCache(bufferPool), buffer);
+    }
+
+    if (cached) {
+        size_t largestPoolSize = __atomic_load_n(&bufferPool->largestPoolSize, __ATOMIC_RELAXED);
+        while (poolSize > largestPoolSize
+               && !__atomic_compare_exchange_n(&bufferPool->largestPoolSize, &largestPoolSize, poolSize, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+            ;
         }
+    } else {
+        __atomic_sub_fetch(&bufferPool->poolSize, 1, __ATOMIC_RELAXED);
+        _parcBufferPool_FreeBuffer(buffer);
     }
 
     *bufferPtr = 0;
@@ -138,15 +502,11 @@ parcBufferPool_AssertValid(const PARCBufferPool *instance)
 PARCBufferPool *
 parcBufferPool_CreateExtending(const PARCObjectDescriptor *originalDescriptor, size_t limit, size_t bufferSize)
 {
-    PARCBufferPool *result = parcObject_CreateInstance(PARCBufferPool);
+    PARCBufferPool *result = parcObject_CreateAndClearInstance(PARCBufferPool);
 
     if (result != NULL) {
         result->limit = limit;
-        result->totalInstances = 0;
-        result->cacheHits = 0;
-        result->largestPoolSize = 0;
         result->bufferSize = bufferSize;
-        result->freeList = parcLinkedList_Create();
 
         result->originalDescriptor = originalDescriptor;
 
@@ -182,7 +542,7 @@ parcBufferPool_IsValid(const PARCBufferPool *bufferPool)
     bool result = false;
 
     if (bufferPool != NULL) {
-        result = parcLinkedList_IsValid(bufferPool->freeList);
+        result = bufferPool->descriptor != NULL;
     }
 
     return result;
@@ -191,18 +551,18 @@ parcBufferPool_IsValid(const PARCBufferPool *bufferPool)
 PARCBuffer *
 parcBufferPool_GetInstance(PARCBufferPool *bufferPool)
 {
-    PARCBuffer *result = NULL;
+    _PARCBufferPoolThreadCache *cache = _parcBufferPool_ThreadCache(bufferPool);
 
-    parcObject_Synchronize(bufferPool->freeList) {
-        if (parcLinkedList_Size(bufferPool->freeList) > 0) {
-            result = parcLinkedList_RemoveFirst(bufferPool->freeList);
-            bufferPool->cacheHits++;
-        } else {
-            result = parcBuffer_Allocate(bufferPool->bufferSize);
-            parcObject_SetDescriptor(result, bufferPool->descriptor);
-        }
-        bufferPool->totalInstances++;
+    PARCBuffer *result = _parcBufferPool_ThreadCacheGet(bufferPool, cache);
+
+    if (result != NULL) {
+        __atomic_sub_fetch(&bufferPool->poolSize, 1, __ATOMIC_RELAXED);
+        __atomic_store_n(&cache->cacheHits, cache->cacheHits + 1, __ATOMIC_RELAXED);
+    } else {
+        result = parcBuffer_Allocate(bufferPool->bufferSize);
+        parcObject_SetDescriptor(result, bufferPool->descriptor);
     }
+    __atomic_store_n(&cache->totalInstances, cache->totalInstances + 1, __ATOMIC_RELAXED);
 
     return result;
 }
@@ -212,16 +572,22 @@ parcBufferPool_Drain(PARCBufferPool *bufferPool)
 {
     size_t result = 0;
 
-    parcObject_Synchronize(bufferPool->freeList) {
-        size_t freeListSize = parcLinkedList_Size(bufferPool->freeList);
-        if (freeListSize > bufferPool->limit) {
-            result = freeListSize - bufferPool->limit;
-            for (size_t i = bufferPool->limit; i < freeListSize; i++) {
-                PARCObject *object = parcLinkedList_RemoveLast(bufferPool->freeList);
-                parcObject_SetDescriptor(object, &PARCBuffer_Descriptor);
-                parcObject_Release(&object);
-            }
+    _PARCBufferPoolThreadCache *cache = _parcBufferPool_ThreadCache(bufferPool);
+
+    // Buffers cached by other threads are beyond reach, those threads drain them when they next see the new epoch.
+    cache->drainEpoch = __atomic_add_fetch(&bufferPool->drainEpoch, 1, __ATOMIC_RELAXED);
+
+    size_t poolSize = __atomic_load_n(&bufferPool->poolSize, __ATOMIC_RELAXED);
+    if (poolSize > bufferPool->limit) {
+        size_t excess = poolSize - bufferPool->limit;
+
+        _PARCBufferPoolMagazine *magazine;
+        while (result < excess && (magazine = _parcBufferPool_DepotPop(bufferPool, &bufferPool->fullMagazines)) != NULL) {
+            result += _parcBufferPool_FreeMagazineBuffers(bufferPool, magazine, excess - result);
+            _parcBufferPool_DepotReturn(bufferPool, magazine);
         }
+
+        result += _parcBufferPool_ThreadCacheDrain(bufferPool, cache);
     }
 
     return result;
@@ -250,7 +616,7 @@ parcBufferPool_GetLimit(const PARCBufferPool *bufferPool)
 size_t
 parcBufferPool_GetCurrentPoolSize(const PARCBufferPool *bufferPool)
 {
-    size_t result = parcLinkedList_Size(bufferPool->freeList);
+    size_t result = __atomic_load_n(&bufferPool->poolSize, __ATOMIC_RELAXED);
 
     return result;
 }
@@ -258,17 +624,31 @@ parcBufferPool_GetCurrentPoolSize(const PARCBufferPool *bufferPool)
 size_t
 parcBufferPool_GetLargestPoolSize(const PARCBufferPool *bufferPool)
 {
-    return bufferPool->largestPoolSize;
+    return __atomic_load_n(&bufferPool->largestPoolSize, __ATOMIC_RELAXED);
 }
 
 size_t
 parcBufferPool_GetTotalInstances(const PARCBufferPool *bufferPool)
 {
-    return bufferPool->totalInstances;
+    pthread_mutex_lock(&_parcBufferPool_RegistryLock);
+    size_t result = bufferPool->totalInstances;
+    for (_PARCBufferPoolThreadCache *cache = bufferPool->threadCaches; cache != NULL; cache = cache->nextInPool) {
+        result += __atomic_load_n(&cache->totalInstances, __ATOMIC_RELAXED);
+    }
+    pthread_mutex_unlock(&_parcBufferPool_RegistryLock);
+
+    return result;
 }
 
 size_t
 parcBufferPool_GetCacheHits(const PARCBufferPool *bufferPool)
 {
-    return bufferPool->cacheHits;
+    pthread_mutex_lock(&_parcBufferPool_RegistryLock);
+    size_t result = bufferPool->cacheHits;
+    for (_PARCBufferPoolThreadCache *cache = bufferPool->threadCaches; cache != NULL; cache = cache->nextInPool) {
+        result += __atomic_load_n(&cache->cacheHits, __ATOMIC_RELAXED);
+    }
+    pthread_mutex_unlock(&_parcBufferPool_RegistryLock);
+
+    return result;
 }
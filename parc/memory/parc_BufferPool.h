@@ -61,6 +61,10 @@
  * into the pool when the `PARCBuffer_Release` function is called.
  * The pool has a maxmimum number of instances that it will cache.
  *
+ * Each thread caches a few released instances for itself, so getting and releasing instances
+ * does not contend with other threads in the common case.
+ * All instances must be released before the pool itself is released.
+ *
  * @author Glenn Scott, Palo Alto Research Center (PARC)
  * @copyright 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
  */
@@ -363,9 +367,15 @@ size_t parcBufferPool_GetLargestPoolSize(const PARCBufferPool *bufferPool);
  * The number of PARCBuffer instances can exceed the PARCBufferPool's limit if `parcBufferPool_SetLimit` is used to set the limit
  * to less than Pool's current pool size.
  *
+ * Instances cached by the calling thread, or returned to the pool by threads that have exited, are drained at once
+ * and counted in the result.
+ * Instances cached by other running threads are not counted.  Each of those threads drains its own excess instances
+ * the next time it gets an instance from, or returns one to, the pool.
+ * A thread that never uses the pool again keeps its instances until it exits or the pool is released.
+ *
  * @param [in] bufferPool A pointer to a valid PARCBufferPool instance.
  *
- * @return the largest number of buffers released from the Pool's cache.
+ * @return the number of buffers released from the Pool's cache by the calling thread.
  *
  * Example:
  * @code
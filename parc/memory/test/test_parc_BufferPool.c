@@ -58,10 +58,14 @@
  */
 #include "../parc_BufferPool.c"
 
+#include <pthread.h>
+#include <sys/time.h>
+
 #include <LongBow/testing.h>
 #include <LongBow/debugging.h>
 #include <parc/algol/parc_Memory.h>
 #include <parc/algol/parc_SafeMemory.h>
+#include <parc/algol/parc_StdlibMemory.h>
 #include <parc/algol/parc_DisplayIndented.h>
 
 #include <parc/testing/parc_MemoryTesting.h>
@@ -75,6 +79,7 @@ LONGBOW_TEST_RUNNER(parc_BufferPool)
     LONGBOW_RUN_TEST_FIXTURE(CreateAcquireRelease);
     LONGBOW_RUN_TEST_FIXTURE(Object);
     LONGBOW_RUN_TEST_FIXTURE(Specialization);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
 }
 
 // The Test Runner calls this function once before any Test Fixtures are run.
@@ -178,6 +183,11 @@ LONGBOW_TEST_FIXTURE(Specialization)
     LONGBOW_RUN_TEST_CASE(Specialization, parcBufferPool_SetLimit_Increasing);
     LONGBOW_RUN_TEST_CASE(Specialization, parcBufferPool_SetLimit_Decreasing);
     LONGBOW_RUN_TEST_CASE(Specialization, parcBufferPool_Drain);
+    LONGBOW_RUN_TEST_CASE(Specialization, parcBufferPool_Drain_Depot);
+    LONGBOW_RUN_TEST_CASE(Specialization, parcBufferPool_Drain_OtherThread);
+    LONGBOW_RUN_TEST_CASE(Specialization, parcBufferPool_GetInstance_Reuse);
+    LONGBOW_RUN_TEST_CASE(Specialization, parcBufferPool_MultipleThreads);
+    LONGBOW_RUN_TEST_CASE(Specialization, parcBufferPool_Release_ThreadCached);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Specialization)
@@ -401,6 +411,282 @@ LONGBOW_TEST_CASE(Specialization, parcBufferPool_Drain)
     parcBufferPool_Release(&pool);
 }
 
+LONGBOW_TEST_CASE(Specialization, parcBufferPool_Drain_Depot)
+{
+    size_t oldLimit = 100;
+    size_t newLimit = 10;
+
+    PARCBufferPool *pool = parcBufferPool_Create(oldLimit, 10);
+
+    // Enough buffers to fill several magazines, so some of them are returned to the depot.
+    PARCBuffer *buffers[100];
+    for (size_t i = 0; i < oldLimit; i++) {
+        buffers[i] = parcBufferPool_GetInstance(pool);
+    }
+    for (size_t i = 0; i < oldLimit; i++) {
+        parcBuffer_Release(&buffers[i]);
+    }
+
+    size_t poolSize = parcBufferPool_GetCurrentPoolSize(pool);
+    assertTrue(poolSize == oldLimit, "Expected the poolSize to be %zu, actual %zu", oldLimit, poolSize);
+
+    parcBufferPool_SetLimit(pool, newLimit);
+    size_t drained = parcBufferPool_Drain(pool);
+    assertTrue(drained == oldLimit - newLimit, "Expected the drained to be %zu, actual %zu", oldLimit - newLimit, drained);
+
+    poolSize = parcBufferPool_GetCurrentPoolSize(pool);
+    assertTrue(poolSize == newLimit, "Expected the poolSize to be %zu, actual %zu", newLimit, poolSize);
+
+    drained = parcBufferPool_Drain(pool);
+    assertTrue(drained == 0, "Expected nothing more to drain, actual %zu", drained);
+
+    parcBufferPool_Release(&pool);
+}
+
+LONGBOW_TEST_CASE(Specialization, parcBufferPool_GetInstance_Reuse)
+{
+    PARCBufferPool *pool = parcBufferPool_Create(3, 10);
+
+    PARCBuffer *buffer = parcBufferPool_GetInstance(pool);
+    PARCBuffer *original = buffer;
+    parcBuffer_Release(&buffer);
+
+    buffer = parcBufferPool_GetInstance(pool);
+    assertTrue(buffer == original, "Expected the cached instance %p, actual %p", (void *) original, (void *) buffer);
+    assertTrue(parcObject_GetReferenceCount(buffer) == 1,
+               "Expected a reference count of 1, actual %" PRIu64, parcObject_GetReferenceCount(buffer));
+    parcBuffer_AssertValid(buffer);
+    parcBuffer_Release(&buffer);
+
+    parcBufferPool_Release(&pool);
+}
+
+#define POOL_THREADS 4
+#define POOL_ITERATIONS 10000
+
+typedef struct {
+    PARCBufferPool *pool;
+    pthread_barrier_t *barrier;
+} _PoolThread;
+
+static void *
+_poolThread(void *arg)
+{
+    _PoolThread *poolThread = arg;
+
+    PARCBuffer *buffers[20];
+    for (int iteration = 0; iteration < POOL_ITERATIONS; iteration++) {
+        int count = 1 + iteration % 20;
+        for (int i = 0; i < count; i++) {
+            buffers[i] = parcBufferPool_GetInstance(poolThread->pool);
+            parcBuffer_PutUint8(buffers[i], 1);
+            parcBuffer_Flip(buffers[i]);
+        }
+        for (int i = 0; i < count; i++) {
+            parcBuffer_Release(&buffers[i]);
+        }
+    }
+
+    if (poolThread->barrier != NULL) {
+        pthread_barrier_wait(poolThread->barrier);
+        pthread_barrier_wait(poolThread->barrier);
+    }
+
+    return NULL;
+}
+
+LONGBOW_TEST_CASE(Specialization, parcBufferPool_MultipleThreads)
+{
+    size_t limit = 50;
+    PARCBufferPool *pool = parcBufferPool_Create(limit, 10);
+
+    pthread_t threads[POOL_THREADS];
+    _PoolThread poolThread = { .pool = pool, .barrier = NULL };
+    for (int i = 0; i < POOL_THREADS; i++) {
+        pthread_create(&threads[i], NULL, _poolThread, &poolThread);
+    }
+    for (int i = 0; i < POOL_THREADS; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    size_t totalInstances = parcBufferPool_GetTotalInstances(pool);
+    size_t expected = 0;
+    for (int iteration = 0; iteration < POOL_ITERATIONS; iteration++) {
+        expected += 1 + iteration % 20;
+    }
+    expected *= POOL_THREADS;
+    assertTrue(totalInstances == expected, "Expected the totalInstances to be %zu, actual %zu", expected, totalInstances);
+
+    size_t cacheHits = parcBufferPool_GetCacheHits(pool);
+    assertTrue(cacheHits > 0 && cacheHits < totalInstances, "Expected some cache hits, actual %zu of %zu", cacheHits, totalInstances);
+
+    size_t poolSize = parcBufferPool_GetCurrentPoolSize(pool);
+    size_t largestPoolSize = parcBufferPool_GetLargestPoolSize(pool);
+    assertTrue(poolSize <= limit, "Expected the poolSize to be at most %zu, actual %zu", limit, poolSize);
+    assertTrue(largestPoolSize <= limit, "Expected the largestPoolSize to be at most %zu, actual %zu", limit, largestPoolSize);
+
+    // The exited threads returned their cached buffers to the pool, where this thread can use them.
+    PARCBuffer *buffers[50];
+    for (size_t i = 0; i < poolSize; i++) {
+        buffers[i] = parcBufferPool_GetInstance(pool);
+    }
+    size_t hits = parcBufferPool_GetCacheHits(pool) - cacheHits;
+    assertTrue(hits == poolSize, "Expected %zu cache hits, actual %zu", poolSize, hits);
+    assertTrue(parcBufferPool_GetCurrentPoolSize(pool) == 0,
+               "Expected an empty pool, actual %zu", parcBufferPool_GetCurrentPoolSize(pool));
+    for (size_t i = 0; i < poolSize; i++) {
+        parcBuffer_Release(&buffers[i]);
+    }
+
+    parcBufferPool_Release(&pool);
+}
+
+LONGBOW_TEST_CASE(Specialization, parcBufferPool_Release_ThreadCached)
+{
+    // Release the pool while another thread still has buffers cached for it.
+    PARCBufferPool *pool = parcBufferPool_Create(50, 10);
+
+    pthread_barrier_t barrier;
+    pthread_barrier_init(&barrier, NULL, 2);
+
+    pthread_t thread;
+    _PoolThread poolThread = { .pool = pool, .barrier = &barrier };
+    pthread_create(&thread, NULL, _poolThread, &poolThread);
+
+    pthread_barrier_wait(&barrier);
+    size_t poolSize = parcBufferPool_GetCurrentPoolSize(pool);
+    assertTrue(poolSize > 0, "Expected the other thread to have cached buffers");
+    parcBufferPool_Release(&pool);
+    pthread_barrier_wait(&barrier);
+
+    pthread_join(thread, NULL);
+    pthread_barrier_destroy(&barrier);
+}
+
+static void *
+_drainThread(void *arg)
+{
+    _PoolThread *poolThread = arg;
+
+    PARCBuffer *buffers[20];
+    for (int i = 0; i < 20; i++) {
+        buffers[i] = parcBufferPool_GetInstance(poolThread->pool);
+    }
+    for (int i = 0; i < 20; i++) {
+        parcBuffer_Release(&buffers[i]);
+    }
+
+    pthread_barrier_wait(poolThread->barrier);
+    pthread_barrier_wait(poolThread->barrier);
+
+    // The first use of the pool after the drain frees this thread's excess buffers.
+    PARCBuffer *buffer = parcBufferPool_GetInstance(poolThread->pool);
+    parcBuffer_Release(&buffer);
+
+    pthread_barrier_wait(poolThread->barrier);
+    pthread_barrier_wait(poolThread->barrier);
+
+    return NULL;
+}
+
+LONGBOW_TEST_CASE(Specialization, parcBufferPool_Drain_OtherThread)
+{
+    size_t newLimit = 5;
+    PARCBufferPool *pool = parcBufferPool_Create(50, 10);
+
+    pthread_barrier_t barrier;
+    pthread_barrier_init(&barrier, NULL, 2);
+
+    pthread_t thread;
+    _PoolThread poolThread = { .pool = pool, .barrier = &barrier };
+    pthread_create(&thread, NULL, _drainThread, &poolThread);
+
+    pthread_barrier_wait(&barrier);
+    size_t poolSize = parcBufferPool_GetCurrentPoolSize(pool);
+    assertTrue(poolSize == 20, "Expected the other thread to have cached 20 buffers, actual %zu", poolSize);
+
+    parcBufferPool_SetLimit(pool, newLimit);
+    size_t drained = parcBufferPool_Drain(pool);
+    assertTrue(drained == 0, "Expected the buffers cached by the other thread to be out of reach, actual %zu", drained);
+    poolSize = parcBufferPool_GetCurrentPoolSize(pool);
+    assertTrue(poolSize == 20, "Expected the poolSize to be unchanged until the other thread uses the pool, actual %zu", poolSize);
+    pthread_barrier_wait(&barrier);
+
+    pthread_barrier_wait(&barrier);
+    poolSize = parcBufferPool_GetCurrentPoolSize(pool);
+    assertTrue(poolSize == newLimit, "Expected the other thread to drain the pool to %zu, actual %zu", newLimit, poolSize);
+    pthread_barrier_wait(&barrier);
+
+    pthread_join(thread, NULL);
+    pthread_barrier_destroy(&barrier);
+    parcBufferPool_Release(&pool);
+}
+
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, parcBufferPool_GetInstance_Throughput);
+    LONGBOW_RUN_TEST_CASE(Performance, parcBufferPool_GetInstance_Threads_Throughput);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    parcMemory_SetInterface(&PARCStdlibMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+static double
+_performance_Elapsed(const struct timeval *start)
+{
+    struct timeval end, elapsed;
+    gettimeofday(&end, NULL);
+    timersub(&end, start, &elapsed);
+    return elapsed.tv_sec + elapsed.tv_usec / 1000000.0;
+}
+
+static void
+_performance_Run(int threadCount)
+{
+    PARCBufferPool *pool = parcBufferPool_Create(1000, 64);
+
+    struct timeval start;
+    gettimeofday(&start, NULL);
+
+    pthread_t threads[POOL_THREADS];
+    _PoolThread poolThread = { .pool = pool, .barrier = NULL };
+    for (int i = 0; i < threadCount; i++) {
+        pthread_create(&threads[i], NULL, _poolThread, &poolThread);
+    }
+    for (int i = 0; i < threadCount; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    double seconds = _performance_Elapsed(&start);
+    size_t totalInstances = parcBufferPool_GetTotalInstances(pool);
+    printf("parcBufferPool_GetInstance: %zu instances, %d threads in %.6f seconds (%.0f/second), %zu cache hits\n",
+           totalInstances, threadCount, seconds, totalInstances / seconds, parcBufferPool_GetCacheHits(pool));
+
+    parcBufferPool_Release(&pool);
+}
+
+LONGBOW_TEST_CASE(Performance, parcBufferPool_GetInstance_Throughput)
+{
+    for (int i = 0; i < 10; i++) {
+        _performance_Run(1);
+    }
+}
+
+LONGBOW_TEST_CASE(Performance, parcBufferPool_GetInstance_Threads_Throughput)
+{
+    for (int i = 0; i < 10; i++) {
+        _performance_Run(POOL_THREADS);
+    }
+}
+
 int
 main(int argc, char *argv[argc])
 {
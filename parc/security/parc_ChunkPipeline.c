@@ -0,0 +1,266 @@
+/*
+ * Copyright (c) 2015, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * Each chunk becomes a job, run as a `PARCFutureTask` on the pool.
+ * The calling thread keeps the tasks in a ring of `maxInFlight` slots, in chunk order.
+ * It fills free slots from the iterator, then waits for the oldest task, delivers its result and frees its slot,
+ * so results are delivered in order however the pool schedules the tasks.
+ *
+ * @author Glenn Scott, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include <config.h>
+
+#include <stdio.h>
+
+#include <LongBow/runtime.h>
+
+#include <parc/algol/parc_Object.h>
+#include <parc/algol/parc_Memory.h>
+
+#include <parc/concurrent/parc_FutureTask.h>
+#include <parc/security/parc_CryptoHasher.h>
+#include <parc/security/parc_ChunkPipeline.h>
+
+struct parc_chunk_pipeline {
+    PARCThreadPool *pool;
+    PARCCryptoHashType hashType;
+    PARCSigner *signer;
+    size_t maxInFlight;
+};
+
+typedef struct {
+    PARCBuffer *chunk;
+    PARCCryptoHashType hashType;
+    PARCSigner *signer;
+
+    PARCCryptoHash *hash;
+    PARCSignature *signature;
+} _PARCChunkPipelineJob;
+
+static bool
+_parcChunkPipelineJob_Destructor(_PARCChunkPipelineJob **jobPtr)
+{
+    _PARCChunkPipelineJob *job = *jobPtr;
+
+    parcBuffer_Release(&job->chunk);
+    if (job->signer != NULL) {
+        parcSigner_Release(&job->signer);
+    }
+    if (job->hash != NULL) {
+        parcCryptoHash_Release(&job->hash);
+    }
+    if (job->signature != NULL) {
+        parcSignature_Release(&job->signature);
+    }
+    return true;
+}
+
+parcObject_Override(_PARCChunkPipelineJob, PARCObject,
+                    .destructor = (PARCObjectDestructor *) _parcChunkPipelineJob_Destructor);
+
+static _PARCChunkPipelineJob *
+_parcChunkPipelineJob_Create(const PARCChunkPipeline *pipeline, PARCBuffer *chunk)
+{
+    _PARCChunkPipelineJob *result = parcObject_CreateInstance(_PARCChunkPipelineJob);
+    assertNotNull(result, "parcObject_CreateInstance returned NULL");
+
+    result->chunk = parcBuffer_Acquire(chunk);
+    result->hashType = pipeline->hashType;
+    result->signer = (pipeline->signer != NULL) ? parcSigner_Acquire(pipeline->signer) : NULL;
+    result->hash = NULL;
+    result->signature = NULL;
+
+    return result;
+}
+
+/*
+ * Digest the chunk, and sign the digest, as parcSigner_SignBuffer does.
+ */
+static void *
+_parcChunkPipelineJob_Run(PARCFutureTask *task, void *parameter)
+{
+    _PARCChunkPipelineJob *job = parameter;
+
+    PARCCryptoHasher *hasher = parcCryptoHasher_Create(job->hashType);
+    parcCryptoHasher_Init(hasher);
+    parcCryptoHasher_UpdateBuffer(hasher, job->chunk);
+    job->hash = parcCryptoHasher_Finalize(hasher);
+    parcCryptoHasher_Release(&hasher);
+
+    if (job->signer != NULL) {
+        job->signature = parcSigner_SignDigest(job->signer, job->hash);
+    }
+
+    return job;
+}
+
+static void
+_parcChunkPipeline_Destroy(PARCChunkPipeline **pipelinePtr)
+{
+    PARCChunkPipeline *pipeline = *pipelinePtr;
+
+    parcThreadPool_Release(&pipeline->pool);
+    if (pipeline->signer != NULL) {
+        parcSigner_Release(&pipeline->signer);
+    }
+}
+
+parcObject_ExtendPARCObject(PARCChunkPipeline, _parcChunkPipeline_Destroy, NULL, NULL, NULL, NULL, NULL, NULL);
+parcObject_ImplementAcquire(parcChunkPipeline, PARCChunkPipeline);
+parcObject_ImplementRelease(parcChunkPipeline, PARCChunkPipeline);
+
+PARCChunkPipeline *
+parcChunkPipeline_Create(PARCThreadPool *pool, PARCCryptoHashType hashType, PARCSigner *signer, size_t maxInFlight)
+{
+    assertNotNull(pool, "The PARCThreadPool must not be NULL");
+    trapIllegalValueIf(signer != NULL && parcSigner_GetCryptoHashType(signer) != hashType,
+                       "The signer uses %s, not %s",
+                       parcCryptoHashType_ToString(parcSigner_GetCryptoHashType(signer)), parcCryptoHashType_ToString(hashType));
+
+    PARCChunkPipeline *result = parcObject_CreateInstance(PARCChunkPipeline);
+    if (result != NULL) {
+        result->pool = parcThreadPool_Acquire(pool);
+        result->hashType = hashType;
+        result->signer = (signer != NULL) ? parcSigner_Acquire(signer) : NULL;
+        result->maxInFlight = (maxInFlight > 0) ? maxInFlight : 4 * (size_t) parcThreadPool_GetCorePoolSize(pool);
+        if (result->maxInFlight == 0) {
+            result->maxInFlight = 1;
+        }
+    }
+
+    return result;
+}
+
+size_t
+parcChunkPipeline_GetMaxInFlight(const PARCChunkPipeline *pipeline)
+{
+    return pipeline->maxInFlight;
+}
+
+/*
+ * Wait for the task to complete and return its job.
+ */
+static _PARCChunkPipelineJob *
+_parcChunkPipeline_Await(PARCFutureTask *task)
+{
+    while (!parcFutureTask_IsDone(task)) {
+        parcFutureTask_Get(task, PARCTimeout_Never);
+    }
+    return parcFutureTask_Get(task, PARCTimeout_Immediate).value;
+}
+
+size_t
+parcChunkPipeline_ProcessIterator(PARCChunkPipeline *pipeline, PARCIterator *chunks,
+                                  PARCChunkPipelineCallback *callback, void *context)
+{
+    PARCFutureTask **inFlight = parcMemory_AllocateAndClear(pipeline->maxInFlight * sizeof(PARCFutureTask *));
+    assertNotNull(inFlight, "Cannot allocate %zu in-flight slots", pipeline->maxInFlight);
+
+    size_t submitted = 0;
+    size_t delivered = 0;
+    bool proceed = true;
+
+    while (proceed) {
+        while (submitted - delivered < pipeline->maxInFlight && parcIterator_HasNext(chunks)) {
+            PARCBuffer *chunk = parcIterator_Next(chunks);
+            _PARCChunkPipelineJob *job = _parcChunkPipelineJob_Create(pipeline, chunk);
+            PARCFutureTask *task = parcFutureTask_Create(_parcChunkPipelineJob_Run, job);
+            parcObject_Release((PARCObject **) &job);
+            parcBuffer_Release(&chunk);
+
+            // The first chunk is processed here, so that anything the signer initialises lazily
+            // is in place before the signer is shared between threads.
+            if (submitted == 0 || !parcThreadPool_Execute(pipeline->pool, task)) {
+                parcFutureTask_Run(task);
+            }
+            inFlight[submitted % pipeline->maxInFlight] = task;
+            submitted++;
+        }
+
+        if (delivered == submitted) {
+            break;
+        }
+
+        PARCFutureTask **slot = &inFlight[delivered % pipeline->maxInFlight];
+        _PARCChunkPipelineJob *job = _parcChunkPipeline_Await(*slot);
+        proceed = callback(context, delivered, job->chunk, job->hash, job->signature);
+        parcFutureTask_Release(slot);
+        delivered++;
+    }
+
+    size_t result = delivered;
+
+    // The callback stopped early: wait for the chunks still being processed.
+    while (delivered < submitted) {
+        PARCFutureTask **slot = &inFlight[delivered % pipeline->maxInFlight];
+        _parcChunkPipeline_Await(*slot);
+        parcFutureTask_Release(slot);
+        delivered++;
+    }
+
+    parcMemory_Deallocate((void **) &inFlight);
+    return result;
+}
+
+size_t
+parcChunkPipeline_Process(PARCChunkPipeline *pipeline, const PARCChunker *chunker,
+                          PARCChunkPipelineCallback *callback, void *context)
+{
+    PARCIterator *chunks = parcChunker_ForwardIterator(chunker);
+    size_t result = parcChunkPipeline_ProcessIterator(pipeline, chunks, callback, context);
+    parcIterator_Release(&chunks);
+    return result;
+}
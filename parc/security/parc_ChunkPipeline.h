@@ -0,0 +1,247 @@
+/*
+ * Copyright (c) 2015, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @file parc_ChunkPipeline.h
+ * @ingroup security
+ * @brief Digest, and optionally sign, the chunks of a `PARCChunker` in parallel.
+ *
+ * A `PARCChunkPipeline` takes the chunks produced by a `PARCChunker` and computes the `PARCCryptoHash`
+ * of each one, and its `PARCSignature` if the pipeline has a `PARCSigner`, as tasks on a `PARCThreadPool`.
+ * The results are delivered to a callback on the calling thread in chunk order,
+ * so the caller sees the same sequence it would computing each chunk in turn.
+ *
+ * At most a fixed number of chunks are in flight at once.
+ * The chunker is only advanced when a slot is free, so a large object is never read
+ * further ahead of the callback than that number of chunks.
+ *
+ * @code
+ * {
+ *     PARCThreadPool *pool = parcThreadPool_Create(4);
+ *     PARCChunkPipeline *pipeline = parcChunkPipeline_Create(pool, PARCCryptoHashType_SHA256, signer, 0);
+ *
+ *     parcChunkPipeline_Process(pipeline, chunker, publishChunk, context);
+ *
+ *     parcChunkPipeline_Release(&pipeline);
+ *     parcThreadPool_ShutdownNow(pool);
+ *     parcThreadPool_Release(&pool);
+ * }
+ * @endcode
+ *
+ * @author Glenn Scott, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#ifndef libparc_parc_ChunkPipeline_h
+#define libparc_parc_ChunkPipeline_h
+
+#include <stdbool.h>
+
+#include <parc/algol/parc_Buffer.h>
+#include <parc/algol/parc_Chunker.h>
+#include <parc/algol/parc_Iterator.h>
+#include <parc/concurrent/parc_ThreadPool.h>
+#include <parc/security/parc_CryptoHash.h>
+#include <parc/security/parc_CryptoHashType.h>
+#include <parc/security/parc_Signature.h>
+#include <parc/security/parc_Signer.h>
+
+struct parc_chunk_pipeline;
+typedef struct parc_chunk_pipeline PARCChunkPipeline;
+
+/**
+ * The function called with the result for each chunk, in chunk order, on the thread that invoked the pipeline.
+ *
+ * The callback does not own @p chunk, @p hash or @p signature, and must acquire a reference to any it keeps.
+ *
+ * @param [in] context The context given to {@link parcChunkPipeline_Process}.
+ * @param [in] chunkNumber The position of the chunk in the sequence, starting at 0.
+ * @param [in] chunk The chunk.
+ * @param [in] hash The digest of the chunk.
+ * @param [in] signature The signature of @p hash, or NULL if the pipeline has no signer.
+ *
+ * @return true To continue with the next chunk.
+ * @return false To stop processing.
+ */
+typedef bool (PARCChunkPipelineCallback)(void *context, size_t chunkNumber, PARCBuffer *chunk,
+                                         PARCCryptoHash *hash, PARCSignature *signature);
+
+/**
+ * Create a `PARCChunkPipeline` that digests chunks with @p hashType, and signs them with @p signer if it is not NULL.
+ *
+ * The @p signer is called from several threads at once, so it must be safe to use concurrently.
+ * The signers in this library are, once they have produced a first signature,
+ * and the pipeline always processes the first chunk on the calling thread to ensure that.
+ *
+ * @param [in] pool The `PARCThreadPool` on which chunks are processed.
+ * @param [in] hashType The digest algorithm.
+ * @param [in] signer A `PARCSigner`, which must use @p hashType, or NULL to only compute digests.
+ * @param [in] maxInFlight The most chunks in flight at once, or 0 for four times the pool's core size.
+ *
+ * @return A new `PARCChunkPipeline` that must be released via {@link parcChunkPipeline_Release}.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCChunkPipeline *pipeline = parcChunkPipeline_Create(pool, PARCCryptoHashType_SHA256, NULL, 64);
+ * }
+ * @endcode
+ */
+PARCChunkPipeline *parcChunkPipeline_Create(PARCThreadPool *pool, PARCCryptoHashType hashType, PARCSigner *signer, size_t maxInFlight);
+
+/**
+ * Increase the number of references to a `PARCChunkPipeline`.
+ *
+ * @param [in] pipeline A pointer to a valid `PARCChunkPipeline` instance.
+ *
+ * @return The value of @p pipeline.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCChunkPipeline *reference = parcChunkPipeline_Acquire(pipeline);
+ * }
+ * @endcode
+ */
+PARCChunkPipeline *parcChunkPipeline_Acquire(const PARCChunkPipeline *pipeline);
+
+/**
+ * Release a previously acquired reference to the specified instance,
+ * decrementing the reference count for the instance.
+ *
+ * The pointer to the instance is set to NULL as a side-effect of this function.
+ *
+ * @param [in,out] pipelinePtr A pointer to a pointer to the instance to release.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcChunkPipeline_Release(&pipeline);
+ * }
+ * @endcode
+ */
+void parcChunkPipeline_Release(PARCChunkPipeline **pipelinePtr);
+
+/**
+ * Get the most chunks a `PARCChunkPipeline` has in flight at once.
+ *
+ * @param [in] pipeline A pointer to a valid `PARCChunkPipeline` instance.
+ *
+ * @return The most chunks in flight at once.
+ *
+ * Example:
+ * @code
+ * {
+ *     size_t window = parcChunkPipeline_GetMaxInFlight(pipeline);
+ * }
+ * @endcode
+ */
+size_t parcChunkPipeline_GetMaxInFlight(const PARCChunkPipeline *pipeline);
+
+/**
+ * Digest, and sign, each chunk of @p chunker in its forward order, calling @p callback with each result in turn.
+ *
+ * The function returns once every chunk has been delivered, or @p callback has returned false
+ * and the chunks still in flight have completed.
+ *
+ * @param [in] pipeline A pointer to a valid `PARCChunkPipeline` instance.
+ * @param [in] chunker The `PARCChunker` providing the chunks.
+ * @param [in] callback The function called with each result.
+ * @param [in] context A value passed to @p callback.
+ *
+ * @return The number of times @p callback was called.
+ *
+ * Example:
+ * @code
+ * {
+ *     static bool
+ *     publishChunk(void *context, size_t chunkNumber, PARCBuffer *chunk, PARCCryptoHash *hash, PARCSignature *signature)
+ *     {
+ *         ...
+ *         return true;
+ *     }
+ *
+ *     size_t chunks = parcChunkPipeline_Process(pipeline, chunker, publishChunk, NULL);
+ * }
+ * @endcode
+ *
+ * @see parcChunkPipeline_ProcessIterator
+ */
+size_t parcChunkPipeline_Process(PARCChunkPipeline *pipeline, const PARCChunker *chunker,
+                                 PARCChunkPipelineCallback *callback, void *context);
+
+/**
+ * Digest, and sign, each `PARCBuffer` produced by @p chunks, calling @p callback with each result in turn.
+ *
+ * This accepts any iterator of `PARCBuffer` instances that transfers a reference to each to the caller of `parcIterator_Next`,
+ * such as those of `parcChunker_ReverseIterator`, `parcBufferChunker_ForwardIterator` and `parcFileChunker_ReverseIterator`.
+ *
+ * @param [in] pipeline A pointer to a valid `PARCChunkPipeline` instance.
+ * @param [in] chunks The `PARCIterator` providing the chunks.
+ * @param [in] callback The function called with each result.
+ * @param [in] context A value passed to @p callback.
+ *
+ * @return The number of times @p callback was called.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCIterator *chunks = parcChunker_ReverseIterator(chunker);
+ *     size_t count = parcChunkPipeline_ProcessIterator(pipeline, chunks, publishChunk, NULL);
+ *     parcIterator_Release(&chunks);
+ * }
+ * @endcode
+ */
+size_t parcChunkPipeline_ProcessIterator(PARCChunkPipeline *pipeline, PARCIterator *chunks,
+                                         PARCChunkPipelineCallback *callback, void *context);
+#endif // libparc_parc_ChunkPipeline_h
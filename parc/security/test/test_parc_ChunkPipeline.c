@@ -0,0 +1,423 @@
+/*
+ * Copyright (c) 2014, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @author Glenn Scott, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include "../parc_ChunkPipeline.c"
+
+#include <sys/time.h>
+
+#include <LongBow/unit-test.h>
+
+#include <parc/algol/parc_SafeMemory.h>
+#include <parc/algol/parc_BufferChunker.h>
+#include <parc/security/parc_Security.h>
+#include <parc/security/parc_Signer.h>
+#include <parc/testing/parc_MemoryTesting.h>
+#include <parc/testing/parc_ObjectTesting.h>
+
+LONGBOW_TEST_RUNNER(parc_ChunkPipeline)
+{
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
+}
+
+// The Test Runner calls this function once before any Test Fixtures are run.
+LONGBOW_TEST_RUNNER_SETUP(parc_ChunkPipeline)
+{
+    parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// The Test Runner calls this function once after all the Test Fixtures are run.
+LONGBOW_TEST_RUNNER_TEARDOWN(parc_ChunkPipeline)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, parcChunkPipeline_AcquireRelease);
+    LONGBOW_RUN_TEST_CASE(Global, parcChunkPipeline_Create_SignerHashTypeMismatch);
+    LONGBOW_RUN_TEST_CASE(Global, parcChunkPipeline_GetMaxInFlight);
+    LONGBOW_RUN_TEST_CASE(Global, parcChunkPipeline_Process);
+    LONGBOW_RUN_TEST_CASE(Global, parcChunkPipeline_Process_OneInFlight);
+    LONGBOW_RUN_TEST_CASE(Global, parcChunkPipeline_Process_Signed);
+    LONGBOW_RUN_TEST_CASE(Global, parcChunkPipeline_Process_Stop);
+    LONGBOW_RUN_TEST_CASE(Global, parcChunkPipeline_ProcessIterator_Reverse);
+}
+
+typedef struct {
+    PARCThreadPool *pool;
+    PARCBuffer *data;
+    PARCChunker *chunker;
+} _TestData;
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    parcSecurity_Init();
+
+    _TestData *data = parcMemory_Allocate(sizeof(_TestData));
+    data->pool = parcThreadPool_Create(4);
+    data->data = parcBuffer_Allocate(10000);
+    for (size_t i = 0; i < 10000; i++) {
+        parcBuffer_PutUint8(data->data, (uint8_t) (i * 13));
+    }
+    parcBuffer_Flip(data->data);
+
+    PARCBufferChunker *bufferChunker = parcBufferChunker_Create(data->data, 128);
+    data->chunker = parcChunker_Create(bufferChunker, PARCBufferChunkerAsChunker);
+    parcBufferChunker_Release(&bufferChunker);
+
+    longBowTestCase_SetClipBoardData(testCase, data);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    _TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    parcChunker_Release(&data->chunker);
+    parcBuffer_Release(&data->data);
+    parcThreadPool_ShutdownNow(data->pool);
+    parcThreadPool_Release(&data->pool);
+    parcMemory_Deallocate(&data);
+
+    parcSecurity_Fini();
+    if (!parcMemoryTesting_ExpectedOutstanding(0, "%s leaked memory.", longBowTestCase_GetFullName(testCase))) {
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+/*
+ * A stand-in signer whose signature is the digest XOR a fixed key, so the tests do not depend on a key store.
+ */
+static PARCCryptoHashType _mockSignerHashType;
+
+static PARCSignature *
+_mockSignDigest(void *instance, const PARCCryptoHash *digest)
+{
+    PARCBuffer *key = instance;
+    PARCBuffer *digestBits = parcCryptoHash_GetDigest(digest);
+
+    size_t length = parcBuffer_Remaining(digestBits);
+    PARCBuffer *bits = parcBuffer_Allocate(length);
+    for (size_t i = 0; i < length; i++) {
+        uint8_t k = parcBuffer_GetAtIndex(key, i % parcBuffer_Remaining(key));
+        parcBuffer_PutUint8(bits, parcBuffer_GetAtIndex(digestBits, i) ^ k);
+    }
+    parcBuffer_Flip(bits);
+
+    PARCSignature *result = parcSignature_Create(PARCSigningAlgorithm_HMAC, parcCryptoHash_GetDigestType(digest), bits);
+    parcBuffer_Release(&bits);
+    return result;
+}
+
+static PARCCryptoHashType
+_mockGetCryptoHashType(void *instance)
+{
+    return _mockSignerHashType;
+}
+
+static PARCSigningAlgorithm
+_mockGetSigningAlgorithm(void *instance)
+{
+    return PARCSigningAlgorithm_HMAC;
+}
+
+static PARCSigningInterface *_mockSigner = &(PARCSigningInterface) {
+    .SignDigest          = _mockSignDigest,
+    .GetCryptoHashType   = _mockGetCryptoHashType,
+    .GetSigningAlgorithm = _mockGetSigningAlgorithm
+};
+
+static PARCSigner *
+_createSigner(PARCCryptoHashType hashType)
+{
+    _mockSignerHashType = hashType;
+    PARCBuffer *key = parcBuffer_WrapCString("chunk pipeline");
+    PARCSigner *result = parcSigner_Create(key, _mockSigner);
+    parcBuffer_Release(&key);
+    return result;
+}
+
+/*
+ * Records what the pipeline delivers and checks it against computing each chunk in turn.
+ */
+typedef struct {
+    PARCIterator *expected;
+    PARCSigner *signer;
+    size_t count;
+    size_t stopAfter;
+} _Expectation;
+
+static bool
+_checkChunk(void *context, size_t chunkNumber, PARCBuffer *chunk, PARCCryptoHash *hash, PARCSignature *signature)
+{
+    _Expectation *expectation = context;
+    assertTrue(chunkNumber == expectation->count, "Expected chunk %zu, actual %zu", expectation->count, chunkNumber);
+    assertTrue(parcIterator_HasNext(expectation->expected), "More chunks delivered than the chunker has");
+
+    PARCBuffer *expectedChunk = parcIterator_Next(expectation->expected);
+    assertTrue(parcBuffer_Equals(expectedChunk, chunk), "Chunk %zu is out of order", chunkNumber);
+
+    PARCCryptoHasher *hasher = parcCryptoHasher_Create(PARCCryptoHashType_SHA256);
+    parcCryptoHasher_Init(hasher);
+    parcCryptoHasher_UpdateBuffer(hasher, expectedChunk);
+    PARCCryptoHash *expectedHash = parcCryptoHasher_Finalize(hasher);
+    assertTrue(parcCryptoHash_Equals(expectedHash, hash), "Wrong digest for chunk %zu", chunkNumber);
+
+    if (expectation->signer != NULL) {
+        assertNotNull(signature, "Expected a signature for chunk %zu", chunkNumber);
+        PARCSignature *expectedSignature = parcSigner_SignDigest(expectation->signer, expectedHash);
+        assertTrue(parcSignature_Equals(expectedSignature, signature), "Wrong signature for chunk %zu", chunkNumber);
+        parcSignature_Release(&expectedSignature);
+    } else {
+        assertNull(signature, "Expected no signature without a signer");
+    }
+
+    parcCryptoHash_Release(&expectedHash);
+    parcCryptoHasher_Release(&hasher);
+    parcBuffer_Release(&expectedChunk);
+
+    expectation->count++;
+    return expectation->count != expectation->stopAfter;
+}
+
+LONGBOW_TEST_CASE(Global, parcChunkPipeline_AcquireRelease)
+{
+    _TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    PARCChunkPipeline *pipeline = parcChunkPipeline_Create(data->pool, PARCCryptoHashType_SHA256, NULL, 0);
+    assertNotNull(pipeline, "Expected non-null result from parcChunkPipeline_Create");
+
+    parcObjectTesting_AssertAcquireReleaseContract(parcChunkPipeline_Acquire, pipeline);
+
+    parcChunkPipeline_Release(&pipeline);
+    assertNull(pipeline, "Expected parcChunkPipeline_Release to null the pointer");
+}
+
+LONGBOW_TEST_CASE_EXPECTS(Global, parcChunkPipeline_Create_SignerHashTypeMismatch, .event = &LongBowTrapIllegalValue)
+{
+    _TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    PARCSigner *signer = _createSigner(PARCCryptoHashType_SHA512);
+
+    parcChunkPipeline_Create(data->pool, PARCCryptoHashType_SHA256, signer, 0);
+}
+
+LONGBOW_TEST_CASE(Global, parcChunkPipeline_GetMaxInFlight)
+{
+    _TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    PARCChunkPipeline *pipeline = parcChunkPipeline_Create(data->pool, PARCCryptoHashType_SHA256, NULL, 0);
+    assertTrue(parcChunkPipeline_GetMaxInFlight(pipeline) == 16,
+               "Expected four times the pool size, actual %zu", parcChunkPipeline_GetMaxInFlight(pipeline));
+    parcChunkPipeline_Release(&pipeline);
+
+    pipeline = parcChunkPipeline_Create(data->pool, PARCCryptoHashType_SHA256, NULL, 3);
+    assertTrue(parcChunkPipeline_GetMaxInFlight(pipeline) == 3,
+               "Expected 3, actual %zu", parcChunkPipeline_GetMaxInFlight(pipeline));
+    parcChunkPipeline_Release(&pipeline);
+}
+
+static void
+_assertProcess(_TestData *data, size_t maxInFlight, PARCSigner *signer)
+{
+    PARCChunkPipeline *pipeline = parcChunkPipeline_Create(data->pool, PARCCryptoHashType_SHA256, signer, maxInFlight);
+
+    _Expectation expectation = { .expected = parcChunker_ForwardIterator(data->chunker), .signer = signer };
+    size_t count = parcChunkPipeline_Process(pipeline, data->chunker, _checkChunk, &expectation);
+
+    assertTrue(count == 79, "Expected 79 chunks, actual %zu", count);
+    assertFalse(parcIterator_HasNext(expectation.expected), "Expected every chunk to be delivered");
+
+    parcIterator_Release(&expectation.expected);
+    parcChunkPipeline_Release(&pipeline);
+}
+
+LONGBOW_TEST_CASE(Global, parcChunkPipeline_Process)
+{
+    _assertProcess(longBowTestCase_GetClipBoardData(testCase), 8, NULL);
+}
+
+LONGBOW_TEST_CASE(Global, parcChunkPipeline_Process_OneInFlight)
+{
+    _assertProcess(longBowTestCase_GetClipBoardData(testCase), 1, NULL);
+}
+
+LONGBOW_TEST_CASE(Global, parcChunkPipeline_Process_Signed)
+{
+    PARCSigner *signer = _createSigner(PARCCryptoHashType_SHA256);
+    _assertProcess(longBowTestCase_GetClipBoardData(testCase), 0, signer);
+    parcSigner_Release(&signer);
+}
+
+LONGBOW_TEST_CASE(Global, parcChunkPipeline_Process_Stop)
+{
+    _TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    PARCChunkPipeline *pipeline = parcChunkPipeline_Create(data->pool, PARCCryptoHashType_SHA256, NULL, 8);
+
+    _Expectation expectation = { .expected = parcChunker_ForwardIterator(data->chunker), .stopAfter = 5 };
+    size_t count = parcChunkPipeline_Process(pipeline, data->chunker, _checkChunk, &expectation);
+    assertTrue(count == 5, "Expected 5 chunks before stopping, actual %zu", count);
+
+    parcIterator_Release(&expectation.expected);
+    parcChunkPipeline_Release(&pipeline);
+}
+
+LONGBOW_TEST_CASE(Global, parcChunkPipeline_ProcessIterator_Reverse)
+{
+    _TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    PARCChunkPipeline *pipeline = parcChunkPipeline_Create(data->pool, PARCCryptoHashType_SHA256, NULL, 8);
+
+    _Expectation expectation = { .expected = parcChunker_ReverseIterator(data->chunker) };
+    PARCIterator *chunks = parcChunker_ReverseIterator(data->chunker);
+    size_t count = parcChunkPipeline_ProcessIterator(pipeline, chunks, _checkChunk, &expectation);
+    assertTrue(count == 79, "Expected 79 chunks, actual %zu", count);
+
+    parcIterator_Release(&chunks);
+    parcIterator_Release(&expectation.expected);
+    parcChunkPipeline_Release(&pipeline);
+}
+
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, parcChunkPipeline_Process_Throughput);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    parcSecurity_Init();
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    parcSecurity_Fini();
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+static bool
+_countChunk(void *context, size_t chunkNumber, PARCBuffer *chunk, PARCCryptoHash *hash, PARCSignature *signature)
+{
+    return true;
+}
+
+static double
+_elapsedSeconds(const struct timeval *start, const struct timeval *end)
+{
+    return (end->tv_sec - start->tv_sec) + (end->tv_usec - start->tv_usec) / 1000000.0;
+}
+
+LONGBOW_TEST_CASE(Performance, parcChunkPipeline_Process_Throughput)
+{
+    size_t length = 64 * 1024 * 1024;
+    size_t chunkSize = 4096;
+    PARCBuffer *buffer = parcBuffer_Allocate(length);
+    parcBuffer_SetPosition(buffer, length);
+    parcBuffer_Flip(buffer);
+
+    PARCBufferChunker *bufferChunker = parcBufferChunker_Create(buffer, chunkSize);
+    PARCChunker *chunker = parcChunker_Create(bufferChunker, PARCBufferChunkerAsChunker);
+    parcBufferChunker_Release(&bufferChunker);
+
+    struct timeval start, end;
+    gettimeofday(&start, NULL);
+    PARCIterator *chunks = parcChunker_ForwardIterator(chunker);
+    while (parcIterator_HasNext(chunks)) {
+        PARCBuffer *chunk = parcIterator_Next(chunks);
+        PARCCryptoHasher *hasher = parcCryptoHasher_Create(PARCCryptoHashType_SHA256);
+        parcCryptoHasher_Init(hasher);
+        parcCryptoHasher_UpdateBuffer(hasher, chunk);
+        PARCCryptoHash *hash = parcCryptoHasher_Finalize(hasher);
+        parcCryptoHash_Release(&hash);
+        parcCryptoHasher_Release(&hasher);
+        parcBuffer_Release(&chunk);
+    }
+    parcIterator_Release(&chunks);
+    gettimeofday(&end, NULL);
+    printf("parcChunkPipeline SHA-256 of %zu byte chunks, sequential: %.0f MB/s\n",
+           chunkSize, length / _elapsedSeconds(&start, &end) / 1e6);
+
+    int poolSizes[] = { 1, 2, 4, 8 };
+    for (size_t p = 0; p < sizeof(poolSizes) / sizeof(poolSizes[0]); p++) {
+        PARCThreadPool *pool = parcThreadPool_Create(poolSizes[p]);
+        PARCChunkPipeline *pipeline = parcChunkPipeline_Create(pool, PARCCryptoHashType_SHA256, NULL, 0);
+
+        // PARCBufferChunker iterates by moving the position of the buffer it wraps.
+        parcBuffer_Rewind(buffer);
+        gettimeofday(&start, NULL);
+        parcChunkPipeline_Process(pipeline, chunker, _countChunk, NULL);
+        gettimeofday(&end, NULL);
+        printf("parcChunkPipeline SHA-256 of %zu byte chunks, %d threads: %.0f MB/s\n",
+               chunkSize, poolSizes[p], length / _elapsedSeconds(&start, &end) / 1e6);
+
+        parcChunkPipeline_Release(&pipeline);
+        parcThreadPool_ShutdownNow(pool);
+        parcThreadPool_Release(&pool);
+    }
+
+    parcChunker_Release(&chunker);
+    parcBuffer_Release(&buffer);
+}
+
+int
+main(int argc, char *argv[])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(parc_ChunkPipeline);
+    int exitStatus = LONGBOW_TEST_MAIN(argc, argv, testRunner);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}